@@ -2,6 +2,7 @@
 #include <ctime>
 #include <chrono>
 #include <ratio>
+#include <algorithm>
 
 #include "main.h"
 #include "program.h"
@@ -17,7 +18,7 @@
 
 bool Usage(std::vector<SettingOption> options)
 {
-    std::cerr << "Usage pebble: [--help] [--custom] [--only] [--noisy] [--ast] [--trace] [program.pebl]" << std::endl;
+    std::cerr << "Usage pebble: [--help] [--custom] [--only] [--noisy] [--ast] [--trace] [--jobs] [program.pebl]" << std::endl;
 
     exit(2);
 }
@@ -68,6 +69,18 @@ bool SettingTraceProgram(std::vector<SettingOption> options)
     return true;
 }
 
+bool SettingJobs(std::vector<SettingOption> options)
+{
+    if(options.empty())
+    {
+        return true;
+    }
+
+    g_testJobs = std::max(1, atoi(options[0].c_str()));
+
+    return true;
+}
+
 ProgramConfiguration Config
 {
     {
@@ -87,6 +100,9 @@ ProgramConfiguration Config
     },
     {
         "Run and trace one program", "--trace", SettingTraceProgram
+    },
+    {
+        "Run tests in processes", "--jobs", SettingJobs
     }
 };
 
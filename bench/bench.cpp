@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Benchmarks
+//
+// runs each benchmark program with both runtimes of pebble and prints one tab separated
+// row per program and runtime, so the results of two commits can be diffed:
+//
+//     program  runtime  seconds  instructions  instructions_per_second  peak_rss_kb  exit_code
+//
+// [seconds] is the fastest wall time of the runs of the program, and [peak_rss_kb] the
+// largest resident set of those runs. [instructions] is the number of bytecode
+// instructions executed, counted by a separate run with --fusion-stats so that counting
+// does not slow the timed runs. the ast runtime does not execute instructions, so its
+// instruction columns are '-'
+//
+// usage: runbench [--pebble ./pebble] [--repeat n] program.pebl...
+
+/// the runtimes every program is run with, as given to --runtime
+const std::vector<std::string> Runtimes = { "bc", "ast" };
+
+/// the result of running pebble once
+/// [Seconds] is the wall time of the run
+/// [PeakRssKb] is the largest resident set of the process
+/// [ExitCode] is the exit code of the process, or -1 if it did not exit
+/// [Errors] is what the process wrote to stderr
+struct BenchRun
+{
+    double Seconds;
+    long PeakRssKb;
+    int ExitCode;
+    std::string Errors;
+};
+
+/// runs [pebble] with [args], discarding what it prints to stdout. returns the run with
+/// an ExitCode of -1 if the process could not be started
+BenchRun RunPebble(const std::string& pebble, const std::vector<std::string>& args)
+{
+    BenchRun run = { 0, 0, -1, "" };
+
+    int fds[2];
+    if(pipe(fds) != 0)
+    {
+        return run;
+    }
+
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(pebble.c_str()));
+    for(auto& arg: args)
+    {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    pid_t pid = fork();
+    if(pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return run;
+    }
+
+    if(pid == 0)
+    {
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[0]);
+        execv(pebble.c_str(), argv.data());
+        _exit(127);
+    }
+
+    close(fds[1]);
+    char chunk[4096];
+    ssize_t n;
+    while((n = read(fds[0], chunk, sizeof(chunk))) != 0)
+    {
+        if(n > 0)
+        {
+            run.Errors.append(chunk, n);
+        }
+        else if(errno != EINTR)
+        {
+            break;
+        }
+    }
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage = {};
+    while(wait4(pid, &status, 0, &usage) < 0 && errno == EINTR);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    run.Seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+#ifdef __APPLE__
+    run.PeakRssKb = usage.ru_maxrss / 1024;
+#else
+    run.PeakRssKb = usage.ru_maxrss;
+#endif
+    run.ExitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    return run;
+}
+
+/// returns the number of instructions executed by [program] with the bytecode
+/// runtime, or -1 if it cannot be counted
+long long CountInstructions(const std::string& pebble, const std::string& program)
+{
+    auto run = RunPebble(pebble, { "--runtime", "bc", "--fusion-stats", program });
+
+    const std::string field = "instructions executed:";
+    auto at = run.Errors.find(field);
+    if(at == std::string::npos)
+    {
+        return -1;
+    }
+
+    return std::atoll(run.Errors.c_str() + at + field.size());
+}
+
+/// returns the name of [program] without its directory and extension
+std::string ProgramName(const std::string& program)
+{
+    auto start = program.find_last_of('/');
+    start = start == std::string::npos ? 0 : start + 1;
+    auto end = program.rfind('.');
+    if(end == std::string::npos || end < start)
+    {
+        end = program.size();
+    }
+
+    return program.substr(start, end - start);
+}
+
+/// runs [program] [repeat] times with [runtime] and prints its row of the table
+void BenchProgram(const std::string& pebble, const std::string& program, const std::string& runtime, int repeat)
+{
+    BenchRun best = { 0, 0, 0, "" };
+    for(int i=0; i<repeat; i++)
+    {
+        auto run = RunPebble(pebble, { "--runtime", runtime, program });
+        if(i == 0 || run.Seconds < best.Seconds)
+        {
+            best.Seconds = run.Seconds;
+        }
+        if(run.PeakRssKb > best.PeakRssKb)
+        {
+            best.PeakRssKb = run.PeakRssKb;
+        }
+        if(run.ExitCode != 0)
+        {
+            best.ExitCode = run.ExitCode;
+        }
+    }
+
+    std::string instructions = "-";
+    std::string instructionsPerSecond = "-";
+    if(runtime == "bc")
+    {
+        long long count = CountInstructions(pebble, program);
+        if(count >= 0)
+        {
+            instructions = std::to_string(count);
+            instructionsPerSecond = std::to_string(static_cast<long long>(count / best.Seconds));
+        }
+    }
+
+    char seconds[32];
+    std::snprintf(seconds, sizeof(seconds), "%.4f", best.Seconds);
+
+    std::cout << ProgramName(program) << "\t" << runtime << "\t" << seconds << "\t" << instructions << "\t"
+        << instructionsPerSecond << "\t" << best.PeakRssKb << "\t" << best.ExitCode << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string pebble = "./pebble";
+    int repeat = 3;
+    std::vector<std::string> programs;
+
+    for(int i=1; i<argc; i++)
+    {
+        std::string arg = argv[i];
+        if(arg == "--pebble" && i+1 < argc)
+        {
+            pebble = argv[++i];
+        }
+        else if(arg == "--repeat" && i+1 < argc)
+        {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            programs.push_back(arg);
+        }
+    }
+
+    if(programs.empty())
+    {
+        std::cerr << "Usage runbench: [--pebble ./pebble] [--repeat n] program.pebl..." << std::endl;
+        return 2;
+    }
+
+    std::cout << "program\truntime\tseconds\tinstructions\tinstructions_per_second\tpeak_rss_kb\texit_code" << std::endl;
+    for(auto& program: programs)
+    {
+        for(auto& runtime: Runtimes)
+        {
+            BenchProgram(pebble, program, runtime, repeat);
+        }
+    }
+
+    return 0;
+}
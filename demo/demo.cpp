@@ -76,9 +76,13 @@ bool PromptYN(std::string prompt)
 void RunProgramSuppressingOutput(Program* p)
 {
     g_outputOn = false;
-    FlattenProgram(p);
-    DoByteCodeProgram(p);
+    PebbleVM* vm = PebbleVMConstructor();
+    vm->Output = &ProgramOutput;
+    vm->Messages = &ProgramMsgs;
+    FlattenProgram(vm, p);
+    DoByteCodeProgram(vm, p);
     ProgramDestructor(p);
+    PebbleVMDestructor(vm);
 }
 
 const int IndentSize = 4;
@@ -47,7 +47,7 @@ std::string RightEdge()
 
 const char* GetSimpleTokenColor(const Token* token)
 {
-    auto content = token->Content;
+    String content(token->Content);
     
     std::regex typeBinding("\\b(a|an)\\b");
     if(std::regex_search(content, typeBinding))
@@ -139,10 +139,10 @@ std::string Formatted(const Token* token)
     switch(token->Type)
     {
         case TokenType::String:
-            return "\"" + token->Content + "\"";
+            return "\"" + String(token->Content) + "\"";
         
         default:
-            return token->Content;
+            return String(token->Content);
     }
 }
 
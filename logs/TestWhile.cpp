@@ -0,0 +1,252 @@
+// generated by pebble --emit-cpp. do not edit
+
+#include "aot.h"
+
+// runtime settings, which pebble defines in main.cpp
+bool g_outputOn = true;
+bool g_useBytecodeRuntime = true;
+LogSeverityType LogAtLevel = LogSeverityType::Sev3_Critical;
+
+static const AotProgram Aot =
+{
+    {
+        { 0, 8 },
+        { 19, 0 },
+        { 1, 0 },
+        { 2, 0 },
+        { 31, 0 },
+        { 36, 8 },
+        { 1, 1 },
+        { 39, 2147483665 },
+        { 36, 8 },
+        { 7, 0 },
+        { 31, 0 },
+        { 36, 8 },
+        { 36, 8 },
+        { 38, 2 },
+        { 2, 0 },
+        { 31, 0 },
+        { 16, 5 },
+        { 36, 9 },
+        { 1, 3 },
+        { 2, 0 },
+        { 31, 0 },
+        { 36, 9 },
+        { 15, 27 },
+        { 1, 4 },
+        { 7, 0 },
+        { 31, 0 },
+        { 16, 21 },
+        { 36, 8 },
+        { 1, 1 },
+        { 38, 0 },
+        { 2, 0 },
+        { 31, 0 },
+        { 36, 8 },
+        { 1, 1 },
+        { 39, 1610612780 },
+        { 36, 8 },
+        { 7, 0 },
+        { 31, 0 },
+        { 36, 8 },
+        { 36, 8 },
+        { 37, 2 },
+        { 2, 0 },
+        { 31, 0 },
+        { 16, 32 },
+    },
+    {
+        String("X", 1),
+        String("Y", 1),
+    },
+    {
+        { &IntegerType, 5, 0x0p+0, String("", 0), false },
+        { &IntegerType, 0, 0x0p+0, String("", 0), false },
+        { &IntegerType, 1, 0x0p+0, String("", 0), false },
+        { &BooleanType, 0, 0x0p+0, String("", 0), false },
+        { &StringType, 0, 0x0p+0, String("in", 2), false },
+    },
+    {
+    },
+    {
+        0, 4, 7, 10, 15, 20, 22, 25, 31, 34, 37, 42, 
+    },
+    {
+        1, 2, 3, 4, 6, 7, 8, 10, 11, 12, 13, 
+    },
+};
+
+static int RunProgram(PebbleVM* vm, Program* p)
+{
+ins_0:
+    vm->InstructionReg = 0; BCI_LoadCallName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_1:
+    vm->InstructionReg = 1; BCI_ResolveDirect(vm, 0); if(vm->ErrorFlag) goto error;
+ins_2:
+    vm->InstructionReg = 2; BCI_LoadPrimitive(vm, 0); if(vm->ErrorFlag) goto error;
+ins_3:
+    vm->InstructionReg = 3; BCI_Assign(vm, 0); if(vm->ErrorFlag) goto error;
+ins_4:
+    vm->InstructionReg = 4; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_5:
+    vm->InstructionReg = 5; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_6:
+    vm->InstructionReg = 6; BCI_LoadPrimitive(vm, 1); if(vm->ErrorFlag) goto error;
+ins_7:
+    vm->InstructionReg = 7; BCI_CmpJumpFalse(vm, 2147483665); if(vm->ErrorFlag) goto error;
+    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto ins_17; }
+ins_8:
+    vm->InstructionReg = 8; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_9:
+    vm->InstructionReg = 9; BCI_SysCall(vm, 0); if(vm->ErrorFlag) goto error;
+ins_10:
+    vm->InstructionReg = 10; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_11:
+    vm->InstructionReg = 11; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_12:
+    vm->InstructionReg = 12; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_13:
+    vm->InstructionReg = 13; BCI_SubtractConst(vm, 2); if(vm->ErrorFlag) goto error;
+ins_14:
+    vm->InstructionReg = 14; BCI_Assign(vm, 0); if(vm->ErrorFlag) goto error;
+ins_15:
+    vm->InstructionReg = 15; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_16:
+    goto ins_5;
+ins_17:
+    vm->InstructionReg = 17; BCI_ResolveName(vm, 9); if(vm->ErrorFlag) goto error;
+ins_18:
+    vm->InstructionReg = 18; BCI_LoadPrimitive(vm, 3); if(vm->ErrorFlag) goto error;
+ins_19:
+    vm->InstructionReg = 19; BCI_Assign(vm, 0); if(vm->ErrorFlag) goto error;
+ins_20:
+    vm->InstructionReg = 20; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_21:
+    vm->InstructionReg = 21; BCI_ResolveName(vm, 9); if(vm->ErrorFlag) goto error;
+ins_22:
+    vm->InstructionReg = 22; BCI_JumpFalse(vm, 27); if(vm->ErrorFlag) goto error;
+    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto ins_27; }
+ins_23:
+    vm->InstructionReg = 23; BCI_LoadPrimitive(vm, 4); if(vm->ErrorFlag) goto error;
+ins_24:
+    vm->InstructionReg = 24; BCI_SysCall(vm, 0); if(vm->ErrorFlag) goto error;
+ins_25:
+    vm->InstructionReg = 25; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_26:
+    goto ins_21;
+ins_27:
+    vm->InstructionReg = 27; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_28:
+    vm->InstructionReg = 28; BCI_LoadPrimitive(vm, 1); if(vm->ErrorFlag) goto error;
+ins_29:
+    vm->InstructionReg = 29; BCI_SubtractConst(vm, 0); if(vm->ErrorFlag) goto error;
+ins_30:
+    vm->InstructionReg = 30; BCI_Assign(vm, 0); if(vm->ErrorFlag) goto error;
+ins_31:
+    vm->InstructionReg = 31; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_32:
+    vm->InstructionReg = 32; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_33:
+    vm->InstructionReg = 33; BCI_LoadPrimitive(vm, 1); if(vm->ErrorFlag) goto error;
+ins_34:
+    vm->InstructionReg = 34; BCI_CmpJumpFalse(vm, 1610612780); if(vm->ErrorFlag) goto error;
+    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto ins_44; }
+ins_35:
+    vm->InstructionReg = 35; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_36:
+    vm->InstructionReg = 36; BCI_SysCall(vm, 0); if(vm->ErrorFlag) goto error;
+ins_37:
+    vm->InstructionReg = 37; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_38:
+    vm->InstructionReg = 38; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_39:
+    vm->InstructionReg = 39; BCI_ResolveName(vm, 8); if(vm->ErrorFlag) goto error;
+ins_40:
+    vm->InstructionReg = 40; BCI_AddConst(vm, 2); if(vm->ErrorFlag) goto error;
+ins_41:
+    vm->InstructionReg = 41; BCI_Assign(vm, 0); if(vm->ErrorFlag) goto error;
+ins_42:
+    vm->InstructionReg = 42; BCI_EndLine(vm, 0); if(vm->ErrorFlag) goto error;
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+ins_43:
+    goto ins_32;
+ins_44:
+    goto halt;
+
+dispatch:
+    switch(vm->InstructionReg)
+    {
+        case 0: goto ins_0;
+        case 1: goto ins_1;
+        case 2: goto ins_2;
+        case 3: goto ins_3;
+        case 4: goto ins_4;
+        case 5: goto ins_5;
+        case 6: goto ins_6;
+        case 7: goto ins_7;
+        case 8: goto ins_8;
+        case 9: goto ins_9;
+        case 10: goto ins_10;
+        case 11: goto ins_11;
+        case 12: goto ins_12;
+        case 13: goto ins_13;
+        case 14: goto ins_14;
+        case 15: goto ins_15;
+        case 16: goto ins_16;
+        case 17: goto ins_17;
+        case 18: goto ins_18;
+        case 19: goto ins_19;
+        case 20: goto ins_20;
+        case 21: goto ins_21;
+        case 22: goto ins_22;
+        case 23: goto ins_23;
+        case 24: goto ins_24;
+        case 25: goto ins_25;
+        case 26: goto ins_26;
+        case 27: goto ins_27;
+        case 28: goto ins_28;
+        case 29: goto ins_29;
+        case 30: goto ins_30;
+        case 31: goto ins_31;
+        case 32: goto ins_32;
+        case 33: goto ins_33;
+        case 34: goto ins_34;
+        case 35: goto ins_35;
+        case 36: goto ins_36;
+        case 37: goto ins_37;
+        case 38: goto ins_38;
+        case 39: goto ins_39;
+        case 40: goto ins_40;
+        case 41: goto ins_41;
+        case 42: goto ins_42;
+        case 43: goto ins_43;
+        case 44: goto ins_44;
+        default: goto halt;
+    }
+
+error:
+    IfNeededDisplayError(vm, p);
+    if(vm->FatalErrorOccured)
+    {
+        GracefullyExit(vm);
+        return 1;
+    }
+    if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++;
+    goto dispatch;
+
+halt:
+    GracefullyExit(vm);
+    return 0;
+}
+
+int main()
+{
+    return RunAotProgram(Aot, RunProgram);
+}
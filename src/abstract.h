@@ -18,6 +18,7 @@ struct Reference;
 struct ByteCodeInstruction;
 struct CFGRule;
 struct Call;
+struct PebbleVM;
 
 class Object;
 class Method;
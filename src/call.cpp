@@ -1,18 +1,22 @@
+#include <new>
+#include <type_traits>
+
 #include "call.h"
 
 #include "value.h"
 #include "vm.h"
 #include "diagnostics.h"
+#include "utils.h"
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Call structure methods
 
 /// wrapper which should always be used when creating a new instance of Call
-/// with [name]
-Call* CallConstructor(const String* name)
+/// with [name], allocated from [slab]
+Call* CallConstructor(utils::Slab<Call>& slab, const String* name)
 {
-    auto call = new Call;
+    auto call = new (slab.Allocate()) Call;
     call->Name = name;
     call->BoundScope = nullptr;
     call->BoundSection = 0;
@@ -26,9 +30,18 @@ Call* CallConstructor(const String* name)
 }
 
 /// wrapper which should always be used when freeing an instance of Call [call]
-void CallDestructor(Call* call)
+/// allocated from [slab]
+void CallDestructor(utils::Slab<Call>& slab, Call* call)
+{
+    // Calls own no memory, so they may be freed without being destroyed
+    static_assert(std::is_trivially_destructible<Call>::value, "Call must be trivially destructible");
+    slab.Free(call);
+}
+
+/// frees every Call allocated from [slab] at once
+void ReleaseAllCalls(utils::Slab<Call>& slab)
 {
-    delete call;
+    slab.Reset();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
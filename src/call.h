@@ -3,6 +3,7 @@
 
 #include "abstract.h"
 #include "value.h"
+#include "utils.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Type structure
@@ -74,11 +75,16 @@ struct Call
 };
 
 /// wrapper which should always be used when creating a new instance of Call
-/// with [name]
-Call* CallConstructor(const String* name=nullptr);
+/// with [name], allocated from [slab]
+Call* CallConstructor(utils::Slab<Call>& slab, const String* name=nullptr);
 
 /// wrapper which should always be used when freeing an instance of Call [call]
-void CallDestructor(Call* call);
+/// allocated from [slab]
+void CallDestructor(utils::Slab<Call>& slab, Call* call);
+
+/// frees every Call allocated from [slab] at once. no such Call may be used
+/// afterwards
+void ReleaseAllCalls(utils::Slab<Call>& slab);
 
 /// true if a [call] refers to a primitive type
 bool CallIsPrimitive(Call* call);
@@ -452,7 +452,7 @@ String ToString(const Token& token)
     return StringForAttrbute("Token", Msg("Position: %i\t Type: %s\t Content: %s", 
         token.Position,
         GetStringTokenType(token.Type),
-        token.Content));
+        String(token.Content)));
 }
 
 String ToString(const Token* token)
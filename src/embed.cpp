@@ -0,0 +1,66 @@
+#include "embed.h"
+
+#include "program.h"
+#include "grammar.h"
+#include "flattener.h"
+#include "vm.h"
+
+PebbleProgram* CompilePebbleProgram(const String& source, String* messages)
+{
+    ProgramMsgs.clear();
+    FatalCompileError = false;
+
+    CompileGrammar();
+    Program* parsed = ParseProgramSource(source);
+
+    if(messages != nullptr)
+    {
+        *messages = ProgramMsgs;
+    }
+
+    /// the compile leaves no messages or errors behind for the next one
+    bool isCompiled = parsed != nullptr && !FatalCompileError;
+    ProgramMsgs.clear();
+    FatalCompileError = false;
+
+    if(!isCompiled)
+    {
+        if(parsed != nullptr)
+        {
+            ProgramDestructor(parsed);
+        }
+        return nullptr;
+    }
+
+    PebbleProgram* program = new PebbleProgram;
+    program->VM = PebbleVMConstructor();
+    program->Source = parsed;
+    FlattenProgram(program->VM, parsed);
+
+    return program;
+}
+
+PebbleRunResult RunPebbleProgram(PebbleProgram* program, const PebbleAskMethod& ask)
+{
+    PebbleRunResult result;
+
+    auto vm = program->VM;
+    vm->OutputBuffer.clear();
+    vm->MessagesBuffer.clear();
+    vm->Ask = ask;
+
+    result.ExitCode = DoByteCodeProgram(vm, program->Source);
+
+    result.Output.swap(vm->OutputBuffer);
+    result.Messages.swap(vm->MessagesBuffer);
+    vm->Ask = nullptr;
+
+    return result;
+}
+
+void PebbleProgramDestructor(PebbleProgram* program)
+{
+    ProgramDestructor(program->Source);
+    PebbleVMDestructor(program->VM);
+    delete program;
+}
@@ -0,0 +1,57 @@
+#ifndef __EMBED_H
+#define __EMBED_H
+
+#include <functional>
+
+#include "abstract.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Embedding
+//
+// libpebble.a (`make libpebble.a`) holds the runtime without main, so that a C++
+// program may run pebble programs. a program is compiled once from source held in
+// memory, and may then be run any number of times without being parsed or flattened
+// again. each run reads the input of ask from a callback and captures what the program
+// prints, and neither reads nor writes any file
+//
+// programs are compiled one at a time, but separate PebblePrograms may run at the same
+// time on different threads. a program is not bound to the thread which compiled it:
+// it may be compiled, run and freed on different threads, such as those of a pool, as
+// long as only one thread uses it at a time
+
+/// a compiled program which may be run any number of times
+/// [VM] holds the flattened program and runs it
+/// [Source] is the parsed program, which holds the line numbers used to report errors
+struct PebbleProgram
+{
+    PebbleVM* VM;
+    Program* Source;
+};
+
+/// returns the line of input read by ask
+typedef std::function<String()> PebbleAskMethod;
+
+/// the result of running a PebbleProgram
+/// [Output] is the text printed by the program, including its runtime errors
+/// [Messages] holds the runtime errors alone
+/// [ExitCode] is 0, or 1 if the program was ended by a fatal error
+struct PebbleRunResult
+{
+    String Output;
+    String Messages;
+    int ExitCode;
+};
+
+/// compiles [source] into a program which must be freed with PebbleProgramDestructor.
+/// returns nullptr if [source] cannot be compiled. if not nullptr, [messages] is set
+/// to the compile errors
+PebbleProgram* CompilePebbleProgram(const String& source, String* messages=nullptr);
+
+/// runs [program], with [ask] returning the input of each ask. if [ask] is empty, ask
+/// reads a line of std::cin
+PebbleRunResult RunPebbleProgram(PebbleProgram* program, const PebbleAskMethod& ask=nullptr);
+
+/// frees [program]
+void PebbleProgramDestructor(PebbleProgram* program);
+
+#endif
@@ -0,0 +1,320 @@
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+#include "aot.h"
+
+#include "value.h"
+#include "scope.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Emit state
+
+String g_emitCppFile = "";
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Emit helpers
+
+/// returns [str] as a C++ String expression which keeps every byte
+String CppStringFor(const String& str)
+{
+    String literal = "\"";
+    for(unsigned char c: str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            literal += '\\';
+            literal += c;
+        }
+        else if(c >= 0x20 && c < 0x7f)
+        {
+            literal += c;
+        }
+        else
+        {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\%03o", (unsigned)c);
+            literal += escape;
+        }
+    }
+    literal += "\"";
+
+    return "String(" + literal + ", " + std::to_string(str.size()) + ")";
+}
+
+/// returns [value] as a C++ double expression which keeps its exact value
+String CppDecimalFor(double value)
+{
+    if(std::isnan(value))
+    {
+        return "std::nan(\"\")";
+    }
+    if(std::isinf(value))
+    {
+        return value > 0 ? "HUGE_VAL" : "-HUGE_VAL";
+    }
+    char hex[64];
+    std::snprintf(hex, sizeof(hex), "%a", value);
+    return hex;
+}
+
+/// returns the C++ expression of the type [type] bound to a constant primitive
+String CppTypeFor(BindingType type)
+{
+    if(type == &IntegerType) return "&IntegerType";
+    if(type == &DecimalType) return "&DecimalType";
+    if(type == &StringType) return "&StringType";
+    if(type == &BooleanType) return "&BooleanType";
+    if(type == &MethodType) return "&MethodType";
+    return "&NothingType";
+}
+
+/// returns the C++ initializer of the AotPrimitive for [call]
+String CppPrimitiveFor(const Call* call)
+{
+    int integer = 0;
+    double decimal = 0;
+    String text = "";
+    bool boolean = false;
+
+    if(call->BoundType == &IntegerType) integer = call->BoundValue.i;
+    else if(call->BoundType == &DecimalType) decimal = call->BoundValue.d;
+    else if(call->BoundType == &StringType) text = *call->BoundValue.s;
+    else if(call->BoundType == &BooleanType) boolean = call->BoundValue.b;
+
+    return "{ " + CppTypeFor(call->BoundType) + ", " + std::to_string(integer) + ", " + CppDecimalFor(decimal) 
+        + ", " + CppStringFor(text) + ", " + (boolean ? "true" : "false") + " }";
+}
+
+/// returns the C++ label of the instruction [insId]
+inline String LabelFor(extArg_t insId)
+{
+    return "ins_" + std::to_string(insId);
+}
+
+/// returns the C++ statement which calls the BCI method of [ins] as instruction
+/// [insId] and checks for an error
+inline String CallFor(const ByteCodeInstruction& ins, extArg_t insId)
+{
+    return "vm->InstructionReg = " + std::to_string(insId) + "; " + BCI_InstructionNames[ins.Op] 
+        + "(vm, " + std::to_string(ins.Arg) + "); if(vm->ErrorFlag) goto error;";
+}
+
+/// returns the C++ code of the instruction [insId] of [vm]. each instruction does
+/// what the vm does for it
+String CppCodeFor(PebbleVM* vm, extArg_t insId)
+{
+    auto& ins = vm->ByteCodeProgram[insId];
+    String code = LabelFor(insId) + ":\n    ";
+
+    switch(ins.Op)
+    {
+        case OP_NOP:
+            code += ";";
+            break;
+
+        case OP_Jump:
+            code += "goto " + LabelFor(ins.Arg) + ";";
+            break;
+
+        case OP_JumpFalse:
+        case OP_CmpJumpFalse:
+        {
+            auto target = ins.Op == OP_CmpJumpFalse ? CmpJumpTargetOf(ins.Arg) : ins.Arg;
+            code += CallFor(ins, insId);
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto " + LabelFor(target) + "; }";
+            break;
+        }
+
+        case OP_TailEval:
+            code += CallFor(ins, insId);
+            code += "\n    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);";
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto dispatch; }";
+            break;
+
+        case OP_Eval:
+        case OP_EvalHere:
+        case OP_Return:
+            code += CallFor(ins, insId);
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto dispatch; }";
+            break;
+
+        case OP_EndLine:
+            code += CallFor(ins, insId);
+            code += "\n    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);";
+            break;
+
+        default:
+            code += CallFor(ins, insId);
+            break;
+    }
+
+    return code + "\n";
+}
+
+/// writes the tables of [vm] and [p] as the AotProgram named Aot to [out]
+void EmitTables(PebbleVM* vm, std::ofstream& out, Program* p)
+{
+    out << "static const AotProgram Aot =\n{\n";
+
+    out << "    {\n";
+    for(auto& ins: vm->ByteCodeProgram)
+    {
+        out << "        { " << (int)ins.Op << ", " << ins.Arg << " },\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto& name: vm->CallNames)
+    {
+        out << "        " << CppStringFor(name) << ",\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto call: vm->ConstPrimitives)
+    {
+        out << "        " << CppPrimitiveFor(call) << ",\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto& slot: vm->LocalSlots)
+    {
+        out << "        { " << slot.Slot << ", " << slot.NameId << " },\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n        ";
+    for(auto id: vm->ByteCodeLineAssociation)
+    {
+        out << id << ", ";
+    }
+    out << "\n    },\n";
+
+    out << "    {\n        ";
+    for(auto& line: p->Lines)
+    {
+        out << line.LineNumber << ", ";
+    }
+    out << "\n    },\n";
+
+    out << "};\n\n";
+}
+
+/// writes the code of the ByteCodeProgram of [vm] as the function RunProgram to [out]
+void EmitCode(PebbleVM* vm, std::ofstream& out)
+{
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+
+    out << "static int RunProgram(PebbleVM* vm, Program* p)\n{\n";
+    for(extArg_t id = 0; id < programEnd; id++)
+    {
+        out << CppCodeFor(vm, id);
+    }
+    out << LabelFor(programEnd) << ":\n    goto halt;\n\n";
+
+    out << "dispatch:\n    switch(vm->InstructionReg)\n    {\n";
+    for(extArg_t id = 0; id <= programEnd; id++)
+    {
+        out << "        case " << id << ": goto " << LabelFor(id) << ";\n";
+    }
+    out << "        default: goto halt;\n    }\n\n";
+
+    out << "error:\n"
+        << "    IfNeededDisplayError(vm, p);\n"
+        << "    if(vm->FatalErrorOccured)\n"
+        << "    {\n"
+        << "        GracefullyExit(vm);\n"
+        << "        return 1;\n"
+        << "    }\n"
+        << "    if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++;\n"
+        << "    goto dispatch;\n\n";
+
+    out << "halt:\n"
+        << "    GracefullyExit(vm);\n"
+        << "    return 0;\n"
+        << "}\n\n";
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Ahead-of-time compilation
+
+bool EmitCpp(PebbleVM* vm, const String& file, Program* p)
+{
+    std::ofstream out(file);
+    if(!out)
+    {
+        return false;
+    }
+
+    out << "// generated by pebble --emit-cpp. do not edit\n\n"
+        << "#include \"aot.h\"\n\n";
+
+    out << "// runtime settings, which pebble defines in main.cpp\n"
+        << "bool g_outputOn = true;\n"
+        << "bool g_useBytecodeRuntime = true;\n"
+        << "LogSeverityType LogAtLevel = LogSeverityType::Sev3_Critical;\n\n";
+
+    EmitTables(vm, out, p);
+    EmitCode(vm, out);
+
+    out << "int main()\n{\n    return RunAotProgram(Aot, RunProgram);\n}\n";
+
+    return out.good();
+}
+
+/// returns a new constant primitive of [vm] for [primitive]
+Call* PrimitiveCallFor(PebbleVM* vm, const AotPrimitive& primitive)
+{
+    Call* call = CallConstructor(vm->PrimitiveSlab);
+    if(primitive.Type == &IntegerType) call->BoundValue.i = primitive.Integer;
+    else if(primitive.Type == &DecimalType) call->BoundValue.d = primitive.Decimal;
+    else if(primitive.Type == &StringType) call->BoundValue.s = StringConstructor(primitive.Text);
+    else if(primitive.Type == &BooleanType) call->BoundValue.b = primitive.Boolean;
+
+    BindScope(call, &SomethingScope);
+    BindType(call, primitive.Type);
+    return call;
+}
+
+Program* LoadProgramTables(PebbleVM* vm, const AotProgram& aot)
+{
+    vm->ByteCodeProgram = aot.Instructions;
+    vm->CallNames = aot.CallNames;
+    vm->LocalSlots = aot.Slots;
+    vm->ByteCodeLineAssociation = aot.LineAssociation;
+
+    ReleaseConstPrimitives(vm);
+    for(auto& primitive: aot.Primitives)
+    {
+        vm->ConstPrimitives.push_back(PrimitiveCallFor(vm, primitive));
+    }
+
+    Program* program = new Program();
+    program->GlobalScope = nullptr;
+    program->Main = nullptr;
+    program->That = nullptr;
+    program->Lines.resize(aot.LineNumbers.size());
+    for(size_t i=0; i<aot.LineNumbers.size(); i++)
+    {
+        program->Lines[i].LineNumber = aot.LineNumbers[i];
+    }
+
+    return program;
+}
+
+int RunAotProgram(const AotProgram& aot, AotCode code)
+{
+    PebbleVM* vm = PebbleVMConstructor();
+    Program* program = LoadProgramTables(vm, aot);
+
+    InitRuntime(vm);
+    int exitCode = code(vm, program);
+
+    delete program;
+    PebbleVMDestructor(vm);
+    return exitCode;
+}
@@ -0,0 +1,67 @@
+#ifndef __AOT_H
+#define __AOT_H
+
+#include "abstract.h"
+#include "diagnostics.h"
+#include "program.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "call.h"
+#include "vm.h"
+#include "gc.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Ahead-of-time compilation
+//
+// with --emit-cpp, the ByteCodeProgram is written as a C++ translation unit instead
+// of being run. each instruction becomes a direct call to its BCI method and each
+// jump a goto, so the program runs without dispatch. the translation unit holds the
+// tables created by the flattener and is linked against every runtime object except
+// main.o and commandargs.o, ie. with `make program.aot` for program.cpp
+//
+// jumps whose target is only known at runtime (calls, returns and resuming after an
+// error) go through a single switch over every instruction id
+
+/// a constant primitive of a program compiled ahead of time
+/// [Type] is the type bound to the primitive
+/// [Integer], [Decimal], [Text] and [Boolean] hold the value for its type
+struct AotPrimitive
+{
+    BindingType Type;
+    int Integer;
+    double Decimal;
+    String Text;
+    bool Boolean;
+};
+
+/// the tables of a program compiled ahead of time, as created by the flattener
+/// [LineNumbers] is the line number of each line of the program
+struct AotProgram
+{
+    std::vector<ByteCodeInstruction> Instructions;
+    std::vector<String> CallNames;
+    std::vector<AotPrimitive> Primitives;
+    std::vector<LocalSlot> Slots;
+    std::vector<extArg_t> LineAssociation;
+    std::vector<int> LineNumbers;
+};
+
+/// the generated code of a program compiled ahead of time, which runs [p] in [vm]
+/// and returns its exit code
+typedef int (*AotCode)(PebbleVM* vm, Program* p);
+
+/// the file to write the C++ translation unit to, or empty if the program is run
+extern String g_emitCppFile;
+
+/// writes the ByteCodeProgram which [vm] holds for [p] as a C++ translation unit to
+/// [file]. returns false if the file could not be written
+bool EmitCpp(PebbleVM* vm, const String& file, Program* p);
+
+/// loads the tables of [aot] into [vm]. returns a Program which only holds the line
+/// numbers used to report errors, and must be deleted by the caller
+Program* LoadProgramTables(PebbleVM* vm, const AotProgram& aot);
+
+/// loads the tables of [aot] into a new vm and runs [code]. returns its exit code
+int RunAotProgram(const AotProgram& aot, AotCode code);
+
+#endif
@@ -12,22 +12,25 @@
 #include "scope.h"
 #include "value.h"
 
+#include <algorithm>
+#include <type_traits>
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Internal constructor wrappers
 
 /// wrapper for the ScopeConstructor used to create a new scope with
 /// [inheritedscope]
-inline Scope* InternalScopeConstructor(Scope* inheritedScope)
+inline Scope* InternalScopeConstructor(PebbleVM* vm, Scope* inheritedScope)
 {
-    auto scope = ScopeConstructor(inheritedScope);
-    AddRuntimeScope(scope);
+    auto scope = ScopeConstructor(vm->ScopeSlab, inheritedScope);
+    AddRuntimeScope(vm, scope);
 
     return scope;
 }
 
 /// wrapper for CopyScope used to copy [scopeToCopy] into a new scope
-inline Scope* InternalCopyScope(Scope* scopeToCopy)
+inline Scope* InternalCopyScope(PebbleVM* vm, Scope* scopeToCopy)
 {
     Scope* scope;
     if(scopeToCopy == &NothingScope)
@@ -36,132 +39,121 @@ inline Scope* InternalCopyScope(Scope* scopeToCopy)
     }
     else
     {
-        scope = CopyScope(scopeToCopy);
-        AddRuntimeScope(scope);
+        scope = CopyScope(scopeToCopy, vm->ScopeSlab, vm->CallSlab);
+        AddRuntimeScope(vm, scope);
+        for(auto call: scope->CallsIndex)
+        {
+            AddRuntimeCall(vm, call);
+        }
+        for(auto call: scope->Elements)
+        {
+            AddRuntimeCall(vm, call);
+        }
     }
 
     return scope;
 }
 
 /// wrapper for CallConstructor to create a new call with [name]
-inline Call* InternalCallConstructor(const String* name=nullptr)
+inline Call* InternalCallConstructor(PebbleVM* vm, const String* name=nullptr)
 {
-    Call* call = CallConstructor(name);
+    Call* call = CallConstructor(vm->CallSlab, name);
     BindScope(call, &NothingScope);
     BindType(call, &NothingType);
-    AddRuntimeCall(call);
+    AddRuntimeCall(vm, call);
 
     return call;
 }
 
-inline Call* InternalSharedPrimitiveCallConstructor()
+inline Call* InternalSharedPrimitiveCallConstructor(PebbleVM* vm)
 {
-    auto call = InternalCallConstructor();
+    auto call = InternalCallConstructor(vm);
     BindScope(call, &SomethingScope);
     return call;
 }
 
 /// wrapper to construct a call for a primitive [value] enforcing the 
 /// prior that a given primitive value should only have one constructed call
-Call* InternalPrimitiveCallConstructor(int value)
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, int value)
 {
-    Call* foundCall = nullptr;
-    if(ListContainsPrimitiveCall(RuntimeCalls, value, &foundCall))
-    {
-        return foundCall;
-    }
-    else if(ListContainsPrimitiveCall(ConstPrimitives, value, &foundCall))
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
     {
         return foundCall;
     }
-    else
-    {
-        Call* call = InternalSharedPrimitiveCallConstructor();
-        BindType(call, &IntegerType);
-        AssignValue(call->BoundValue, value);
-        return call;
-    }
+
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &IntegerType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
 }
 
 /// wrapper to construct a call for a primitive [value] enforcing the 
 /// prior that a given primitive value should only have one constructed call
-Call* InternalPrimitiveCallConstructor(double value)
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, double value)
 {
-    Call* foundCall = nullptr;
-    if(ListContainsPrimitiveCall(RuntimeCalls, value, &foundCall))
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
     {
         return foundCall;
     }
-    else if(ListContainsPrimitiveCall(ConstPrimitives, value, &foundCall))
-    {
-        return foundCall;
-    }
-    else
-    {
-        Call* call = InternalSharedPrimitiveCallConstructor();
-        BindType(call, &DecimalType);
-        AssignValue(call->BoundValue, value);
 
-        return call;
-    }
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &DecimalType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
 }
 
 /// wrapper to construct a call for a primitive [value] enforcing the 
 /// prior that a given primitive value should only have one constructed call
-Call* InternalPrimitiveCallConstructor(bool value)
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, bool value)
 {
-    Call* foundCall = nullptr;
-    if(ListContainsPrimitiveCall(RuntimeCalls, value, &foundCall))
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
     {
         return foundCall;
     }
-    else if(ListContainsPrimitiveCall(ConstPrimitives, value, &foundCall))
-    {
-        return foundCall;
-    }
-    else
-    {
-        Call* call = InternalSharedPrimitiveCallConstructor();
-        BindType(call, &BooleanType);
-        AssignValue(call->BoundValue, value);
 
-        return call;
-    }
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &BooleanType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
 }
 
 /// wrapper to construct a call for a primitive [value] enforcing the 
 /// prior that a given primitive value should only have one constructed call
-Call* InternalPrimitiveCallConstructor(String& value)
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, String& value)
 {
-    Call* foundCall = nullptr;
-    if(ListContainsPrimitiveCall(RuntimeCalls, value, &foundCall))
-    {
-        return foundCall;
-    }
-    else if(ListContainsPrimitiveCall(ConstPrimitives, value, &foundCall))
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
     {
         return foundCall;
     }
-    else
-    {
-        Call* call = InternalSharedPrimitiveCallConstructor();
-        BindType(call, &StringType);
-        AssignValue(call->BoundValue, value);
 
-        return call;
-    }
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &StringType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
 }
 
-Call* InternalCopyCall(const Call* call)
+Call* InternalCopyCall(PebbleVM* vm, const Call* call)
 {
     if(call == &NothingCall)
     {
         return &NothingCall;
     }
     
-    auto callCopy = InternalCallConstructor();
+    auto callCopy = InternalCallConstructor(vm);
     
-    auto scp = InternalCopyScope(call->BoundScope);
+    auto scp = InternalCopyScope(vm, call->BoundScope);
     BindScope(callCopy, scp);
     BindType(callCopy, call->BoundType);
     BindSection(callCopy, call->BoundSection);
@@ -240,47 +232,256 @@ BCI_Method BCI_Instructions[] = {
     BCI_Array,
     BCI_EnterLocal,
     BCI_LeaveLocal,
-    BCI_Extend,
-
     BCI_NOP,
+
     BCI_Dup,
     BCI_EndLine,
     BCI_DropTOS,
     BCI_Is,
+    BCI_LoadLocal,
+
+    BCI_StoreLocal,
+    BCI_ResolveName,
+    BCI_AddConst,
+    BCI_SubtractConst,
+    BCI_CmpJumpFalse,
+
+    BCI_TailEval,
+};
+
+/// names of the instructions in BCI_Instructions, in the same order
+const char* const BCI_InstructionNames[] = {
+    "BCI_LoadCallName",
+    "BCI_LoadPrimitive",
+    "BCI_Assign",
+    "BCI_Add",
+    "BCI_Subtract",
+
+    "BCI_Multiply",
+    "BCI_Divide",
+    "BCI_SysCall",
+    "BCI_And",
+    "BCI_Or",
+    
+    "BCI_Not",
+    "BCI_NotEquals",
+    "BCI_Equals",
+    "BCI_Cmp",
+    "BCI_LoadCmp",
+
+    "BCI_JumpFalse",
+    "BCI_Jump",
+    "BCI_Copy",
+    "BCI_BindType",
+    "BCI_ResolveDirect",
+
+    "BCI_ResolveScoped",
+    "BCI_BindScope",
+    "BCI_BindSection",
+    "BCI_EvalHere",
+    "BCI_Eval",
+
+    "BCI_Return",
+    "BCI_Array",
+    "BCI_EnterLocal",
+    "BCI_LeaveLocal",
+    "BCI_NOP",
+
+    "BCI_Dup",
+    "BCI_EndLine",
+    "BCI_DropTOS",
+    "BCI_Is",
+    "BCI_LoadLocal",
+
+    "BCI_StoreLocal",
+    "BCI_ResolveName",
+    "BCI_AddConst",
+    "BCI_SubtractConst",
+    "BCI_CmpJumpFalse",
+
+    "BCI_TailEval",
 };
 
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Immediate values
+// an Integer or Boolean result which has not yet been bound to a name is left on
+// the MemoryStack as a tagged word instead of as a <Call>. every pointer on the
+// MemoryStack is aligned, so the low bits of a word tell the two apart. a <Call> 
+// is only made for an immediate when it escapes (i.e. is used by an instruction 
+// which does not understand immediates), and it is then the interned primitive
+
+/// mask of the bits of a word on the MemoryStack which hold its tag
+constexpr uintptr_t ImmediateTagMask = 0x3;
+
+/// number of bits used by the tag of an immediate
+constexpr int ImmediateTagBits = 2;
+
+/// tag of an immediate holding an Integer
+constexpr uintptr_t IntegerImmediateTag = 0x1;
+
+/// tag of an immediate holding a Boolean
+constexpr uintptr_t BooleanImmediateTag = 0x2;
+
+/// true if [word] is an immediate rather than a pointer
+inline bool IsImmediate(const void* word)
+{
+    static_assert(std::alignment_of<Call>::value > ImmediateTagMask, "a Call pointer must leave the tag bits clear");
+    static_assert(std::alignment_of<Scope>::value > ImmediateTagMask, "a Scope pointer must leave the tag bits clear");
+    static_assert(std::alignment_of<String>::value > ImmediateTagMask, "a String pointer must leave the tag bits clear");
+
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) != 0;
+}
+
+/// true if [word] is an immediate holding an Integer
+inline bool IsIntegerImmediate(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) == IntegerImmediateTag;
+}
+
+/// true if [word] is an immediate holding a Boolean
+inline bool IsBooleanImmediate(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) == BooleanImmediateTag;
+}
+
+/// returns the immediate holding the Integer [value]
+inline void* IntegerImmediate(int value)
+{
+    auto bits = static_cast<uintptr_t>(static_cast<intptr_t>(value));
+    return reinterpret_cast<void*>((bits << ImmediateTagBits) | IntegerImmediateTag);
+}
+
+/// returns the immediate holding the Boolean [value]
+inline void* BooleanImmediate(bool value)
+{
+    auto bits = static_cast<uintptr_t>(value);
+    return reinterpret_cast<void*>((bits << ImmediateTagBits) | BooleanImmediateTag);
+}
+
+/// returns the Integer held by the immediate [word]
+inline int IntegerOfImmediate(const void* word)
+{
+    return static_cast<int>(reinterpret_cast<intptr_t>(word) >> ImmediateTagBits);
+}
+
+/// returns the Boolean held by the immediate [word]
+inline bool BooleanOfImmediate(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) >> ImmediateTagBits) != 0;
+}
+
+/// returns the <Call> for [word], which is the interned primitive if [word] is 
+/// an immediate
+inline Call* CallOfWord(PebbleVM* vm, void* word)
+{
+    if(IsIntegerImmediate(word))
+    {
+        return InternalPrimitiveCallConstructor(vm, IntegerOfImmediate(word));
+    }
+    if(IsBooleanImmediate(word))
+    {
+        return InternalPrimitiveCallConstructor(vm, BooleanOfImmediate(word));
+    }
+    return static_cast<Call*>(word);
+}
+
+/// true if [word] is strictly an Integer, in which case its value is stored in
+/// [value]. [word] must be an immediate or a <Call>
+inline bool IntegerOfWord(const void* word, int& value)
+{
+    if(IsIntegerImmediate(word))
+    {
+        value = IntegerOfImmediate(word);
+        return true;
+    }
+    if(IsImmediate(word))
+    {
+        return false;
+    }
+
+    auto call = static_cast<const Call*>(word);
+    if(Strictly(&IntegerType, call))
+    {
+        value = IntegerValueOf(call);
+        return true;
+    }
+    return false;
+}
+
+/// fills [call] with the bindings of the primitive <Call> of the immediate [word], 
+/// without constructing or interning it
+inline void BindImmediate(Call* call, const void* word)
+{
+    call->Name = nullptr;
+    call->BoundSection = 0;
+    call->BoundScope = &SomethingScope;
+    call->CallType = nullptr;
+    call->BoundValue.s = 0;
+    call->NumberOfParameters = 0;
+
+    if(IsIntegerImmediate(word))
+    {
+        call->BoundType = &IntegerType;
+        AssignValue(call->BoundValue, IntegerOfImmediate(word));
+    }
+    else
+    {
+        call->BoundType = &BooleanType;
+        AssignValue(call->BoundValue, BooleanOfImmediate(word));
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Memory stack helpers
 
-/// pop a pointer of <T> from the top of the MemoryStack
+/// pop a pointer of <T> from the top of the MemoryStack. an immediate popped as a
+/// <Call> is given its <Call>
 template <typename T>
-inline T* PopTOS()
+inline T* PopTOS(PebbleVM* vm)
 {
-    T* tos = static_cast<T*>(MemoryStack.back());
-    MemoryStack.pop_back();
-    return tos;
+    void* tos = vm->MemoryStack.back();
+    vm->MemoryStack.pop_back();
+    if constexpr (std::is_same<T, Call>::value)
+    {
+        return CallOfWord(vm, tos);
+    }
+    return static_cast<T*>(tos);
 }
 
 /// push a pointer of <T> to [entity] onto the MemoryStack
 template <typename T>
-inline void PushTOS(T* entity)
+inline void PushTOS(PebbleVM* vm, T* entity)
 {
-    MemoryStack.push_back(static_cast<void*>(entity));
+    vm->MemoryStack.push_back(static_cast<void*>(entity));
 }
 
-/// peek a pointer of <T> to the top of the MemoryStack
+/// peek a pointer of <T> to the entity [depth] words below the top of the MemoryStack.
+/// an immediate peeked as a <Call> is replaced by its <Call>
 template <typename T>
-inline T* PeekTOS()
+inline T* PeekTOS(PebbleVM* vm, size_t depth=0)
 {
-    return static_cast<T*>(MemoryStack.back());
+    auto& word = vm->MemoryStack[vm->MemoryStack.size() - 1 - depth];
+    if constexpr (std::is_same<T, Call>::value)
+    {
+        word = CallOfWord(vm, word);
+    }
+    return static_cast<T*>(word);
+}
+
+/// removes the [n] topmost words of the MemoryStack without reading them
+inline void DropFromTOS(PebbleVM* vm, size_t n)
+{
+    vm->MemoryStack.resize(vm->MemoryStack.size() - n);
 }
 
 /// return the size of the MemoryStack
-inline size_t MemoryStackSize()
+inline size_t MemoryStackSize(PebbleVM* vm)
 {
-    return MemoryStack.size();
+    return vm->MemoryStack.size();
 }
 
 
@@ -291,12 +492,7 @@ inline size_t MemoryStackSize()
 /// the inherited scope
 inline Call* FindInScopeOnlyImmediate(Scope* scope, const String* callName)
 {
-    for(auto call: scope->CallsIndex)
-    {
-        if(call->Name == callName)
-            return call;
-    }
-    return nullptr;
+    return scope->CallsIndex.Find(callName);
 }
 
 /// finds and returns a Reference with [callName] in [scope] and checks
@@ -305,15 +501,39 @@ inline Call* FindInScopeChain(Scope* scope, const String* callName)
 {
     for(auto s = scope; s != nullptr; s = s->InheritedScope)
     {
-        for(auto call: s->CallsIndex)
-        {
-            if(call->Name == callName)
-                return call;
-        }
+        auto call = s->CallsIndex.Find(callName);
+        if(call != nullptr)
+            return call;
     }
     return nullptr;
 }
 
+/// returns the call named by [slot] if it is at the expected index of the scope of
+/// SelfReg and BCI_ResolveDirect would resolve the same call, otherwise nullptr
+inline Call* FindInLocalSlot(PebbleVM* vm, const LocalSlot& slot)
+{
+    auto& calls = vm->SelfReg->BoundScope->CallsIndex;
+    if(slot.Slot >= calls.size() || vm->LocalScopeIsDetachedReg)
+    {
+        return nullptr;
+    }
+
+    auto call = calls[slot.Slot];
+    auto callName = &vm->CallNames[slot.NameId - SIMPLE_CALLS];
+    if(call->Name != callName)
+    {
+        return nullptr;
+    }
+
+    /// an anonymous local scope is searched before the scope of SelfReg
+    if(vm->LocalScopeReg != vm->SelfReg->BoundScope && FindInScopeOnlyImmediate(vm->LocalScopeReg, callName) != nullptr)
+    {
+        return nullptr;
+    }
+
+    return call;
+}
+
 /// returns the Scope bound to [call]
 inline Scope* ScopeOf(Call* call)
 {
@@ -326,52 +546,73 @@ inline Scope* ScopeOf(Call* call)
 // Instruction jump helpers
 
 /// sets the jump location to [ins] and notifies the vm to jump
-inline void InternalJumpTo(extArg_t ins)
-{
-    InstructionReg = ins;
-    JumpStatusReg = 1;
-}
-
-/// add a new CallFrame to the CallStack with [caller] and [self] the new caller and self
-/// objects. changes registers appropriately but does not change the instruction pointer
-inline void EnterNewCallFrame(extArg_t callerRefId, Call* caller, Call* self)
+inline void InternalJumpTo(PebbleVM* vm, extArg_t ins)
 {
-    std::vector<LabeledScope> localScopeStack;
-    CallStack.push_back({ InstructionReg+1, MemoryStackSize(), callerRefId, localScopeStack, LastResultReg });
-    PushTOS<Call>(caller);
-    PushTOS<Call>(self);
-
-    CallerReg = caller;
-    SelfReg = self;
-    LocalScopeReg = self->BoundScope;
-    LastResultReg = nullptr;
-    LocalScopeIsDetachedReg = false;
+    vm->InstructionReg = ins;
+    vm->JumpStatusReg = 1;
 }
 
 /// changes the LocalScopeReg whenever a LocalScope change occurs. the base scope
 /// is either the program scope or the self object scope
-void AdjustLocalScopeReg()
+void AdjustLocalScopeReg(PebbleVM* vm)
 {
-    if(LocalScopeStack().size() == 0)
+    if(LocalScopeDepth(vm) == 0)
     {
-        if(SelfReg->BoundScope != &NothingScope)
+        if(vm->SelfReg->BoundScope != &NothingScope)
         {
-            LocalScopeReg = SelfReg->BoundScope;
+            vm->LocalScopeReg = vm->SelfReg->BoundScope;
         }
         else
         {
-            LocalScopeReg = ProgramReg;
+            vm->LocalScopeReg = vm->ProgramReg;
         }
 
-        LocalScopeIsDetachedReg = false;
+        vm->LocalScopeIsDetachedReg = false;
     }
     else
     {
-        LocalScopeReg = LocalScopeStack().back().Value;
-        LocalScopeIsDetachedReg = LocalScopeStack().back().IsDetached;
+        vm->LocalScopeReg = vm->LocalScopes.back().Value;
+        vm->LocalScopeIsDetachedReg = vm->LocalScopes.back().IsDetached;
     }
 }
 
+/// pushes [caller] and [self] to the start of the current CallFrame and makes them
+/// the new caller and self objects. a frame whose self is Nothing (ie. a method
+/// evaluated here at the program level) uses the program scope, so calls are never
+/// added to the shared NothingScope
+inline void StartCallFrame(PebbleVM* vm, Call* caller, Call* self)
+{
+    PushTOS<Call>(vm, caller);
+    PushTOS<Call>(vm, self);
+
+    vm->CallerReg = caller;
+    vm->SelfReg = self;
+    vm->LastResultReg = nullptr;
+    AdjustLocalScopeReg(vm);
+}
+
+/// add a new CallFrame to the CallStack with [caller] and [self] the new caller and self
+/// objects. changes registers appropriately but does not change the instruction pointer
+inline void EnterNewCallFrame(PebbleVM* vm, extArg_t callerRefId, Call* caller, Call* self)
+{
+    extArg_t localScopesStart = vm->LocalScopes.size();
+    vm->CallStack.push_back({ vm->InstructionReg+1, MemoryStackSize(vm), callerRefId, localScopesStart, vm->LastResultReg });
+    vm->MaxCallStackSize = std::max(vm->MaxCallStackSize, vm->CallStack.size());
+    StartCallFrame(vm, caller, self);
+}
+
+/// replace the current CallFrame with one for [caller] and [self]. the frame keeps
+/// the instruction and result it returns to, so a method called in tail position 
+/// returns directly to the caller of the current method
+inline void ReuseCallFrame(PebbleVM* vm, Call* caller, Call* self)
+{
+    auto& frame = vm->CallStack.back();
+    vm->MemoryStack.resize(frame.MemoryStackStart);
+    vm->LocalScopes.resize(frame.LocalScopesStart);
+    StartCallFrame(vm, caller, self);
+}
+
+
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -438,56 +679,59 @@ inline bool NthBit(uint8_t data, int n)
 }
 
 /// fills in <= >= using the comparisions already made
-inline void FillInRestOfComparisons()
+inline void FillInRestOfComparisons(PebbleVM* vm)
 {
-    uint8_t geq = NthBit(CmpReg, 2) | NthBit(CmpReg, 4);
-    uint8_t leq = NthBit(CmpReg, 2) | NthBit(CmpReg, 3);
+    uint8_t geq = NthBit(vm->CmpReg, 2) | NthBit(vm->CmpReg, 4);
+    uint8_t leq = NthBit(vm->CmpReg, 2) | NthBit(vm->CmpReg, 3);
 
-    CmpReg = CmpReg | (geq << 6) | (leq << 5);
+    vm->CmpReg = vm->CmpReg | (geq << 6) | (leq << 5);
 }
 
-/// sets CmpReg to the result of comparing [lhs] and [rhs] as integers
-inline void CompareIntegers(const Call* lhs, const Call* rhs)
+/// sets CmpReg to the result of comparing the integers [lVal] and [rVal]
+inline void CompareIntegerValues(PebbleVM* vm, int lVal, int rVal)
 {
-    int lVal = IntegerValueOf(lhs);
-    int rVal = IntegerValueOf(rhs);
-
     if(lVal < rVal)
     {
-        CmpReg = CmpReg | (BitFlag << 3);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 3);
     }
     else if(lVal > rVal)
     {
-        CmpReg = CmpReg | (BitFlag << 4);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 4);
     }
     else
     {
-        CmpReg = CmpReg | (BitFlag << 2);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 2);
     }
 
-    FillInRestOfComparisons();
+    FillInRestOfComparisons(vm);
+}
+
+/// sets CmpReg to the result of comparing [lhs] and [rhs] as integers
+inline void CompareIntegers(PebbleVM* vm, const Call* lhs, const Call* rhs)
+{
+    CompareIntegerValues(vm, IntegerValueOf(lhs), IntegerValueOf(rhs));
 }
 
 /// sets CmpReg to the result of comparing [lhs] and [rhs] as decimals
-inline void CompareDecimals(const Call* lhs, const Call* rhs)
+inline void CompareDecimals(PebbleVM* vm, const Call* lhs, const Call* rhs)
 {
     double lVal = DecimalValueOf(lhs);
     double rVal = DecimalValueOf(rhs);
 
     if(lVal < rVal)
     {
-        CmpReg = CmpReg | (BitFlag << 3);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 3);
     }
     else if(lVal > rVal)
     {
-        CmpReg = CmpReg | (BitFlag << 4);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 4);
     }
     else
     {
-        CmpReg = CmpReg | (BitFlag << 2);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 2);
     }
 
-    FillInRestOfComparisons();
+    FillInRestOfComparisons(vm);
 }
 
 
@@ -496,9 +740,10 @@ inline void CompareDecimals(const Call* lhs, const Call* rhs)
 // ---------------------------------------------------------------------------------------------------------------------
 // Binary operation helpers
 
-typedef Call* (*InternalFunction)(size_t i, const Call* lhs, const Call* rhs);
+typedef Call* (*InternalFunction)(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
 
 Call* ApplyFunction(
+    PebbleVM* vm, 
     InternalFunction func, 
     Call* lhs, 
     Call* rhs, 
@@ -512,7 +757,7 @@ Call* ApplyFunction(
         {
             if(Both(Strictly, types[i], lhs, rhs))
             {
-                call = func(i, lhs, rhs);
+                call = func(vm, i, lhs, rhs);
             }
             else
             {
@@ -540,7 +785,7 @@ BindingType AddTypes[] = {
 
 size_t nAddTypes = 3;
 
-Call* AddFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* AddFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -548,21 +793,21 @@ Call* AddFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             int ans = IntegerValueOf(lhs) + IntegerValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
         case 1:
         {
             double ans = DecimalValueOf(lhs) + DecimalValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans);
+            call = InternalPrimitiveCallConstructor(vm, ans);
             break;
         }
 
         case 2:
         {
             String ans = StringValueOf(lhs) + StringValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans);
+            call = InternalPrimitiveCallConstructor(vm, ans);
             break;
         }
 
@@ -581,7 +826,7 @@ BindingType GenericMathTypes[] =
 
 size_t nGenericMathTypes = 2;
 
-Call* SubtractFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* SubtractFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -589,14 +834,14 @@ Call* SubtractFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             int ans = IntegerValueOf(lhs) - IntegerValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
         case 1:
         {
             double ans = DecimalValueOf(lhs) - DecimalValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans);
+            call = InternalPrimitiveCallConstructor(vm, ans);
             break;
         }
 
@@ -607,7 +852,7 @@ Call* SubtractFunction(size_t i, const Call* lhs, const Call* rhs)
     return call;
 }
 
-Call* MultiplyFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* MultiplyFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -615,14 +860,14 @@ Call* MultiplyFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             int ans = IntegerValueOf(lhs) * IntegerValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
         case 1:
         {
             double ans = DecimalValueOf(lhs) * DecimalValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans);
+            call = InternalPrimitiveCallConstructor(vm, ans);
             break;
         }
 
@@ -633,7 +878,7 @@ Call* MultiplyFunction(size_t i, const Call* lhs, const Call* rhs)
     return call;
 }
 
-Call* DivideFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* DivideFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -641,14 +886,14 @@ Call* DivideFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             int ans = IntegerValueOf(lhs) / IntegerValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
         case 1:
         {
             double ans = DecimalValueOf(lhs) / DecimalValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans);
+            call = InternalPrimitiveCallConstructor(vm, ans);
             break;
         }
 
@@ -666,7 +911,7 @@ BindingType GenericBooleanTypes[] =
 
 size_t nGenericBooleanTypes = 1;
 
-Call* AndFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* AndFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -674,7 +919,7 @@ Call* AndFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             bool ans = BooleanValueOf(lhs) && BooleanValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
@@ -685,7 +930,7 @@ Call* AndFunction(size_t i, const Call* lhs, const Call* rhs)
     return call;
 }
 
-Call* OrFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* OrFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
@@ -693,7 +938,7 @@ Call* OrFunction(size_t i, const Call* lhs, const Call* rhs)
         case 0:
         {
             bool ans = BooleanValueOf(lhs) && BooleanValueOf(rhs);
-            call = InternalPrimitiveCallConstructor(ans); 
+            call = InternalPrimitiveCallConstructor(vm, ans); 
             break;
         }
 
@@ -704,20 +949,20 @@ Call* OrFunction(size_t i, const Call* lhs, const Call* rhs)
     return call;
 }
 
-Call* CmpFunction(size_t i, const Call* lhs, const Call* rhs)
+Call* CmpFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
 {
     Call* call = &NothingCall;
     switch(i)
     {
         case 0:
         {
-            CompareIntegers(lhs, rhs);
+            CompareIntegers(vm, lhs, rhs);
             break;
         }
 
         case 1:
         {
-            CompareDecimals(lhs, rhs);
+            CompareDecimals(vm, lhs, rhs);
             break;
         }
 
@@ -759,11 +1004,11 @@ inline void DoInternalAssign(Call* lhs, const Call* rhs)
     EnforceCallType(lhs, rhs->BoundType);
 }
 
-inline void InternalAssign(Call* lhs, const Call* rhs)
+inline void InternalAssign(PebbleVM* vm, Call* lhs, const Call* rhs)
 {
     if(IsUnassignable(lhs))
     {
-        ReportFatalError(SystemMessageType::Exception, 7, 
+        ReportFatalError(vm, SystemMessageType::Exception, 7, 
             Msg("cannot reassign the global call %s", *lhs->Name));
         return;
     }
@@ -785,13 +1030,27 @@ inline void InternalAssign(Call* lhs, const Call* rhs)
         }
         else
         {
-            ReportFatalError(SystemMessageType::Exception, 0,
+            ReportFatalError(vm, SystemMessageType::Exception, 0,
                 Msg("cannot assign a %s to be a %s", CallTypeToString(lhs), CallTypeToString(rhs)));
             return;
         }
     }
 }
 
+/// assigns [lhs] to the bindings of [word], which may be an immediate
+inline void InternalAssignWord(PebbleVM* vm, Call* lhs, void* word)
+{
+    if(IsImmediate(word))
+    {
+        Call rhs;
+        BindImmediate(&rhs, word);
+        InternalAssign(vm, lhs, &rhs);
+        return;
+    }
+
+    InternalAssign(vm, lhs, static_cast<Call*>(word));
+}
+
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -842,63 +1101,65 @@ inline bool CallsAreEqual(const Call* call1, const Call* call2)
 
 /// resolves [callName] which is a keyword to the appropriate call which is 
 /// pushed to TOS
-inline void ResolveKeywordCall(const String* callName)
+inline void ResolveKeywordCall(PebbleVM* vm, const String* callName)
 {
     Call* call = &NothingCall;
     if(*callName == "caller")
     {
-        call = CallerReg;
+        call = vm->CallerReg;
     }
     else if(*callName == "self")
     {
-        call = SelfReg;
+        call = vm->SelfReg;
     }
     else
     {
-        if(LastResultReg == nullptr)
+        if(vm->LastResultReg == nullptr)
         {
             call = &NothingCall;
         }
         else
         {
-            call = LastResultReg;
+            call = vm->LastResultReg;
         }
     }
 
-    PushTOS<Call>(call);
+    PushTOS<Call>(vm, call);
 }
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Array helpers
 
-/// built in method to initialize a new array and push it onto TOS
-inline void HandleArrayInitialization(Call* caller, Call* size)
+/// built in method to initialize a new array and push it onto TOS. the elements 
+/// are kept in index order in the Elements of the array's scope
+inline void HandleArrayInitialization(PebbleVM* vm, Call* caller, Call* size)
 {
-    int arraySize = IntegerValueOf(size);
-    IfNeededAddArrayIndexCalls(arraySize);
+    int arraySize = std::max(IntegerValueOf(size), 0);
+    auto& elements = ScopeOf(caller)->Elements;
+    elements.reserve(elements.size() + arraySize);
     for(int i=0; i<arraySize; i++)
     {
-        auto callatIndex = InternalCallConstructor(CallNamePointerFor(i));
-        AddCallToScope(callatIndex, ScopeOf(caller));
+        elements.push_back(InternalCallConstructor(vm, &ArrayElementCallName));
     }
 
-    auto sizeCall = InternalCallConstructor(&SizeCallName);
+    auto sizeCall = InternalCallConstructor(vm, vm->SizeCallNamePointer);
+    BindScope(sizeCall, &SomethingScope);
     BindType(sizeCall, &IntegerType);
     AssignValue(sizeCall->BoundValue, arraySize);
     AddCallToScope(sizeCall, ScopeOf(caller));
 
-    PushTOS<Call>(caller);
+    PushTOS<Call>(vm, caller);
 }
 
 /// build in method to initialize a new object and push it onto TOS
-inline void HandleObjectInitialization(Call* call)
+inline void HandleObjectInitialization(PebbleVM* vm, Call* call)
 {
-    auto newObjectCall = InternalCallConstructor();
+    auto newObjectCall = InternalCallConstructor(vm);
     BindType(newObjectCall, &ObjectType);
-    BindScope(newObjectCall, InternalScopeConstructor(nullptr));
+    BindScope(newObjectCall, InternalScopeConstructor(vm, nullptr));
     
-    PushTOS<Call>(newObjectCall);
+    PushTOS<Call>(vm, newObjectCall);
 }
 
 /// true if a type corresponds to a primitive, predefined method
@@ -910,12 +1171,14 @@ inline bool IsPrimitiveMethodType(const BindingType type)
         || type == &AbstractObjectType; 
 }
 
-void HandlePrimitiveTypeInstantiation(Call* simpleCall, Call** paramsList, bool inPlace)
+/// runs the built in method of [simpleCall] with the [params] still on the MemoryStack
+/// and removes the [nWords] used by the evaluation from the MemoryStack
+void HandlePrimitiveTypeInstantiation(PebbleVM* vm, Call* simpleCall, void** params, extArg_t nWords, bool inPlace)
 {
     Call* callToInitialize = nullptr;
     if(inPlace)
     {
-        callToInitialize = SelfReg;
+        callToInitialize = vm->SelfReg;
     }
     else
     {
@@ -924,11 +1187,18 @@ void HandlePrimitiveTypeInstantiation(Call* simpleCall, Call** paramsList, bool
 
     if(Loosely(&ArrayType, simpleCall) || Loosely(&AbstractArrayType, simpleCall))
     {
-        HandleArrayInitialization(callToInitialize, paramsList[0]);
+        auto size = CallOfWord(vm, params[0]);
+        DropFromTOS(vm, nWords);
+        HandleArrayInitialization(vm, callToInitialize, size);
     }
     else if(Loosely(&ObjectType, simpleCall) || Loosely(&AbstractObjectType, simpleCall))
     {
-        HandleObjectInitialization(callToInitialize);
+        DropFromTOS(vm, nWords);
+        HandleObjectInitialization(vm, callToInitialize);
+    }
+    else
+    {
+        DropFromTOS(vm, nWords);
     }
 }
 
@@ -937,63 +1207,73 @@ void HandlePrimitiveTypeInstantiation(Call* simpleCall, Call** paramsList, bool
 // ---------------------------------------------------------------------------------------------------------------------
 // Eval instruction helpers
 
-/// add a list of Calls [paramsList] to the scope of [methodCall] in reverse order
-/// used when evaluating a method
-inline void AddParamsToMethodScope(Call* methodCall, Call** paramsList, extArg_t nParams)
+/// assign the [params] to the parameters in the scope of [methodCall], in the
+/// order they were pushed. used when evaluating a method
+inline void AddParamsToMethodScope(PebbleVM* vm, Call* methodCall, void** params)
 {
     for(size_t i =0; i<methodCall->NumberOfParameters; i++)
     {
         auto methodParam = methodCall->BoundScope->CallsIndex[i];
-        auto paramInput = paramsList[nParams-1-i];
-        InternalAssign(methodParam, paramInput);
+        InternalAssignWord(vm, methodParam, params[i]);
     }
 }
 
-/// pops [numParams] objects from the MemoryStack and returns a list of these elements
-/// (which is the reverse order due to the push/pop algorithm)
-inline Call** GetParameters(extArg_t numParams)
+/// returns the [numParams] topmost words of the MemoryStack, in the order they were
+/// pushed. the parameters are read in place and stay on the MemoryStack until 
+/// they are dropped
+inline void** ParametersOnStack(PebbleVM* vm, extArg_t numParams)
 {
-    Call** params = new Call*[numParams];
-    for(extArg_t i=0; i<numParams; i++)
-    {
-        params[i] = PopTOS<Call>();
-    }
-    
-    return params;
+    return vm->MemoryStack.data() + vm->MemoryStack.size() - numParams;
 }
 
-/// defines the logic to evaluate the section bound to a given call
-inline void InternalEval(Call* methodCall, Call* caller, Call** paramsList, extArg_t nParams, bool inPlace)
+/// true if evaluating [methodCall] with [nParams] parameters jumps to its section and
+/// enters a new CallFrame
+inline bool EvalEntersCallFrame(Call* methodCall, extArg_t nParams)
+{
+    return !IsPureNothing(methodCall)
+        && nParams == methodCall->NumberOfParameters
+        && !IsPrimitiveMethodType(methodCall->BoundType)
+        && methodCall->BoundSection != 0;
+}
+
+/// defines the logic to evaluate the section bound to a given call. [params] are 
+/// the [nParams] parameters on the MemoryStack, and [nWords] is the number of words
+/// of the MemoryStack used by the evaluation, which are dropped before anything is
+/// pushed
+inline void InternalEval(PebbleVM* vm, Call* methodCall, Call* caller, void** params, extArg_t nParams, extArg_t nWords, bool inPlace)
 {
     if(IsPureNothing(methodCall))
     {
-        PushTOS<Call>(&NothingCall);
+        DropFromTOS(vm, nWords);
+        PushTOS<Call>(vm, &NothingCall);
         return;
     }
 
     if(nParams != methodCall->NumberOfParameters)
     {
-        ReportFatalError(SystemMessageType::Exception, 2, 
+        DropFromTOS(vm, nWords);
+        ReportFatalError(vm, SystemMessageType::Exception, 2, 
             Msg("expected %i arguments but got %i", methodCall->NumberOfParameters, nParams));
         return;
     }
 
     if(IsPrimitiveMethodType(methodCall->BoundType))
     {
-        HandlePrimitiveTypeInstantiation(methodCall, paramsList, inPlace);
+        HandlePrimitiveTypeInstantiation(vm, methodCall, params, nWords, inPlace);
         return;
     }
 
     if(methodCall->BoundSection == 0)
     {
+        DropFromTOS(vm, nWords);
         auto methodName = (methodCall->Name == nullptr ? "anonymous variable" : *methodCall->Name);
-        ReportFatalError(SystemMessageType::Exception, 3, Msg("%s cannot be called", methodName));
+        ReportFatalError(vm, SystemMessageType::Exception, 3, Msg("%s cannot be called", methodName));
         return;
     }
 
     if(methodCall->BoundScope == &NothingScope)
     {
-        BindScope(methodCall, InternalScopeConstructor(nullptr));
+        BindScope(methodCall, InternalScopeConstructor(vm, nullptr));
     }
 
     extArg_t jumpIns = methodCall->BoundSection;
@@ -1004,22 +1284,24 @@ inline void InternalEval(Call* methodCall, Call* caller, Call** paramsList, extA
     {
         if(nParams != 0)
         {
-            AddParamsToMethodScope(SelfReg, paramsList, nParams);
+            AddParamsToMethodScope(vm, vm->SelfReg, params);
         }
 
-        EnterNewCallFrame(0, CallerReg, SelfReg);
+        DropFromTOS(vm, nWords);
+        EnterNewCallFrame(vm, 0, vm->CallerReg, vm->SelfReg);
     }
     else
     {
         if(nParams != 0)
         {
-            AddParamsToMethodScope(methodCall, paramsList, nParams);
+            AddParamsToMethodScope(vm, methodCall, params);
         }
 
-        EnterNewCallFrame(0, caller, methodCall);
+        DropFromTOS(vm, nWords);
+        EnterNewCallFrame(vm, 0, caller, methodCall);
     }
 
-    InternalJumpTo(jumpIns);
+    InternalJumpTo(vm, jumpIns);
 }
 
 
@@ -1053,6 +1335,161 @@ String CallToString(const Call* call)
     return StringValueOf(call) + "\n";
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Shared instruction bodies
+// used by both an instruction and the superinstructions which fuse it with the 
+// instructions that usually precede or follow it
+
+/// returns the name of the call with [nameId], as used by BCI_LoadCallName
+inline String* NamePointerFor(PebbleVM* vm, extArg_t nameId)
+{
+    if(nameId < SIMPLE_CALLS)
+    {
+        return SimpleCallNames[nameId];
+    }
+    return &vm->CallNames[nameId-SIMPLE_CALLS];
+}
+
+/// resolves [callName] into a valid <Call> inside contextual scope and leaves it as TOS
+inline void InternalResolveDirect(PebbleVM* vm, String* callName)
+{
+    if(CallNameIsKeyword(callName))
+    {
+        ResolveKeywordCall(vm, callName);
+        return;
+    }
+
+    auto resolvedCall = FindInScopeOnlyImmediate(vm->LocalScopeReg, callName);
+
+    if(vm->LocalScopeIsDetachedReg == false)
+    {
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeChain(vm->SelfReg->BoundScope, callName);
+        }
+
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeOnlyImmediate(vm->CallerReg->BoundScope, callName);
+        }
+
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeOnlyImmediate(vm->ProgramReg, callName);
+        }
+    }
+
+    if(resolvedCall == nullptr)
+    {
+        auto newCall = InternalCallConstructor(vm, callName);
+        AddCallToScope(newCall, vm->LocalScopeReg);
+        PushTOS<Call>(vm, newCall);
+    }
+    else
+    {
+        PushTOS<Call>(vm, resolvedCall);
+    }
+}
+
+/// leaves the result of adding [lhs] and [rhs] as TOS
+inline void InternalAdd(PebbleVM* vm, void* lhs, void* rhs)
+{
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal + rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, AddFunction, lCall, rCall, AddTypes, nAddTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot add types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+/// leaves the result of subtracting [rhs] from [lhs] as TOS
+inline void InternalSubtract(PebbleVM* vm, void* lhs, void* rhs)
+{
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal - rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, SubtractFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot subtract types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+/// returns the boolean immediate for the comparison [arg] stored in CmpReg, or 
+/// NothingCall if the comparison involved Nothing
+inline void* CmpResultWord(PebbleVM* vm, extArg_t arg)
+{
+    if(arg < 6 && NthBit(vm->CmpReg, 7) == 0)
+    {
+        return BooleanImmediate(NthBit(vm->CmpReg, arg));
+    }
+    return &NothingCall;
+}
+
+/// jump to [arg] if [word] is boolean false
+inline void InternalJumpFalse(PebbleVM* vm, void* word, extArg_t arg)
+{
+    if(IsBooleanImmediate(word))
+    {
+        if(!BooleanOfImmediate(word))
+        {
+            InternalJumpTo(vm, arg);
+        }
+        return;
+    }
+
+    auto call = CallOfWord(vm, word);
+    if(IsPureNothing(call))
+    {
+        InternalJumpTo(vm, arg);
+    }
+
+    if(Loosely(&BooleanType, call))
+    {
+        if(Strictly(&BooleanType, call))
+        {
+            if(!BooleanValueOf(call))
+            {
+                InternalJumpTo(vm, arg);
+            }
+        }
+        else
+        {
+            InternalJumpTo(vm, arg);
+        }
+    }
+    else
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot conditionally jump on %s", CallTypeToString(call)));
+        return;
+    }
+}
+
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1067,15 +1504,15 @@ String CallToString(const Call* call)
 ///              or CallNames
 /// description: leaves the <String*> representing the Call's name as TOS
 /// stack state: <String*>
-void BCI_LoadCallName(extArg_t arg)
+void BCI_LoadCallName(PebbleVM* vm, extArg_t arg)
 {
     if(arg < SIMPLE_CALLS)
     {
-        PushTOS<String>(SimpleCallNames[arg]);
+        PushTOS<String>(vm, SimpleCallNames[arg]);
     }
     else
     {
-        PushTOS<String>(&CallNames[arg-SIMPLE_CALLS]);
+        PushTOS<String>(vm, &vm->CallNames[arg-SIMPLE_CALLS]);
     }
 }
 
@@ -1085,12 +1522,12 @@ void BCI_LoadCallName(extArg_t arg)
 /// argument:    index of primitive in ConstPrimitives
 /// description: leaves the primitive call specified by arg as TOS
 /// stack state: <Call>
-void BCI_LoadPrimitive(extArg_t arg)
+void BCI_LoadPrimitive(PebbleVM* vm, extArg_t arg)
 {
-    if(arg >= ConstPrimitives.size())
+    if(arg >= vm->ConstPrimitives.size())
         return; 
 
-    PushTOS<Call>(ConstPrimitives[arg]);
+    PushTOS<Call>(vm, vm->ConstPrimitives[arg]);
 }
 
 /// bytecode instruction
@@ -1098,14 +1535,14 @@ void BCI_LoadPrimitive(extArg_t arg)
 /// description: reassigns TOS[1] to the bindings on TOS[0] which is retained
 ///              as TOS
 /// stack state: <Call> 
-void BCI_Assign(extArg_t arg)
+void BCI_Assign(PebbleVM* vm, extArg_t arg)
 {
-    auto rhs = PopTOS<Call>();
-    auto lhs = PopTOS<Call>();
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<Call>(vm);
 
-    InternalAssign(lhs, rhs);
+    InternalAssignWord(vm, lhs, rhs);
 
-    PushTOS<Call>(lhs);
+    PushTOS<Call>(vm, lhs);
 }
 
 /// bytecode instruction
@@ -1113,21 +1550,12 @@ void BCI_Assign(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the addition result as TOS
 /// stack state: <Call>
-void BCI_Add(extArg_t arg)
+void BCI_Add(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
-
-    auto call = ApplyFunction(AddFunction, lCall, rCall, AddTypes, nAddTypes);
-
-    if(call == nullptr)
-    {
-        ReportFatalError(SystemMessageType::Exception, 0, 
-            Msg("cannot add types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
-        return;
-    }
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
 
-    PushTOS(call);
+    InternalAdd(vm, lhs, rhs);
 }
 
 /// bytecode instruction
@@ -1135,21 +1563,12 @@ void BCI_Add(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the subtraction result as TOS
 /// stack state: <Call>
-void BCI_Subtract(extArg_t arg)
+void BCI_Subtract(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
-
-    auto call = ApplyFunction(SubtractFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
 
-    if(call == nullptr)
-    {
-        ReportFatalError(SystemMessageType::Exception, 0, 
-            Msg("cannot subtract types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
-        return;
-    }
-
-    PushTOS(call);
+    InternalSubtract(vm, lhs, rhs);
 }
 
 /// bytecode instruction
@@ -1157,21 +1576,30 @@ void BCI_Subtract(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the multiplication result as TOS
 /// stack state: <Call>
-void BCI_Multiply(extArg_t arg)
+void BCI_Multiply(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal * rVal));
+        return;
+    }
 
-    auto call = ApplyFunction(MultiplyFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, MultiplyFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
 
     if(call == nullptr)
     {
-        ReportFatalError(SystemMessageType::Exception, 0, 
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
             Msg("cannot multiply types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
         return;
     }
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1179,21 +1607,30 @@ void BCI_Multiply(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the division result as TOS
 /// stack state: <Call>
-void BCI_Divide(extArg_t arg)
+void BCI_Divide(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
 
-    auto call = ApplyFunction(DivideFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal / rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, DivideFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
 
     if(call == nullptr)
     {
-        ReportFatalError(SystemMessageType::Exception, 0, 
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
             Msg("cannot divide types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
         return;
     }
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1203,14 +1640,14 @@ void BCI_Divide(extArg_t arg)
 ///              1 = ask
 /// description: applies the system function with TOS[0]
 /// stack state: <Call>
-void BCI_SysCall(extArg_t arg)
+void BCI_SysCall(PebbleVM* vm, extArg_t arg)
 {
     switch(arg)
     {
         case 0:
         {
-            String msg = CallToString(PeekTOS<Call>());
-            ProgramOutput += msg;
+            String msg = CallToString(PeekTOS<Call>(vm));
+            vm->Output->append(msg);
             if(g_outputOn)
             {
                 std::cout << msg;
@@ -1222,9 +1659,16 @@ void BCI_SysCall(extArg_t arg)
         case 1:
         {
             String s;
-            std::getline(std::cin, s);
-            auto call = InternalPrimitiveCallConstructor(s);
-            PushTOS<Call>(call);
+            if(vm->Ask)
+            {
+                s = vm->Ask();
+            }
+            else
+            {
+                std::getline(std::cin, s);
+            }
+            auto call = InternalPrimitiveCallConstructor(vm, s);
+            PushTOS<Call>(vm, call);
             break;
         }
         
@@ -1238,21 +1682,21 @@ void BCI_SysCall(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the and result as TOS
 /// stack state: <Call> 
-void BCI_And(extArg_t arg)
+void BCI_And(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
 
-    auto call = ApplyFunction(AndFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
+    auto call = ApplyFunction(vm, AndFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
 
     if(call == nullptr)
     {
-        ReportFatalError(SystemMessageType::Exception, 0, 
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
             Msg("cannot 'and' types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
         return;
     }
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1260,21 +1704,21 @@ void BCI_And(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the or result as TOS
 /// stack state: <Call>  
-void BCI_Or(extArg_t arg)
+void BCI_Or(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
 
-    auto call = ApplyFunction(OrFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
+    auto call = ApplyFunction(vm, OrFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
 
     if(call == nullptr)
     {
-        ReportFatalError(SystemMessageType::Exception, 0, 
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
             Msg("cannot 'or' types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
         return;
     }
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1282,18 +1726,18 @@ void BCI_Or(extArg_t arg)
 /// assumptions: TOS[0] is <Call>
 /// description: leaves the not result as TOS
 /// stack state: <Call> 
-void BCI_Not(extArg_t arg)
+void BCI_Not(PebbleVM* vm, extArg_t arg)
 {
-    if(IsPureNothing(PeekTOS<Call>()))
+    if(IsPureNothing(PeekTOS<Call>(vm)))
     {
         return;
     }
      
-    auto call = PopTOS<Call>();
+    auto call = PopTOS<Call>(vm);
 
     if(!CanBe(&BooleanType, call))
     {
-        ReportFatalError(SystemMessageType::Exception, 0, 
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
             Msg("cannot 'not' %s", CallTypeToString(call)));
         return;
     }
@@ -1301,12 +1745,12 @@ void BCI_Not(extArg_t arg)
     if(Strictly(&BooleanType, call))
     {
         bool b = !BooleanValueOf(call);
-        Call* newCall = InternalPrimitiveCallConstructor(b);
-        PushTOS(newCall);
+        Call* newCall = InternalPrimitiveCallConstructor(vm, b);
+        PushTOS(vm, newCall);
     }
     else
     {
-        PushTOS(call);
+        PushTOS(vm, call);
     }
 }
 
@@ -1315,15 +1759,15 @@ void BCI_Not(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the resulting boolean typed Call as TOS
 /// stack state: <Call> 
-void BCI_NotEquals(extArg_t arg)
+void BCI_NotEquals(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
 
     bool b = !CallsAreEqual(rCall, lCall);
-    Call* call = InternalPrimitiveCallConstructor(b);
+    Call* call = InternalPrimitiveCallConstructor(vm, b);
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1331,15 +1775,15 @@ void BCI_NotEquals(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: leaves the resulting boolean typed Call as TOS
 /// stack state: <Call> 
-void BCI_Equals(extArg_t arg)
+void BCI_Equals(PebbleVM* vm, extArg_t arg)
 {
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
 
     bool b = CallsAreEqual(rCall, lCall);
-    Call* call = InternalPrimitiveCallConstructor(b);
+    Call* call = InternalPrimitiveCallConstructor(vm, b);
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1347,24 +1791,33 @@ void BCI_Equals(extArg_t arg)
 /// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
 /// description: fills the CmpReg with the result of all numeric comparisons
 /// stack state: none 
-void BCI_Cmp(extArg_t arg)
+void BCI_Cmp(PebbleVM* vm, extArg_t arg)
 {
-    CmpReg = CmpRegDefaultValue;
-    auto rCall = PopTOS<Call>();
-    auto lCall = PopTOS<Call>();
+    vm->CmpReg = CmpRegDefaultValue;
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
 
-    auto call = ApplyFunction(CmpFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        CompareIntegerValues(vm, lVal, rVal);
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, CmpFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
 
     if(call == nullptr)
     {
-        ReportFatalError(SystemMessageType::Warning, 0, 
+        ReportFatalError(vm, SystemMessageType::Warning, 0, 
             Msg("cannot compare types %s and %s", lCall->BoundType, rCall->BoundType));
         return;
     }
 
     if(Either(IsNothing, lCall, rCall))
     {
-        CmpReg = CmpReg | (BitFlag << 7);
+        vm->CmpReg = vm->CmpReg | (BitFlag << 7);
     }
 }
 
@@ -1372,20 +1825,11 @@ void BCI_Cmp(extArg_t arg)
 /// consumption: 0
 /// assumptions: CmpReg is properly valued
 /// argument:    determines the specific comparison to use
-/// description: leaves the boolean call for a specific comparison as TOS
+/// description: leaves the boolean for a specific comparison as TOS
 /// stack state: <Call>
-void BCI_LoadCmp(extArg_t arg)
+void BCI_LoadCmp(PebbleVM* vm, extArg_t arg)
 {
-    Call* boolCall = nullptr;
-    if(arg < 6 && NthBit(CmpReg, 7) == 0)
-    {
-        boolCall = InternalPrimitiveCallConstructor(NthBit(CmpReg, arg));
-        PushTOS<Call>(boolCall);
-    }
-    else
-    {
-        PushTOS(&NothingCall);
-    }
+    PushTOS<void>(vm, CmpResultWord(vm, arg));
 }
 
 /// bytecode instruction
@@ -1394,35 +1838,10 @@ void BCI_LoadCmp(extArg_t arg)
 /// argument:    the new instruction id to jump to
 /// description: jump to [arg] if TOS[0] is boolean false
 /// stack state: none
-void BCI_JumpFalse(extArg_t arg)
+void BCI_JumpFalse(PebbleVM* vm, extArg_t arg)
 {
-    auto call = PopTOS<Call>();
-
-    if(IsPureNothing(call))
-    {
-        InternalJumpTo(arg);
-    }
-
-    if(Loosely(&BooleanType, call))
-    {
-        if(Strictly(&BooleanType, call))
-        {
-            if(!BooleanValueOf(call))
-            {
-                InternalJumpTo(arg);
-            }
-        }
-        else
-        {
-            InternalJumpTo(arg);
-        }
-    }
-    else
-    {
-        ReportFatalError(SystemMessageType::Exception, 0, 
-            Msg("cannot conditionally jump on %s", CallTypeToString(call)));
-        return;
-    }
+    auto word = PopTOS<void>(vm);
+    InternalJumpFalse(vm, word, arg);
 }
 
 /// bytecode instruction
@@ -1430,9 +1849,9 @@ void BCI_JumpFalse(extArg_t arg)
 /// assumptions: none
 /// description: unconditionally jumps to [arg]
 /// stack state: none
-void BCI_Jump(extArg_t arg)
+void BCI_Jump(PebbleVM* vm, extArg_t arg)
 {
-    InternalJumpTo(arg);
+    InternalJumpTo(vm, arg);
 }
 
 /// TODO: may not work with primitives
@@ -1441,11 +1860,11 @@ void BCI_Jump(extArg_t arg)
 /// assumptions: TOS[0] is <Call>
 /// description: creates a deep copy of TOS[0] which is left as the new TOS
 /// stack state: <Call>
-void BCI_Copy(extArg_t arg)
+void BCI_Copy(PebbleVM* vm, extArg_t arg)
 {
-    auto call = PopTOS<Call>();
-    auto callCopy = InternalCopyCall(call);
-    PushTOS<Call>(callCopy);
+    auto call = PopTOS<Call>(vm);
+    auto callCopy = InternalCopyCall(vm, call);
+    PushTOS<Call>(vm, callCopy);
 }
 
 /// bytecode instruction
@@ -1453,23 +1872,23 @@ void BCI_Copy(extArg_t arg)
 /// assumptions: TOS[0] is <Call>
 /// description: binds type to TOS[0] or to a shallow copy of it
 /// stack state: <Call>
-void BCI_BindType(extArg_t arg)
+void BCI_BindType(PebbleVM* vm, extArg_t arg)
 {
-    auto originalCall = PeekTOS<Call>();
+    auto originalCall = PeekTOS<Call>(vm);
 
     if(originalCall->Name != nullptr)
     {
         if(originalCall->BoundScope != &NothingScope)
         {
-            PopTOS<Call>();
-            auto call = InternalCallConstructor();
+            PopTOS<Call>(vm);
+            auto call = InternalCallConstructor(vm);
             call->NumberOfParameters = originalCall->NumberOfParameters;
             BindType(call, originalCall->Name);
             BindSection(call, originalCall->BoundSection);
             BindValue(call, originalCall->BoundValue);
 
             EnforceCallType(call, originalCall->BoundType);
-            PushTOS(call);
+            PushTOS(vm, call);
         }
         else
         {
@@ -1486,47 +1905,10 @@ void BCI_BindType(extArg_t arg)
 /// assumptions: TOS[0] is <String>
 /// description: resolve TOS[0] into a valid <Call> inside contextual scope
 /// stack state: <Call>
-void BCI_ResolveDirect(extArg_t arg)
+void BCI_ResolveDirect(PebbleVM* vm, extArg_t arg)
 {
-    auto callName = PopTOS<String>();
-
-    if(CallNameIsKeyword(callName))
-    {
-        ResolveKeywordCall(callName);
-        return;
-    }
-
-    auto resolvedCall = FindInScopeOnlyImmediate(LocalScopeReg, callName);
-
-    if(LocalScopeIsDetachedReg == false)
-    {
-        if(resolvedCall == nullptr)
-        {
-            resolvedCall = FindInScopeChain(SelfReg->BoundScope, callName);
-        }
-
-        if(resolvedCall == nullptr)
-        {
-            resolvedCall = FindInScopeOnlyImmediate(CallerReg->BoundScope, callName);
-        }
-
-        if(resolvedCall == nullptr)
-        {
-            resolvedCall = FindInScopeOnlyImmediate(ProgramReg, callName);
-        }
-    }
-
-    if(resolvedCall == nullptr)
-    {
-        auto newCall = InternalCallConstructor(callName);
-        AddCallToScope(newCall, LocalScopeReg);
-        PushTOS<Call>(newCall);
-    }
-    else
-    {
-        PushTOS<Call>(resolvedCall);
-    }
-
+    auto callName = PopTOS<String>(vm);
+    InternalResolveDirect(vm, callName);
 }
 
 /// bytecode instruction
@@ -1534,15 +1916,15 @@ void BCI_ResolveDirect(extArg_t arg)
 /// assumptions: TOS[0] is <String>, TOS[1] is <Call>
 /// description: resolves TOS[0] into a valid <Call> in TOS[1] scope
 /// stack state: <Call>
-void BCI_ResolveScoped(extArg_t arg)
+void BCI_ResolveScoped(PebbleVM* vm, extArg_t arg)
 {
-    auto callName = PopTOS<String>();
-    auto callerCall = PopTOS<Call>();
+    auto callName = PopTOS<String>(vm);
+    auto callerCall = PopTOS<Call>(vm);
 
     // all attributes of Nothing resolve to Nothing
     if(IsNothing(callerCall))
     {
-        PushTOS<Call>(&NothingCall);
+        PushTOS<Call>(vm, &NothingCall);
         return;
     }
 
@@ -1550,13 +1932,13 @@ void BCI_ResolveScoped(extArg_t arg)
 
     if(resolvedCall == nullptr)
     {
-        auto newCall = InternalCallConstructor(callName);
+        auto newCall = InternalCallConstructor(vm, callName);
         AddCallToScope(newCall, ScopeOf(callerCall));
-        PushTOS<Call>(newCall);
+        PushTOS<Call>(vm, newCall);
     }
     else
     {
-        PushTOS<Call>(resolvedCall);
+        PushTOS<Call>(vm, resolvedCall);
     }
 }
 
@@ -1565,10 +1947,10 @@ void BCI_ResolveScoped(extArg_t arg)
 /// assumptions: TOS[0] is <Scope>
 /// description: creates a new <Call> which is bound to TOS[0] and left as TOS
 /// stack state: <Call>
-void BCI_BindScope(extArg_t arg)
+void BCI_BindScope(PebbleVM* vm, extArg_t arg)
 {
-    auto call = InternalCallConstructor();
-    auto scope = PopTOS<Scope>();
+    auto call = InternalCallConstructor(vm);
+    auto scope = PopTOS<Scope>(vm);
 
     call->NumberOfParameters = arg;
     BindScope(call, scope);
@@ -1576,7 +1958,7 @@ void BCI_BindScope(extArg_t arg)
     /// TODO: make method types more robust
     BindType(call, &MethodType);
 
-    PushTOS(call);
+    PushTOS(vm, call);
 }
 
 /// bytecode instruction
@@ -1584,9 +1966,9 @@ void BCI_BindScope(extArg_t arg)
 /// assumptions: TOS[0] is <Call>
 /// description: binds [arg] as the section of TOS, 
 /// stack state: none
-void BCI_BindSection(extArg_t arg)
+void BCI_BindSection(PebbleVM* vm, extArg_t arg)
 {
-    auto call = PeekTOS<Call>();
+    auto call = PeekTOS<Call>(vm);
     BindSection(call, arg);
 }
 
@@ -1610,14 +1992,13 @@ void BCI_BindSection(extArg_t arg)
 ///                 leaves the constructed <Call> as TOS. does not jump
 ///              
 /// stack state: varies
-void BCI_Eval(extArg_t arg)
+void BCI_Eval(PebbleVM* vm, extArg_t arg)
 {
-    auto paramsList = GetParameters(arg);
-    auto methodCall = PopTOS<Call>();
-    auto caller = PopTOS<Call>();
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
+    auto caller = PeekTOS<Call>(vm, arg + 1);
 
-    InternalEval(methodCall, caller, paramsList, arg, /*inPlace*/ false);
-    delete[] paramsList;
+    InternalEval(vm, methodCall, caller, params, arg, arg + 2, /*inPlace*/ false);
 }
 
 /// bytecode instruction
@@ -1627,13 +2008,59 @@ void BCI_Eval(extArg_t arg)
 /// description: TOS[1 + arg] is the <Call> whose section is evaluated (see
 ///              BCI_Eval)
 /// stack state: none
-void BCI_EvalHere(extArg_t arg)
+void BCI_EvalHere(PebbleVM* vm, extArg_t arg)
 {
-    auto paramsList = GetParameters(arg);
-    auto methodCall = PopTOS<Call>();
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
 
-    InternalEval(methodCall, &NothingCall, paramsList, arg, /*inPlace*/ true);
-    delete[] paramsList;
+    InternalEval(vm, methodCall, &NothingCall, params, arg, arg + 1, /*inPlace*/ true);
+}
+
+bool TailEvalReusesCallFrame(PebbleVM* vm, extArg_t arg)
+{
+    return EvalEntersCallFrame(PeekTOS<Call>(vm, arg), arg);
+}
+
+/// bytecode instruction
+/// consumption: 2 + [arg]
+/// assumptions: TOS[0 : 2 + arg] are <Call>
+/// argmument:   the number of parameters
+/// description: evaluates TOS[arg] as BCI_Eval and returns its result as BCI_Return
+///              with arg = 1. used for a method called in tail position, whose
+///              section runs in the current <CallFrame> instead of a new one, 
+///              so the CallStack does not grow with tail recursion
+///
+///              if the evaluation does not jump (pure nothing or primitive type)
+///              then the result is returned as soon as it is left as TOS
+/// stack state: varies
+void BCI_TailEval(PebbleVM* vm, extArg_t arg)
+{
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
+    auto caller = PeekTOS<Call>(vm, arg + 1);
+
+    if(!EvalEntersCallFrame(methodCall, arg))
+    {
+        InternalEval(vm, methodCall, caller, params, arg, arg + 2, /*inPlace*/ false);
+        if(!vm->ErrorFlag)
+        {
+            BCI_Return(vm, 1);
+        }
+        return;
+    }
+
+    if(methodCall->BoundScope == &NothingScope)
+    {
+        BindScope(methodCall, InternalScopeConstructor(vm, nullptr));
+    }
+
+    if(arg != 0)
+    {
+        AddParamsToMethodScope(vm, methodCall, params);
+    }
+
+    ReuseCallFrame(vm, caller, methodCall);
+    InternalJumpTo(vm, methodCall->BoundSection);
 }
 
 /// bytecode instruction
@@ -1645,52 +2072,52 @@ void BCI_EvalHere(extArg_t arg)
 ///              arg = 1: use TOS[0] (is <Call>) as return value. consumes 1.
 /// description: pushes the approriate <Call> to TOS
 /// stack state: <Call>
-void BCI_Return(extArg_t arg)
+void BCI_Return(PebbleVM* vm, extArg_t arg)
 {
-    extArg_t jumpBackTo = CallStack.back().ReturnToInstructionId;
-    extArg_t stackStart = CallStack.back().MemoryStackStart;
+    extArg_t jumpBackTo = vm->CallStack.back().ReturnToInstructionId;
+    extArg_t stackStart = vm->CallStack.back().MemoryStackStart;
 
-    Call* returnObj = nullptr;
+    void* returnObj = nullptr;
     if(arg == 1)
     {
-        returnObj = PopTOS<Call>();
+        returnObj = PopTOS<void>(vm);
     }
 
-    while(MemoryStack.size() > stackStart)
+    while(vm->MemoryStack.size() > stackStart)
     {
-        PopTOS<void>();
+        PopTOS<void>(vm);
     }
 
     if(arg == 1)
     {
-        PushTOS(returnObj);
+        PushTOS<void>(vm, returnObj);
     }
     else
     {
-        if(CallerReg->BoundType != &NothingType)
+        if(vm->CallerReg->BoundType != &NothingType)
         {
-            PushTOS(CallerReg);
+            PushTOS(vm, vm->CallerReg);
         }
         else
         {
-            PushTOS(SelfReg);
+            PushTOS(vm, vm->SelfReg);
         }
     }
 
-    InstructionReg = jumpBackTo;
+    vm->InstructionReg = jumpBackTo;
 
-    LastResultReg = CallStack.back().LastResult;
-    CallStack.pop_back();
+    vm->LastResultReg = vm->CallStack.back().LastResult;
+    vm->LocalScopes.resize(vm->CallStack.back().LocalScopesStart);
+    vm->CallStack.pop_back();
 
-    extArg_t returnMemStart = CallStack.back().MemoryStackStart;
+    extArg_t returnMemStart = vm->CallStack.back().MemoryStackStart;
 
-    CallerReg = static_cast<Call*>(MemoryStack[returnMemStart]);
-    SelfReg = static_cast<Call*>(MemoryStack[returnMemStart+1]);
+    vm->CallerReg = static_cast<Call*>(vm->MemoryStack[returnMemStart]);
+    vm->SelfReg = static_cast<Call*>(vm->MemoryStack[returnMemStart+1]);
 
-    LocalScopeStack() = CallStack.back().LocalScopeStack;
-    AdjustLocalScopeReg();
+    AdjustLocalScopeReg(vm);
 
-    JumpStatusReg = 1;
+    vm->JumpStatusReg = 1;
 }
 
 /// bytecode instruction
@@ -1701,41 +2128,39 @@ void BCI_Return(extArg_t arg)
 ///
 ///              enforces that TOS[0] must a <Call> of <IntegerType>
 /// stack state: <Call>
-void BCI_Array(extArg_t arg)
+void BCI_Array(PebbleVM* vm, extArg_t arg)
 {
-    auto indexCall = PopTOS<Call>();
-    auto arrayCall = PopTOS<Call>();
-
-    auto sizeCall = FindInScopeOnlyImmediate(ScopeOf(arrayCall), &SizeCallName);
+    auto indexWord = PopTOS<void>(vm);
+    auto arrayCall = PopTOS<Call>(vm);
 
-    if(indexCall->BoundType != &IntegerType)
+    int indexInt;
+    if(!IntegerOfWord(indexWord, indexInt))
     {
-        ReportFatalError(SystemMessageType::Exception, 5, Msg("%s is not an integer", *indexCall->Name));
-        return;
+        auto indexCall = CallOfWord(vm, indexWord);
+        if(indexCall->BoundType != &IntegerType)
+        {
+            ReportFatalError(vm, SystemMessageType::Exception, 5, Msg("%s is not an integer", CallTypeToString(indexCall)));
+            return;
+        }
+        indexInt = IntegerValueOf(indexCall);
     }
 
+    auto sizeCall = FindInScopeOnlyImmediate(ScopeOf(arrayCall), vm->SizeCallNamePointer);
     if(sizeCall == nullptr)
     {
-        ReportFatalError(SystemMessageType::Exception, 4, Msg("%s is not an array", *arrayCall->Name));
+        ReportFatalError(vm, SystemMessageType::Exception, 4, Msg("%s is not an array", *arrayCall->Name));
         return;
     }
 
-    auto indexInt = IntegerValueOf(indexCall);
-    auto sizeInt = IntegerValueOf(sizeCall);
-
-    if(indexInt >= sizeInt)
+    auto& elements = ScopeOf(arrayCall)->Elements;
+    if(indexInt < 0 || static_cast<size_t>(indexInt) >= elements.size())
     {
-        ReportFatalError(SystemMessageType::Exception, 6, Msg("%i is out of bounds in %s of size %i", indexInt, *arrayCall->Name, sizeInt));
+        ReportFatalError(vm, SystemMessageType::Exception, 6, 
+            Msg("%i is out of bounds in %s of size %i", indexInt, *arrayCall->Name, static_cast<int>(elements.size())));
         return;
     }
 
-    auto indexedCall = FindInScopeOnlyImmediate(ScopeOf(arrayCall), CallNamePointerFor(indexInt));
-    if(indexCall == nullptr)
-    {
-        LogIt(LogSeverityType::Sev3_Critical, "BCI_Array", "cannot find indexed call");
-    }
-
-    PushTOS(indexedCall);
+    PushTOS(vm, elements[indexInt]);
 }
 
 
@@ -1752,18 +2177,18 @@ void BCI_Array(extArg_t arg)
 ///              detached scope:
 ///                 call resolution only occurs in the detached scope. 
 /// externality: LocalScopeReg, 
-///              LocalScopeStack(), 
+///              LocalScopes, 
 ///              LocalScopeIsDetachedReg, 
 ///              LastResultReg
 /// stack state: none
-void BCI_EnterLocal(extArg_t arg)
+void BCI_EnterLocal(PebbleVM* vm, extArg_t arg)
 {
-    auto newScope = InternalScopeConstructor(nullptr);
+    auto newScope = InternalScopeConstructor(vm, nullptr);
     bool isDetached = (arg == 1 ? true : false);
-    LocalScopeStack().push_back({newScope, isDetached});
-    LocalScopeReg = LocalScopeStack().back().Value;
-    LocalScopeIsDetachedReg = isDetached;
-    LastResultReg = nullptr;
+    vm->LocalScopes.push_back({newScope, isDetached});
+    vm->LocalScopeReg = vm->LocalScopes.back().Value;
+    vm->LocalScopeIsDetachedReg = isDetached;
+    vm->LastResultReg = nullptr;
 }
 
 /// bytecode instruction
@@ -1772,30 +2197,12 @@ void BCI_EnterLocal(extArg_t arg)
 /// stack state: 
 /// no assumptions
 /// leaves the scope as TOS. will update LocalScopeReg and LastResultReg
-void BCI_LeaveLocal(extArg_t arg)
+void BCI_LeaveLocal(PebbleVM* vm, extArg_t arg)
 {   
-    PushTOS<Scope>(LocalScopeStack().back().Value);
-    LocalScopeStack().pop_back();
-    AdjustLocalScopeReg();
-    LastResultReg = nullptr;
-}
-
-/// bytecode instruction
-/// consumption: 0
-/// assumptions: none
-/// description: adds [arg] as the next uninitialized byte of ExtendedArg
-///              (stored by ExtensionExp, which is incremented)
-/// externality: ExtensionExp
-///              ExtendedArg
-/// stack state: none
-void BCI_Extend(extArg_t arg)
-{
-    if(ExtensionExp < 7)
-    {
-        ExtensionExp++;
-        extArg_t shiftedExpr = ((extArg_t)arg) << (8 * ExtensionExp);
-        ExtendedArg = ExtendedArg ^ shiftedExpr;
-    }
+    PushTOS<Scope>(vm, vm->LocalScopes.back().Value);
+    vm->LocalScopes.pop_back();
+    AdjustLocalScopeReg(vm);
+    vm->LastResultReg = nullptr;
 }
 
 /// bytecode instruction
@@ -1803,7 +2210,7 @@ void BCI_Extend(extArg_t arg)
 /// assumptions: none
 /// description: no operation
 /// stack state: none
-void BCI_NOP(extArg_t arg)
+void BCI_NOP(PebbleVM* vm, extArg_t arg)
 {
     // does nothing, used for optimizations
 }
@@ -1813,10 +2220,10 @@ void BCI_NOP(extArg_t arg)
 /// assumptions: none
 /// description: duplicates TOS[0] and leaves this pointer as TOS
 /// stack state: same as <TOS[0]>
-void BCI_Dup(extArg_t arg)
+void BCI_Dup(PebbleVM* vm, extArg_t arg)
 {
-    auto entity = PeekTOS<void>();
-    PushTOS<void>(entity);
+    auto entity = PeekTOS<void>(vm);
+    PushTOS<void>(vm, entity);
 }
 
 /// bytecode instruction
@@ -1825,9 +2232,9 @@ void BCI_Dup(extArg_t arg)
 /// description: sets LastResultReg to TOS[0]
 /// externality: LastResultReg
 /// stack state: none
-void BCI_EndLine(extArg_t arg)
+void BCI_EndLine(PebbleVM* vm, extArg_t arg)
 {
-    LastResultReg = PopTOS<Call>();
+    vm->LastResultReg = PopTOS<Call>(vm);
 }
 
 /// bytecode instruction
@@ -1835,9 +2242,9 @@ void BCI_EndLine(extArg_t arg)
 /// assumptions: none
 /// description: remove and discard TOS[0]
 /// stack state: none
-void BCI_DropTOS(extArg_t arg)
+void BCI_DropTOS(PebbleVM* vm, extArg_t arg)
 {
-    PopTOS<void>();
+    PopTOS<void>(vm);
 }
 
 /// bytecode instruction
@@ -1846,16 +2253,16 @@ void BCI_DropTOS(extArg_t arg)
 /// description: leaves a <Call> of <BooleanType> as TOS which signifies whether
 ///              TOS[1] 'is' TOS[0]. defines the notion of 'being of'
 /// stack state: <Call>
-void BCI_Is(extArg_t arg)
+void BCI_Is(PebbleVM* vm, extArg_t arg)
 {
-    auto rhs = PopTOS<Call>();
-    auto lhs = PopTOS<Call>();
+    auto rhs = PopTOS<Call>(vm);
+    auto lhs = PopTOS<Call>(vm);
 
     Call* call = nullptr;
     if(IsPureNothing(lhs))
     {
-        InternalAssign(lhs, rhs);
-        call = InternalPrimitiveCallConstructor(true);   
+        InternalAssign(vm, lhs, rhs);
+        call = InternalPrimitiveCallConstructor(vm, true);   
     }
     else
     {
@@ -1881,8 +2288,111 @@ void BCI_Is(extArg_t arg)
             is = CallsAreEqual(lhs, rhs);
         }
 
-        call = InternalPrimitiveCallConstructor(is);
+        call = InternalPrimitiveCallConstructor(vm, is);
+    }
+
+    PushTOS(vm, call);
+}
+
+/// bytecode instruction
+/// consumption: 0
+/// assumptions: none
+/// argument:    index of the slot in LocalSlots
+/// description: leaves the <Call> in the slot of the scope of SelfReg as TOS. 
+///              if the slot does not hold the expected call, the call is 
+///              resolved by name as with BCI_ResolveDirect
+/// stack state: <Call>
+void BCI_LoadLocal(PebbleVM* vm, extArg_t arg)
+{
+    auto& slot = vm->LocalSlots[arg];
+    auto call = FindInLocalSlot(vm, slot);
+    if(call == nullptr)
+    {
+        BCI_LoadCallName(vm, slot.NameId);
+        BCI_ResolveDirect(vm, 0);
+        return;
+    }
+
+    PushTOS<Call>(vm, call);
+}
+
+/// bytecode instruction
+/// consumption: 1
+/// assumptions: TOS[0] is <Call>
+/// argument:    index of the slot in LocalSlots
+/// description: assigns the call in the slot of the scope of SelfReg to the
+///              bindings on TOS[0] and leaves the assigned <Call> as TOS. 
+///              if the slot does not hold the expected call, the call is 
+///              resolved by name as with BCI_ResolveDirect
+/// stack state: <Call>
+void BCI_StoreLocal(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+
+    auto& slot = vm->LocalSlots[arg];
+    auto lhs = FindInLocalSlot(vm, slot);
+    if(lhs == nullptr)
+    {
+        BCI_LoadCallName(vm, slot.NameId);
+        BCI_ResolveDirect(vm, 0);
+        lhs = PopTOS<Call>(vm);
     }
 
-    PushTOS(call);
+    InternalAssignWord(vm, lhs, rhs);
+    PushTOS<Call>(vm, lhs);
+}
+
+/// superinstruction
+/// consumption: 0
+/// assumptions: none
+/// argument:    index id of call name, as with BCI_LoadCallName
+/// description: BCI_LoadCallName followed by BCI_ResolveDirect; leaves the
+///              <Call> with the name specified by arg as TOS
+/// stack state: <Call>
+void BCI_ResolveName(PebbleVM* vm, extArg_t arg)
+{
+    InternalResolveDirect(vm, NamePointerFor(vm, arg));
+}
+
+/// superinstruction
+/// consumption: 1
+/// assumptions: TOS[0] is <Call>
+/// argument:    index of primitive in ConstPrimitives
+/// description: BCI_LoadPrimitive followed by BCI_Add; leaves the result of
+///              adding the primitive to TOS[0] as TOS
+/// stack state: <Call>
+void BCI_AddConst(PebbleVM* vm, extArg_t arg)
+{
+    auto lhs = PopTOS<void>(vm);
+    InternalAdd(vm, lhs, vm->ConstPrimitives[arg]);
+}
+
+/// superinstruction
+/// consumption: 1
+/// assumptions: TOS[0] is <Call>
+/// argument:    index of primitive in ConstPrimitives
+/// description: BCI_LoadPrimitive followed by BCI_Subtract; leaves the result 
+///              of subtracting the primitive from TOS[0] as TOS
+/// stack state: <Call>
+void BCI_SubtractConst(PebbleVM* vm, extArg_t arg)
+{
+    auto lhs = PopTOS<void>(vm);
+    InternalSubtract(vm, lhs, vm->ConstPrimitives[arg]);
+}
+
+/// superinstruction
+/// consumption: 2
+/// assumptions: TOS[0] is <Call>, TOS[1] is <Call>
+/// argument:    the comparison (as with BCI_LoadCmp) and the instruction id to 
+///              jump to, packed by CmpJumpFalseArg
+/// description: BCI_Cmp, BCI_LoadCmp and BCI_JumpFalse; jumps if the comparison
+///              of TOS[1] and TOS[0] is false
+/// stack state: none
+void BCI_CmpJumpFalse(PebbleVM* vm, extArg_t arg)
+{
+    BCI_Cmp(vm, 0);
+    if(vm->ErrorFlag)
+        return;
+
+    InternalJumpFalse(vm, CmpResultWord(vm, CmpJumpComparisonOf(arg)), CmpJumpTargetOf(arg));
 }
@@ -10,56 +10,132 @@
 constexpr uint8_t BitFlag = 0x1;
 
 /// number of bytecode instructions 
-constexpr int BCI_NumberOfInstructions = 35;
+constexpr int BCI_NumberOfInstructions = 41;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Instruction ids
+
+/// the index of each instruction in BCI_Instructions. lets code which dispatches on
+/// an instruction (i.e. the vm loop) name it at compile time instead of using
+/// IndexOfInstruction
+enum BCI_Id : uint8_t
+{
+    OP_LoadCallName,
+    OP_LoadPrimitive,
+    OP_Assign,
+    OP_Add,
+    OP_Subtract,
+
+    OP_Multiply,
+    OP_Divide,
+    OP_SysCall,
+    OP_And,
+    OP_Or,
+
+    OP_Not,
+    OP_NotEquals,
+    OP_Equals,
+    OP_Cmp,
+    OP_LoadCmp,
+
+    OP_JumpFalse,
+    OP_Jump,
+    OP_Copy,
+    OP_BindType,
+    OP_ResolveDirect,
+
+    OP_ResolveScoped,
+    OP_BindScope,
+    OP_BindSection,
+    OP_EvalHere,
+    OP_Eval,
+
+    OP_Return,
+    OP_Array,
+    OP_EnterLocal,
+    OP_LeaveLocal,
+    OP_NOP,
+
+    OP_Dup,
+    OP_EndLine,
+    OP_DropTOS,
+    OP_Is,
+    OP_LoadLocal,
+
+    OP_StoreLocal,
+    OP_ResolveName,
+    OP_AddConst,
+    OP_SubtractConst,
+    OP_CmpJumpFalse,
+
+    OP_TailEval,
+
+    OP_NumberOfInstructions,
+};
+
+static_assert(OP_NumberOfInstructions == BCI_NumberOfInstructions, "BCI_Id must list every instruction");
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Bytecode instructions methods
 
 /// function type of a bytecode instruction
-typedef void (*BCI_Method)(extArg_t);
-
-void BCI_LoadCallName(extArg_t arg);
-void BCI_LoadPrimitive(extArg_t arg);
-void BCI_Assign(extArg_t arg);
-void BCI_Add(extArg_t arg);
-void BCI_Subtract(extArg_t arg);
-
-void BCI_Multiply(extArg_t arg);
-void BCI_Divide(extArg_t arg);
-void BCI_SysCall(extArg_t arg);
-void BCI_And(extArg_t arg);
-void BCI_Or(extArg_t arg);
-
-void BCI_Not(extArg_t arg);
-void BCI_NotEquals(extArg_t arg);
-void BCI_Equals(extArg_t arg);
-void BCI_Cmp(extArg_t arg);
-void BCI_LoadCmp(extArg_t arg);
-
-void BCI_JumpFalse(extArg_t arg);
-void BCI_Jump(extArg_t arg);
-void BCI_Copy(extArg_t arg);
-void BCI_BindType(extArg_t arg);
-void BCI_ResolveDirect(extArg_t arg);
-
-void BCI_ResolveScoped(extArg_t arg);
-void BCI_BindScope(extArg_t arg);
-void BCI_BindSection(extArg_t arg);
-void BCI_EvalHere(extArg_t arg);
-void BCI_Eval(extArg_t arg);
-
-void BCI_Return(extArg_t arg);
-void BCI_Array(extArg_t arg);
-void BCI_EnterLocal(extArg_t arg);
-void BCI_LeaveLocal(extArg_t arg);
-void BCI_Extend(extArg_t arg);
-
-void BCI_NOP(extArg_t arg);
-void BCI_Dup(extArg_t arg);
-void BCI_EndLine(extArg_t arg);
-void BCI_DropTOS(extArg_t arg);
-void BCI_Is(extArg_t arg);
+typedef void (*BCI_Method)(PebbleVM*, extArg_t);
+
+void BCI_LoadCallName(PebbleVM* vm, extArg_t arg);
+void BCI_LoadPrimitive(PebbleVM* vm, extArg_t arg);
+void BCI_Assign(PebbleVM* vm, extArg_t arg);
+void BCI_Add(PebbleVM* vm, extArg_t arg);
+void BCI_Subtract(PebbleVM* vm, extArg_t arg);
+
+void BCI_Multiply(PebbleVM* vm, extArg_t arg);
+void BCI_Divide(PebbleVM* vm, extArg_t arg);
+void BCI_SysCall(PebbleVM* vm, extArg_t arg);
+void BCI_And(PebbleVM* vm, extArg_t arg);
+void BCI_Or(PebbleVM* vm, extArg_t arg);
+
+void BCI_Not(PebbleVM* vm, extArg_t arg);
+void BCI_NotEquals(PebbleVM* vm, extArg_t arg);
+void BCI_Equals(PebbleVM* vm, extArg_t arg);
+void BCI_Cmp(PebbleVM* vm, extArg_t arg);
+void BCI_LoadCmp(PebbleVM* vm, extArg_t arg);
+
+void BCI_JumpFalse(PebbleVM* vm, extArg_t arg);
+void BCI_Jump(PebbleVM* vm, extArg_t arg);
+void BCI_Copy(PebbleVM* vm, extArg_t arg);
+void BCI_BindType(PebbleVM* vm, extArg_t arg);
+void BCI_ResolveDirect(PebbleVM* vm, extArg_t arg);
+
+void BCI_ResolveScoped(PebbleVM* vm, extArg_t arg);
+void BCI_BindScope(PebbleVM* vm, extArg_t arg);
+void BCI_BindSection(PebbleVM* vm, extArg_t arg);
+void BCI_EvalHere(PebbleVM* vm, extArg_t arg);
+void BCI_Eval(PebbleVM* vm, extArg_t arg);
+
+void BCI_Return(PebbleVM* vm, extArg_t arg);
+void BCI_Array(PebbleVM* vm, extArg_t arg);
+void BCI_EnterLocal(PebbleVM* vm, extArg_t arg);
+void BCI_LeaveLocal(PebbleVM* vm, extArg_t arg);
+void BCI_NOP(PebbleVM* vm, extArg_t arg);
+
+void BCI_Dup(PebbleVM* vm, extArg_t arg);
+void BCI_EndLine(PebbleVM* vm, extArg_t arg);
+void BCI_DropTOS(PebbleVM* vm, extArg_t arg);
+void BCI_Is(PebbleVM* vm, extArg_t arg);
+void BCI_LoadLocal(PebbleVM* vm, extArg_t arg);
+
+void BCI_StoreLocal(PebbleVM* vm, extArg_t arg);
+void BCI_ResolveName(PebbleVM* vm, extArg_t arg);
+void BCI_AddConst(PebbleVM* vm, extArg_t arg);
+void BCI_SubtractConst(PebbleVM* vm, extArg_t arg);
+void BCI_CmpJumpFalse(PebbleVM* vm, extArg_t arg);
+
+void BCI_TailEval(PebbleVM* vm, extArg_t arg);
+
+/// true if BCI_TailEval with [arg] will replace the current CallFrame and jump to the
+/// section of the method on the stack, rather than return the result of its evaluation
+bool TailEvalReusesCallFrame(PebbleVM* vm, extArg_t arg);
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -68,6 +144,38 @@ void BCI_Is(extArg_t arg);
 /// array of all recognized bytecode instructions
 extern BCI_Method BCI_Instructions[];
 
+/// names of the instructions in BCI_Instructions, in the same order
+extern const char* const BCI_InstructionNames[];
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Superinstruction arguments
+
+/// number of bits of the BCI_CmpJumpFalse argument used for the jump target; the
+/// bits above hold the comparison used by BCI_LoadCmp
+constexpr int CmpJumpTargetBits = 29;
+
+/// the largest jump target which BCI_CmpJumpFalse can hold
+constexpr extArg_t MaxCmpJumpTarget = (extArg_t(1) << CmpJumpTargetBits) - 1;
+
+/// returns the argument of BCI_CmpJumpFalse for [comparison] and [target]
+inline extArg_t CmpJumpFalseArg(extArg_t comparison, extArg_t target)
+{
+    return (comparison << CmpJumpTargetBits) | target;
+}
+
+/// returns the comparison used by the BCI_CmpJumpFalse with [arg]
+inline extArg_t CmpJumpComparisonOf(extArg_t arg)
+{
+    return arg >> CmpJumpTargetBits;
+}
+
+/// returns the jump target of the BCI_CmpJumpFalse with [arg]
+inline extArg_t CmpJumpTargetOf(extArg_t arg)
+{
+    return arg & MaxCmpJumpTarget;
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Helper methods
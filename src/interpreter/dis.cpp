@@ -10,172 +10,85 @@
 // ---------------------------------------------------------------------------------------------------------------------
 // Diagnostics
 
-/// returns a string represntation of an instruction [ins]
-String ToString(ByteCodeInstruction& ins)
+/// returns the name of the call with [nameId], as used by BCI_LoadCallName
+String CallNameFor(PebbleVM* vm, extArg_t nameId)
 {
-    String str;
-    String decodedArg;
-
-    if(ins.Op == IndexOfInstruction(BCI_LoadCallName))
-    {
-        str += "#BCI_LoadCallName";
-        if(ins.Arg < SIMPLE_CALLS)
-        {
-            decodedArg = *SimpleCallNames[ins.Arg];
-        }
-        else
-        {
-            decodedArg = CallNames[ins.Arg - SIMPLE_CALLS];
-        }
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_LoadPrimitive))
-    {
-        str += "#BCI_LoadPrimitive";
-        auto call = ConstPrimitives[ins.Arg];
-        if(call->BoundScope != &NothingScope)
-        {
-            decodedArg = StringValueOf(ConstPrimitives[ins.Arg]);
-        }
-        else
-        {
-            decodedArg = CallTypeToString(call);
-        }
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Assign)) 
-    {
-        str += "#BCI_Assign";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Add))
-    {
-        str += "#BCI_Add";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Subtract))
-    {
-        str += "#BCI_Subtract";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Multiply))
-    {
-        str += "#BCI_Multiply";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Divide))
-    {
-        str += "#BCI_Divide";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_SysCall))
-    {
-        str += "#BCI_SysCall";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_And))
-    {
-        str += "#BCI_And";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Or))
-    {
-        str += "#BCI_Or";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Not))
-    {
-        str += "#BCI_Not";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Equals))
-    {
-        str += "#BCI_Equals";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_NotEquals))
-    {
-        str += "#BCI_NotEquals";
-    }    
-    else if(ins.Op == IndexOfInstruction(BCI_Cmp))
-    {
-        str += "#BCI_Cmp";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_LoadCmp))
-    {
-        str += "#BCI_LoadCmp";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_JumpFalse))
-    {
-        str += "#BCI_JumpFalse";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Jump))
-    {
-        str += "#BCI_Jump";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Copy))
-    {
-        str += "#BCI_Copy";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_ResolveDirect))
-    {
-        str += "#BCI_ResolveDirect";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_ResolveScoped))
-    {
-        str += "#BCI_ResolveScoped";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_BindScope))
-    {
-        str += "#BCI_BindScope";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_BindSection))
+    if(nameId < SIMPLE_CALLS)
     {
-        str += "#BCI_BindSection";
+        return *SimpleCallNames[nameId];
     }
-    else if(ins.Op == IndexOfInstruction(BCI_BindType))
-    {
-        str += "#BCI_BindType";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Eval))
-    {
-        str += "#BCI_Eval";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_EvalHere))
-    {
-        str += "#BCI_EvalHere";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Return))
-    {
-        str += "#BCI_Return";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Array))
-    {
-        str += "#BCI_Array";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_EnterLocal))
-    {
-        str += "#BCI_EnterLocal";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_LeaveLocal))
-    {
-        str += "#BCI_LeaveLocal";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Extend))
-    {
-        str += "#BCI_Extend";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_NOP))
-    {
-        str += "#BCI_NOP";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_Dup))
-    {
-        str += "#BCI_Dup";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_EndLine))
-    {
-        str += "#BCI_EndLine";
-    }
-    else if(ins.Op == IndexOfInstruction(BCI_DropTOS))
+    return vm->CallNames[nameId - SIMPLE_CALLS];
+}
+
+/// returns a string representation of the primitive with [primitiveId], as used by
+/// BCI_LoadPrimitive
+String PrimitiveFor(PebbleVM* vm, extArg_t primitiveId)
+{
+    auto call = vm->ConstPrimitives[primitiveId];
+    if(call->BoundScope != &NothingScope)
     {
-        str += "#BCI_DropTOS";
+        return StringValueOf(call);
     }
-    else if(ins.Op == IndexOfInstruction(BCI_Is))
+    return CallTypeToString(call);
+}
+
+/// returns a string representation of a [slot] used by BCI_LoadLocal/BCI_StoreLocal
+String ToString(PebbleVM* vm, const LocalSlot& slot)
+{
+    return Msg("%s @ %i", CallNameFor(vm, slot.NameId), slot.Slot);
+}
+
+/// the name of each instruction, indexed by its BCI_Id
+static const char* const InstructionNames[] =
+{
+    "BCI_LoadCallName", "BCI_LoadPrimitive", "BCI_Assign", "BCI_Add", "BCI_Subtract",
+    "BCI_Multiply", "BCI_Divide", "BCI_SysCall", "BCI_And", "BCI_Or", "BCI_Not", "BCI_NotEquals",
+    "BCI_Equals", "BCI_Cmp", "BCI_LoadCmp", "BCI_JumpFalse", "BCI_Jump", "BCI_Copy", "BCI_BindType",
+    "BCI_ResolveDirect", "BCI_ResolveScoped", "BCI_BindScope", "BCI_BindSection", "BCI_EvalHere",
+    "BCI_Eval", "BCI_Return", "BCI_Array", "BCI_EnterLocal", "BCI_LeaveLocal", "BCI_NOP", "BCI_Dup",
+    "BCI_EndLine", "BCI_DropTOS", "BCI_Is", "BCI_LoadLocal", "BCI_StoreLocal", "BCI_ResolveName",
+    "BCI_AddConst", "BCI_SubtractConst", "BCI_CmpJumpFalse", "BCI_TailEval",
+};
+
+static_assert(sizeof(InstructionNames) / sizeof(InstructionNames[0]) == OP_NumberOfInstructions,
+    "InstructionNames must name every instruction");
+
+String InstructionName(uint8_t op)
+{
+    if(op < OP_NumberOfInstructions)
     {
-        str += "#BCI_Is";
+        return InstructionNames[op];
     }
-    else
+    return "?????????" + std::to_string(op);
+}
+
+/// returns a string represntation of an instruction [ins]
+String ToString(PebbleVM* vm, ByteCodeInstruction& ins)
+{
+    String str = "#" + InstructionName(ins.Op);
+    String decodedArg;
+
+    switch(ins.Op)
     {
-        str += "#?????????" + std::to_string(ins.Op);
+        case OP_LoadCallName:
+        case OP_ResolveName:
+            decodedArg = CallNameFor(vm, ins.Arg);
+            break;
+
+        case OP_LoadPrimitive:
+        case OP_AddConst:
+        case OP_SubtractConst:
+            decodedArg = PrimitiveFor(vm, ins.Arg);
+            break;
+
+        case OP_LoadLocal:
+        case OP_StoreLocal:
+            decodedArg = ToString(vm, vm->LocalSlots[ins.Arg]);
+            break;
+
+        case OP_CmpJumpFalse:
+            decodedArg = Msg("cmp %i -> %i", (int)CmpJumpComparisonOf(ins.Arg), (int)CmpJumpTargetOf(ins.Arg));
+            break;
     }
     
     while(str.size() < 22)
@@ -188,20 +101,20 @@ String ToString(ByteCodeInstruction& ins)
 }
 
 /// returns a string representation of a [bciProgram] which is a list of ByteCodeInstructions
-String ToString(std::vector<ByteCodeInstruction>& bciProgram)
+String ToString(PebbleVM* vm, std::vector<ByteCodeInstruction>& bciProgram)
 {
     String str = "";
     int i=0;
     for(auto& ins: bciProgram)
     {
-        str += std::to_string(i++) + "\t" + ToString(ins)  + "\n";
+        str += std::to_string(i++) + "\t" + ToString(vm, ins)  + "\n";
     }
 
     return str;
 }
 
-/// logs the references and instructions of ByteCodeProgram
-void LogProgramInstructions()
+/// logs the references and instructions of the ByteCodeProgram of [vm]
+void LogProgramInstructions(PebbleVM* vm)
 {
     String refNames = "Call list\n";
 
@@ -211,19 +124,19 @@ void LogProgramInstructions()
     }
 
 
-    for(size_t i=0; i<CallNames.size(); i++)
+    for(size_t i=0; i<vm->CallNames.size(); i++)
     {
-        refNames +=  Msg("%i:\t %s\n", i + SIMPLE_CALLS, CallNames[i]);
+        refNames +=  Msg("%i:\t %s\n", i + SIMPLE_CALLS, vm->CallNames[i]);
     }
     
     LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", refNames);
 
     String primitives = "Const Primitives\n";
-    for(size_t i=0; i<ConstPrimitives.size(); i++)
+    for(size_t i=0; i<vm->ConstPrimitives.size(); i++)
     {
-        primitives += Msg("%i: %s", i, ToString(ConstPrimitives[i]));
+        primitives += Msg("%i: %s", i, ToString(vm->ConstPrimitives[i]));
     }
     
     LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", primitives);
-    LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", Msg("\n%s", ToString(ByteCodeProgram)));
+    LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", Msg("\n%s", ToString(vm, vm->ByteCodeProgram)));
 }
@@ -6,7 +6,10 @@
 // ---------------------------------------------------------------------------------------------------------------------
 // Display methods
 
-void LogProgramInstructions();
-String ToString(ByteCodeInstruction& ins);
+void LogProgramInstructions(PebbleVM* vm);
+String ToString(PebbleVM* vm, ByteCodeInstruction& ins);
+
+/// returns the name of the instruction with the id [op], such as "BCI_Add"
+String InstructionName(uint8_t op);
 
 #endif
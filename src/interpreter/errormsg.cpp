@@ -12,34 +12,29 @@
 // ---------------------------------------------------------------------------------------------------------------------
 // Error Handling
 
-bool ErrorFlag = false;
-int ErrorCode = 0;
-String ErrorMsg;
-SystemMessageType ErrorType;
-bool FatalErrorOccured = false;
-
-std::vector<extArg_t> ByteCodeLineAssociation;
-
-inline int GetLineNumberFromInstructionNumber(extArg_t instructionNumber, Program* p)
+/// returns the number of the line of [p] which holds the instruction [instructionNumber]
+/// of [vm]
+inline int GetLineNumberFromInstructionNumber(const PebbleVM* vm, extArg_t instructionNumber, Program* p)
 {
+    auto& lineAssociation = vm->ByteCodeLineAssociation;
     extArg_t i = 0;
-    for(; i< ByteCodeLineAssociation.size() && ByteCodeLineAssociation[i] < instructionNumber; i++);
+    for(; i< lineAssociation.size() && lineAssociation[i] < instructionNumber; i++);
     return p->Lines[i-1].LineNumber;
 }
 
-void IfNeededDisplayError(Program* p)
+void IfNeededDisplayError(PebbleVM* vm, Program* p)
 {
-    if(ErrorFlag)
+    if(vm->ErrorFlag)
     {
-        ErrorFlag = false;
-        int lineNumber = GetLineNumberFromInstructionNumber(InstructionReg, p);        
-        String fatalStatus = (ErrorType == SystemMessageType::Exception ? "Fatal" : "");        
-        auto stringMsg = Msg("%s %s at line[%i]: %s\n     (!)   %s\n", fatalStatus, SystemMessageTypeString(ErrorType), lineNumber, ErrorClasses[ErrorCode].ErrorMsg, ErrorMsg);
+        vm->ErrorFlag = false;
+        int lineNumber = GetLineNumberFromInstructionNumber(vm, vm->InstructionReg, p);        
+        String fatalStatus = (vm->ErrorType == SystemMessageType::Exception ? "Fatal" : "");        
+        auto stringMsg = Msg("%s %s at line[%i]: %s\n     (!)   %s\n", fatalStatus, SystemMessageTypeString(vm->ErrorType), lineNumber, ErrorClasses[vm->ErrorCode].ErrorMsg, vm->ErrorMsg);
 
-        ProgramOutput += stringMsg;
+        vm->Output->append(stringMsg);
         if(g_outputOn)
-            std::cerr << ConsoleColorForMessage(ErrorType) << stringMsg << CONSOLE_RESET;
-        ProgramMsgs.append(stringMsg);
+            std::cerr << ConsoleColorForMessage(vm->ErrorType) << stringMsg << CONSOLE_RESET;
+        vm->Messages->append(stringMsg);
     }
 }
 
@@ -2,33 +2,28 @@
 #define __ERRORMSG_H
 
 #include "abstract.h"
+#include "vm.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Error Handling
 
-extern bool ErrorFlag;
-extern int ErrorCode;
-extern String ErrorMsg;
-extern SystemMessageType ErrorType;
-extern bool FatalErrorOccured;
-
-inline void ReportError(SystemMessageType errorType, int errorCode, String errorMsg)
+inline void ReportError(PebbleVM* vm, SystemMessageType errorType, int errorCode, String errorMsg)
 {
-    ErrorFlag = true;
+    vm->ErrorFlag = true;
 
-    ErrorMsg = errorMsg;
-    ErrorCode = errorCode;
-    ErrorType = errorType;
+    vm->ErrorMsg = errorMsg;
+    vm->ErrorCode = errorCode;
+    vm->ErrorType = errorType;
 }
 
-inline void ReportFatalError(SystemMessageType errorType, int errorCode, String errorMsg)
+inline void ReportFatalError(PebbleVM* vm, SystemMessageType errorType, int errorCode, String errorMsg)
 {
-    ErrorFlag = true;
-    FatalErrorOccured = true;
+    vm->ErrorFlag = true;
+    vm->FatalErrorOccured = true;
 
-    ErrorMsg = errorMsg;
-    ErrorCode = errorCode;
-    ErrorType = errorType;
+    vm->ErrorMsg = errorMsg;
+    vm->ErrorCode = errorCode;
+    vm->ErrorType = errorType;
 }
 
 struct ByteCodeError
@@ -38,10 +33,9 @@ struct ByteCodeError
 };
 
 extern ByteCodeError ErrorClasses[];
-void IfNeededDisplayError(Program* p);
 
-/// stores the running total number of byte code instructions obtained from
-/// all lines less that the value of the index
-extern std::vector<extArg_t> ByteCodeLineAssociation;
+/// displays the error reported to [vm] while running [p], if there is one, and
+/// clears its ErrorFlag
+void IfNeededDisplayError(PebbleVM* vm, Program* p);
 
-#endif
\ No newline at end of file
+#endif
@@ -16,6 +16,7 @@
 #include "bytecode.h"
 #include "errormsg.h"
 #include "dis.h"
+#include "fusion.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // TODO
@@ -31,142 +32,90 @@ static Operation* GlobalBlockOwner;
 /// constant used in instructions which do not use the argument
 constexpr extArg_t noArg = 0;
 
-/// constant used to mask a single byte
-constexpr extArg_t ByteMask = 0xff;
-
-/// zeros the byte with [byteNumber] in arg, modifying it, and returns the byte
-inline uint8_t RemoveByteFromLongArg(extArg_t& arg, int byteNumber)
-{
-    extArg_t extendArg = arg & (ByteMask << (byteNumber * 8));
-    uint8_t scaledExtendArg = extendArg >> (byteNumber * 8);
-    arg = (~(ByteMask << (byteNumber * 8))) & arg; 
-    return scaledExtendArg;
-}
-
-/// adds the necessary extend operation to represent the long form of [arg] by bytes and 
-/// returns the least significant byte
-inline uint8_t IfNecessaryAddExtendInstructionAndReduce(extArg_t arg)
+/// returns [arg] as it is stored in a ByteCodeInstruction
+inline uint32_t InstructionArg(extArg_t arg)
 {
-    int extendExp = 1;
-    while(arg > 255 && extendExp < 8)
+    if(arg > MaxInstructionArg)
     {
-        uint8_t opId = IndexOfInstruction(BCI_Extend);
-        uint8_t scaledExtendArg = RemoveByteFromLongArg(arg, extendExp);
-        ByteCodeProgram.push_back( {opId, scaledExtendArg} );
-        extendExp++;
+        LogIt(LogSeverityType::Sev3_Critical, "InstructionArg", "argument is too large for an instruction");
     }
-    arg = arg & ByteMask;
-
-    return arg;
+    return static_cast<uint32_t>(arg);
 }
 
-/// add the instruction for [opId] with [arg], breaking [arg] into individual bytes
-/// if it is too long
-inline void AddByteCodeInstruction(uint8_t opId, extArg_t arg)
+/// add the instruction for [opId] with [arg]
+inline void AddByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg)
 {
-    uint8_t reducedArg = IfNecessaryAddExtendInstructionAndReduce(arg);
-    ByteCodeProgram.push_back( {opId, reducedArg} );
+    vm->ByteCodeProgram.push_back( {opId, InstructionArg(arg)} );
 }
 
-/// rewrites extend instructions starting [atPos] to represent the long for mof [arg]
-/// and returns the least significant byte
-inline uint8_t IfNecessaryRewriteExtendInstructionAndReduce(extArg_t arg, extArg_t& atPos)
+/// rewrite the instruction at [atPos] to be [opId] with [arg]. as every instruction
+/// has the same width, this never moves any other instruction
+inline void RewriteByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg, extArg_t atPos)
 {
-    int extendExp = 1;
-    while(arg > 255 && extendExp < 8)
-    {
-        uint8_t opId = IndexOfInstruction(BCI_Extend);
-        uint8_t scaledExtendArg = RemoveByteFromLongArg(arg, extendExp);
-        ByteCodeProgram[atPos++] = {opId, scaledExtendArg};
-        extendExp++;
-    }
-    arg = arg & ByteMask;
-
-    return arg;
-}
-
-/// rewrite a byte code instuction [opId] starting [atPOs], ensuring that the long form of [arg] is broken into
-/// individual bits
-inline void RewriteByteCodeInstruction(uint8_t opId, extArg_t arg, extArg_t atPos)
-{
-    uint8_t reducedArg = IfNecessaryRewriteExtendInstructionAndReduce(arg, atPos);
-    ByteCodeProgram[atPos] = {opId, reducedArg};
+    vm->ByteCodeProgram[atPos] = {opId, InstructionArg(arg)};
 }
 
 /// returns the current instruction id
-inline extArg_t CurrentInstructionId()
+inline extArg_t CurrentInstructionId(PebbleVM* vm)
 {
-    return ByteCodeProgram.size()-1;
+    return vm->ByteCodeProgram.size()-1;
 }
 
 /// returns the next instruction id
-inline extArg_t NextInstructionId()
-{
-    return ByteCodeProgram.size();
-}
-
-/// returns the number of bytes needed to represent the current instruction id
-inline int CurrentInstructionMagnitude()
+inline extArg_t NextInstructionId(PebbleVM* vm)
 {
-    extArg_t ip = CurrentInstructionId();
-    int magnitude = 0;
-    for(ip = ip >> 8; ip; ip = ip >> 8)
-    {
-        magnitude++;   
-    }
-
-    return magnitude;
+    return vm->ByteCodeProgram.size();
 }
 
-/// adds [i] NOP instructions
-inline void AddNOPS(int i)
+/// adds a placeholder for an instruction [opId] whose argument is not yet known and
+/// returns its id. the placeholder is later resolved by RewriteByteCodeInstruction
+inline extArg_t AddUnresolvedInstruction(PebbleVM* vm, uint8_t opId)
 {
-    for(;i; i-=1)
-    {
-        uint8_t opId = IndexOfInstruction(BCI_NOP);
-        AddByteCodeInstruction(opId, noArg);
-    }
+    extArg_t id = NextInstructionId(vm);
+    AddByteCodeInstruction(vm, opId, noArg);
+    return id;
 }
 
 /// add an instruction marking the end of a line of code
-inline void AddEndLineInstruction()
+inline void AddEndLineInstruction(PebbleVM* vm)
 {
-    AddByteCodeInstruction(IndexOfInstruction(BCI_EndLine), noArg);
+    AddByteCodeInstruction(vm, IndexOfInstruction(BCI_EndLine), noArg);
 }
 
+
 /// add instructions for listing params when defining a method and sets 
 /// arg to the number of params the method takes
-inline void AddInstructionsForDefMethodParameters(Operation* op, extArg_t& arg)
+inline void AddInstructionsForDefMethodParameters(PebbleVM* vm, Operation* op, extArg_t& arg)
 {
     uint8_t opId;
     arg = 0;
     
     opId = IndexOfInstruction(BCI_EnterLocal);
-    AddByteCodeInstruction(opId, 1);
+    AddByteCodeInstruction(vm, opId, 1);
 
     /// assumes the tuple contains one argumented scope resolutions
     if(op->Type == OperationType::Tuple)
     {
         for(auto operand: op->Operands)
         {
-            FlattenOperation(operand);
+            FlattenOperation(vm, operand);
             arg++;
 
             opId = IndexOfInstruction(BCI_EndLine);
-            AddByteCodeInstruction(opId, noArg);
+            AddByteCodeInstruction(vm, opId, noArg);
         }
     }
     else
     {
-        FlattenOperation(op);
+        FlattenOperation(vm, op);
         arg = 1;
 
         opId = IndexOfInstruction(BCI_EndLine);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
 
     opId = IndexOfInstruction(BCI_LeaveLocal);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 }
 
 /// true if [op] is an expression (not of type OperationType::Ref)
@@ -177,7 +126,7 @@ inline bool OperationIsExpression(Operation* op)
 
 /// add instructions for listing params when evaluating a method and sets
 /// arg to the number of params the method takes
-inline void AddInstructionsForEvaluateParameters(Operation* evalOp, extArg_t& arg)
+inline void AddInstructionsForEvaluateParameters(PebbleVM* vm, Operation* evalOp, extArg_t& arg)
 {
     if(evalOp->Operands.size() < 3)
     {
@@ -191,7 +140,7 @@ inline void AddInstructionsForEvaluateParameters(Operation* evalOp, extArg_t& ar
     {
         for(auto operand: op->Operands)
         {
-            FlattenOperation(operand);
+            FlattenOperation(vm, operand);
             arg++;
         }
     }
@@ -199,24 +148,16 @@ inline void AddInstructionsForEvaluateParameters(Operation* evalOp, extArg_t& ar
     {
         if(OperationIsExpression(op))
         {
-            FlattenOperation(op);
+            FlattenOperation(vm, op);
         }
         else
         {
-            FlattenOperationRefDirect(op);
+            FlattenOperationRefDirect(vm, op);
         }
         arg = 1;
     }
 }
 
-/// returns the number of NOPs to used in unresolved jumps to be reasonably sure that no bytecode
-/// will be overwritten when adding extends
-int NOPSafetyDomainSize()
-{
-    return 2 + CurrentInstructionMagnitude();
-}
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 // Jump Context
 // A jump context is used to flatten if-else-blocks into bytecode. Unresolved jumps
@@ -226,18 +167,16 @@ int NOPSafetyDomainSize()
 // the next if-header (if/else-if/else) if evaluated as false.
 
 /// adds a segment of bytecode which will later be resolved as a unconditional jump
-inline void AddInstructionsForUnresolvedJump(JumpContext& ctx)
+inline void AddInstructionsForUnresolvedJump(PebbleVM* vm, JumpContext& ctx)
 {
-    ctx.UnresolvedJumps.push_back(NextInstructionId());
-    AddNOPS(NOPSafetyDomainSize());
+    ctx.UnresolvedJumps.push_back(AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_Jump)));
 }
 
 /// adds a segment of bytecode which will later be resolved as a conditional jump
-inline void AddInstructionsForUnresolvedJumpFalse(JumpContext& ctx)
+inline void AddInstructionsForUnresolvedJumpFalse(PebbleVM* vm, JumpContext& ctx)
 {
-    ctx.UnresolvedJumpFalse = NextInstructionId();
+    ctx.UnresolvedJumpFalse = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_JumpFalse));
     ctx.HasUnresolvedJumpFalse = true;
-    AddNOPS(NOPSafetyDomainSize());
 }
 
 /// initialize a new JumpContext
@@ -256,31 +195,31 @@ inline void ClearJumpContext(JumpContext& ctx)
 
 /// resolves all unresolved jumps (conditional/unconditional) remaining in a JumpContext
 /// to jump to the NextInstructionId
-inline void ResolveJumpContext(JumpContext& ctx)
+inline void ResolveJumpContext(PebbleVM* vm, JumpContext& ctx)
 {
     uint8_t opId = IndexOfInstruction(BCI_Jump);
-    extArg_t jumpTo = NextInstructionId();
+    extArg_t jumpTo = NextInstructionId(vm);
     for(extArg_t pos: ctx.UnresolvedJumps)
     {
-        RewriteByteCodeInstruction(opId, jumpTo, pos);  
+        RewriteByteCodeInstruction(vm, opId, jumpTo, pos);  
     }
 
     opId = IndexOfInstruction(BCI_JumpFalse);
     if(ctx.HasUnresolvedJumpFalse)
     {
-        RewriteByteCodeInstruction(opId, jumpTo, ctx.UnresolvedJumpFalse);
+        RewriteByteCodeInstruction(vm, opId, jumpTo, ctx.UnresolvedJumpFalse);
     }
 
     ClearJumpContext(ctx);
 }
 
 /// resolves the latest conditional jump to the NextInstructionId
-inline void ResolveJumpContextClause(JumpContext& ctx)
+inline void ResolveJumpContextClause(PebbleVM* vm, JumpContext& ctx)
 {
     uint8_t opId = IndexOfInstruction(BCI_JumpFalse);
-    extArg_t jumpTo = NextInstructionId();
+    extArg_t jumpTo = NextInstructionId(vm);
 
-    RewriteByteCodeInstruction(opId, jumpTo, ctx.UnresolvedJumpFalse);
+    RewriteByteCodeInstruction(vm, opId, jumpTo, ctx.UnresolvedJumpFalse);
     ctx.HasUnresolvedJumpFalse = false;
 }
 
@@ -366,8 +305,139 @@ inline bool IsSimpleCall(Operation* op)
     return false;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Slots
+// names used in the body of a method are expected at fixed indexes (slots) of the 
+// scope of the method: first the names created by the method's parameter list, then
+// the names in the order they are first used at the top level of the body. these 
+// names are flattened into BCI_LoadLocal/BCI_StoreLocal, which check the slot at 
+// runtime and resolve the name as usual if it does not hold the expected call
+
+/// slot contexts of the method bodies being flattened
+std::vector<SlotContext> SlotContexts;
+
+/// names created by the parameter list being flattened, or nullptr when no
+/// parameter list is being flattened
+std::vector<extArg_t>* ParamScopeNames = nullptr;
+
+/// names created by the parameter list of the last method definition flattened
+std::vector<extArg_t> DefinedParamScopeNames;
+
+/// the operation which defined DefinedParamScopeNames
+Operation* DefinedParamScopeOwner = nullptr;
+
+/// true if [names] contains [nameId] and sets [atPosition] to its position
+inline bool ContainsName(const std::vector<extArg_t>& names, extArg_t nameId, size_t& atPosition)
+{
+    for(size_t i=0; i<names.size(); i++)
+    {
+        if(names[i] == nameId)
+        {
+            atPosition = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// true if the name of [op] (assumed to be a non-primitive OperationType::Ref) could
+/// be given a slot
+inline bool CanHaveSlot(Operation* op)
+{
+    return !IsSimpleCall(op) && !CallNameIsKeyword(&op->Value->Name);
+}
+
+/// true if [op] (assumed to be a non-primitive OperationType::Ref) refers to a name
+/// created by the parameter list of the method being flattened
+inline bool HasParamSlot(Operation* op)
+{
+    if(ParamScopeNames != nullptr || SlotContexts.empty() || !CanHaveSlot(op))
+    {
+        return false;
+    }
+
+    size_t atPosition;
+    auto& ctx = SlotContexts.back();
+    return ContainsName(ctx.SlotNames, op->EntityIndex, atPosition) && atPosition < ctx.NumberOfParamSlots;
+}
+
+/// true if [op] (assumed to be a non-primitive OperationType::Ref) should be flattened
+/// using a slot, and sets [slotId] to the index of the slot in LocalSlots. records the 
+/// name of [op] if it will be created in the scope of a method
+inline bool IfPossibleGetSlot(PebbleVM* vm, Operation* op, extArg_t& slotId)
+{
+    extArg_t nameId = op->EntityIndex;
+    size_t atPosition;
+
+    if(ParamScopeNames != nullptr)
+    {
+        /// parameter lists are detached, so every name but a keyword is created
+        if(!CallNameIsKeyword(&op->Value->Name) && !ContainsName(*ParamScopeNames, nameId, atPosition))
+        {
+            ParamScopeNames->push_back(nameId);
+        }
+        return false;
+    }
+
+    if(SlotContexts.empty() || !CanHaveSlot(op))
+    {
+        return false;
+    }
+
+    auto& ctx = SlotContexts.back();
+    if(!ContainsName(ctx.SlotNames, nameId, atPosition))
+    {
+        /// names first used inside an anonymous scope are created there
+        if(ctx.Depth > 0)
+        {
+            return false;
+        }
+
+        atPosition = ctx.SlotNames.size();
+        ctx.SlotNames.push_back(nameId);
+    }
+
+    slotId = vm->LocalSlots.size();
+    vm->LocalSlots.push_back({ atPosition, nameId });
+    return true;
+}
+
+/// enter the slot context for the body of a method defined by [methodOwner]
+inline void EnterSlotContext(Operation* methodOwner)
+{
+    SlotContext ctx;
+    if(methodOwner != nullptr && methodOwner == DefinedParamScopeOwner)
+    {
+        ctx.SlotNames = DefinedParamScopeNames;
+    }
+    ctx.NumberOfParamSlots = ctx.SlotNames.size();
+    ctx.Depth = 0;
+
+    SlotContexts.push_back(ctx);
+}
+
+/// leave the slot context of the method body being flattened
+inline void LeaveSlotContext()
+{
+    SlotContexts.pop_back();
+}
+
+/// record that an anonymous scope is entered (by [change] = 1) or left (by 
+/// [change] = -1) in the method body being flattened
+inline void ChangeSlotContextDepth(int change)
+{
+    if(!SlotContexts.empty())
+    {
+        SlotContexts.back().Depth += change;
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Flattening operations
+
 /// flatten a OperationType::Ref [op] which may point to a primitive object
-void FlattenOperationRefDirect(Operation* op)
+void FlattenOperationRefDirect(PebbleVM* vm, Operation* op)
 {
     uint8_t opId;
     extArg_t arg = op->EntityIndex;
@@ -375,75 +445,80 @@ void FlattenOperationRefDirect(Operation* op)
     if(OperationRefIsPrimitive(op))
     {
         opId = IndexOfInstruction(BCI_LoadPrimitive);
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
+    }
+    else if(IfPossibleGetSlot(vm, op, arg))
+    {
+        opId = IndexOfInstruction(BCI_LoadLocal);
+        AddByteCodeInstruction(vm, opId, arg);
     }
     else
     {
         opId = IndexOfInstruction(BCI_LoadCallName);
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
         opId = IndexOfInstruction(BCI_ResolveDirect);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
 }
 
 /// flattens an OperationType::Ref [op] which cannot be a primitive (it is scoped)
-void FlattenOperationRefScoped(Operation* op, bool& isRef)
+void FlattenOperationRefScoped(PebbleVM* vm, Operation* op, bool& isRef)
 {
     uint8_t opId = IndexOfInstruction(BCI_LoadCallName);
     extArg_t arg = op->EntityIndex;
 
     isRef = true;
 
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// flattens a OperationType::ScopeResolution [op] assuming it is direct and has
 /// only 1 operand
-void FlattenOperationScopeResolutionDirect(Operation* op)
+void FlattenOperationScopeResolutionDirect(PebbleVM* vm, Operation* op)
 {
     auto firstOperand = op->Operands[0];
-    FlattenOperationRefDirect(firstOperand);
+    FlattenOperationRefDirect(vm, firstOperand);
 }
 
 /// flattens a OperationType::ScopeResolution [op] assuming it is scoped and has
 /// exactly 2 operands
-void FlattenOperationScopeResolutionScoped(Operation* op)
+void FlattenOperationScopeResolutionScoped(PebbleVM* vm, Operation* op)
 {
     auto firstOperand = op->Operands[0];
     if(firstOperand->Type == OperationType::ScopeResolution)
     {
-        FlattenOperationScopeResolution(firstOperand);
+        FlattenOperationScopeResolution(vm, firstOperand);
     }
     else
     {
         /// must be an expression
-        FlattenOperation(firstOperand);
+        FlattenOperation(vm, firstOperand);
     }
 
     auto secondOperand = op->Operands[1];
     bool isRef = false;
-    FlattenOperationRefScoped(secondOperand, isRef);
+    FlattenOperationRefScoped(vm, secondOperand, isRef);
 
     if(isRef)
     {
         uint8_t opId = IndexOfInstruction(BCI_ResolveScoped);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
 }
 
 /// TODO: might (won't) work with scoped pritmitives (ie X.4)
 /// flattens an OperationType::ScopeResolution [op] w
-void FlattenOperationScopeResolution(Operation* op)
+void FlattenOperationScopeResolution(PebbleVM* vm, Operation* op)
 {
     if(op->Operands.size() == 1)
     {
-        FlattenOperationScopeResolutionDirect(op);
+        FlattenOperationScopeResolutionDirect(vm, op);
     }
     else
     {
         // must be case of scoped resolution
-        FlattenOperationScopeResolutionScoped(op);
+        FlattenOperationScopeResolutionScoped(vm, op);
     }
 }
 
@@ -468,18 +543,18 @@ bool IsOperationComparision(Operation* op)
 /// 5: <=
 /// 6: >=
 /// see vm.cpp for official list
-inline void FlattenOperationComparison(Operation* op)
+inline void FlattenOperationComparison(PebbleVM* vm, Operation* op)
 {
     for(auto operand: op->Operands)
     {
-        FlattenOperation(operand);
+        FlattenOperation(vm, operand);
     }
 
     uint8_t opId;
     extArg_t arg;
 
     opId = IndexOfInstruction(BCI_Cmp);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 
     opId = IndexOfInstruction(BCI_LoadCmp);
     switch(op->Type)
@@ -504,7 +579,7 @@ inline void FlattenOperationComparison(Operation* op)
         return;
     }
     
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// flattens generic operations [op] which all follow the the same format and are generally
@@ -517,11 +592,11 @@ inline void FlattenOperationComparison(Operation* op)
 /// isequal/is
 /// array
 /// dotypebinding new
-inline void FlattenOperationGeneric(Operation* op)
+inline void FlattenOperationGeneric(PebbleVM* vm, Operation* op)
 {
     for(auto operand: op->Operands)
     {
-        FlattenOperation(operand);
+        FlattenOperation(vm, operand);
     }
 
     uint8_t opId;
@@ -595,109 +670,128 @@ inline void FlattenOperationGeneric(Operation* op)
         LogIt(LogSeverityType::Sev3_Critical, "FlattenOperationGeneric", Msg("unknown or unimplemented, %s", ToString(op->Type)));
         return;
     }
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds bytecode instructions for [op] with OperationType::Assign
-inline void FlattenOperationAssign(Operation* op)
+inline void FlattenOperationAssign(PebbleVM* vm, Operation* op)
 {
+    auto lhs = op->Operands[0];
+
+    /// parameters always exist, so they can be assigned after the right operand
+    if(lhs->Type == OperationType::Ref && !OperationRefIsPrimitive(lhs) && HasParamSlot(lhs))
+    {
+        extArg_t arg;
+        FlattenOperation(vm, op->Operands[1]);
+        IfPossibleGetSlot(vm, lhs, arg);
+        AddByteCodeInstruction(vm, IndexOfInstruction(BCI_StoreLocal), arg);
+        return;
+    }
+
     if(op->Operands[0]->Type == OperationType::ScopeResolution)
     {
-        FlattenOperationScopeResolution(op->Operands[0]);
+        FlattenOperationScopeResolution(vm, op->Operands[0]);
     }
     else if(op->Operands[0]->Type == OperationType::Ref)
     {
-        FlattenOperationRefDirect(op->Operands[0]);
+        FlattenOperationRefDirect(vm, op->Operands[0]);
     }
     else
     {
-        FlattenOperation(op->Operands[0]);
+        FlattenOperation(vm, op->Operands[0]);
     }
 
-    FlattenOperation(op->Operands[1]);
+    FlattenOperation(vm, op->Operands[1]);
     uint8_t opId = IndexOfInstruction(BCI_Assign);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 }
 
 /// adds bytecode instructions for [op] with OperationType::DefineMethod
-inline void FlattenOperationDefineMethod(Operation* op)
+inline void FlattenOperationDefineMethod(PebbleVM* vm, Operation* op)
 {
     uint8_t opId;
     extArg_t arg;
     
     arg = noArg;
 
+    std::vector<extArg_t> paramScopeNames;
+
     if(op->Operands.size() > 0)
     {
-        AddInstructionsForDefMethodParameters(op->Operands[0], arg);
+        ParamScopeNames = &paramScopeNames;
+        AddInstructionsForDefMethodParameters(vm, op->Operands[0], arg);
+        ParamScopeNames = nullptr;
     }
     else
     {
         opId = IndexOfInstruction(BCI_EnterLocal);
-        AddByteCodeInstruction(opId, 1);
+        AddByteCodeInstruction(vm, opId, 1);
 
         opId = IndexOfInstruction(BCI_LeaveLocal);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
 
+    DefinedParamScopeNames = paramScopeNames;
+    DefinedParamScopeOwner = op;
+
     opId = IndexOfInstruction(BCI_BindScope);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
-inline void FlattenOperationEvaluateAsArrayInitialization(Operation* op)
+inline void FlattenOperationEvaluateAsArrayInitialization(PebbleVM* vm, Operation* op)
 {
     uint8_t opId;
     extArg_t arg;
 
     opId = IndexOfInstruction(BCI_LoadCallName);
     arg = NOTHING_CALL_ID; 
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
     opId = IndexOfInstruction(BCI_ResolveDirect);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
     opId = IndexOfInstruction(BCI_LoadCallName);
     arg = ARRAY_CALL_ID;
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
     opId = IndexOfInstruction(BCI_ResolveDirect);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 
     opId = IndexOfInstruction(BCI_Copy);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 
-    AddInstructionsForEvaluateParameters(op, arg);
+    AddInstructionsForEvaluateParameters(vm, op, arg);
 
     opId = IndexOfInstruction(BCI_Eval);
-    AddByteCodeInstruction(opId, 1);
+    AddByteCodeInstruction(vm, opId, 1);
 }
 
-inline void FlattenOperationNew(Operation* op)
+inline void FlattenOperationNew(PebbleVM* vm, Operation* op)
 {
     uint8_t opId;
     extArg_t arg; 
 
     opId = IndexOfInstruction(BCI_LoadCallName);
     arg = NOTHING_CALL_ID; 
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
     opId = IndexOfInstruction(BCI_ResolveDirect);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
 
-    FlattenOperation(op->Operands[0]);
+    FlattenOperation(vm, op->Operands[0]);
 
     /// methods are done on cloned objects
     opId = IndexOfInstruction(BCI_Copy);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
     
     opId = IndexOfInstruction(BCI_Eval);
     arg = 0;
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds bytecode instructions for [op] with OperationType::Evaluate
-inline void FlattenOperationEvaluate(Operation* op)
+inline void FlattenOperationEvaluate(PebbleVM* vm, Operation* op)
 {
     /// order of operands is caller, method, params
     auto callerOp = op->Operands[0];
@@ -708,13 +802,13 @@ inline void FlattenOperationEvaluate(Operation* op)
 
     if(methodOp->Type == OperationType::DoTypeBinding && methodOp->Operands[0]->EntityIndex == ARRAY_CALL_ID)
     {
-        FlattenOperationEvaluateAsArrayInitialization(op);
+        FlattenOperationEvaluateAsArrayInitialization(vm, op);
         return;
     }
 
     if(methodOp->Type == OperationType::Ref && OperationRefIsPrimitive(methodOp) && methodOp->EntityIndex == ARRAY_CALL_ID)
     {
-        FlattenOperationEvaluateAsArrayInitialization(op);
+        FlattenOperationEvaluateAsArrayInitialization(vm, op);
         return;
     }
 
@@ -723,43 +817,43 @@ inline void FlattenOperationEvaluate(Operation* op)
     {
         opId = IndexOfInstruction(BCI_LoadCallName);
         arg = NOTHING_CALL_ID; 
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
         opId = IndexOfInstruction(BCI_ResolveDirect);
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
-        FlattenOperation(methodOp);
+        FlattenOperation(vm, methodOp);
     }
     else
     {
         // case for Expr.Ref()
-        FlattenOperation(callerOp);
+        FlattenOperation(vm, callerOp);
 
         opId = IndexOfInstruction(BCI_Dup);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
 
         opId = IndexOfInstruction(BCI_LoadCallName);
         arg = methodOp->EntityIndex;
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
         opId = IndexOfInstruction(BCI_ResolveScoped);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
     
 
     /// methods are done on cloned objects
     opId = IndexOfInstruction(BCI_Copy);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
     
     arg = 0;
-    AddInstructionsForEvaluateParameters(op, arg);
+    AddInstructionsForEvaluateParameters(vm, op, arg);
 
     opId = IndexOfInstruction(BCI_Eval);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds bytecode instructions for [op] with OperationType::EvaluateHere
-inline void FlattenOperationEvaluateHere(Operation* op)
+inline void FlattenOperationEvaluateHere(PebbleVM* vm, Operation* op)
 {
     op = op->Operands[0];
     /// order of operands is caller, method, params
@@ -773,36 +867,36 @@ inline void FlattenOperationEvaluateHere(Operation* op)
     {
         opId = IndexOfInstruction(BCI_LoadCallName);
         arg = methodOp->EntityIndex;
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
         opId = IndexOfInstruction(BCI_ResolveDirect);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
     else
     {
-        FlattenOperation(callerOp);
+        FlattenOperation(vm, callerOp);
 
         opId = IndexOfInstruction(BCI_LoadCallName);
         arg = methodOp->EntityIndex;
-        AddByteCodeInstruction(opId, arg);
+        AddByteCodeInstruction(vm, opId, arg);
 
         opId = IndexOfInstruction(BCI_ResolveScoped);
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
     }
 
     /// methods are done on cloned objects
     opId = IndexOfInstruction(BCI_Copy);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
     
     arg = 0;
-    AddInstructionsForEvaluateParameters(op, arg);
+    AddInstructionsForEvaluateParameters(vm, op, arg);
 
     opId = IndexOfInstruction(BCI_EvalHere);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds bytecode instructions for [op] with OperationType::Return
-inline void FlattenOperationReturn(Operation* op)
+inline void FlattenOperationReturn(PebbleVM* vm, Operation* op)
 {
     uint8_t opId;
     extArg_t arg;
@@ -813,80 +907,90 @@ inline void FlattenOperationReturn(Operation* op)
     }
     else
     {
-        FlattenOperation(op->Operands[0]);
+        FlattenOperation(vm, op->Operands[0]);
         arg = 1;
+
+        /// a method evaluated in tail position of a method body returns its own
+        /// result, so it is evaluated in place of the current call frame
+        auto& lastIns = vm->ByteCodeProgram.back();
+        if(!SlotContexts.empty() && lastIns.Op == IndexOfInstruction(BCI_Eval))
+        {
+            opId = IndexOfInstruction(BCI_TailEval);
+            RewriteByteCodeInstruction(vm, opId, lastIns.Arg, CurrentInstructionId(vm));
+            return;
+        }
     }
 
     opId = IndexOfInstruction(BCI_Return);
-    AddByteCodeInstruction(opId, arg);    
+    AddByteCodeInstruction(vm, opId, arg);    
 }
 
 /// adds bytecode instructions for [op] with OperationType::Ask
-inline void FlattenOperationAsk(Operation* op)
+inline void FlattenOperationAsk(PebbleVM* vm, Operation* op)
 {
     uint8_t opId = IndexOfInstruction(BCI_SysCall);
     extArg_t arg;
 
     if(op->Operands.size() > 0)
     {
-        FlattenOperation(op->Operands[0]);
+        FlattenOperation(vm, op->Operands[0]);
         arg = 0;
-        AddByteCodeInstruction(opId, noArg);
+        AddByteCodeInstruction(vm, opId, noArg);
 
-        AddEndLineInstruction();
+        AddEndLineInstruction(vm);
     }
 
     arg = 1;
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds bytecode instructions for an [op] based on its OperationType
-void FlattenOperation(Operation* op)
+void FlattenOperation(PebbleVM* vm, Operation* op)
 {
     if(op->Type == OperationType::ScopeResolution)
     {
-        FlattenOperationScopeResolution(op);
+        FlattenOperationScopeResolution(vm, op);
     }
     else if(op->Type == OperationType::Ref)
     {
-        FlattenOperationRefDirect(op);
+        FlattenOperationRefDirect(vm, op);
     }
     else if(op->Type == OperationType::Assign)
     {
-        FlattenOperationAssign(op);
+        FlattenOperationAssign(vm, op);
     }
     else if(op->Type == OperationType::DefineMethod)
     {
-        FlattenOperationDefineMethod(op);
+        FlattenOperationDefineMethod(vm, op);
         GlobalBlockOwner = op;
     }
     else if(op->Type == OperationType::Evaluate)
     {
-        FlattenOperationEvaluate(op);
+        FlattenOperationEvaluate(vm, op);
     }
     else if(op->Type == OperationType::Return)
     {
-        FlattenOperationReturn(op);
+        FlattenOperationReturn(vm, op);
     }
     else if(IsOperationComparision(op))
     {
-        FlattenOperationComparison(op);
+        FlattenOperationComparison(vm, op);
     }
     else if(op->Type == OperationType::EvaluateHere)
     {
-        FlattenOperationEvaluateHere(op);
+        FlattenOperationEvaluateHere(vm, op);
     }
     else if(op->Type == OperationType::Ask)
     {
-        FlattenOperationAsk(op);
+        FlattenOperationAsk(vm, op);
     }
     else if(op->Type == OperationType::New)
     {
-        FlattenOperationNew(op);
+        FlattenOperationNew(vm, op);
     }
     else
     {
-        FlattenOperationGeneric(op);
+        FlattenOperationGeneric(vm, op);
     }
 }
 
@@ -897,135 +1001,136 @@ void FlattenOperation(Operation* op)
 // Control flow
 
 /// adds instructions to enter an anonymous scope and do [block]
-inline void HandleAnonymousScope(Block* block)
+inline void HandleAnonymousScope(PebbleVM* vm, Block* block)
 {
     uint8_t opId;
     extArg_t arg = noArg;
 
     opId = IndexOfInstruction(BCI_EnterLocal);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
-    FlattenBlock(block);
+    ChangeSlotContextDepth(1);
+    FlattenBlock(vm, block);
+    ChangeSlotContextDepth(-1);
     
     opId = IndexOfInstruction(BCI_LeaveLocal);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
     opId = IndexOfInstruction(BCI_DropTOS);
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 }
 
 /// adds instructions to enter a while loop's [block] with the while loop gate
 /// clause starting at [whileInstructionStart]
-inline void HandleWhile(Block* block, extArg_t whileInstructionStart)
+inline void HandleWhile(PebbleVM* vm, Block* block, extArg_t whileInstructionStart)
 {
     uint8_t opId;
     extArg_t arg = noArg;
-    extArg_t JumpInstructionStart = NextInstructionId();
-    AddNOPS(NOPSafetyDomainSize());
+    extArg_t JumpInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_JumpFalse));
 
-    FlattenBlock(block);
+    FlattenBlock(vm, block);
     
     opId = IndexOfInstruction(BCI_Jump);
     arg = whileInstructionStart;
-    AddByteCodeInstruction(opId, arg);
+    AddByteCodeInstruction(vm, opId, arg);
 
 
     opId = IndexOfInstruction(BCI_JumpFalse);
-    arg = NextInstructionId();
-    RewriteByteCodeInstruction(opId, arg, JumpInstructionStart);
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, JumpInstructionStart);
 }
 
 /// add instructions to skip over executing [block] when defining it and returning out
 /// of [block] after execution
-inline void HandleDefineMethod(Block* block)
+inline void HandleDefineMethod(PebbleVM* vm, Block* block, Operation* blockOwner)
 {
     uint8_t opId;
     extArg_t arg = noArg;
 
-    extArg_t BindInstructionStart = NextInstructionId();
-    AddNOPS(NOPSafetyDomainSize());
-    extArg_t JumpInstructionStart = NextInstructionId();
-    AddNOPS(NOPSafetyDomainSize());
+    extArg_t BindInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_BindSection));
+    extArg_t JumpInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_Jump));
 
     opId = IndexOfInstruction(BCI_BindSection);
-    arg = NextInstructionId();
-    RewriteByteCodeInstruction(opId, arg, BindInstructionStart);
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, BindInstructionStart);
 
-    FlattenBlock(block);
+    EnterSlotContext(blockOwner);
+    FlattenBlock(vm, block);
+    LeaveSlotContext();
 
     opId = IndexOfInstruction(BCI_Return);
-    AddByteCodeInstruction(opId, noArg);
+    AddByteCodeInstruction(vm, opId, noArg);
 
     opId = IndexOfInstruction(BCI_Jump);
-    arg = NextInstructionId();
-    RewriteByteCodeInstruction(opId, arg, JumpInstructionStart);
-    AddEndLineInstruction();
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, JumpInstructionStart);
+    AddEndLineInstruction(vm);
 }
 
 /// add instructions enteri if and else-if clauses
-inline void HandleIf(Block* block, JumpContext& ctx)
+inline void HandleIf(PebbleVM* vm, Block* block, JumpContext& ctx)
 {
-    HandleAnonymousScope(block);
-    AddInstructionsForUnresolvedJump(ctx);
+    HandleAnonymousScope(vm, block);
+    AddInstructionsForUnresolvedJump(vm, ctx);
 }
 
 /// add instructions when presented with a [block] that may have a [blockOwner] (any gating instruction)
 /// that starts at [blockOwnerInstructionStart] and where [ctx] is the JumpContext of any
 /// if-complex that the block may be a part of
-inline void HandleFlatteningControlFlow(Block* block, Operation* blockOwner, extArg_t blockOwnerInstructionStart, JumpContext& ctx)
+inline void HandleFlatteningControlFlow(PebbleVM* vm, Block* block, Operation* blockOwner, extArg_t blockOwnerInstructionStart, JumpContext& ctx)
 {
     if(JumpContextNeedsResolution(ctx) && !IsPartOfIfComplex(blockOwner))
     {
-        ResolveJumpContext(ctx);
+        ResolveJumpContext(vm, ctx);
     }
 
     if(blockOwner == nullptr)
     {
-        HandleAnonymousScope(block);
+        HandleAnonymousScope(vm, block);
     }
     else if(blockOwner->Type == OperationType::While)
     {
-        HandleWhile(block, blockOwnerInstructionStart);
+        HandleWhile(vm, block, blockOwnerInstructionStart);
     }
     else if(blockOwner->Type == OperationType::If || blockOwner->Type == OperationType::ElseIf)
     {
-        HandleIf(block, ctx);
+        HandleIf(vm, block, ctx);
     }
     else if(blockOwner->Type == OperationType::Else)
     {
-        HandleAnonymousScope(block);
+        HandleAnonymousScope(vm, block);
     }
     else if(blockOwner->Type == OperationType::DefineMethod)
     {
-        HandleDefineMethod(block);
+        HandleDefineMethod(vm, block, blockOwner);
     }
     /// TODO: figure this out
     else if(blockOwner->Type == OperationType::Ref)
     {
-        HandleDefineMethod(block);
+        HandleDefineMethod(vm, block, nullptr);
     }
     else
     {
-        HandleAnonymousScope(block);
+        HandleAnonymousScope(vm, block);
     }
 }
 
 /// add instructions when presented with an [op] and sets [blockOwner] and [blockOwnerInstructionStart]
 /// to the values corresponding to the flatten bytecode of [op]. will resolve [ctx] if necessary
-inline void HandleFlatteningOperation(Operation* op, extArg_t& blockOwnerInstructionStart, Operation** blockOwner, JumpContext& ctx)
+inline void HandleFlatteningOperation(PebbleVM* vm, Operation* op, extArg_t& blockOwnerInstructionStart, Operation** blockOwner, JumpContext& ctx)
 {
     if(JumpContextNeedsResolution(ctx) && !IsPartOfIfContinuation(op))
     {
-        ResolveJumpContext(ctx);
+        ResolveJumpContext(vm, ctx);
     }
     else if(JumpContextHasUnresolvedClause(ctx))
     {
-        ResolveJumpContextClause(ctx);
+        ResolveJumpContextClause(vm, ctx);
     }
     
-    blockOwnerInstructionStart = NextInstructionId();
+    blockOwnerInstructionStart = NextInstructionId(vm);
     GlobalBlockOwner = nullptr;
-    FlattenOperation(op);
+    FlattenOperation(vm, op);
     if(GlobalBlockOwner != nullptr)
     {
         *blockOwner = GlobalBlockOwner;
@@ -1036,21 +1141,21 @@ inline void HandleFlatteningOperation(Operation* op, extArg_t& blockOwnerInstruc
     }
     
 
-    ByteCodeLineAssociation.push_back(NextInstructionId());
+    vm->ByteCodeLineAssociation.push_back(NextInstructionId(vm));
     
     if(!IsConditionalJump((*blockOwner)) && (*blockOwner)->Type != OperationType::Else && (*blockOwner)->Type != OperationType::DefineMethod) 
     {
-        AddEndLineInstruction();
+        AddEndLineInstruction(vm);
     }
 
     if(IsPartOfIfConditional(op))
     {
-        AddInstructionsForUnresolvedJumpFalse(ctx);
+        AddInstructionsForUnresolvedJumpFalse(vm, ctx);
     }
 }
 
 /// assumes that all ifs/whiles/methods have blocks
-void FlattenBlock(Block* block)
+void FlattenBlock(PebbleVM* vm, Block* block)
 {
     Operation* blockOwner = nullptr;
     extArg_t blockOwnerInstructionStart = 0;
@@ -1063,12 +1168,12 @@ void FlattenBlock(Block* block)
         switch(exec->ExecType)
         {
             case ExecutableType::Block:
-            HandleFlatteningControlFlow(static_cast<Block*>(exec), blockOwner, blockOwnerInstructionStart, ctx);
+            HandleFlatteningControlFlow(vm, static_cast<Block*>(exec), blockOwner, blockOwnerInstructionStart, ctx);
             blockOwner = nullptr;
             break;
 
             case ExecutableType::Operation:
-            HandleFlatteningOperation(static_cast<Operation*>(exec), blockOwnerInstructionStart, &blockOwner, ctx);
+            HandleFlatteningOperation(vm, static_cast<Operation*>(exec), blockOwnerInstructionStart, &blockOwner, ctx);
 
             break;
         }
@@ -1076,7 +1181,7 @@ void FlattenBlock(Block* block)
 
     if(JumpContextNeedsResolution(ctx) && !IsPartOfIfContinuation(blockOwner))
     {
-        ResolveJumpContext(ctx);
+        ResolveJumpContext(vm, ctx);
     }
 }
 
@@ -1090,11 +1195,11 @@ void FlattenBlock(Block* block)
 std::vector<Object*> PrimitiveObjectsEncountered;
 
 /// true if CallNames array contains [callName], sets [atPosition] to this position
-bool CallNamesContains(String callName, size_t& atPosition)
+bool CallNamesContains(PebbleVM* vm, String callName, size_t& atPosition)
 {
-    for(size_t i=0; i<CallNames.size(); i++)
+    for(size_t i=0; i<vm->CallNames.size(); i++)
     {
-        auto name = CallNames[i];
+        auto name = vm->CallNames[i];
         if(name == callName)
         {
             atPosition = i;
@@ -1106,19 +1211,19 @@ bool CallNamesContains(String callName, size_t& atPosition)
 
 /// add a new entry to CallNames if needed
 /// assumes [op] is OperationType::Ref
-void IfNeededAddReferenceName(Operation* op)
+void IfNeededAddReferenceName(PebbleVM* vm, Operation* op)
 {
     auto callName = op->Value->Name;
 
     size_t atPosition;
-    if(CallNamesContains(callName, atPosition))
+    if(CallNamesContains(vm, callName, atPosition))
     {
         op->EntityIndex = atPosition + SIMPLE_CALLS;
         return;
     }
 
-    op->EntityIndex = CallNames.size() + SIMPLE_CALLS;
-    CallNames.push_back(callName);
+    op->EntityIndex = vm->CallNames.size() + SIMPLE_CALLS;
+    vm->CallNames.push_back(callName);
 }
 
 bool EncounteredPrimitiveObject(Object* obj, size_t& atPosition)
@@ -1185,7 +1290,7 @@ void AssignValueFromObject(Call* c, Object* obj)
 
 /// add a new entry to ConstPrimitives if needed
 /// assumes [op] is OperationType::Ref
-void IfNeededAddConstPrimitive(Operation* op)
+void IfNeededAddConstPrimitive(PebbleVM* vm, Operation* op)
 {
     auto obj = op->Value->To;
     
@@ -1199,12 +1304,12 @@ void IfNeededAddConstPrimitive(Operation* op)
     op->EntityIndex = PrimitiveObjectsEncountered.size();
     PrimitiveObjectsEncountered.push_back(obj);
     
-    Call* call = CallConstructor();
+    Call* call = CallConstructor(vm->PrimitiveSlab);
     AssignValueFromObject(call, obj);
     BindScope(call, &SomethingScope);
     /// TODO: make this more robust
     BindType(call, ObjectClassToType(op->Value->To));
-    ConstPrimitives.push_back(call);
+    vm->ConstPrimitives.push_back(call);
 }
 
 void AssignEntityIndexForSimpleCall(Operation* op)
@@ -1250,13 +1355,13 @@ void AssignEntityIndexForSimpleCall(Operation* op)
 }
 
 /// recurses over the ast with [op] as head 
-void FirstPassOperation(Operation* op)
+void FirstPassOperation(PebbleVM* vm, Operation* op)
 {
     if(op->Type == OperationType::Ref)
     {
         if(OperationRefIsPrimitive(op))
         {
-            IfNeededAddConstPrimitive(op);
+            IfNeededAddConstPrimitive(vm, op);
         }
         else if(IsSimpleCall(op))
         {
@@ -1264,30 +1369,30 @@ void FirstPassOperation(Operation* op)
         }
         else
         {
-            IfNeededAddReferenceName(op);
+            IfNeededAddReferenceName(vm, op);
         }
         return;
     }
 
     for(auto operand: op->Operands)
     {
-        FirstPassOperation(operand);
+        FirstPassOperation(vm, operand);
     }
 }
 
 /// iterates through the ast list [b]
-void FirstPassBlock(Block* b)
+void FirstPassBlock(PebbleVM* vm, Block* b)
 {
     for(auto exec: b->Executables)
     {
         switch(exec->ExecType)
         {
             case ExecutableType::Block:
-            FirstPassBlock(static_cast<Block*>(exec));
+            FirstPassBlock(vm, static_cast<Block*>(exec));
             break;
 
             case ExecutableType::Operation:
-            FirstPassOperation(static_cast<Operation*>(exec));
+            FirstPassOperation(vm, static_cast<Operation*>(exec));
             break;
         }
     }
@@ -1296,29 +1401,35 @@ void FirstPassBlock(Block* b)
 std::vector<void*> DeletedValueAddrs;
 
 /// resets the CallNames and ConstPrimtiives lists
-void InitEntityLists()
+void InitEntityLists(PebbleVM* vm)
 {
-    ConstPrimitives.clear();
-    ConstPrimitives.reserve(64);
+    ReleaseConstPrimitives(vm);
+    vm->ConstPrimitives.reserve(64);
 
-    CallNames.clear();
-    CallNames.reserve(64);
+    vm->CallNames.clear();
+    vm->CallNames.reserve(64);
 
     PrimitiveObjectsEncountered.clear();
     PrimitiveObjectsEncountered.reserve(64);
     
-    ByteCodeProgram.clear();
-    ByteCodeLineAssociation.clear();
-    ByteCodeLineAssociation.push_back(0);
+    vm->LocalSlots.clear();
+    SlotContexts.clear();
+    ParamScopeNames = nullptr;
+    DefinedParamScopeNames.clear();
+    DefinedParamScopeOwner = nullptr;
+
+    vm->ByteCodeProgram.clear();
+    vm->ByteCodeLineAssociation.clear();
+    vm->ByteCodeLineAssociation.push_back(0);
 
     DeletedValueAddrs.clear();
     DeletedValueAddrs.reserve(64);
 }
 
 /// iterates through the main block of [p]
-void FirstPassProgram(Program* p)
+void FirstPassProgram(PebbleVM* vm, Program* p)
 {
-    FirstPassBlock(p->Main);
+    FirstPassBlock(vm, p->Main);
 }
 
 void SafeDeleteObjectValue(Object* obj)
@@ -1343,7 +1454,7 @@ void SafeDeleteObjectValue(Object* obj)
 
 void InternalDeleteObject(Object* obj)
 {
-    ScopeDestructor(obj->Attributes);
+    ScopeDestructor(ObjectScopeSlab, obj->Attributes);
     if(IsCallable(obj))
     {
         MethodDestructor(obj->Action);
@@ -1354,11 +1465,12 @@ void InternalDeleteObject(Object* obj)
 }
 
 /// performs first pass and the flattens [p] to generate a BytecodeProgram
-void FlattenProgram(Program* p)
+void FlattenProgram(PebbleVM* vm, Program* p)
 {
-    InitEntityLists();
-    FirstPassProgram(p);
-    FlattenBlock(p->Main);
+    InitEntityLists(vm);
+    FirstPassProgram(vm, p);
+    FlattenBlock(vm, p->Main);
+    FuseInstructions(vm);
 
     for(auto obj: PrimitiveObjectsEncountered)
     {
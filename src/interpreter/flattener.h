@@ -12,16 +12,27 @@ struct JumpContext
 };
 
 
+/// the slots known while flattening the body of a method
+/// [SlotNames] are the name ids expected at each index of the scope of the method
+/// [NumberOfParamSlots] is the number of names created by the parameter list of
+///                      the method, which are always in its scope
+/// [Depth] is the number of anonymous scopes entered inside the method body
+struct SlotContext
+{
+    std::vector<extArg_t> SlotNames;
+    size_t NumberOfParamSlots;
+    int Depth;
+};
 
-extern int UniversalPrimitiveCount;
 
-void FlattenProgram(Program* p);
-void FlattenBlock(Block* block);
-void FlattenOperation(Operation* op);
+extern int UniversalPrimitiveCount;
 
-int NOPSafetyDomainSize();
+/// flattens [p] into the ByteCodeProgram and tables of [vm]
+void FlattenProgram(PebbleVM* vm, Program* p);
+void FlattenBlock(PebbleVM* vm, Block* block);
+void FlattenOperation(PebbleVM* vm, Operation* op);
 
-void FlattenOperationScopeResolution(Operation* op);
-void FlattenOperationRefDirect(Operation* op);
+void FlattenOperationScopeResolution(PebbleVM* vm, Operation* op);
+void FlattenOperationRefDirect(PebbleVM* vm, Operation* op);
 
 #endif
\ No newline at end of file
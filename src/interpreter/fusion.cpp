@@ -0,0 +1,185 @@
+#include <iostream>
+
+#include "fusion.h"
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "diagnostics.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Fusion state
+
+bool g_fusionStatsOn = false;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Fusion helpers
+
+/// true if [op] takes an instruction id as its argument
+inline bool TakesInstructionId(uint8_t op)
+{
+    return op == OP_Jump || op == OP_JumpFalse || op == OP_BindSection;
+}
+
+/// returns a list which is true at each instruction id of [vm] which must begin a new
+/// instruction after fusion. these are the targets of jumps and the instructions
+/// following each id in ByteCodeLineAssociation, as each of those ends a line
+inline std::vector<bool> FindBoundaries(PebbleVM* vm)
+{
+    std::vector<bool> boundaries(vm->ByteCodeProgram.size() + 1, false);
+    for(auto& ins: vm->ByteCodeProgram)
+    {
+        if(TakesInstructionId(ins.Op) && ins.Arg < boundaries.size())
+        {
+            boundaries[ins.Arg] = true;
+        }
+    }
+
+    for(auto id: vm->ByteCodeLineAssociation)
+    {
+        if(id + 1 < boundaries.size())
+        {
+            boundaries[id + 1] = true;
+        }
+    }
+
+    return boundaries;
+}
+
+/// true if the instructions starting at [at] are [ops] and can be fused
+inline bool MatchesSequence(PebbleVM* vm, extArg_t at, const std::vector<bool>& boundaries, const std::vector<uint8_t>& ops)
+{
+    if(at + ops.size() > vm->ByteCodeProgram.size())
+    {
+        return false;
+    }
+
+    for(size_t i=0; i<ops.size(); i++)
+    {
+        if(vm->ByteCodeProgram[at+i].Op != ops[i] || (i > 0 && boundaries[at+i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// sets [ins] to the superinstruction for the sequence starting at [at] and returns the
+/// length of the sequence, or returns 1 if there is no superinstruction for it
+inline extArg_t FuseSequenceAt(PebbleVM* vm, extArg_t at, const std::vector<bool>& boundaries, ByteCodeInstruction& ins)
+{
+    auto& program = vm->ByteCodeProgram;
+
+    if(MatchesSequence(vm, at, boundaries, { OP_Cmp, OP_LoadCmp, OP_JumpFalse })
+        && program[at+1].Arg < 8 && program[at+2].Arg <= MaxCmpJumpTarget)
+    {
+        ins = { OP_CmpJumpFalse, static_cast<uint32_t>(CmpJumpFalseArg(program[at+1].Arg, program[at+2].Arg)) };
+        return 3;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadCallName, OP_ResolveDirect }))
+    {
+        ins = { OP_ResolveName, program[at].Arg };
+        return 2;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadPrimitive, OP_Add }) && program[at].Arg < vm->ConstPrimitives.size())
+    {
+        ins = { OP_AddConst, program[at].Arg };
+        return 2;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadPrimitive, OP_Subtract }) && program[at].Arg < vm->ConstPrimitives.size())
+    {
+        ins = { OP_SubtractConst, program[at].Arg };
+        return 2;
+    }
+
+    ins = program[at];
+    return 1;
+}
+
+/// rewrites the instruction id held by [ins], if any, using [newIds]
+inline void RelocateInstruction(ByteCodeInstruction& ins, const std::vector<extArg_t>& newIds)
+{
+    if(TakesInstructionId(ins.Op) && ins.Arg < newIds.size())
+    {
+        ins.Arg = newIds[ins.Arg];
+    }
+    else if(ins.Op == OP_CmpJumpFalse)
+    {
+        auto target = CmpJumpTargetOf(ins.Arg);
+        ins.Arg = CmpJumpFalseArg(CmpJumpComparisonOf(ins.Arg), newIds[target]);
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Fusion pass
+
+/// replaces common sequences in the ByteCodeProgram of [vm] with superinstructions,
+/// and updates all jump targets and its ByteCodeLineAssociation to match
+void FuseInstructions(PebbleVM* vm)
+{
+    vm->FusionStats = {};
+
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+    auto boundaries = FindBoundaries(vm);
+
+    std::vector<ByteCodeInstruction> fusedProgram;
+    fusedProgram.reserve(programEnd);
+
+    /// the id of each instruction in the fused program; instructions which were 
+    /// fused share the id of their superinstruction
+    std::vector<extArg_t> newIds(programEnd + 1);
+
+    for(extArg_t i=0; i<programEnd;)
+    {
+        ByteCodeInstruction ins;
+        extArg_t length = FuseSequenceAt(vm, i, boundaries, ins);
+        if(length > 1)
+        {
+            vm->FusionStats.FusedSequences++;
+            vm->FusionStats.RemovedInstructions += length - 1;
+        }
+
+        for(extArg_t j=0; j<length; j++)
+        {
+            newIds[i+j] = fusedProgram.size();
+        }
+        fusedProgram.push_back(ins);
+        i += length;
+    }
+    newIds[programEnd] = fusedProgram.size();
+
+    for(auto& ins: fusedProgram)
+    {
+        RelocateInstruction(ins, newIds);
+    }
+
+    for(auto& id: vm->ByteCodeLineAssociation)
+    {
+        if(id <= programEnd)
+        {
+            id = newIds[id];
+        }
+    }
+
+    vm->ByteCodeProgram.swap(fusedProgram);
+}
+
+/// writes the FusionStats of [vm] to std::cerr
+void ReportFusionStatistics(const PebbleVM* vm)
+{
+    double executed = vm->FusionStats.ExecutedInstructions;
+    double fusedPercent = executed > 0 ? 100.0 * vm->FusionStats.ExecutedSuperinstructions / executed : 0;
+
+    std::cerr << "fused sequences:            " << vm->FusionStats.FusedSequences << "\n"
+              << "instructions removed:       " << vm->FusionStats.RemovedInstructions << "\n"
+              << "instructions executed:      " << vm->FusionStats.ExecutedInstructions << "\n"
+              << "superinstructions executed: " << vm->FusionStats.ExecutedSuperinstructions 
+                << " (" << fusedPercent << "%)\n"
+              << "dispatches saved:           " << vm->FusionStats.ReplacedDispatches << "\n";
+}
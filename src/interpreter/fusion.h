@@ -0,0 +1,73 @@
+#ifndef __FUSION_H
+#define __FUSION_H
+
+#include "abstract.h"
+#include "bytecode.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Superinstructions
+//
+// after flattening, common sequences of instructions are replaced by a single 
+// superinstruction which does the work of the whole sequence:
+//
+//     BCI_LoadCallName n, BCI_ResolveDirect           =>  BCI_ResolveName n
+//     BCI_LoadPrimitive k, BCI_Add                    =>  BCI_AddConst k
+//     BCI_LoadPrimitive k, BCI_Subtract               =>  BCI_SubtractConst k
+//     BCI_Cmp, BCI_LoadCmp c, BCI_JumpFalse t         =>  BCI_CmpJumpFalse c,t
+//
+// a sequence is never fused if any instruction after its first is the target of a 
+// jump or begins a new line, so every jump still lands on an instruction boundary
+// and every error is still reported on the same line
+
+/// statistics about the superinstructions of a program
+/// [FusedSequences] is the number of sequences replaced by a superinstruction
+/// [RemovedInstructions] is the number of instructions removed from the program
+/// [ExecutedInstructions] is the number of instructions executed during the run
+/// [ExecutedSuperinstructions] is the number of executed instructions which were
+///                             superinstructions
+/// [ReplacedDispatches] is the number of instructions which would have been 
+///                      executed without fusion, but were not
+struct FusionStatistics
+{
+    size_t FusedSequences;
+    size_t RemovedInstructions;
+    size_t ExecutedInstructions;
+    size_t ExecutedSuperinstructions;
+    size_t ReplacedDispatches;
+};
+
+/// if true, executed instructions are counted and the FusionStats of a vm will be
+/// reported when its program finishes
+extern bool g_fusionStatsOn;
+
+/// true if [op] is the id of a superinstruction
+inline bool IsSuperinstruction(uint8_t op)
+{
+    return op >= OP_ResolveName && op <= OP_CmpJumpFalse;
+}
+
+/// number of instructions which the superinstruction [op] replaces
+inline size_t InstructionsReplacedBy(uint8_t op)
+{
+    return op == OP_CmpJumpFalse ? 3 : 2;
+}
+
+/// records the execution of [op] in [stats]
+inline void CountExecutedInstruction(FusionStatistics& stats, uint8_t op)
+{
+    stats.ExecutedInstructions++;
+    if(IsSuperinstruction(op))
+    {
+        stats.ExecutedSuperinstructions++;
+        stats.ReplacedDispatches += InstructionsReplacedBy(op) - 1;
+    }
+}
+
+/// replaces common sequences in the ByteCodeProgram of [vm] with superinstructions,
+/// and updates all jump targets and its ByteCodeLineAssociation to match
+void FuseInstructions(PebbleVM* vm);
+
+/// writes the FusionStats of [vm] to std::cerr
+void ReportFusionStatistics(const PebbleVM* vm);
+
+#endif
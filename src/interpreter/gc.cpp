@@ -0,0 +1,294 @@
+#include <iostream>
+#include <chrono>
+#include <unordered_set>
+
+#include "gc.h"
+
+#include "vm.h"
+#include "call.h"
+#include "scope.h"
+#include "value.h"
+#include "diagnostics.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Collector state
+
+size_t GCMinimumThreshold = 4096;
+
+bool g_gcStatsOn = false;
+
+/// runtime Calls and Scopes which may be freed, used to recognize the entities
+/// stored on the MemoryStack. these sets only hold state during a collection, so
+/// each thread which runs a vm has its own
+static thread_local std::unordered_set<const void*> ManagedCalls;
+static thread_local std::unordered_set<const void*> ManagedScopes;
+
+/// entities which are reachable from a root
+static thread_local std::unordered_set<const void*> Marked;
+
+/// String values which are bound to a reachable Call
+static thread_local std::unordered_set<const String*> LiveStrings;
+
+/// reachable entities which have yet to be traced
+static thread_local std::vector<Call*> CallWorklist;
+static thread_local std::vector<Scope*> ScopeWorklist;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Mark phase
+
+/// true if [entity] has been marked as reachable
+inline bool IsMarked(const void* entity)
+{
+    return Marked.count(entity) != 0;
+}
+
+/// marks [call] as reachable
+inline void MarkCall(Call* call)
+{
+    if(call != nullptr && Marked.insert(call).second)
+    {
+        CallWorklist.push_back(call);
+    }
+}
+
+/// marks [scope] as reachable
+inline void MarkScope(Scope* scope)
+{
+    if(scope != nullptr && Marked.insert(scope).second)
+    {
+        ScopeWorklist.push_back(scope);
+    }
+}
+
+/// marks all entities on the MemoryStack. as the stack is untyped, a word is only
+/// treated as a Call or Scope if it is a managed entity
+inline void MarkMemoryStack(PebbleVM* vm)
+{
+    for(auto word: vm->MemoryStack)
+    {
+        if(ManagedCalls.count(word) != 0)
+        {
+            MarkCall(static_cast<Call*>(word));
+        }
+        else if(ManagedScopes.count(word) != 0)
+        {
+            MarkScope(static_cast<Scope*>(word));
+        }
+    }
+}
+
+/// marks every root of [vm]
+inline void MarkRoots(PebbleVM* vm)
+{
+    MarkScope(vm->ProgramReg);
+    MarkScope(vm->LocalScopeReg);
+    MarkScope(&NothingScope);
+    MarkScope(&SomethingScope);
+
+    MarkCall(vm->SelfReg);
+    MarkCall(vm->CallerReg);
+    MarkCall(vm->LastResultReg);
+
+    for(size_t i=0; i<SIMPLE_CALLS && i<vm->RuntimeCalls.size(); i++)
+    {
+        MarkCall(vm->RuntimeCalls[i]);
+    }
+
+    for(auto call: vm->ConstPrimitives)
+    {
+        MarkCall(call);
+    }
+
+    for(auto& frame: vm->CallStack)
+    {
+        MarkCall(frame.LastResult);
+    }
+
+    for(auto& labeledScope: vm->LocalScopes)
+    {
+        MarkScope(labeledScope.Value);
+    }
+
+    MarkMemoryStack(vm);
+}
+
+/// marks everything reachable from the entities in the worklists
+inline void TraceWorklists()
+{
+    while(!CallWorklist.empty() || !ScopeWorklist.empty())
+    {
+        while(!CallWorklist.empty())
+        {
+            auto call = CallWorklist.back();
+            CallWorklist.pop_back();
+
+            if(call->BoundType == &StringType && call->BoundValue.s != nullptr)
+            {
+                LiveStrings.insert(call->BoundValue.s);
+            }
+            MarkScope(call->BoundScope);
+        }
+
+        while(!ScopeWorklist.empty())
+        {
+            auto scope = ScopeWorklist.back();
+            ScopeWorklist.pop_back();
+
+            for(auto call: scope->CallsIndex)
+            {
+                MarkCall(call);
+            }
+            for(auto call: scope->Elements)
+            {
+                MarkCall(call);
+            }
+            MarkScope(scope->InheritedScope);
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Sweep phase
+
+/// removes the entries of [table] which refer to unmarked calls
+template <typename T>
+inline void SweepPrimitiveTable(T& table)
+{
+    for(auto entry = table.begin(); entry != table.end();)
+    {
+        if(IsMarked(entry->second))
+        {
+            entry++;
+        }
+        else
+        {
+            entry = table.erase(entry);
+        }
+    }
+}
+
+/// removes unmarked calls from the primitive tables of [vm], which do not keep calls alive
+inline void SweepPrimitiveTables(PebbleVM* vm)
+{
+    SweepPrimitiveTable(vm->IntegerPrimitives);
+    SweepPrimitiveTable(vm->DecimalPrimitives);
+    SweepPrimitiveTable(vm->StringPrimitives);
+
+    for(auto& call: vm->BooleanPrimitives)
+    {
+        if(call != nullptr && !IsMarked(call))
+        {
+            call = nullptr;
+        }
+    }
+}
+
+/// frees the unmarked runtime calls and the String values which only they are bound to
+inline void SweepCalls(PebbleVM* vm)
+{
+    std::unordered_set<String*> freedStrings;
+
+    size_t kept = SIMPLE_CALLS;
+    for(size_t i=SIMPLE_CALLS; i<vm->RuntimeCalls.size(); i++)
+    {
+        auto call = vm->RuntimeCalls[i];
+        if(IsMarked(call))
+        {
+            vm->RuntimeCalls[kept++] = call;
+            continue;
+        }
+
+        auto value = call->BoundValue.s;
+        bool ownsValue = call->BoundType == &StringType && call->BoundScope != &NothingScope;
+        if(ownsValue && value != nullptr && LiveStrings.count(value) == 0 && freedStrings.insert(value).second)
+        {
+            vm->GCStats.BytesReclaimed += sizeof(String) + value->capacity();
+            vm->GCStats.StringsFreed++;
+            StringDestructor(value);
+        }
+
+        vm->GCStats.BytesReclaimed += sizeof(Call);
+        vm->GCStats.CallsFreed++;
+        CallDestructor(vm->CallSlab, call);
+    }
+
+    vm->RuntimeCalls.resize(kept);
+}
+
+/// frees the unmarked runtime scopes
+inline void SweepScopes(PebbleVM* vm)
+{
+    size_t kept = 0;
+    for(size_t i=0; i<vm->RuntimeScopes.size(); i++)
+    {
+        auto scope = vm->RuntimeScopes[i];
+        if(IsMarked(scope))
+        {
+            vm->RuntimeScopes[kept++] = scope;
+            continue;
+        }
+
+        vm->GCStats.BytesReclaimed += sizeof(Scope) + scope->CallsIndex.AllocatedBytes() 
+            + scope->Elements.capacity() * sizeof(Call*);
+        vm->GCStats.ScopesFreed++;
+        ScopeDestructor(vm->ScopeSlab, scope);
+    }
+
+    vm->RuntimeScopes.resize(kept);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Collection
+
+/// resets the GCStats and the GCThreshold of [vm]
+void InitGarbageCollector(PebbleVM* vm)
+{
+    vm->GCStats = {};
+    vm->GCThreshold = GCMinimumThreshold;
+}
+
+/// frees all runtime Calls and Scopes of [vm] which are not reachable from a root
+void CollectGarbage(PebbleVM* vm)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    ManagedCalls.clear();
+    ManagedCalls.insert(vm->RuntimeCalls.begin(), vm->RuntimeCalls.end());
+    ManagedScopes.clear();
+    ManagedScopes.insert(vm->RuntimeScopes.begin(), vm->RuntimeScopes.end());
+    Marked.clear();
+    Marked.reserve(vm->RuntimeCalls.size() + vm->RuntimeScopes.size());
+    LiveStrings.clear();
+
+    MarkRoots(vm);
+    TraceWorklists();
+
+    SweepPrimitiveTables(vm);
+    SweepCalls(vm);
+    SweepScopes(vm);
+
+    size_t live = vm->RuntimeCalls.size() + vm->RuntimeScopes.size();
+    vm->GCThreshold = std::max(GCMinimumThreshold, 2 * live);
+
+    std::chrono::duration<double, std::milli> pause = std::chrono::steady_clock::now() - start;
+    vm->GCStats.Collections++;
+    vm->GCStats.TotalPauseMs += pause.count();
+    vm->GCStats.MaxPauseMs = std::max(vm->GCStats.MaxPauseMs, pause.count());
+    vm->GCStats.MaxLive = std::max(vm->GCStats.MaxLive, live);
+}
+
+/// writes the GCStats of [vm] to std::cerr
+void ReportGarbageCollectorStatistics(const PebbleVM* vm)
+{
+    std::cerr << "gc collections:      " << vm->GCStats.Collections << "\n"
+              << "gc total pause (ms): " << vm->GCStats.TotalPauseMs << "\n"
+              << "gc max pause (ms):   " << vm->GCStats.MaxPauseMs << "\n"
+              << "gc calls freed:      " << vm->GCStats.CallsFreed << "\n"
+              << "gc scopes freed:     " << vm->GCStats.ScopesFreed << "\n"
+              << "gc strings freed:    " << vm->GCStats.StringsFreed << "\n"
+              << "gc bytes reclaimed:  " << vm->GCStats.BytesReclaimed << "\n"
+              << "gc max live:         " << vm->GCStats.MaxLive << "\n";
+}
@@ -0,0 +1,50 @@
+#ifndef __GC_H
+#define __GC_H
+
+#include "abstract.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Garbage collection
+//
+// a mark and sweep collector for the Calls and Scopes in the RuntimeCalls and 
+// RuntimeScopes of a vm. the roots are the registers, the MemoryStack, the CallStack,
+// the ProgramReg and the static primitives. the collector only runs between 
+// instructions (at BCI_EndLine), so no entity is held only by a native variable
+
+/// statistics about the collections done during a run
+/// [Collections] is the number of collections done
+/// [CallsFreed] is the number of Calls freed
+/// [ScopesFreed] is the number of Scopes freed
+/// [StringsFreed] is the number of String values freed
+/// [BytesReclaimed] is an estimate of the number of bytes freed
+/// [TotalPauseMs] is the total time spent collecting
+/// [MaxPauseMs] is the time spent in the longest collection
+/// [MaxLive] is the largest number of runtime Calls and Scopes kept by a collection
+struct GCStatistics
+{
+    size_t Collections;
+    size_t CallsFreed;
+    size_t ScopesFreed;
+    size_t StringsFreed;
+    size_t BytesReclaimed;
+    double TotalPauseMs;
+    double MaxPauseMs;
+    size_t MaxLive;
+};
+
+/// the smallest number of runtime Calls and Scopes which will trigger a collection
+extern size_t GCMinimumThreshold;
+
+/// if true, GCStats will be reported when the program finishes
+extern bool g_gcStatsOn;
+
+/// resets the GCStats and the GCThreshold of [vm]
+void InitGarbageCollector(PebbleVM* vm);
+
+/// frees all runtime Calls and Scopes of [vm] which are not reachable from a root
+void CollectGarbage(PebbleVM* vm);
+
+/// writes the GCStats of [vm] to std::cerr
+void ReportGarbageCollectorStatistics(const PebbleVM* vm);
+
+#endif
@@ -0,0 +1,443 @@
+#include <cstring>
+#include <memory>
+
+#include "jit.h"
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "gc.h"
+
+/// native code is generated for x86-64 using the System V calling convention, in
+/// memory mapped with mmap
+#if __x86_64__
+#if __unix__ || __APPLE__
+#define PEBBLE_JIT_X86_64
+#include <sys/mman.h>
+#endif
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+// JIT state
+
+bool g_jitOn = false;
+
+uint32_t JitThreshold = JitDefaultThreshold;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Instruction wrappers
+//
+// instructions which the vm follows with more work are called through these wrappers,
+// so the native code does the same work
+
+/// BCI_Eval, counting the entry to the section it jumps to
+void JitEval(PebbleVM* vm, extArg_t arg)
+{
+    BCI_Eval(vm, arg);
+    if(!vm->ErrorFlag && vm->JumpStatusReg)
+    {
+        CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+/// BCI_EvalHere, counting the entry to the section it jumps to
+void JitEvalHere(PebbleVM* vm, extArg_t arg)
+{
+    BCI_EvalHere(vm, arg);
+    if(!vm->ErrorFlag && vm->JumpStatusReg)
+    {
+        CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+/// BCI_TailEval, counting the entry to the section it jumps to if it replaced the call
+/// frame. otherwise it returned to the caller, which is not the start of a section. as
+/// in the vm, the garbage collector may run once the call frame is replaced
+void JitTailEval(PebbleVM* vm, extArg_t arg)
+{
+    bool reusesCallFrame = TailEvalReusesCallFrame(vm, arg);
+    BCI_TailEval(vm, arg);
+    if(!vm->ErrorFlag)
+    {
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        if(reusesCallFrame) CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+/// BCI_EndLine, after which the garbage collector may run as in the vm
+void JitEndLine(PebbleVM* vm, extArg_t arg)
+{
+    BCI_EndLine(vm, arg);
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Code generation helpers
+
+#ifdef PEBBLE_JIT_X86_64
+
+/// registers which hold the vm and the addresses of its state used by the native code
+/// rbx: &InstructionReg  r12: &ErrorFlag  r13: &JumpStatusReg  r14: vm
+
+/// a rel32 operand at [At] in the code which must point to the native code of the
+/// instruction [Target], or to the exit of the region if [Target] is ExitLabel
+struct NativeJump
+{
+    size_t At;
+    extArg_t Target;
+};
+
+/// label of the exit of a region
+constexpr extArg_t ExitLabel = ~extArg_t(0);
+
+/// the largest instruction id which may be stored as a sign extended imm32
+constexpr extArg_t MaxNativeInstructionId = 0x7fffffff;
+
+/// appends [bytes] to [code]
+inline void Emit(std::vector<uint8_t>& code, std::initializer_list<uint8_t> bytes)
+{
+    code.insert(code.end(), bytes);
+}
+
+/// appends [value] to [code] as a little endian value of [width] bytes
+inline void EmitValue(std::vector<uint8_t>& code, uint64_t value, int width)
+{
+    for(int i=0; i<width; i++)
+    {
+        code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/// appends a rel32 operand to [code] which is resolved to [target] later
+inline void EmitJumpTarget(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    jumps.push_back({ code.size(), target });
+    EmitValue(code, 0, 4);
+}
+
+/// jmp [target]
+inline void EmitJump(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    Emit(code, { 0xE9 });
+    EmitJumpTarget(code, jumps, target);
+}
+
+/// mov qword [rbx], [insId]
+inline void EmitSetInstructionReg(std::vector<uint8_t>& code, extArg_t insId)
+{
+    Emit(code, { 0x48, 0xC7, 0x03 });
+    EmitValue(code, insId, 4);
+}
+
+/// mov rdi, r14; mov esi, [arg]; mov rax, [method]; call rax
+inline void EmitCall(std::vector<uint8_t>& code, BCI_Method method, extArg_t arg)
+{
+    Emit(code, { 0x4C, 0x89, 0xF7 });
+    Emit(code, { 0xBE });
+    EmitValue(code, arg, 4);
+    Emit(code, { 0x48, 0xB8 });
+    EmitValue(code, reinterpret_cast<uint64_t>(method), 8);
+    Emit(code, { 0xFF, 0xD0 });
+}
+
+/// cmp byte [r12], 0; jne exit
+inline void EmitErrorCheck(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps)
+{
+    Emit(code, { 0x41, 0x80, 0x3C, 0x24, 0x00 });
+    Emit(code, { 0x0F, 0x85 });
+    EmitJumpTarget(code, jumps, ExitLabel);
+}
+
+/// if JumpStatusReg is set, clears it and jumps to [target]. otherwise continues
+/// with the next instruction
+inline void EmitJumpStatusCheck(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    /// cmp dword [r13], 0; je over the clear and jump
+    Emit(code, { 0x41, 0x83, 0x7D, 0x00, 0x00 });
+    Emit(code, { 0x74, 0x0D });
+
+    /// mov dword [r13], 0; jmp target
+    Emit(code, { 0x41, 0xC7, 0x45, 0x00 });
+    EmitValue(code, 0, 4);
+    EmitJump(code, jumps, target);
+}
+
+/// returns the BCI method called by the native code for [op]
+inline BCI_Method NativeMethodFor(uint8_t op)
+{
+    switch(op)
+    {
+        case OP_Eval:       return JitEval;
+        case OP_EvalHere:   return JitEvalHere;
+        case OP_TailEval:   return JitTailEval;
+        case OP_EndLine:    return JitEndLine;
+        default:            return BCI_Instructions[op];
+    }
+}
+
+/// returns the jump target of the conditional jump [ins]
+inline extArg_t ConditionalJumpTarget(const ByteCodeInstruction& ins)
+{
+    return ins.Op == OP_CmpJumpFalse ? CmpJumpTargetOf(ins.Arg) : ins.Arg;
+}
+
+/// appends the template of the instruction [insId] of [vm] in [region] to [code]
+inline void EmitInstruction(PebbleVM* vm, std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, NativeRegion& region, extArg_t insId)
+{
+    auto& ins = vm->ByteCodeProgram[insId];
+    auto isInRegion = [&region](extArg_t id) { return id >= region.Start && id <= region.End; };
+
+    switch(ins.Op)
+    {
+        case OP_NOP:
+            break;
+
+        case OP_Jump:
+            if(!isInRegion(ins.Arg))
+            {
+                EmitSetInstructionReg(code, ins.Arg);
+            }
+            EmitJump(code, jumps, isInRegion(ins.Arg) ? ins.Arg : ExitLabel);
+            break;
+
+        case OP_JumpFalse:
+        case OP_CmpJumpFalse:
+        {
+            auto target = ConditionalJumpTarget(ins);
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            EmitJumpStatusCheck(code, jumps, isInRegion(target) ? target : ExitLabel);
+            break;
+        }
+
+        case OP_Eval:
+        case OP_EvalHere:
+        case OP_TailEval:
+        case OP_Return:
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            EmitJumpStatusCheck(code, jumps, ExitLabel);
+            break;
+
+        default:
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            break;
+    }
+}
+
+/// generates the native code for [region] of [vm] into [code] and sets its Entries as
+/// offsets into [code]
+inline void GenerateRegion(PebbleVM* vm, std::vector<uint8_t>& code, NativeRegion& region)
+{
+    std::vector<NativeJump> jumps;
+    std::vector<size_t> offsets(region.End - region.Start + 1);
+
+    /// push rbx; push r12; push r13; push r14; sub rsp, 8 to align the stack for calls
+    Emit(code, { 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56 });
+    Emit(code, { 0x48, 0x83, 0xEC, 0x08 });
+
+    /// mov rbx, &InstructionReg; mov r12, &ErrorFlag; mov r13, &JumpStatusReg; mov r14, vm
+    Emit(code, { 0x48, 0xBB });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->InstructionReg), 8);
+    Emit(code, { 0x49, 0xBC });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->ErrorFlag), 8);
+    Emit(code, { 0x49, 0xBD });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->JumpStatusReg), 8);
+    Emit(code, { 0x49, 0xBE });
+    EmitValue(code, reinterpret_cast<uint64_t>(vm), 8);
+
+    /// mov rax, Entries; jmp [rax + rdi*8]
+    Emit(code, { 0x48, 0xB8 });
+    EmitValue(code, reinterpret_cast<uint64_t>(region.Entries.data()), 8);
+    Emit(code, { 0xFF, 0x24, 0xF8 });
+
+    for(extArg_t id = region.Start; id <= region.End; id++)
+    {
+        offsets[id - region.Start] = code.size();
+        EmitInstruction(vm, code, jumps, region, id);
+    }
+
+    /// falling off the end of the region continues after it
+    EmitSetInstructionReg(code, region.End + 1);
+
+    /// add rsp, 8; pop r14; pop r13; pop r12; pop rbx; ret
+    size_t exitOffset = code.size();
+    Emit(code, { 0x48, 0x83, 0xC4, 0x08 });
+    Emit(code, { 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+
+    for(auto& jump: jumps)
+    {
+        size_t to = jump.Target == ExitLabel ? exitOffset : offsets[jump.Target - region.Start];
+        auto rel = static_cast<int32_t>(static_cast<int64_t>(to) - static_cast<int64_t>(jump.At + 4));
+        std::memcpy(code.data() + jump.At, &rel, sizeof(rel));
+    }
+
+    for(size_t i=0; i<offsets.size(); i++)
+    {
+        region.Entries[i] = reinterpret_cast<void*>(offsets[i]);
+    }
+}
+
+/// copies [code] into new executable memory for [region]. returns false if the
+/// memory could not be mapped
+inline bool MapRegion(const std::vector<uint8_t>& code, NativeRegion& region)
+{
+    region.Size = code.size();
+    void* memory = mmap(nullptr, region.Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED)
+    {
+        return false;
+    }
+
+    std::memcpy(memory, code.data(), region.Size);
+    if(mprotect(memory, region.Size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, region.Size);
+        return false;
+    }
+
+    region.Memory = memory;
+    region.Code = reinterpret_cast<NativeCode>(memory);
+    for(auto& entry: region.Entries)
+    {
+        entry = static_cast<uint8_t*>(memory) + reinterpret_cast<size_t>(entry);
+    }
+    return true;
+}
+
+#endif
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Regions
+
+/// returns the last instruction of the section of [vm] starting at [section]. a
+/// section defined by a method is preceded by its BCI_BindSection and the BCI_Jump
+/// over it, otherwise the section ends at its first BCI_Return
+inline extArg_t SectionEnd(PebbleVM* vm, extArg_t section)
+{
+    if(section >= 2
+        && vm->ByteCodeProgram[section - 2].Op == OP_BindSection
+        && vm->ByteCodeProgram[section - 2].Arg == section
+        && vm->ByteCodeProgram[section - 1].Op == OP_Jump
+        && vm->ByteCodeProgram[section - 1].Arg > section)
+    {
+        return vm->ByteCodeProgram[section - 1].Arg - 1;
+    }
+
+    extArg_t id = section;
+    while(id + 1 < vm->ByteCodeProgram.size() && vm->ByteCodeProgram[id].Op != OP_Return)
+    {
+        id++;
+    }
+    return id;
+}
+
+/// compiles the instructions of [vm] from [start] to [end] into native code and
+/// dispatches every instruction which is not yet compiled to it
+void CompileRegion(PebbleVM* vm, extArg_t start, extArg_t end)
+{
+#ifdef PEBBLE_JIT_X86_64
+    if(end >= vm->ByteCodeProgram.size() || end >= MaxNativeInstructionId || start > end)
+    {
+        return;
+    }
+
+    auto region = std::make_unique<NativeRegion>();
+    region->Start = start;
+    region->End = end;
+    region->Entries.resize(end - start + 1);
+
+    std::vector<uint8_t> code;
+    GenerateRegion(vm, code, *region);
+    if(!MapRegion(code, *region))
+    {
+        return;
+    }
+
+    for(extArg_t id = start; id <= end; id++)
+    {
+        if(vm->Jit.RegionAt[id] == nullptr)
+        {
+            vm->Jit.RegionAt[id] = region.get();
+            vm->DecodedProgram[id].Op = NativeOp;
+            vm->DecodedProgram[id].Target = vm->Jit.NativeTarget;
+        }
+    }
+
+    vm->Jit.Regions.push_back(std::move(region));
+#endif
+}
+
+/// true if the entry at [insId] of [vm] makes it hot
+inline bool CountEntry(PebbleVM* vm, extArg_t insId)
+{
+    if(insId >= vm->Jit.Counters.size() || vm->Jit.RegionAt[insId] != nullptr || vm->Jit.Counters[insId] >= JitThreshold)
+    {
+        return false;
+    }
+
+    return ++vm->Jit.Counters[insId] == JitThreshold;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// JIT
+
+bool JitIsSupported()
+{
+#ifdef PEBBLE_JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+void InitJit(PebbleVM* vm, void* nativeTarget)
+{
+    ReleaseNativeCode(vm);
+    vm->Jit.NativeTarget = nativeTarget;
+    vm->Jit.Counters.assign(vm->ByteCodeProgram.size(), 0);
+    vm->Jit.RegionAt.assign(vm->ByteCodeProgram.size(), nullptr);
+}
+
+void CountSectionEntry(PebbleVM* vm, extArg_t section)
+{
+    if(CountEntry(vm, section))
+    {
+        CompileRegion(vm, section, SectionEnd(vm, section));
+    }
+}
+
+void CountLoopEntry(PebbleVM* vm, extArg_t loopHeader, extArg_t backEdge)
+{
+    if(CountEntry(vm, loopHeader))
+    {
+        CompileRegion(vm, loopHeader, backEdge);
+    }
+}
+
+void RunNativeCode(PebbleVM* vm)
+{
+    auto region = vm->Jit.RegionAt[vm->InstructionReg];
+    region->Code(vm->InstructionReg - region->Start);
+}
+
+void ReleaseNativeCode(PebbleVM* vm)
+{
+#ifdef PEBBLE_JIT_X86_64
+    for(auto& region: vm->Jit.Regions)
+    {
+        munmap(region->Memory, region->Size);
+    }
+#endif
+    vm->Jit.Regions.clear();
+    vm->Jit.RegionAt.clear();
+    vm->Jit.Counters.clear();
+}
@@ -0,0 +1,100 @@
+#ifndef __JIT_H
+#define __JIT_H
+
+#include <memory>
+
+#include "abstract.h"
+#include "bytecode.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Template JIT
+//
+// with --jit, the vm counts how often each BoundSection is entered and how often
+// each loop header is reached by a backwards BCI_Jump. once a count reaches
+// JitThreshold, the instructions of the section or loop (a region) are translated
+// into x86-64 machine code by stitching together a template for each instruction:
+//
+//     BCI_Jump                                 a native jump
+//     BCI_NOP                                  nothing
+//     BCI_JumpFalse, BCI_CmpJumpFalse          calls the BCI method, then jumps
+//                                              natively if it jumped
+//     BCI_Eval, BCI_EvalHere, BCI_TailEval,    calls the BCI method, then leaves
+//     BCI_Return                               the region if it jumped
+//     every other instruction                  calls the BCI method
+//
+// native code checks ErrorFlag after each call and leaves the region (returns to
+// the vm) on an error, a jump outside of the region or a change of call frame.
+// every instruction of a compiled region is dispatched by the vm to the native
+// code, which enters the region at that instruction. native code is generated for
+// a single vm, whose address it holds. on other platforms --jit has
+// no effect and the program is interpreted
+
+/// id of the DecodedProgram instruction which runs the native code of a region
+constexpr uint8_t NativeOp = OP_NumberOfInstructions + 1;
+
+/// the default number of entries to a section or loop before it is compiled
+constexpr uint32_t JitDefaultThreshold = 64;
+
+/// the native code of a region, entered at the instruction Start + [entry]
+typedef void (*NativeCode)(extArg_t entry);
+
+/// the instructions from [Start] to [End] (inclusive) compiled into native code
+/// [Code] is the start of the native code
+/// [Entries] is the address in [Code] of each instruction of the region
+/// [Memory] is the executable mapping which holds [Code] and has [Size] bytes
+struct NativeRegion
+{
+    extArg_t Start;
+    extArg_t End;
+    NativeCode Code;
+    std::vector<void*> Entries;
+    void* Memory;
+    size_t Size;
+};
+
+/// the JIT state of a vm
+/// [Counters] is the number of entries to the section or loop starting at each
+///            instruction
+/// [RegionAt] is the region whose native code runs each instruction, or nullptr if
+///            the instruction is interpreted
+/// [Regions] holds all compiled regions
+/// [NativeTarget] is the address of the vm's handler for NativeOp when dispatch is
+///                threaded
+struct JitState
+{
+    std::vector<uint32_t> Counters;
+    std::vector<NativeRegion*> RegionAt;
+    std::vector<std::unique_ptr<NativeRegion>> Regions;
+    void* NativeTarget = nullptr;
+};
+
+/// if true, hot sections and loops are compiled to native code
+extern bool g_jitOn;
+
+/// number of entries to a section or loop before it is compiled
+extern uint32_t JitThreshold;
+
+/// true if native code can be generated and run on this platform
+bool JitIsSupported();
+
+/// resets the JIT for the DecodedProgram of [vm]. [nativeTarget] is the address of
+/// the vm's handler for NativeOp when dispatch is threaded
+void InitJit(PebbleVM* vm, void* nativeTarget);
+
+/// counts an entry to the section of [vm] starting at [section], compiling it if it
+/// is hot
+void CountSectionEntry(PebbleVM* vm, extArg_t section);
+
+/// counts a jump from [backEdge] to the earlier [loopHeader] of [vm], compiling the
+/// loop if it is hot
+void CountLoopEntry(PebbleVM* vm, extArg_t loopHeader, extArg_t backEdge);
+
+/// runs the native code of the region which holds the instruction at the
+/// InstructionReg of [vm]. returns with InstructionReg at the next instruction to
+/// interpret, or with ErrorFlag set as an instruction would
+void RunNativeCode(PebbleVM* vm);
+
+/// frees all native code of [vm]
+void ReleaseNativeCode(PebbleVM* vm);
+
+#endif
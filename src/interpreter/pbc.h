@@ -0,0 +1,87 @@
+#ifndef __PBC_H
+#define __PBC_H
+
+#include "abstract.h"
+#include "aot.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Precompiled bytecode
+//
+// with --cache, the compiled tables of program.pebl are written to program.pbc next
+// to it, and later runs of the unchanged program load them instead of compiling the
+// grammar, parsing and flattening. a .pbc file stores each table in the layout it
+// has in memory, so it is mapped and copied into the vm without any parsing:
+//
+//     PbcHeader
+//     ByteCodeInstruction[NumberOfInstructions]
+//     PbcString[NumberOfCallNames]
+//     PbcPrimitive[NumberOfPrimitives]
+//     LocalSlot[NumberOfSlots]
+//     extArg_t[NumberOfLineAssociations]
+//     int32_t[NumberOfLines]
+//     char[StringsSize]
+//
+// every table but the last two has entries whose size is a multiple of 8, so each
+// table is aligned. a .pbc file is only used if it was written for the same version
+// of the format and instruction set, from a source with the same hash
+
+/// first bytes of every .pbc file
+constexpr uint32_t PbcMagic = 0x43425050;
+
+/// version of the .pbc format, changed whenever the format or flattener changes
+constexpr uint32_t PbcVersion = 1;
+
+/// the start of a .pbc file
+/// [SourceHash] is the hash of the source the tables were compiled from
+/// [NumberOfInstructionIds] is BCI_NumberOfInstructions when the file was written
+/// [StringsSize] is the number of bytes holding the text of every string
+struct PbcHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t SourceHash;
+    uint64_t NumberOfInstructionIds;
+    uint64_t NumberOfInstructions;
+    uint64_t NumberOfCallNames;
+    uint64_t NumberOfPrimitives;
+    uint64_t NumberOfSlots;
+    uint64_t NumberOfLineAssociations;
+    uint64_t NumberOfLines;
+    uint64_t StringsSize;
+};
+
+/// a string stored as [Length] bytes at [Offset] in the strings of a .pbc file
+struct PbcString
+{
+    uint32_t Offset;
+    uint32_t Length;
+};
+
+/// a constant primitive stored in a .pbc file. [Type] is the index of its type in
+/// PbcTypes, and [Text] is the value of a string primitive
+struct PbcPrimitive
+{
+    double Decimal;
+    int32_t Integer;
+    uint32_t Type;
+    PbcString Text;
+    uint32_t Boolean;
+    uint32_t Padding;
+};
+
+/// if true, programs are loaded from and written to .pbc files
+extern bool g_cacheOn;
+
+/// returns the .pbc file of the source [sourceFile]
+String PrecompiledFileFor(const String& sourceFile);
+
+/// writes the tables which [vm] holds for the flattened program [p] compiled from
+/// [sourceFile] to [pbcFile]. returns false if the file could not be written
+bool WritePrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile, Program* p);
+
+/// loads the tables in [pbcFile] into [vm] if it holds the compiled [sourceFile].
+/// returns a Program to run with DoByteCodeProgram, which must be deleted by the
+/// caller, or nullptr if [sourceFile] must be compiled
+Program* LoadPrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile);
+
+#endif
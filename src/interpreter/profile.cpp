@@ -0,0 +1,132 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+#include "profile.h"
+
+#include "vm.h"
+#include "dis.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Profiler state
+
+bool g_profileOpsOn = false;
+
+/// the number of pairs of instructions listed by ReportInstructionProfile
+constexpr size_t ReportedPairs = 30;
+
+void StartInstructionProfile(PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    profile.Counts.assign(OP_NumberOfInstructions, 0);
+    profile.Nanoseconds.assign(OP_NumberOfInstructions, 0);
+    profile.PairCounts.assign(OP_NumberOfInstructions * OP_NumberOfInstructions, 0);
+    profile.PairNanoseconds.assign(OP_NumberOfInstructions * OP_NumberOfInstructions, 0);
+    profile.CurrentOp = NoProfiledOp;
+    profile.PreviousOp = NoProfiledOp;
+}
+
+void FinishInstructionProfile(PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    EndProfiledInstruction(profile, std::chrono::steady_clock::now());
+    profile.CurrentOp = NoProfiledOp;
+    profile.PreviousOp = NoProfiledOp;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Reporting
+
+/// returns the [part] of [whole] as a percentage
+double PercentOf(uint64_t part, uint64_t whole)
+{
+    return whole > 0 ? 100.0 * part / whole : 0;
+}
+
+/// writes one row of a histogram with [name], [count] and [nanoseconds] to std::cerr
+void ReportProfileRow(const String& name, uint64_t count, uint64_t totalCount,
+    uint64_t nanoseconds, uint64_t totalNanoseconds)
+{
+    char row[256];
+    std::snprintf(row, sizeof(row), "  %-40s %12llu %6.2f%% %12.6f %6.2f%% %10.1f\n", name.c_str(),
+        static_cast<unsigned long long>(count), PercentOf(count, totalCount), nanoseconds / 1e9,
+        PercentOf(nanoseconds, totalNanoseconds), count > 0 ? static_cast<double>(nanoseconds) / count : 0);
+    std::cerr << row;
+}
+
+/// writes the header of a histogram whose first column is [name] to std::cerr
+void ReportProfileHeader(const String& name)
+{
+    char header[256];
+    std::snprintf(header, sizeof(header), "  %-40s %12s %7s %12s %7s %10s\n", name.c_str(),
+        "count", "", "secs", "", "ns/op");
+    std::cerr << header;
+}
+
+void ReportInstructionProfile(const PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    if(profile.Counts.empty())
+    {
+        return;
+    }
+
+    uint64_t totalCount = 0;
+    uint64_t totalNanoseconds = 0;
+    std::vector<uint8_t> ops;
+    for(uint8_t op=0; op<OP_NumberOfInstructions; op++)
+    {
+        totalCount += profile.Counts[op];
+        totalNanoseconds += profile.Nanoseconds[op];
+        if(profile.Counts[op] > 0)
+        {
+            ops.push_back(op);
+        }
+    }
+
+    std::sort(ops.begin(), ops.end(), [&profile](uint8_t a, uint8_t b)
+    {
+        return profile.Nanoseconds[a] > profile.Nanoseconds[b];
+    });
+
+    std::cerr << "instructions executed: " << totalCount << " in " << totalNanoseconds / 1e9 << " secs\n\n";
+    ReportProfileHeader("instruction");
+    for(auto op: ops)
+    {
+        ReportProfileRow(InstructionName(op), profile.Counts[op], totalCount,
+            profile.Nanoseconds[op], totalNanoseconds);
+    }
+
+    uint64_t totalPairs = 0;
+    std::vector<size_t> pairs;
+    for(size_t pair=0; pair<profile.PairCounts.size(); pair++)
+    {
+        totalPairs += profile.PairCounts[pair];
+        if(profile.PairCounts[pair] > 0)
+        {
+            pairs.push_back(pair);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [&profile](size_t a, size_t b)
+    {
+        return profile.PairCounts[a] > profile.PairCounts[b];
+    });
+
+    std::cerr << "\n";
+    ReportProfileHeader("previous instruction -> instruction");
+    for(size_t i=0; i<pairs.size() && i<ReportedPairs; i++)
+    {
+        auto pair = pairs[i];
+        auto name = InstructionName(pair / OP_NumberOfInstructions) + " -> "
+            + InstructionName(pair % OP_NumberOfInstructions);
+        ReportProfileRow(name, profile.PairCounts[pair], totalPairs,
+            profile.PairNanoseconds[pair], totalNanoseconds);
+    }
+
+    if(pairs.size() > ReportedPairs)
+    {
+        std::cerr << "  (" << pairs.size() - ReportedPairs << " more pairs)\n";
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+#include <chrono>
+#include <vector>
+
+#include "abstract.h"
+#include "bytecode.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Instruction profiler
+//
+// with --profile-ops, the bytecode runtime counts and times every instruction it
+// executes, and every pair of an instruction and the instruction executed before it.
+// the profiler is called from the same trace handler as --fusion-stats, so when it is
+// off the dispatch of each instruction is unchanged
+//
+// the time of an instruction runs from its dispatch to the dispatch of the next
+// instruction, so it includes the cost of dispatching. native code is not traced, so
+// the JIT is not used while profiling
+
+/// the counts and times of the instructions executed during a run
+/// [Counts] is the number of executions of each instruction
+/// [Nanoseconds] is the time spent in each instruction
+/// [PairCounts] is the number of executions of each instruction after each other
+///              instruction, indexed by [previous * OP_NumberOfInstructions + op]
+/// [PairNanoseconds] is the time spent in each instruction after each other instruction
+/// [CurrentOp] is the instruction being executed, and [PreviousOp] the one before it
+/// [CurrentStart] is the time at which CurrentOp was dispatched
+struct InstructionProfile
+{
+    std::vector<uint64_t> Counts;
+    std::vector<uint64_t> Nanoseconds;
+    std::vector<uint64_t> PairCounts;
+    std::vector<uint64_t> PairNanoseconds;
+
+    uint8_t CurrentOp;
+    uint8_t PreviousOp;
+    std::chrono::steady_clock::time_point CurrentStart;
+};
+
+/// no instruction, used for CurrentOp and PreviousOp before the first instructions
+constexpr uint8_t NoProfiledOp = OP_NumberOfInstructions;
+
+/// if true, the instructions executed by a vm are profiled and the profile is reported
+/// when its program finishes
+extern bool g_profileOpsOn;
+
+/// clears the InstructionProfile of [vm] for a new run
+void StartInstructionProfile(PebbleVM* vm);
+
+/// adds the time since CurrentOp of [profile] was dispatched until [now] to CurrentOp
+inline void EndProfiledInstruction(InstructionProfile& profile, std::chrono::steady_clock::time_point now)
+{
+    if(profile.CurrentOp == NoProfiledOp)
+    {
+        return;
+    }
+
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - profile.CurrentStart).count();
+    profile.Nanoseconds[profile.CurrentOp] += elapsed;
+    if(profile.PreviousOp != NoProfiledOp)
+    {
+        profile.PairNanoseconds[profile.PreviousOp * OP_NumberOfInstructions + profile.CurrentOp] += elapsed;
+    }
+}
+
+/// records the dispatch of [op] in [profile]
+inline void ProfileInstruction(InstructionProfile& profile, uint8_t op)
+{
+    auto now = std::chrono::steady_clock::now();
+    EndProfiledInstruction(profile, now);
+
+    profile.Counts[op]++;
+    if(profile.CurrentOp != NoProfiledOp)
+    {
+        profile.PairCounts[profile.CurrentOp * OP_NumberOfInstructions + op]++;
+    }
+
+    profile.PreviousOp = profile.CurrentOp;
+    profile.CurrentOp = op;
+    profile.CurrentStart = now;
+}
+
+/// records the end of the last instruction executed by [vm]
+void FinishInstructionProfile(PebbleVM* vm);
+
+/// writes the InstructionProfile of [vm] to std::cerr, as a histogram of the instructions
+/// sorted by time and a histogram of the pairs of instructions sorted by count
+void ReportInstructionProfile(const PebbleVM* vm);
+
+#endif
@@ -1,6 +1,11 @@
+#include <unordered_set>
+
 #include "vm.h"
 
 #include "bytecode.h"
+#include "gc.h"
+#include "fusion.h"
+#include "jit.h"
 #include "errormsg.h"
 #include "dis.h"
 #include "flattener.h"
@@ -16,64 +21,6 @@
 #include "value.h"
 
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Scope Registers
-
-/// stores the program global scope
-Scope* ProgramReg = nullptr;
-
-/// stores the caller object
-Call* CallerReg = nullptr;
-
-/// stores the self object;
-Call* SelfReg = nullptr;
-
-/// stores the local (possibly anonymous) scope
-/// in general this is equivalent to the scope of SelfReg, when in the base level of the program
-/// this will be the same as ProgramReg
-Scope* LocalScopeReg = nullptr;
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// Special Registers
-
-/// stores the extended argument needed when an argument does not fit inside a single byte
-extArg_t ExtendedArg;
-
-/// stores the current number of bytes (exponent) which the ExtendedArg contains
-int ExtensionExp;
-
-/// stores the index of the current instruction
-extArg_t InstructionReg;
-
-/// 1 if jump occured, 0 otherwise
-int JumpStatusReg;
-
-/// stores the result of perfoming a BCI_Cmp operation
-/// bit at position [i] indicates:
-/// 0: hardcoded false
-/// 1: hardcoded true
-/// 2: ==
-/// 3: <
-/// 4: >
-/// 5: <=
-/// 6: >=
-/// 7: true Nothing, overrides all else
-uint8_t CmpReg = CmpRegDefaultValue;
-
-/// stores the result of the last line of code and is updated by the BCI_Endline 
-/// instruction
-Call* LastResultReg = nullptr;
-
-bool LocalScopeIsDetachedReg = 0;
-
-// ---------------------------------------------------------------------------------------------------------------------
-// Call Stack
-
-/// stores objects, references, string pointers, etc. which are used by instructions
-std::vector<void*> MemoryStack;
-
-
 // ---------------------------------------------------------------------------------------------------------------------
 // Entity Arrays
 
@@ -88,32 +35,88 @@ String* SimpleCallNames[] = {
     &AnythingType,
 };
 
-/// list of all reference names appearing in a program
-std::vector<String> CallNames;
 
-/// list of all constant primitives appearing in a program
-std::vector<Call*> ConstPrimitives;
+// ---------------------------------------------------------------------------------------------------------------------
+// Primitive tables
 
-/// list of all calls created during runtime
-std::vector<Call*> RuntimeCalls;
+/// returns [call] if it still holds [value], otherwise nullptr
+template <typename T>
+inline Call* IfStillMatches(Call* call, T value)
+{
+    if(call != nullptr && ValueMatchesPrimitiveCall(value, call))
+    {
+        return call;
+    }
+    return nullptr;
+}
 
-/// list of all scopes created during runtime
-std::vector<Scope*> RuntimeScopes;
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, int value)
+{
+    auto entry = vm->IntegerPrimitives.find(value);
+    return entry == vm->IntegerPrimitives.end() ? nullptr : IfStillMatches(entry->second, value);
+}
 
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, double value)
+{
+    auto entry = vm->DecimalPrimitives.find(value);
+    return entry == vm->DecimalPrimitives.end() ? nullptr : IfStillMatches(entry->second, value);
+}
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Call Stack
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, bool value)
+{
+    return IfStillMatches(vm->BooleanPrimitives[value], value);
+}
 
-/// the call stack, stores information about different function calls and 
-/// how to return after a given function returns
-std::vector<CallFrame> CallStack;
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, const String& value)
+{
+    auto entry = vm->StringPrimitives.find(value);
+    return entry == vm->StringPrimitives.end() ? nullptr : IfStillMatches<const String&>(entry->second, value);
+}
 
+/// add the primitive [call] to the table of [vm] for its type. if a call already
+/// exists for its value, that call is kept
+void AddPrimitiveCall(PebbleVM* vm, Call* call)
+{
+    if(call->BoundScope == &NothingScope)
+    {
+        return;
+    }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Bytecode program
+    if(call->BoundType == &IntegerType)
+    {
+        auto& entry = vm->IntegerPrimitives[call->BoundValue.i];
+        if(IfStillMatches(entry, (int)call->BoundValue.i) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &DecimalType)
+    {
+        auto& entry = vm->DecimalPrimitives[call->BoundValue.d];
+        if(IfStillMatches(entry, call->BoundValue.d) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &BooleanType)
+    {
+        auto& entry = vm->BooleanPrimitives[call->BoundValue.b];
+        if(IfStillMatches(entry, call->BoundValue.b) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &StringType && call->BoundValue.s != nullptr)
+    {
+        auto& entry = vm->StringPrimitives[*call->BoundValue.s];
+        if(IfStillMatches<const String&>(entry, *call->BoundValue.s) == nullptr) entry = call;
+    }
+}
 
-/// a list of instructions to be executed sequentially
-std::vector<ByteCodeInstruction> ByteCodeProgram;
+/// empties all primitive tables of [vm]
+void ClearPrimitiveTables(PebbleVM* vm)
+{
+    vm->IntegerPrimitives.clear();
+    vm->DecimalPrimitives.clear();
+    vm->StringPrimitives.clear();
+    vm->BooleanPrimitives[0] = nullptr;
+    vm->BooleanPrimitives[1] = nullptr;
+}
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -195,128 +198,173 @@ Call BooleanCall
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Array methods
-/// TODO: fix arrays
 
 const String SizeCallName = "Size";
+const String ArrayElementCallName = "?";
 
-std::vector<String> ArrayIndexCalls;
-
-String* CallNamePointerFor(int i)
+/// sets the SizeCallNamePointer of [vm] for the names in its CallNames
+void ResolveSizeCallName(PebbleVM* vm)
 {
-    return &ArrayIndexCalls[i];
-}
-
-void IfNeededAddArrayIndexCalls(size_t n)
-{
-    if(n > ArrayIndexCalls.size())
+    vm->SizeCallNamePointer = &SizeCallName;
+    for(auto& name: vm->CallNames)
     {
-        for(size_t i=ArrayIndexCalls.size(); i<n; i++)
+        if(name == SizeCallName)
         {
-            ArrayIndexCalls.push_back("?");
+            vm->SizeCallNamePointer = &name;
+            return;
         }
     }
 }
 
-void AddSimpleCallsToProgramScope()
+void AddSimpleCallsToProgramScope(PebbleVM* vm)
 {
-    AddCallToScope(&ObjectCall, ProgramReg);
-    AddCallToScope(&NothingCall, ProgramReg);
-    AddCallToScope(&ArrayCall, ProgramReg);
-    AddCallToScope(&IntegerCall, ProgramReg);
-    AddCallToScope(&DecimalCall, ProgramReg);
-    AddCallToScope(&StringCall, ProgramReg);
-    AddCallToScope(&BooleanCall, ProgramReg);
-    AddCallToScope(&AnythingCall, ProgramReg);
+    AddCallToScope(&ObjectCall, vm->ProgramReg);
+    AddCallToScope(&NothingCall, vm->ProgramReg);
+    AddCallToScope(&ArrayCall, vm->ProgramReg);
+    AddCallToScope(&IntegerCall, vm->ProgramReg);
+    AddCallToScope(&DecimalCall, vm->ProgramReg);
+    AddCallToScope(&StringCall, vm->ProgramReg);
+    AddCallToScope(&BooleanCall, vm->ProgramReg);
+    AddCallToScope(&AnythingCall, vm->ProgramReg);
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Program execution helpers
 
-/// initializes all registers and pushes the program CallFrame onto the CallStack
-void InitRuntime()
+/// initializes all registers of [vm] and pushes the program CallFrame onto its
+/// CallStack
+void InitRuntime(PebbleVM* vm)
 {
-    std::vector<LabeledScope> localScopeStack;
-    extArg_t programEnd = ByteCodeProgram.size();
+    extArg_t programEnd = vm->ByteCodeProgram.size();
 
-    RuntimeCalls.clear();
-    RuntimeCalls.reserve(256);
+    vm->RuntimeCalls.clear();
+    vm->RuntimeCalls.reserve(256);
 
-    RuntimeCalls = { &ObjectCall, &NothingCall, &ArrayCall, &IntegerCall,
+    vm->RuntimeCalls = { &ObjectCall, &NothingCall, &ArrayCall, &IntegerCall,
         &DecimalCall, &StringCall, &BooleanCall, &AnythingCall };
 
-    RuntimeScopes.clear();
-    RuntimeScopes.reserve(256);
+    vm->RuntimeScopes.clear();
+    vm->RuntimeScopes.reserve(256);
+
+    vm->CallStack.clear();
+    vm->CallStack.reserve(CallStackReservedFrames);
 
-    CallStack.clear();
-    CallStack.reserve(256);
+    vm->LocalScopes.clear();
+    vm->LocalScopes.reserve(CallStackReservedFrames);
     
     /// TODO: update arg 3 (caller ID);
-    CallStack.push_back( {programEnd, 0, 0, localScopeStack });
+    vm->CallStack.push_back( {programEnd, 0, 0, 0, nullptr });
+    vm->MaxCallStackSize = vm->CallStack.size();
 
-    CallerReg = &NothingCall;
-    SelfReg = &NothingCall;
+    vm->CallerReg = &NothingCall;
+    vm->SelfReg = &NothingCall;
 
-    MemoryStack.clear();
-    MemoryStack.reserve(256);
+    vm->MemoryStack.clear();
+    vm->MemoryStack.reserve(256);
 
-    MemoryStack.push_back(CallerReg);
-    MemoryStack.push_back(SelfReg);
+    vm->MemoryStack.push_back(vm->CallerReg);
+    vm->MemoryStack.push_back(vm->SelfReg);
 
-    ProgramReg = ScopeConstructor(nullptr);
-    LocalScopeReg = ProgramReg;
-    AddSimpleCallsToProgramScope();
+    ResolveSizeCallName(vm);
 
-    FatalErrorOccured = false;
-    ErrorFlag = false;
+    ClearPrimitiveTables(vm);
+    for(auto call: vm->ConstPrimitives)
+    {
+        AddPrimitiveCall(vm, call);
+    }
+
+    vm->ProgramReg = ScopeConstructor(vm->ScopeSlab, nullptr);
+    vm->LocalScopeReg = vm->ProgramReg;
+    AddSimpleCallsToProgramScope(vm);
+
+    InitGarbageCollector(vm);
 
-    InstructionReg = 0;
+    vm->FusionStats.ExecutedInstructions = 0;
+    vm->FusionStats.ExecutedSuperinstructions = 0;
+    vm->FusionStats.ReplacedDispatches = 0;
 
-    JumpStatusReg = 0;
-    LocalScopeIsDetachedReg = false;
-    LastResultReg = nullptr;
-    CmpReg = CmpRegDefaultValue;
+    vm->FatalErrorOccured = false;
+    vm->ErrorFlag = false;
 
-    ExtendedArg = 0;
-    ExtensionExp = 0; 
+    vm->InstructionReg = 0;
+
+    vm->JumpStatusReg = 0;
+    vm->LocalScopeIsDetachedReg = false;
+    vm->LastResultReg = nullptr;
+    vm->CmpReg = CmpRegDefaultValue;
 }
 
-/// true if [ins] is not an Extend instruction and the exponent of the ExtendedArg
-/// stored at ExtensionExp is not 0;
-inline bool ShouldUseExtendedArg(const ByteCodeInstruction& ins)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Construction
+
+PebbleVM* PebbleVMConstructor()
 {
-    return ins.Op != IndexOfInstruction(BCI_Extend) && ExtensionExp;
+    return new PebbleVM();
 }
 
-/// true if [ins] is a NOP
-inline bool IsNOP(const ByteCodeInstruction& ins)
+void PebbleVMDestructor(PebbleVM* vm)
 {
-    return ins.Op == IndexOfInstruction(BCI_NOP);
+    ReleaseNativeCode(vm);
+    ReleaseConstPrimitives(vm);
+    delete vm;
 }
 
+
 // ---------------------------------------------------------------------------------------------------------------------
-// Program post-execution cleanup
+// Program decoding
 
-/// list containing the memory addresses of Call values which have already
-/// been destroyed
-std::vector<String*> DestroyedValues;
+/// the id of the halt instruction which ends the DecodedProgram
+constexpr uint8_t HaltOp = OP_NumberOfInstructions;
 
-/// true if [value] has already been destroyed and appears in DestroyedValues
-/// otherwise will return false and add [value] to the list
-bool HasBeenDestroyed(String* value)
+/// decodes the ByteCodeProgram of [vm] into its DecodedProgram. as each instruction
+/// holds its full argument, decoding only widens the argument and appends the halt
+/// instruction
+void DecodeByteCodeProgram(PebbleVM* vm)
 {
-    if(value == nullptr)
-        return true;
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+    vm->DecodedProgram.clear();
+    vm->DecodedProgram.reserve(programEnd + 1);
 
-    for(auto val: DestroyedValues)
+    for(auto& ins: vm->ByteCodeProgram)
     {
-        if(val == value)
-        {
-            return true;
-        }
+        vm->DecodedProgram.push_back({ nullptr, ins.Arg, ins.Op });
+    }
+
+    vm->DecodedProgram.push_back({ nullptr, programEnd, HaltOp });
+}
+
+/// counts the instruction of [vm] at InstructionReg if g_fusionStatsOn, profiles it if
+/// g_profileOpsOn, and logs it if [shouldLog]
+void TraceCurrentInstruction(PebbleVM* vm, bool shouldLog)
+{
+    if(g_fusionStatsOn)
+    {
+        CountExecutedInstruction(vm->FusionStats, vm->DecodedProgram[vm->InstructionReg].Op);
+    }
+
+    if(g_profileOpsOn)
+    {
+        ProfileInstruction(vm->OpProfile, vm->DecodedProgram[vm->InstructionReg].Op);
+    }
+
+    if(shouldLog)
+    {
+        LogItDebug(Msg("%i: %s", (int)vm->InstructionReg, ToString(vm, vm->ByteCodeProgram[vm->InstructionReg])));
     }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Program post-execution cleanup
 
-    DestroyedValues.push_back(value);
-    return false;
+/// true if [value] has already been destroyed and appears in [destroyedValues]
+/// otherwise will return false and add [value] to the set
+bool HasBeenDestroyed(String* value, std::unordered_set<String*>& destroyedValues)
+{
+    if(value == nullptr)
+        return true;
+
+    return !destroyedValues.insert(value).second;
 }
 
 /// true if [call] has a BoundValue that should be destroyed
@@ -325,105 +373,359 @@ bool ShouldDestroyValue(const Call* call)
     return call->BoundType == &StringType && call->BoundScope != &NothingScope;
 }
 
-/// wrapper to delete a [call] and meet all dependencies
-void DeleteCall(Call* call)
+/// frees the value owned by [call], if any. the call itself is freed in bulk
+void DeleteCallValue(Call* call, std::unordered_set<String*>& destroyedValues)
 {
-    if(ShouldDestroyValue(call) && !HasBeenDestroyed(call->BoundValue.s))
+    if(ShouldDestroyValue(call) && !HasBeenDestroyed(call->BoundValue.s, destroyedValues))
     {
         StringDestructor(call->BoundValue.s);
     }
-    CallDestructor(call);
 }
 
-/// free all allocated memory and stop program execution
-void GracefullyExit()
+/// free all memory allocated by [vm] while running its program and stop program
+/// execution. the ConstPrimitives are kept, so the program may be run again
+void GracefullyExit(PebbleVM* vm)
 {
-    size_t size = RuntimeCalls.size() + ConstPrimitives.size();
-    DestroyedValues.clear();
-    DestroyedValues.reserve(size);
-    
-    for(size_t i=SIMPLE_CALLS; i<RuntimeCalls.size(); i++)
+    ClearPrimitiveTables(vm);
+
+    /// the memory addresses of Call values which have already been destroyed. runtime
+    /// calls may share the values of the ConstPrimitives, which are kept
+    std::unordered_set<String*> destroyedValues;
+    destroyedValues.reserve(vm->RuntimeCalls.size() + vm->ConstPrimitives.size());
+    for(auto call: vm->ConstPrimitives)
     {
-        DeleteCall(RuntimeCalls[i]);
+        if(ShouldDestroyValue(call))
+        {
+            destroyedValues.insert(call->BoundValue.s);
+        }
     }
 
-    for(auto scope: RuntimeScopes)
+    for(size_t i=SIMPLE_CALLS; i<vm->RuntimeCalls.size(); i++)
     {
-        ScopeDestructor(scope);
+        DeleteCallValue(vm->RuntimeCalls[i], destroyedValues);
     }
+    vm->RuntimeCalls.resize(SIMPLE_CALLS);
 
-    for(auto call: ConstPrimitives)
+    for(auto scope: vm->RuntimeScopes)
     {
-        DeleteCall(call);
+        ReleaseScopeStorage(scope);
     }
-    ScopeDestructor(ProgramReg);
+    vm->RuntimeScopes.clear();
+
+    ReleaseScopeStorage(vm->ProgramReg);
+    vm->ProgramReg = nullptr;
+    ReleaseNativeCode(vm);
+
+    /// every call and scope of the run is a runtime call or scope, or the ProgramReg
+    ReleaseAllCalls(vm->CallSlab);
+    ReleaseAllScopes(vm->ScopeSlab);
+}
+
+void ReleaseConstPrimitives(PebbleVM* vm)
+{
+    std::unordered_set<String*> destroyedValues;
+    for(auto call: vm->ConstPrimitives)
+    {
+        DeleteCallValue(call, destroyedValues);
+    }
+
+    vm->ConstPrimitives.clear();
+    ReleaseAllCalls(vm->PrimitiveSlab);
 }
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Program Execution
 
-/// iterates and executes the instructions stored in BytecodeProgram
-int DoByteCodeProgram(Program* p)
+/// dispatch is threaded (computed goto) on compilers which support it, otherwise each 
+/// instruction is dispatched through a switch
+#ifdef __GNUC__
+#define PEBBLE_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#ifdef PEBBLE_THREADED_DISPATCH
+/// jumps to the handler of the instruction at InstructionReg
+#define DISPATCH goto *vm->DecodedProgram[vm->InstructionReg].Target
+#else
+#define DISPATCH goto dispatch
+#endif
+
+/// the argument of the instruction at InstructionReg
+#define CURRENT_ARG vm->DecodedProgram[vm->InstructionReg].Arg
+
+/// iterates and executes the instructions stored in the BytecodeProgram of [vm]
+/// 
+/// each instruction is handled in one of four ways:
+/// SIMPLE_OP   cannot report an error or jump, so it only advances InstructionReg
+/// CHECKED_OP  may report an error, so ErrorFlag is checked before advancing
+/// JUMPING_OP  may report an error or jump, and only advances if it did not jump
+/// EVAL_OP     is a JUMPING_OP whose jump enters a section, which is counted by the JIT
+/// op_Jump, op_EndLine, op_TailEval and op_Native do more than these, so they are
+/// written out by hand.
+/// errors are displayed in a single place outside of the normal instruction path
+int DoByteCodeProgram(PebbleVM* vm, Program* p)
 {
-    InitRuntime();
+    InitRuntime(vm);
+    DecodeByteCodeProgram(vm);
 
-    while(InstructionReg < ByteCodeProgram.size())
+    bool shouldLogInstructions = LogAtLevel == LogSeverityType::Sev0_Debug;
+    bool shouldTraceInstructions = shouldLogInstructions || g_fusionStatsOn || g_profileOpsOn;
+    if(g_profileOpsOn)
     {
-        auto ins = ByteCodeProgram[InstructionReg];
-        LogItDebug(Msg("%i: %s", (int)InstructionReg, ToString(ins)));
+        StartInstructionProfile(vm);
+    }
 
-        if(IsNOP(ins))
-        {
-            InstructionReg++;
-            continue;
-        }
+    /// native code does not trace instructions, so the JIT is only used without tracing
+    bool useJit = g_jitOn && JitIsSupported() && !shouldTraceInstructions;
+
+    /// true if the BCI_TailEval being executed enters a section counted by the JIT
+    bool tailEvalEntersSection = false;
+
+    #define SIMPLE_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            vm->InstructionReg++; \
+            DISPATCH;
+
+    #define CHECKED_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            vm->InstructionReg++; \
+            DISPATCH;
+
+    #define JUMPING_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++; \
+            DISPATCH;
+
+    #define EVAL_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; if(useJit) CountSectionEntry(vm, vm->InstructionReg); } else vm->InstructionReg++; \
+            DISPATCH;
+
+#ifdef PEBBLE_THREADED_DISPATCH
+    static void* handlers[] = {
+        &&op_LoadCallName, &&op_LoadPrimitive, &&op_Assign, &&op_Add, &&op_Subtract,
+        &&op_Multiply, &&op_Divide, &&op_SysCall, &&op_And, &&op_Or,
+        &&op_Not, &&op_NotEquals, &&op_Equals, &&op_Cmp, &&op_LoadCmp,
+        &&op_JumpFalse, &&op_Jump, &&op_Copy, &&op_BindType, &&op_ResolveDirect,
+        &&op_ResolveScoped, &&op_BindScope, &&op_BindSection, &&op_EvalHere, &&op_Eval,
+        &&op_Return, &&op_Array, &&op_EnterLocal, &&op_LeaveLocal, &&op_NOP,
+        &&op_Dup, &&op_EndLine, &&op_DropTOS, &&op_Is, &&op_LoadLocal,
+        &&op_StoreLocal, &&op_ResolveName, &&op_AddConst, &&op_SubtractConst, &&op_CmpJumpFalse,
+        &&op_TailEval,
+        &&halt, &&op_Native,
+    };
+
+    for(auto& ins: vm->DecodedProgram)
+    {
+        ins.Target = (shouldTraceInstructions && ins.Op != HaltOp) ? &&trace : handlers[ins.Op];
+    }
+
+    if(useJit)
+    {
+        InitJit(vm, &&op_Native);
+    }
+    DISPATCH;
 
-        if(ShouldUseExtendedArg(ins))
+    trace:
+        TraceCurrentInstruction(vm, shouldLogInstructions);
+        goto *handlers[vm->DecodedProgram[vm->InstructionReg].Op];
+#else
+    if(useJit)
+    {
+        InitJit(vm, nullptr);
+    }
+
+    dispatch:
+        if(shouldTraceInstructions && vm->DecodedProgram[vm->InstructionReg].Op != HaltOp)
         {
-            BCI_Instructions[ins.Op](ExtendedArg ^ ins.Arg);
-            ExtendedArg = 0;
-            ExtensionExp = 0;
+            TraceCurrentInstruction(vm, shouldLogInstructions);
         }
-        else
+
+        switch(vm->DecodedProgram[vm->InstructionReg].Op)
         {
-            BCI_Instructions[ins.Op](ins.Arg);
+            case OP_LoadCallName:   goto op_LoadCallName;
+            case OP_LoadPrimitive:  goto op_LoadPrimitive;
+            case OP_Assign:         goto op_Assign;
+            case OP_Add:            goto op_Add;
+            case OP_Subtract:       goto op_Subtract;
+            case OP_Multiply:       goto op_Multiply;
+            case OP_Divide:         goto op_Divide;
+            case OP_SysCall:        goto op_SysCall;
+            case OP_And:            goto op_And;
+            case OP_Or:             goto op_Or;
+            case OP_Not:            goto op_Not;
+            case OP_NotEquals:      goto op_NotEquals;
+            case OP_Equals:         goto op_Equals;
+            case OP_Cmp:            goto op_Cmp;
+            case OP_LoadCmp:        goto op_LoadCmp;
+            case OP_JumpFalse:      goto op_JumpFalse;
+            case OP_Jump:           goto op_Jump;
+            case OP_Copy:           goto op_Copy;
+            case OP_BindType:       goto op_BindType;
+            case OP_ResolveDirect:  goto op_ResolveDirect;
+            case OP_ResolveScoped:  goto op_ResolveScoped;
+            case OP_BindScope:      goto op_BindScope;
+            case OP_BindSection:    goto op_BindSection;
+            case OP_EvalHere:       goto op_EvalHere;
+            case OP_Eval:           goto op_Eval;
+            case OP_Return:         goto op_Return;
+            case OP_Array:          goto op_Array;
+            case OP_EnterLocal:     goto op_EnterLocal;
+            case OP_LeaveLocal:     goto op_LeaveLocal;
+            case OP_NOP:            goto op_NOP;
+            case OP_Dup:            goto op_Dup;
+            case OP_EndLine:        goto op_EndLine;
+            case OP_DropTOS:        goto op_DropTOS;
+            case OP_Is:             goto op_Is;
+            case OP_LoadLocal:      goto op_LoadLocal;
+            case OP_StoreLocal:     goto op_StoreLocal;
+            case OP_ResolveName:    goto op_ResolveName;
+            case OP_AddConst:       goto op_AddConst;
+            case OP_SubtractConst:  goto op_SubtractConst;
+            case OP_CmpJumpFalse:   goto op_CmpJumpFalse;
+            case OP_TailEval:       goto op_TailEval;
+            case HaltOp:            goto halt;
+            case NativeOp:          goto op_Native;
+            default:                goto halt;
         }
-
-        IfNeededDisplayError(p);
-        if(FatalErrorOccured)
+#endif
+
+    SIMPLE_OP(LoadCallName)
+    SIMPLE_OP(LoadPrimitive)
+    CHECKED_OP(Assign)
+    CHECKED_OP(Add)
+    CHECKED_OP(Subtract)
+
+    CHECKED_OP(Multiply)
+    CHECKED_OP(Divide)
+    SIMPLE_OP(SysCall)
+    CHECKED_OP(And)
+    CHECKED_OP(Or)
+
+    CHECKED_OP(Not)
+    SIMPLE_OP(NotEquals)
+    SIMPLE_OP(Equals)
+    CHECKED_OP(Cmp)
+    SIMPLE_OP(LoadCmp)
+
+    JUMPING_OP(JumpFalse)
+    SIMPLE_OP(Copy)
+    SIMPLE_OP(BindType)
+    SIMPLE_OP(ResolveDirect)
+
+    SIMPLE_OP(ResolveScoped)
+    SIMPLE_OP(BindScope)
+    SIMPLE_OP(BindSection)
+    EVAL_OP(EvalHere)
+    EVAL_OP(Eval)
+
+    JUMPING_OP(Return)
+    CHECKED_OP(Array)
+    SIMPLE_OP(EnterLocal)
+    SIMPLE_OP(LeaveLocal)
+    SIMPLE_OP(NOP)
+
+    SIMPLE_OP(Dup)
+    SIMPLE_OP(DropTOS)
+    CHECKED_OP(Is)
+
+    SIMPLE_OP(LoadLocal)
+    CHECKED_OP(StoreLocal)
+    SIMPLE_OP(ResolveName)
+    CHECKED_OP(AddConst)
+    CHECKED_OP(SubtractConst)
+    JUMPING_OP(CmpJumpFalse)
+
+    /// unconditional jumps only move InstructionReg. a jump backwards enters a loop
+    op_Jump:
+        if(useJit && CURRENT_ARG < vm->InstructionReg) CountLoopEntry(vm, CURRENT_ARG, vm->InstructionReg);
+        vm->InstructionReg = CURRENT_ARG;
+        DISPATCH;
+
+    /// the end of a line is the only point where the garbage collector may run, as
+    /// every live entity is then held by a register or the stacks
+    op_EndLine:
+        BCI_EndLine(vm, CURRENT_ARG);
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        vm->InstructionReg++;
+        DISPATCH;
+
+    /// a method called in tail position never reaches the end of the line, but once
+    /// it replaces the current call frame every live entity is held by a register or
+    /// the stacks, so the garbage collector may also run here. only a replaced call
+    /// frame enters a section, otherwise the result was returned to the caller
+    op_TailEval:
+        tailEvalEntersSection = useJit && TailEvalReusesCallFrame(vm, CURRENT_ARG);
+        BCI_TailEval(vm, CURRENT_ARG);
+        if(vm->ErrorFlag) goto error;
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        if(tailEvalEntersSection) CountSectionEntry(vm, vm->InstructionReg);
+        if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++;
+        DISPATCH;
+
+    /// the native code of a compiled region leaves InstructionReg at the next
+    /// instruction to interpret
+    op_Native:
+        RunNativeCode(vm);
+        if(vm->ErrorFlag) goto error;
+        DISPATCH;
+
+    error:
+        IfNeededDisplayError(vm, p);
+        if(vm->FatalErrorOccured)
         {
-            GracefullyExit();
+            if(g_profileOpsOn) FinishInstructionProfile(vm);
+            GracefullyExit(vm);
             return 1;
         }
 
-        if(!JumpStatusReg)
+        if(vm->JumpStatusReg)
         {
-            InstructionReg++;
+            vm->JumpStatusReg = 0;
         }
         else
         {
-            JumpStatusReg = 0;
+            vm->InstructionReg++;
         }
-    }
-    
-    if(LogAtLevel == LogSeverityType::Sev0_Debug)
-    {
-        std::cout << "\nmem#" << MemoryStack.size() << "\n";
-    }
-    GracefullyExit();
-    return 0;
+        DISPATCH;
+
+    halt:
+        if(g_profileOpsOn) FinishInstructionProfile(vm);
+        if(LogAtLevel == LogSeverityType::Sev0_Debug)
+        {
+            std::cout << "\nmem#" << vm->MemoryStack.size() << "\n";
+        }
+        GracefullyExit(vm);
+        return 0;
+
+    #undef SIMPLE_OP
+    #undef CHECKED_OP
+    #undef JUMPING_OP
+    #undef EVAL_OP
 }
 
+#ifdef PEBBLE_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Recording created entities
 
-void AddRuntimeCall(Call* call)
+void AddRuntimeCall(PebbleVM* vm, Call* call)
 {
-    RuntimeCalls.push_back(call);
+    vm->RuntimeCalls.push_back(call);
 }
 
-void AddRuntimeScope(Scope* scope)
+void AddRuntimeScope(PebbleVM* vm, Scope* scope)
 {
-    RuntimeScopes.push_back(scope);
+    vm->RuntimeScopes.push_back(scope);
 }
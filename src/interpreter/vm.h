@@ -1,88 +1,40 @@
 #ifndef __VM_H
 #define __VM_H
 
-#include "abstract.h"
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// Scope Registers
-
-/// stores the program global scope
-extern Scope* ProgramReg;
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 
-/// stores the caller scope
-extern Call* CallerReg;
-
-/// stores the topmost callframe scope
-extern Call* SelfReg;
-
-/// stores the local (possibly anonymous) scope
-/// in general this is equivalent to SelfReg
-extern Scope* LocalScopeReg;
+#include "abstract.h"
+#include "utils.h"
+#include "gc.h"
+#include "fusion.h"
+#include "profile.h"
+#include "jit.h"
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Special Registers
 
-/// stores the extended argument if necessary
-extern extArg_t ExtendedArg;
-
-/// stores the exponent on the highest order byte of ExtendedArg
-extern int ExtensionExp;
-
-/// stores the current instruction number
-extern extArg_t InstructionReg;
-
-/// 1 if jump occured, 0 otherwise
-extern int JumpStatusReg;
-
-/// stores the result of perfoming a BCI_Cmp operation
-/// bit at position [i] indicates:
-/// 0: hardcoded false
-/// 1: hardcoded true
-/// 2: ==
-/// 3: <
-/// 4: >
-/// 5: <=
-/// 6: >=
-/// 7: true if Nothing, overrides all others
-extern uint8_t CmpReg;
-
 /// default value for the CmpReg to maintain the priors
 constexpr uint8_t CmpRegDefaultValue = 0x3;
 
-/// stores a pointer the call returned by the last line of code
-extern Call* LastResultReg;
-
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// Call Stack
-
-/// a stack which represents the working memory of the vm
-extern std::vector<void*> MemoryStack;
-
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Entity Arrays
 
 extern String* SimpleCallNames[];
 
-/// stores the names of all calls defined in a program
-extern std::vector<String> CallNames;
-
-/// stores the calls for all primitives defined in a program, including the 
-/// built in primitives (String/Integer/Decimal/Boolean/Nothing/Object/Array)
-extern std::vector<Call*> ConstPrimitives;
-
-/// stores the calls which are created during runtime
-extern std::vector<Call*> RuntimeCalls;
-
-/// stores the scopes which are created during runtime
-extern std::vector<Scope*> RuntimeScopes;
-
+/// a call which the flattener expects at a fixed index (slot) of the scope of the
+/// method being executed
+/// [Slot] is the expected index of the call in SelfReg's scope
+/// [NameId] is the id of the call's name, as used by BCI_LoadCallName
+struct LocalSlot
+{
+    extArg_t Slot;
+    extArg_t NameId;
+};
 
-extern bool LocalScopeIsDetachedReg;
 struct LabeledScope
 {
     Scope* Value;
@@ -99,47 +51,261 @@ struct LabeledScope
 /// [ReturnToInstructionId] will be the intruction id returned to
 /// [MemoryStackStart] stores the starting index on the memory stack for all
 ///                    memory used by the method
-/// [Owner] refers to the method 
-/// [LocalScopeStack] is a stack of Scopes used to handle local scope changes
+/// [Owner] refers to the method
+/// [LocalScopesStart] stores the index in LocalScopes where the stack of Scopes
+///                    used to handle local scope changes in the method starts
 /// [LastResult] stores the value of LastResultReg before the method is called
 struct CallFrame
 {
     extArg_t ReturnToInstructionId;
     extArg_t MemoryStackStart;
     extArg_t Owner;
-    std::vector<LabeledScope> LocalScopeStack;
+    extArg_t LocalScopesStart;
     Call* LastResult;
 };
 
-/// the call stack used by the vm
-extern std::vector<CallFrame> CallStack;
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// Anonymous scope stack
-// used for scopes that don't have owners (if/while/indent-block) which don't affect
-// self or caller
-inline std::vector<LabeledScope>& LocalScopeStack()
-{
-    return CallStack.back().LocalScopeStack;
-}
+/// number of CallFrames the CallStack holds before it needs to grow
+constexpr size_t CallStackReservedFrames = 1024;
 
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Bytecode program
 
+/// the largest argument a ByteCodeInstruction can hold
+constexpr extArg_t MaxInstructionArg = UINT32_MAX;
+
 /// stores the information for executing a bytecode instruction
 /// [Op] is the id of the instruction in BCI_Instructions
 /// [Arg] is the argument provided to the instruction
 struct ByteCodeInstruction
 {
     uint8_t Op;
-    uint8_t Arg;
+    uint32_t Arg;
 };
 
-/// a list of ByteCodeInstructions which represents a executable program
-extern std::vector<ByteCodeInstruction> ByteCodeProgram;
+/// a ByteCodeInstruction after decoding, as it is executed by the vm
+/// [Target] is the address of the handler for [Op] when dispatch is threaded
+/// [Arg] is the argument of the instruction, widened for the BCI methods
+/// [Op] is the id of the instruction in BCI_Instructions
+struct DecodedInstruction
+{
+    void* Target;
+    extArg_t Arg;
+    uint8_t Op;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Arrays
+
+/// name of the call which holds the size of an array
+extern const String SizeCallName;
+
+/// name given to every element call of an array
+extern const String ArrayElementCallName;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Interpreter context
+//
+// a PebbleVM holds everything needed to run one ByteCodeProgram: its registers,
+// stacks, tables and the entities created while it runs. every BCI method, the
+// flattener and the collector work on the PebbleVM they are given, so separate vms
+// may run at the same time on different threads. a vm is only used by one thread at
+// a time, and the Scopes it creates while running come from the slab of that thread
+//
+// the static primitives below are shared by every vm and are never changed while a
+// program runs
+
+struct PebbleVM
+{
+    // -----------------------------------------------------------------------------------------------------------------
+    // Scope Registers
+
+    /// stores the program global scope
+    Scope* ProgramReg = nullptr;
+
+    /// stores the caller scope
+    Call* CallerReg = nullptr;
+
+    /// stores the topmost callframe scope
+    Call* SelfReg = nullptr;
+
+    /// stores the local (possibly anonymous) scope
+    /// in general this is equivalent to SelfReg
+    Scope* LocalScopeReg = nullptr;
+
+    /// true if LocalScopeReg is a detached scope, in which only its own calls resolve
+    bool LocalScopeIsDetachedReg = false;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Special Registers
+
+    /// stores the current instruction number
+    extArg_t InstructionReg = 0;
+
+    /// 1 if jump occured, 0 otherwise
+    int JumpStatusReg = 0;
+
+    /// stores the result of perfoming a BCI_Cmp operation
+    /// bit at position [i] indicates:
+    /// 0: hardcoded false
+    /// 1: hardcoded true
+    /// 2: ==
+    /// 3: <
+    /// 4: >
+    /// 5: <=
+    /// 6: >=
+    /// 7: true if Nothing, overrides all others
+    uint8_t CmpReg = CmpRegDefaultValue;
+
+    /// stores a pointer the call returned by the last line of code
+    Call* LastResultReg = nullptr;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Stacks
+
+    /// a stack which represents the working memory of the vm
+    std::vector<void*> MemoryStack;
+
+    /// the call stack used by the vm
+    std::vector<CallFrame> CallStack;
+
+    /// the largest number of CallFrames on the CallStack during the current run
+    size_t MaxCallStackSize = 0;
+
+    /// the local scopes of all CallFrames on the CallStack. used for scopes that don't
+    /// have owners (if/while/indent-block) which don't affect self or caller. the local
+    /// scopes of every CallFrame are kept one after the other, so those of the current
+    /// CallFrame are at its end
+    std::vector<LabeledScope> LocalScopes;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Bytecode program
+
+    /// a list of ByteCodeInstructions which represents a executable program
+    std::vector<ByteCodeInstruction> ByteCodeProgram;
+
+    /// ByteCodeProgram decoded at the start of execution, followed by a final halt
+    /// instruction
+    std::vector<DecodedInstruction> DecodedProgram;
+
+    /// stores the running total number of byte code instructions obtained from
+    /// all lines less that the value of the index
+    std::vector<extArg_t> ByteCodeLineAssociation;
+
+    /// stores the names of all calls defined in a program
+    std::vector<String> CallNames;
+
+    /// stores the calls for all primitives defined in a program, including the
+    /// built in primitives (String/Integer/Decimal/Boolean/Nothing/Object/Array)
+    std::vector<Call*> ConstPrimitives;
+
+    /// stores the slots used by BCI_LoadLocal and BCI_StoreLocal
+    std::vector<LocalSlot> LocalSlots;
+
+    /// name pointer used for the size call of an array. this is the entry of CallNames
+    /// for SizeCallName when the program refers to it, so that .Size resolves
+    const String* SizeCallNamePointer = &SizeCallName;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Runtime entities
+
+    /// stores the calls which are created during runtime. they are all freed when the
+    /// program ends
+    utils::Slab<Call> CallSlab;
+
+    /// stores the ConstPrimitives, which are kept until the program is replaced or the
+    /// vm is freed, so the program may be run again
+    utils::Slab<Call> PrimitiveSlab;
+
+    /// stores the ProgramReg and the scopes which are created during runtime
+    utils::Slab<Scope> ScopeSlab;
+
+    /// stores the calls which are created during runtime
+    std::vector<Call*> RuntimeCalls;
+
+    /// stores the scopes which are created during runtime
+    std::vector<Scope*> RuntimeScopes;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Primitive tables
+    //
+    // a given primitive value should only have one constructed call. these tables map
+    // each primitive value to that call, and are filled with the ConstPrimitives when
+    // the runtime starts and with each primitive call constructed during runtime
+
+    /// maps Integer values to their call
+    std::unordered_map<std::int64_t, Call*> IntegerPrimitives;
+
+    /// maps Decimal values to their call
+    std::unordered_map<double, Call*> DecimalPrimitives;
+
+    /// maps String values to their call
+    std::unordered_map<String, Call*> StringPrimitives;
+
+    /// the calls for false and true (at index 0 and 1)
+    Call* BooleanPrimitives[2] = { nullptr, nullptr };
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Errors
+
+    /// true if the last instruction reported an error
+    bool ErrorFlag = false;
+
+    /// the id in ErrorClasses of the last error
+    int ErrorCode = 0;
+
+    /// the message of the last error
+    String ErrorMsg;
+
+    /// the type of the last error
+    SystemMessageType ErrorType = SystemMessageType::Exception;
+
+    /// true if an error which ends the program was reported
+    bool FatalErrorOccured = false;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Output
+
+    /// the text printed by the program and its runtime errors are appended to [Output],
+    /// and the runtime errors alone to [Messages]. they point to the [OutputBuffer] and
+    /// [MessagesBuffer] of the vm, unless they are pointed to other strings
+    String OutputBuffer;
+    String MessagesBuffer;
+    String* Output = &OutputBuffer;
+    String* Messages = &MessagesBuffer;
+
+    /// returns the line of input read by ask. if empty, ask reads a line of std::cin
+    std::function<String()> Ask;
+
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Statistics and JIT
+
+    /// statistics of the collections done during the current run
+    GCStatistics GCStats = {};
+
+    /// the number of runtime Calls and Scopes which will trigger the next collection
+    size_t GCThreshold = 0;
+
+    /// statistics of the superinstructions of the program
+    FusionStatistics FusionStats = {};
+
+    /// the counts and times of the instructions executed with --profile-ops
+    InstructionProfile OpProfile;
+
+    /// the counters and native code of the JIT
+    JitState Jit;
+};
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -167,28 +333,83 @@ extern Call StringCall;
 extern Call BooleanCall;
 extern Call AnythingCall;
 
-/// the scope of NothingCall which is also assigned to new Calls and calls 
+/// the scope of NothingCall which is also assigned to new Calls and calls
 /// which have yet to be bound to a scope
 extern Scope NothingScope;
 
 /// the scope used for Primitives which have values
 extern Scope SomethingScope;
 
-/// TODO: fix arrays
-extern const String SizeCallName;
-String* CallNamePointerFor(int i);
-void IfNeededAddArrayIndexCalls(size_t n);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Primitive tables
+
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, int value);
+
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, double value);
+
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, bool value);
+
+/// returns the call of [vm] for [value] or nullptr if there is none
+Call* FindPrimitiveCall(PebbleVM* vm, const String& value);
+
+/// add the primitive [call] to the table of [vm] for its type. if a call already
+/// exists for its value, that call is kept
+void AddPrimitiveCall(PebbleVM* vm, Call* call);
+
+/// empties all primitive tables of [vm]
+void ClearPrimitiveTables(PebbleVM* vm);
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Helper methods
+
+/// number of local scopes entered in the current CallFrame of [vm]
+inline size_t LocalScopeDepth(const PebbleVM* vm)
+{
+    return vm->LocalScopes.size() - vm->CallStack.back().LocalScopesStart;
+}
+
+/// true if enough entities have been created by [vm] since the last collection
+inline bool ShouldCollectGarbage(const PebbleVM* vm)
+{
+    return vm->RuntimeCalls.size() + vm->RuntimeScopes.size() >= vm->GCThreshold;
+}
+
+/// sets the SizeCallNamePointer of [vm] for the names in its CallNames
+void ResolveSizeCallName(PebbleVM* vm);
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Public interface methods
 
-/// executes the bytecodeprogram representation of [p]
-int DoByteCodeProgram(Program* p);
+/// returns a new vm without a program, which prints to its own OutputBuffer and must
+/// be freed with PebbleVMDestructor
+PebbleVM* PebbleVMConstructor();
+
+/// frees [vm], its program and any native code it holds
+void PebbleVMDestructor(PebbleVM* vm);
+
+/// executes the bytecodeprogram of [vm] which was flattened from [p]
+int DoByteCodeProgram(PebbleVM* vm, Program* p);
+
+/// resets the registers, stacks and primitive tables of [vm] for its ByteCodeProgram
+void InitRuntime(PebbleVM* vm);
+
+/// free all memory allocated by [vm] while running its program and stop program
+/// execution. the program itself is kept, so it may be run again
+void GracefullyExit(PebbleVM* vm);
+
+/// frees the ConstPrimitives of [vm]
+void ReleaseConstPrimitives(PebbleVM* vm);
 
-/// add a [call] to the list of runtime calls
-void AddRuntimeCall(Call* call);
+/// add a [call] to the list of runtime calls of [vm]
+void AddRuntimeCall(PebbleVM* vm, Call* call);
 
-/// add a [scope] to the list of runtime scopes
-void AddRuntimeScope(Scope* scope);
+/// add a [scope] to the list of runtime scopes of [vm]
+void AddRuntimeScope(PebbleVM* vm, Scope* scope);
 
 #endif
@@ -0,0 +1,13 @@
+#include "main.h"
+#include "program.h"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Library settings
+//
+// libpebble.a is linked without main.cpp, so it holds the settings main.cpp defines
+// for the pebble executable. a program embedding pebble receives the output of its
+// programs from RunPebbleProgram, so nothing is printed
+
+bool g_outputOn = false;
+bool g_useBytecodeRuntime = true;
+LogSeverityType LogAtLevel = LogSeverityType::Sev3_Critical;
@@ -12,6 +12,12 @@
 #include "parse.h"
 #include "commandargs.h"
 #include "vm.h"
+#include "gc.h"
+#include "fusion.h"
+#include "profile.h"
+#include "jit.h"
+#include "aot.h"
+#include "pbc.h"
 #include "flattener.h"
 #include "scope.h"
 #include "dis.h"
@@ -38,7 +44,7 @@ bool Usage(std::vector<SettingOption> options)
 {
     // If this was derived at build time, that would be fantastic
     // TODO - generate from Settings table and use null flags as non-flag [] args
-    std::cerr << "Usage pebble: [--help] [--log sev0|sev1|sev2|sev3] [program.pebl]" << std::endl;
+    std::cerr << "Usage pebble: [--help] [--log sev0|sev1|sev2|sev3] [--gc-stats] [--fusion-stats] [--profile-ops] [--jit] [--jit-threshold n] [--emit-cpp out.cpp] [--cache] [--grammar grammar.txt] [--emit-grammar out.h] [--parse-threads n] [program.pebl]" << std::endl;
 
     exit(2);
 }
@@ -87,6 +93,84 @@ bool ChangeRuntime(std::vector<SettingOption> options)
     return true;
 }
 
+bool ShowGarbageCollectorStatistics(std::vector<SettingOption> options)
+{
+    g_gcStatsOn = true;
+    return false;
+}
+
+bool ShowFusionStatistics(std::vector<SettingOption> options)
+{
+    g_fusionStatsOn = true;
+    return false;
+}
+
+bool ProfileInstructions(std::vector<SettingOption> options)
+{
+    g_profileOpsOn = true;
+    return false;
+}
+
+bool UseJit(std::vector<SettingOption> options)
+{
+    g_jitOn = true;
+    return false;
+}
+
+bool ChangeJitThreshold(std::vector<SettingOption> options)
+{
+    if(options.size() < 1)
+        return true;
+
+    int threshold = std::atoi(options[0].c_str());
+    JitThreshold = threshold < 1 ? 1 : threshold;
+    return true;
+}
+
+bool ChangeEmitCppFile(std::vector<SettingOption> options)
+{
+    if(options.size() < 1)
+        return true;
+
+    g_emitCppFile = options[0];
+    return true;
+}
+
+bool UseCache(std::vector<SettingOption> options)
+{
+    g_cacheOn = true;
+    return false;
+}
+
+bool ChangeGrammarFile(std::vector<SettingOption> options)
+{
+    if(options.size() < 1)
+        return true;
+
+    g_grammarFile = options[0];
+    return true;
+}
+
+bool ChangeParseThreads(std::vector<SettingOption> options)
+{
+    if(options.size() < 1)
+        return true;
+
+    int threads = std::atoi(options[0].c_str());
+    g_parseThreads = threads < 0 ? 0 : threads;
+    return true;
+}
+
+String g_emitGrammarFile = "";
+bool ChangeEmitGrammarFile(std::vector<SettingOption> options)
+{
+    if(options.size() < 1)
+        return true;
+
+    g_emitGrammarFile = options[0];
+    return true;
+}
+
 ProgramConfiguration Config
 {
     {
@@ -107,6 +191,36 @@ ProgramConfiguration Config
     {
         "Runtime version", "--runtime", ChangeRuntime
     },
+    {
+        "GC statistics", "--gc-stats", ShowGarbageCollectorStatistics
+    },
+    {
+        "Fusion statistics", "--fusion-stats", ShowFusionStatistics
+    },
+    {
+        "Profile instructions", "--profile-ops", ProfileInstructions
+    },
+    {
+        "JIT", "--jit", UseJit
+    },
+    {
+        "JIT threshold", "--jit-threshold", ChangeJitThreshold
+    },
+    {
+        "Emit C++", "--emit-cpp", ChangeEmitCppFile
+    },
+    {
+        "Precompiled bytecode cache", "--cache", UseCache
+    },
+    {
+        "Grammar file", "--grammar", ChangeGrammarFile
+    },
+    {
+        "Emit grammar tables", "--emit-grammar", ChangeEmitGrammarFile
+    },
+    {
+        "Parse threads", "--parse-threads", ChangeParseThreads
+    },
 
 #ifdef DEMO
     {
@@ -122,6 +236,24 @@ bool g_outputOn = true;
 // Runtime
 bool g_useBytecodeRuntime = true;
 
+/// runs the flattened or precompiled program [p] in [vm] with the bytecode runtime
+void RunByteCodeProgram(PebbleVM* vm, Program* p)
+{
+    DoByteCodeProgram(vm, p);
+    if(g_gcStatsOn)
+    {
+        ReportGarbageCollectorStatistics(vm);
+    }
+    if(g_fusionStatsOn)
+    {
+        ReportFusionStatistics(vm);
+    }
+    if(g_profileOpsOn)
+    {
+        ReportInstructionProfile(vm);
+    }
+}
+
 int main(int argc, char* argv[])
 {
     ParseCommandArgs(argc, argv, &Config);
@@ -137,7 +269,38 @@ int main(int argc, char* argv[])
     bool ShouldPrintInitialCompileResult = true; 
 
     PurgeLog();                         // cleans log between each run
-    CompileGrammar();                   // compile grammar from grammar.txt
+
+    // write the grammar tables compiled into pebble instead of running a program
+    if(!g_emitGrammarFile.empty())
+    {
+        CompileGrammar();
+        bool emitted = EmitGrammarTables(g_emitGrammarFile);
+        if(!emitted)
+        {
+            std::cerr << "cannot write " << g_emitGrammarFile << std::endl;
+        }
+        return emitted ? 0 : 1;
+    }
+
+    // the vm which runs the program with the bytecode runtime
+    PebbleVM* vm = PebbleVMConstructor();
+
+    // run the precompiled program if it is up to date with the source
+    auto pbcFile = PrecompiledFileFor(Config.at(0).Flag);
+    if(g_cacheOn && g_useBytecodeRuntime && g_emitCppFile.empty())
+    {
+        auto precompiled = LoadPrecompiledProgram(vm, pbcFile, Config.at(0).Flag);
+        if(precompiled != nullptr)
+        {
+            LogIt(LogSeverityType::Sev1_Notify, "main", "precompiled program loaded");
+            RunByteCodeProgram(vm, precompiled);
+            delete precompiled;
+            PebbleVMDestructor(vm);
+            return 0;
+        }
+    }
+
+    CompileGrammar();                   // compile grammar from the grammar tables
 
 
     // compile program
@@ -147,6 +310,7 @@ int main(int argc, char* argv[])
     if(FatalCompileError || prog == nullptr)
     {
         LogIt(LogSeverityType::Sev2_Important, "main", "compile fails");
+        PebbleVMDestructor(vm);
         return 1;
     }
 
@@ -158,17 +322,37 @@ int main(int argc, char* argv[])
         LogDiagnostics(PROGRAM->Main, "initial parse structure", "main");
     }
 
+    // compile program ahead of time instead of running it
+    if(!g_emitCppFile.empty())
+    {
+        FlattenProgram(vm, PROGRAM);
+        bool emitted = EmitCpp(vm, g_emitCppFile, PROGRAM);
+        if(!emitted)
+        {
+            std::cerr << "cannot write " << g_emitCppFile << std::endl;
+        }
+
+        ProgramDestructor(PROGRAM);
+        PebbleVMDestructor(vm);
+        return emitted ? 0 : 1;
+    }
+
     if(g_useBytecodeRuntime)
     {
-        FlattenProgram(PROGRAM);
-        LogProgramInstructions();
+        FlattenProgram(vm, PROGRAM);
+        LogProgramInstructions(vm);
+
+        if(g_cacheOn)
+        {
+            WritePrecompiledProgram(vm, pbcFile, Config.at(0).Flag, PROGRAM);
+        }
     }
 
     // run program
     LogIt(LogSeverityType::Sev1_Notify, "main", "execution begins");
     if(g_useBytecodeRuntime)
     {
-        DoByteCodeProgram(prog);
+        RunByteCodeProgram(vm, prog);
     }   
     else
     {
@@ -179,6 +363,7 @@ int main(int argc, char* argv[])
 
     LogIt(LogSeverityType::Sev1_Notify, "main", "cleanup");
     ProgramDestructor(PROGRAM);
+    PebbleVMDestructor(vm);
 
     LogItDebug("method end reached", "main");
     if(g_standalone)
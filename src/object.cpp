@@ -8,10 +8,12 @@
 #include "scope.h"
 #include "token.h"
 
+utils::Slab<Scope> ObjectScopeSlab;
+
 Object* ObjectConstructor()
 {
     Object* obj = new Object;
-    obj->Attributes = ScopeConstructor(nullptr);
+    obj->Attributes = ScopeConstructor(ObjectScopeSlab, nullptr);
     obj->Attributes->IsDurable = true;
     obj->Class = NullClass;
     obj->Value = nullptr;
@@ -25,7 +27,7 @@ Object* ObjectConstructor()
 Object* ObjectConstructor(ObjectClass cls, void* value)
 {
     Object* obj = new Object;
-    obj->Attributes = ScopeConstructor(nullptr);
+    obj->Attributes = ScopeConstructor(ObjectScopeSlab, nullptr);
     obj->Class = cls;
     obj->Value = value;
     obj->Action = nullptr;
@@ -82,7 +84,7 @@ void ObjectDestructor(Object* obj)
 
 void DeleteObject(Object* obj)
 {
-    ScopeDestructor(obj->Attributes);
+    ScopeDestructor(ObjectScopeSlab, obj->Attributes);
     if(IsCallable(obj))
     {
         MethodDestructor(obj->Action);
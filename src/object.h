@@ -2,6 +2,7 @@
 #define __OBJECT_H
 
 #include "abstract.h"
+#include "utils.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Objects/Methods
@@ -38,6 +39,10 @@ class Method
 };
 
 
+/// stores the Attributes of every object. objects are created and deleted while a
+/// program is compiled, which happens one program at a time, and by the ast runtime
+extern utils::Slab<Scope> ObjectScopeSlab;
+
 Object* ObjectConstructor(ObjectClass cls, void* value);
 Object* ObjectConstructor();
 void ObjectDestructor(Object* obj);
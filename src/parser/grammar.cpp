@@ -4,13 +4,25 @@
 
 #include "token.h"
 #include "diagnostics.h"
+#include "grammartables.h"
 
 
+String g_grammarFile = "";
+
 std::vector<CFGRule> Grammar;
 std::list<PrecedenceClass> PrecedenceRules;
 std::vector<String> ProductionVariables;
 std::vector<PreprocessorRule> PreprocessorRules;
 
+std::deque<String> GrammarSymbolNames;
+std::unordered_map<std::string_view, GrammarSymbol> GrammarSymbols;
+GrammarSymbol RefGrammarSymbol = NoGrammarSymbol;
+std::vector<ReductionState> ReductionTransitions;
+std::vector<int> ReductionRules;
+std::vector<int> SymbolPrecedences;
+std::vector<bool> ProductionSymbols;
+int DefaultSymbolPrecedence = 0;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // PrecedenceClass
 bool PrecedenceClass::Contains(String symb)
@@ -141,7 +153,7 @@ int PrecedenceOf(Token* lookaheadToken)
     if(lookaheadToken == nullptr)
         return 0;
 
-    return PrecedenceOf(lookaheadToken->Content);
+    return PrecedenceOf(String(lookaheadToken->Content));
 }
 
 void AssignRulePrecedences()
@@ -157,7 +169,7 @@ void AddPrecedenceClass(TokenList& tokens)
     PrecedenceClass precdence;
     for(Token* t: tokens)
     {
-        precdence.Members.push_back(t->Content);
+        precdence.Members.emplace_back(t->Content);
     }
     PrecedenceRules.push_front(precdence);
 }
@@ -197,7 +209,7 @@ void AddGrammarRuleInternal(
 
     for(size_t i=3; i<tokens.size(); i++)
     {
-        rule.IntoPattern.push_back(tokens.at(i)->Content);
+        rule.IntoPattern.emplace_back(tokens.at(i)->Content);
     }
 
     Grammar.push_back(rule);
@@ -209,7 +221,7 @@ PrecedenceClass GetOverridePrecedenceClass(TokenList& tokens)
     pclass.Members.reserve(tokens.size()-1);
     for(size_t i=1; i<tokens.size(); i++)
     {
-        pclass.Members.push_back(tokens.at(i)->Content);
+        pclass.Members.emplace_back(tokens.at(i)->Content);
     }
 
     return pclass;
@@ -289,13 +301,158 @@ void AddPreprocessorRule(TokenList& tokens)
         std::vector<String> pattern;
         for(auto token: tokens)
         {
-            pattern.push_back(token->Content);
+            pattern.emplace_back(token->Content);
         }
         PreprocessorRule rule = { becomes, pattern };
         PreprocessorRules.push_back(rule);
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Parse tables
+
+/// returns the symbol of [str], interning it if it is new
+GrammarSymbol InternGrammarSymbol(const String& str)
+{
+    auto it = GrammarSymbols.find(str);
+    if(it != GrammarSymbols.end())
+    {
+        return it->second;
+    }
+
+    GrammarSymbol symbol = GrammarSymbolNames.size();
+    GrammarSymbolNames.push_back(str);
+    GrammarSymbols[GrammarSymbolNames.back()] = symbol;
+    return symbol;
+}
+
+/// returns the interned symbols of [strs]
+std::vector<GrammarSymbol> InternGrammarSymbols(const std::vector<String>& strs)
+{
+    std::vector<GrammarSymbol> symbols;
+    symbols.reserve(strs.size());
+    for(auto& str: strs)
+    {
+        symbols.push_back(InternGrammarSymbol(str));
+    }
+
+    return symbols;
+}
+
+/// interns every symbol of the grammar and sets the lookahead precedence and kind of
+/// each one
+void InternGrammar()
+{
+    GrammarSymbols.clear();
+    GrammarSymbolNames.clear();
+
+    for(auto& productionVar: ProductionVariables)
+    {
+        InternGrammarSymbol(productionVar);
+    }
+    RefGrammarSymbol = InternGrammarSymbol("Ref");
+
+    for(auto& rule: Grammar)
+    {
+        rule.FromProductionSymbol = InternGrammarSymbol(rule.FromProduction);
+        rule.HigherPrecedenceSymbols = InternGrammarSymbols(rule.HigherPrecedenceClass.Members);
+        rule.LowerPrecedenceSymbols = InternGrammarSymbols(rule.LowerPrecedenceClass.Members);
+        InternGrammarSymbols(rule.IntoPattern);
+    }
+
+    for(auto& pclass: PrecedenceRules)
+    {
+        InternGrammarSymbols(pclass.Members);
+    }
+
+    // tokens without a precedence class have the precedence of "." as in PrecedenceOf
+    DefaultSymbolPrecedence = PrecedenceOf(".");
+    SymbolPrecedences.assign(GrammarSymbolNames.size(), DefaultSymbolPrecedence);
+
+    // a symbol takes the precedence of the first class which contains it
+    std::vector<bool> hasPrecedence(GrammarSymbolNames.size(), false);
+    int precedence = 1;
+    for(auto& pclass: PrecedenceRules)
+    {
+        for(auto& member: pclass.Members)
+        {
+            auto symbol = GrammarSymbolOf(member);
+            if(!hasPrecedence[symbol])
+            {
+                SymbolPrecedences[symbol] = precedence;
+                hasPrecedence[symbol] = true;
+            }
+        }
+        precedence++;
+    }
+
+    ProductionSymbols.assign(GrammarSymbolNames.size(), false);
+    for(auto& productionVar: ProductionVariables)
+    {
+        ProductionSymbols[GrammarSymbolOf(productionVar)] = true;
+    }
+}
+
+/// returns a new state of the ReductionTrie without any transitions
+ReductionState AddReductionState()
+{
+    ReductionState state = ReductionRules.size();
+    ReductionTransitions.insert(ReductionTransitions.end(), GrammarSymbolNames.size(), NoReductionState);
+    ReductionRules.push_back(-1);
+    return state;
+}
+
+/// builds the ReductionTrie from the patterns of the [Grammar]
+void BuildReductionTrie()
+{
+    size_t numberOfSymbols = GrammarSymbolNames.size();
+    ReductionTransitions.clear();
+    ReductionRules.clear();
+
+    std::vector<ReductionState> parents = { NoReductionState };
+    AddReductionState();
+
+    for(size_t r=0; r<Grammar.size(); r++)
+    {
+        ReductionState state = ReductionTrieRoot;
+        auto& pattern = Grammar[r].IntoPattern;
+        for(auto it = pattern.rbegin(); it != pattern.rend(); it++)
+        {
+            size_t transition = state * numberOfSymbols + GrammarSymbolOf(*it);
+            if(ReductionTransitions[transition] == NoReductionState)
+            {
+                ReductionState next = AddReductionState();
+                parents.push_back(state);
+                ReductionTransitions[transition] = next;
+            }
+            state = ReductionTransitions[transition];
+        }
+
+        // the first rule in the grammar takes priority, as when matching in order
+        if(ReductionRules[state] < 0)
+        {
+            ReductionRules[state] = r;
+        }
+    }
+
+    // every state holds the first rule matched on the way to it. a parent is always
+    // created before its children, so one pass in order suffices
+    for(size_t state=1; state<ReductionRules.size(); state++)
+    {
+        int parentRule = ReductionRules[parents[state]];
+        if(parentRule >= 0 && (ReductionRules[state] < 0 || parentRule < ReductionRules[state]))
+        {
+            ReductionRules[state] = parentRule;
+        }
+    }
+}
+
+void BuildParseTables()
+{
+    InternGrammar();
+    BuildReductionTrie();
+}
+
 void ResetGrammar()
 {
     Grammar.clear();
@@ -311,12 +468,17 @@ void ResetGrammar()
     PreprocessorRules.reserve(16);
 }
 
-void CompileGrammar()
+void CompileGrammarFromFile(const String& fileName)
 {
     ResetGrammar();
 
     std::fstream file;
-    file.open("./assets/grammar.txt", std::ios::in);
+    file.open(fileName, std::ios::in);
+    if(!file)
+    {
+        LogIt(LogSeverityType::Sev3_Critical, "CompileGrammarFromFile", Msg("cannot open %s", fileName));
+        return;
+    }
 
     // state: +1 upon every line with first non-whitespace char being ';'
     //  0: skip all lines
@@ -327,10 +489,12 @@ void CompileGrammar()
     int state = 0;
 
     String line;
+    TokenArena arena;
     while(std::getline(file, line))
     {
         /// TODO: we should't have to lex the line every time
-        TokenList tokens = LexLine(line);
+        ClearTokenArena(arena);
+        TokenList tokens = LexLine(line, arena);
         if(tokens.empty())
         {
             continue;
@@ -338,7 +502,6 @@ void CompileGrammar()
 
         if(tokens.at(0)->Content == ";")
         {
-            DeleteTokenList(tokens);
             state++;
             continue;
         }
@@ -360,9 +523,187 @@ void CompileGrammar()
             default:
             break;
         }
-
-        DeleteTokenList(tokens);
     }
 
     AssignRulePrecedences();
+    BuildParseTables();
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Compiled grammar tables
+
+/// returns the strings in [range] of the compiled grammar tables
+std::vector<String> CompiledStringsIn(CompiledStringRange range)
+{
+    std::vector<String> strings;
+    strings.reserve(range.Size);
+    for(int i=range.Start; i<range.Start + range.Size; i++)
+    {
+        strings.push_back(CompiledGrammarStrings[i]);
+    }
+
+    return strings;
+}
+
+/// compiles the [Grammar] from the tables of grammartables.h
+void CompileGrammarFromTables()
+{
+    ResetGrammar();
+
+    for(auto& compiled: CompiledPreprocessorRules)
+    {
+        PreprocessorRule rule = { compiled.Becomes, CompiledStringsIn(compiled.Pattern) };
+        PreprocessorRules.push_back(rule);
+    }
+
+    for(auto& compiled: CompiledGrammarRules)
+    {
+        CFGRule rule;
+        rule.Name = compiled.Name;
+        rule.Symbol = compiled.Symbol;
+        rule.Precedence = compiled.Precedence;
+        rule.OpType = compiled.OpType;
+        rule.IntoPattern = CompiledStringsIn(compiled.IntoPattern);
+        rule.FromProduction = compiled.FromProduction;
+        rule.ParseMethod = compiled.ParseMethod;
+
+        rule.HasHigherPrecedenceClassOverride = compiled.HigherPrecedenceClass.Size > 0;
+        rule.HasLowerPrecedenceClassOverride = compiled.LowerPrecedenceClass.Size > 0;
+        rule.HigherPrecedenceClass.Members = CompiledStringsIn(compiled.HigherPrecedenceClass);
+        rule.LowerPrecedenceClass.Members = CompiledStringsIn(compiled.LowerPrecedenceClass);
+
+        Grammar.push_back(rule);
+    }
+
+    for(auto& compiled: CompiledPrecedenceClasses)
+    {
+        PrecedenceClass pclass;
+        pclass.Members = CompiledStringsIn(compiled);
+        PrecedenceRules.push_back(pclass);
+    }
+
+    ProductionVariables.clear();
+    for(auto productionVar: CompiledProductionVariables)
+    {
+        ProductionVariables.push_back(productionVar);
+    }
+
+    BuildParseTables();
+}
+
+void CompileGrammar()
+{
+    if(!g_grammarFile.empty())
+    {
+        CompileGrammarFromFile(g_grammarFile);
+        return;
+    }
+
+    CompileGrammarFromTables();
+}
+
+/// returns [str] as a C++ string literal
+String CppLiteralFor(const String& str)
+{
+    String literal = "\"";
+    for(auto c: str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            literal += '\\';
+        }
+        literal += c;
+    }
+
+    return literal + "\"";
+}
+
+/// appends [strings] to [table] and returns their CompiledStringRange as C++
+String CppRangeFor(const std::vector<String>& strings, std::vector<String>& table)
+{
+    String range = "{ " + std::to_string(table.size()) + ", " + std::to_string(strings.size()) + " }";
+    table.insert(table.end(), strings.begin(), strings.end());
+    return range;
+}
+
+/// returns the C++ expression of [type], which is named by the rule [name]
+String CppOperationTypeFor(OperationType type, const String& name)
+{
+    if(type == OperationType::NoOperationType)
+    {
+        return "OperationType::NoOperationType";
+    }
+    return "OperationType::" + name;
+}
+
+bool EmitGrammarTables(const String& file)
+{
+    std::vector<String> table;
+
+    std::vector<String> preprocessorRules;
+    for(auto& rule: PreprocessorRules)
+    {
+        preprocessorRules.push_back("{ " + CppLiteralFor(rule.Becomes) + ", " + CppRangeFor(rule.Pattern, table) + " }");
+    }
+
+    std::vector<String> grammarRules;
+    for(auto& rule: Grammar)
+    {
+        grammarRules.push_back("{ " + CppLiteralFor(rule.Name) + ", " + CppLiteralFor(rule.Symbol) + ", "
+            + std::to_string(rule.Precedence) + ", " + CppOperationTypeFor(rule.OpType, rule.Name) + ", "
+            + CppRangeFor(rule.IntoPattern, table) + ", " + CppLiteralFor(rule.FromProduction) + ", "
+            + CppLiteralFor(rule.ParseMethod) + ", " 
+            + CppRangeFor(rule.HigherPrecedenceClass.Members, table) + ", "
+            + CppRangeFor(rule.LowerPrecedenceClass.Members, table) + " }");
+    }
+
+    std::vector<String> precedenceClasses;
+    for(auto& pclass: PrecedenceRules)
+    {
+        precedenceClasses.push_back(CppRangeFor(pclass.Members, table));
+    }
+
+    std::vector<String> productionVariables;
+    for(auto& productionVar: ProductionVariables)
+    {
+        productionVariables.push_back(CppLiteralFor(productionVar));
+    }
+
+    for(auto& str: table)
+    {
+        str = CppLiteralFor(str);
+    }
+
+    std::ofstream out(file);
+    if(!out)
+    {
+        return false;
+    }
+
+    auto emitTable = [&](const String& type, const String& name, const std::vector<String>& entries)
+    {
+        out << "constexpr std::array<" << type << ", " << entries.size() << "> " << name << " =\n{{\n";
+        for(auto& entry: entries)
+        {
+            out << "    " << entry << ",\n";
+        }
+        out << "}};\n\n";
+    };
+
+    out << "// generated by `make grammar` from ./assets/grammar.txt. do not edit\n\n"
+        << "#ifndef __GRAMMARTABLES_H\n"
+        << "#define __GRAMMARTABLES_H\n\n"
+        << "#include <array>\n\n"
+        << "#include \"grammar.h\"\n\n";
+
+    emitTable("const char*", "CompiledGrammarStrings", table);
+    emitTable("CompiledPreprocessorRule", "CompiledPreprocessorRules", preprocessorRules);
+    emitTable("CompiledGrammarRule", "CompiledGrammarRules", grammarRules);
+    emitTable("CompiledStringRange", "CompiledPrecedenceClasses", precedenceClasses);
+    emitTable("const char*", "CompiledProductionVariables", productionVariables);
+
+    out << "#endif\n";
+
+    return out.good();
 }
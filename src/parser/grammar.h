@@ -2,9 +2,19 @@
 #define __GRAMMAR_H
 
 #include <list>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
 
 #include "abstract.h"
 
+/// the id of an interned grammar symbol, ie. a production variable or the content of
+/// a simple token
+typedef int GrammarSymbol;
+
+/// the symbol of a token whose content does not appear in the grammar
+constexpr GrammarSymbol NoGrammarSymbol = -1;
+
 /// a PrecedenceClass is a collection of String representing operation symbols that all have the same precedence
 /// when parsed
 class PrecedenceClass
@@ -22,6 +32,8 @@ class PrecedenceClass
 /// [IntoPattern] is the pattern which applying the rule yields
 /// [FromProduction] is the production rule name
 /// [ParseMethod] is the method which describes how to reverse the rule on a set of operand Operations
+/// [FromProductionSymbol] is the interned [FromProduction]
+/// [HigherPrecedenceSymbols] and [LowerPrecedenceSymbols] are the interned precedence class overrides
 struct CFGRule
 {
     String Name;
@@ -36,6 +48,10 @@ struct CFGRule
     bool HasLowerPrecedenceClassOverride;
     PrecedenceClass HigherPrecedenceClass;
     PrecedenceClass LowerPrecedenceClass;
+
+    GrammarSymbol FromProductionSymbol;
+    std::vector<GrammarSymbol> HigherPrecedenceSymbols;
+    std::vector<GrammarSymbol> LowerPrecedenceSymbols;
 };
 
 struct PreprocessorRule
@@ -45,6 +61,43 @@ struct PreprocessorRule
 };
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Compiled grammar tables
+//
+// the grammar is compiled into pebble as the static tables of grammartables.h, which
+// `make grammar` generates from ./assets/grammar.txt. every list of strings in the
+// tables is a range of CompiledGrammarStrings
+
+/// a range of [Size] strings starting at [Start] in CompiledGrammarStrings
+struct CompiledStringRange
+{
+    int Start;
+    int Size;
+};
+
+/// a CFGRule as it is stored in the compiled grammar tables. a precedence class
+/// override is empty if the rule does not have one
+struct CompiledGrammarRule
+{
+    const char* Name;
+    const char* Symbol;
+    int Precedence;
+    OperationType OpType;
+    CompiledStringRange IntoPattern;
+    const char* FromProduction;
+    const char* ParseMethod;
+    CompiledStringRange HigherPrecedenceClass;
+    CompiledStringRange LowerPrecedenceClass;
+};
+
+/// a PreprocessorRule as it is stored in the compiled grammar tables
+struct CompiledPreprocessorRule
+{
+    const char* Becomes;
+    CompiledStringRange Pattern;
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Definitions
 
@@ -59,12 +112,104 @@ extern std::vector<String> ProductionVariables;
 
 extern std::vector<PreprocessorRule> PreprocessorRules;
 
-/// compiles the [Grammar] from ./assets/grammar.txt
+/// the grammar file to compile the [Grammar] from at runtime, or empty to use the
+/// compiled grammar tables
+extern String g_grammarFile;
+
+/// compiles the [Grammar] from the compiled grammar tables, or from [g_grammarFile]
+/// if it is set
 void CompileGrammar();
 
+/// compiles the [Grammar] from the grammar file [file]
+void CompileGrammarFromFile(const String& file);
+
+/// writes the current [Grammar] as the compiled grammar tables to [file]. returns
+/// false if the file could not be written
+bool EmitGrammarTables(const String& file);
+
 int PrecedenceOf(String opSymbol);
 int PrecedenceOf(Token* lookaheadToken);
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Parse tables
+//
+// the parser matches rules on interned GrammarSymbols instead of strings. the patterns
+// of the rules are inserted back to front into the ReductionTrie, so walking it from
+// the top of the parse stack finds the first rule in the [Grammar] whose pattern ends
+// the stack. a match costs at most the length of the longest pattern, however many
+// rules there are. the tables are built whenever the grammar is compiled
+
+/// a state of the ReductionTrie
+typedef int ReductionState;
+
+/// the state before any symbol of the parse stack is read
+constexpr ReductionState ReductionTrieRoot = 0;
+
+/// the state after a symbol which no pattern continues with
+constexpr ReductionState NoReductionState = -1;
+
+/// the string of each symbol, and the interned symbols keyed by views of those strings,
+/// so tokens are looked up without copying their content
+extern std::deque<String> GrammarSymbolNames;
+extern std::unordered_map<std::string_view, GrammarSymbol> GrammarSymbols;
+
+/// the symbol of a parse token for a Ref
+extern GrammarSymbol RefGrammarSymbol;
+
+/// the ReductionTrie, where the state after [symbol] from [state] is
+/// ReductionTransitions[state * GrammarSymbolNames.size() + symbol]
+extern std::vector<ReductionState> ReductionTransitions;
+
+/// the index in the [Grammar] of the first rule whose pattern is matched on the way to
+/// each state, or -1
+extern std::vector<int> ReductionRules;
+
+/// the precedence of each symbol as a lookahead
+extern std::vector<int> SymbolPrecedences;
+
+/// true for each symbol which is a production variable
+extern std::vector<bool> ProductionSymbols;
+
+/// the lookahead precedence of tokens which have no precedence class
+extern int DefaultSymbolPrecedence;
+
+/// returns the interned symbol of [str], or NoGrammarSymbol
+inline GrammarSymbol GrammarSymbolOf(std::string_view str)
+{
+    auto it = GrammarSymbols.find(str);
+    return it == GrammarSymbols.end() ? NoGrammarSymbol : it->second;
+}
+
+/// returns the state of the ReductionTrie after reading [symbol] in [state]
+inline ReductionState NextReductionState(ReductionState state, GrammarSymbol symbol)
+{
+    if(symbol == NoGrammarSymbol)
+    {
+        return NoReductionState;
+    }
+    return ReductionTransitions[state * GrammarSymbolNames.size() + symbol];
+}
+
+/// returns the first rule matched on the way to [state], or nullptr
+inline const CFGRule* ReducedRuleAt(ReductionState state)
+{
+    int rule = ReductionRules[state];
+    return rule < 0 ? nullptr : &Grammar[rule];
+}
+
+/// returns the precedence of [symbol] as a lookahead
+inline int PrecedenceOfSymbol(GrammarSymbol symbol)
+{
+    return symbol == NoGrammarSymbol ? DefaultSymbolPrecedence : SymbolPrecedences[symbol];
+}
+
+/// returns true if [symbol] is a production variable
+inline bool IsProductionSymbol(GrammarSymbol symbol)
+{
+    return symbol != NoGrammarSymbol && ProductionSymbols[symbol];
+}
+
 inline const String g_ContextStartSymbol = "@";
 
 #endif
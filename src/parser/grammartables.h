@@ -0,0 +1,399 @@
+// generated by `make grammar` from ./assets/grammar.txt. do not edit
+
+#ifndef __GRAMMARTABLES_H
+#define __GRAMMARTABLES_H
+
+#include <array>
+
+#include "grammar.h"
+
+constexpr std::array<const char*, 265> CompiledGrammarStrings =
+{{
+    "is",
+    "leq",
+    "to",
+    "is",
+    "leq",
+    "leq",
+    "leq",
+    "to",
+    "is",
+    "less",
+    "than",
+    "or",
+    "equal",
+    "to",
+    "is",
+    "geq",
+    "to",
+    "is",
+    "geq",
+    "geq",
+    "geq",
+    "to",
+    "is",
+    "greater",
+    "than",
+    "or",
+    "equal",
+    "to",
+    "is",
+    "greater",
+    "than",
+    "is",
+    "less",
+    "than",
+    "equals",
+    "is",
+    "equal",
+    "is",
+    "equal",
+    "to",
+    "does",
+    "not",
+    "equal",
+    "not",
+    "equal",
+    "not",
+    "equal",
+    "to",
+    "not",
+    "equals",
+    "is",
+    "not",
+    "not",
+    "an",
+    "and",
+    "or",
+    "inherits",
+    "print",
+    "'s",
+    "otherwise",
+    "ow",
+    "Expr",
+    "==",
+    "Expr",
+    "Expr",
+    "!=",
+    "Expr",
+    "Expr",
+    ">",
+    "Expr",
+    "Expr",
+    "<",
+    "Expr",
+    "Expr",
+    ">=",
+    "Expr",
+    "Expr",
+    "<=",
+    "Expr",
+    "Expr",
+    "is",
+    "Expr",
+    "Expr",
+    "=",
+    "(",
+    "Tuple",
+    ")",
+    "Expr",
+    "=",
+    "Expr",
+    "Expr",
+    "=",
+    "Lambda",
+    "Expr",
+    "+",
+    "Expr",
+    "Expr",
+    "-",
+    "Expr",
+    "Expr",
+    "*",
+    "Expr",
+    "Expr",
+    "/",
+    "Expr",
+    "Expr",
+    "&&",
+    "Expr",
+    "Expr",
+    "||",
+    "Expr",
+    "!",
+    "Expr",
+    "ask",
+    "Expr",
+    "say",
+    "Expr",
+    "here",
+    "Expr",
+    ":",
+    "Expr",
+    ".",
+    "Ref",
+    "(",
+    ")",
+    ":",
+    "Expr",
+    ".",
+    "Ref",
+    "(",
+    "Expr",
+    ")",
+    ":",
+    "Expr",
+    ".",
+    "Ref",
+    "(",
+    "Tuple",
+    ")",
+    ":",
+    "Expr",
+    "Expr",
+    "(",
+    ")",
+    ":",
+    "Expr",
+    "Expr",
+    "(",
+    "Expr",
+    ")",
+    ":",
+    "Expr",
+    "Expr",
+    "(",
+    "Tuple",
+    ")",
+    ":",
+    "Expr",
+    "(",
+    ")",
+    ":",
+    "Expr",
+    "(",
+    "Expr",
+    ")",
+    ":",
+    "Expr",
+    "(",
+    "Tuple",
+    ")",
+    "return",
+    "Expr",
+    "return",
+    "Expr",
+    "[",
+    "Expr",
+    "]",
+    "if",
+    "else",
+    "else",
+    "if",
+    "Expr",
+    "if",
+    "Expr",
+    "while",
+    "Expr",
+    "for",
+    "each",
+    "(",
+    "Ref",
+    "in",
+    "Expr",
+    ")",
+    "for",
+    "each",
+    "Ref",
+    "in",
+    "Expr",
+    "(",
+    "Tuple",
+    ")",
+    ":",
+    "(",
+    "Expr",
+    ")",
+    ":",
+    "(",
+    ")",
+    ":",
+    ":",
+    "Expr",
+    "Lambda",
+    "Ref",
+    "Lambda",
+    "a",
+    "Ref",
+    "new",
+    "Ref",
+    "Tuple",
+    ",",
+    "Expr",
+    "Expr",
+    ",",
+    "Expr",
+    "Expr",
+    ".",
+    "Ref",
+    "a",
+    "Ref",
+    "SRef",
+    "(",
+    "Expr",
+    ")",
+    "consider",
+    "Expr",
+    "take",
+    "Expr",
+    "Expr",
+    "lowest",
+    ")",
+    "]",
+    ",",
+    "=",
+    "is",
+    "||",
+    "&&",
+    "==",
+    "!=",
+    "<",
+    ">",
+    "<=",
+    ">=",
+    "+",
+    "-",
+    "*",
+    "/",
+    "!",
+    "[",
+    ".",
+    "(",
+    "in",
+    "new",
+    "a",
+    ":",
+    "highest",
+}};
+
+constexpr std::array<CompiledPreprocessorRule, 29> CompiledPreprocessorRules =
+{{
+    { "<=", { 0, 3 } },
+    { "<=", { 3, 2 } },
+    { "<=", { 5, 1 } },
+    { "<=", { 6, 2 } },
+    { "<=", { 8, 6 } },
+    { ">=", { 14, 3 } },
+    { ">=", { 17, 2 } },
+    { ">=", { 19, 1 } },
+    { ">=", { 20, 2 } },
+    { ">=", { 22, 6 } },
+    { ">", { 28, 3 } },
+    { "<", { 31, 3 } },
+    { "==", { 34, 1 } },
+    { "==", { 35, 2 } },
+    { "==", { 37, 3 } },
+    { "!=", { 40, 3 } },
+    { "!=", { 43, 2 } },
+    { "!=", { 45, 3 } },
+    { "!=", { 48, 2 } },
+    { "!=", { 50, 2 } },
+    { "!", { 52, 1 } },
+    { "a", { 53, 1 } },
+    { "&&", { 54, 1 } },
+    { "||", { 55, 1 } },
+    { "here", { 56, 1 } },
+    { "say", { 57, 1 } },
+    { ".", { 58, 1 } },
+    { "else", { 59, 1 } },
+    { "else", { 60, 1 } },
+}};
+
+constexpr std::array<CompiledGrammarRule, 55> CompiledGrammarRules =
+{{
+    { "IsEqual", "==", 7, OperationType::IsEqual, { 61, 3 }, "Expr", "Reduce", { 61, 0 }, { 61, 0 } },
+    { "IsNotEqual", "!=", 7, OperationType::IsNotEqual, { 64, 3 }, "Expr", "Reduce", { 64, 0 }, { 64, 0 } },
+    { "IsGreaterThan", ">", 8, OperationType::IsGreaterThan, { 67, 3 }, "Expr", "Reduce", { 67, 0 }, { 67, 0 } },
+    { "IsLessThan", "<", 8, OperationType::IsLessThan, { 70, 3 }, "Expr", "Reduce", { 70, 0 }, { 70, 0 } },
+    { "IsGreaterThanOrEqualTo", ">=", 8, OperationType::IsGreaterThanOrEqualTo, { 73, 3 }, "Expr", "Reduce", { 73, 0 }, { 73, 0 } },
+    { "IsLessThanOrEqualTo", "<=", 8, OperationType::IsLessThanOrEqualTo, { 76, 3 }, "Expr", "Reduce", { 76, 0 }, { 76, 0 } },
+    { "Is", "is", 4, OperationType::Is, { 79, 3 }, "Expr", "Reduce", { 79, 0 }, { 79, 0 } },
+    { "Assign", "=", 4, OperationType::Assign, { 82, 5 }, "Expr", "Reduce", { 82, 0 }, { 82, 0 } },
+    { "Assign", "=", 4, OperationType::Assign, { 87, 3 }, "Expr", "Reduce", { 87, 0 }, { 87, 0 } },
+    { "Assign", "=", 4, OperationType::Assign, { 90, 3 }, "Expr", "Reduce", { 90, 0 }, { 90, 0 } },
+    { "Add", "+", 9, OperationType::Add, { 93, 3 }, "Expr", "Reduce", { 93, 0 }, { 93, 0 } },
+    { "Subtract", "-", 9, OperationType::Subtract, { 96, 3 }, "Expr", "Reduce", { 96, 0 }, { 96, 0 } },
+    { "Multiply", "*", 10, OperationType::Multiply, { 99, 3 }, "Expr", "Reduce", { 99, 0 }, { 99, 0 } },
+    { "Divide", "/", 10, OperationType::Divide, { 102, 3 }, "Expr", "Reduce", { 102, 0 }, { 102, 0 } },
+    { "And", "&&", 6, OperationType::And, { 105, 3 }, "Expr", "Reduce", { 105, 0 }, { 105, 0 } },
+    { "Or", "||", 5, OperationType::Or, { 108, 3 }, "Expr", "Reduce", { 108, 0 }, { 108, 0 } },
+    { "Not", "!", 11, OperationType::Not, { 111, 2 }, "Expr", "Reduce", { 111, 0 }, { 111, 0 } },
+    { "Ask", "lowest", 1, OperationType::Ask, { 113, 2 }, "Expr", "Reduce", { 113, 0 }, { 113, 0 } },
+    { "Print", "lowest", 1, OperationType::Print, { 115, 2 }, "Line", "Reduce", { 115, 0 }, { 115, 0 } },
+    { "EvaluateHere", "!", 11, OperationType::EvaluateHere, { 117, 2 }, "Expr", "Reduce", { 117, 0 }, { 117, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 120, 5 }, "Expr", "Reduce", { 119, 1 }, { 119, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 126, 6 }, "Expr", "Reduce", { 125, 1 }, { 125, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 133, 6 }, "Expr", "Reduce", { 132, 1 }, { 132, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 140, 4 }, "Expr", "Reduce", { 139, 1 }, { 139, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 145, 5 }, "Expr", "Reduce", { 144, 1 }, { 144, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 151, 5 }, "Expr", "Reduce", { 150, 1 }, { 150, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 157, 3 }, "Expr", "UnscopedEval", { 156, 1 }, { 156, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 161, 4 }, "Expr", "UnscopedEval", { 160, 1 }, { 160, 0 } },
+    { "Evaluate", "(", 13, OperationType::Evaluate, { 166, 4 }, "Expr", "UnscopedEval", { 165, 1 }, { 165, 0 } },
+    { "Return", "=", 4, OperationType::Return, { 170, 2 }, "Line", "Reduce", { 170, 0 }, { 170, 0 } },
+    { "Return", "=", 4, OperationType::Return, { 172, 1 }, "Line", "Reduce", { 172, 0 }, { 172, 0 } },
+    { "Array", "[", 12, OperationType::Array, { 173, 4 }, "Expr", "Reduce", { 173, 0 }, { 173, 0 } },
+    { "Else", "lowest", 1, OperationType::Else, { 178, 1 }, "Line", "Reduce", { 177, 1 }, { 177, 0 } },
+    { "ElseIf", "lowest", 1, OperationType::ElseIf, { 179, 3 }, "Line", "Reduce", { 179, 0 }, { 179, 0 } },
+    { "If", "lowest", 1, OperationType::If, { 182, 2 }, "Line", "Reduce", { 182, 0 }, { 182, 0 } },
+    { "While", "lowest", 1, OperationType::While, { 184, 2 }, "Line", "Reduce", { 184, 0 }, { 184, 0 } },
+    { "For", "lowest", 1, OperationType::NoOperationType, { 186, 7 }, "Line", "Reduce", { 186, 0 }, { 186, 0 } },
+    { "For", "lowest", 1, OperationType::NoOperationType, { 193, 5 }, "Line", "Reduce", { 193, 0 }, { 193, 0 } },
+    { "DefineMethod", ":", 14, OperationType::DefineMethod, { 198, 4 }, "Lambda", "Reduce", { 198, 0 }, { 198, 0 } },
+    { "DefineMethod", ":", 14, OperationType::DefineMethod, { 202, 4 }, "Lambda", "Reduce", { 202, 0 }, { 202, 0 } },
+    { "DefineMethod", ":", 14, OperationType::DefineMethod, { 206, 3 }, "Lambda", "Reduce", { 206, 0 }, { 206, 0 } },
+    { "DefineMethod", ":", 14, OperationType::DefineMethod, { 209, 1 }, "Lambda", "Reduce", { 209, 0 }, { 209, 0 } },
+    { "Assign", "highest", 14, OperationType::Assign, { 210, 2 }, "Line", "Reduce", { 210, 0 }, { 210, 0 } },
+    { "Assign", "highest", 14, OperationType::Assign, { 212, 2 }, "Line", "Reduce", { 212, 0 }, { 212, 0 } },
+    { "DoTypeBinding", "a", 14, OperationType::DoTypeBinding, { 214, 2 }, "Expr", "Reduce", { 214, 0 }, { 214, 0 } },
+    { "New", "new", 14, OperationType::New, { 216, 2 }, "Expr", "Reduce", { 216, 0 }, { 216, 0 } },
+    { "Tuple", ",", 3, OperationType::Tuple, { 218, 3 }, "Tuple", "Merge", { 218, 0 }, { 218, 0 } },
+    { "Tuple", ",", 3, OperationType::Tuple, { 221, 3 }, "Tuple", "Reduce", { 221, 0 }, { 221, 0 } },
+    { "ScopeResolution", ".", 12, OperationType::ScopeResolution, { 224, 3 }, "SRef", "Reduce", { 224, 0 }, { 224, 0 } },
+    { "NoOperationType", "highest", 14, OperationType::NoOperationType, { 228, 1 }, "SRef", "Retain", { 227, 1 }, { 227, 0 } },
+    { "NoOperationType", "highest", 14, OperationType::NoOperationType, { 229, 1 }, "Expr", "Retain", { 229, 0 }, { 229, 0 } },
+    { "NoOperationType", "(", 13, OperationType::NoOperationType, { 230, 3 }, "Expr", "Retain", { 230, 0 }, { 230, 0 } },
+    { "NoOperationType", "lowest", 1, OperationType::NoOperationType, { 233, 2 }, "Line", "Retain", { 233, 0 }, { 233, 0 } },
+    { "NoOperationType", "lowest", 1, OperationType::NoOperationType, { 235, 2 }, "Line", "Retain", { 235, 0 }, { 235, 0 } },
+    { "NoOperationType", "lowest", 1, OperationType::NoOperationType, { 237, 1 }, "Line", "Retain", { 237, 0 }, { 237, 0 } },
+}};
+
+constexpr std::array<CompiledStringRange, 14> CompiledPrecedenceClasses =
+{{
+    { 238, 1 },
+    { 239, 2 },
+    { 241, 1 },
+    { 242, 2 },
+    { 244, 1 },
+    { 245, 1 },
+    { 246, 2 },
+    { 248, 4 },
+    { 252, 2 },
+    { 254, 2 },
+    { 256, 1 },
+    { 257, 2 },
+    { 259, 1 },
+    { 260, 5 },
+}};
+
+constexpr std::array<const char*, 6> CompiledProductionVariables =
+{{
+    "Ref",
+    "Expr",
+    "Line",
+    "Lambda",
+    "Tuple",
+    "SRef",
+}};
+
+#endif
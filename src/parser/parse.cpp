@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
 #include "parse.h"
 
 #include "main.h"
@@ -13,6 +17,11 @@
 
 std::vector<Object*> ConstantPrimitiveObjects;
 
+/// the ConstantPrimitiveObjects keyed by the ConstantKeyOf their tokens
+std::unordered_map<String, Object*> ConstantPrimitiveIndex;
+
+thread_local std::vector<DeferredConstant>* DeferredConstants = nullptr;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Formal expression parser
 
@@ -48,12 +57,12 @@ void RemoveLastTokenFromList(ParseToken** listHead, ParseToken** listTail)
     delete temp;
 }
 
-ParseToken* ParseTokenConstructor(String tokenType)
+ParseToken* ParseTokenConstructor(GrammarSymbol symbol)
 {
     ParseToken* gt = new ParseToken;
     gt->Next = nullptr;
     gt->Prev = nullptr;
-    gt->TokenType = tokenType;
+    gt->Symbol = symbol;
     gt->Value = nullptr;
 
     return gt;
@@ -64,38 +73,44 @@ void ParseTokenDestructor(ParseToken* token)
     delete token;
 }
 
-bool TokenRefersToExistingPrimitiveObject(Token* token, Object** matchedObject)
+/// returns the key of the primitive [token] in the ConstantPrimitiveIndex, which is the same for every token
+/// of the same type and value
+String ConstantKeyOf(Token* token)
 {
-    Object* obj;
-    auto value = token->Content;
-    bool found = false;
     switch(token->Type)
     {
         case TokenType::Integer:
-        found = ListContainsPrimitiveObject(ConstantPrimitiveObjects, std::stoi(value), &obj);
-        break;
+        return "i" + std::to_string(std::stoi(String(token->Content)));
 
         case TokenType::Boolean:
-        {
-            bool b = (value == "true" ? true : false);
-            found = ListContainsPrimitiveObject(ConstantPrimitiveObjects, b, &obj);
-        }
-        break;
+        return token->Content == "true" ? "b1" : "b0";
 
         case TokenType::String:
-        found = ListContainsPrimitiveObject(ConstantPrimitiveObjects, value, &obj);
-        break;
+        return "s" + String(token->Content);
 
         case TokenType::Decimal:
-        found = ListContainsPrimitiveObject(ConstantPrimitiveObjects, std::stod(value), &obj);
-        break;
+        {
+            double value = std::stod(String(token->Content));
+            String key(1 + sizeof(value), 'd');
+            std::memcpy(&key[1], &value, sizeof(value));
+            return key;
+        }
 
         default:
+        return "";
+    }
+}
+
+bool TokenRefersToExistingPrimitiveObject(Token* token, Object** matchedObject)
+{
+    auto it = ConstantPrimitiveIndex.find(ConstantKeyOf(token));
+    if(it == ConstantPrimitiveIndex.end())
+    {
         return false;
     }
 
-    *matchedObject = obj;
-    return found;
+    *matchedObject = it->second;
+    return true;
 }
 
 Object* CreateObjectFromToken(Token* token)
@@ -103,10 +118,10 @@ Object* CreateObjectFromToken(Token* token)
     switch(token->Type)
     {
         case TokenType::Integer:
-        return ObjectConstructor(IntegerClass, ObjectValueConstructor(std::stoi(token->Content)));
+        return ObjectConstructor(IntegerClass, ObjectValueConstructor(std::stoi(String(token->Content))));
         
         case TokenType::Decimal:
-        return ObjectConstructor(DecimalClass, ObjectValueConstructor(std::stod(token->Content)));
+        return ObjectConstructor(DecimalClass, ObjectValueConstructor(std::stod(String(token->Content))));
 
         case TokenType::Boolean:
         {
@@ -115,32 +130,55 @@ Object* CreateObjectFromToken(Token* token)
         }
 
         case TokenType::String:
-        return ObjectConstructor(StringClass, ObjectValueConstructor(token->Content));
+        return ObjectConstructor(StringClass, ObjectValueConstructor(String(token->Content)));
 
         default:
         return nullptr;
     }
 }
 
+/// returns the constant object for the primitive [token], which is shared by every token with its value
+Object* ConstantObjectFor(Token* token)
+{
+    Object* obj = nullptr;
+    if(!TokenRefersToExistingPrimitiveObject(token, &obj))
+    {
+        obj = CreateObjectFromToken(token);
+        ConstantPrimitiveObjects.push_back(obj);
+        ConstantPrimitiveIndex[ConstantKeyOf(token)] = obj;
+    }
+
+    return obj;
+}
+
+void BindDeferredConstants(const std::vector<DeferredConstant>& constants)
+{
+    for(auto& constant: constants)
+    {
+        constant.Ref->To = ConstantObjectFor(constant.Value);
+    }
+}
+
 /// constructs a operation of type OperationType::Ref with either a primitive value or a named Reference stub
 Operation* RefOperation(Token* refToken)
 {
     Reference* ref = nullptr;
-    Object* obj = nullptr;
 
     if(TokenMatchesType(refToken, PrimitiveTokenTypes))
     {
-        if(!TokenRefersToExistingPrimitiveObject(refToken, &obj))
+        if(DeferredConstants != nullptr)
         {
-            obj = CreateObjectFromToken(refToken);
-            ConstantPrimitiveObjects.push_back(obj);
+            ref = ReferenceConstructor(c_operationReferenceName, nullptr);
+            DeferredConstants->push_back({ ref, refToken });
+        }
+        else
+        {
+            ref = ReferenceConstructor(c_operationReferenceName, ConstantObjectFor(refToken));
         }
-
-        ref = ReferenceConstructor(c_operationReferenceName, obj);
     }
     else
     {
-        ref = ReferenceStubConstructor(refToken->Content);    
+        ref = ReferenceStubConstructor(String(refToken->Content));    
     }
     
     Operation* op = OperationConstructor(OperationType::Ref, ref);
@@ -148,34 +186,29 @@ Operation* RefOperation(Token* refToken)
     return op;
 }
 
-bool MatchGrammarPatterns(ParseToken* listHead, ParseToken* listTail, CFGRule& match)
+/// returns the first rule in the [Grammar] whose pattern matches the end of the list, or nullptr. walks the
+/// ReductionTrie from [listTail] towards the head
+const CFGRule* MatchGrammarPatterns(ParseToken* listTail)
 {
-    for(CFGRule& rule: Grammar)
+    ReductionState state = ReductionTrieRoot;
+    const CFGRule* match = ReducedRuleAt(state);
+
+    for(ParseToken* listItr = listTail; listItr != nullptr; listItr = listItr->Prev)
     {
-        bool isMatchForRule = true;
-        ParseToken* listItr = listTail;
-        for(int i=rule.IntoPattern.size()-1; i>=0; i--, listItr = listItr->Prev)
+        state = NextReductionState(state, listItr->Symbol);
+        if(state == NoReductionState)
         {
-            // false if rule is longer than the list
-            if(listItr == nullptr)
-            {
-                isMatchForRule = false;
-                break;
-            }
-
-            if(listItr->TokenType != rule.IntoPattern.at(i))
-            {
-                isMatchForRule = false;
-                break;
-            }
+            break;
         }
-        if(isMatchForRule)
+
+        const CFGRule* rule = ReducedRuleAt(state);
+        if(rule != nullptr)
         {
             match = rule;
-            return true;
         }
     }
-    return false;
+
+    return match;
 }
 
 void DestroyList(ParseToken* listHead)
@@ -189,18 +222,8 @@ void DestroyList(ParseToken* listHead)
     }
 }
 
-bool ParseTokenTypeMatches(String TokenType, std::vector<String> matchTypes)
-{
-    for(auto str: matchTypes)
-    {
-        if(TokenType == str)
-            return true;
-    }
-    return false;
-}
-
 /// pushes listTail back to before the [rule] pattern and sets listSnipHead to be the head (start) of [rule] in the ParseStack
-void PointToHeadOfRuleAndSnip(ParseToken** listHead, ParseToken** listTail, ParseToken** listSnipHead, CFGRule& rule)
+void PointToHeadOfRuleAndSnip(ParseToken** listHead, ParseToken** listTail, ParseToken** listSnipHead, const CFGRule& rule)
 {
     int backtrackAmount = rule.IntoPattern.size()-1;
 
@@ -220,7 +243,7 @@ void PointToHeadOfRuleAndSnip(ParseToken** listHead, ParseToken** listTail, Pars
 }
 
 /// assumes that the list matches [rule] and removes the rule
-OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** listTail, CFGRule& rule)
+OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
 {
     OperationsList operands;
     operands.reserve(4);
@@ -232,7 +255,7 @@ OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** list
     // gets the operands
     for(ParseToken* listSnipItr = listSnipHead; listSnipItr != nullptr; listSnipItr = listSnipItr->Next)
     {
-        if(ParseTokenTypeMatches(listSnipItr->TokenType, ProductionVariables) && listSnipItr->Value != nullptr)
+        if(IsProductionSymbol(listSnipItr->Symbol) && listSnipItr->Value != nullptr)
         {
             operands.push_back(listSnipItr->Value);
         }
@@ -249,13 +272,13 @@ OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** list
 // Methods of collapsing grammar rules
 
 /// collapse a rule by adding each component as the operand of a new operation
-Operation* CollapseByReduce(CFGRule& rule, OperationsList& components)
+Operation* CollapseByReduce(const CFGRule& rule, OperationsList& components)
 {
     return OperationConstructor(rule.OpType, components);
 }
 
 /// collapse a rule by merging all components into the first component's operand list
-Operation* CollapseByMerge(CFGRule& rule, OperationsList& components)
+Operation* CollapseByMerge(const CFGRule& rule, OperationsList& components)
 {
     OperationsList& oplist = components.at(0)->Operands;
     
@@ -273,7 +296,7 @@ Operation* NothingStubOperation()
 }
 
 /// order is caller, method, params
-Operation* CollapseByUnscopedEval(CFGRule& rule, OperationsList& components)
+Operation* CollapseByUnscopedEval(const CFGRule& rule, OperationsList& components)
 {
     if(components.size() == 1)
     {
@@ -296,7 +319,7 @@ Operation* CollapseByUnscopedEval(CFGRule& rule, OperationsList& components)
     return OperationConstructor(rule.OpType, components);
 }
 
-Operation* CollapseRuleInternal(CFGRule& rule, OperationsList& components)
+Operation* CollapseRuleInternal(const CFGRule& rule, OperationsList& components)
 {
     if(rule.ParseMethod == "Reduce")
     {
@@ -322,12 +345,12 @@ Operation* CollapseRuleInternal(CFGRule& rule, OperationsList& components)
 }
 
 /// reverses a rule in the ParseStack
-void CollapseListByRule(ParseToken** listHead, ParseToken** listTail, CFGRule& rule)
+void CollapseListByRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
 {
     OperationsList operands = GetOperandsAndRemoveRule(listHead, listTail, rule);
     Operation* op = CollapseRuleInternal(rule, operands);
 
-    ParseToken* t = ParseTokenConstructor(rule.FromProduction);
+    ParseToken* t = ParseTokenConstructor(rule.FromProductionSymbol);
     t->Value = op;
 
     AddToList(listHead, listTail, t);
@@ -335,10 +358,15 @@ void CollapseListByRule(ParseToken** listHead, ParseToken** listTail, CFGRule& r
 
 void LogParseStack(ParseToken* listHead)
 {
+    if(LogAtLevel > LogSeverityType::Sev0_Debug)
+    {
+        return;
+    }
+
     String Line;
     for(ParseToken* t = listHead; t != nullptr; t = t->Next)
     {
-       Line += t->TokenType;
+       Line += t->Symbol == NoGrammarSymbol ? "?" : GrammarSymbolNames[t->Symbol];
        Line += " ";
     }
     LogItDebug(Line, "LogParseStack");
@@ -348,7 +376,7 @@ void LogParseStack(ParseToken* listHead)
 /// add a new token for a Ref (object) to the ParseList
 void AddRefToken(ParseToken** listHead, ParseToken** listTail, Token* token)
 {
-    ParseToken* t = ParseTokenConstructor("Ref");
+    ParseToken* t = ParseTokenConstructor(RefGrammarSymbol);
     t->Value = RefOperation(token);
     AddToList(listHead, listTail, t);
 }
@@ -356,7 +384,7 @@ void AddRefToken(ParseToken** listHead, ParseToken** listTail, Token* token)
 /// add a new token for a simple keyword/operation to the ParseList
 void AddSimpleToken(ParseToken** listHead, ParseToken** listTail, Token* token)
 {
-    ParseToken* t = ParseTokenConstructor(token->Content);
+    ParseToken* t = ParseTokenConstructor(GrammarSymbolOf(token->Content));
     t->Value = nullptr;
     AddToList(listHead, listTail, t);
 }
@@ -380,21 +408,26 @@ void AddNextTokenToList(ParseToken** listHead, ParseToken** listTail, Token* cur
     }
 }
 
-bool CurrentRuleHasHigherPrecedence(CFGRule& rule, Token* lookaheadToken)
+/// returns true if [symbols] contains [symbol]
+inline bool SymbolsContain(const std::vector<GrammarSymbol>& symbols, GrammarSymbol symbol)
 {
-    if(lookaheadToken != nullptr)
+    return std::find(symbols.begin(), symbols.end(), symbol) != symbols.end();
+}
+
+/// [lookaheadSymbol] and [lookaheadPrecedence] describe the lookahead token, and are NoGrammarSymbol and 0
+/// at the end of the line
+bool CurrentRuleHasHigherPrecedence(const CFGRule& rule, GrammarSymbol lookaheadSymbol, int lookaheadPrecedence)
+{
+    if(lookaheadSymbol != NoGrammarSymbol)
     {
-        auto symb = lookaheadToken->Content;
-        if(rule.HasHigherPrecedenceClassOverride && rule.HigherPrecedenceClass.Contains(symb))
+        if(rule.HasHigherPrecedenceClassOverride && SymbolsContain(rule.HigherPrecedenceSymbols, lookaheadSymbol))
             return false;
 
-        if(rule.HasLowerPrecedenceClassOverride && rule.LowerPrecedenceClass.Contains(symb))
+        if(rule.HasLowerPrecedenceClassOverride && SymbolsContain(rule.LowerPrecedenceSymbols, lookaheadSymbol))
             return true;
     }
 
-
     int currentRulePrecedence = rule.Precedence;
-    int lookaheadPrecedence = PrecedenceOf(lookaheadToken);
     return (currentRulePrecedence >= lookaheadPrecedence);
 }
 
@@ -402,13 +435,19 @@ bool CurrentRuleHasHigherPrecedence(CFGRule& rule, Token* lookaheadToken)
 /// the list. continue doing so until no rules match
 void TryReversingGrammarRules(ParseToken** listHead, ParseToken** listTail, Token* lookaheadToken)
 {
-    CFGRule match;
+    GrammarSymbol lookaheadSymbol = NoGrammarSymbol;
+    int lookaheadPrecedence = 0;
+    if(lookaheadToken != nullptr)
+    {
+        lookaheadSymbol = GrammarSymbolOf(lookaheadToken->Content);
+        lookaheadPrecedence = PrecedenceOfSymbol(lookaheadSymbol);
+    }
 
-    while(MatchGrammarPatterns(*listHead, *listTail, match))
+    while(const CFGRule* match = MatchGrammarPatterns(*listTail))
     {
-        if(CurrentRuleHasHigherPrecedence(match, lookaheadToken))
+        if(CurrentRuleHasHigherPrecedence(*match, lookaheadSymbol, lookaheadPrecedence))
         {
-            CollapseListByRule(listHead, listTail, match);
+            CollapseListByRule(listHead, listTail, *match);
         }
         else
         {
@@ -463,7 +502,9 @@ bool PositionMatchesPreprocessorRule(TokenList& list, size_t startPos, Preproces
     return false;
 }
 
-TokenList Preprocess(TokenList& list)
+/// returns [list] with each match of a PreprocessorRule replaced by a single token, which is allocated in
+/// [arena]
+TokenList Preprocess(TokenList& list, TokenArena& arena)
 {
     TokenList processedList;
     int newListIndex = 0;
@@ -472,9 +513,7 @@ TokenList Preprocess(TokenList& list)
         PreprocessorRule* rule = nullptr;
         if(PositionMatchesPreprocessorRule(list, i, &rule))
         {
-            Token* t = new Token;
-            *t = { TokenType::Simple, rule->Becomes, newListIndex };
-            processedList.push_back(t);
+            processedList.push_back(TokenConstructor(arena, TokenType::Simple, rule->Becomes, newListIndex));
             i += rule->Pattern.size() - 1;
         }
         else
@@ -490,12 +529,13 @@ TokenList Preprocess(TokenList& list)
     return processedList;
 }
 
-Operation* ExpressionParser(TokenList& rawline)
+Operation* ParseExpression(TokenList& rawline, bool& isSyntaxError)
 {
     ParseToken* listHead = nullptr;
     ParseToken* listTail = nullptr;
 
-    TokenList line = Preprocess(rawline);
+    TokenArena preprocessedTokens;
+    TokenList line = Preprocess(rawline, preprocessedTokens);
     LogDiagnostics(line);
 
     int pos = 0;
@@ -516,11 +556,10 @@ Operation* ExpressionParser(TokenList& rawline)
     }
 
     // if the line could not be parsed
-    if(listHead != listTail)
+    if(listHead != listTail || listHead == nullptr)
     {
         DestroyList(listHead);
-        ReportCompileMsg(SystemMessageType::Exception, "syntax error");
-        FatalCompileError = true;
+        isSyntaxError = true;
         return nullptr;
     }
 
@@ -528,6 +567,20 @@ Operation* ExpressionParser(TokenList& rawline)
     auto ast = listHead->Value;
     DestroyList(listHead);
 
+    isSyntaxError = false;
+    return ast;
+}
+
+Operation* ExpressionParser(TokenList& rawline)
+{
+    bool isSyntaxError = false;
+    Operation* ast = ParseExpression(rawline, isSyntaxError);
+    if(isSyntaxError)
+    {
+        ReportCompileMsg(SystemMessageType::Exception, "syntax error");
+        FatalCompileError = true;
+    }
+
     return ast;
 }
 
@@ -535,4 +588,5 @@ void InitParser()
 {
     ConstantPrimitiveObjects.clear();
     ConstantPrimitiveObjects.reserve(64);
+    ConstantPrimitiveIndex.clear();
 }
\ No newline at end of file
@@ -5,31 +5,53 @@
 #include <vector>
 
 #include "abstract.h"
+#include "grammar.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Struct definitions
 
 /// a parsetoken is the evoled from of a token from the tokenizer (token.cpp) which contains additional meta
 /// information and a fragment of the AST of Operations
-/// [TokenType] is a string describing the the token in terms of its ProductionVariable
+/// [Symbol] is the interned symbol describing the the token in terms of its ProductionVariable
 /// [Value] is the fragment of the operation tree 
 /// [Next] is the next ParseToken in the partially parsed line
 /// [Prev] is the previous ParseToken in the partially parsed line
 struct ParseToken
 {
-    String TokenType;
+    GrammarSymbol Symbol;
     Operation* Value;
     ParseToken* Next = nullptr;
     ParseToken* Prev = nullptr;
 }; 
 
+/// a primitive token whose constant object is bound after its line is parsed
+/// [Ref] is the Reference of the token's Ref operation
+/// [Value] is the token
+struct DeferredConstant
+{
+    Reference* Ref;
+    Token* Value;
+};
+
 extern std::vector<Object*> ConstantPrimitiveObjects;
 
+/// if not nullptr, primitive tokens parsed by this thread are added to it instead of being bound to
+/// ConstantPrimitiveObjects, so lines can be parsed on several threads at once
+extern thread_local std::vector<DeferredConstant>* DeferredConstants;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Methods
 
 /// parses a [line] of code into an AST of Operations
 Operation* ExpressionParser(TokenList& line);
+
+/// parses a [line] of code into an AST of Operations without reporting errors, so it may run on any thread.
+/// sets [isSyntaxError] if the line cannot be parsed
+Operation* ParseExpression(TokenList& line, bool& isSyntaxError);
+
+/// binds the Reference of each of [constants] to its constant object, in order
+void BindDeferredConstants(const std::vector<DeferredConstant>& constants);
+
 void InitParser();
 
 #endif
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cctype>
 #include <fstream>
+#include <iterator>
 
 #include "token.h"
 
@@ -16,249 +17,241 @@
 // TODO:
 // 1. Match boolean tokens in any case (i.e. TRUE, FaLsE)
 
-Token* TokenConstructor(TokenType type, String content, int number)
-{
-    Token* t = new Token { type, content, number };
-    return t;
-}
 
-void TokenDestructor(Token* t)
-{
-    delete t;
-}
+// ---------------------------------------------------------------------------------------------------------------------
+// Token arena
 
-void DeleteTokenList(TokenList tokenList)
+Token* TokenConstructor(TokenArena& arena, TokenType type, std::string_view content, int position)
 {
-    for(auto t: tokenList)
+    if(arena.Used == TokenArenaBlockSize)
     {
-        TokenDestructor(t);
+        arena.Blocks.emplace_back(new Token[TokenArenaBlockSize]);
+        arena.Used = 0;
     }
+
+    Token* t = &arena.Blocks.back()[arena.Used++];
+    *t = { type, content, position };
+    return t;
 }
 
-void SkipWhiteSpace(const std::string& line, size_t& position)
+void ClearTokenArena(TokenArena& arena)
 {
-    for(; position < line.size() && line.at(position) == ' '; position++);
+    if(arena.Blocks.size() > 1)
+        arena.Blocks.resize(1);
+
+    arena.Used = arena.Blocks.empty() ? TokenArenaBlockSize : 0;
 }
 
-bool IsInteger(const std::string& tokenString)
+void MoveTokenArena(TokenArena& into, TokenArena& from)
 {
-    for(size_t i=0; i<tokenString.size(); i++)
+    if(into.Blocks.empty())
     {
-        if(!std::isdigit(tokenString.at(i)))
-            return false;
+        into.Blocks.swap(from.Blocks);
+        into.Used = from.Used;
     }
-    return true;
-}
-
-bool IsDecimal(const std::string& tokenString)
-{
-    bool foundDecimalPointAlready = false;
-    for(size_t i=0; i<tokenString.size(); i++)
+    else
     {
-        if(!std::isdigit(tokenString.at(i)))
-        {
-            if(tokenString.at(i) == '.')
-            {
-                if(foundDecimalPointAlready)
-                    return false;
-                foundDecimalPointAlready = true;
-            }
-            else
-            {
-                return false;
-            }
-            
-        }
+        // the blocks go before the last block of [into], so its unused tokens are still allocated next
+        auto last = into.Blocks.end() - 1;
+        into.Blocks.insert(last, std::make_move_iterator(from.Blocks.begin()), std::make_move_iterator(from.Blocks.end()));
     }
-    return true;
-}
 
-bool IsString(const std::string& tokenString)
-{
-    return tokenString.at(0) == '"' && tokenString.at(tokenString.size()-1) == '"';
+    from.Blocks.clear();
+    from.Used = TokenArenaBlockSize;
 }
 
-std::string ToLowerCase(const std::string& str)
-{
-    std::string lowerCaseStr = "";
-    for(size_t i=0; i<str.size(); i++)
-    {
-        lowerCaseStr += std::tolower(str.at(i));
-    }
-    return lowerCaseStr;
-}
 
-bool IsBoolean(const std::string& tokenString)
-{
-    return ToLowerCase(tokenString) == "true" || ToLowerCase(tokenString) == "false";
-}
+// ---------------------------------------------------------------------------------------------------------------------
+// Character classes
 
-bool IsReference(const std::string& tokenString)
+/// flags of the CharClasses table which classify each character for the lexer
+enum CharClass : unsigned char
 {
-    return (tokenString.at(0) >= 65 && tokenString.at(0) <= 90);
-}
+    CharSpace = 1,                  // separates tokens
+    CharSingleton = 2,              // is a token on its own
+    CharDoubleStart = 4,            // may start a two character token
+    CharDigit = 8,
+    CharQuote = 16,                 // starts a string
+};
 
-TokenType TypeOfTokenString(const std::string& tokenString)
-{
-    if(IsInteger(tokenString))
-    {
-        return TokenType::Integer;
-    }
-    else if(IsDecimal(tokenString))
-    {
-        return TokenType::Decimal;
-    }
-    else if(IsString(tokenString))
-    {
-        return TokenType::String;
-    }
-    else if(IsBoolean(tokenString))
-    {
-        return TokenType::Boolean;
-    }
-    else if(IsReference(tokenString))
-    {
-        return TokenType::Reference;
-    }
-    else
-    {
-        return TokenType::Simple;
-    }
-    
-}
+const String SingletonChars = "!@#$%^*()-+=[]{}\\:;<>,./?~`&|";
+const String DoubledChars = "&&||==!=>=<='s";
 
-const String StringStartChars = "\"'";
 const char DecimalPoint = '.';
-const String SingletonChars = "!@#$%^*()-+=[]{}\\:;<>,./?~`&|";
-const String DoubledChars = "&&||==!=>=<=" "'s";
+const char CommentChar = '#';
 
-bool IsSingleTonChar(char c)
+/// returns the table of the CharClass flags of every character
+std::vector<unsigned char> CharClassTable()
 {
-    for(size_t i=0; i<SingletonChars.size(); i++)
-        if(c == SingletonChars.at(i))
-            return true;
+    std::vector<unsigned char> table(256, 0);
+    table[static_cast<unsigned char>(' ')] |= CharSpace;
+    table[static_cast<unsigned char>('"')] |= CharQuote;
 
-    return false;
+    for(char c: SingletonChars)
+        table[static_cast<unsigned char>(c)] |= CharSingleton;
+
+    for(size_t i=0; i<DoubledChars.size(); i+=2)
+        table[static_cast<unsigned char>(DoubledChars[i])] |= CharDoubleStart;
+
+    for(char c='0'; c<='9'; c++)
+        table[static_cast<unsigned char>(c)] |= CharDigit;
+
+    return table;
+}
+
+const std::vector<unsigned char> CharClasses = CharClassTable();
+
+inline bool CharIs(char c, CharClass charClass)
+{
+    return CharClasses[static_cast<unsigned char>(c)] & charClass;
 }
 
-Token* GetSingletonCharToken(const String& line, size_t& position, int tokenNumber)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Lexing
+
+std::string ToLowerCase(const std::string& str)
 {
-    String tokenString = "";
-    tokenString += line.at(position++);
-    return TokenConstructor(TokenType::Simple, tokenString, tokenNumber);
+    std::string lowerCaseStr = "";
+    for(size_t i=0; i<str.size(); i++)
+    {
+        lowerCaseStr += std::tolower(str.at(i));
+    }
+    return lowerCaseStr;
 }
 
-bool IsDoubleCharToken(size_t& position, const String& line)
+bool IsDoubleCharToken(std::string_view line, size_t position)
 {
-    if(position + 1 >= line.size())
+    if(position + 1 >= line.size() || !CharIs(line[position], CharDoubleStart))
         return false;
     
     for(size_t i=0; i<DoubledChars.size(); i+=2)
     {
-        if(line.at(position) == DoubledChars.at(i) && line.at(position+1) == DoubledChars.at(i+1))
+        if(line[position] == DoubledChars[i] && line[position+1] == DoubledChars[i+1])
             return true;
     }
 
     return false;
 }
 
-Token* GetDoubleCharToken(const String& line, size_t& position, int tokenNumber)
+bool IsActuallyDecimalPoint(std::string_view line, size_t position)
 {
-    String tokenString = "";
-    tokenString += line.at(position);
-    tokenString += line.at(position+1);
-    position += 2;
-    
-    return TokenConstructor(TokenType::Simple, tokenString, tokenNumber);
+    return (position > 0 && CharIs(line[position-1], CharDigit)) &&
+        (position + 1 < line.size() && CharIs(line[position+1], CharDigit));
 }
 
-bool IsStringStartChar(char c)
+/// returns true if [word] is true or false in any case
+bool IsBoolean(std::string_view word)
 {
-    return c == '"';
+    if(word.size() != 4 && word.size() != 5)
+        return false;
+
+    String lowerCaseWord = ToLowerCase(String(word));
+    return lowerCaseWord == "true" || lowerCaseWord == "false";
 }
 
-Token* GetStringToken(const String& line, size_t& position, int tokenNumber)
+/// returns the TokenType of [word], which has [numberOfDigits] digits and [numberOfPoints] decimal points
+TokenType TypeOfWord(std::string_view word, size_t numberOfDigits, size_t numberOfPoints)
 {
-    String tokenString;
-    while(++position < line.size() && line.at(position) != '"')
+    if(numberOfDigits == word.size())
     {
-        tokenString += line.at(position);
+        return TokenType::Integer;
     }
-    position++; // get rid of end quote
-    return TokenConstructor(TokenType::String, tokenString, tokenNumber);
-}
-
-
-bool IsNumericChar(char c)
-{
-    return 48 <= static_cast<int>(c) && 57 >= static_cast<int>(c);
-}
-
-bool IsActuallyDecimalPoint(const size_t& position, const String& line)
-{
-    return (position > 0 && IsNumericChar(line.at(position-1))) &&
-        (position + 1 < line.size() && IsNumericChar(line.at(position+1)));
-}
-
-Token* GetToken(const std::string& line, size_t& position, int tokenNumber)
-{
-
-    SkipWhiteSpace(line, position);
-    if(position >= line.size())
-        return nullptr;
-
-
-    // special case for string
-    if(IsStringStartChar(line.at(position)))
+    else if(numberOfDigits + numberOfPoints == word.size() && numberOfPoints == 1)
     {
-        return GetStringToken(line, position, tokenNumber);
+        return TokenType::Decimal;
     }
-    else if(IsDoubleCharToken(position, line))
+    else if(IsBoolean(word))
     {
-        return GetDoubleCharToken(line, position, tokenNumber);
+        return TokenType::Boolean;
     }
-    else if(IsSingleTonChar(line.at(position)))
+    else if(word[0] >= 'A' && word[0] <= 'Z')
     {
-        return GetSingletonCharToken(line, position, tokenNumber);
+        return TokenType::Reference;
     }
+    else
+    {
+        return TokenType::Simple;
+    }
+}
 
-    Token* token;
-    std::string tokenString = "";
-
-    for(; position < line.size() && line.at(position) != ' '; position++)
+/// returns the end of the word starting at [position], which runs until a space or a token which is
+/// not part of a word. counts the digits and decimal points of the word
+size_t EndOfWord(std::string_view line, size_t position, size_t& numberOfDigits, size_t& numberOfPoints)
+{
+    for(; position < line.size() && !CharIs(line[position], CharSpace); position++)
     {
-        if(line.at(position) != DecimalPoint && (IsSingleTonChar(line.at(position)) || IsDoubleCharToken(position, line)))
-            break;
-        else if(line.at(position) == DecimalPoint)
+        char c = line[position];
+        if(c == DecimalPoint)
         {
-            if(!IsActuallyDecimalPoint(position, line))
+            if(!IsActuallyDecimalPoint(line, position))
                 break;
+            numberOfPoints++;
+        }
+        else if(CharIs(c, CharSingleton) || IsDoubleCharToken(line, position))
+        {
+            break;
+        }
+        else if(CharIs(c, CharDigit))
+        {
+            numberOfDigits++;
         }
-        tokenString += line.at(position);    
     }
 
-    if(tokenString == "")
-        return nullptr;
-    
-    token = TokenConstructor(TypeOfTokenString(tokenString), tokenString, tokenNumber);
-
-    return token;
+    return position;
 }
 
-
-TokenList LexLine(const std::string& line)
+TokenList LexLine(std::string_view line, TokenArena& arena)
 {
     TokenList tokens;
-    size_t linePosition = 0;
+    size_t position = 0;
     int tokenNumber = 0;
-    while(linePosition < line.size())
+    while(true)
     {
-        Token* t = GetToken(line, linePosition, tokenNumber);
-        if(t == nullptr)
-            continue;
+        for(; position < line.size() && CharIs(line[position], CharSpace); position++);
+        if(position >= line.size())
+            break;
+
+        char c = line[position];
+        std::string_view content;
+        TokenType type = TokenType::Simple;
+
+        if(CharIs(c, CharQuote))
+        {
+            // strings run until the closing quote, or the end of the line
+            size_t end = line.find('"', position + 1);
+            if(end == std::string_view::npos)
+                end = line.size();
+
+            content = line.substr(position + 1, end - position - 1);
+            type = TokenType::String;
+            position = end + 1;
+        }
+        else if(IsDoubleCharToken(line, position))
+        {
+            content = line.substr(position, 2);
+            position += 2;
+        }
+        else if(CharIs(c, CharSingleton))
+        {
+            if(c == CommentChar)
+                break;
+
+            content = line.substr(position, 1);
+            position++;
+        }
+        else
+        {
+            size_t numberOfDigits = 0;
+            size_t numberOfPoints = 0;
+            size_t end = EndOfWord(line, position, numberOfDigits, numberOfPoints);
+
+            content = line.substr(position, end - position);
+            type = TypeOfWord(content, numberOfDigits, numberOfPoints);
+            position = end;
+        }
 
-        tokens.push_back(t);
-        tokenNumber++;
+        tokens.push_back(TokenConstructor(arena, type, content, tokenNumber++));
     }
 
     return tokens;
@@ -306,7 +299,7 @@ bool SameLetterOrChar(char c1, char c2)
     return std::toupper(c1) == std::toupper(c2);
 }
 
-bool StringCaseInsensitiveEquals(const std::string& str1, const std::string& str2)
+bool StringCaseInsensitiveEquals(std::string_view str1, std::string_view str2)
 {
     if(str1.size() != str2.size())
         return false;
@@ -320,7 +313,7 @@ bool StringCaseInsensitiveEquals(const std::string& str1, const std::string& str
     return true;
 }
 
-Token* FindToken(const TokenList& tokens, std::string str)
+Token* FindToken(const TokenList& tokens, std::string_view str)
 {
     for(Token* t: tokens)
     {
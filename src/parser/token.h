@@ -1,6 +1,9 @@
 #ifndef __TOKEN_H
 #define __TOKEN_H
 
+#include <memory>
+#include <string_view>
+
 #include "abstract.h"
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -19,15 +22,28 @@ enum class TokenType
 
 /// a token contains information about chunks of parsed string including
 /// [Type] describing the token's TokenType
-/// [Content] being the string bit it refers to
+/// [Content] being the string bit it refers to, which views the lexed line
 /// [Position] what position in a line does the token occur
 struct Token
 {
     TokenType Type;
-    String Content;
+    std::string_view Content;
     int Position;
 };
 
+/// number of tokens in each block of a TokenArena
+constexpr size_t TokenArenaBlockSize = 1024;
+
+/// a TokenArena owns tokens in blocks of TokenArenaBlockSize, so lexing does not
+/// allocate each token on its own and every token is freed with the arena
+/// [Blocks] are the blocks of tokens
+/// [Used] is the number of tokens used in the last block
+struct TokenArena
+{
+    std::vector<std::unique_ptr<Token[]>> Blocks;
+    size_t Used = TokenArenaBlockSize;
+};
+
 /// a list of TokenTypes which represent primitive objects
 const std::vector<TokenType> PrimitiveTokenTypes {
     TokenType::Integer,
@@ -51,21 +67,27 @@ typedef std::vector<Token*> TokenList;
 // ---------------------------------------------------------------------------------------------------------------------
 // Methods
 
-void DeleteTokenList(TokenList tokenList);
+/// returns a new token in [arena]
+Token* TokenConstructor(TokenArena& arena, TokenType type, std::string_view content, int position);
+
+/// frees every token of [arena], keeping its first block to reuse
+void ClearTokenArena(TokenArena& arena);
 
-void TokenDestructor(Token* t);
+/// moves every token of [from] into [into], leaving [from] empty
+void MoveTokenArena(TokenArena& into, TokenArena& from);
 
 /// returns a new string with each character of [str] changed to lowercase
 String ToLowerCase(const String& str);
 
-// takes in a single line (no newlines) and returns a list of tokens representing the line
-TokenList LexLine(const String& line);
+/// takes in a single line (no newlines) and returns a list of tokens representing the line, which are
+/// allocated in [arena] and view [line]. the line ends at a # comment
+TokenList LexLine(std::string_view line, TokenArena& arena);
 
 // returns the string value for a category of the enum class TokenType
 String GetStringTokenType(TokenType type);
 
 // finds a token with token-Content equal to [str] in a list [tokens]
-Token* FindToken(const TokenList& tokens, std::string str);
+Token* FindToken(const TokenList& tokens, std::string_view str);
 
 // returns a new TokenList containing all tokens to the left of [token], not including [token],
 // and renumbered to begin at 0
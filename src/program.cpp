@@ -2,6 +2,11 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "main.h"
 #include "program.h"
@@ -77,8 +82,10 @@ void Reset()
 Program* ProgramConstructor()
 {
     Program* p = new Program;
-    p->GlobalScope = ScopeConstructor(nullptr);
+    p->GlobalScope = ScopeConstructor(p->ScopeSlab, nullptr);
     p->GlobalScope->IsDurable = true;
+    p->Main = nullptr;
+    p->That = nullptr;
 
     return p;
 }
@@ -111,160 +118,79 @@ String RemoveCommas(String line)
     return returnString;
 }
 
-TokenList RemoveComment(TokenList tokens)
-{
-    TokenList tokensNoComments;
-    bool foundComment = false; 
-    for (size_t i = 0; i < tokens.size(); i++)
-    { 
-        if (tokens.at(i)->Content != "#" && !foundComment) 
-        {
-            tokensNoComments.push_back(tokens.at(i));
-        } 
-        else if (tokens.at(i)->Content != "#" && foundComment)
-        {
-            TokenDestructor(tokens.at(i));
-        } 
-        else if (tokens.at(i)->Content == "#") 
-        {
-            foundComment = true;
-            TokenDestructor(tokens.at(i));
-        }
-    }  
-    return tokensNoComments;
-}
-
+/// the indentation of the first indented line, which is one level of indentation
 String g_tabString;
 
-bool TabStringIsSet()
-{
-    return g_tabString.size() > 0;
-}
-
-void SetTabString(String str)
-{
-    if(str.size() == 0)
-        return;
-    if(TabStringIsSet())
-        return;
-
-    g_tabString = str;
-}
-
 bool IsTabCharacter(char c)
 {
     return c == '\t' || c == ' ';
 }
 
-String DecideTabString(String line)
+/// returns the level of a line starting with [indentation] or -1 if malformed, ie. if it is not made of
+/// g_tabStrings
+int LevelOfIndentation(std::string_view indentation)
 {
-    String tabString;
-    tabString.reserve(8);
-
-    for(size_t i =0; i < line.size() && IsTabCharacter(line.at(i)); i++)
-        tabString += line.at(i);
-    
-    return tabString;
-}
-
-/// returns the level of the line or -1 if malformed
-int LevelOfLine(String line)
-{
-    if(line.size() == 0)
-        return -1;
-    if(!IsTabCharacter(line.at(0)))
+    if(indentation.empty())
         return 0;
 
     // if some spacing exists but the tabString is not set, the code is malformed
-    if(g_tabString.size() == 0)
+    if(g_tabString.empty() || indentation.size() % g_tabString.size() != 0)
         return -1;
 
-    int level=0;
-    size_t i=0;
-    while(static_cast<size_t>(level) < line.size())
+    for(size_t i=0; i<indentation.size(); i+=g_tabString.size())
     {
-        for(size_t j=0; j<g_tabString.size() && i<line.size(); j++, i++)
-        {
-            if(g_tabString.at(j) != line.at(i)){
-                return -1;
-            }
-        }
-        level++;
-        if(!IsTabCharacter(line.at(i)))
-            return level;
+        if(indentation.compare(i, g_tabString.size(), g_tabString) != 0)
+            return -1;
     }
-    return -1;
-}
 
-inline const std::string SpaceChars = " \n\t";
-
-bool CharIsWhiteSpace(char c)
-{
-    for(size_t i=0; i<SpaceChars.size(); i++)
-    {
-        if(c == SpaceChars[i])
-            return true;
-    }
-    return false;
+    return indentation.size() / g_tabString.size();
 }
 
-bool LineIsWhitespace(std::string& line)
+/// an effective line of source, ie. one which is neither whitespace nor a comment
+/// [Text] views the line in the source
+/// [LineNumber] is the number of the line, counting from 1
+/// [Level] is the indent level of the line or -1 if malformed
+struct SourceLine
 {
-    for(size_t i =0; i<line.size(); i++)
-    {
-        if(!CharIsWhiteSpace(line[i]))
-            return false;
-    }
-    return true;
-}
-
-bool LineIsComment(std::string &line)
+    std::string_view Text;
+    int LineNumber;
+    int Level;
+};
+
+/// returns the effective lines of [source], found in a single pass. the end of each line is found with
+/// memchr, which the c library vectorises, and only the indentation of each line is read to skip lines of
+/// whitespace and comments and to find its level
+std::vector<SourceLine> ScanSourceLines(std::string_view source)
 {
-    size_t i = 0;
-    while (i < line.size())
+    std::vector<SourceLine> lines;
+    int lineNumber = 0;
+    size_t position = 0;
+    while(position < source.size())
     {
-        if (!CharIsWhiteSpace(line.at(i)))
-            break;
-        i++;
-    }    
-    return line[i] == '#' ? true : false;
-}
+        auto start = source.data() + position;
+        auto end = static_cast<const char*>(std::memchr(start, '\n', source.size() - position));
+        size_t length = end == nullptr ? source.size() - position : end - start;
 
-/// returns a line of code and sets lineNumber to that of the next line and lineStart to
-/// the starting position of the returned line. commas allow for a line to be split
-std::string GetEffectiveLine(std::fstream& file, int& lineNumber, int& lineStart)
-{
-    std::string fullLine = "";
-    std::string newLine;
-
-    bool FirstTime = true;
-    do
-    {
+        auto line = source.substr(position, length);
+        position += length + 1;
         lineNumber++;
-        if(!std::getline(file, newLine))
-            break;
 
-        /// skip lines of whitespace
-        if(LineIsWhitespace(newLine))
-            continue;
+        size_t indent = 0;
+        while(indent < line.size() && IsTabCharacter(line[indent]))
+            indent++;
 
-        if (LineIsComment(newLine))
+        if(indent == line.size() || line[indent] == '#')
             continue;
 
-        if(FirstTime)
-        {
-            lineStart = lineNumber - 1;
-            FirstTime = false;
-        }
-        fullLine += newLine;
-
-    } while (LineIsWhitespace(newLine) || LineIsComment(newLine));
+        auto indentation = line.substr(0, indent);
+        if(g_tabString.empty())
+            g_tabString = indentation;
 
-    if(!TabStringIsSet())
-        SetTabString(DecideTabString(newLine));
+        SourceLine sourceLine = { line, lineNumber, LevelOfIndentation(indentation) };
+        lines.push_back(sourceLine);
+    }
 
-    return fullLine;
-    // return RemoveCommas(fullLine);
+    return lines;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -424,7 +350,10 @@ Block* ParseBlock(
             int blockSize = SizeOfBlock(it, end);
             Block* b = ParseBlock(it, it+blockSize);
             if(FatalCompileError)
+            {
+                DeleteBlockRecursive(thisBlock);
                 return nullptr;
+            }
             LogItDebug(Msg("finishes compile new block at line [%i]", it->LineNumber), "ParseBlock");
 
             // increment iterator to end of block
@@ -435,10 +364,13 @@ Block* ParseBlock(
         else
         {
             LogItDebug(Msg("starting compile line [%i]", it->LineNumber), "ParseBlock");
-            Operation* op = ParseLine(it->Tokens);
+            Operation* op = it->Parsed != nullptr ? it->Parsed : ParseLine(it->Tokens);
             HandleCompileMessage(it->LineNumber);
             if(FatalCompileError)
+            {
+                DeleteBlockRecursive(thisBlock);
                 return nullptr;
+            }
 
             NumberOperation(op, it->LineNumber);
             LogItDebug(Msg("finishes compile line [%i]", it->LineNumber), "ParseBlock");
@@ -450,39 +382,131 @@ Block* ParseBlock(
     return thisBlock;
 }
 
-Program* ParseProgram(const std::string filepath)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Parallel parsing
+//
+// the lines of a long program are lexed and parsed on several threads before ParseBlock assembles them into
+// blocks in order. lines are handed out in chunks, and each worker lexes into its own TokenArena. workers do
+// not touch the shared parser state: the constants of each chunk are bound once every worker has finished,
+// in the order of the lines, and lines which fail to parse are parsed again by ParseBlock, so any error is
+// reported as it would be without threads
+
+int g_parseThreads = 0;
+
+/// the number of lines handed to a worker at once
+constexpr size_t LinesPerParseChunk = 64;
+
+/// the number of lines worth starting another thread for, when g_parseThreads is 0
+constexpr size_t MinLinesPerParseThread = 2048;
+
+/// returns the number of threads to parse [numberOfLines] lines with
+size_t NumberOfParseThreads(size_t numberOfLines)
 {
-    InitParser();
-    g_tabString.clear();
-    
-    Program* p = ProgramConstructor();
+    // the parser logs from whichever thread runs it, so logged runs keep to one thread
+    if(LogAtLevel <= LogSeverityType::Sev1_Notify)
+        return 1;
 
-    std::fstream file;
-    file.open(filepath, std::ios::in);
-    if(!file.is_open())
+    size_t numberOfChunks = (numberOfLines + LinesPerParseChunk - 1) / LinesPerParseChunk;
+    size_t threads = g_parseThreads;
+    if(threads == 0)
+    {
+        threads = std::min<size_t>(std::thread::hardware_concurrency(), numberOfLines / MinLinesPerParseThread);
+    }
+
+    return std::max<size_t>(1, std::min(threads, numberOfChunks));
+}
+
+/// parses [tokens] on a worker. returns nullptr if the line must be parsed again by ParseBlock to report
+/// its error
+Operation* ParseLineOnWorker(TokenList& tokens)
+{
+    try
+    {
+        bool isSyntaxError = false;
+        return ParseExpression(tokens, isSyntaxError);
+    }
+    catch(const std::exception&)
     {
-        std::cout << "\ncould not open file: " << filepath << std::endl;
         return nullptr;
     }
+}
+
+/// lexes and parses [lines] into the Lines of [p] on [threads] threads, including this one
+void ParseLinesInParallel(Program* p, const std::vector<SourceLine>& lines, size_t threads)
+{
+    size_t numberOfChunks = (lines.size() + LinesPerParseChunk - 1) / LinesPerParseChunk;
+    std::vector<std::vector<DeferredConstant>> constants(numberOfChunks);
+    std::vector<TokenArena> arenas(threads);
+    std::atomic<size_t> nextChunk(0);
+
+    p->Lines.resize(lines.size());
+
+    auto parseChunks = [&](size_t worker)
+    {
+        for(size_t chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+        {
+            DeferredConstants = &constants[chunk];
+
+            size_t end = std::min(lines.size(), (chunk + 1) * LinesPerParseChunk);
+            for(size_t i = chunk * LinesPerParseChunk; i < end; i++)
+            {
+                auto& codeLine = p->Lines[i];
+                codeLine.Tokens = LexLine(lines[i].Text, arenas[worker]);
+                codeLine.LineNumber = lines[i].LineNumber;
+                codeLine.Level = lines[i].Level;
+                codeLine.Parsed = ParseLineOnWorker(codeLine.Tokens);
+            }
+
+            DeferredConstants = nullptr;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(size_t worker=1; worker<threads; worker++)
+    {
+        workers.emplace_back(parseChunks, worker);
+    }
+    parseChunks(0);
 
-    int lineLevel = 0;
-    int nextLinePos = 1;
-    int lineStart = 1;
+    for(auto& worker: workers)
+    {
+        worker.join();
+    }
 
-    for(std::string line = GetEffectiveLine(file, nextLinePos, lineStart); line != ""; line = GetEffectiveLine(file, nextLinePos, lineStart))
+    for(auto& arena: arenas)
     {
-        // std::string removed = RemoveComment(line);
-        TokenList tokens = LexLine(line);
-        TokenList noComments = RemoveComment(tokens);
-        lineLevel = LevelOfLine(line);
+        MoveTokenArena(p->Tokens, arena);
+    }
 
-        CodeLine ls = { noComments , lineStart, lineLevel };
-        p->Lines.push_back(ls);
+    for(auto& chunkConstants: constants)
+    {
+        BindDeferredConstants(chunkConstants);
+    }
+}
 
+/// lexes and parses the Source of [p]. returns nullptr if it has no lines
+Program* ParseSourceOf(Program* p)
+{
+    auto lines = ScanSourceLines(ViewOf(p->Source));
+    size_t threads = NumberOfParseThreads(lines.size());
+    if(threads > 1)
+    {
+        ParseLinesInParallel(p, lines, threads);
+    }
+    else
+    {
+        p->Lines.reserve(lines.size());
+        for(auto& line: lines)
+        {
+            CodeLine codeLine = { LexLine(line.Text, p->Tokens), line.LineNumber, line.Level };
+            p->Lines.push_back(codeLine);
+        }
     }
 
     if(p->Lines.empty())
     {
+        ProgramDestructor(p);
         return nullptr;
     }
 
@@ -493,16 +517,45 @@ Program* ParseProgram(const std::string filepath)
     return p;
 }
 
-void ProgramDestructor(Program* p)
+Program* ParseProgram(const std::string filepath)
+{
+    InitParser();
+    g_tabString.clear();
+    
+    Program* p = ProgramConstructor();
+
+    if(!OpenMappedFile(filepath, p->Source))
+    {
+        std::cout << "\ncould not open file: " << filepath << std::endl;
+        return nullptr;
+    }
+
+    return ParseSourceOf(p);
+}
+
+Program* ParseProgramSource(const std::string& source)
 {
-    ScopeDestructor(p->GlobalScope);
+    InitParser();
+    g_tabString.clear();
+
+    Program* p = ProgramConstructor();
+    CopyIntoMappedFile(source, p->Source);
+
+    return ParseSourceOf(p);
+}
 
-    for(auto codeLine: p->Lines)
+void ProgramDestructor(Program* p)
+{
+    if(p->GlobalScope != nullptr)
     {
-        DeleteTokenList(codeLine.Tokens);
+        ScopeDestructor(p->ScopeSlab, p->GlobalScope);
     }
 
-    DeleteBlockRecursive(p->Main);
+    if(p->Main != nullptr)
+    {
+        DeleteBlockRecursive(p->Main);
+    }
+    CloseMappedFile(p->Source);
 
     delete p;
 }
\ No newline at end of file
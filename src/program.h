@@ -2,6 +2,9 @@
 #define __PROGRAM_H
 
 #include "abstract.h"
+#include "token.h"
+#include "mappedfile.h"
+#include "scope.h"
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -11,20 +14,28 @@
 /// [Tokens] are the tokens resulting from processing an effective line of code
 /// [LineNumber] is the line of code which was processed
 /// [Level] is the indent level of the line
+/// [Parsed] is the Operation tree of the line if it was parsed ahead of ParseBlock, or nullptr
 struct CodeLine
 {
     TokenList Tokens;
     int LineNumber;
     int Level;
+    Operation* Parsed = nullptr;
 };
 
 /// a structure which contains a runnable representation of Pebble code
+/// [Source] is the mapped text of the program, which the tokens of its lines view
+/// [Tokens] owns the tokens of its lines
 /// [Lines] are the 'raw' tokenized CodeLines of the program
 /// [GlobalScope] (possible deprecated) is the global scope of the program
+/// [ScopeSlab] stores the GlobalScope, which is the only scope the program owns
 /// [ObjectsIndex] contains all objects and their references during program execution
 struct Program
 {
+    MappedFile Source;
+    TokenArena Tokens;
     std::vector<CodeLine> Lines;
+    utils::Slab<Scope> ScopeSlab{ 1 };
     Scope* GlobalScope;
     Block* Main;
     Reference* That;
@@ -65,6 +76,13 @@ extern std::string ProgramMsgs;
 
 extern Program* PROGRAM;
 
+/// the number of threads which parse the lines of a program, or 0 for one for every core once a program
+/// is long enough to be worth it
+extern int g_parseThreads;
+
+/// returns the number of threads to parse [numberOfLines] lines with
+size_t NumberOfParseThreads(size_t numberOfLines);
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Method declarations
@@ -75,6 +93,9 @@ Operation* ParseLine(TokenList& tokens);
 Block* ParseBlock(std::vector<CodeLine>::iterator it, std::vector<CodeLine>::iterator end, Scope* scope=nullptr);
 Program* ParseProgram(const std::string filepath);
 
+/// parses the program held in [source]. returns nullptr if it has no lines
+Program* ParseProgramSource(const std::string& source);
+
 void ReportCompileMsg(SystemMessageType type, String message);
 void ReportRuntimeMsg(SystemMessageType type, String message);
 
@@ -3,16 +3,81 @@
 #include "reference.h"
 #include "call.h"
 #include "diagnostics.h"
+#include "utils.h"
 #include <iostream>
+#include <algorithm>
+#include <new>
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Call index
+
+CallIndex::CallIndex()
+    : Calls(InlineCalls), Size(0), Capacity(CallIndexInlineSize), Table(nullptr), TableCapacity(0)
+{
+}
+
+CallIndex::~CallIndex()
+{
+    if(Calls != InlineCalls)
+    {
+        delete[] Calls;
+    }
+    delete[] Table;
+}
+
+/// doubles the capacity of the index, moving the calls to the heap and building
+/// the hash table the first time the inline storage is outgrown
+void CallIndex::Grow()
+{
+    uint32_t newCapacity = Capacity * 2;
+    Call** newCalls = new Call*[newCapacity];
+    std::copy(Calls, Calls + Size, newCalls);
+
+    if(Calls != InlineCalls)
+    {
+        delete[] Calls;
+    }
+    Calls = newCalls;
+    Capacity = newCapacity;
+
+    /// keep the table at most half full
+    Rehash(newCapacity * 2);
+}
+
+/// rebuilds the hash table with [newTableCapacity] slots
+void CallIndex::Rehash(uint32_t newTableCapacity)
+{
+    delete[] Table;
+    Table = new Call*[newTableCapacity]();
+    TableCapacity = newTableCapacity;
+
+    for(uint32_t i=0; i<Size; i++)
+    {
+        InsertIntoTable(Calls[i]);
+    }
+}
+
+/// adds [call] to the hash table unless a call with the same name is already there
+void CallIndex::InsertIntoTable(Call* call)
+{
+    size_t i = SlotFor(call->Name);
+    for(; Table[i] != nullptr; i = (i + 1) & (TableCapacity - 1))
+    {
+        if(Table[i]->Name == call->Name)
+            return;
+    }
+    Table[i] = call;
+}
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructors
 
-/// create a new scope with [inheritedScope]. all new scopes should be created from this
-/// constructor method
-Scope* ScopeConstructor(Scope* inheritedScope)
+/// create a new scope from [slab] with [inheritedScope]. all new scopes should be created
+/// from this constructor method
+Scope* ScopeConstructor(utils::Slab<Scope>& slab, Scope* inheritedScope)
 {
-    Scope* s = new Scope;
+    Scope* s = new (slab.Allocate()) Scope;
     s->InheritedScope = inheritedScope;
     s->ReferencesIndex = {};
     s->IsDurable = false;
@@ -20,9 +85,27 @@ Scope* ScopeConstructor(Scope* inheritedScope)
     return s;
 }
 
-void ScopeDestructor(Scope* scope)
+void ScopeDestructor(utils::Slab<Scope>& slab, Scope* scope)
+{
+    scope->~Scope();
+    slab.Free(scope);
+}
+
+/// most runtime scopes hold only a few calls in the inline storage of their CallsIndex,
+/// so only the scopes whose vectors or table were allocated need their destructor run
+void ReleaseScopeStorage(Scope* scope)
+{
+    bool ownsStorage = scope->CallsIndex.AllocatedBytes() > 0 || scope->ReferencesIndex.capacity() > 0
+        || scope->Elements.capacity() > 0;
+    if(ownsStorage)
+    {
+        scope->~Scope();
+    }
+}
+
+void ReleaseAllScopes(utils::Slab<Scope>& slab)
 {
-    delete scope;
+    slab.Reset();
 }
 
 void AddReferenceToScope(Reference* ref, Scope* scope)
@@ -36,21 +119,33 @@ void AddCallToScope(Call* call, Scope* scope)
     scope->CallsIndex.push_back(call);
 }
 
-/// return a deep copy of [scp]
-Scope* CopyScope(Scope* scp)
+/// returns a new call from [slab] with the same name and bindings as [call]
+inline Call* CopyCallBindings(const Call* call, utils::Slab<Call>& slab)
 {
-    Scope* scpCopy = ScopeConstructor(scp->InheritedScope);
+    Call* callCopy = CallConstructor(slab, call->Name);
+    BindScope(callCopy, call->BoundScope);
+    BindSection(callCopy, call->BoundSection);
+    BindType(callCopy, call->BoundType);
+    EnforceCallType(callCopy, call->CallType);
+    callCopy->NumberOfParameters = call->NumberOfParameters;
+
+    return callCopy;
+}
+
+/// return a deep copy of [scp], with its calls allocated from [slab]
+Scope* CopyScope(Scope* scp, utils::Slab<Scope>& scopeSlab, utils::Slab<Call>& callSlab)
+{
+    Scope* scpCopy = ScopeConstructor(scopeSlab, scp->InheritedScope);
 
     for(auto call: scp->CallsIndex)
     {
-        Call* callCopy = CallConstructor(call->Name);
-        BindScope(callCopy, call->BoundScope);
-        BindSection(callCopy, call->BoundSection);
-        BindType(callCopy, call->BoundType);
-        EnforceCallType(callCopy, call->CallType);
-        callCopy->NumberOfParameters = call->NumberOfParameters;
-
-        AddCallToScope(callCopy, scpCopy);
+        AddCallToScope(CopyCallBindings(call, callSlab), scpCopy);
+    }
+
+    scpCopy->Elements.reserve(scp->Elements.size());
+    for(auto call: scp->Elements)
+    {
+        scpCopy->Elements.push_back(CopyCallBindings(call, callSlab));
     }
 
     return scpCopy;
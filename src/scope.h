@@ -2,12 +2,112 @@
 #define __SCOPE_H
 
 #include "abstract.h"
+#include "call.h"
 
 
 
 
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Call index
+
+/// number of calls a CallIndex stores without allocating
+constexpr uint32_t CallIndexInlineSize = 8;
+
+/// the calls of a scope, kept in the order they were added. small indexes are
+/// stored inline and searched linearly. once an index grows past
+/// CallIndexInlineSize, its calls move to the heap and lookups go through an
+/// open-addressed hash table keyed by the (interned) name pointer of each call.
+/// as with a linear search, the first call added with a given name is the one 
+/// which is found
+struct CallIndex
+{
+    CallIndex();
+    ~CallIndex();
+
+    CallIndex(const CallIndex&) = delete;
+    CallIndex& operator=(const CallIndex&) = delete;
+
+    /// add [call] to the end of the index
+    inline void push_back(Call* call)
+    {
+        if(Size == Capacity)
+        {
+            Grow();
+        }
+
+        Calls[Size++] = call;
+        if(Table != nullptr)
+        {
+            InsertIntoTable(call);
+        }
+    }
+
+    /// returns the first call added with [name] or nullptr if there is none
+    inline Call* Find(const String* name) const
+    {
+        if(Table == nullptr)
+        {
+            for(uint32_t i=0; i<Size; i++)
+            {
+                if(Calls[i]->Name == name)
+                    return Calls[i];
+            }
+            return nullptr;
+        }
+
+        for(size_t i=SlotFor(name); Table[i] != nullptr; i = (i + 1) & (TableCapacity - 1))
+        {
+            if(Table[i]->Name == name)
+                return Table[i];
+        }
+        return nullptr;
+    }
+
+    inline Call* operator[](size_t i) const { return Calls[i]; }
+    inline size_t size() const { return Size; }
+    inline bool empty() const { return Size == 0; }
+
+    inline Call** begin() const { return Calls; }
+    inline Call** end() const { return Calls + Size; }
+
+    /// number of bytes the index has allocated on the heap
+    inline size_t AllocatedBytes() const
+    {
+        size_t bytes = TableCapacity * sizeof(Call*);
+        if(Calls != InlineCalls)
+        {
+            bytes += Capacity * sizeof(Call*);
+        }
+        return bytes;
+    }
+
+    private:
+    Call** Calls;
+    uint32_t Size;
+    uint32_t Capacity;
+
+    /// open-addressed hash table of the calls, or nullptr while the index is small
+    Call** Table;
+    uint32_t TableCapacity;
+
+    Call* InlineCalls[CallIndexInlineSize];
+
+    /// index in Table where the search for [name] starts
+    inline size_t SlotFor(const String* name) const
+    {
+        /// fibonacci hashing of the pointer, ignoring alignment bits
+        uint64_t h = (reinterpret_cast<uintptr_t>(name) >> 3) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32) & (TableCapacity - 1);
+    }
+
+    void Grow();
+    void Rehash(uint32_t newTableCapacity);
+    void InsertIntoTable(Call* call);
+};
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Struct definitions
 
@@ -15,6 +115,8 @@
 /// and add new references.
 /// [ReferencesIndex] contains all references available in the scope
 /// [InheritedScope] is a link to the parent scope and to inherited references
+/// [Elements] holds the element calls of an array in index order, and is empty
+///            for every scope which is not bound to an array
 struct Scope
 {
     std::vector<Reference*> ReferencesIndex;
@@ -22,18 +124,26 @@ struct Scope
     bool IsDurable;
 
     /// new scope
-    std::vector<Call*> CallsIndex;
+    CallIndex CallsIndex;
+    std::vector<Call*> Elements;
 };
 
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructors/Destructors
 
-/// create a new scope with [inheritedScope]
-Scope* ScopeConstructor(Scope* inheritedScope);
+/// create a new scope from [slab] with [inheritedScope]
+Scope* ScopeConstructor(utils::Slab<Scope>& slab, Scope* inheritedScope);
+
+/// destroys the [scope], which must have been created from [slab]
+void ScopeDestructor(utils::Slab<Scope>& slab, Scope* scope);
+
+/// frees the memory which [scope] holds outside of its slab, before its slab is reset
+void ReleaseScopeStorage(Scope* scope);
 
-/// destroys the [scope]
-void ScopeDestructor(Scope* scope);
+/// frees every Scope allocated from [slab] at once. the storage of each such Scope must
+/// have been released with ReleaseScopeStorage, and no such Scope may be used afterwards
+void ReleaseAllScopes(utils::Slab<Scope>& slab);
 
 /// DEP: 
 void AddReferenceToScope(Reference* ref, Scope* scope);
@@ -41,7 +151,7 @@ void AddReferenceToScope(Reference* ref, Scope* scope);
 /// add [call] to [scope]
 void AddCallToScope(Call* call, Scope* scope);
 
-/// return a deep copy of [scp]
-Scope* CopyScope(Scope* scp);
+/// return a deep copy of [scp] from [scopeSlab], with its calls allocated from [callSlab]
+Scope* CopyScope(Scope* scp, utils::Slab<Scope>& scopeSlab, utils::Slab<Call>& callSlab);
 
 #endif
@@ -0,0 +1,84 @@
+#include <fstream>
+
+#include "mappedfile.h"
+
+#if __unix__ || __APPLE__
+#define PEBBLE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool OpenMappedFile(const std::string& file, MappedFile& contents)
+{
+    CloseMappedFile(contents);
+
+#ifdef PEBBLE_MMAP
+    int fd = open(file.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    {
+        close(fd);
+        return false;
+    }
+
+    // an empty file cannot be mapped, but is still readable
+    if(info.st_size == 0)
+    {
+        close(fd);
+        return true;
+    }
+
+    void* memory = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(memory == MAP_FAILED)
+    {
+        return false;
+    }
+
+    contents.Data = static_cast<const char*>(memory);
+    contents.Size = info.st_size;
+    contents.IsMapped = true;
+    return true;
+#else
+    std::ifstream in(file, std::ios::binary);
+    if(!in)
+    {
+        return false;
+    }
+
+    contents.Buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    contents.Data = contents.Buffer.data();
+    contents.Size = contents.Buffer.size();
+    return true;
+#endif
+}
+
+void CopyIntoMappedFile(const std::string& text, MappedFile& contents)
+{
+    CloseMappedFile(contents);
+
+    contents.Buffer.assign(text.begin(), text.end());
+    contents.Data = contents.Buffer.data();
+    contents.Size = contents.Buffer.size();
+}
+
+void CloseMappedFile(MappedFile& contents)
+{
+#ifdef PEBBLE_MMAP
+    if(contents.IsMapped)
+    {
+        munmap(const_cast<char*>(contents.Data), contents.Size);
+    }
+#endif
+    contents.Data = nullptr;
+    contents.Size = 0;
+    contents.IsMapped = false;
+    contents.Buffer.clear();
+}
@@ -0,0 +1,41 @@
+#ifndef __MAPPEDFILE_H
+#define __MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Mapped files
+//
+// files are mapped with mmap where it is available, so their pages are only read as
+// they are touched and never copied. elsewhere they are read into a buffer
+
+/// the contents of a file, either mapped into memory or read into [Buffer]
+/// [Data] and [Size] are the contents of the file
+/// [IsMapped] is true if [Data] is mapped and must be unmapped
+struct MappedFile
+{
+    const char* Data = nullptr;
+    size_t Size = 0;
+    bool IsMapped = false;
+    std::vector<char> Buffer;
+};
+
+/// maps or reads [file] into [contents]. returns false if it cannot be read
+bool OpenMappedFile(const std::string& file, MappedFile& contents);
+
+/// copies [text] into [contents], as if it were the contents of a file
+void CopyIntoMappedFile(const std::string& text, MappedFile& contents);
+
+/// releases the memory of [contents]
+void CloseMappedFile(MappedFile& contents);
+
+/// returns the contents of [contents] as a view
+inline std::string_view ViewOf(const MappedFile& contents)
+{
+    return std::string_view(contents.Data, contents.Size);
+}
+
+#endif
@@ -65,6 +65,80 @@ namespace utils
     {
         return stackHead + 1;
     }
+
+
+    template <typename T>
+    Slab<T>::Slab(size_t slotsPerChunk)
+        : freeList(nullptr), chunkSize(slotsPerChunk), currentChunk(0), usedInCurrentChunk(0), liveCount(0)
+    {
+    }
+
+    template <typename T>
+    Slab<T>::Slab() : Slab::Slab(SlabDefaultChunkSize) {}
+
+    template <typename T>
+    Slab<T>::~Slab()
+    {
+        for(auto chunk: chunks)
+            delete[] chunk;
+    }
+
+    /// returns the next slot which has never been handed out, moving on to the next
+    /// chunk (and allocating it if needed) once the current chunk is used up
+    template <typename T>
+    typename Slab<T>::Slot* Slab<T>::NextUnusedSlot()
+    {
+        if(currentChunk < chunks.size() && usedInCurrentChunk == chunkSize)
+        {
+            currentChunk++;
+            usedInCurrentChunk = 0;
+        }
+
+        if(currentChunk == chunks.size())
+            chunks.push_back(new Slot[chunkSize]);
+
+        return &chunks[currentChunk][usedInCurrentChunk++];
+    }
+
+    template <typename T>
+    void* Slab<T>::Allocate()
+    {
+        liveCount++;
+        if(freeList != nullptr)
+        {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot->storage;
+        }
+
+        return NextUnusedSlot()->storage;
+    }
+
+    template <typename T>
+    void Slab<T>::Free(void* obj)
+    {
+        Slot* slot = static_cast<Slot*>(obj);
+        slot->next = freeList;
+        freeList = slot;
+        liveCount--;
+    }
+
+    /// frees every object in the slab. the chunks are kept and reused by later
+    /// allocations
+    template <typename T>
+    void Slab<T>::Reset()
+    {
+        freeList = nullptr;
+        currentChunk = 0;
+        usedInCurrentChunk = 0;
+        liveCount = 0;
+    }
+
+    template <typename T>
+    size_t Slab<T>::LiveCount()
+    {
+        return liveCount;
+    }
 }
 
 #endif
\ No newline at end of file
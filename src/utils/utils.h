@@ -1,6 +1,9 @@
 #ifndef __UTILS_H
 #define __UTILS_H
 
+#include <cstddef>
+#include <vector>
+
 namespace utils
 {
     template <typename T>
@@ -26,6 +29,43 @@ namespace utils
         int Size();
 
     };
+
+    /// allocates memory for objects of type T from large chunks instead of one 
+    /// object at a time. freed objects are kept on a free list and reused, and 
+    /// Reset frees every object at once while keeping the chunks for reuse. the 
+    /// slab only manages memory, so objects must be constructed and destroyed by
+    /// the caller
+    template <typename T>
+    class Slab
+    {
+    private:
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        std::vector<Slot*> chunks;
+        Slot* freeList;
+        size_t chunkSize;
+        size_t currentChunk;
+        size_t usedInCurrentChunk;
+        size_t liveCount;
+
+        Slot* NextUnusedSlot();
+    public:
+        constexpr static size_t SlabDefaultChunkSize = 256;
+
+        Slab(size_t slotsPerChunk);
+
+        Slab();
+        ~Slab();
+
+        void* Allocate();
+        void Free(void* obj);
+        void Reset();
+        size_t LiveCount();
+    };
 }
 #include "utils.cpp"
 #endif
\ No newline at end of file
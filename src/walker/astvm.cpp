@@ -14,6 +14,7 @@
 
 
 std::vector<ObjectReferenceMap> ObjectsIndex;
+utils::Slab<Scope> WalkerScopeSlab;
 // ---------------------------------------------------------------------------------------------------------------------
 // Diagnostics
 
@@ -194,7 +195,7 @@ Reference* DoBlock(Block* codeBlock, Scope* scope)
     if(scope == nullptr)
     {
         scopeIsLocal = true;
-        scope = ScopeConstructor(CurrentScope());
+        scope = ScopeConstructor(WalkerScopeSlab, CurrentScope());
     }
     
     EnterScope(scope);
@@ -617,7 +618,7 @@ Reference* CreateNullReference()
 
 Reference* CreateReferenceToNewObject(String name, Token* valueToken)
 {
-    String value = valueToken->Content;
+    String value(valueToken->Content);
     bool b;
 
     switch(valueToken->Type)
@@ -644,7 +645,7 @@ Reference* CreateReferenceToNewObject(String name, Token* valueToken)
 
 Reference* CreateReferenceToNewObject(Token* nameToken, Token* valueToken)
 {
-    return CreateReferenceToNewObject(nameToken->Content, valueToken);
+    return CreateReferenceToNewObject(String(nameToken->Content), valueToken);
 }
 
 
@@ -877,7 +878,7 @@ void ExitScope(bool andDestroy)
 {
     auto scope = ScopeStack.Pop();
     if(andDestroy)
-        ScopeDestructor(scope);
+        ScopeDestructor(WalkerScopeSlab, scope);
 }
 
 /// add [ref] to current scope
@@ -903,6 +904,6 @@ void WipeScope(Scope* scope)
         RemoveReferenceFromObjectIndex(ref);
         ReferenceDestructor(ref);
     }
-    ScopeDestructor(scope);
+    ScopeDestructor(WalkerScopeSlab, scope);
 }
 
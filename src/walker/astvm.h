@@ -2,6 +2,7 @@
 #define __ASTVM_H
 
 #include "abstract.h"
+#include "utils.h"
 
 /// used to keep track of objects and their references
 struct ObjectReferenceMap
@@ -12,6 +13,9 @@ struct ObjectReferenceMap
 
 extern std::vector<ObjectReferenceMap> ObjectsIndex;
 
+/// stores the scopes which the ast runtime creates for blocks and method bodies
+extern utils::Slab<Scope> WalkerScopeSlab;
+
 
 
 
@@ -625,7 +625,7 @@ Reference* OperationEvaluate(Reference* value, std::vector<Reference*>& operands
     auto methodSelfScope = method->To->Attributes;
     methodSelfScope->InheritedScope = methodCallerScope;
 
-    auto methodBodyScope = ScopeConstructor(methodSelfScope);
+    auto methodBodyScope = ScopeConstructor(WalkerScopeSlab, methodSelfScope);
     EnterScope(methodBodyScope);
     {
         for(size_t i=0; i<methodParamNames.size(); i++)
@@ -0,0 +1,488 @@
+#include "test.h"
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+#include "aot.h"
+
+#include "value.h"
+#include "scope.h"
+
+
+String g_emitCppFile = "";
+
+
+
+
+String CppStringFor(const String& str);
+
+String CppStringFor_INTERNAL(const String& str)
+{
+    String literal = "\"";
+    for(unsigned char c: str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            literal += '\\';
+            literal += c;
+        }
+        else if(c >= 0x20 && c < 0x7f)
+        {
+            literal += c;
+        }
+        else
+        {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\%03o", (unsigned)c);
+            literal += escape;
+        }
+    }
+    literal += "\"";
+
+    return "String(" + literal + ", " + std::to_string(str.size()) + ")";
+}
+
+// generated by TestBuilder
+String CppStringFor(const String& str)
+{
+    TEST_Tracer("CppStringFor");
+    methodHitMap["CppStringFor"]++;
+    if(FunctionInjections.count("CppStringFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&str));
+    FunctionInjections["CppStringFor"](p);
+    }
+    return CppStringFor_INTERNAL(str);
+}
+
+
+String CppDecimalFor(double value);
+
+String CppDecimalFor_INTERNAL(double value)
+{
+    if(std::isnan(value))
+    {
+        return "std::nan(\"\")";
+    }
+    if(std::isinf(value))
+    {
+        return value > 0 ? "HUGE_VAL" : "-HUGE_VAL";
+    }
+    char hex[64];
+    std::snprintf(hex, sizeof(hex), "%a", value);
+    return hex;
+}
+
+// generated by TestBuilder
+String CppDecimalFor(double value)
+{
+    TEST_Tracer("CppDecimalFor");
+    methodHitMap["CppDecimalFor"]++;
+    if(FunctionInjections.count("CppDecimalFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CppDecimalFor"](p);
+    }
+    return CppDecimalFor_INTERNAL(value);
+}
+
+
+String CppTypeFor(BindingType type);
+
+String CppTypeFor_INTERNAL(BindingType type)
+{
+    if(type == &IntegerType) return "&IntegerType";
+    if(type == &DecimalType) return "&DecimalType";
+    if(type == &StringType) return "&StringType";
+    if(type == &BooleanType) return "&BooleanType";
+    if(type == &MethodType) return "&MethodType";
+    return "&NothingType";
+}
+
+// generated by TestBuilder
+String CppTypeFor(BindingType type)
+{
+    TEST_Tracer("CppTypeFor");
+    methodHitMap["CppTypeFor"]++;
+    if(FunctionInjections.count("CppTypeFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["CppTypeFor"](p);
+    }
+    return CppTypeFor_INTERNAL(type);
+}
+
+
+String CppPrimitiveFor(const Call* call);
+
+String CppPrimitiveFor_INTERNAL(const Call* call)
+{
+    int integer = 0;
+    double decimal = 0;
+    String text = "";
+    bool boolean = false;
+
+    if(call->BoundType == &IntegerType) integer = call->BoundValue.i;
+    else if(call->BoundType == &DecimalType) decimal = call->BoundValue.d;
+    else if(call->BoundType == &StringType) text = *call->BoundValue.s;
+    else if(call->BoundType == &BooleanType) boolean = call->BoundValue.b;
+
+    return "{ " + CppTypeFor(call->BoundType) + ", " + std::to_string(integer) + ", " + CppDecimalFor(decimal) 
+        + ", " + CppStringFor(text) + ", " + (boolean ? "true" : "false") + " }";
+}
+
+// generated by TestBuilder
+String CppPrimitiveFor(const Call* call)
+{
+    TEST_Tracer("CppPrimitiveFor");
+    methodHitMap["CppPrimitiveFor"]++;
+    if(FunctionInjections.count("CppPrimitiveFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["CppPrimitiveFor"](p);
+    }
+    return CppPrimitiveFor_INTERNAL(call);
+}
+
+
+inline String LabelFor(extArg_t insId);
+
+inline String LabelFor_INTERNAL(extArg_t insId)
+{
+    return "ins_" + std::to_string(insId);
+}
+
+// generated by TestBuilder
+inline String LabelFor(extArg_t insId)
+{
+    TEST_Tracer("LabelFor");
+    methodHitMap["LabelFor"]++;
+    if(FunctionInjections.count("LabelFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&insId));
+    FunctionInjections["LabelFor"](p);
+    }
+    return LabelFor_INTERNAL(insId);
+}
+
+
+inline String CallFor(const ByteCodeInstruction& ins, extArg_t insId);
+
+inline String CallFor_INTERNAL(const ByteCodeInstruction& ins, extArg_t insId)
+{
+    return "vm->InstructionReg = " + std::to_string(insId) + "; " + BCI_InstructionNames[ins.Op] 
+        + "(vm, " + std::to_string(ins.Arg) + "); if(vm->ErrorFlag) goto error;";
+}
+
+// generated by TestBuilder
+inline String CallFor(const ByteCodeInstruction& ins, extArg_t insId)
+{
+    TEST_Tracer("CallFor");
+    methodHitMap["CallFor"]++;
+    if(FunctionInjections.count("CallFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ins));
+    p.push_back(static_cast<const void*>(&insId));
+    FunctionInjections["CallFor"](p);
+    }
+    return CallFor_INTERNAL(ins, insId);
+}
+
+
+String CppCodeFor(PebbleVM* vm, extArg_t insId);
+
+String CppCodeFor_INTERNAL(PebbleVM* vm, extArg_t insId)
+{
+    auto& ins = vm->ByteCodeProgram[insId];
+    String code = LabelFor(insId) + ":\n    ";
+
+    switch(ins.Op)
+    {
+        case OP_NOP:
+            code += ";";
+            break;
+
+        case OP_Jump:
+            code += "goto " + LabelFor(ins.Arg) + ";";
+            break;
+
+        case OP_JumpFalse:
+        case OP_CmpJumpFalse:
+        {
+            auto target = ins.Op == OP_CmpJumpFalse ? CmpJumpTargetOf(ins.Arg) : ins.Arg;
+            code += CallFor(ins, insId);
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto " + LabelFor(target) + "; }";
+            break;
+        }
+
+        case OP_TailEval:
+            code += CallFor(ins, insId);
+            code += "\n    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);";
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto dispatch; }";
+            break;
+
+        case OP_Eval:
+        case OP_EvalHere:
+        case OP_Return:
+            code += CallFor(ins, insId);
+            code += "\n    if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto dispatch; }";
+            break;
+
+        case OP_EndLine:
+            code += CallFor(ins, insId);
+            code += "\n    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);";
+            break;
+
+        default:
+            code += CallFor(ins, insId);
+            break;
+    }
+
+    return code + "\n";
+}
+
+// generated by TestBuilder
+String CppCodeFor(PebbleVM* vm, extArg_t insId)
+{
+    TEST_Tracer("CppCodeFor");
+    methodHitMap["CppCodeFor"]++;
+    if(FunctionInjections.count("CppCodeFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&insId));
+    FunctionInjections["CppCodeFor"](p);
+    }
+    return CppCodeFor_INTERNAL(vm, insId);
+}
+
+
+void EmitTables(PebbleVM* vm, std::ofstream& out, Program* p)
+{
+    out << "static const AotProgram Aot =\n{\n";
+
+    out << "    {\n";
+    for(auto& ins: vm->ByteCodeProgram)
+    {
+        out << "        { " << (int)ins.Op << ", " << ins.Arg << " },\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto& name: vm->CallNames)
+    {
+        out << "        " << CppStringFor(name) << ",\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto call: vm->ConstPrimitives)
+    {
+        out << "        " << CppPrimitiveFor(call) << ",\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n";
+    for(auto& slot: vm->LocalSlots)
+    {
+        out << "        { " << slot.Slot << ", " << slot.NameId << " },\n";
+    }
+    out << "    },\n";
+
+    out << "    {\n        ";
+    for(auto id: vm->ByteCodeLineAssociation)
+    {
+        out << id << ", ";
+    }
+    out << "\n    },\n";
+
+    out << "    {\n        ";
+    for(auto& line: p->Lines)
+    {
+        out << line.LineNumber << ", ";
+    }
+    out << "\n    },\n";
+
+    out << "};\n\n";
+}
+
+
+void EmitCode(PebbleVM* vm, std::ofstream& out)
+{
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+
+    out << "static int RunProgram(PebbleVM* vm, Program* p)\n{\n";
+    for(extArg_t id = 0; id < programEnd; id++)
+    {
+        out << CppCodeFor(vm, id);
+    }
+    out << LabelFor(programEnd) << ":\n    goto halt;\n\n";
+
+    out << "dispatch:\n    switch(vm->InstructionReg)\n    {\n";
+    for(extArg_t id = 0; id <= programEnd; id++)
+    {
+        out << "        case " << id << ": goto " << LabelFor(id) << ";\n";
+    }
+    out << "        default: goto halt;\n    }\n\n";
+
+    out << "error:\n"
+        << "    IfNeededDisplayError(vm, p);\n"
+        << "    if(vm->FatalErrorOccured)\n"
+        << "    {\n"
+        << "        GracefullyExit(vm);\n"
+        << "        return 1;\n"
+        << "    }\n"
+        << "    if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++;\n"
+        << "    goto dispatch;\n\n";
+
+    out << "halt:\n"
+        << "    GracefullyExit(vm);\n"
+        << "    return 0;\n"
+        << "}\n\n";
+}
+
+
+
+
+bool EmitCpp(PebbleVM* vm, const String& file, Program* p);
+
+bool EmitCpp_INTERNAL(PebbleVM* vm, const String& file, Program* p)
+{
+    std::ofstream out(file);
+    if(!out)
+    {
+        return false;
+    }
+
+    out << "// generated by pebble --emit-cpp. do not edit\n\n"
+        << "#include \"aot.h\"\n\n";
+
+    out << "// runtime settings, which pebble defines in main.cpp\n"
+        << "bool g_outputOn = true;\n"
+        << "bool g_useBytecodeRuntime = true;\n"
+        << "LogSeverityType LogAtLevel = LogSeverityType::Sev3_Critical;\n\n";
+
+    EmitTables(vm, out, p);
+    EmitCode(vm, out);
+
+    out << "int main()\n{\n    return RunAotProgram(Aot, RunProgram);\n}\n";
+
+    return out.good();
+}
+
+// generated by TestBuilder
+bool EmitCpp(PebbleVM* vm, const String& file, Program* p)
+{
+    TEST_Tracer("EmitCpp");
+    methodHitMap["EmitCpp"]++;
+    if(FunctionInjections.count("EmitCpp") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&file));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["EmitCpp"](p);
+    }
+    return EmitCpp_INTERNAL(vm, file, p);
+}
+
+
+Call* PrimitiveCallFor(PebbleVM* vm, const AotPrimitive& primitive);
+
+Call* PrimitiveCallFor_INTERNAL(PebbleVM* vm, const AotPrimitive& primitive)
+{
+    Call* call = CallConstructor(vm->PrimitiveSlab);
+    if(primitive.Type == &IntegerType) call->BoundValue.i = primitive.Integer;
+    else if(primitive.Type == &DecimalType) call->BoundValue.d = primitive.Decimal;
+    else if(primitive.Type == &StringType) call->BoundValue.s = StringConstructor(primitive.Text);
+    else if(primitive.Type == &BooleanType) call->BoundValue.b = primitive.Boolean;
+
+    BindScope(call, &SomethingScope);
+    BindType(call, primitive.Type);
+    return call;
+}
+
+// generated by TestBuilder
+Call* PrimitiveCallFor(PebbleVM* vm, const AotPrimitive& primitive)
+{
+    TEST_Tracer("PrimitiveCallFor");
+    methodHitMap["PrimitiveCallFor"]++;
+    if(FunctionInjections.count("PrimitiveCallFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&primitive));
+    FunctionInjections["PrimitiveCallFor"](p);
+    }
+    return PrimitiveCallFor_INTERNAL(vm, primitive);
+}
+
+
+Program* LoadProgramTables(PebbleVM* vm, const AotProgram& aot);
+
+Program* LoadProgramTables_INTERNAL(PebbleVM* vm, const AotProgram& aot)
+{
+    vm->ByteCodeProgram = aot.Instructions;
+    vm->CallNames = aot.CallNames;
+    vm->LocalSlots = aot.Slots;
+    vm->ByteCodeLineAssociation = aot.LineAssociation;
+
+    ReleaseConstPrimitives(vm);
+    for(auto& primitive: aot.Primitives)
+    {
+        vm->ConstPrimitives.push_back(PrimitiveCallFor(vm, primitive));
+    }
+
+    Program* program = new Program();
+    program->GlobalScope = nullptr;
+    program->Main = nullptr;
+    program->That = nullptr;
+    program->Lines.resize(aot.LineNumbers.size());
+    for(size_t i=0; i<aot.LineNumbers.size(); i++)
+    {
+        program->Lines[i].LineNumber = aot.LineNumbers[i];
+    }
+
+    return program;
+}
+
+// generated by TestBuilder
+Program* LoadProgramTables(PebbleVM* vm, const AotProgram& aot)
+{
+    TEST_Tracer("LoadProgramTables");
+    methodHitMap["LoadProgramTables"]++;
+    if(FunctionInjections.count("LoadProgramTables") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&aot));
+    FunctionInjections["LoadProgramTables"](p);
+    }
+    return LoadProgramTables_INTERNAL(vm, aot);
+}
+
+
+int RunAotProgram(const AotProgram& aot, AotCode code);
+
+int RunAotProgram_INTERNAL(const AotProgram& aot, AotCode code)
+{
+    PebbleVM* vm = PebbleVMConstructor();
+    Program* program = LoadProgramTables(vm, aot);
+
+    InitRuntime(vm);
+    int exitCode = code(vm, program);
+
+    delete program;
+    PebbleVMDestructor(vm);
+    return exitCode;
+}
+
+// generated by TestBuilder
+int RunAotProgram(const AotProgram& aot, AotCode code)
+{
+    TEST_Tracer("RunAotProgram");
+    methodHitMap["RunAotProgram"]++;
+    if(FunctionInjections.count("RunAotProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&aot));
+    p.push_back(static_cast<const void*>(&code));
+    FunctionInjections["RunAotProgram"](p);
+    }
+    return RunAotProgram_INTERNAL(aot, code);
+}
@@ -0,0 +1,1884 @@
+#include "test.h"
+#include "astvm.h"
+
+#include <iostream>
+
+#include "main.h"
+#include "diagnostics.h"
+#include "scope.h"
+#include "operation.h"
+#include "reference.h"
+#include "program.h"
+#include "object.h"
+#include "executable.h"
+#include "token.h"
+
+
+std::vector<ObjectReferenceMap> ObjectsIndex;
+utils::Slab<Scope> WalkerScopeSlab;
+
+
+void LogDiagnosticsForRuntimeLine(Scope* scope, Operation* op);
+
+void LogDiagnosticsForRuntimeLine_INTERNAL(Scope* scope, Operation* op)
+{
+    for(; scope != nullptr; scope=scope->InheritedScope)
+        for(auto ref: scope->ReferencesIndex)
+            LogDiagnostics(ref, Msg("scope before %s line %i", ToString(op->Type), op->LineNumber), "DoOperationOnReferences");
+}
+
+// generated by TestBuilder
+void LogDiagnosticsForRuntimeLine(Scope* scope, Operation* op)
+{
+    TEST_Tracer("LogDiagnosticsForRuntimeLine");
+    methodHitMap["LogDiagnosticsForRuntimeLine"]++;
+    if(FunctionInjections.count("LogDiagnosticsForRuntimeLine") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["LogDiagnosticsForRuntimeLine"](p);
+    }
+    LogDiagnosticsForRuntimeLine_INTERNAL(scope, op);
+}
+
+
+
+
+
+Block* AsBlock(Executable* exec);
+
+Block* AsBlock_INTERNAL(Executable* exec)
+{
+    return static_cast<Block*>(exec);
+}
+
+// generated by TestBuilder
+Block* AsBlock(Executable* exec)
+{
+    TEST_Tracer("AsBlock");
+    methodHitMap["AsBlock"]++;
+    if(FunctionInjections.count("AsBlock") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&exec));
+    FunctionInjections["AsBlock"](p);
+    }
+    return AsBlock_INTERNAL(exec);
+}
+
+
+Operation* AsOperation(Executable* exec);
+
+Operation* AsOperation_INTERNAL(Executable* exec)
+{
+    return static_cast<Operation*>(exec);
+}
+
+// generated by TestBuilder
+Operation* AsOperation(Executable* exec)
+{
+    TEST_Tracer("AsOperation");
+    methodHitMap["AsOperation"]++;
+    if(FunctionInjections.count("AsOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&exec));
+    FunctionInjections["AsOperation"](p);
+    }
+    return AsOperation_INTERNAL(exec);
+}
+
+
+Reference* DoOperationOnReferences(Operation* op, std::vector<Reference*> operands)
+{
+    return OperationEvaluators[op->Type](op->Value, operands);
+}
+
+
+std::vector<Reference*> GetOperandReferences(Operation* op)
+{
+    std::vector<Reference*> operandReferences;
+    
+    for(Operation* operand: op->Operands)
+    {
+        Reference* operandRef = DoOperation(operand);
+        operandReferences.push_back(operandRef);
+    }
+    return operandReferences;
+}
+
+
+Reference* DoOperation(Operation* op);
+
+Reference* DoOperation_INTERNAL(Operation* op)
+{
+    std::vector<Reference*> operandReferences = GetOperandReferences(op);
+    Reference* returnRef = DoOperationOnReferences(op, operandReferences);
+    LogItDebug(Msg("line[%i] operation %s returned a reference", op->LineNumber, ToString(op->Type)), "DoOperation");
+    return returnRef;
+}
+
+// generated by TestBuilder
+Reference* DoOperation(Operation* op)
+{
+    TEST_Tracer("DoOperation");
+    methodHitMap["DoOperation"]++;
+    if(FunctionInjections.count("DoOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["DoOperation"](p);
+    }
+    return DoOperation_INTERNAL(op);
+}
+
+
+void UpdatePreviousResult(Reference** result, Reference** previousResult);
+
+void UpdatePreviousResult_INTERNAL(Reference** result, Reference** previousResult)
+{
+    if(*previousResult != nullptr)
+        Dereference(*previousResult);
+    *previousResult = *result;
+    PROGRAM->That = *result;
+}
+
+// generated by TestBuilder
+void UpdatePreviousResult(Reference** result, Reference** previousResult)
+{
+    TEST_Tracer("UpdatePreviousResult");
+    methodHitMap["UpdatePreviousResult"]++;
+    if(FunctionInjections.count("UpdatePreviousResult") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&result));
+    p.push_back(static_cast<const void*>(&previousResult));
+    FunctionInjections["UpdatePreviousResult"](p);
+    }
+    UpdatePreviousResult_INTERNAL(result, previousResult);
+}
+
+
+Reference* HandleControlFlowIf(Operation* op, size_t& execLine);
+
+Reference* HandleControlFlowIf_INTERNAL(Operation* op, size_t& execLine)
+{
+    Reference* ifExpressionResult = DoOperation(op);
+    bool ifIsTrue = GetBoolValue(ObjectOf(ifExpressionResult));
+    if(op->Type == OperationType::If && !ifIsTrue)
+    {
+        execLine++;
+    }
+    return ifExpressionResult;
+}
+
+// generated by TestBuilder
+Reference* HandleControlFlowIf(Operation* op, size_t& execLine)
+{
+    TEST_Tracer("HandleControlFlowIf");
+    methodHitMap["HandleControlFlowIf"]++;
+    if(FunctionInjections.count("HandleControlFlowIf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&execLine));
+    FunctionInjections["HandleControlFlowIf"](p);
+    }
+    return HandleControlFlowIf_INTERNAL(op, execLine);
+}
+
+
+Reference* HandleControlFlowWhile(Operation* op, size_t& execLine, Block* codeBlock);
+
+Reference* HandleControlFlowWhile_INTERNAL(Operation* op, size_t& execLine, Block* codeBlock)
+{
+    Reference* whileExpression = DoOperation(op);
+    bool condition = GetBoolValue(ObjectOf(whileExpression));
+    if(op->Type == OperationType::While && !condition)
+    {
+        execLine++;
+    } else if(op->Type == OperationType::While && condition){
+        if(codeBlock->Executables.size() > execLine + 1 && codeBlock->Executables.at(execLine+1)->ExecType == ExecutableType::Block)
+        {
+            auto ref = DoBlock(static_cast<Block *> (codeBlock->Executables.at(execLine+1)));
+            Dereference(ref);
+            execLine -= 1;
+        }
+    }
+    return whileExpression;
+}
+
+// generated by TestBuilder
+Reference* HandleControlFlowWhile(Operation* op, size_t& execLine, Block* codeBlock)
+{
+    TEST_Tracer("HandleControlFlowWhile");
+    methodHitMap["HandleControlFlowWhile"]++;
+    if(FunctionInjections.count("HandleControlFlowWhile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&execLine));
+    p.push_back(static_cast<const void*>(&codeBlock));
+    FunctionInjections["HandleControlFlowWhile"](p);
+    }
+    return HandleControlFlowWhile_INTERNAL(op, execLine, codeBlock);
+}
+
+
+Reference* HandleControlFlowClass(Operation* op, size_t& execLine, Block* block);
+
+Reference* HandleControlFlowClass_INTERNAL(Operation* op, size_t& execLine, Block* block)
+{
+    if(!(execLine + 1 < block->Executables.size() && block->Executables[execLine+1]->ExecType == ExecutableType::Block))
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, "no block after class");
+        return NullReference();                
+    }
+
+    Reference* newClass = DoOperation(op);
+    
+    auto classBlock = AsBlock(block->Executables[++execLine]);
+    auto classScope = ObjectOf(newClass)->Attributes;
+    DoBlock(classBlock, classScope);
+
+    return newClass;
+}
+
+// generated by TestBuilder
+Reference* HandleControlFlowClass(Operation* op, size_t& execLine, Block* block)
+{
+    TEST_Tracer("HandleControlFlowClass");
+    methodHitMap["HandleControlFlowClass"]++;
+    if(FunctionInjections.count("HandleControlFlowClass") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&execLine));
+    p.push_back(static_cast<const void*>(&block));
+    FunctionInjections["HandleControlFlowClass"](p);
+    }
+    return HandleControlFlowClass_INTERNAL(op, execLine, block);
+}
+
+
+Reference* HandleControlFlowDefineMethod(Operation* op, size_t& execline, Block* block);
+
+Reference* HandleControlFlowDefineMethod_INTERNAL(Operation* op, size_t& execline, Block* block)
+{
+    if(!(execline + 1 < block->Executables.size() && block->Executables[execline+1]->ExecType == ExecutableType::Block))
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, "no block after method definition");
+        return NullReference();
+    }
+
+    Reference* method = DoOperation(op);
+
+    auto methodBlock = AsBlock(block->Executables[++execline]);
+    method->To->Action->CodeBlock = methodBlock;
+
+    return method;
+}
+
+// generated by TestBuilder
+Reference* HandleControlFlowDefineMethod(Operation* op, size_t& execline, Block* block)
+{
+    TEST_Tracer("HandleControlFlowDefineMethod");
+    methodHitMap["HandleControlFlowDefineMethod"]++;
+    if(FunctionInjections.count("HandleControlFlowDefineMethod") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&execline));
+    p.push_back(static_cast<const void*>(&block));
+    FunctionInjections["HandleControlFlowDefineMethod"](p);
+    }
+    return HandleControlFlowDefineMethod_INTERNAL(op, execline, block);
+}
+
+Reference* HandleControlFlow(Operation* op, size_t& execLine, Block* block);
+
+Reference* HandleControlFlow_INTERNAL(Operation* op, size_t& execLine, Block* block)
+{
+    switch(op->Type)
+    {
+        case OperationType::If:
+        return HandleControlFlowIf(op, execLine);
+
+
+        case OperationType::While:
+        return HandleControlFlowWhile(op, execLine, block);
+
+        case OperationType::DefineMethod:
+        return HandleControlFlowDefineMethod(op, execLine, block);
+        default:
+        return DoOperation(op);
+    }
+}
+
+// generated by TestBuilder
+Reference* HandleControlFlow(Operation* op, size_t& execLine, Block* block)
+{
+    TEST_Tracer("HandleControlFlow");
+    methodHitMap["HandleControlFlow"]++;
+    if(FunctionInjections.count("HandleControlFlow") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&execLine));
+    p.push_back(static_cast<const void*>(&block));
+    FunctionInjections["HandleControlFlow"](p);
+    }
+    return HandleControlFlow_INTERNAL(op, execLine, block);
+}
+
+
+void HandleRuntimeMessages(int lineNumber);
+
+void HandleRuntimeMessages_INTERNAL(int lineNumber)
+{
+    if(RuntimeMsgFlag)
+    {
+        RuntimeMsgPrint(lineNumber);
+        RuntimeMsgFlag = false;
+    }
+}
+
+// generated by TestBuilder
+void HandleRuntimeMessages(int lineNumber)
+{
+    TEST_Tracer("HandleRuntimeMessages");
+    methodHitMap["HandleRuntimeMessages"]++;
+    if(FunctionInjections.count("HandleRuntimeMessages") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&lineNumber));
+    FunctionInjections["HandleRuntimeMessages"](p);
+    }
+    HandleRuntimeMessages_INTERNAL(lineNumber);
+}
+
+
+bool ProgramFinished();
+
+bool ProgramFinished_INTERNAL()
+{
+    return ScopeStackIsEmpty();
+}
+
+// generated by TestBuilder
+bool ProgramFinished()
+{
+    TEST_Tracer("ProgramFinished");
+    methodHitMap["ProgramFinished"]++;
+    if(FunctionInjections.count("ProgramFinished") == 1){
+    Params p;
+    FunctionInjections["ProgramFinished"](p);
+    }
+    return ProgramFinished_INTERNAL();
+}
+
+
+bool shouldReturn = false;
+
+
+Reference* DoBlock(Block* codeBlock, Scope* scope);
+
+Reference* DoBlock_INTERNAL(Block* codeBlock, Scope* scope)
+{
+    Reference* result = nullptr;
+    Reference* previousResult = nullptr;
+
+    shouldReturn = false;
+    bool scopeIsLocal = false;
+    if(scope == nullptr)
+    {
+        scopeIsLocal = true;
+        scope = ScopeConstructor(WalkerScopeSlab, CurrentScope());
+    }
+    
+    EnterScope(scope);
+    {
+        for(size_t i=0; i<codeBlock->Executables.size(); i++)
+        {
+            auto exec = codeBlock->Executables.at(i);
+
+            if(exec->ExecType == ExecutableType::Operation)
+            {
+                Operation* op = AsOperation(exec); 
+
+                LogItDebug(Msg("starting execute line [%i] which is %s", op->LineNumber, ToString(op->Type)), "DoBlock");
+
+                result = HandleControlFlow(op, i, codeBlock); 
+                UpdatePreviousResult(&result, &previousResult);
+                HandleRuntimeMessages(op->LineNumber);
+                
+                LogItDebug(Msg("finishes execute line [%i]", op->LineNumber), "DoBlock");
+
+                if(op->Type == OperationType::Return)
+                {
+                    shouldReturn = true;
+                    break;
+                }
+            }
+            else if(exec->ExecType == ExecutableType::Block)
+            {
+                LogItDebug("discovered child block: starting", "DoBlock");
+
+                result = DoBlock(AsBlock(exec));
+                UpdatePreviousResult(&result, &previousResult);
+
+                LogItDebug("exiting child block", "DoBlock");
+                if(shouldReturn) break;
+            }
+        }
+    }
+    ExitScope();
+
+    if(ProgramFinished())
+        return nullptr;
+
+    Reference * returnRef;
+    if(result != nullptr)
+    {
+        returnRef = ReferenceForExistingObject(c_returnReferenceName, result->To);
+    }
+    else
+    {
+        returnRef = NullReference();
+    }
+
+    if(scopeIsLocal)
+        WipeScope(scope);
+    return returnRef;
+}
+
+// generated by TestBuilder
+Reference* DoBlock(Block* codeBlock, Scope* scope)
+{
+    TEST_Tracer("DoBlock");
+    methodHitMap["DoBlock"]++;
+    if(FunctionInjections.count("DoBlock") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&codeBlock));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["DoBlock"](p);
+    }
+    return DoBlock_INTERNAL(codeBlock, scope);
+}
+
+
+void DeleteObjectsIndex();
+
+void DeleteObjectsIndex_INTERNAL()
+{
+    for(size_t i=0; i<ObjectsIndex.size(); i++)
+    {
+        auto& map = ObjectsIndex[i];
+        for(auto ref: map.References)
+        {
+            ReferenceDestructor(ref);
+        }
+        if(map.IndexedObject == NullObject())
+            continue;
+        DeleteObject(map.IndexedObject);
+    }
+}
+
+// generated by TestBuilder
+void DeleteObjectsIndex()
+{
+    TEST_Tracer("DeleteObjectsIndex");
+    methodHitMap["DeleteObjectsIndex"]++;
+    if(FunctionInjections.count("DeleteObjectsIndex") == 1){
+    Params p;
+    FunctionInjections["DeleteObjectsIndex"](p);
+    }
+    DeleteObjectsIndex_INTERNAL();
+}
+
+
+void FirstPassForAstVm(Operation* op);
+
+void FirstPassForAstVm_INTERNAL(Operation* op)
+{
+    switch(op->Type)
+    {
+        case OperationType::Ref:
+        {
+            if(!IsReferenceStub(op->Value))
+            {
+                IndexObject(op->Value->To, op->Value);
+                AddReferenceToScope(op->Value, PROGRAM->GlobalScope);
+            }
+            break;
+        }
+
+        default:
+        for(auto operand: op->Operands)
+        {
+            FirstPassForAstVm(operand);
+        }
+        break;
+    }
+}
+
+// generated by TestBuilder
+void FirstPassForAstVm(Operation* op)
+{
+    TEST_Tracer("FirstPassForAstVm");
+    methodHitMap["FirstPassForAstVm"]++;
+    if(FunctionInjections.count("FirstPassForAstVm") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FirstPassForAstVm"](p);
+    }
+    FirstPassForAstVm_INTERNAL(op);
+}
+
+
+void FirstPassForAstVm(Block* b);
+
+void FirstPassForAstVm_INTERNAL(Block* b)
+{
+    for(auto exec: b->Executables)
+    {
+        switch(exec->ExecType)
+        {
+            case ExecutableType::Block:
+            FirstPassForAstVm(static_cast<Block*>(exec));
+            break;
+
+            case ExecutableType::Operation:
+            FirstPassForAstVm(static_cast<Operation*>(exec));
+            break;
+        }
+    }
+}
+
+// generated by TestBuilder
+void FirstPassForAstVm(Block* b)
+{
+    TEST_Tracer("FirstPassForAstVm");
+    methodHitMap["FirstPassForAstVm"]++;
+    if(FunctionInjections.count("FirstPassForAstVm") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&b));
+    FunctionInjections["FirstPassForAstVm"](p);
+    }
+    FirstPassForAstVm_INTERNAL(b);
+}
+
+
+void FirstPassForAstVm(Program* program);
+
+void FirstPassForAstVm_INTERNAL(Program* program)
+{
+    FirstPassForAstVm(program->Main);
+}
+
+// generated by TestBuilder
+void FirstPassForAstVm(Program* program)
+{
+    TEST_Tracer("FirstPassForAstVm");
+    methodHitMap["FirstPassForAstVm"]++;
+    if(FunctionInjections.count("FirstPassForAstVm") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&program));
+    FunctionInjections["FirstPassForAstVm"](p);
+    }
+    FirstPassForAstVm_INTERNAL(program);
+}
+
+
+void DoProgram(Program* program);
+
+void DoProgram_INTERNAL(Program* program)
+{
+    EnterProgram(program);
+ 
+    FirstPassForAstVm(program);
+    for(ObjectReferenceMap& map: ObjectsIndex)
+    {
+        LogDiagnostics(map, "initial object reference state", "main");
+    }
+
+    DoBlock(program->Main, program->GlobalScope);
+    ExitProgram();
+
+    DeleteObjectsIndex();
+}
+
+// generated by TestBuilder
+void DoProgram(Program* program)
+{
+    TEST_Tracer("DoProgram");
+    methodHitMap["DoProgram"]++;
+    if(FunctionInjections.count("DoProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&program));
+    FunctionInjections["DoProgram"](p);
+    }
+    DoProgram_INTERNAL(program);
+}
+
+
+void EnterProgram(Program* p);
+
+void EnterProgram_INTERNAL(Program* p)
+{
+    PROGRAM = p;
+    
+}
+
+// generated by TestBuilder
+void EnterProgram(Program* p)
+{
+    TEST_Tracer("EnterProgram");
+    methodHitMap["EnterProgram"]++;
+    if(FunctionInjections.count("EnterProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["EnterProgram"](p);
+    }
+    EnterProgram_INTERNAL(p);
+}
+
+
+void ExitProgram();
+
+void ExitProgram_INTERNAL()
+{
+    PROGRAM = nullptr;
+}
+
+// generated by TestBuilder
+void ExitProgram()
+{
+    TEST_Tracer("ExitProgram");
+    methodHitMap["ExitProgram"]++;
+    if(FunctionInjections.count("ExitProgram") == 1){
+    Params p;
+    FunctionInjections["ExitProgram"](p);
+    }
+    ExitProgram_INTERNAL();
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+void RemoveReferenceFromCurrentScope(Reference* ref);
+
+void RemoveReferenceFromCurrentScope_INTERNAL(Reference* ref)
+{
+    size_t refLoc;
+    for(refLoc = 0; refLoc<CurrentScope()->ReferencesIndex.size() && CurrentScope()->ReferencesIndex.at(refLoc) != ref; refLoc++);
+    if(refLoc != CurrentScope()->ReferencesIndex.size())
+        CurrentScope()->ReferencesIndex.erase(CurrentScope()->ReferencesIndex.begin()+refLoc);
+}
+
+// generated by TestBuilder
+void RemoveReferenceFromCurrentScope(Reference* ref)
+{
+    TEST_Tracer("RemoveReferenceFromCurrentScope");
+    methodHitMap["RemoveReferenceFromCurrentScope"]++;
+    if(FunctionInjections.count("RemoveReferenceFromCurrentScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["RemoveReferenceFromCurrentScope"](p);
+    }
+    RemoveReferenceFromCurrentScope_INTERNAL(ref);
+}
+
+
+void RemoveReferenceFromObjectIndex(Reference* ref);
+
+void RemoveReferenceFromObjectIndex_INTERNAL(Reference* ref)
+{
+    ObjectReferenceMap* map = nullptr;
+    if(FoundEntryInIndexOf(ObjectOf(ref), &map))
+    {
+        size_t refLoc;
+        for(refLoc=0; refLoc<map->References.size() && ref != map->References.at(refLoc); refLoc++);
+        map->References.erase(map->References.begin()+refLoc);
+    }
+    else
+    {
+        LogIt(LogSeverityType::Sev3_Critical, "RemoveReferenceFromObjectIndex", "cannot find reference in ObjectIndex");
+    }
+}
+
+// generated by TestBuilder
+void RemoveReferenceFromObjectIndex(Reference* ref)
+{
+    TEST_Tracer("RemoveReferenceFromObjectIndex");
+    methodHitMap["RemoveReferenceFromObjectIndex"]++;
+    if(FunctionInjections.count("RemoveReferenceFromObjectIndex") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["RemoveReferenceFromObjectIndex"](p);
+    }
+    RemoveReferenceFromObjectIndex_INTERNAL(ref);
+}
+
+
+
+void Dereference(Reference* ref);
+
+void Dereference_INTERNAL(Reference* ref)
+{
+    if(!IsTemporaryReference(ref) && !IsNullReference(ref))
+        return;
+
+    LogItDebug(Msg("dereferencing: %s", ref->Name), "Dereference");
+
+    if(ObjectOf(ref) != nullptr)
+    {
+        RemoveReferenceFromObjectIndex(ref);
+    }
+    RemoveReferenceFromCurrentScope(ref);
+    ReferenceDestructor(ref);
+}
+
+// generated by TestBuilder
+void Dereference(Reference* ref)
+{
+    TEST_Tracer("Dereference");
+    methodHitMap["Dereference"]++;
+    if(FunctionInjections.count("Dereference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["Dereference"](p);
+    }
+    Dereference_INTERNAL(ref);
+}
+
+
+void DereferenceAll(std::vector<Reference*> referenceList)
+{
+    for(Reference* ref: referenceList)
+    {
+        Dereference(ref);
+    }
+}
+
+
+
+
+
+Reference* GetReference(String refName);
+
+Reference* GetReference_INTERNAL(String refName)
+{
+    for(Scope* lookInScope = CurrentScope(); lookInScope != nullptr; lookInScope = lookInScope->InheritedScope)
+    {
+        for(Reference* ref: lookInScope->ReferencesIndex)
+        {
+            if(NameMatchesReference(refName, ref))
+                return ref;
+        }
+    }
+    return nullptr;
+}
+
+// generated by TestBuilder
+Reference* GetReference(String refName)
+{
+    TEST_Tracer("GetReference");
+    methodHitMap["GetReference"]++;
+    if(FunctionInjections.count("GetReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    FunctionInjections["GetReference"](p);
+    }
+    return GetReference_INTERNAL(refName);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+bool FoundEntryInIndexOf(const Object* obj, ObjectReferenceMap** foundMap);
+
+bool FoundEntryInIndexOf_INTERNAL(const Object* obj, ObjectReferenceMap** foundMap)
+{
+    for(ObjectReferenceMap& map: ObjectsIndex)
+    {
+        if(map.IndexedObject == obj)
+        {
+            *foundMap = &map;            
+            return true;
+        }
+    }
+    foundMap = nullptr;
+    return false;
+}
+
+// generated by TestBuilder
+bool FoundEntryInIndexOf(const Object* obj, ObjectReferenceMap** foundMap)
+{
+    TEST_Tracer("FoundEntryInIndexOf");
+    methodHitMap["FoundEntryInIndexOf"]++;
+    if(FunctionInjections.count("FoundEntryInIndexOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    p.push_back(static_cast<const void*>(&foundMap));
+    FunctionInjections["FoundEntryInIndexOf"](p);
+    }
+    return FoundEntryInIndexOf_INTERNAL(obj, foundMap);
+}
+
+
+void IndexObject(Object* obj, Reference* ref);
+
+void IndexObject_INTERNAL(Object* obj, Reference* ref)
+{
+    ObjectReferenceMap* map = nullptr;
+    if(FoundEntryInIndexOf(obj, &map))
+    {
+        map->References.push_back(ref);
+    }
+    else
+    {
+        std::vector<Reference*> refs = { ref };
+        
+        ObjectReferenceMap objMap = { obj, refs };
+        ObjectsIndex.push_back(objMap);
+    }
+
+}
+
+// generated by TestBuilder
+void IndexObject(Object* obj, Reference* ref)
+{
+    TEST_Tracer("IndexObject");
+    methodHitMap["IndexObject"]++;
+    if(FunctionInjections.count("IndexObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IndexObject"](p);
+    }
+    IndexObject_INTERNAL(obj, ref);
+}
+
+
+Reference* CreateReferenceInternal(String name, ObjectClass objClass);
+
+Reference* CreateReferenceInternal_INTERNAL(String name, ObjectClass objClass)
+{
+    Object* obj = ObjectConstructor();
+    Reference* ref = ReferenceConstructor(name, obj);
+
+    IndexObject(obj, ref);
+
+    obj->Class = objClass;
+    
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceInternal(String name, ObjectClass objClass)
+{
+    TEST_Tracer("CreateReferenceInternal");
+    methodHitMap["CreateReferenceInternal"]++;
+    if(FunctionInjections.count("CreateReferenceInternal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    FunctionInjections["CreateReferenceInternal"](p);
+    }
+    return CreateReferenceInternal_INTERNAL(name, objClass);
+}
+
+
+
+Reference* CreateReferenceToArrayObject(String name, ObjectClass objClass, int value);
+
+Reference* CreateReferenceToArrayObject_INTERNAL(String name, ObjectClass objClass, int value){
+    Reference* ref = CreateReferenceInternal(name, objClass);
+
+    int* i = new int;
+    *i = value;
+
+
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToArrayObject(String name, ObjectClass objClass, int value){
+    TEST_Tracer("CreateReferenceToArrayObject");
+    methodHitMap["CreateReferenceToArrayObject"]++;
+    if(FunctionInjections.count("CreateReferenceToArrayObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToArrayObject"](p);
+    }
+    return CreateReferenceToArrayObject_INTERNAL(name, objClass, value);
+}
+
+
+
+
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, int value);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, ObjectClass objClass, int value)
+{
+    Reference* ref = CreateReferenceInternal(name, objClass);
+    ObjectOf(ref)->Value = ObjectValueConstructor(value);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, int value)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, objClass, value);
+}
+
+
+
+
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, double value);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, ObjectClass objClass, double value)
+{
+    Reference* ref = CreateReferenceInternal(name, objClass);
+    ObjectOf(ref)->Value = ObjectValueConstructor(value);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, double value)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, objClass, value);
+}
+
+
+
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, bool value);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, ObjectClass objClass, bool value)
+{
+    Reference* ref = CreateReferenceInternal(name, objClass);
+    ObjectOf(ref)->Value = ObjectValueConstructor(value);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, bool value)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, objClass, value);
+}
+
+
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, const String value);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, ObjectClass objClass, const String value)
+{
+    Reference* ref = CreateReferenceInternal(name, objClass);
+    ObjectOf(ref)->Value = ObjectValueConstructor(value);
+    
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, const String value)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, objClass, value);
+}
+
+
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, void* value);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, ObjectClass objClass, void* value){
+    if(objClass == StringClass)
+    {
+        return CreateReferenceToNewObject(name, objClass, *static_cast<String*>(value));
+    }
+    else if(objClass == DecimalClass)
+    {
+        return CreateReferenceToNewObject(name, objClass, *static_cast<double*>(value));
+    }
+    else if(objClass == BooleanClass)
+    {
+        return CreateReferenceToNewObject(name, objClass, *static_cast<bool*>(value));
+    }
+    else if(objClass == IntegerClass)
+    {
+        return CreateReferenceToNewObject(name, objClass, *static_cast<int*>(value));
+    }
+    else if(objClass == ArrayClass)
+    {
+        return CreateReferenceToArrayObject(name, objClass, *static_cast<int*>(value));
+    }
+    else if(objClass == TupleClass)
+    {
+        return CreateReferenceInternal(name, TupleClass);
+    }
+    else if(objClass == BaseClass)
+    {
+        return CreateReferenceInternal(name, BaseClass);
+    }
+    else 
+    {
+        return CreateReferenceInternal(name, objClass);
+    }
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, ObjectClass objClass, void* value){
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&objClass));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, objClass, value);
+}
+
+
+
+
+Reference* CreateReference(String name, Object* obj);
+
+Reference* CreateReference_INTERNAL(String name, Object* obj)
+{
+    Reference* ref = ReferenceConstructor(name, obj);
+    IndexObject(obj, ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateReference(String name, Object* obj)
+{
+    TEST_Tracer("CreateReference");
+    methodHitMap["CreateReference"]++;
+    if(FunctionInjections.count("CreateReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["CreateReference"](p);
+    }
+    return CreateReference_INTERNAL(name, obj);
+}
+
+
+
+Object* NullObject();
+
+Object* NullObject_INTERNAL()
+{
+    static Object nullObject;
+    static Scope nullScope;
+    nullObject.Class = NullClass;
+    nullObject.Value = nullptr;
+    nullObject.Attributes = &nullScope;
+
+    return &nullObject;
+}
+
+// generated by TestBuilder
+Object* NullObject()
+{
+    TEST_Tracer("NullObject");
+    methodHitMap["NullObject"]++;
+    if(FunctionInjections.count("NullObject") == 1){
+    Params p;
+    FunctionInjections["NullObject"](p);
+    }
+    return NullObject_INTERNAL();
+}
+
+
+Reference* CreateNullReference(String name);
+
+Reference* CreateNullReference_INTERNAL(String name)
+{
+    Object* nullObject = NullObject();
+    Reference* ref = ReferenceConstructor(name, nullObject);
+    ref->Name = name;
+    ref->To = nullObject;
+
+    IndexObject(nullObject, ref);
+    
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* CreateNullReference(String name)
+{
+    TEST_Tracer("CreateNullReference");
+    methodHitMap["CreateNullReference"]++;
+    if(FunctionInjections.count("CreateNullReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    FunctionInjections["CreateNullReference"](p);
+    }
+    return CreateNullReference_INTERNAL(name);
+}
+
+
+Reference* CreateNullReference();
+
+Reference* CreateNullReference_INTERNAL()
+{
+    return CreateNullReference(c_temporaryReferenceName);
+}
+
+// generated by TestBuilder
+Reference* CreateNullReference()
+{
+    TEST_Tracer("CreateNullReference");
+    methodHitMap["CreateNullReference"]++;
+    if(FunctionInjections.count("CreateNullReference") == 1){
+    Params p;
+    FunctionInjections["CreateNullReference"](p);
+    }
+    return CreateNullReference_INTERNAL();
+}
+
+
+
+Reference* CreateReferenceToNewObject(String name, Token* valueToken);
+
+Reference* CreateReferenceToNewObject_INTERNAL(String name, Token* valueToken)
+{
+    String value(valueToken->Content);
+    bool b;
+
+    switch(valueToken->Type)
+    {
+        case TokenType::Integer:
+        return CreateReferenceToNewObject(name, IntegerClass, std::stoi(value));
+
+        case TokenType::Boolean:
+        b = value == "true" ? true : false;
+        return CreateReferenceToNewObject(name, BooleanClass, b);
+
+        case TokenType::String:
+        return CreateReferenceToNewObject(name, StringClass, value);
+
+        case TokenType::Decimal:
+        return CreateReferenceToNewObject(name, DecimalClass, std::stod(value));
+
+        case TokenType::Reference:
+        default:
+        LogIt(LogSeverityType::Sev1_Notify, "CreateReferenceToNewObject", "unimplemented in this case (generic References/Simple)");
+        return CreateNullReference();
+    }
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(String name, Token* valueToken)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&valueToken));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(name, valueToken);
+}
+
+
+Reference* CreateReferenceToNewObject(Token* nameToken, Token* valueToken);
+
+Reference* CreateReferenceToNewObject_INTERNAL(Token* nameToken, Token* valueToken)
+{
+    return CreateReferenceToNewObject(String(nameToken->Content), valueToken);
+}
+
+// generated by TestBuilder
+Reference* CreateReferenceToNewObject(Token* nameToken, Token* valueToken)
+{
+    TEST_Tracer("CreateReferenceToNewObject");
+    methodHitMap["CreateReferenceToNewObject"]++;
+    if(FunctionInjections.count("CreateReferenceToNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&nameToken));
+    p.push_back(static_cast<const void*>(&valueToken));
+    FunctionInjections["CreateReferenceToNewObject"](p);
+    }
+    return CreateReferenceToNewObject_INTERNAL(nameToken, valueToken);
+}
+
+
+
+
+
+
+
+
+Reference* LookupReference(String refName);
+
+Reference* LookupReference_INTERNAL(String refName)
+{
+    return GetReference(refName);
+}
+
+// generated by TestBuilder
+Reference* LookupReference(String refName)
+{
+    TEST_Tracer("LookupReference");
+    methodHitMap["LookupReference"]++;
+    if(FunctionInjections.count("LookupReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    FunctionInjections["LookupReference"](p);
+    }
+    return LookupReference_INTERNAL(refName);
+}
+
+
+Reference* ReferenceForInImmediateScope(String refName, Scope* scope);
+
+Reference* ReferenceForInImmediateScope_INTERNAL(String refName, Scope* scope)
+{
+    for(auto ref: scope->ReferencesIndex)
+    {
+        if(NameMatchesReference(refName, ref))
+            return ref;
+    }
+    return nullptr;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForInImmediateScope(String refName, Scope* scope)
+{
+    TEST_Tracer("ReferenceForInImmediateScope");
+    methodHitMap["ReferenceForInImmediateScope"]++;
+    if(FunctionInjections.count("ReferenceForInImmediateScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["ReferenceForInImmediateScope"](p);
+    }
+    return ReferenceForInImmediateScope_INTERNAL(refName, scope);
+}
+
+
+bool ObjectsIndexContains(int value, Object** foundObj);
+
+bool ObjectsIndexContains_INTERNAL(int value, Object** foundObj)
+{
+    for(auto map: ObjectsIndex)
+    {
+        if(map.IndexedObject->Class == IntegerClass && *static_cast<int*>(map.IndexedObject->Value) == value)
+        {
+            *foundObj = map.IndexedObject;
+            return true;
+        }
+    }
+
+    *foundObj = ObjectConstructor(IntegerClass, ObjectValueConstructor(value));
+    return false;
+}
+
+// generated by TestBuilder
+bool ObjectsIndexContains(int value, Object** foundObj)
+{
+    TEST_Tracer("ObjectsIndexContains");
+    methodHitMap["ObjectsIndexContains"]++;
+    if(FunctionInjections.count("ObjectsIndexContains") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&foundObj));
+    FunctionInjections["ObjectsIndexContains"](p);
+    }
+    return ObjectsIndexContains_INTERNAL(value, foundObj);
+}
+
+
+bool ObjectsIndexContains(double value, Object** foundObj);
+
+bool ObjectsIndexContains_INTERNAL(double value, Object** foundObj)
+{
+    for(auto map: ObjectsIndex)
+    {
+        if(map.IndexedObject->Class == DecimalClass && *static_cast<double*>(map.IndexedObject->Value) == value)
+        {
+            *foundObj = map.IndexedObject;
+            return true;
+        }
+    }
+
+    *foundObj = ObjectConstructor(DecimalClass, ObjectValueConstructor(value));
+    return false;
+}
+
+// generated by TestBuilder
+bool ObjectsIndexContains(double value, Object** foundObj)
+{
+    TEST_Tracer("ObjectsIndexContains");
+    methodHitMap["ObjectsIndexContains"]++;
+    if(FunctionInjections.count("ObjectsIndexContains") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&foundObj));
+    FunctionInjections["ObjectsIndexContains"](p);
+    }
+    return ObjectsIndexContains_INTERNAL(value, foundObj);
+}
+
+
+bool ObjectsIndexContains(String& value, Object** foundObj);
+
+bool ObjectsIndexContains_INTERNAL(String& value, Object** foundObj)
+{
+    for(auto map: ObjectsIndex)
+    {
+        if(map.IndexedObject->Class == StringClass && *static_cast<String*>(map.IndexedObject->Value) == value)
+        {
+            *foundObj = map.IndexedObject;
+            return true;
+        }
+    }
+    *foundObj = ObjectConstructor(StringClass, ObjectValueConstructor(value));
+    return false;
+}
+
+// generated by TestBuilder
+bool ObjectsIndexContains(String& value, Object** foundObj)
+{
+    TEST_Tracer("ObjectsIndexContains");
+    methodHitMap["ObjectsIndexContains"]++;
+    if(FunctionInjections.count("ObjectsIndexContains") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&foundObj));
+    FunctionInjections["ObjectsIndexContains"](p);
+    }
+    return ObjectsIndexContains_INTERNAL(value, foundObj);
+}
+
+
+bool ObjectsIndexContains(bool value, Object** foundObj);
+
+bool ObjectsIndexContains_INTERNAL(bool value, Object** foundObj)
+{
+    for(auto map: ObjectsIndex)
+    {
+        if(map.IndexedObject->Class == BooleanClass && *static_cast<bool*>(map.IndexedObject->Value) == value)
+        {
+            *foundObj = map.IndexedObject;
+            return true;
+        }
+    }
+
+    *foundObj = ObjectConstructor(BooleanClass, ObjectValueConstructor(value));
+    return false;
+}
+
+// generated by TestBuilder
+bool ObjectsIndexContains(bool value, Object** foundObj)
+{
+    TEST_Tracer("ObjectsIndexContains");
+    methodHitMap["ObjectsIndexContains"]++;
+    if(FunctionInjections.count("ObjectsIndexContains") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&foundObj));
+    FunctionInjections["ObjectsIndexContains"](p);
+    }
+    return ObjectsIndexContains_INTERNAL(value, foundObj);
+}
+
+
+Reference* ReferenceForPrimitiveObject(String refName, int value);
+
+Reference* ReferenceForPrimitiveObject_INTERNAL(String refName, int value)
+{
+    Object* obj;
+    ObjectsIndexContains(value, &obj);
+    Reference* ref = ReferenceConstructor(refName, obj);
+    AddReferenceToCurrentScope(ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForPrimitiveObject(String refName, int value)
+{
+    TEST_Tracer("ReferenceForPrimitiveObject");
+    methodHitMap["ReferenceForPrimitiveObject"]++;
+    if(FunctionInjections.count("ReferenceForPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ReferenceForPrimitiveObject"](p);
+    }
+    return ReferenceForPrimitiveObject_INTERNAL(refName, value);
+}
+
+
+Reference* ReferenceForPrimitiveObject(String refName, bool value);
+
+Reference* ReferenceForPrimitiveObject_INTERNAL(String refName, bool value)
+{
+    Object* obj;
+    ObjectsIndexContains(value, &obj);
+    Reference* ref = ReferenceConstructor(refName, obj);
+    AddReferenceToCurrentScope(ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForPrimitiveObject(String refName, bool value)
+{
+    TEST_Tracer("ReferenceForPrimitiveObject");
+    methodHitMap["ReferenceForPrimitiveObject"]++;
+    if(FunctionInjections.count("ReferenceForPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ReferenceForPrimitiveObject"](p);
+    }
+    return ReferenceForPrimitiveObject_INTERNAL(refName, value);
+}
+
+
+Reference* ReferenceForPrimitiveObject(String refName, String value);
+
+Reference* ReferenceForPrimitiveObject_INTERNAL(String refName, String value)
+{
+    Object* obj;
+    ObjectsIndexContains(value, &obj);
+    Reference* ref = ReferenceConstructor(refName, obj);
+    AddReferenceToCurrentScope(ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForPrimitiveObject(String refName, String value)
+{
+    TEST_Tracer("ReferenceForPrimitiveObject");
+    methodHitMap["ReferenceForPrimitiveObject"]++;
+    if(FunctionInjections.count("ReferenceForPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ReferenceForPrimitiveObject"](p);
+    }
+    return ReferenceForPrimitiveObject_INTERNAL(refName, value);
+}
+
+
+Reference* ReferenceForPrimitiveObject(String refName, double value);
+
+Reference* ReferenceForPrimitiveObject_INTERNAL(String refName, double value)
+{
+    Object* obj;
+    ObjectsIndexContains(value, &obj);
+    Reference* ref = ReferenceConstructor(refName, obj);
+    AddReferenceToCurrentScope(ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForPrimitiveObject(String refName, double value)
+{
+    TEST_Tracer("ReferenceForPrimitiveObject");
+    methodHitMap["ReferenceForPrimitiveObject"]++;
+    if(FunctionInjections.count("ReferenceForPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ReferenceForPrimitiveObject"](p);
+    }
+    return ReferenceForPrimitiveObject_INTERNAL(refName, value);
+}
+
+
+Reference* ReferenceForNewObject(String refName, ObjectClass cls, void* value);
+
+Reference* ReferenceForNewObject_INTERNAL(String refName, ObjectClass cls, void* value)
+{
+    Object* obj = ObjectConstructor(cls, value);
+    Reference* ref = ReferenceConstructor(refName, obj);
+    AddReferenceToCurrentScope(ref);
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForNewObject(String refName, ObjectClass cls, void* value)
+{
+    TEST_Tracer("ReferenceForNewObject");
+    methodHitMap["ReferenceForNewObject"]++;
+    if(FunctionInjections.count("ReferenceForNewObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&cls));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ReferenceForNewObject"](p);
+    }
+    return ReferenceForNewObject_INTERNAL(refName, cls, value);
+}
+
+
+
+
+Reference* ReferenceForExistingObject(String refName, Object* obj);
+
+Reference* ReferenceForExistingObject_INTERNAL(String refName, Object* obj)
+{
+    Reference* ref = CreateReference(refName, obj);
+    AddReferenceToCurrentScope(ref);
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceForExistingObject(String refName, Object* obj)
+{
+    TEST_Tracer("ReferenceForExistingObject");
+    methodHitMap["ReferenceForExistingObject"]++;
+    if(FunctionInjections.count("ReferenceForExistingObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ReferenceForExistingObject"](p);
+    }
+    return ReferenceForExistingObject_INTERNAL(refName, obj);
+}
+
+
+void ReassignReference(Reference* ref, Object* to);
+
+void ReassignReference_INTERNAL(Reference* ref, Object* to)
+{
+    RemoveReferenceFromObjectIndex(ref);
+    IndexObject(to, ref);
+    
+    ref->To = to;
+}
+
+// generated by TestBuilder
+void ReassignReference(Reference* ref, Object* to)
+{
+    TEST_Tracer("ReassignReference");
+    methodHitMap["ReassignReference"]++;
+    if(FunctionInjections.count("ReassignReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    p.push_back(static_cast<const void*>(&to));
+    FunctionInjections["ReassignReference"](p);
+    }
+    ReassignReference_INTERNAL(ref, to);
+}
+
+
+
+
+
+Reference* NullReference(String refName);
+
+Reference* NullReference_INTERNAL(String refName)
+{
+    Reference* ref = CreateNullReference(refName);
+    AddReferenceToCurrentScope(ref);
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* NullReference(String refName)
+{
+    TEST_Tracer("NullReference");
+    methodHitMap["NullReference"]++;
+    if(FunctionInjections.count("NullReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    FunctionInjections["NullReference"](p);
+    }
+    return NullReference_INTERNAL(refName);
+}
+
+
+Reference* NullReference();
+
+Reference* NullReference_INTERNAL()
+{
+    return NullReference(c_temporaryReferenceName);
+}
+
+// generated by TestBuilder
+Reference* NullReference()
+{
+    TEST_Tracer("NullReference");
+    methodHitMap["NullReference"]++;
+    if(FunctionInjections.count("NullReference") == 1){
+    Params p;
+    FunctionInjections["NullReference"](p);
+    }
+    return NullReference_INTERNAL();
+}
+
+
+bool IsNullReference(const Reference* ref);
+
+bool IsNullReference_INTERNAL(const Reference* ref)
+{
+    return (ObjectOf(ref) != nullptr && ObjectOf(ref) == NullObject());
+}
+
+// generated by TestBuilder
+bool IsNullReference(const Reference* ref)
+{
+    TEST_Tracer("IsNullReference");
+    methodHitMap["IsNullReference"]++;
+    if(FunctionInjections.count("IsNullReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsNullReference"](p);
+    }
+    return IsNullReference_INTERNAL(ref);
+}
+
+
+void AssignToNull(Reference* ref);
+
+void AssignToNull_INTERNAL(Reference* ref)
+{
+    RemoveReferenceFromObjectIndex(ref);
+    IndexObject(NullObject(), ref);
+    ref->To = NullObject();
+}
+
+// generated by TestBuilder
+void AssignToNull(Reference* ref)
+{
+    TEST_Tracer("AssignToNull");
+    methodHitMap["AssignToNull"]++;
+    if(FunctionInjections.count("AssignToNull") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["AssignToNull"](p);
+    }
+    AssignToNull_INTERNAL(ref);
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+using namespace utils;
+
+static Stack<Scope*> ScopeStack;
+
+
+Scope* CurrentScope();
+
+Scope* CurrentScope_INTERNAL()
+{
+    return ScopeStack.Peek();
+}
+
+// generated by TestBuilder
+Scope* CurrentScope()
+{
+    TEST_Tracer("CurrentScope");
+    methodHitMap["CurrentScope"]++;
+    if(FunctionInjections.count("CurrentScope") == 1){
+    Params p;
+    FunctionInjections["CurrentScope"](p);
+    }
+    return CurrentScope_INTERNAL();
+}
+
+
+void EnterScope(Scope* newScope);
+
+void EnterScope_INTERNAL(Scope* newScope)
+{
+    ScopeStack.Push(newScope);
+}
+
+// generated by TestBuilder
+void EnterScope(Scope* newScope)
+{
+    TEST_Tracer("EnterScope");
+    methodHitMap["EnterScope"]++;
+    if(FunctionInjections.count("EnterScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&newScope));
+    FunctionInjections["EnterScope"](p);
+    }
+    EnterScope_INTERNAL(newScope);
+}
+
+
+void ExitScope(bool andDestroy);
+
+void ExitScope_INTERNAL(bool andDestroy)
+{
+    auto scope = ScopeStack.Pop();
+    if(andDestroy)
+        ScopeDestructor(WalkerScopeSlab, scope);
+}
+
+// generated by TestBuilder
+void ExitScope(bool andDestroy)
+{
+    TEST_Tracer("ExitScope");
+    methodHitMap["ExitScope"]++;
+    if(FunctionInjections.count("ExitScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&andDestroy));
+    FunctionInjections["ExitScope"](p);
+    }
+    ExitScope_INTERNAL(andDestroy);
+}
+
+
+void AddReferenceToCurrentScope(Reference* ref);
+
+void AddReferenceToCurrentScope_INTERNAL(Reference* ref)
+{
+    if(CurrentScope() == nullptr)
+    {
+        LogIt(LogSeverityType::Sev2_Important, "AddReferenceToCurrentScope", "current scope is not set");
+        return;
+    }
+    CurrentScope()->ReferencesIndex.push_back(ref);
+}
+
+// generated by TestBuilder
+void AddReferenceToCurrentScope(Reference* ref)
+{
+    TEST_Tracer("AddReferenceToCurrentScope");
+    methodHitMap["AddReferenceToCurrentScope"]++;
+    if(FunctionInjections.count("AddReferenceToCurrentScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["AddReferenceToCurrentScope"](p);
+    }
+    AddReferenceToCurrentScope_INTERNAL(ref);
+}
+
+
+bool ScopeStackIsEmpty();
+
+bool ScopeStackIsEmpty_INTERNAL()
+{
+    return ScopeStack.Size() == 0;
+}
+
+// generated by TestBuilder
+bool ScopeStackIsEmpty()
+{
+    TEST_Tracer("ScopeStackIsEmpty");
+    methodHitMap["ScopeStackIsEmpty"]++;
+    if(FunctionInjections.count("ScopeStackIsEmpty") == 1){
+    Params p;
+    FunctionInjections["ScopeStackIsEmpty"](p);
+    }
+    return ScopeStackIsEmpty_INTERNAL();
+}
+
+
+void WipeScope(Scope* scope);
+
+void WipeScope_INTERNAL(Scope* scope)
+{
+    for(auto ref: scope->ReferencesIndex)
+    {
+        RemoveReferenceFromObjectIndex(ref);
+        ReferenceDestructor(ref);
+    }
+    ScopeDestructor(WalkerScopeSlab, scope);
+}
+
+// generated by TestBuilder
+void WipeScope(Scope* scope)
+{
+    TEST_Tracer("WipeScope");
+    methodHitMap["WipeScope"]++;
+    if(FunctionInjections.count("WipeScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["WipeScope"](p);
+    }
+    WipeScope_INTERNAL(scope);
+}
+
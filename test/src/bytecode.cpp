@@ -0,0 +1,3988 @@
+#include "test.h"
+#include "bytecode.h"
+
+#include "vm.h"
+#include "errormsg.h"
+#include "flattener.h"
+
+#include "main.h"
+#include "program.h"
+#include "scope.h"
+#include "diagnostics.h"
+#include "call.h"
+#include "scope.h"
+#include "value.h"
+
+#include <algorithm>
+#include <type_traits>
+
+
+
+
+inline Scope* InternalScopeConstructor(PebbleVM* vm, Scope* inheritedScope);
+
+inline Scope* InternalScopeConstructor_INTERNAL(PebbleVM* vm, Scope* inheritedScope)
+{
+    auto scope = ScopeConstructor(vm->ScopeSlab, inheritedScope);
+    AddRuntimeScope(vm, scope);
+
+    return scope;
+}
+
+// generated by TestBuilder
+inline Scope* InternalScopeConstructor(PebbleVM* vm, Scope* inheritedScope)
+{
+    TEST_Tracer("InternalScopeConstructor");
+    methodHitMap["InternalScopeConstructor"]++;
+    if(FunctionInjections.count("InternalScopeConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&inheritedScope));
+    FunctionInjections["InternalScopeConstructor"](p);
+    }
+    return InternalScopeConstructor_INTERNAL(vm, inheritedScope);
+}
+
+
+inline Scope* InternalCopyScope(PebbleVM* vm, Scope* scopeToCopy);
+
+inline Scope* InternalCopyScope_INTERNAL(PebbleVM* vm, Scope* scopeToCopy)
+{
+    Scope* scope;
+    if(scopeToCopy == &NothingScope)
+    {
+        scope = &NothingScope;
+    }
+    else
+    {
+        scope = CopyScope(scopeToCopy, vm->ScopeSlab, vm->CallSlab);
+        AddRuntimeScope(vm, scope);
+        for(auto call: scope->CallsIndex)
+        {
+            AddRuntimeCall(vm, call);
+        }
+        for(auto call: scope->Elements)
+        {
+            AddRuntimeCall(vm, call);
+        }
+    }
+
+    return scope;
+}
+
+// generated by TestBuilder
+inline Scope* InternalCopyScope(PebbleVM* vm, Scope* scopeToCopy)
+{
+    TEST_Tracer("InternalCopyScope");
+    methodHitMap["InternalCopyScope"]++;
+    if(FunctionInjections.count("InternalCopyScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&scopeToCopy));
+    FunctionInjections["InternalCopyScope"](p);
+    }
+    return InternalCopyScope_INTERNAL(vm, scopeToCopy);
+}
+
+inline Call* InternalCallConstructor(PebbleVM* vm, const String* name=nullptr)
+{
+    Call* call = CallConstructor(vm->CallSlab, name);
+    BindScope(call, &NothingScope);
+    BindType(call, &NothingType);
+    AddRuntimeCall(vm, call);
+
+    return call;
+}
+
+
+inline Call* InternalSharedPrimitiveCallConstructor(PebbleVM* vm);
+
+inline Call* InternalSharedPrimitiveCallConstructor_INTERNAL(PebbleVM* vm)
+{
+    auto call = InternalCallConstructor(vm);
+    BindScope(call, &SomethingScope);
+    return call;
+}
+
+// generated by TestBuilder
+inline Call* InternalSharedPrimitiveCallConstructor(PebbleVM* vm)
+{
+    TEST_Tracer("InternalSharedPrimitiveCallConstructor");
+    methodHitMap["InternalSharedPrimitiveCallConstructor"]++;
+    if(FunctionInjections.count("InternalSharedPrimitiveCallConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["InternalSharedPrimitiveCallConstructor"](p);
+    }
+    return InternalSharedPrimitiveCallConstructor_INTERNAL(vm);
+}
+
+
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, int value);
+
+Call* InternalPrimitiveCallConstructor_INTERNAL(PebbleVM* vm, int value)
+{
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
+    {
+        return foundCall;
+    }
+
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &IntegerType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
+}
+
+// generated by TestBuilder
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, int value)
+{
+    TEST_Tracer("InternalPrimitiveCallConstructor");
+    methodHitMap["InternalPrimitiveCallConstructor"]++;
+    if(FunctionInjections.count("InternalPrimitiveCallConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["InternalPrimitiveCallConstructor"](p);
+    }
+    return InternalPrimitiveCallConstructor_INTERNAL(vm, value);
+}
+
+
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, double value);
+
+Call* InternalPrimitiveCallConstructor_INTERNAL(PebbleVM* vm, double value)
+{
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
+    {
+        return foundCall;
+    }
+
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &DecimalType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
+}
+
+// generated by TestBuilder
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, double value)
+{
+    TEST_Tracer("InternalPrimitiveCallConstructor");
+    methodHitMap["InternalPrimitiveCallConstructor"]++;
+    if(FunctionInjections.count("InternalPrimitiveCallConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["InternalPrimitiveCallConstructor"](p);
+    }
+    return InternalPrimitiveCallConstructor_INTERNAL(vm, value);
+}
+
+
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, bool value);
+
+Call* InternalPrimitiveCallConstructor_INTERNAL(PebbleVM* vm, bool value)
+{
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
+    {
+        return foundCall;
+    }
+
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &BooleanType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
+}
+
+// generated by TestBuilder
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, bool value)
+{
+    TEST_Tracer("InternalPrimitiveCallConstructor");
+    methodHitMap["InternalPrimitiveCallConstructor"]++;
+    if(FunctionInjections.count("InternalPrimitiveCallConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["InternalPrimitiveCallConstructor"](p);
+    }
+    return InternalPrimitiveCallConstructor_INTERNAL(vm, value);
+}
+
+
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, String& value);
+
+Call* InternalPrimitiveCallConstructor_INTERNAL(PebbleVM* vm, String& value)
+{
+    Call* foundCall = FindPrimitiveCall(vm, value);
+    if(foundCall != nullptr)
+    {
+        return foundCall;
+    }
+
+    Call* call = InternalSharedPrimitiveCallConstructor(vm);
+    BindType(call, &StringType);
+    AssignValue(call->BoundValue, value);
+    AddPrimitiveCall(vm, call);
+
+    return call;
+}
+
+// generated by TestBuilder
+Call* InternalPrimitiveCallConstructor(PebbleVM* vm, String& value)
+{
+    TEST_Tracer("InternalPrimitiveCallConstructor");
+    methodHitMap["InternalPrimitiveCallConstructor"]++;
+    if(FunctionInjections.count("InternalPrimitiveCallConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["InternalPrimitiveCallConstructor"](p);
+    }
+    return InternalPrimitiveCallConstructor_INTERNAL(vm, value);
+}
+
+
+Call* InternalCopyCall(PebbleVM* vm, const Call* call);
+
+Call* InternalCopyCall_INTERNAL(PebbleVM* vm, const Call* call)
+{
+    if(call == &NothingCall)
+    {
+        return &NothingCall;
+    }
+    
+    auto callCopy = InternalCallConstructor(vm);
+    
+    auto scp = InternalCopyScope(vm, call->BoundScope);
+    BindScope(callCopy, scp);
+    BindType(callCopy, call->BoundType);
+    BindSection(callCopy, call->BoundSection);
+    EnforceCallType(callCopy, call->CallType);
+    callCopy->NumberOfParameters = call->NumberOfParameters;
+
+    return callCopy;
+}
+
+// generated by TestBuilder
+Call* InternalCopyCall(PebbleVM* vm, const Call* call)
+{
+    TEST_Tracer("InternalCopyCall");
+    methodHitMap["InternalCopyCall"]++;
+    if(FunctionInjections.count("InternalCopyCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["InternalCopyCall"](p);
+    }
+    return InternalCopyCall_INTERNAL(vm, call);
+}
+
+
+
+extArg_t IndexOfNop();
+
+extArg_t IndexOfNop_INTERNAL()
+{
+    for(size_t i=0; i<BCI_NumberOfInstructions; i++)
+    {
+        if(BCI_Instructions[i] == BCI_NOP)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// generated by TestBuilder
+extArg_t IndexOfNop()
+{
+    TEST_Tracer("IndexOfNop");
+    methodHitMap["IndexOfNop"]++;
+    if(FunctionInjections.count("IndexOfNop") == 1){
+    Params p;
+    FunctionInjections["IndexOfNop"](p);
+    }
+    return IndexOfNop_INTERNAL();
+}
+
+
+int IndexOfInstruction(BCI_Method bci);
+
+int IndexOfInstruction_INTERNAL(BCI_Method bci)
+{
+    for(size_t i=0; i<BCI_NumberOfInstructions; i++)
+    {
+        if(BCI_Instructions[i] == bci)
+        {
+            return i;
+        }
+    }
+    LogIt(LogSeverityType::Sev3_Critical, "IndexOfInstruction", "instruction not found, returned NOP");
+    return IndexOfNop();
+}
+
+// generated by TestBuilder
+int IndexOfInstruction(BCI_Method bci)
+{
+    TEST_Tracer("IndexOfInstruction");
+    methodHitMap["IndexOfInstruction"]++;
+    if(FunctionInjections.count("IndexOfInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&bci));
+    FunctionInjections["IndexOfInstruction"](p);
+    }
+    return IndexOfInstruction_INTERNAL(bci);
+}
+
+
+
+BCI_Method BCI_Instructions[] = {
+    BCI_LoadCallName,
+    BCI_LoadPrimitive,
+    BCI_Assign,
+    BCI_Add,
+    BCI_Subtract,
+
+    BCI_Multiply,
+    BCI_Divide,
+    BCI_SysCall,
+    BCI_And,
+    BCI_Or,
+    
+    BCI_Not,
+    BCI_NotEquals,
+    BCI_Equals,
+    BCI_Cmp,
+    BCI_LoadCmp,
+
+    BCI_JumpFalse,
+    BCI_Jump,
+    BCI_Copy,
+    BCI_BindType,
+    BCI_ResolveDirect,
+
+    BCI_ResolveScoped,
+    BCI_BindScope,
+    BCI_BindSection,
+    BCI_EvalHere,
+    BCI_Eval,
+
+    BCI_Return,
+    BCI_Array,
+    BCI_EnterLocal,
+    BCI_LeaveLocal,
+    BCI_NOP,
+
+    BCI_Dup,
+    BCI_EndLine,
+    BCI_DropTOS,
+    BCI_Is,
+    BCI_LoadLocal,
+
+    BCI_StoreLocal,
+    BCI_ResolveName,
+    BCI_AddConst,
+    BCI_SubtractConst,
+    BCI_CmpJumpFalse,
+
+    BCI_TailEval,
+};
+
+const char* const BCI_InstructionNames[] = {
+    "BCI_LoadCallName",
+    "BCI_LoadPrimitive",
+    "BCI_Assign",
+    "BCI_Add",
+    "BCI_Subtract",
+
+    "BCI_Multiply",
+    "BCI_Divide",
+    "BCI_SysCall",
+    "BCI_And",
+    "BCI_Or",
+    
+    "BCI_Not",
+    "BCI_NotEquals",
+    "BCI_Equals",
+    "BCI_Cmp",
+    "BCI_LoadCmp",
+
+    "BCI_JumpFalse",
+    "BCI_Jump",
+    "BCI_Copy",
+    "BCI_BindType",
+    "BCI_ResolveDirect",
+
+    "BCI_ResolveScoped",
+    "BCI_BindScope",
+    "BCI_BindSection",
+    "BCI_EvalHere",
+    "BCI_Eval",
+
+    "BCI_Return",
+    "BCI_Array",
+    "BCI_EnterLocal",
+    "BCI_LeaveLocal",
+    "BCI_NOP",
+
+    "BCI_Dup",
+    "BCI_EndLine",
+    "BCI_DropTOS",
+    "BCI_Is",
+    "BCI_LoadLocal",
+
+    "BCI_StoreLocal",
+    "BCI_ResolveName",
+    "BCI_AddConst",
+    "BCI_SubtractConst",
+    "BCI_CmpJumpFalse",
+
+    "BCI_TailEval",
+};
+
+
+
+
+constexpr uintptr_t ImmediateTagMask = 0x3;
+
+constexpr int ImmediateTagBits = 2;
+
+constexpr uintptr_t IntegerImmediateTag = 0x1;
+
+constexpr uintptr_t BooleanImmediateTag = 0x2;
+
+
+inline bool IsImmediate(const void* word);
+
+inline bool IsImmediate_INTERNAL(const void* word)
+{
+    static_assert(std::alignment_of<Call>::value > ImmediateTagMask, "a Call pointer must leave the tag bits clear");
+    static_assert(std::alignment_of<Scope>::value > ImmediateTagMask, "a Scope pointer must leave the tag bits clear");
+    static_assert(std::alignment_of<String>::value > ImmediateTagMask, "a String pointer must leave the tag bits clear");
+
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) != 0;
+}
+
+// generated by TestBuilder
+inline bool IsImmediate(const void* word)
+{
+    TEST_Tracer("IsImmediate");
+    methodHitMap["IsImmediate"]++;
+    if(FunctionInjections.count("IsImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["IsImmediate"](p);
+    }
+    return IsImmediate_INTERNAL(word);
+}
+
+
+inline bool IsIntegerImmediate(const void* word);
+
+inline bool IsIntegerImmediate_INTERNAL(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) == IntegerImmediateTag;
+}
+
+// generated by TestBuilder
+inline bool IsIntegerImmediate(const void* word)
+{
+    TEST_Tracer("IsIntegerImmediate");
+    methodHitMap["IsIntegerImmediate"]++;
+    if(FunctionInjections.count("IsIntegerImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["IsIntegerImmediate"](p);
+    }
+    return IsIntegerImmediate_INTERNAL(word);
+}
+
+
+inline bool IsBooleanImmediate(const void* word);
+
+inline bool IsBooleanImmediate_INTERNAL(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) & ImmediateTagMask) == BooleanImmediateTag;
+}
+
+// generated by TestBuilder
+inline bool IsBooleanImmediate(const void* word)
+{
+    TEST_Tracer("IsBooleanImmediate");
+    methodHitMap["IsBooleanImmediate"]++;
+    if(FunctionInjections.count("IsBooleanImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["IsBooleanImmediate"](p);
+    }
+    return IsBooleanImmediate_INTERNAL(word);
+}
+
+
+inline void* IntegerImmediate(int value);
+
+inline void* IntegerImmediate_INTERNAL(int value)
+{
+    auto bits = static_cast<uintptr_t>(static_cast<intptr_t>(value));
+    return reinterpret_cast<void*>((bits << ImmediateTagBits) | IntegerImmediateTag);
+}
+
+// generated by TestBuilder
+inline void* IntegerImmediate(int value)
+{
+    TEST_Tracer("IntegerImmediate");
+    methodHitMap["IntegerImmediate"]++;
+    if(FunctionInjections.count("IntegerImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["IntegerImmediate"](p);
+    }
+    return IntegerImmediate_INTERNAL(value);
+}
+
+
+inline void* BooleanImmediate(bool value);
+
+inline void* BooleanImmediate_INTERNAL(bool value)
+{
+    auto bits = static_cast<uintptr_t>(value);
+    return reinterpret_cast<void*>((bits << ImmediateTagBits) | BooleanImmediateTag);
+}
+
+// generated by TestBuilder
+inline void* BooleanImmediate(bool value)
+{
+    TEST_Tracer("BooleanImmediate");
+    methodHitMap["BooleanImmediate"]++;
+    if(FunctionInjections.count("BooleanImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["BooleanImmediate"](p);
+    }
+    return BooleanImmediate_INTERNAL(value);
+}
+
+
+inline int IntegerOfImmediate(const void* word);
+
+inline int IntegerOfImmediate_INTERNAL(const void* word)
+{
+    return static_cast<int>(reinterpret_cast<intptr_t>(word) >> ImmediateTagBits);
+}
+
+// generated by TestBuilder
+inline int IntegerOfImmediate(const void* word)
+{
+    TEST_Tracer("IntegerOfImmediate");
+    methodHitMap["IntegerOfImmediate"]++;
+    if(FunctionInjections.count("IntegerOfImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["IntegerOfImmediate"](p);
+    }
+    return IntegerOfImmediate_INTERNAL(word);
+}
+
+
+inline bool BooleanOfImmediate(const void* word);
+
+inline bool BooleanOfImmediate_INTERNAL(const void* word)
+{
+    return (reinterpret_cast<uintptr_t>(word) >> ImmediateTagBits) != 0;
+}
+
+// generated by TestBuilder
+inline bool BooleanOfImmediate(const void* word)
+{
+    TEST_Tracer("BooleanOfImmediate");
+    methodHitMap["BooleanOfImmediate"]++;
+    if(FunctionInjections.count("BooleanOfImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["BooleanOfImmediate"](p);
+    }
+    return BooleanOfImmediate_INTERNAL(word);
+}
+
+
+inline Call* CallOfWord(PebbleVM* vm, void* word);
+
+inline Call* CallOfWord_INTERNAL(PebbleVM* vm, void* word)
+{
+    if(IsIntegerImmediate(word))
+    {
+        return InternalPrimitiveCallConstructor(vm, IntegerOfImmediate(word));
+    }
+    if(IsBooleanImmediate(word))
+    {
+        return InternalPrimitiveCallConstructor(vm, BooleanOfImmediate(word));
+    }
+    return static_cast<Call*>(word);
+}
+
+// generated by TestBuilder
+inline Call* CallOfWord(PebbleVM* vm, void* word)
+{
+    TEST_Tracer("CallOfWord");
+    methodHitMap["CallOfWord"]++;
+    if(FunctionInjections.count("CallOfWord") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["CallOfWord"](p);
+    }
+    return CallOfWord_INTERNAL(vm, word);
+}
+
+
+inline bool IntegerOfWord(const void* word, int& value);
+
+inline bool IntegerOfWord_INTERNAL(const void* word, int& value)
+{
+    if(IsIntegerImmediate(word))
+    {
+        value = IntegerOfImmediate(word);
+        return true;
+    }
+    if(IsImmediate(word))
+    {
+        return false;
+    }
+
+    auto call = static_cast<const Call*>(word);
+    if(Strictly(&IntegerType, call))
+    {
+        value = IntegerValueOf(call);
+        return true;
+    }
+    return false;
+}
+
+// generated by TestBuilder
+inline bool IntegerOfWord(const void* word, int& value)
+{
+    TEST_Tracer("IntegerOfWord");
+    methodHitMap["IntegerOfWord"]++;
+    if(FunctionInjections.count("IntegerOfWord") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&word));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["IntegerOfWord"](p);
+    }
+    return IntegerOfWord_INTERNAL(word, value);
+}
+
+
+inline void BindImmediate(Call* call, const void* word);
+
+inline void BindImmediate_INTERNAL(Call* call, const void* word)
+{
+    call->Name = nullptr;
+    call->BoundSection = 0;
+    call->BoundScope = &SomethingScope;
+    call->CallType = nullptr;
+    call->BoundValue.s = 0;
+    call->NumberOfParameters = 0;
+
+    if(IsIntegerImmediate(word))
+    {
+        call->BoundType = &IntegerType;
+        AssignValue(call->BoundValue, IntegerOfImmediate(word));
+    }
+    else
+    {
+        call->BoundType = &BooleanType;
+        AssignValue(call->BoundValue, BooleanOfImmediate(word));
+    }
+}
+
+// generated by TestBuilder
+inline void BindImmediate(Call* call, const void* word)
+{
+    TEST_Tracer("BindImmediate");
+    methodHitMap["BindImmediate"]++;
+    if(FunctionInjections.count("BindImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["BindImmediate"](p);
+    }
+    BindImmediate_INTERNAL(call, word);
+}
+
+
+
+
+
+template <typename T>
+inline T* PopTOS(PebbleVM* vm)
+{
+    void* tos = vm->MemoryStack.back();
+    vm->MemoryStack.pop_back();
+    if constexpr (std::is_same<T, Call>::value)
+    {
+        return CallOfWord(vm, tos);
+    }
+    return static_cast<T*>(tos);
+}
+
+
+template <typename T>
+inline void PushTOS(PebbleVM* vm, T* entity)
+{
+    vm->MemoryStack.push_back(static_cast<void*>(entity));
+}
+
+
+template <typename T>
+inline T* PeekTOS(PebbleVM* vm, size_t depth=0)
+{
+    auto& word = vm->MemoryStack[vm->MemoryStack.size() - 1 - depth];
+    if constexpr (std::is_same<T, Call>::value)
+    {
+        word = CallOfWord(vm, word);
+    }
+    return static_cast<T*>(word);
+}
+
+
+inline void DropFromTOS(PebbleVM* vm, size_t n);
+
+inline void DropFromTOS_INTERNAL(PebbleVM* vm, size_t n)
+{
+    vm->MemoryStack.resize(vm->MemoryStack.size() - n);
+}
+
+// generated by TestBuilder
+inline void DropFromTOS(PebbleVM* vm, size_t n)
+{
+    TEST_Tracer("DropFromTOS");
+    methodHitMap["DropFromTOS"]++;
+    if(FunctionInjections.count("DropFromTOS") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&n));
+    FunctionInjections["DropFromTOS"](p);
+    }
+    DropFromTOS_INTERNAL(vm, n);
+}
+
+
+inline size_t MemoryStackSize(PebbleVM* vm);
+
+inline size_t MemoryStackSize_INTERNAL(PebbleVM* vm)
+{
+    return vm->MemoryStack.size();
+}
+
+// generated by TestBuilder
+inline size_t MemoryStackSize(PebbleVM* vm)
+{
+    TEST_Tracer("MemoryStackSize");
+    methodHitMap["MemoryStackSize"]++;
+    if(FunctionInjections.count("MemoryStackSize") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["MemoryStackSize"](p);
+    }
+    return MemoryStackSize_INTERNAL(vm);
+}
+
+
+
+
+inline Call* FindInScopeOnlyImmediate(Scope* scope, const String* callName);
+
+inline Call* FindInScopeOnlyImmediate_INTERNAL(Scope* scope, const String* callName)
+{
+    return scope->CallsIndex.Find(callName);
+}
+
+// generated by TestBuilder
+inline Call* FindInScopeOnlyImmediate(Scope* scope, const String* callName)
+{
+    TEST_Tracer("FindInScopeOnlyImmediate");
+    methodHitMap["FindInScopeOnlyImmediate"]++;
+    if(FunctionInjections.count("FindInScopeOnlyImmediate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    p.push_back(static_cast<const void*>(&callName));
+    FunctionInjections["FindInScopeOnlyImmediate"](p);
+    }
+    return FindInScopeOnlyImmediate_INTERNAL(scope, callName);
+}
+
+
+inline Call* FindInScopeChain(Scope* scope, const String* callName);
+
+inline Call* FindInScopeChain_INTERNAL(Scope* scope, const String* callName)
+{
+    for(auto s = scope; s != nullptr; s = s->InheritedScope)
+    {
+        auto call = s->CallsIndex.Find(callName);
+        if(call != nullptr)
+            return call;
+    }
+    return nullptr;
+}
+
+// generated by TestBuilder
+inline Call* FindInScopeChain(Scope* scope, const String* callName)
+{
+    TEST_Tracer("FindInScopeChain");
+    methodHitMap["FindInScopeChain"]++;
+    if(FunctionInjections.count("FindInScopeChain") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    p.push_back(static_cast<const void*>(&callName));
+    FunctionInjections["FindInScopeChain"](p);
+    }
+    return FindInScopeChain_INTERNAL(scope, callName);
+}
+
+
+inline Call* FindInLocalSlot(PebbleVM* vm, const LocalSlot& slot);
+
+inline Call* FindInLocalSlot_INTERNAL(PebbleVM* vm, const LocalSlot& slot)
+{
+    auto& calls = vm->SelfReg->BoundScope->CallsIndex;
+    if(slot.Slot >= calls.size() || vm->LocalScopeIsDetachedReg)
+    {
+        return nullptr;
+    }
+
+    auto call = calls[slot.Slot];
+    auto callName = &vm->CallNames[slot.NameId - SIMPLE_CALLS];
+    if(call->Name != callName)
+    {
+        return nullptr;
+    }
+
+    if(vm->LocalScopeReg != vm->SelfReg->BoundScope && FindInScopeOnlyImmediate(vm->LocalScopeReg, callName) != nullptr)
+    {
+        return nullptr;
+    }
+
+    return call;
+}
+
+// generated by TestBuilder
+inline Call* FindInLocalSlot(PebbleVM* vm, const LocalSlot& slot)
+{
+    TEST_Tracer("FindInLocalSlot");
+    methodHitMap["FindInLocalSlot"]++;
+    if(FunctionInjections.count("FindInLocalSlot") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&slot));
+    FunctionInjections["FindInLocalSlot"](p);
+    }
+    return FindInLocalSlot_INTERNAL(vm, slot);
+}
+
+
+inline Scope* ScopeOf(Call* call);
+
+inline Scope* ScopeOf_INTERNAL(Call* call)
+{
+    return call->BoundScope;
+}
+
+// generated by TestBuilder
+inline Scope* ScopeOf(Call* call)
+{
+    TEST_Tracer("ScopeOf");
+    methodHitMap["ScopeOf"]++;
+    if(FunctionInjections.count("ScopeOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ScopeOf"](p);
+    }
+    return ScopeOf_INTERNAL(call);
+}
+
+
+
+
+
+inline void InternalJumpTo(PebbleVM* vm, extArg_t ins);
+
+inline void InternalJumpTo_INTERNAL(PebbleVM* vm, extArg_t ins)
+{
+    vm->InstructionReg = ins;
+    vm->JumpStatusReg = 1;
+}
+
+// generated by TestBuilder
+inline void InternalJumpTo(PebbleVM* vm, extArg_t ins)
+{
+    TEST_Tracer("InternalJumpTo");
+    methodHitMap["InternalJumpTo"]++;
+    if(FunctionInjections.count("InternalJumpTo") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ins));
+    FunctionInjections["InternalJumpTo"](p);
+    }
+    InternalJumpTo_INTERNAL(vm, ins);
+}
+
+
+void AdjustLocalScopeReg(PebbleVM* vm);
+
+void AdjustLocalScopeReg_INTERNAL(PebbleVM* vm)
+{
+    if(LocalScopeDepth(vm) == 0)
+    {
+        if(vm->SelfReg->BoundScope != &NothingScope)
+        {
+            vm->LocalScopeReg = vm->SelfReg->BoundScope;
+        }
+        else
+        {
+            vm->LocalScopeReg = vm->ProgramReg;
+        }
+
+        vm->LocalScopeIsDetachedReg = false;
+    }
+    else
+    {
+        vm->LocalScopeReg = vm->LocalScopes.back().Value;
+        vm->LocalScopeIsDetachedReg = vm->LocalScopes.back().IsDetached;
+    }
+}
+
+// generated by TestBuilder
+void AdjustLocalScopeReg(PebbleVM* vm)
+{
+    TEST_Tracer("AdjustLocalScopeReg");
+    methodHitMap["AdjustLocalScopeReg"]++;
+    if(FunctionInjections.count("AdjustLocalScopeReg") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["AdjustLocalScopeReg"](p);
+    }
+    AdjustLocalScopeReg_INTERNAL(vm);
+}
+
+
+inline void StartCallFrame(PebbleVM* vm, Call* caller, Call* self);
+
+inline void StartCallFrame_INTERNAL(PebbleVM* vm, Call* caller, Call* self)
+{
+    PushTOS<Call>(vm, caller);
+    PushTOS<Call>(vm, self);
+
+    vm->CallerReg = caller;
+    vm->SelfReg = self;
+    vm->LastResultReg = nullptr;
+    AdjustLocalScopeReg(vm);
+}
+
+// generated by TestBuilder
+inline void StartCallFrame(PebbleVM* vm, Call* caller, Call* self)
+{
+    TEST_Tracer("StartCallFrame");
+    methodHitMap["StartCallFrame"]++;
+    if(FunctionInjections.count("StartCallFrame") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&caller));
+    p.push_back(static_cast<const void*>(&self));
+    FunctionInjections["StartCallFrame"](p);
+    }
+    StartCallFrame_INTERNAL(vm, caller, self);
+}
+
+
+inline void EnterNewCallFrame(PebbleVM* vm, extArg_t callerRefId, Call* caller, Call* self);
+
+inline void EnterNewCallFrame_INTERNAL(PebbleVM* vm, extArg_t callerRefId, Call* caller, Call* self)
+{
+    extArg_t localScopesStart = vm->LocalScopes.size();
+    vm->CallStack.push_back({ vm->InstructionReg+1, MemoryStackSize(vm), callerRefId, localScopesStart, vm->LastResultReg });
+    vm->MaxCallStackSize = std::max(vm->MaxCallStackSize, vm->CallStack.size());
+    StartCallFrame(vm, caller, self);
+}
+
+// generated by TestBuilder
+inline void EnterNewCallFrame(PebbleVM* vm, extArg_t callerRefId, Call* caller, Call* self)
+{
+    TEST_Tracer("EnterNewCallFrame");
+    methodHitMap["EnterNewCallFrame"]++;
+    if(FunctionInjections.count("EnterNewCallFrame") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&callerRefId));
+    p.push_back(static_cast<const void*>(&caller));
+    p.push_back(static_cast<const void*>(&self));
+    FunctionInjections["EnterNewCallFrame"](p);
+    }
+    EnterNewCallFrame_INTERNAL(vm, callerRefId, caller, self);
+}
+
+
+inline void ReuseCallFrame(PebbleVM* vm, Call* caller, Call* self);
+
+inline void ReuseCallFrame_INTERNAL(PebbleVM* vm, Call* caller, Call* self)
+{
+    auto& frame = vm->CallStack.back();
+    vm->MemoryStack.resize(frame.MemoryStackStart);
+    vm->LocalScopes.resize(frame.LocalScopesStart);
+    StartCallFrame(vm, caller, self);
+}
+
+// generated by TestBuilder
+inline void ReuseCallFrame(PebbleVM* vm, Call* caller, Call* self)
+{
+    TEST_Tracer("ReuseCallFrame");
+    methodHitMap["ReuseCallFrame"]++;
+    if(FunctionInjections.count("ReuseCallFrame") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&caller));
+    p.push_back(static_cast<const void*>(&self));
+    FunctionInjections["ReuseCallFrame"](p);
+    }
+    ReuseCallFrame_INTERNAL(vm, caller, self);
+}
+
+
+
+
+
+
+inline bool CanBe(const BindingType type, const Call* call);
+
+inline bool CanBe_INTERNAL(const BindingType type, const Call* call)
+{
+    return call->BoundType == type 
+        || call->BoundType == &NothingType;
+}
+
+// generated by TestBuilder
+inline bool CanBe(const BindingType type, const Call* call)
+{
+    TEST_Tracer("CanBe");
+    methodHitMap["CanBe"]++;
+    if(FunctionInjections.count("CanBe") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["CanBe"](p);
+    }
+    return CanBe_INTERNAL(type, call);
+}
+
+
+inline bool Loosely(const BindingType type, const Call* call);
+
+inline bool Loosely_INTERNAL(const BindingType type, const Call* call)
+{
+    return call->BoundType == type;
+}
+
+// generated by TestBuilder
+inline bool Loosely(const BindingType type, const Call* call)
+{
+    TEST_Tracer("Loosely");
+    methodHitMap["Loosely"]++;
+    if(FunctionInjections.count("Loosely") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["Loosely"](p);
+    }
+    return Loosely_INTERNAL(type, call);
+}
+
+
+inline bool IsNotNothing(const Call* call);
+
+inline bool IsNotNothing_INTERNAL(const Call* call)
+{
+    return call->BoundScope != &NothingScope;
+}
+
+// generated by TestBuilder
+inline bool IsNotNothing(const Call* call)
+{
+    TEST_Tracer("IsNotNothing");
+    methodHitMap["IsNotNothing"]++;
+    if(FunctionInjections.count("IsNotNothing") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["IsNotNothing"](p);
+    }
+    return IsNotNothing_INTERNAL(call);
+}
+
+typedef bool (*TypeClassifier)(const BindingType, const Call*);
+typedef bool (*NothingTypeClassifier)(const Call*);
+
+
+inline bool Either(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2);
+
+inline bool Either_INTERNAL(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2)
+{
+    return classifiedAs(type, call1) || classifiedAs(type, call2);
+}
+
+// generated by TestBuilder
+inline bool Either(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2)
+{
+    TEST_Tracer("Either");
+    methodHitMap["Either"]++;
+    if(FunctionInjections.count("Either") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&classifiedAs));
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["Either"](p);
+    }
+    return Either_INTERNAL(classifiedAs, type, call1, call2);
+}
+
+
+inline bool Either(NothingTypeClassifier isNothing, const Call* call1, const Call* call2);
+
+inline bool Either_INTERNAL(NothingTypeClassifier isNothing, const Call* call1, const Call* call2)
+{
+    return isNothing(call1) || isNothing(call2);
+}
+
+// generated by TestBuilder
+inline bool Either(NothingTypeClassifier isNothing, const Call* call1, const Call* call2)
+{
+    TEST_Tracer("Either");
+    methodHitMap["Either"]++;
+    if(FunctionInjections.count("Either") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&isNothing));
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["Either"](p);
+    }
+    return Either_INTERNAL(isNothing, call1, call2);
+}
+
+
+inline bool Both(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2);
+
+inline bool Both_INTERNAL(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2)
+{
+    return classifiedAs(type, call1) && classifiedAs(type, call2);
+}
+
+// generated by TestBuilder
+inline bool Both(TypeClassifier classifiedAs, const BindingType type, const Call* call1, const Call* call2)
+{
+    TEST_Tracer("Both");
+    methodHitMap["Both"]++;
+    if(FunctionInjections.count("Both") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&classifiedAs));
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["Both"](p);
+    }
+    return Both_INTERNAL(classifiedAs, type, call1, call2);
+}
+
+
+inline Call* TheNothingOf(Call* call1, Call* call2);
+
+inline Call* TheNothingOf_INTERNAL(Call* call1, Call* call2)
+{
+    if(IsNothing(call1) && !IsPureNothing(call1))
+    {
+        return call1;   
+    }
+    else if(IsNothing(call2) && !IsPureNothing(call2))
+    {
+        return call2;
+    }
+
+    return &NothingCall;
+}
+
+// generated by TestBuilder
+inline Call* TheNothingOf(Call* call1, Call* call2)
+{
+    TEST_Tracer("TheNothingOf");
+    methodHitMap["TheNothingOf"]++;
+    if(FunctionInjections.count("TheNothingOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["TheNothingOf"](p);
+    }
+    return TheNothingOf_INTERNAL(call1, call2);
+}
+
+
+
+
+
+
+inline bool NthBit(uint8_t data, int n);
+
+inline bool NthBit_INTERNAL(uint8_t data, int n)
+{
+    return (data & (BitFlag << n)) >> n;
+}
+
+// generated by TestBuilder
+inline bool NthBit(uint8_t data, int n)
+{
+    TEST_Tracer("NthBit");
+    methodHitMap["NthBit"]++;
+    if(FunctionInjections.count("NthBit") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&data));
+    p.push_back(static_cast<const void*>(&n));
+    FunctionInjections["NthBit"](p);
+    }
+    return NthBit_INTERNAL(data, n);
+}
+
+
+inline void FillInRestOfComparisons(PebbleVM* vm);
+
+inline void FillInRestOfComparisons_INTERNAL(PebbleVM* vm)
+{
+    uint8_t geq = NthBit(vm->CmpReg, 2) | NthBit(vm->CmpReg, 4);
+    uint8_t leq = NthBit(vm->CmpReg, 2) | NthBit(vm->CmpReg, 3);
+
+    vm->CmpReg = vm->CmpReg | (geq << 6) | (leq << 5);
+}
+
+// generated by TestBuilder
+inline void FillInRestOfComparisons(PebbleVM* vm)
+{
+    TEST_Tracer("FillInRestOfComparisons");
+    methodHitMap["FillInRestOfComparisons"]++;
+    if(FunctionInjections.count("FillInRestOfComparisons") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["FillInRestOfComparisons"](p);
+    }
+    FillInRestOfComparisons_INTERNAL(vm);
+}
+
+
+inline void CompareIntegerValues(PebbleVM* vm, int lVal, int rVal);
+
+inline void CompareIntegerValues_INTERNAL(PebbleVM* vm, int lVal, int rVal)
+{
+    if(lVal < rVal)
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 3);
+    }
+    else if(lVal > rVal)
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 4);
+    }
+    else
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 2);
+    }
+
+    FillInRestOfComparisons(vm);
+}
+
+// generated by TestBuilder
+inline void CompareIntegerValues(PebbleVM* vm, int lVal, int rVal)
+{
+    TEST_Tracer("CompareIntegerValues");
+    methodHitMap["CompareIntegerValues"]++;
+    if(FunctionInjections.count("CompareIntegerValues") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lVal));
+    p.push_back(static_cast<const void*>(&rVal));
+    FunctionInjections["CompareIntegerValues"](p);
+    }
+    CompareIntegerValues_INTERNAL(vm, lVal, rVal);
+}
+
+
+inline void CompareIntegers(PebbleVM* vm, const Call* lhs, const Call* rhs);
+
+inline void CompareIntegers_INTERNAL(PebbleVM* vm, const Call* lhs, const Call* rhs)
+{
+    CompareIntegerValues(vm, IntegerValueOf(lhs), IntegerValueOf(rhs));
+}
+
+// generated by TestBuilder
+inline void CompareIntegers(PebbleVM* vm, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("CompareIntegers");
+    methodHitMap["CompareIntegers"]++;
+    if(FunctionInjections.count("CompareIntegers") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["CompareIntegers"](p);
+    }
+    CompareIntegers_INTERNAL(vm, lhs, rhs);
+}
+
+
+inline void CompareDecimals(PebbleVM* vm, const Call* lhs, const Call* rhs);
+
+inline void CompareDecimals_INTERNAL(PebbleVM* vm, const Call* lhs, const Call* rhs)
+{
+    double lVal = DecimalValueOf(lhs);
+    double rVal = DecimalValueOf(rhs);
+
+    if(lVal < rVal)
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 3);
+    }
+    else if(lVal > rVal)
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 4);
+    }
+    else
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 2);
+    }
+
+    FillInRestOfComparisons(vm);
+}
+
+// generated by TestBuilder
+inline void CompareDecimals(PebbleVM* vm, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("CompareDecimals");
+    methodHitMap["CompareDecimals"]++;
+    if(FunctionInjections.count("CompareDecimals") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["CompareDecimals"](p);
+    }
+    CompareDecimals_INTERNAL(vm, lhs, rhs);
+}
+
+
+
+
+
+typedef Call* (*InternalFunction)(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+
+Call* ApplyFunction(
+    PebbleVM* vm, 
+    InternalFunction func, 
+    Call* lhs, 
+    Call* rhs, 
+    BindingType* types, 
+    size_t nTypes);
+
+Call* ApplyFunction_INTERNAL(
+    PebbleVM* vm, 
+    InternalFunction func, 
+    Call* lhs, 
+    Call* rhs, 
+    BindingType* types, 
+    size_t nTypes)
+{
+    Call* call = &NothingCall;
+    for(size_t i=0; i<nTypes; i++)
+    {
+        if(Both(CanBe, types[i], lhs, rhs))
+        {
+            if(Both(Strictly, types[i], lhs, rhs))
+            {
+                call = func(vm, i, lhs, rhs);
+            }
+            else
+            {
+                call = TheNothingOf(lhs, rhs);
+            }
+
+            return call;
+        }
+    }
+
+    return nullptr;
+}
+
+// generated by TestBuilder
+Call* ApplyFunction(
+    PebbleVM* vm, 
+    InternalFunction func, 
+    Call* lhs, 
+    Call* rhs, 
+    BindingType* types, 
+    size_t nTypes)
+{
+    TEST_Tracer("ApplyFunction");
+    methodHitMap["ApplyFunction"]++;
+    if(FunctionInjections.count("ApplyFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&func));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    p.push_back(static_cast<const void*>(&types));
+    p.push_back(static_cast<const void*>(&nTypes));
+    FunctionInjections["ApplyFunction"](p);
+    }
+    return ApplyFunction_INTERNAL(vm, func, lhs, rhs, types, nTypes);
+}
+
+
+
+
+
+BindingType AddTypes[] = {
+    &IntegerType, 
+    &DecimalType, 
+    &StringType
+};
+
+size_t nAddTypes = 3;
+
+
+Call* AddFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* AddFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            int ans = IntegerValueOf(lhs) + IntegerValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        case 1:
+        {
+            double ans = DecimalValueOf(lhs) + DecimalValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans);
+            break;
+        }
+
+        case 2:
+        {
+            String ans = StringValueOf(lhs) + StringValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans);
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* AddFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("AddFunction");
+    methodHitMap["AddFunction"]++;
+    if(FunctionInjections.count("AddFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["AddFunction"](p);
+    }
+    return AddFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+BindingType GenericMathTypes[] = 
+{
+    &IntegerType,
+    &DecimalType
+};
+
+size_t nGenericMathTypes = 2;
+
+
+Call* SubtractFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* SubtractFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            int ans = IntegerValueOf(lhs) - IntegerValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        case 1:
+        {
+            double ans = DecimalValueOf(lhs) - DecimalValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans);
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* SubtractFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("SubtractFunction");
+    methodHitMap["SubtractFunction"]++;
+    if(FunctionInjections.count("SubtractFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["SubtractFunction"](p);
+    }
+    return SubtractFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+
+Call* MultiplyFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* MultiplyFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            int ans = IntegerValueOf(lhs) * IntegerValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        case 1:
+        {
+            double ans = DecimalValueOf(lhs) * DecimalValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans);
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* MultiplyFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("MultiplyFunction");
+    methodHitMap["MultiplyFunction"]++;
+    if(FunctionInjections.count("MultiplyFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["MultiplyFunction"](p);
+    }
+    return MultiplyFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+
+Call* DivideFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* DivideFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            int ans = IntegerValueOf(lhs) / IntegerValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        case 1:
+        {
+            double ans = DecimalValueOf(lhs) / DecimalValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans);
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* DivideFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("DivideFunction");
+    methodHitMap["DivideFunction"]++;
+    if(FunctionInjections.count("DivideFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["DivideFunction"](p);
+    }
+    return DivideFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+BindingType GenericBooleanTypes[] = 
+{
+    &BooleanType,
+};
+
+size_t nGenericBooleanTypes = 1;
+
+
+Call* AndFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* AndFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            bool ans = BooleanValueOf(lhs) && BooleanValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* AndFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("AndFunction");
+    methodHitMap["AndFunction"]++;
+    if(FunctionInjections.count("AndFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["AndFunction"](p);
+    }
+    return AndFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+
+Call* OrFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* OrFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            bool ans = BooleanValueOf(lhs) && BooleanValueOf(rhs);
+            call = InternalPrimitiveCallConstructor(vm, ans); 
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* OrFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("OrFunction");
+    methodHitMap["OrFunction"]++;
+    if(FunctionInjections.count("OrFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["OrFunction"](p);
+    }
+    return OrFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+
+Call* CmpFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs);
+
+Call* CmpFunction_INTERNAL(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    Call* call = &NothingCall;
+    switch(i)
+    {
+        case 0:
+        {
+            CompareIntegers(vm, lhs, rhs);
+            break;
+        }
+
+        case 1:
+        {
+            CompareDecimals(vm, lhs, rhs);
+            break;
+        }
+
+        default:
+        break;
+    }
+    
+    return call;
+}
+
+// generated by TestBuilder
+Call* CmpFunction(PebbleVM* vm, size_t i, const Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("CmpFunction");
+    methodHitMap["CmpFunction"]++;
+    if(FunctionInjections.count("CmpFunction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&i));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["CmpFunction"](p);
+    }
+    return CmpFunction_INTERNAL(vm, i, lhs, rhs);
+}
+
+
+
+
+
+
+
+inline bool IsUnassignable(const Call* call);
+
+inline bool IsUnassignable_INTERNAL(const Call* call)
+{
+    return call == &NothingCall
+        || call == &ObjectCall
+        || call == &IntegerCall
+        || call == &DecimalCall
+        || call == &StringCall
+        || call == &BooleanCall
+        || call == &ArrayCall
+        || call == &AnythingCall;
+}
+
+// generated by TestBuilder
+inline bool IsUnassignable(const Call* call)
+{
+    TEST_Tracer("IsUnassignable");
+    methodHitMap["IsUnassignable"]++;
+    if(FunctionInjections.count("IsUnassignable") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["IsUnassignable"](p);
+    }
+    return IsUnassignable_INTERNAL(call);
+}
+
+
+inline void DoInternalAssign(Call* lhs, const Call* rhs);
+
+inline void DoInternalAssign_INTERNAL(Call* lhs, const Call* rhs)
+{
+    BindType(lhs, rhs->BoundType);
+    BindSection(lhs, rhs->BoundSection);
+    BindScope(lhs, rhs->BoundScope);
+    BindValue(lhs, rhs->BoundValue);
+    lhs->NumberOfParameters = rhs->NumberOfParameters;
+
+    EnforceCallType(lhs, rhs->BoundType);
+}
+
+// generated by TestBuilder
+inline void DoInternalAssign(Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("DoInternalAssign");
+    methodHitMap["DoInternalAssign"]++;
+    if(FunctionInjections.count("DoInternalAssign") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["DoInternalAssign"](p);
+    }
+    DoInternalAssign_INTERNAL(lhs, rhs);
+}
+
+
+inline void InternalAssign(PebbleVM* vm, Call* lhs, const Call* rhs);
+
+inline void InternalAssign_INTERNAL(PebbleVM* vm, Call* lhs, const Call* rhs)
+{
+    if(IsUnassignable(lhs))
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 7, 
+            Msg("cannot reassign the global call %s", *lhs->Name));
+        return;
+    }
+
+    if(IsPureNothing(lhs) || lhs->CallType == &AnythingType)
+    {
+        DoInternalAssign(lhs, rhs);
+    }
+    else
+    {
+        
+        if(lhs->CallType == rhs->BoundType)
+        {
+            DoInternalAssign(lhs, rhs);
+        }
+        else if(IsNothing(lhs) && IsPureNothing(rhs))
+        {
+            return;
+        }
+        else
+        {
+            ReportFatalError(vm, SystemMessageType::Exception, 0,
+                Msg("cannot assign a %s to be a %s", CallTypeToString(lhs), CallTypeToString(rhs)));
+            return;
+        }
+    }
+}
+
+// generated by TestBuilder
+inline void InternalAssign(PebbleVM* vm, Call* lhs, const Call* rhs)
+{
+    TEST_Tracer("InternalAssign");
+    methodHitMap["InternalAssign"]++;
+    if(FunctionInjections.count("InternalAssign") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["InternalAssign"](p);
+    }
+    InternalAssign_INTERNAL(vm, lhs, rhs);
+}
+
+
+inline void InternalAssignWord(PebbleVM* vm, Call* lhs, void* word);
+
+inline void InternalAssignWord_INTERNAL(PebbleVM* vm, Call* lhs, void* word)
+{
+    if(IsImmediate(word))
+    {
+        Call rhs;
+        BindImmediate(&rhs, word);
+        InternalAssign(vm, lhs, &rhs);
+        return;
+    }
+
+    InternalAssign(vm, lhs, static_cast<Call*>(word));
+}
+
+// generated by TestBuilder
+inline void InternalAssignWord(PebbleVM* vm, Call* lhs, void* word)
+{
+    TEST_Tracer("InternalAssignWord");
+    methodHitMap["InternalAssignWord"]++;
+    if(FunctionInjections.count("InternalAssignWord") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&word));
+    FunctionInjections["InternalAssignWord"](p);
+    }
+    InternalAssignWord_INTERNAL(vm, lhs, word);
+}
+
+
+
+
+
+inline bool CallsHaveEqualValue(const Call* call1, const Call* call2);
+
+inline bool CallsHaveEqualValue_INTERNAL(const Call* call1, const Call* call2)
+{
+    if(Either(IsNothing, call1, call2))
+    {
+        return true;
+    }
+    else if(Both(Strictly, &IntegerType, call1, call2))
+    {
+        return call1->BoundValue.i == call2->BoundValue.i;
+    }
+    else if(Both(Strictly, &DecimalType, call1, call2))
+    {
+        return call1->BoundValue.d == call2->BoundValue.d;
+    }
+    else if(Both(Strictly, &StringType, call1, call2))
+    {
+        return call1->BoundValue.s == call2->BoundValue.s;
+    }
+    else if(Both(Strictly, &BooleanType, call1, call2))
+    {
+        return call1->BoundValue.b == call2->BoundValue.b;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+// generated by TestBuilder
+inline bool CallsHaveEqualValue(const Call* call1, const Call* call2)
+{
+    TEST_Tracer("CallsHaveEqualValue");
+    methodHitMap["CallsHaveEqualValue"]++;
+    if(FunctionInjections.count("CallsHaveEqualValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["CallsHaveEqualValue"](p);
+    }
+    return CallsHaveEqualValue_INTERNAL(call1, call2);
+}
+
+
+inline bool CallsAreEqual(const Call* call1, const Call* call2);
+
+inline bool CallsAreEqual_INTERNAL(const Call* call1, const Call* call2)
+{
+    return call1->BoundType == call2->BoundType
+        && call1->BoundScope == call2->BoundScope 
+        && call1->BoundSection == call2->BoundSection 
+        && CallsHaveEqualValue(call1, call2);
+}
+
+// generated by TestBuilder
+inline bool CallsAreEqual(const Call* call1, const Call* call2)
+{
+    TEST_Tracer("CallsAreEqual");
+    methodHitMap["CallsAreEqual"]++;
+    if(FunctionInjections.count("CallsAreEqual") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call1));
+    p.push_back(static_cast<const void*>(&call2));
+    FunctionInjections["CallsAreEqual"](p);
+    }
+    return CallsAreEqual_INTERNAL(call1, call2);
+}
+
+
+
+
+
+inline void ResolveKeywordCall(PebbleVM* vm, const String* callName);
+
+inline void ResolveKeywordCall_INTERNAL(PebbleVM* vm, const String* callName)
+{
+    Call* call = &NothingCall;
+    if(*callName == "caller")
+    {
+        call = vm->CallerReg;
+    }
+    else if(*callName == "self")
+    {
+        call = vm->SelfReg;
+    }
+    else
+    {
+        if(vm->LastResultReg == nullptr)
+        {
+            call = &NothingCall;
+        }
+        else
+        {
+            call = vm->LastResultReg;
+        }
+    }
+
+    PushTOS<Call>(vm, call);
+}
+
+// generated by TestBuilder
+inline void ResolveKeywordCall(PebbleVM* vm, const String* callName)
+{
+    TEST_Tracer("ResolveKeywordCall");
+    methodHitMap["ResolveKeywordCall"]++;
+    if(FunctionInjections.count("ResolveKeywordCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&callName));
+    FunctionInjections["ResolveKeywordCall"](p);
+    }
+    ResolveKeywordCall_INTERNAL(vm, callName);
+}
+
+
+
+
+inline void HandleArrayInitialization(PebbleVM* vm, Call* caller, Call* size);
+
+inline void HandleArrayInitialization_INTERNAL(PebbleVM* vm, Call* caller, Call* size)
+{
+    int arraySize = std::max(IntegerValueOf(size), 0);
+    auto& elements = ScopeOf(caller)->Elements;
+    elements.reserve(elements.size() + arraySize);
+    for(int i=0; i<arraySize; i++)
+    {
+        elements.push_back(InternalCallConstructor(vm, &ArrayElementCallName));
+    }
+
+    auto sizeCall = InternalCallConstructor(vm, vm->SizeCallNamePointer);
+    BindScope(sizeCall, &SomethingScope);
+    BindType(sizeCall, &IntegerType);
+    AssignValue(sizeCall->BoundValue, arraySize);
+    AddCallToScope(sizeCall, ScopeOf(caller));
+
+    PushTOS<Call>(vm, caller);
+}
+
+// generated by TestBuilder
+inline void HandleArrayInitialization(PebbleVM* vm, Call* caller, Call* size)
+{
+    TEST_Tracer("HandleArrayInitialization");
+    methodHitMap["HandleArrayInitialization"]++;
+    if(FunctionInjections.count("HandleArrayInitialization") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&caller));
+    p.push_back(static_cast<const void*>(&size));
+    FunctionInjections["HandleArrayInitialization"](p);
+    }
+    HandleArrayInitialization_INTERNAL(vm, caller, size);
+}
+
+
+inline void HandleObjectInitialization(PebbleVM* vm, Call* call);
+
+inline void HandleObjectInitialization_INTERNAL(PebbleVM* vm, Call* call)
+{
+    auto newObjectCall = InternalCallConstructor(vm);
+    BindType(newObjectCall, &ObjectType);
+    BindScope(newObjectCall, InternalScopeConstructor(vm, nullptr));
+    
+    PushTOS<Call>(vm, newObjectCall);
+}
+
+// generated by TestBuilder
+inline void HandleObjectInitialization(PebbleVM* vm, Call* call)
+{
+    TEST_Tracer("HandleObjectInitialization");
+    methodHitMap["HandleObjectInitialization"]++;
+    if(FunctionInjections.count("HandleObjectInitialization") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["HandleObjectInitialization"](p);
+    }
+    HandleObjectInitialization_INTERNAL(vm, call);
+}
+
+
+inline bool IsPrimitiveMethodType(const BindingType type);
+
+inline bool IsPrimitiveMethodType_INTERNAL(const BindingType type)
+{
+    return type == &ArrayType 
+        || type == &ObjectType 
+        || type == &AbstractArrayType 
+        || type == &AbstractObjectType; 
+}
+
+// generated by TestBuilder
+inline bool IsPrimitiveMethodType(const BindingType type)
+{
+    TEST_Tracer("IsPrimitiveMethodType");
+    methodHitMap["IsPrimitiveMethodType"]++;
+    if(FunctionInjections.count("IsPrimitiveMethodType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["IsPrimitiveMethodType"](p);
+    }
+    return IsPrimitiveMethodType_INTERNAL(type);
+}
+
+
+void HandlePrimitiveTypeInstantiation(PebbleVM* vm, Call* simpleCall, void** params, extArg_t nWords, bool inPlace);
+
+void HandlePrimitiveTypeInstantiation_INTERNAL(PebbleVM* vm, Call* simpleCall, void** params, extArg_t nWords, bool inPlace)
+{
+    Call* callToInitialize = nullptr;
+    if(inPlace)
+    {
+        callToInitialize = vm->SelfReg;
+    }
+    else
+    {
+        callToInitialize = simpleCall;
+    }
+
+    if(Loosely(&ArrayType, simpleCall) || Loosely(&AbstractArrayType, simpleCall))
+    {
+        auto size = CallOfWord(vm, params[0]);
+        DropFromTOS(vm, nWords);
+        HandleArrayInitialization(vm, callToInitialize, size);
+    }
+    else if(Loosely(&ObjectType, simpleCall) || Loosely(&AbstractObjectType, simpleCall))
+    {
+        DropFromTOS(vm, nWords);
+        HandleObjectInitialization(vm, callToInitialize);
+    }
+    else
+    {
+        DropFromTOS(vm, nWords);
+    }
+}
+
+// generated by TestBuilder
+void HandlePrimitiveTypeInstantiation(PebbleVM* vm, Call* simpleCall, void** params, extArg_t nWords, bool inPlace)
+{
+    TEST_Tracer("HandlePrimitiveTypeInstantiation");
+    methodHitMap["HandlePrimitiveTypeInstantiation"]++;
+    if(FunctionInjections.count("HandlePrimitiveTypeInstantiation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&simpleCall));
+    p.push_back(static_cast<const void*>(&params));
+    p.push_back(static_cast<const void*>(&nWords));
+    p.push_back(static_cast<const void*>(&inPlace));
+    FunctionInjections["HandlePrimitiveTypeInstantiation"](p);
+    }
+    HandlePrimitiveTypeInstantiation_INTERNAL(vm, simpleCall, params, nWords, inPlace);
+}
+
+
+
+
+
+inline void AddParamsToMethodScope(PebbleVM* vm, Call* methodCall, void** params);
+
+inline void AddParamsToMethodScope_INTERNAL(PebbleVM* vm, Call* methodCall, void** params)
+{
+    for(size_t i =0; i<methodCall->NumberOfParameters; i++)
+    {
+        auto methodParam = methodCall->BoundScope->CallsIndex[i];
+        InternalAssignWord(vm, methodParam, params[i]);
+    }
+}
+
+// generated by TestBuilder
+inline void AddParamsToMethodScope(PebbleVM* vm, Call* methodCall, void** params)
+{
+    TEST_Tracer("AddParamsToMethodScope");
+    methodHitMap["AddParamsToMethodScope"]++;
+    if(FunctionInjections.count("AddParamsToMethodScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&methodCall));
+    p.push_back(static_cast<const void*>(&params));
+    FunctionInjections["AddParamsToMethodScope"](p);
+    }
+    AddParamsToMethodScope_INTERNAL(vm, methodCall, params);
+}
+
+
+inline void** ParametersOnStack(PebbleVM* vm, extArg_t numParams);
+
+inline void** ParametersOnStack_INTERNAL(PebbleVM* vm, extArg_t numParams)
+{
+    return vm->MemoryStack.data() + vm->MemoryStack.size() - numParams;
+}
+
+// generated by TestBuilder
+inline void** ParametersOnStack(PebbleVM* vm, extArg_t numParams)
+{
+    TEST_Tracer("ParametersOnStack");
+    methodHitMap["ParametersOnStack"]++;
+    if(FunctionInjections.count("ParametersOnStack") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&numParams));
+    FunctionInjections["ParametersOnStack"](p);
+    }
+    return ParametersOnStack_INTERNAL(vm, numParams);
+}
+
+
+inline bool EvalEntersCallFrame(Call* methodCall, extArg_t nParams);
+
+inline bool EvalEntersCallFrame_INTERNAL(Call* methodCall, extArg_t nParams)
+{
+    return !IsPureNothing(methodCall)
+        && nParams == methodCall->NumberOfParameters
+        && !IsPrimitiveMethodType(methodCall->BoundType)
+        && methodCall->BoundSection != 0;
+}
+
+// generated by TestBuilder
+inline bool EvalEntersCallFrame(Call* methodCall, extArg_t nParams)
+{
+    TEST_Tracer("EvalEntersCallFrame");
+    methodHitMap["EvalEntersCallFrame"]++;
+    if(FunctionInjections.count("EvalEntersCallFrame") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&methodCall));
+    p.push_back(static_cast<const void*>(&nParams));
+    FunctionInjections["EvalEntersCallFrame"](p);
+    }
+    return EvalEntersCallFrame_INTERNAL(methodCall, nParams);
+}
+
+
+inline void InternalEval(PebbleVM* vm, Call* methodCall, Call* caller, void** params, extArg_t nParams, extArg_t nWords, bool inPlace);
+
+inline void InternalEval_INTERNAL(PebbleVM* vm, Call* methodCall, Call* caller, void** params, extArg_t nParams, extArg_t nWords, bool inPlace)
+{
+    if(IsPureNothing(methodCall))
+    {
+        DropFromTOS(vm, nWords);
+        PushTOS<Call>(vm, &NothingCall);
+        return;
+    }
+
+    if(nParams != methodCall->NumberOfParameters)
+    {
+        DropFromTOS(vm, nWords);
+        ReportFatalError(vm, SystemMessageType::Exception, 2, 
+            Msg("expected %i arguments but got %i", methodCall->NumberOfParameters, nParams));
+        return;
+    }
+
+    if(IsPrimitiveMethodType(methodCall->BoundType))
+    {
+        HandlePrimitiveTypeInstantiation(vm, methodCall, params, nWords, inPlace);
+        return;
+    }
+
+    if(methodCall->BoundSection == 0)
+    {
+        DropFromTOS(vm, nWords);
+        auto methodName = (methodCall->Name == nullptr ? "anonymous variable" : *methodCall->Name);
+        ReportFatalError(vm, SystemMessageType::Exception, 3, Msg("%s cannot be called", methodName));
+        return;
+    }
+
+    if(methodCall->BoundScope == &NothingScope)
+    {
+        BindScope(methodCall, InternalScopeConstructor(vm, nullptr));
+    }
+
+    extArg_t jumpIns = methodCall->BoundSection;
+
+    if(inPlace)
+    {
+        if(nParams != 0)
+        {
+            AddParamsToMethodScope(vm, vm->SelfReg, params);
+        }
+
+        DropFromTOS(vm, nWords);
+        EnterNewCallFrame(vm, 0, vm->CallerReg, vm->SelfReg);
+    }
+    else
+    {
+        if(nParams != 0)
+        {
+            AddParamsToMethodScope(vm, methodCall, params);
+        }
+
+        DropFromTOS(vm, nWords);
+        EnterNewCallFrame(vm, 0, caller, methodCall);
+    }
+
+    InternalJumpTo(vm, jumpIns);
+}
+
+// generated by TestBuilder
+inline void InternalEval(PebbleVM* vm, Call* methodCall, Call* caller, void** params, extArg_t nParams, extArg_t nWords, bool inPlace)
+{
+    TEST_Tracer("InternalEval");
+    methodHitMap["InternalEval"]++;
+    if(FunctionInjections.count("InternalEval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&methodCall));
+    p.push_back(static_cast<const void*>(&caller));
+    p.push_back(static_cast<const void*>(&params));
+    p.push_back(static_cast<const void*>(&nParams));
+    p.push_back(static_cast<const void*>(&nWords));
+    p.push_back(static_cast<const void*>(&inPlace));
+    FunctionInjections["InternalEval"](p);
+    }
+    InternalEval_INTERNAL(vm, methodCall, caller, params, nParams, nWords, inPlace);
+}
+
+
+
+
+String CallTypeToString(const Call* call);
+
+String CallTypeToString_INTERNAL(const Call* call)
+{
+    if(IsPureNothing(call))
+    {
+        return "<Nothing>";
+    }
+
+    if(IsNothing(call))
+    {
+        return "<" + *call->BoundType + "?>";
+    }
+
+    return "<" + *call->BoundType + ">";
+}
+
+// generated by TestBuilder
+String CallTypeToString(const Call* call)
+{
+    TEST_Tracer("CallTypeToString");
+    methodHitMap["CallTypeToString"]++;
+    if(FunctionInjections.count("CallTypeToString") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["CallTypeToString"](p);
+    }
+    return CallTypeToString_INTERNAL(call);
+}
+
+
+String CallToString(const Call* call);
+
+String CallToString_INTERNAL(const Call* call)
+{
+    if(IsPureNothing(call) || IsNothing(call))
+    {
+        return CallTypeToString(call) + "\n";
+    }
+
+    return StringValueOf(call) + "\n";
+}
+
+// generated by TestBuilder
+String CallToString(const Call* call)
+{
+    TEST_Tracer("CallToString");
+    methodHitMap["CallToString"]++;
+    if(FunctionInjections.count("CallToString") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["CallToString"](p);
+    }
+    return CallToString_INTERNAL(call);
+}
+
+
+
+inline String* NamePointerFor(PebbleVM* vm, extArg_t nameId);
+
+inline String* NamePointerFor_INTERNAL(PebbleVM* vm, extArg_t nameId)
+{
+    if(nameId < SIMPLE_CALLS)
+    {
+        return SimpleCallNames[nameId];
+    }
+    return &vm->CallNames[nameId-SIMPLE_CALLS];
+}
+
+// generated by TestBuilder
+inline String* NamePointerFor(PebbleVM* vm, extArg_t nameId)
+{
+    TEST_Tracer("NamePointerFor");
+    methodHitMap["NamePointerFor"]++;
+    if(FunctionInjections.count("NamePointerFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&nameId));
+    FunctionInjections["NamePointerFor"](p);
+    }
+    return NamePointerFor_INTERNAL(vm, nameId);
+}
+
+
+inline void InternalResolveDirect(PebbleVM* vm, String* callName);
+
+inline void InternalResolveDirect_INTERNAL(PebbleVM* vm, String* callName)
+{
+    if(CallNameIsKeyword(callName))
+    {
+        ResolveKeywordCall(vm, callName);
+        return;
+    }
+
+    auto resolvedCall = FindInScopeOnlyImmediate(vm->LocalScopeReg, callName);
+
+    if(vm->LocalScopeIsDetachedReg == false)
+    {
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeChain(vm->SelfReg->BoundScope, callName);
+        }
+
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeOnlyImmediate(vm->CallerReg->BoundScope, callName);
+        }
+
+        if(resolvedCall == nullptr)
+        {
+            resolvedCall = FindInScopeOnlyImmediate(vm->ProgramReg, callName);
+        }
+    }
+
+    if(resolvedCall == nullptr)
+    {
+        auto newCall = InternalCallConstructor(vm, callName);
+        AddCallToScope(newCall, vm->LocalScopeReg);
+        PushTOS<Call>(vm, newCall);
+    }
+    else
+    {
+        PushTOS<Call>(vm, resolvedCall);
+    }
+}
+
+// generated by TestBuilder
+inline void InternalResolveDirect(PebbleVM* vm, String* callName)
+{
+    TEST_Tracer("InternalResolveDirect");
+    methodHitMap["InternalResolveDirect"]++;
+    if(FunctionInjections.count("InternalResolveDirect") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&callName));
+    FunctionInjections["InternalResolveDirect"](p);
+    }
+    InternalResolveDirect_INTERNAL(vm, callName);
+}
+
+
+inline void InternalAdd(PebbleVM* vm, void* lhs, void* rhs);
+
+inline void InternalAdd_INTERNAL(PebbleVM* vm, void* lhs, void* rhs)
+{
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal + rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, AddFunction, lCall, rCall, AddTypes, nAddTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot add types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+inline void InternalAdd(PebbleVM* vm, void* lhs, void* rhs)
+{
+    TEST_Tracer("InternalAdd");
+    methodHitMap["InternalAdd"]++;
+    if(FunctionInjections.count("InternalAdd") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["InternalAdd"](p);
+    }
+    InternalAdd_INTERNAL(vm, lhs, rhs);
+}
+
+
+inline void InternalSubtract(PebbleVM* vm, void* lhs, void* rhs);
+
+inline void InternalSubtract_INTERNAL(PebbleVM* vm, void* lhs, void* rhs)
+{
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal - rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, SubtractFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot subtract types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+inline void InternalSubtract(PebbleVM* vm, void* lhs, void* rhs)
+{
+    TEST_Tracer("InternalSubtract");
+    methodHitMap["InternalSubtract"]++;
+    if(FunctionInjections.count("InternalSubtract") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["InternalSubtract"](p);
+    }
+    InternalSubtract_INTERNAL(vm, lhs, rhs);
+}
+
+
+inline void* CmpResultWord(PebbleVM* vm, extArg_t arg);
+
+inline void* CmpResultWord_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    if(arg < 6 && NthBit(vm->CmpReg, 7) == 0)
+    {
+        return BooleanImmediate(NthBit(vm->CmpReg, arg));
+    }
+    return &NothingCall;
+}
+
+// generated by TestBuilder
+inline void* CmpResultWord(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("CmpResultWord");
+    methodHitMap["CmpResultWord"]++;
+    if(FunctionInjections.count("CmpResultWord") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["CmpResultWord"](p);
+    }
+    return CmpResultWord_INTERNAL(vm, arg);
+}
+
+
+inline void InternalJumpFalse(PebbleVM* vm, void* word, extArg_t arg);
+
+inline void InternalJumpFalse_INTERNAL(PebbleVM* vm, void* word, extArg_t arg)
+{
+    if(IsBooleanImmediate(word))
+    {
+        if(!BooleanOfImmediate(word))
+        {
+            InternalJumpTo(vm, arg);
+        }
+        return;
+    }
+
+    auto call = CallOfWord(vm, word);
+    if(IsPureNothing(call))
+    {
+        InternalJumpTo(vm, arg);
+    }
+
+    if(Loosely(&BooleanType, call))
+    {
+        if(Strictly(&BooleanType, call))
+        {
+            if(!BooleanValueOf(call))
+            {
+                InternalJumpTo(vm, arg);
+            }
+        }
+        else
+        {
+            InternalJumpTo(vm, arg);
+        }
+    }
+    else
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot conditionally jump on %s", CallTypeToString(call)));
+        return;
+    }
+}
+
+// generated by TestBuilder
+inline void InternalJumpFalse(PebbleVM* vm, void* word, extArg_t arg)
+{
+    TEST_Tracer("InternalJumpFalse");
+    methodHitMap["InternalJumpFalse"]++;
+    if(FunctionInjections.count("InternalJumpFalse") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&word));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["InternalJumpFalse"](p);
+    }
+    InternalJumpFalse_INTERNAL(vm, word, arg);
+}
+
+
+
+
+
+void BCI_LoadCallName(PebbleVM* vm, extArg_t arg);
+
+void BCI_LoadCallName_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    if(arg < SIMPLE_CALLS)
+    {
+        PushTOS<String>(vm, SimpleCallNames[arg]);
+    }
+    else
+    {
+        PushTOS<String>(vm, &vm->CallNames[arg-SIMPLE_CALLS]);
+    }
+}
+
+// generated by TestBuilder
+void BCI_LoadCallName(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_LoadCallName");
+    methodHitMap["BCI_LoadCallName"]++;
+    if(FunctionInjections.count("BCI_LoadCallName") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_LoadCallName"](p);
+    }
+    BCI_LoadCallName_INTERNAL(vm, arg);
+}
+
+
+void BCI_LoadPrimitive(PebbleVM* vm, extArg_t arg);
+
+void BCI_LoadPrimitive_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    if(arg >= vm->ConstPrimitives.size())
+        return; 
+
+    PushTOS<Call>(vm, vm->ConstPrimitives[arg]);
+}
+
+// generated by TestBuilder
+void BCI_LoadPrimitive(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_LoadPrimitive");
+    methodHitMap["BCI_LoadPrimitive"]++;
+    if(FunctionInjections.count("BCI_LoadPrimitive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_LoadPrimitive"](p);
+    }
+    BCI_LoadPrimitive_INTERNAL(vm, arg);
+}
+
+
+void BCI_Assign(PebbleVM* vm, extArg_t arg);
+
+void BCI_Assign_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<Call>(vm);
+
+    InternalAssignWord(vm, lhs, rhs);
+
+    PushTOS<Call>(vm, lhs);
+}
+
+// generated by TestBuilder
+void BCI_Assign(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Assign");
+    methodHitMap["BCI_Assign"]++;
+    if(FunctionInjections.count("BCI_Assign") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Assign"](p);
+    }
+    BCI_Assign_INTERNAL(vm, arg);
+}
+
+
+void BCI_Add(PebbleVM* vm, extArg_t arg);
+
+void BCI_Add_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    InternalAdd(vm, lhs, rhs);
+}
+
+// generated by TestBuilder
+void BCI_Add(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Add");
+    methodHitMap["BCI_Add"]++;
+    if(FunctionInjections.count("BCI_Add") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Add"](p);
+    }
+    BCI_Add_INTERNAL(vm, arg);
+}
+
+
+void BCI_Subtract(PebbleVM* vm, extArg_t arg);
+
+void BCI_Subtract_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    InternalSubtract(vm, lhs, rhs);
+}
+
+// generated by TestBuilder
+void BCI_Subtract(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Subtract");
+    methodHitMap["BCI_Subtract"]++;
+    if(FunctionInjections.count("BCI_Subtract") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Subtract"](p);
+    }
+    BCI_Subtract_INTERNAL(vm, arg);
+}
+
+
+void BCI_Multiply(PebbleVM* vm, extArg_t arg);
+
+void BCI_Multiply_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal * rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, MultiplyFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot multiply types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_Multiply(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Multiply");
+    methodHitMap["BCI_Multiply"]++;
+    if(FunctionInjections.count("BCI_Multiply") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Multiply"](p);
+    }
+    BCI_Multiply_INTERNAL(vm, arg);
+}
+
+
+void BCI_Divide(PebbleVM* vm, extArg_t arg);
+
+void BCI_Divide_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        PushTOS<void>(vm, IntegerImmediate(lVal / rVal));
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, DivideFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot divide types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_Divide(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Divide");
+    methodHitMap["BCI_Divide"]++;
+    if(FunctionInjections.count("BCI_Divide") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Divide"](p);
+    }
+    BCI_Divide_INTERNAL(vm, arg);
+}
+
+
+void BCI_SysCall(PebbleVM* vm, extArg_t arg);
+
+void BCI_SysCall_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    switch(arg)
+    {
+        case 0:
+        {
+            String msg = CallToString(PeekTOS<Call>(vm));
+            vm->Output->append(msg);
+            if(g_outputOn)
+            {
+                std::cout << msg;
+            }
+
+            break;
+        }
+
+        case 1:
+        {
+            String s;
+            if(vm->Ask)
+            {
+                s = vm->Ask();
+            }
+            else
+            {
+                std::getline(std::cin, s);
+            }
+            auto call = InternalPrimitiveCallConstructor(vm, s);
+            PushTOS<Call>(vm, call);
+            break;
+        }
+        
+        default:
+        break;
+    }
+}
+
+// generated by TestBuilder
+void BCI_SysCall(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_SysCall");
+    methodHitMap["BCI_SysCall"]++;
+    if(FunctionInjections.count("BCI_SysCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_SysCall"](p);
+    }
+    BCI_SysCall_INTERNAL(vm, arg);
+}
+
+
+void BCI_And(PebbleVM* vm, extArg_t arg);
+
+void BCI_And_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
+
+    auto call = ApplyFunction(vm, AndFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot 'and' types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_And(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_And");
+    methodHitMap["BCI_And"]++;
+    if(FunctionInjections.count("BCI_And") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_And"](p);
+    }
+    BCI_And_INTERNAL(vm, arg);
+}
+
+
+void BCI_Or(PebbleVM* vm, extArg_t arg);
+
+void BCI_Or_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
+
+    auto call = ApplyFunction(vm, OrFunction, lCall, rCall, GenericBooleanTypes, nGenericBooleanTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot 'or' types %s from %s", CallTypeToString(lCall), CallTypeToString(rCall)));
+        return;
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_Or(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Or");
+    methodHitMap["BCI_Or"]++;
+    if(FunctionInjections.count("BCI_Or") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Or"](p);
+    }
+    BCI_Or_INTERNAL(vm, arg);
+}
+
+
+void BCI_Not(PebbleVM* vm, extArg_t arg);
+
+void BCI_Not_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    if(IsPureNothing(PeekTOS<Call>(vm)))
+    {
+        return;
+    }
+     
+    auto call = PopTOS<Call>(vm);
+
+    if(!CanBe(&BooleanType, call))
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 0, 
+            Msg("cannot 'not' %s", CallTypeToString(call)));
+        return;
+    }
+
+    if(Strictly(&BooleanType, call))
+    {
+        bool b = !BooleanValueOf(call);
+        Call* newCall = InternalPrimitiveCallConstructor(vm, b);
+        PushTOS(vm, newCall);
+    }
+    else
+    {
+        PushTOS(vm, call);
+    }
+}
+
+// generated by TestBuilder
+void BCI_Not(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Not");
+    methodHitMap["BCI_Not"]++;
+    if(FunctionInjections.count("BCI_Not") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Not"](p);
+    }
+    BCI_Not_INTERNAL(vm, arg);
+}
+
+
+void BCI_NotEquals(PebbleVM* vm, extArg_t arg);
+
+void BCI_NotEquals_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
+
+    bool b = !CallsAreEqual(rCall, lCall);
+    Call* call = InternalPrimitiveCallConstructor(vm, b);
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_NotEquals(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_NotEquals");
+    methodHitMap["BCI_NotEquals"]++;
+    if(FunctionInjections.count("BCI_NotEquals") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_NotEquals"](p);
+    }
+    BCI_NotEquals_INTERNAL(vm, arg);
+}
+
+
+void BCI_Equals(PebbleVM* vm, extArg_t arg);
+
+void BCI_Equals_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rCall = PopTOS<Call>(vm);
+    auto lCall = PopTOS<Call>(vm);
+
+    bool b = CallsAreEqual(rCall, lCall);
+    Call* call = InternalPrimitiveCallConstructor(vm, b);
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_Equals(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Equals");
+    methodHitMap["BCI_Equals"]++;
+    if(FunctionInjections.count("BCI_Equals") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Equals"](p);
+    }
+    BCI_Equals_INTERNAL(vm, arg);
+}
+
+
+void BCI_Cmp(PebbleVM* vm, extArg_t arg);
+
+void BCI_Cmp_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    vm->CmpReg = CmpRegDefaultValue;
+    auto rhs = PopTOS<void>(vm);
+    auto lhs = PopTOS<void>(vm);
+
+    int lVal, rVal;
+    if(IntegerOfWord(lhs, lVal) && IntegerOfWord(rhs, rVal))
+    {
+        CompareIntegerValues(vm, lVal, rVal);
+        return;
+    }
+
+    auto lCall = CallOfWord(vm, lhs);
+    auto rCall = CallOfWord(vm, rhs);
+    auto call = ApplyFunction(vm, CmpFunction, lCall, rCall, GenericMathTypes, nGenericMathTypes);
+
+    if(call == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Warning, 0, 
+            Msg("cannot compare types %s and %s", lCall->BoundType, rCall->BoundType));
+        return;
+    }
+
+    if(Either(IsNothing, lCall, rCall))
+    {
+        vm->CmpReg = vm->CmpReg | (BitFlag << 7);
+    }
+}
+
+// generated by TestBuilder
+void BCI_Cmp(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Cmp");
+    methodHitMap["BCI_Cmp"]++;
+    if(FunctionInjections.count("BCI_Cmp") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Cmp"](p);
+    }
+    BCI_Cmp_INTERNAL(vm, arg);
+}
+
+
+void BCI_LoadCmp(PebbleVM* vm, extArg_t arg);
+
+void BCI_LoadCmp_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    PushTOS<void>(vm, CmpResultWord(vm, arg));
+}
+
+// generated by TestBuilder
+void BCI_LoadCmp(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_LoadCmp");
+    methodHitMap["BCI_LoadCmp"]++;
+    if(FunctionInjections.count("BCI_LoadCmp") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_LoadCmp"](p);
+    }
+    BCI_LoadCmp_INTERNAL(vm, arg);
+}
+
+
+void BCI_JumpFalse(PebbleVM* vm, extArg_t arg);
+
+void BCI_JumpFalse_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto word = PopTOS<void>(vm);
+    InternalJumpFalse(vm, word, arg);
+}
+
+// generated by TestBuilder
+void BCI_JumpFalse(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_JumpFalse");
+    methodHitMap["BCI_JumpFalse"]++;
+    if(FunctionInjections.count("BCI_JumpFalse") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_JumpFalse"](p);
+    }
+    BCI_JumpFalse_INTERNAL(vm, arg);
+}
+
+
+void BCI_Jump(PebbleVM* vm, extArg_t arg);
+
+void BCI_Jump_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    InternalJumpTo(vm, arg);
+}
+
+// generated by TestBuilder
+void BCI_Jump(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Jump");
+    methodHitMap["BCI_Jump"]++;
+    if(FunctionInjections.count("BCI_Jump") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Jump"](p);
+    }
+    BCI_Jump_INTERNAL(vm, arg);
+}
+
+
+void BCI_Copy(PebbleVM* vm, extArg_t arg);
+
+void BCI_Copy_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto call = PopTOS<Call>(vm);
+    auto callCopy = InternalCopyCall(vm, call);
+    PushTOS<Call>(vm, callCopy);
+}
+
+// generated by TestBuilder
+void BCI_Copy(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Copy");
+    methodHitMap["BCI_Copy"]++;
+    if(FunctionInjections.count("BCI_Copy") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Copy"](p);
+    }
+    BCI_Copy_INTERNAL(vm, arg);
+}
+
+
+void BCI_BindType(PebbleVM* vm, extArg_t arg);
+
+void BCI_BindType_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto originalCall = PeekTOS<Call>(vm);
+
+    if(originalCall->Name != nullptr)
+    {
+        if(originalCall->BoundScope != &NothingScope)
+        {
+            PopTOS<Call>(vm);
+            auto call = InternalCallConstructor(vm);
+            call->NumberOfParameters = originalCall->NumberOfParameters;
+            BindType(call, originalCall->Name);
+            BindSection(call, originalCall->BoundSection);
+            BindValue(call, originalCall->BoundValue);
+
+            EnforceCallType(call, originalCall->BoundType);
+            PushTOS(vm, call);
+        }
+        else
+        {
+            BindType(originalCall, originalCall->Name);
+            EnforceCallType(originalCall, originalCall->Name);
+        }
+
+    }
+    
+}
+
+// generated by TestBuilder
+void BCI_BindType(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_BindType");
+    methodHitMap["BCI_BindType"]++;
+    if(FunctionInjections.count("BCI_BindType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_BindType"](p);
+    }
+    BCI_BindType_INTERNAL(vm, arg);
+}
+
+
+void BCI_ResolveDirect(PebbleVM* vm, extArg_t arg);
+
+void BCI_ResolveDirect_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto callName = PopTOS<String>(vm);
+    InternalResolveDirect(vm, callName);
+}
+
+// generated by TestBuilder
+void BCI_ResolveDirect(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_ResolveDirect");
+    methodHitMap["BCI_ResolveDirect"]++;
+    if(FunctionInjections.count("BCI_ResolveDirect") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_ResolveDirect"](p);
+    }
+    BCI_ResolveDirect_INTERNAL(vm, arg);
+}
+
+
+void BCI_ResolveScoped(PebbleVM* vm, extArg_t arg);
+
+void BCI_ResolveScoped_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto callName = PopTOS<String>(vm);
+    auto callerCall = PopTOS<Call>(vm);
+
+    if(IsNothing(callerCall))
+    {
+        PushTOS<Call>(vm, &NothingCall);
+        return;
+    }
+
+    auto resolvedCall = FindInScopeOnlyImmediate(ScopeOf(callerCall), callName);
+
+    if(resolvedCall == nullptr)
+    {
+        auto newCall = InternalCallConstructor(vm, callName);
+        AddCallToScope(newCall, ScopeOf(callerCall));
+        PushTOS<Call>(vm, newCall);
+    }
+    else
+    {
+        PushTOS<Call>(vm, resolvedCall);
+    }
+}
+
+// generated by TestBuilder
+void BCI_ResolveScoped(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_ResolveScoped");
+    methodHitMap["BCI_ResolveScoped"]++;
+    if(FunctionInjections.count("BCI_ResolveScoped") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_ResolveScoped"](p);
+    }
+    BCI_ResolveScoped_INTERNAL(vm, arg);
+}
+
+
+void BCI_BindScope(PebbleVM* vm, extArg_t arg);
+
+void BCI_BindScope_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto call = InternalCallConstructor(vm);
+    auto scope = PopTOS<Scope>(vm);
+
+    call->NumberOfParameters = arg;
+    BindScope(call, scope);
+
+    BindType(call, &MethodType);
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_BindScope(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_BindScope");
+    methodHitMap["BCI_BindScope"]++;
+    if(FunctionInjections.count("BCI_BindScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_BindScope"](p);
+    }
+    BCI_BindScope_INTERNAL(vm, arg);
+}
+
+
+void BCI_BindSection(PebbleVM* vm, extArg_t arg);
+
+void BCI_BindSection_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto call = PeekTOS<Call>(vm);
+    BindSection(call, arg);
+}
+
+// generated by TestBuilder
+void BCI_BindSection(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_BindSection");
+    methodHitMap["BCI_BindSection"]++;
+    if(FunctionInjections.count("BCI_BindSection") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_BindSection"](p);
+    }
+    BCI_BindSection_INTERNAL(vm, arg);
+}
+
+
+void BCI_Eval(PebbleVM* vm, extArg_t arg);
+
+void BCI_Eval_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
+    auto caller = PeekTOS<Call>(vm, arg + 1);
+
+    InternalEval(vm, methodCall, caller, params, arg, arg + 2, /*inPlace*/ false);
+}
+
+// generated by TestBuilder
+void BCI_Eval(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Eval");
+    methodHitMap["BCI_Eval"]++;
+    if(FunctionInjections.count("BCI_Eval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Eval"](p);
+    }
+    BCI_Eval_INTERNAL(vm, arg);
+}
+
+
+void BCI_EvalHere(PebbleVM* vm, extArg_t arg);
+
+void BCI_EvalHere_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
+
+    InternalEval(vm, methodCall, &NothingCall, params, arg, arg + 1, /*inPlace*/ true);
+}
+
+// generated by TestBuilder
+void BCI_EvalHere(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_EvalHere");
+    methodHitMap["BCI_EvalHere"]++;
+    if(FunctionInjections.count("BCI_EvalHere") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_EvalHere"](p);
+    }
+    BCI_EvalHere_INTERNAL(vm, arg);
+}
+
+
+bool TailEvalReusesCallFrame(PebbleVM* vm, extArg_t arg);
+
+bool TailEvalReusesCallFrame_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    return EvalEntersCallFrame(PeekTOS<Call>(vm, arg), arg);
+}
+
+// generated by TestBuilder
+bool TailEvalReusesCallFrame(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("TailEvalReusesCallFrame");
+    methodHitMap["TailEvalReusesCallFrame"]++;
+    if(FunctionInjections.count("TailEvalReusesCallFrame") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["TailEvalReusesCallFrame"](p);
+    }
+    return TailEvalReusesCallFrame_INTERNAL(vm, arg);
+}
+
+
+void BCI_TailEval(PebbleVM* vm, extArg_t arg);
+
+void BCI_TailEval_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto params = ParametersOnStack(vm, arg);
+    auto methodCall = PeekTOS<Call>(vm, arg);
+    auto caller = PeekTOS<Call>(vm, arg + 1);
+
+    if(!EvalEntersCallFrame(methodCall, arg))
+    {
+        InternalEval(vm, methodCall, caller, params, arg, arg + 2, /*inPlace*/ false);
+        if(!vm->ErrorFlag)
+        {
+            BCI_Return(vm, 1);
+        }
+        return;
+    }
+
+    if(methodCall->BoundScope == &NothingScope)
+    {
+        BindScope(methodCall, InternalScopeConstructor(vm, nullptr));
+    }
+
+    if(arg != 0)
+    {
+        AddParamsToMethodScope(vm, methodCall, params);
+    }
+
+    ReuseCallFrame(vm, caller, methodCall);
+    InternalJumpTo(vm, methodCall->BoundSection);
+}
+
+// generated by TestBuilder
+void BCI_TailEval(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_TailEval");
+    methodHitMap["BCI_TailEval"]++;
+    if(FunctionInjections.count("BCI_TailEval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_TailEval"](p);
+    }
+    BCI_TailEval_INTERNAL(vm, arg);
+}
+
+
+void BCI_Return(PebbleVM* vm, extArg_t arg);
+
+void BCI_Return_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    extArg_t jumpBackTo = vm->CallStack.back().ReturnToInstructionId;
+    extArg_t stackStart = vm->CallStack.back().MemoryStackStart;
+
+    void* returnObj = nullptr;
+    if(arg == 1)
+    {
+        returnObj = PopTOS<void>(vm);
+    }
+
+    while(vm->MemoryStack.size() > stackStart)
+    {
+        PopTOS<void>(vm);
+    }
+
+    if(arg == 1)
+    {
+        PushTOS<void>(vm, returnObj);
+    }
+    else
+    {
+        if(vm->CallerReg->BoundType != &NothingType)
+        {
+            PushTOS(vm, vm->CallerReg);
+        }
+        else
+        {
+            PushTOS(vm, vm->SelfReg);
+        }
+    }
+
+    vm->InstructionReg = jumpBackTo;
+
+    vm->LastResultReg = vm->CallStack.back().LastResult;
+    vm->LocalScopes.resize(vm->CallStack.back().LocalScopesStart);
+    vm->CallStack.pop_back();
+
+    extArg_t returnMemStart = vm->CallStack.back().MemoryStackStart;
+
+    vm->CallerReg = static_cast<Call*>(vm->MemoryStack[returnMemStart]);
+    vm->SelfReg = static_cast<Call*>(vm->MemoryStack[returnMemStart+1]);
+
+    AdjustLocalScopeReg(vm);
+
+    vm->JumpStatusReg = 1;
+}
+
+// generated by TestBuilder
+void BCI_Return(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Return");
+    methodHitMap["BCI_Return"]++;
+    if(FunctionInjections.count("BCI_Return") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Return"](p);
+    }
+    BCI_Return_INTERNAL(vm, arg);
+}
+
+
+void BCI_Array(PebbleVM* vm, extArg_t arg);
+
+void BCI_Array_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto indexWord = PopTOS<void>(vm);
+    auto arrayCall = PopTOS<Call>(vm);
+
+    int indexInt;
+    if(!IntegerOfWord(indexWord, indexInt))
+    {
+        auto indexCall = CallOfWord(vm, indexWord);
+        if(indexCall->BoundType != &IntegerType)
+        {
+            ReportFatalError(vm, SystemMessageType::Exception, 5, Msg("%s is not an integer", CallTypeToString(indexCall)));
+            return;
+        }
+        indexInt = IntegerValueOf(indexCall);
+    }
+
+    auto sizeCall = FindInScopeOnlyImmediate(ScopeOf(arrayCall), vm->SizeCallNamePointer);
+    if(sizeCall == nullptr)
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 4, Msg("%s is not an array", *arrayCall->Name));
+        return;
+    }
+
+    auto& elements = ScopeOf(arrayCall)->Elements;
+    if(indexInt < 0 || static_cast<size_t>(indexInt) >= elements.size())
+    {
+        ReportFatalError(vm, SystemMessageType::Exception, 6, 
+            Msg("%i is out of bounds in %s of size %i", indexInt, *arrayCall->Name, static_cast<int>(elements.size())));
+        return;
+    }
+
+    PushTOS(vm, elements[indexInt]);
+}
+
+// generated by TestBuilder
+void BCI_Array(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Array");
+    methodHitMap["BCI_Array"]++;
+    if(FunctionInjections.count("BCI_Array") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Array"](p);
+    }
+    BCI_Array_INTERNAL(vm, arg);
+}
+
+
+
+void BCI_EnterLocal(PebbleVM* vm, extArg_t arg);
+
+void BCI_EnterLocal_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto newScope = InternalScopeConstructor(vm, nullptr);
+    bool isDetached = (arg == 1 ? true : false);
+    vm->LocalScopes.push_back({newScope, isDetached});
+    vm->LocalScopeReg = vm->LocalScopes.back().Value;
+    vm->LocalScopeIsDetachedReg = isDetached;
+    vm->LastResultReg = nullptr;
+}
+
+// generated by TestBuilder
+void BCI_EnterLocal(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_EnterLocal");
+    methodHitMap["BCI_EnterLocal"]++;
+    if(FunctionInjections.count("BCI_EnterLocal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_EnterLocal"](p);
+    }
+    BCI_EnterLocal_INTERNAL(vm, arg);
+}
+
+
+void BCI_LeaveLocal(PebbleVM* vm, extArg_t arg);
+
+void BCI_LeaveLocal_INTERNAL(PebbleVM* vm, extArg_t arg)
+{   
+    PushTOS<Scope>(vm, vm->LocalScopes.back().Value);
+    vm->LocalScopes.pop_back();
+    AdjustLocalScopeReg(vm);
+    vm->LastResultReg = nullptr;
+}
+
+// generated by TestBuilder
+void BCI_LeaveLocal(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_LeaveLocal");
+    methodHitMap["BCI_LeaveLocal"]++;
+    if(FunctionInjections.count("BCI_LeaveLocal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_LeaveLocal"](p);
+    }
+    BCI_LeaveLocal_INTERNAL(vm, arg);
+}
+
+
+void BCI_NOP(PebbleVM* vm, extArg_t arg);
+
+void BCI_NOP_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+}
+
+// generated by TestBuilder
+void BCI_NOP(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_NOP");
+    methodHitMap["BCI_NOP"]++;
+    if(FunctionInjections.count("BCI_NOP") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_NOP"](p);
+    }
+    BCI_NOP_INTERNAL(vm, arg);
+}
+
+
+void BCI_Dup(PebbleVM* vm, extArg_t arg);
+
+void BCI_Dup_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto entity = PeekTOS<void>(vm);
+    PushTOS<void>(vm, entity);
+}
+
+// generated by TestBuilder
+void BCI_Dup(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Dup");
+    methodHitMap["BCI_Dup"]++;
+    if(FunctionInjections.count("BCI_Dup") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Dup"](p);
+    }
+    BCI_Dup_INTERNAL(vm, arg);
+}
+
+
+void BCI_EndLine(PebbleVM* vm, extArg_t arg);
+
+void BCI_EndLine_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    vm->LastResultReg = PopTOS<Call>(vm);
+}
+
+// generated by TestBuilder
+void BCI_EndLine(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_EndLine");
+    methodHitMap["BCI_EndLine"]++;
+    if(FunctionInjections.count("BCI_EndLine") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_EndLine"](p);
+    }
+    BCI_EndLine_INTERNAL(vm, arg);
+}
+
+
+void BCI_DropTOS(PebbleVM* vm, extArg_t arg);
+
+void BCI_DropTOS_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    PopTOS<void>(vm);
+}
+
+// generated by TestBuilder
+void BCI_DropTOS(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_DropTOS");
+    methodHitMap["BCI_DropTOS"]++;
+    if(FunctionInjections.count("BCI_DropTOS") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_DropTOS"](p);
+    }
+    BCI_DropTOS_INTERNAL(vm, arg);
+}
+
+
+void BCI_Is(PebbleVM* vm, extArg_t arg);
+
+void BCI_Is_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<Call>(vm);
+    auto lhs = PopTOS<Call>(vm);
+
+    Call* call = nullptr;
+    if(IsPureNothing(lhs))
+    {
+        InternalAssign(vm, lhs, rhs);
+        call = InternalPrimitiveCallConstructor(vm, true);   
+    }
+    else
+    {
+        bool is = false;
+        if(IsNothing(lhs) && !IsNothing(rhs))
+        {
+            is = lhs->BoundType == rhs->BoundType
+                 && lhs->BoundSection == rhs->BoundSection
+                 && CallsHaveEqualValue(lhs, rhs); 
+
+        }
+        else if(!IsNothing(lhs) && IsNothing(rhs))
+        {
+            is = lhs->BoundType == rhs->BoundType
+                 && lhs->BoundSection == rhs->BoundSection;
+        }
+        else if(IsNothing(lhs) && IsNothing(rhs))
+        {
+            is = true;
+        }
+        else
+        {
+            is = CallsAreEqual(lhs, rhs);
+        }
+
+        call = InternalPrimitiveCallConstructor(vm, is);
+    }
+
+    PushTOS(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_Is(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_Is");
+    methodHitMap["BCI_Is"]++;
+    if(FunctionInjections.count("BCI_Is") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_Is"](p);
+    }
+    BCI_Is_INTERNAL(vm, arg);
+}
+
+
+void BCI_LoadLocal(PebbleVM* vm, extArg_t arg);
+
+void BCI_LoadLocal_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto& slot = vm->LocalSlots[arg];
+    auto call = FindInLocalSlot(vm, slot);
+    if(call == nullptr)
+    {
+        BCI_LoadCallName(vm, slot.NameId);
+        BCI_ResolveDirect(vm, 0);
+        return;
+    }
+
+    PushTOS<Call>(vm, call);
+}
+
+// generated by TestBuilder
+void BCI_LoadLocal(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_LoadLocal");
+    methodHitMap["BCI_LoadLocal"]++;
+    if(FunctionInjections.count("BCI_LoadLocal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_LoadLocal"](p);
+    }
+    BCI_LoadLocal_INTERNAL(vm, arg);
+}
+
+
+void BCI_StoreLocal(PebbleVM* vm, extArg_t arg);
+
+void BCI_StoreLocal_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto rhs = PopTOS<void>(vm);
+
+    auto& slot = vm->LocalSlots[arg];
+    auto lhs = FindInLocalSlot(vm, slot);
+    if(lhs == nullptr)
+    {
+        BCI_LoadCallName(vm, slot.NameId);
+        BCI_ResolveDirect(vm, 0);
+        lhs = PopTOS<Call>(vm);
+    }
+
+    InternalAssignWord(vm, lhs, rhs);
+    PushTOS<Call>(vm, lhs);
+}
+
+// generated by TestBuilder
+void BCI_StoreLocal(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_StoreLocal");
+    methodHitMap["BCI_StoreLocal"]++;
+    if(FunctionInjections.count("BCI_StoreLocal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_StoreLocal"](p);
+    }
+    BCI_StoreLocal_INTERNAL(vm, arg);
+}
+
+
+void BCI_ResolveName(PebbleVM* vm, extArg_t arg);
+
+void BCI_ResolveName_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    InternalResolveDirect(vm, NamePointerFor(vm, arg));
+}
+
+// generated by TestBuilder
+void BCI_ResolveName(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_ResolveName");
+    methodHitMap["BCI_ResolveName"]++;
+    if(FunctionInjections.count("BCI_ResolveName") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_ResolveName"](p);
+    }
+    BCI_ResolveName_INTERNAL(vm, arg);
+}
+
+
+void BCI_AddConst(PebbleVM* vm, extArg_t arg);
+
+void BCI_AddConst_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto lhs = PopTOS<void>(vm);
+    InternalAdd(vm, lhs, vm->ConstPrimitives[arg]);
+}
+
+// generated by TestBuilder
+void BCI_AddConst(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_AddConst");
+    methodHitMap["BCI_AddConst"]++;
+    if(FunctionInjections.count("BCI_AddConst") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_AddConst"](p);
+    }
+    BCI_AddConst_INTERNAL(vm, arg);
+}
+
+
+void BCI_SubtractConst(PebbleVM* vm, extArg_t arg);
+
+void BCI_SubtractConst_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    auto lhs = PopTOS<void>(vm);
+    InternalSubtract(vm, lhs, vm->ConstPrimitives[arg]);
+}
+
+// generated by TestBuilder
+void BCI_SubtractConst(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_SubtractConst");
+    methodHitMap["BCI_SubtractConst"]++;
+    if(FunctionInjections.count("BCI_SubtractConst") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_SubtractConst"](p);
+    }
+    BCI_SubtractConst_INTERNAL(vm, arg);
+}
+
+
+void BCI_CmpJumpFalse(PebbleVM* vm, extArg_t arg);
+
+void BCI_CmpJumpFalse_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    BCI_Cmp(vm, 0);
+    if(vm->ErrorFlag)
+        return;
+
+    InternalJumpFalse(vm, CmpResultWord(vm, CmpJumpComparisonOf(arg)), CmpJumpTargetOf(arg));
+}
+
+// generated by TestBuilder
+void BCI_CmpJumpFalse(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("BCI_CmpJumpFalse");
+    methodHitMap["BCI_CmpJumpFalse"]++;
+    if(FunctionInjections.count("BCI_CmpJumpFalse") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["BCI_CmpJumpFalse"](p);
+    }
+    BCI_CmpJumpFalse_INTERNAL(vm, arg);
+}
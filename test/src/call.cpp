@@ -0,0 +1,512 @@
+#include "test.h"
+#include <new>
+#include <type_traits>
+
+#include "call.h"
+
+#include "value.h"
+#include "vm.h"
+#include "diagnostics.h"
+#include "utils.h"
+
+
+
+
+Call* CallConstructor(utils::Slab<Call>& slab, const String* name)
+{
+    auto call = new (slab.Allocate()) Call;
+    call->Name = name;
+    call->BoundScope = nullptr;
+    call->BoundSection = 0;
+    call->BoundType = nullptr;
+    call->CallType = nullptr;
+
+    call->BoundValue.s = 0;
+    call->NumberOfParameters = 0;
+
+    return call;
+}
+
+
+void CallDestructor(utils::Slab<Call>& slab, Call* call)
+{
+    static_assert(std::is_trivially_destructible<Call>::value, "Call must be trivially destructible");
+    slab.Free(call);
+}
+
+
+void ReleaseAllCalls(utils::Slab<Call>& slab)
+{
+    slab.Reset();
+}
+
+
+std::string ObjectType = "Object";
+std::string IntegerType = "Integer";
+std::string DecimalType = "Decimal";
+std::string StringType = "String";
+std::string BooleanType = "Boolean";
+std::string NothingType = "Nothing";
+std::string ArrayType = "Array";
+std::string TupleType = "Tuple";
+std::string MethodType = "Method";
+std::string AnythingType = "Anything";
+
+std::string AbstractObjectType = "AbstractObject";
+std::string AbstractIntegerType = "AbstractInteger";
+std::string AbstractDecimalType = "AbstractDecimal";
+std::string AbstractStringType = "AbstractString";
+std::string AbstractBooleanType = "AbstractBoolean";
+std::string AbstractArrayType = "AbstractArray";
+std::string AbstractTupleType = "AbstractTuple";
+std::string AbstractMethodType = "AbstractMethod";
+
+
+
+
+void BindType(Call* call, BindingType type);
+
+void BindType_INTERNAL(Call* call, BindingType type)
+{
+    call->BoundType = type;
+}
+
+// generated by TestBuilder
+void BindType(Call* call, BindingType type)
+{
+    TEST_Tracer("BindType");
+    methodHitMap["BindType"]++;
+    if(FunctionInjections.count("BindType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["BindType"](p);
+    }
+    BindType_INTERNAL(call, type);
+}
+
+
+void BindSection(Call* call, extArg_t section);
+
+void BindSection_INTERNAL(Call* call, extArg_t section)
+{
+    call->BoundSection = section;
+}
+
+// generated by TestBuilder
+void BindSection(Call* call, extArg_t section)
+{
+    TEST_Tracer("BindSection");
+    methodHitMap["BindSection"]++;
+    if(FunctionInjections.count("BindSection") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&section));
+    FunctionInjections["BindSection"](p);
+    }
+    BindSection_INTERNAL(call, section);
+}
+
+
+void BindScope(Call* call, Scope* scope);
+
+void BindScope_INTERNAL(Call* call, Scope* scope)
+{
+    call->BoundScope = scope;
+}
+
+// generated by TestBuilder
+void BindScope(Call* call, Scope* scope)
+{
+    TEST_Tracer("BindScope");
+    methodHitMap["BindScope"]++;
+    if(FunctionInjections.count("BindScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["BindScope"](p);
+    }
+    BindScope_INTERNAL(call, scope);
+}
+
+
+void BindValue(Call* call, Value value);
+
+void BindValue_INTERNAL(Call* call, Value value)
+{
+    call->BoundValue = value;
+}
+
+// generated by TestBuilder
+void BindValue(Call* call, Value value)
+{
+    TEST_Tracer("BindValue");
+    methodHitMap["BindValue"]++;
+    if(FunctionInjections.count("BindValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["BindValue"](p);
+    }
+    BindValue_INTERNAL(call, value);
+}
+
+
+void EnforceCallType(Call* call, BindingType type);
+
+void EnforceCallType_INTERNAL(Call* call, BindingType type)
+{
+    if(call->CallType == nullptr)
+    {
+        call->CallType = type;
+    }
+}
+
+// generated by TestBuilder
+void EnforceCallType(Call* call, BindingType type)
+{
+    TEST_Tracer("EnforceCallType");
+    methodHitMap["EnforceCallType"]++;
+    if(FunctionInjections.count("EnforceCallType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["EnforceCallType"](p);
+    }
+    EnforceCallType_INTERNAL(call, type);
+}
+
+
+
+
+
+
+String StringValueOf(const Call* call);
+
+String StringValueOf_INTERNAL(const Call* call)
+{
+    if(call->BoundType == &IntegerType)
+    {
+        return std::to_string(call->BoundValue.i);
+    }
+    else if(call->BoundType == &DecimalType)
+    {
+        return std::to_string(call->BoundValue.d);
+    }
+    else if(call->BoundType == &BooleanType)
+    {
+        if(call->BoundValue.b)
+        {
+            return "true";
+        }
+        return "false";
+    }
+    else if(call->BoundType == &StringType)
+    {
+        return *call->BoundValue.s;
+    }
+    else
+    {
+        return "<" + *call->BoundType + ">";
+    }
+}
+
+// generated by TestBuilder
+String StringValueOf(const Call* call)
+{
+    TEST_Tracer("StringValueOf");
+    methodHitMap["StringValueOf"]++;
+    if(FunctionInjections.count("StringValueOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["StringValueOf"](p);
+    }
+    return StringValueOf_INTERNAL(call);
+}
+
+
+int IntegerValueOf(const Call* call);
+
+int IntegerValueOf_INTERNAL(const Call* call)
+{
+    if(call->BoundType != &IntegerType)
+    {
+        LogIt(LogSeverityType::Sev1_Notify, "GetIntValue", "only implemented for IntegerType");
+        return 0;
+    }
+    return call->BoundValue.i;
+}
+
+// generated by TestBuilder
+int IntegerValueOf(const Call* call)
+{
+    TEST_Tracer("IntegerValueOf");
+    methodHitMap["IntegerValueOf"]++;
+    if(FunctionInjections.count("IntegerValueOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["IntegerValueOf"](p);
+    }
+    return IntegerValueOf_INTERNAL(call);
+}
+
+
+double DecimalValueOf(const Call* call);
+
+double DecimalValueOf_INTERNAL(const Call* call)
+{
+    if(call->BoundType == &DecimalType)
+    {
+        return call->BoundValue.d;
+    }
+    if(call->BoundType == &IntegerType)
+    {
+        return static_cast<double>(call->BoundValue.i);
+    }
+    LogIt(LogSeverityType::Sev1_Notify, "GetDecimalValue", "only implemented for Integer and Decimal Typees");
+    return 0;
+}
+
+// generated by TestBuilder
+double DecimalValueOf(const Call* call)
+{
+    TEST_Tracer("DecimalValueOf");
+    methodHitMap["DecimalValueOf"]++;
+    if(FunctionInjections.count("DecimalValueOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["DecimalValueOf"](p);
+    }
+    return DecimalValueOf_INTERNAL(call);
+}
+
+
+bool BooleanValueOf(const Call* call);
+
+bool BooleanValueOf_INTERNAL(const Call* call)
+{
+    if(call->BoundType == &BooleanType)
+    {
+        return call->BoundValue.b;
+    }
+    else if(call->BoundType == &NothingType)
+    {
+        return false;
+    }
+
+    LogIt(LogSeverityType::Sev1_Notify, "BooleanValueOf", "only implemented for Boolean and Nothing Typees");
+    return 0;    
+}
+
+// generated by TestBuilder
+bool BooleanValueOf(const Call* call)
+{
+    TEST_Tracer("BooleanValueOf");
+    methodHitMap["BooleanValueOf"]++;
+    if(FunctionInjections.count("BooleanValueOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["BooleanValueOf"](p);
+    }
+    return BooleanValueOf_INTERNAL(call);
+}
+
+
+
+
+bool CallIsType(const Call* call, BindingType cls);
+
+bool CallIsType_INTERNAL(const Call* call, BindingType cls)
+{
+    return call->BoundType == cls;
+}
+
+// generated by TestBuilder
+bool CallIsType(const Call* call, BindingType cls)
+{
+    TEST_Tracer("CallIsType");
+    methodHitMap["CallIsType"]++;
+    if(FunctionInjections.count("CallIsType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&cls));
+    FunctionInjections["CallIsType"](p);
+    }
+    return CallIsType_INTERNAL(call, cls);
+}
+
+
+bool CallIsPrimitive(Call* call);
+
+bool CallIsPrimitive_INTERNAL(Call* call)
+{
+    auto type = call->BoundType;
+    return type == &IntegerType || type == &DecimalType || type == &BooleanType || type == &StringType;
+}
+
+// generated by TestBuilder
+bool CallIsPrimitive(Call* call)
+{
+    TEST_Tracer("CallIsPrimitive");
+    methodHitMap["CallIsPrimitive"]++;
+    if(FunctionInjections.count("CallIsPrimitive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["CallIsPrimitive"](p);
+    }
+    return CallIsPrimitive_INTERNAL(call);
+}
+
+
+
+
+bool ValueMatchesPrimitiveCall(int value, const Call* call);
+
+bool ValueMatchesPrimitiveCall_INTERNAL(int value, const Call* call)
+{
+    return CallIsType(call, &IntegerType) && call->BoundScope != &NothingScope && call->BoundValue.i == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveCall(int value, const Call* call)
+{
+    TEST_Tracer("ValueMatchesPrimitiveCall");
+    methodHitMap["ValueMatchesPrimitiveCall"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ValueMatchesPrimitiveCall"](p);
+    }
+    return ValueMatchesPrimitiveCall_INTERNAL(value, call);
+}
+
+
+bool ValueMatchesPrimitiveCall(const String& value, const Call* call);
+
+bool ValueMatchesPrimitiveCall_INTERNAL(const String& value, const Call* call)
+{
+    return CallIsType(call, &StringType) && call->BoundScope != &NothingScope &&  *call->BoundValue.s == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveCall(const String& value, const Call* call)
+{
+    TEST_Tracer("ValueMatchesPrimitiveCall");
+    methodHitMap["ValueMatchesPrimitiveCall"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ValueMatchesPrimitiveCall"](p);
+    }
+    return ValueMatchesPrimitiveCall_INTERNAL(value, call);
+}
+
+
+bool ValueMatchesPrimitiveCall(double value, const Call* call);
+
+bool ValueMatchesPrimitiveCall_INTERNAL(double value, const Call* call)
+{
+    return CallIsType(call, &DecimalType) && call->BoundScope != &NothingScope && call->BoundValue.d == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveCall(double value, const Call* call)
+{
+    TEST_Tracer("ValueMatchesPrimitiveCall");
+    methodHitMap["ValueMatchesPrimitiveCall"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ValueMatchesPrimitiveCall"](p);
+    }
+    return ValueMatchesPrimitiveCall_INTERNAL(value, call);
+}
+
+
+bool ValueMatchesPrimitiveCall(bool value, const Call* call);
+
+bool ValueMatchesPrimitiveCall_INTERNAL(bool value, const Call* call)
+{
+    return CallIsType(call, &BooleanType) && call->BoundScope != &NothingScope && call->BoundValue.b == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveCall(bool value, const Call* call)
+{
+    TEST_Tracer("ValueMatchesPrimitiveCall");
+    methodHitMap["ValueMatchesPrimitiveCall"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ValueMatchesPrimitiveCall"](p);
+    }
+    return ValueMatchesPrimitiveCall_INTERNAL(value, call);
+}
+
+
+
+
+
+bool ListContainsPrimitiveCall(const std::vector<Call*>& list, int value, Call** foundCall)
+{
+    for(auto call: list)
+    {
+        if(ValueMatchesPrimitiveCall(value, call))
+        {
+            *foundCall = call;
+            return true;
+        }
+    }
+    
+    *foundCall = nullptr; 
+    return false;
+}
+
+
+bool ListContainsPrimitiveCall(const std::vector<Call*>& list, const String& value, Call** foundCall)
+{
+    for(auto call: list)
+    {
+        if(ValueMatchesPrimitiveCall(value, call))
+        {
+            *foundCall = call;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+bool ListContainsPrimitiveCall(const std::vector<Call*>& list, double value, Call** foundCall)
+{
+    for(auto call: list)
+    {
+        if(ValueMatchesPrimitiveCall(value, call))
+        {
+            *foundCall = call;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+bool ListContainsPrimitiveCall(const std::vector<Call*>& list, bool value, Call** foundCall)
+{
+    for(auto call: list)
+    {
+        if(ValueMatchesPrimitiveCall(value, call))
+        {
+            *foundCall = call;
+            return true;
+        }
+    }
+
+    return false;
+}
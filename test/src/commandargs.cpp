@@ -0,0 +1,111 @@
+#include "test.h"
+#include <string>
+#include <iostream>
+
+#include "commandargs.h"
+
+static ProgramConfiguration* Config = nullptr;
+static Setting* CurrentState = nullptr;
+
+
+bool MatchesFlag(String token, Setting** matchedSetting);
+
+bool MatchesFlag_INTERNAL(String token, Setting** matchedSetting)
+{
+	// If there is no text (shouldn't happen) OR this is not a flag, discard
+    if(token.length() < 1 || token.at(0) != '-')
+    {
+        return false;
+    }
+
+    for(Setting& s: *Config)
+    {
+        if(token == s.Flag)
+        {
+            CurrentState = &s;
+            *matchedSetting = &s;
+            return true;
+        }
+    }
+    
+    if(token.at(0) == '-')
+    {
+        Usage(std::vector<SettingOption>());
+    }
+    
+    return false;
+}
+
+// generated by TestBuilder
+bool MatchesFlag(String token, Setting** matchedSetting)
+{
+    TEST_Tracer("MatchesFlag");
+    methodHitMap["MatchesFlag"]++;
+    if(FunctionInjections.count("MatchesFlag") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    p.push_back(static_cast<const void*>(&matchedSetting));
+    FunctionInjections["MatchesFlag"](p);
+    }
+    return MatchesFlag_INTERNAL(token, matchedSetting);
+}
+
+
+void ParseCommandArgs(int argc, char* argv[], ProgramConfiguration* config);
+
+void ParseCommandArgs_INTERNAL(int argc, char* argv[], ProgramConfiguration* config)
+{
+    Config = config;
+    CurrentState = nullptr;
+    bool inFlag = false;
+
+    std::vector<SettingOption> CurrentSettingOptions;
+    CurrentSettingOptions.reserve(8);
+
+    for(int i=1; i<argc; i++)
+    {
+        String arg = argv[i];
+        
+        Setting* newSetting = nullptr;
+        if(MatchesFlag(arg, &newSetting))
+        {
+            if(newSetting->Action(CurrentSettingOptions))
+            {
+                inFlag = true;
+            }
+        }
+        else if(inFlag)
+        {
+            SettingOption option = arg;
+            CurrentSettingOptions.push_back(option);
+            CurrentState->Action(CurrentSettingOptions);
+            CurrentSettingOptions.clear();
+            inFlag = false;
+        }
+        else
+        {        	
+            Config->at(0).Flag = arg;
+            break;
+        }
+    }
+
+    if(CurrentState != nullptr)
+    {
+        CurrentState->Action(CurrentSettingOptions);
+    }
+}
+
+// generated by TestBuilder
+void ParseCommandArgs(int argc, char* argv[], ProgramConfiguration* config)
+{
+    TEST_Tracer("ParseCommandArgs");
+    methodHitMap["ParseCommandArgs"]++;
+    if(FunctionInjections.count("ParseCommandArgs") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&argc));
+    p.push_back(static_cast<const void*>(&argv));
+    p.push_back(static_cast<const void*>(&config));
+    FunctionInjections["ParseCommandArgs"](p);
+    }
+    ParseCommandArgs_INTERNAL(argc, argv, config);
+}
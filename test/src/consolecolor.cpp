@@ -0,0 +1,40 @@
+#include "test.h"
+#include <consolecolor.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+
+const char* WIN32_CONSOLE_COLOR(int color);
+
+const char* WIN32_CONSOLE_COLOR_INTERNAL(int color)
+{
+#ifdef _WIN32
+    if(color == -1)
+    {
+        return "";
+    }
+    
+    HANDLE hConsole;
+    hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    SetConsoleTextAttribute(hConsole, color);
+
+    return "";
+#else
+    return "";
+#endif
+}
+
+// generated by TestBuilder
+const char* WIN32_CONSOLE_COLOR(int color)
+{
+    TEST_Tracer("WIN32_CONSOLE_COLOR");
+    methodHitMap["WIN32_CONSOLE_COLOR"]++;
+    if(FunctionInjections.count("WIN32_CONSOLE_COLOR") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&color));
+    FunctionInjections["WIN32_CONSOLE_COLOR"](p);
+    }
+    return WIN32_CONSOLE_COLOR_INTERNAL(color);
+}
@@ -0,0 +1,89 @@
+#include "test.h"
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+    
+
+    
+
+
+    
+
+    
+
+
+    
+
+    
+
+
+
+
+
+
+ 
+
+
+
+
+
+
+
+    
+
+
+
+
+
+
+
+
+    
+
+    
+
+
+    
+
+    
+
+
+    
+
+    
+
+
+
+
+
+    
+
+    
+
+
+
+
@@ -0,0 +1,234 @@
+#include "test.h"
+#include <iostream>
+
+#include "dis.h"
+
+#include "bytecode.h"
+#include "vm.h"
+#include "diagnostics.h"
+#include "call.h"
+
+
+
+String CallNameFor(PebbleVM* vm, extArg_t nameId);
+
+String CallNameFor_INTERNAL(PebbleVM* vm, extArg_t nameId)
+{
+    if(nameId < SIMPLE_CALLS)
+    {
+        return *SimpleCallNames[nameId];
+    }
+    return vm->CallNames[nameId - SIMPLE_CALLS];
+}
+
+// generated by TestBuilder
+String CallNameFor(PebbleVM* vm, extArg_t nameId)
+{
+    TEST_Tracer("CallNameFor");
+    methodHitMap["CallNameFor"]++;
+    if(FunctionInjections.count("CallNameFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&nameId));
+    FunctionInjections["CallNameFor"](p);
+    }
+    return CallNameFor_INTERNAL(vm, nameId);
+}
+
+
+String PrimitiveFor(PebbleVM* vm, extArg_t primitiveId);
+
+String PrimitiveFor_INTERNAL(PebbleVM* vm, extArg_t primitiveId)
+{
+    auto call = vm->ConstPrimitives[primitiveId];
+    if(call->BoundScope != &NothingScope)
+    {
+        return StringValueOf(call);
+    }
+    return CallTypeToString(call);
+}
+
+// generated by TestBuilder
+String PrimitiveFor(PebbleVM* vm, extArg_t primitiveId)
+{
+    TEST_Tracer("PrimitiveFor");
+    methodHitMap["PrimitiveFor"]++;
+    if(FunctionInjections.count("PrimitiveFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&primitiveId));
+    FunctionInjections["PrimitiveFor"](p);
+    }
+    return PrimitiveFor_INTERNAL(vm, primitiveId);
+}
+
+
+String ToString(PebbleVM* vm, const LocalSlot& slot);
+
+String ToString_INTERNAL(PebbleVM* vm, const LocalSlot& slot)
+{
+    return Msg("%s @ %i", CallNameFor(vm, slot.NameId), slot.Slot);
+}
+
+// generated by TestBuilder
+String ToString(PebbleVM* vm, const LocalSlot& slot)
+{
+    TEST_Tracer("ToString");
+    methodHitMap["ToString"]++;
+    if(FunctionInjections.count("ToString") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&slot));
+    FunctionInjections["ToString"](p);
+    }
+    return ToString_INTERNAL(vm, slot);
+}
+
+static const char* const InstructionNames[] =
+{
+    "BCI_LoadCallName", "BCI_LoadPrimitive", "BCI_Assign", "BCI_Add", "BCI_Subtract",
+    "BCI_Multiply", "BCI_Divide", "BCI_SysCall", "BCI_And", "BCI_Or", "BCI_Not", "BCI_NotEquals",
+    "BCI_Equals", "BCI_Cmp", "BCI_LoadCmp", "BCI_JumpFalse", "BCI_Jump", "BCI_Copy", "BCI_BindType",
+    "BCI_ResolveDirect", "BCI_ResolveScoped", "BCI_BindScope", "BCI_BindSection", "BCI_EvalHere",
+    "BCI_Eval", "BCI_Return", "BCI_Array", "BCI_EnterLocal", "BCI_LeaveLocal", "BCI_NOP", "BCI_Dup",
+    "BCI_EndLine", "BCI_DropTOS", "BCI_Is", "BCI_LoadLocal", "BCI_StoreLocal", "BCI_ResolveName",
+    "BCI_AddConst", "BCI_SubtractConst", "BCI_CmpJumpFalse", "BCI_TailEval",
+};
+
+static_assert(sizeof(InstructionNames) / sizeof(InstructionNames[0]) == OP_NumberOfInstructions,
+    "InstructionNames must name every instruction");
+
+
+String InstructionName(uint8_t op);
+
+String InstructionName_INTERNAL(uint8_t op)
+{
+    if(op < OP_NumberOfInstructions)
+    {
+        return InstructionNames[op];
+    }
+    return "?????????" + std::to_string(op);
+}
+
+// generated by TestBuilder
+String InstructionName(uint8_t op)
+{
+    TEST_Tracer("InstructionName");
+    methodHitMap["InstructionName"]++;
+    if(FunctionInjections.count("InstructionName") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["InstructionName"](p);
+    }
+    return InstructionName_INTERNAL(op);
+}
+
+
+String ToString(PebbleVM* vm, ByteCodeInstruction& ins);
+
+String ToString_INTERNAL(PebbleVM* vm, ByteCodeInstruction& ins)
+{
+    String str = "#" + InstructionName(ins.Op);
+    String decodedArg;
+
+    switch(ins.Op)
+    {
+        case OP_LoadCallName:
+        case OP_ResolveName:
+            decodedArg = CallNameFor(vm, ins.Arg);
+            break;
+
+        case OP_LoadPrimitive:
+        case OP_AddConst:
+        case OP_SubtractConst:
+            decodedArg = PrimitiveFor(vm, ins.Arg);
+            break;
+
+        case OP_LoadLocal:
+        case OP_StoreLocal:
+            decodedArg = ToString(vm, vm->LocalSlots[ins.Arg]);
+            break;
+
+        case OP_CmpJumpFalse:
+            decodedArg = Msg("cmp %i -> %i", (int)CmpJumpComparisonOf(ins.Arg), (int)CmpJumpTargetOf(ins.Arg));
+            break;
+    }
+    
+    while(str.size() < 22)
+    {
+        str += " ";
+    }
+
+    str += "\t" + std::to_string(ins.Arg) + "\t" + decodedArg;
+    return str;
+}
+
+// generated by TestBuilder
+String ToString(PebbleVM* vm, ByteCodeInstruction& ins)
+{
+    TEST_Tracer("ToString");
+    methodHitMap["ToString"]++;
+    if(FunctionInjections.count("ToString") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ins));
+    FunctionInjections["ToString"](p);
+    }
+    return ToString_INTERNAL(vm, ins);
+}
+
+
+String ToString(PebbleVM* vm, std::vector<ByteCodeInstruction>& bciProgram)
+{
+    String str = "";
+    int i=0;
+    for(auto& ins: bciProgram)
+    {
+        str += std::to_string(i++) + "\t" + ToString(vm, ins)  + "\n";
+    }
+
+    return str;
+}
+
+
+void LogProgramInstructions(PebbleVM* vm);
+
+void LogProgramInstructions_INTERNAL(PebbleVM* vm)
+{
+    String refNames = "Call list\n";
+
+    for(size_t i=0; i<SIMPLE_CALLS; i++)
+    {
+        refNames +=  Msg("%i:\t %s\n", i, SimpleCallNames[i]);
+    }
+
+
+    for(size_t i=0; i<vm->CallNames.size(); i++)
+    {
+        refNames +=  Msg("%i:\t %s\n", i + SIMPLE_CALLS, vm->CallNames[i]);
+    }
+    
+    LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", refNames);
+
+    String primitives = "Const Primitives\n";
+    for(size_t i=0; i<vm->ConstPrimitives.size(); i++)
+    {
+        primitives += Msg("%i: %s", i, ToString(vm->ConstPrimitives[i]));
+    }
+    
+    LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", primitives);
+    LogIt(LogSeverityType::Sev2_Important, "ByteCodeProgram", Msg("\n%s", ToString(vm, vm->ByteCodeProgram)));
+}
+
+// generated by TestBuilder
+void LogProgramInstructions(PebbleVM* vm)
+{
+    TEST_Tracer("LogProgramInstructions");
+    methodHitMap["LogProgramInstructions"]++;
+    if(FunctionInjections.count("LogProgramInstructions") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["LogProgramInstructions"](p);
+    }
+    LogProgramInstructions_INTERNAL(vm);
+}
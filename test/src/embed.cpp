@@ -0,0 +1,116 @@
+#include "test.h"
+#include "embed.h"
+
+#include "program.h"
+#include "grammar.h"
+#include "flattener.h"
+#include "vm.h"
+
+
+PebbleProgram* CompilePebbleProgram(const String& source, String* messages);
+
+PebbleProgram* CompilePebbleProgram_INTERNAL(const String& source, String* messages)
+{
+    ProgramMsgs.clear();
+    FatalCompileError = false;
+
+    CompileGrammar();
+    Program* parsed = ParseProgramSource(source);
+
+    if(messages != nullptr)
+    {
+        *messages = ProgramMsgs;
+    }
+
+    bool isCompiled = parsed != nullptr && !FatalCompileError;
+    ProgramMsgs.clear();
+    FatalCompileError = false;
+
+    if(!isCompiled)
+    {
+        if(parsed != nullptr)
+        {
+            ProgramDestructor(parsed);
+        }
+        return nullptr;
+    }
+
+    PebbleProgram* program = new PebbleProgram;
+    program->VM = PebbleVMConstructor();
+    program->Source = parsed;
+    FlattenProgram(program->VM, parsed);
+
+    return program;
+}
+
+// generated by TestBuilder
+PebbleProgram* CompilePebbleProgram(const String& source, String* messages)
+{
+    TEST_Tracer("CompilePebbleProgram");
+    methodHitMap["CompilePebbleProgram"]++;
+    if(FunctionInjections.count("CompilePebbleProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&source));
+    p.push_back(static_cast<const void*>(&messages));
+    FunctionInjections["CompilePebbleProgram"](p);
+    }
+    return CompilePebbleProgram_INTERNAL(source, messages);
+}
+
+
+PebbleRunResult RunPebbleProgram(PebbleProgram* program, const PebbleAskMethod& ask);
+
+PebbleRunResult RunPebbleProgram_INTERNAL(PebbleProgram* program, const PebbleAskMethod& ask)
+{
+    PebbleRunResult result;
+
+    auto vm = program->VM;
+    vm->OutputBuffer.clear();
+    vm->MessagesBuffer.clear();
+    vm->Ask = ask;
+
+    result.ExitCode = DoByteCodeProgram(vm, program->Source);
+
+    result.Output.swap(vm->OutputBuffer);
+    result.Messages.swap(vm->MessagesBuffer);
+    vm->Ask = nullptr;
+
+    return result;
+}
+
+// generated by TestBuilder
+PebbleRunResult RunPebbleProgram(PebbleProgram* program, const PebbleAskMethod& ask)
+{
+    TEST_Tracer("RunPebbleProgram");
+    methodHitMap["RunPebbleProgram"]++;
+    if(FunctionInjections.count("RunPebbleProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&program));
+    p.push_back(static_cast<const void*>(&ask));
+    FunctionInjections["RunPebbleProgram"](p);
+    }
+    return RunPebbleProgram_INTERNAL(program, ask);
+}
+
+
+void PebbleProgramDestructor(PebbleProgram* program);
+
+void PebbleProgramDestructor_INTERNAL(PebbleProgram* program)
+{
+    ProgramDestructor(program->Source);
+    PebbleVMDestructor(program->VM);
+    delete program;
+}
+
+// generated by TestBuilder
+void PebbleProgramDestructor(PebbleProgram* program)
+{
+    TEST_Tracer("PebbleProgramDestructor");
+    methodHitMap["PebbleProgramDestructor"]++;
+    if(FunctionInjections.count("PebbleProgramDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&program));
+    FunctionInjections["PebbleProgramDestructor"](p);
+    }
+    PebbleProgramDestructor_INTERNAL(program);
+}
@@ -0,0 +1,109 @@
+#include "test.h"
+#include <iostream>
+
+#include "errormsg.h"
+
+#include "vm.h"
+#include "consolecolor.h"
+#include "diagnostics.h"
+#include "program.h"
+#include "main.h"
+#include "program.h"
+
+
+
+inline int GetLineNumberFromInstructionNumber(const PebbleVM* vm, extArg_t instructionNumber, Program* p);
+
+inline int GetLineNumberFromInstructionNumber_INTERNAL(const PebbleVM* vm, extArg_t instructionNumber, Program* p)
+{
+    auto& lineAssociation = vm->ByteCodeLineAssociation;
+    extArg_t i = 0;
+    for(; i< lineAssociation.size() && lineAssociation[i] < instructionNumber; i++);
+    return p->Lines[i-1].LineNumber;
+}
+
+// generated by TestBuilder
+inline int GetLineNumberFromInstructionNumber(const PebbleVM* vm, extArg_t instructionNumber, Program* p)
+{
+    TEST_Tracer("GetLineNumberFromInstructionNumber");
+    methodHitMap["GetLineNumberFromInstructionNumber"]++;
+    if(FunctionInjections.count("GetLineNumberFromInstructionNumber") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&instructionNumber));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["GetLineNumberFromInstructionNumber"](p);
+    }
+    return GetLineNumberFromInstructionNumber_INTERNAL(vm, instructionNumber, p);
+}
+
+
+void IfNeededDisplayError(PebbleVM* vm, Program* p);
+
+void IfNeededDisplayError_INTERNAL(PebbleVM* vm, Program* p)
+{
+    if(vm->ErrorFlag)
+    {
+        vm->ErrorFlag = false;
+        int lineNumber = GetLineNumberFromInstructionNumber(vm, vm->InstructionReg, p);        
+        String fatalStatus = (vm->ErrorType == SystemMessageType::Exception ? "Fatal" : "");        
+        auto stringMsg = Msg("%s %s at line[%i]: %s\n     (!)   %s\n", fatalStatus, SystemMessageTypeString(vm->ErrorType), lineNumber, ErrorClasses[vm->ErrorCode].ErrorMsg, vm->ErrorMsg);
+
+        vm->Output->append(stringMsg);
+        if(g_outputOn)
+            std::cerr << ConsoleColorForMessage(vm->ErrorType) << stringMsg << CONSOLE_RESET;
+        vm->Messages->append(stringMsg);
+    }
+}
+
+// generated by TestBuilder
+void IfNeededDisplayError(PebbleVM* vm, Program* p)
+{
+    TEST_Tracer("IfNeededDisplayError");
+    methodHitMap["IfNeededDisplayError"]++;
+    if(FunctionInjections.count("IfNeededDisplayError") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["IfNeededDisplayError"](p);
+    }
+    IfNeededDisplayError_INTERNAL(vm, p);
+}
+
+
+
+ByteCodeError ErrorClasses[] =
+{
+    {
+        0,
+        "type mismatch"
+    },
+    {
+        1,
+        "unattributable object"
+    },
+    {
+        2,
+        "method call arguments mismatch"
+    },
+    {
+        3,
+        "variable is not callable"
+    },
+    {
+        4,
+        "variable is not indexable"
+    },
+    {
+        5,
+        "array index must be Integer typed"
+    },
+    {
+        6,
+        "array index out of bounds"
+    },
+    {
+        7,
+        "unassignable left operand"
+    }
+};
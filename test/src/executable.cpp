@@ -0,0 +1,82 @@
+#include "test.h"
+#include "executable.h"
+
+#include "operation.h"
+
+
+Block* BlockConstructor();
+
+Block* BlockConstructor_INTERNAL()
+{
+    Block* b = new Block;
+    b->ExecType = ExecutableType::Block;
+    b->Executables = {};
+
+    return b;
+}
+
+// generated by TestBuilder
+Block* BlockConstructor()
+{
+    TEST_Tracer("BlockConstructor");
+    methodHitMap["BlockConstructor"]++;
+    if(FunctionInjections.count("BlockConstructor") == 1){
+    Params p;
+    FunctionInjections["BlockConstructor"](p);
+    }
+    return BlockConstructor_INTERNAL();
+}
+
+
+void BlockDestructor(Block* b);
+
+void BlockDestructor_INTERNAL(Block* b)
+{
+    delete b;
+}
+
+// generated by TestBuilder
+void BlockDestructor(Block* b)
+{
+    TEST_Tracer("BlockDestructor");
+    methodHitMap["BlockDestructor"]++;
+    if(FunctionInjections.count("BlockDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&b));
+    FunctionInjections["BlockDestructor"](p);
+    }
+    BlockDestructor_INTERNAL(b);
+}
+
+
+void DeleteBlockRecursive(Block* b);
+
+void DeleteBlockRecursive_INTERNAL(Block* b)
+{
+    for(auto exec: b->Executables)
+    {
+        if(exec->ExecType == ExecutableType::Block)
+        {
+            DeleteBlockRecursive(static_cast<Block*>(exec));
+        }
+        else
+        {
+            DeleteOperationRecursive(static_cast<Operation*>(exec));
+        }
+    }
+    
+    BlockDestructor(b);
+}
+
+// generated by TestBuilder
+void DeleteBlockRecursive(Block* b)
+{
+    TEST_Tracer("DeleteBlockRecursive");
+    methodHitMap["DeleteBlockRecursive"]++;
+    if(FunctionInjections.count("DeleteBlockRecursive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&b));
+    FunctionInjections["DeleteBlockRecursive"](p);
+    }
+    DeleteBlockRecursive_INTERNAL(b);
+}
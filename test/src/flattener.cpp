@@ -0,0 +1,2473 @@
+#include "test.h"
+#include <iostream>
+
+#include "flattener.h"
+
+#include "object.h"
+#include "program.h"
+#include "scope.h"
+#include "reference.h"
+#include "operation.h"
+#include "diagnostics.h"
+#include "executable.h"
+#include "call.h"
+
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "dis.h"
+#include "fusion.h"
+
+
+static Operation* GlobalBlockOwner;
+
+
+
+constexpr extArg_t noArg = 0;
+
+
+inline uint32_t InstructionArg(extArg_t arg);
+
+inline uint32_t InstructionArg_INTERNAL(extArg_t arg)
+{
+    if(arg > MaxInstructionArg)
+    {
+        LogIt(LogSeverityType::Sev3_Critical, "InstructionArg", "argument is too large for an instruction");
+    }
+    return static_cast<uint32_t>(arg);
+}
+
+// generated by TestBuilder
+inline uint32_t InstructionArg(extArg_t arg)
+{
+    TEST_Tracer("InstructionArg");
+    methodHitMap["InstructionArg"]++;
+    if(FunctionInjections.count("InstructionArg") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["InstructionArg"](p);
+    }
+    return InstructionArg_INTERNAL(arg);
+}
+
+
+inline void AddByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg);
+
+inline void AddByteCodeInstruction_INTERNAL(PebbleVM* vm, uint8_t opId, extArg_t arg)
+{
+    vm->ByteCodeProgram.push_back( {opId, InstructionArg(arg)} );
+}
+
+// generated by TestBuilder
+inline void AddByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg)
+{
+    TEST_Tracer("AddByteCodeInstruction");
+    methodHitMap["AddByteCodeInstruction"]++;
+    if(FunctionInjections.count("AddByteCodeInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&opId));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["AddByteCodeInstruction"](p);
+    }
+    AddByteCodeInstruction_INTERNAL(vm, opId, arg);
+}
+
+
+inline void RewriteByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg, extArg_t atPos);
+
+inline void RewriteByteCodeInstruction_INTERNAL(PebbleVM* vm, uint8_t opId, extArg_t arg, extArg_t atPos)
+{
+    vm->ByteCodeProgram[atPos] = {opId, InstructionArg(arg)};
+}
+
+// generated by TestBuilder
+inline void RewriteByteCodeInstruction(PebbleVM* vm, uint8_t opId, extArg_t arg, extArg_t atPos)
+{
+    TEST_Tracer("RewriteByteCodeInstruction");
+    methodHitMap["RewriteByteCodeInstruction"]++;
+    if(FunctionInjections.count("RewriteByteCodeInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&opId));
+    p.push_back(static_cast<const void*>(&arg));
+    p.push_back(static_cast<const void*>(&atPos));
+    FunctionInjections["RewriteByteCodeInstruction"](p);
+    }
+    RewriteByteCodeInstruction_INTERNAL(vm, opId, arg, atPos);
+}
+
+
+inline extArg_t CurrentInstructionId(PebbleVM* vm);
+
+inline extArg_t CurrentInstructionId_INTERNAL(PebbleVM* vm)
+{
+    return vm->ByteCodeProgram.size()-1;
+}
+
+// generated by TestBuilder
+inline extArg_t CurrentInstructionId(PebbleVM* vm)
+{
+    TEST_Tracer("CurrentInstructionId");
+    methodHitMap["CurrentInstructionId"]++;
+    if(FunctionInjections.count("CurrentInstructionId") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["CurrentInstructionId"](p);
+    }
+    return CurrentInstructionId_INTERNAL(vm);
+}
+
+
+inline extArg_t NextInstructionId(PebbleVM* vm);
+
+inline extArg_t NextInstructionId_INTERNAL(PebbleVM* vm)
+{
+    return vm->ByteCodeProgram.size();
+}
+
+// generated by TestBuilder
+inline extArg_t NextInstructionId(PebbleVM* vm)
+{
+    TEST_Tracer("NextInstructionId");
+    methodHitMap["NextInstructionId"]++;
+    if(FunctionInjections.count("NextInstructionId") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["NextInstructionId"](p);
+    }
+    return NextInstructionId_INTERNAL(vm);
+}
+
+
+inline extArg_t AddUnresolvedInstruction(PebbleVM* vm, uint8_t opId);
+
+inline extArg_t AddUnresolvedInstruction_INTERNAL(PebbleVM* vm, uint8_t opId)
+{
+    extArg_t id = NextInstructionId(vm);
+    AddByteCodeInstruction(vm, opId, noArg);
+    return id;
+}
+
+// generated by TestBuilder
+inline extArg_t AddUnresolvedInstruction(PebbleVM* vm, uint8_t opId)
+{
+    TEST_Tracer("AddUnresolvedInstruction");
+    methodHitMap["AddUnresolvedInstruction"]++;
+    if(FunctionInjections.count("AddUnresolvedInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&opId));
+    FunctionInjections["AddUnresolvedInstruction"](p);
+    }
+    return AddUnresolvedInstruction_INTERNAL(vm, opId);
+}
+
+
+inline void AddEndLineInstruction(PebbleVM* vm);
+
+inline void AddEndLineInstruction_INTERNAL(PebbleVM* vm)
+{
+    AddByteCodeInstruction(vm, IndexOfInstruction(BCI_EndLine), noArg);
+}
+
+// generated by TestBuilder
+inline void AddEndLineInstruction(PebbleVM* vm)
+{
+    TEST_Tracer("AddEndLineInstruction");
+    methodHitMap["AddEndLineInstruction"]++;
+    if(FunctionInjections.count("AddEndLineInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["AddEndLineInstruction"](p);
+    }
+    AddEndLineInstruction_INTERNAL(vm);
+}
+
+
+
+inline void AddInstructionsForDefMethodParameters(PebbleVM* vm, Operation* op, extArg_t& arg);
+
+inline void AddInstructionsForDefMethodParameters_INTERNAL(PebbleVM* vm, Operation* op, extArg_t& arg)
+{
+    uint8_t opId;
+    arg = 0;
+    
+    opId = IndexOfInstruction(BCI_EnterLocal);
+    AddByteCodeInstruction(vm, opId, 1);
+
+    if(op->Type == OperationType::Tuple)
+    {
+        for(auto operand: op->Operands)
+        {
+            FlattenOperation(vm, operand);
+            arg++;
+
+            opId = IndexOfInstruction(BCI_EndLine);
+            AddByteCodeInstruction(vm, opId, noArg);
+        }
+    }
+    else
+    {
+        FlattenOperation(vm, op);
+        arg = 1;
+
+        opId = IndexOfInstruction(BCI_EndLine);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+
+    opId = IndexOfInstruction(BCI_LeaveLocal);
+    AddByteCodeInstruction(vm, opId, noArg);
+}
+
+// generated by TestBuilder
+inline void AddInstructionsForDefMethodParameters(PebbleVM* vm, Operation* op, extArg_t& arg)
+{
+    TEST_Tracer("AddInstructionsForDefMethodParameters");
+    methodHitMap["AddInstructionsForDefMethodParameters"]++;
+    if(FunctionInjections.count("AddInstructionsForDefMethodParameters") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["AddInstructionsForDefMethodParameters"](p);
+    }
+    AddInstructionsForDefMethodParameters_INTERNAL(vm, op, arg);
+}
+
+
+inline bool OperationIsExpression(Operation* op);
+
+inline bool OperationIsExpression_INTERNAL(Operation* op)
+{
+    return op->Type != OperationType::Ref;
+}
+
+// generated by TestBuilder
+inline bool OperationIsExpression(Operation* op)
+{
+    TEST_Tracer("OperationIsExpression");
+    methodHitMap["OperationIsExpression"]++;
+    if(FunctionInjections.count("OperationIsExpression") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["OperationIsExpression"](p);
+    }
+    return OperationIsExpression_INTERNAL(op);
+}
+
+
+inline void AddInstructionsForEvaluateParameters(PebbleVM* vm, Operation* evalOp, extArg_t& arg);
+
+inline void AddInstructionsForEvaluateParameters_INTERNAL(PebbleVM* vm, Operation* evalOp, extArg_t& arg)
+{
+    if(evalOp->Operands.size() < 3)
+    {
+        arg = 0;
+        return;
+    }
+
+    auto op = evalOp->Operands[2];
+
+    if(op->Type == OperationType::Tuple)
+    {
+        for(auto operand: op->Operands)
+        {
+            FlattenOperation(vm, operand);
+            arg++;
+        }
+    }
+    else
+    {
+        if(OperationIsExpression(op))
+        {
+            FlattenOperation(vm, op);
+        }
+        else
+        {
+            FlattenOperationRefDirect(vm, op);
+        }
+        arg = 1;
+    }
+}
+
+// generated by TestBuilder
+inline void AddInstructionsForEvaluateParameters(PebbleVM* vm, Operation* evalOp, extArg_t& arg)
+{
+    TEST_Tracer("AddInstructionsForEvaluateParameters");
+    methodHitMap["AddInstructionsForEvaluateParameters"]++;
+    if(FunctionInjections.count("AddInstructionsForEvaluateParameters") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&evalOp));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["AddInstructionsForEvaluateParameters"](p);
+    }
+    AddInstructionsForEvaluateParameters_INTERNAL(vm, evalOp, arg);
+}
+
+
+
+inline void AddInstructionsForUnresolvedJump(PebbleVM* vm, JumpContext& ctx);
+
+inline void AddInstructionsForUnresolvedJump_INTERNAL(PebbleVM* vm, JumpContext& ctx)
+{
+    ctx.UnresolvedJumps.push_back(AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_Jump)));
+}
+
+// generated by TestBuilder
+inline void AddInstructionsForUnresolvedJump(PebbleVM* vm, JumpContext& ctx)
+{
+    TEST_Tracer("AddInstructionsForUnresolvedJump");
+    methodHitMap["AddInstructionsForUnresolvedJump"]++;
+    if(FunctionInjections.count("AddInstructionsForUnresolvedJump") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["AddInstructionsForUnresolvedJump"](p);
+    }
+    AddInstructionsForUnresolvedJump_INTERNAL(vm, ctx);
+}
+
+
+inline void AddInstructionsForUnresolvedJumpFalse(PebbleVM* vm, JumpContext& ctx);
+
+inline void AddInstructionsForUnresolvedJumpFalse_INTERNAL(PebbleVM* vm, JumpContext& ctx)
+{
+    ctx.UnresolvedJumpFalse = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_JumpFalse));
+    ctx.HasUnresolvedJumpFalse = true;
+}
+
+// generated by TestBuilder
+inline void AddInstructionsForUnresolvedJumpFalse(PebbleVM* vm, JumpContext& ctx)
+{
+    TEST_Tracer("AddInstructionsForUnresolvedJumpFalse");
+    methodHitMap["AddInstructionsForUnresolvedJumpFalse"]++;
+    if(FunctionInjections.count("AddInstructionsForUnresolvedJumpFalse") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["AddInstructionsForUnresolvedJumpFalse"](p);
+    }
+    AddInstructionsForUnresolvedJumpFalse_INTERNAL(vm, ctx);
+}
+
+
+inline void InitJumpContext(JumpContext& ctx);
+
+inline void InitJumpContext_INTERNAL(JumpContext& ctx)
+{
+    ctx.UnresolvedJumps.reserve(16);
+    ctx.HasUnresolvedJumpFalse = false;
+}
+
+// generated by TestBuilder
+inline void InitJumpContext(JumpContext& ctx)
+{
+    TEST_Tracer("InitJumpContext");
+    methodHitMap["InitJumpContext"]++;
+    if(FunctionInjections.count("InitJumpContext") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["InitJumpContext"](p);
+    }
+    InitJumpContext_INTERNAL(ctx);
+}
+
+
+inline void ClearJumpContext(JumpContext& ctx);
+
+inline void ClearJumpContext_INTERNAL(JumpContext& ctx)
+{
+    ctx.HasUnresolvedJumpFalse = false;
+    ctx.UnresolvedJumps.clear();
+}
+
+// generated by TestBuilder
+inline void ClearJumpContext(JumpContext& ctx)
+{
+    TEST_Tracer("ClearJumpContext");
+    methodHitMap["ClearJumpContext"]++;
+    if(FunctionInjections.count("ClearJumpContext") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["ClearJumpContext"](p);
+    }
+    ClearJumpContext_INTERNAL(ctx);
+}
+
+
+inline void ResolveJumpContext(PebbleVM* vm, JumpContext& ctx);
+
+inline void ResolveJumpContext_INTERNAL(PebbleVM* vm, JumpContext& ctx)
+{
+    uint8_t opId = IndexOfInstruction(BCI_Jump);
+    extArg_t jumpTo = NextInstructionId(vm);
+    for(extArg_t pos: ctx.UnresolvedJumps)
+    {
+        RewriteByteCodeInstruction(vm, opId, jumpTo, pos);  
+    }
+
+    opId = IndexOfInstruction(BCI_JumpFalse);
+    if(ctx.HasUnresolvedJumpFalse)
+    {
+        RewriteByteCodeInstruction(vm, opId, jumpTo, ctx.UnresolvedJumpFalse);
+    }
+
+    ClearJumpContext(ctx);
+}
+
+// generated by TestBuilder
+inline void ResolveJumpContext(PebbleVM* vm, JumpContext& ctx)
+{
+    TEST_Tracer("ResolveJumpContext");
+    methodHitMap["ResolveJumpContext"]++;
+    if(FunctionInjections.count("ResolveJumpContext") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["ResolveJumpContext"](p);
+    }
+    ResolveJumpContext_INTERNAL(vm, ctx);
+}
+
+
+inline void ResolveJumpContextClause(PebbleVM* vm, JumpContext& ctx);
+
+inline void ResolveJumpContextClause_INTERNAL(PebbleVM* vm, JumpContext& ctx)
+{
+    uint8_t opId = IndexOfInstruction(BCI_JumpFalse);
+    extArg_t jumpTo = NextInstructionId(vm);
+
+    RewriteByteCodeInstruction(vm, opId, jumpTo, ctx.UnresolvedJumpFalse);
+    ctx.HasUnresolvedJumpFalse = false;
+}
+
+// generated by TestBuilder
+inline void ResolveJumpContextClause(PebbleVM* vm, JumpContext& ctx)
+{
+    TEST_Tracer("ResolveJumpContextClause");
+    methodHitMap["ResolveJumpContextClause"]++;
+    if(FunctionInjections.count("ResolveJumpContextClause") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["ResolveJumpContextClause"](p);
+    }
+    ResolveJumpContextClause_INTERNAL(vm, ctx);
+}
+
+
+inline bool JumpContextHasUnresolvedClause(const JumpContext& ctx);
+
+inline bool JumpContextHasUnresolvedClause_INTERNAL(const JumpContext& ctx)
+{
+    return ctx.HasUnresolvedJumpFalse;
+}
+
+// generated by TestBuilder
+inline bool JumpContextHasUnresolvedClause(const JumpContext& ctx)
+{
+    TEST_Tracer("JumpContextHasUnresolvedClause");
+    methodHitMap["JumpContextHasUnresolvedClause"]++;
+    if(FunctionInjections.count("JumpContextHasUnresolvedClause") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["JumpContextHasUnresolvedClause"](p);
+    }
+    return JumpContextHasUnresolvedClause_INTERNAL(ctx);
+}
+
+
+inline bool JumpContextNeedsResolution(const JumpContext& ctx);
+
+inline bool JumpContextNeedsResolution_INTERNAL(const JumpContext& ctx)
+{
+    return ctx.UnresolvedJumps.size() > 0 || ctx.HasUnresolvedJumpFalse;
+}
+
+// generated by TestBuilder
+inline bool JumpContextNeedsResolution(const JumpContext& ctx)
+{
+    TEST_Tracer("JumpContextNeedsResolution");
+    methodHitMap["JumpContextNeedsResolution"]++;
+    if(FunctionInjections.count("JumpContextNeedsResolution") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["JumpContextNeedsResolution"](p);
+    }
+    return JumpContextNeedsResolution_INTERNAL(ctx);
+}
+
+
+inline bool IsConditionalJump(Operation* op);
+
+inline bool IsConditionalJump_INTERNAL(Operation* op)
+{
+    return op->Type == OperationType::While || op->Type == OperationType::If || op->Type == OperationType::ElseIf;
+}
+
+// generated by TestBuilder
+inline bool IsConditionalJump(Operation* op)
+{
+    TEST_Tracer("IsConditionalJump");
+    methodHitMap["IsConditionalJump"]++;
+    if(FunctionInjections.count("IsConditionalJump") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsConditionalJump"](p);
+    }
+    return IsConditionalJump_INTERNAL(op);
+}
+
+
+inline bool IsPartOfIfComplex(Operation* op);
+
+inline bool IsPartOfIfComplex_INTERNAL(Operation* op)
+{
+    if(op == nullptr)
+    {
+        return false;
+    }
+
+    return op->Type == OperationType::Else || op->Type == OperationType::ElseIf || op->Type == OperationType::If;
+}
+
+// generated by TestBuilder
+inline bool IsPartOfIfComplex(Operation* op)
+{
+    TEST_Tracer("IsPartOfIfComplex");
+    methodHitMap["IsPartOfIfComplex"]++;
+    if(FunctionInjections.count("IsPartOfIfComplex") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsPartOfIfComplex"](p);
+    }
+    return IsPartOfIfComplex_INTERNAL(op);
+}
+
+
+inline bool IsPartOfIfContinuation(Operation* op);
+
+inline bool IsPartOfIfContinuation_INTERNAL(Operation* op)
+{
+    if(op == nullptr)
+    {
+        return false;
+    }
+
+    return op->Type == OperationType::Else || op->Type == OperationType::ElseIf;
+}
+
+// generated by TestBuilder
+inline bool IsPartOfIfContinuation(Operation* op)
+{
+    TEST_Tracer("IsPartOfIfContinuation");
+    methodHitMap["IsPartOfIfContinuation"]++;
+    if(FunctionInjections.count("IsPartOfIfContinuation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsPartOfIfContinuation"](p);
+    }
+    return IsPartOfIfContinuation_INTERNAL(op);
+}
+
+
+inline bool IsPartOfIfConditional(Operation *op);
+
+inline bool IsPartOfIfConditional_INTERNAL(Operation *op)
+{
+    if(op == nullptr)
+    {
+        return false;
+    }
+
+    return op->Type == OperationType::If || op->Type == OperationType::ElseIf;
+}
+
+// generated by TestBuilder
+inline bool IsPartOfIfConditional(Operation *op)
+{
+    TEST_Tracer("IsPartOfIfConditional");
+    methodHitMap["IsPartOfIfConditional"]++;
+    if(FunctionInjections.count("IsPartOfIfConditional") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsPartOfIfConditional"](p);
+    }
+    return IsPartOfIfConditional_INTERNAL(op);
+}
+
+
+
+
+
+
+inline bool OperationRefIsPrimitive(Operation* op);
+
+inline bool OperationRefIsPrimitive_INTERNAL(Operation* op)
+{
+    return !IsReferenceStub(op->Value);
+}
+
+// generated by TestBuilder
+inline bool OperationRefIsPrimitive(Operation* op)
+{
+    TEST_Tracer("OperationRefIsPrimitive");
+    methodHitMap["OperationRefIsPrimitive"]++;
+    if(FunctionInjections.count("OperationRefIsPrimitive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["OperationRefIsPrimitive"](p);
+    }
+    return OperationRefIsPrimitive_INTERNAL(op);
+}
+
+
+inline bool IsSimpleCall(Operation* op);
+
+inline bool IsSimpleCall_INTERNAL(Operation* op)
+{
+    auto ref = op->Value;
+    if(IsReferenceStub(ref))
+    {
+        return ref->Name == "Object" 
+            || ref->Name == "Nothing" 
+            || ref->Name == "Array"
+            || ref->Name == "Integer"
+            || ref->Name == "Decimal"
+            || ref->Name == "String"
+            || ref->Name == "Boolean"
+            || ref->Name == "Anything";
+    }
+
+    return false;
+}
+
+// generated by TestBuilder
+inline bool IsSimpleCall(Operation* op)
+{
+    TEST_Tracer("IsSimpleCall");
+    methodHitMap["IsSimpleCall"]++;
+    if(FunctionInjections.count("IsSimpleCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsSimpleCall"](p);
+    }
+    return IsSimpleCall_INTERNAL(op);
+}
+
+
+std::vector<SlotContext> SlotContexts;
+
+std::vector<extArg_t>* ParamScopeNames = nullptr;
+
+std::vector<extArg_t> DefinedParamScopeNames;
+
+Operation* DefinedParamScopeOwner = nullptr;
+
+
+inline bool ContainsName(const std::vector<extArg_t>& names, extArg_t nameId, size_t& atPosition)
+{
+    for(size_t i=0; i<names.size(); i++)
+    {
+        if(names[i] == nameId)
+        {
+            atPosition = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+inline bool CanHaveSlot(Operation* op);
+
+inline bool CanHaveSlot_INTERNAL(Operation* op)
+{
+    return !IsSimpleCall(op) && !CallNameIsKeyword(&op->Value->Name);
+}
+
+// generated by TestBuilder
+inline bool CanHaveSlot(Operation* op)
+{
+    TEST_Tracer("CanHaveSlot");
+    methodHitMap["CanHaveSlot"]++;
+    if(FunctionInjections.count("CanHaveSlot") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["CanHaveSlot"](p);
+    }
+    return CanHaveSlot_INTERNAL(op);
+}
+
+
+inline bool HasParamSlot(Operation* op);
+
+inline bool HasParamSlot_INTERNAL(Operation* op)
+{
+    if(ParamScopeNames != nullptr || SlotContexts.empty() || !CanHaveSlot(op))
+    {
+        return false;
+    }
+
+    size_t atPosition;
+    auto& ctx = SlotContexts.back();
+    return ContainsName(ctx.SlotNames, op->EntityIndex, atPosition) && atPosition < ctx.NumberOfParamSlots;
+}
+
+// generated by TestBuilder
+inline bool HasParamSlot(Operation* op)
+{
+    TEST_Tracer("HasParamSlot");
+    methodHitMap["HasParamSlot"]++;
+    if(FunctionInjections.count("HasParamSlot") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["HasParamSlot"](p);
+    }
+    return HasParamSlot_INTERNAL(op);
+}
+
+
+inline bool IfPossibleGetSlot(PebbleVM* vm, Operation* op, extArg_t& slotId);
+
+inline bool IfPossibleGetSlot_INTERNAL(PebbleVM* vm, Operation* op, extArg_t& slotId)
+{
+    extArg_t nameId = op->EntityIndex;
+    size_t atPosition;
+
+    if(ParamScopeNames != nullptr)
+    {
+        if(!CallNameIsKeyword(&op->Value->Name) && !ContainsName(*ParamScopeNames, nameId, atPosition))
+        {
+            ParamScopeNames->push_back(nameId);
+        }
+        return false;
+    }
+
+    if(SlotContexts.empty() || !CanHaveSlot(op))
+    {
+        return false;
+    }
+
+    auto& ctx = SlotContexts.back();
+    if(!ContainsName(ctx.SlotNames, nameId, atPosition))
+    {
+        if(ctx.Depth > 0)
+        {
+            return false;
+        }
+
+        atPosition = ctx.SlotNames.size();
+        ctx.SlotNames.push_back(nameId);
+    }
+
+    slotId = vm->LocalSlots.size();
+    vm->LocalSlots.push_back({ atPosition, nameId });
+    return true;
+}
+
+// generated by TestBuilder
+inline bool IfPossibleGetSlot(PebbleVM* vm, Operation* op, extArg_t& slotId)
+{
+    TEST_Tracer("IfPossibleGetSlot");
+    methodHitMap["IfPossibleGetSlot"]++;
+    if(FunctionInjections.count("IfPossibleGetSlot") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&slotId));
+    FunctionInjections["IfPossibleGetSlot"](p);
+    }
+    return IfPossibleGetSlot_INTERNAL(vm, op, slotId);
+}
+
+
+inline void EnterSlotContext(Operation* methodOwner);
+
+inline void EnterSlotContext_INTERNAL(Operation* methodOwner)
+{
+    SlotContext ctx;
+    if(methodOwner != nullptr && methodOwner == DefinedParamScopeOwner)
+    {
+        ctx.SlotNames = DefinedParamScopeNames;
+    }
+    ctx.NumberOfParamSlots = ctx.SlotNames.size();
+    ctx.Depth = 0;
+
+    SlotContexts.push_back(ctx);
+}
+
+// generated by TestBuilder
+inline void EnterSlotContext(Operation* methodOwner)
+{
+    TEST_Tracer("EnterSlotContext");
+    methodHitMap["EnterSlotContext"]++;
+    if(FunctionInjections.count("EnterSlotContext") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&methodOwner));
+    FunctionInjections["EnterSlotContext"](p);
+    }
+    EnterSlotContext_INTERNAL(methodOwner);
+}
+
+
+inline void LeaveSlotContext();
+
+inline void LeaveSlotContext_INTERNAL()
+{
+    SlotContexts.pop_back();
+}
+
+// generated by TestBuilder
+inline void LeaveSlotContext()
+{
+    TEST_Tracer("LeaveSlotContext");
+    methodHitMap["LeaveSlotContext"]++;
+    if(FunctionInjections.count("LeaveSlotContext") == 1){
+    Params p;
+    FunctionInjections["LeaveSlotContext"](p);
+    }
+    LeaveSlotContext_INTERNAL();
+}
+
+
+inline void ChangeSlotContextDepth(int change);
+
+inline void ChangeSlotContextDepth_INTERNAL(int change)
+{
+    if(!SlotContexts.empty())
+    {
+        SlotContexts.back().Depth += change;
+    }
+}
+
+// generated by TestBuilder
+inline void ChangeSlotContextDepth(int change)
+{
+    TEST_Tracer("ChangeSlotContextDepth");
+    methodHitMap["ChangeSlotContextDepth"]++;
+    if(FunctionInjections.count("ChangeSlotContextDepth") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&change));
+    FunctionInjections["ChangeSlotContextDepth"](p);
+    }
+    ChangeSlotContextDepth_INTERNAL(change);
+}
+
+
+
+
+void FlattenOperationRefDirect(PebbleVM* vm, Operation* op);
+
+void FlattenOperationRefDirect_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId;
+    extArg_t arg = op->EntityIndex;
+
+    if(OperationRefIsPrimitive(op))
+    {
+        opId = IndexOfInstruction(BCI_LoadPrimitive);
+        AddByteCodeInstruction(vm, opId, arg);
+    }
+    else if(IfPossibleGetSlot(vm, op, arg))
+    {
+        opId = IndexOfInstruction(BCI_LoadLocal);
+        AddByteCodeInstruction(vm, opId, arg);
+    }
+    else
+    {
+        opId = IndexOfInstruction(BCI_LoadCallName);
+        AddByteCodeInstruction(vm, opId, arg);
+
+        opId = IndexOfInstruction(BCI_ResolveDirect);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+}
+
+// generated by TestBuilder
+void FlattenOperationRefDirect(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationRefDirect");
+    methodHitMap["FlattenOperationRefDirect"]++;
+    if(FunctionInjections.count("FlattenOperationRefDirect") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationRefDirect"](p);
+    }
+    FlattenOperationRefDirect_INTERNAL(vm, op);
+}
+
+
+void FlattenOperationRefScoped(PebbleVM* vm, Operation* op, bool& isRef);
+
+void FlattenOperationRefScoped_INTERNAL(PebbleVM* vm, Operation* op, bool& isRef)
+{
+    uint8_t opId = IndexOfInstruction(BCI_LoadCallName);
+    extArg_t arg = op->EntityIndex;
+
+    isRef = true;
+
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+void FlattenOperationRefScoped(PebbleVM* vm, Operation* op, bool& isRef)
+{
+    TEST_Tracer("FlattenOperationRefScoped");
+    methodHitMap["FlattenOperationRefScoped"]++;
+    if(FunctionInjections.count("FlattenOperationRefScoped") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&isRef));
+    FunctionInjections["FlattenOperationRefScoped"](p);
+    }
+    FlattenOperationRefScoped_INTERNAL(vm, op, isRef);
+}
+
+
+void FlattenOperationScopeResolutionDirect(PebbleVM* vm, Operation* op);
+
+void FlattenOperationScopeResolutionDirect_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto firstOperand = op->Operands[0];
+    FlattenOperationRefDirect(vm, firstOperand);
+}
+
+// generated by TestBuilder
+void FlattenOperationScopeResolutionDirect(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationScopeResolutionDirect");
+    methodHitMap["FlattenOperationScopeResolutionDirect"]++;
+    if(FunctionInjections.count("FlattenOperationScopeResolutionDirect") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationScopeResolutionDirect"](p);
+    }
+    FlattenOperationScopeResolutionDirect_INTERNAL(vm, op);
+}
+
+
+void FlattenOperationScopeResolutionScoped(PebbleVM* vm, Operation* op);
+
+void FlattenOperationScopeResolutionScoped_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto firstOperand = op->Operands[0];
+    if(firstOperand->Type == OperationType::ScopeResolution)
+    {
+        FlattenOperationScopeResolution(vm, firstOperand);
+    }
+    else
+    {
+        FlattenOperation(vm, firstOperand);
+    }
+
+    auto secondOperand = op->Operands[1];
+    bool isRef = false;
+    FlattenOperationRefScoped(vm, secondOperand, isRef);
+
+    if(isRef)
+    {
+        uint8_t opId = IndexOfInstruction(BCI_ResolveScoped);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+}
+
+// generated by TestBuilder
+void FlattenOperationScopeResolutionScoped(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationScopeResolutionScoped");
+    methodHitMap["FlattenOperationScopeResolutionScoped"]++;
+    if(FunctionInjections.count("FlattenOperationScopeResolutionScoped") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationScopeResolutionScoped"](p);
+    }
+    FlattenOperationScopeResolutionScoped_INTERNAL(vm, op);
+}
+
+
+void FlattenOperationScopeResolution(PebbleVM* vm, Operation* op);
+
+void FlattenOperationScopeResolution_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    if(op->Operands.size() == 1)
+    {
+        FlattenOperationScopeResolutionDirect(vm, op);
+    }
+    else
+    {
+        FlattenOperationScopeResolutionScoped(vm, op);
+    }
+}
+
+// generated by TestBuilder
+void FlattenOperationScopeResolution(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationScopeResolution");
+    methodHitMap["FlattenOperationScopeResolution"]++;
+    if(FunctionInjections.count("FlattenOperationScopeResolution") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationScopeResolution"](p);
+    }
+    FlattenOperationScopeResolution_INTERNAL(vm, op);
+}
+
+
+bool IsOperationComparision(Operation* op);
+
+bool IsOperationComparision_INTERNAL(Operation* op)
+{
+    auto opType = op->Type;
+    return opType == OperationType::IsGreaterThan
+        || opType == OperationType::IsLessThan
+        || opType == OperationType::IsGreaterThanOrEqualTo
+        || opType == OperationType::IsLessThanOrEqualTo;
+}
+
+// generated by TestBuilder
+bool IsOperationComparision(Operation* op)
+{
+    TEST_Tracer("IsOperationComparision");
+    methodHitMap["IsOperationComparision"]++;
+    if(FunctionInjections.count("IsOperationComparision") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IsOperationComparision"](p);
+    }
+    return IsOperationComparision_INTERNAL(op);
+}
+
+
+inline void FlattenOperationComparison(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationComparison_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    for(auto operand: op->Operands)
+    {
+        FlattenOperation(vm, operand);
+    }
+
+    uint8_t opId;
+    extArg_t arg;
+
+    opId = IndexOfInstruction(BCI_Cmp);
+    AddByteCodeInstruction(vm, opId, noArg);
+
+    opId = IndexOfInstruction(BCI_LoadCmp);
+    switch(op->Type)
+    {
+        case OperationType::IsLessThan:
+        arg = 3;
+        break;
+
+        case OperationType::IsGreaterThan:
+        arg = 4;
+        break;
+
+        case OperationType::IsLessThanOrEqualTo:
+        arg = 5;
+        break;
+
+        case OperationType::IsGreaterThanOrEqualTo:
+        arg = 6;
+        break;
+
+        default:
+        return;
+    }
+    
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationComparison(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationComparison");
+    methodHitMap["FlattenOperationComparison"]++;
+    if(FunctionInjections.count("FlattenOperationComparison") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationComparison"](p);
+    }
+    FlattenOperationComparison_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationGeneric(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationGeneric_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    for(auto operand: op->Operands)
+    {
+        FlattenOperation(vm, operand);
+    }
+
+    uint8_t opId;
+    extArg_t arg = noArg;
+    switch(op->Type)
+    {
+        case OperationType::Add:
+        opId = IndexOfInstruction(BCI_Add);
+        break; 
+
+        case OperationType::Subtract:
+        opId = IndexOfInstruction(BCI_Subtract);
+        break; 
+
+        case OperationType::Multiply:
+        opId = IndexOfInstruction(BCI_Multiply);
+        break; 
+
+        case OperationType::Divide:
+        opId = IndexOfInstruction(BCI_Divide);
+        break; 
+
+        case OperationType::And:
+        opId = IndexOfInstruction(BCI_And);
+        break;
+
+        case OperationType::Or:
+        opId = IndexOfInstruction(BCI_Or);
+        break;
+
+        case OperationType::Not:
+        opId = IndexOfInstruction(BCI_Not);
+        break;
+
+        case OperationType::DoTypeBinding:
+        opId = IndexOfInstruction(BCI_BindType);
+        break;
+
+        case OperationType::New:
+        opId = IndexOfInstruction(BCI_Copy);
+        break;
+
+        case OperationType::Is:
+        opId = IndexOfInstruction(BCI_Is);
+        break;
+        
+        case OperationType::IsEqual:
+        opId = IndexOfInstruction(BCI_Equals);
+        break; 
+
+        case OperationType::IsNotEqual:
+        opId = IndexOfInstruction(BCI_NotEquals);
+        break;
+
+        case OperationType::Array:
+        opId = IndexOfInstruction(BCI_Array);
+        break;
+
+        case OperationType::Print:
+        opId = IndexOfInstruction(BCI_SysCall);
+        arg = 0;
+        break;
+
+        case OperationType::If:
+        case OperationType::ElseIf:
+        case OperationType::Else:
+        case OperationType::While:
+        return;
+        
+        default:
+        LogIt(LogSeverityType::Sev3_Critical, "FlattenOperationGeneric", Msg("unknown or unimplemented, %s", ToString(op->Type)));
+        return;
+    }
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationGeneric(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationGeneric");
+    methodHitMap["FlattenOperationGeneric"]++;
+    if(FunctionInjections.count("FlattenOperationGeneric") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationGeneric"](p);
+    }
+    FlattenOperationGeneric_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationAssign(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationAssign_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto lhs = op->Operands[0];
+
+    if(lhs->Type == OperationType::Ref && !OperationRefIsPrimitive(lhs) && HasParamSlot(lhs))
+    {
+        extArg_t arg;
+        FlattenOperation(vm, op->Operands[1]);
+        IfPossibleGetSlot(vm, lhs, arg);
+        AddByteCodeInstruction(vm, IndexOfInstruction(BCI_StoreLocal), arg);
+        return;
+    }
+
+    if(op->Operands[0]->Type == OperationType::ScopeResolution)
+    {
+        FlattenOperationScopeResolution(vm, op->Operands[0]);
+    }
+    else if(op->Operands[0]->Type == OperationType::Ref)
+    {
+        FlattenOperationRefDirect(vm, op->Operands[0]);
+    }
+    else
+    {
+        FlattenOperation(vm, op->Operands[0]);
+    }
+
+    FlattenOperation(vm, op->Operands[1]);
+    uint8_t opId = IndexOfInstruction(BCI_Assign);
+    AddByteCodeInstruction(vm, opId, noArg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationAssign(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationAssign");
+    methodHitMap["FlattenOperationAssign"]++;
+    if(FunctionInjections.count("FlattenOperationAssign") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationAssign"](p);
+    }
+    FlattenOperationAssign_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationDefineMethod(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationDefineMethod_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId;
+    extArg_t arg;
+    
+    arg = noArg;
+
+    std::vector<extArg_t> paramScopeNames;
+
+    if(op->Operands.size() > 0)
+    {
+        ParamScopeNames = &paramScopeNames;
+        AddInstructionsForDefMethodParameters(vm, op->Operands[0], arg);
+        ParamScopeNames = nullptr;
+    }
+    else
+    {
+        opId = IndexOfInstruction(BCI_EnterLocal);
+        AddByteCodeInstruction(vm, opId, 1);
+
+        opId = IndexOfInstruction(BCI_LeaveLocal);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+
+    DefinedParamScopeNames = paramScopeNames;
+    DefinedParamScopeOwner = op;
+
+    opId = IndexOfInstruction(BCI_BindScope);
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationDefineMethod(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationDefineMethod");
+    methodHitMap["FlattenOperationDefineMethod"]++;
+    if(FunctionInjections.count("FlattenOperationDefineMethod") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationDefineMethod"](p);
+    }
+    FlattenOperationDefineMethod_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationEvaluateAsArrayInitialization(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationEvaluateAsArrayInitialization_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId;
+    extArg_t arg;
+
+    opId = IndexOfInstruction(BCI_LoadCallName);
+    arg = NOTHING_CALL_ID; 
+    AddByteCodeInstruction(vm, opId, arg);
+
+    opId = IndexOfInstruction(BCI_ResolveDirect);
+    AddByteCodeInstruction(vm, opId, arg);
+
+    opId = IndexOfInstruction(BCI_LoadCallName);
+    arg = ARRAY_CALL_ID;
+    AddByteCodeInstruction(vm, opId, arg);
+
+    opId = IndexOfInstruction(BCI_ResolveDirect);
+    AddByteCodeInstruction(vm, opId, noArg);
+
+    opId = IndexOfInstruction(BCI_Copy);
+    AddByteCodeInstruction(vm, opId, noArg);
+
+    AddInstructionsForEvaluateParameters(vm, op, arg);
+
+    opId = IndexOfInstruction(BCI_Eval);
+    AddByteCodeInstruction(vm, opId, 1);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationEvaluateAsArrayInitialization(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationEvaluateAsArrayInitialization");
+    methodHitMap["FlattenOperationEvaluateAsArrayInitialization"]++;
+    if(FunctionInjections.count("FlattenOperationEvaluateAsArrayInitialization") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationEvaluateAsArrayInitialization"](p);
+    }
+    FlattenOperationEvaluateAsArrayInitialization_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationNew(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationNew_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId;
+    extArg_t arg; 
+
+    opId = IndexOfInstruction(BCI_LoadCallName);
+    arg = NOTHING_CALL_ID; 
+    AddByteCodeInstruction(vm, opId, arg);
+
+    opId = IndexOfInstruction(BCI_ResolveDirect);
+    AddByteCodeInstruction(vm, opId, arg);
+
+
+    FlattenOperation(vm, op->Operands[0]);
+
+    opId = IndexOfInstruction(BCI_Copy);
+    AddByteCodeInstruction(vm, opId, noArg);
+    
+    opId = IndexOfInstruction(BCI_Eval);
+    arg = 0;
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationNew(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationNew");
+    methodHitMap["FlattenOperationNew"]++;
+    if(FunctionInjections.count("FlattenOperationNew") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationNew"](p);
+    }
+    FlattenOperationNew_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationEvaluate(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationEvaluate_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto callerOp = op->Operands[0];
+    auto methodOp = op->Operands[1];
+
+    uint8_t opId;
+    extArg_t arg;
+
+    if(methodOp->Type == OperationType::DoTypeBinding && methodOp->Operands[0]->EntityIndex == ARRAY_CALL_ID)
+    {
+        FlattenOperationEvaluateAsArrayInitialization(vm, op);
+        return;
+    }
+
+    if(methodOp->Type == OperationType::Ref && OperationRefIsPrimitive(methodOp) && methodOp->EntityIndex == ARRAY_CALL_ID)
+    {
+        FlattenOperationEvaluateAsArrayInitialization(vm, op);
+        return;
+    }
+
+    if(callerOp->Type == OperationType::Ref && callerOp->Value->Name == "Nothing")
+    {
+        opId = IndexOfInstruction(BCI_LoadCallName);
+        arg = NOTHING_CALL_ID; 
+        AddByteCodeInstruction(vm, opId, arg);
+
+        opId = IndexOfInstruction(BCI_ResolveDirect);
+        AddByteCodeInstruction(vm, opId, arg);
+
+        FlattenOperation(vm, methodOp);
+    }
+    else
+    {
+        FlattenOperation(vm, callerOp);
+
+        opId = IndexOfInstruction(BCI_Dup);
+        AddByteCodeInstruction(vm, opId, noArg);
+
+        opId = IndexOfInstruction(BCI_LoadCallName);
+        arg = methodOp->EntityIndex;
+        AddByteCodeInstruction(vm, opId, arg);
+
+        opId = IndexOfInstruction(BCI_ResolveScoped);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+    
+
+    opId = IndexOfInstruction(BCI_Copy);
+    AddByteCodeInstruction(vm, opId, noArg);
+    
+    arg = 0;
+    AddInstructionsForEvaluateParameters(vm, op, arg);
+
+    opId = IndexOfInstruction(BCI_Eval);
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationEvaluate(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationEvaluate");
+    methodHitMap["FlattenOperationEvaluate"]++;
+    if(FunctionInjections.count("FlattenOperationEvaluate") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationEvaluate"](p);
+    }
+    FlattenOperationEvaluate_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationEvaluateHere(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationEvaluateHere_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    op = op->Operands[0];
+    auto callerOp = op->Operands[0];
+    auto methodOp = op->Operands[1];
+
+    uint8_t opId;
+    extArg_t arg;
+
+    if(callerOp->Type == OperationType::Ref && callerOp->Value->Name == "Nothing")
+    {
+        opId = IndexOfInstruction(BCI_LoadCallName);
+        arg = methodOp->EntityIndex;
+        AddByteCodeInstruction(vm, opId, arg);
+
+        opId = IndexOfInstruction(BCI_ResolveDirect);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+    else
+    {
+        FlattenOperation(vm, callerOp);
+
+        opId = IndexOfInstruction(BCI_LoadCallName);
+        arg = methodOp->EntityIndex;
+        AddByteCodeInstruction(vm, opId, arg);
+
+        opId = IndexOfInstruction(BCI_ResolveScoped);
+        AddByteCodeInstruction(vm, opId, noArg);
+    }
+
+    opId = IndexOfInstruction(BCI_Copy);
+    AddByteCodeInstruction(vm, opId, noArg);
+    
+    arg = 0;
+    AddInstructionsForEvaluateParameters(vm, op, arg);
+
+    opId = IndexOfInstruction(BCI_EvalHere);
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationEvaluateHere(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationEvaluateHere");
+    methodHitMap["FlattenOperationEvaluateHere"]++;
+    if(FunctionInjections.count("FlattenOperationEvaluateHere") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationEvaluateHere"](p);
+    }
+    FlattenOperationEvaluateHere_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationReturn(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationReturn_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId;
+    extArg_t arg;
+    
+    if(op->Operands.size() == 0)
+    {
+        arg = noArg;
+    }
+    else
+    {
+        FlattenOperation(vm, op->Operands[0]);
+        arg = 1;
+
+        auto& lastIns = vm->ByteCodeProgram.back();
+        if(!SlotContexts.empty() && lastIns.Op == IndexOfInstruction(BCI_Eval))
+        {
+            opId = IndexOfInstruction(BCI_TailEval);
+            RewriteByteCodeInstruction(vm, opId, lastIns.Arg, CurrentInstructionId(vm));
+            return;
+        }
+    }
+
+    opId = IndexOfInstruction(BCI_Return);
+    AddByteCodeInstruction(vm, opId, arg);    
+}
+
+// generated by TestBuilder
+inline void FlattenOperationReturn(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationReturn");
+    methodHitMap["FlattenOperationReturn"]++;
+    if(FunctionInjections.count("FlattenOperationReturn") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationReturn"](p);
+    }
+    FlattenOperationReturn_INTERNAL(vm, op);
+}
+
+
+inline void FlattenOperationAsk(PebbleVM* vm, Operation* op);
+
+inline void FlattenOperationAsk_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    uint8_t opId = IndexOfInstruction(BCI_SysCall);
+    extArg_t arg;
+
+    if(op->Operands.size() > 0)
+    {
+        FlattenOperation(vm, op->Operands[0]);
+        arg = 0;
+        AddByteCodeInstruction(vm, opId, noArg);
+
+        AddEndLineInstruction(vm);
+    }
+
+    arg = 1;
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void FlattenOperationAsk(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperationAsk");
+    methodHitMap["FlattenOperationAsk"]++;
+    if(FunctionInjections.count("FlattenOperationAsk") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperationAsk"](p);
+    }
+    FlattenOperationAsk_INTERNAL(vm, op);
+}
+
+
+void FlattenOperation(PebbleVM* vm, Operation* op);
+
+void FlattenOperation_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    if(op->Type == OperationType::ScopeResolution)
+    {
+        FlattenOperationScopeResolution(vm, op);
+    }
+    else if(op->Type == OperationType::Ref)
+    {
+        FlattenOperationRefDirect(vm, op);
+    }
+    else if(op->Type == OperationType::Assign)
+    {
+        FlattenOperationAssign(vm, op);
+    }
+    else if(op->Type == OperationType::DefineMethod)
+    {
+        FlattenOperationDefineMethod(vm, op);
+        GlobalBlockOwner = op;
+    }
+    else if(op->Type == OperationType::Evaluate)
+    {
+        FlattenOperationEvaluate(vm, op);
+    }
+    else if(op->Type == OperationType::Return)
+    {
+        FlattenOperationReturn(vm, op);
+    }
+    else if(IsOperationComparision(op))
+    {
+        FlattenOperationComparison(vm, op);
+    }
+    else if(op->Type == OperationType::EvaluateHere)
+    {
+        FlattenOperationEvaluateHere(vm, op);
+    }
+    else if(op->Type == OperationType::Ask)
+    {
+        FlattenOperationAsk(vm, op);
+    }
+    else if(op->Type == OperationType::New)
+    {
+        FlattenOperationNew(vm, op);
+    }
+    else
+    {
+        FlattenOperationGeneric(vm, op);
+    }
+}
+
+// generated by TestBuilder
+void FlattenOperation(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FlattenOperation");
+    methodHitMap["FlattenOperation"]++;
+    if(FunctionInjections.count("FlattenOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FlattenOperation"](p);
+    }
+    FlattenOperation_INTERNAL(vm, op);
+}
+
+
+
+
+
+
+inline void HandleAnonymousScope(PebbleVM* vm, Block* block);
+
+inline void HandleAnonymousScope_INTERNAL(PebbleVM* vm, Block* block)
+{
+    uint8_t opId;
+    extArg_t arg = noArg;
+
+    opId = IndexOfInstruction(BCI_EnterLocal);
+    AddByteCodeInstruction(vm, opId, arg);
+
+    ChangeSlotContextDepth(1);
+    FlattenBlock(vm, block);
+    ChangeSlotContextDepth(-1);
+    
+    opId = IndexOfInstruction(BCI_LeaveLocal);
+    AddByteCodeInstruction(vm, opId, arg);
+
+    opId = IndexOfInstruction(BCI_DropTOS);
+    AddByteCodeInstruction(vm, opId, arg);
+}
+
+// generated by TestBuilder
+inline void HandleAnonymousScope(PebbleVM* vm, Block* block)
+{
+    TEST_Tracer("HandleAnonymousScope");
+    methodHitMap["HandleAnonymousScope"]++;
+    if(FunctionInjections.count("HandleAnonymousScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    FunctionInjections["HandleAnonymousScope"](p);
+    }
+    HandleAnonymousScope_INTERNAL(vm, block);
+}
+
+
+inline void HandleWhile(PebbleVM* vm, Block* block, extArg_t whileInstructionStart);
+
+inline void HandleWhile_INTERNAL(PebbleVM* vm, Block* block, extArg_t whileInstructionStart)
+{
+    uint8_t opId;
+    extArg_t arg = noArg;
+    extArg_t JumpInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_JumpFalse));
+
+    FlattenBlock(vm, block);
+    
+    opId = IndexOfInstruction(BCI_Jump);
+    arg = whileInstructionStart;
+    AddByteCodeInstruction(vm, opId, arg);
+
+
+    opId = IndexOfInstruction(BCI_JumpFalse);
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, JumpInstructionStart);
+}
+
+// generated by TestBuilder
+inline void HandleWhile(PebbleVM* vm, Block* block, extArg_t whileInstructionStart)
+{
+    TEST_Tracer("HandleWhile");
+    methodHitMap["HandleWhile"]++;
+    if(FunctionInjections.count("HandleWhile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    p.push_back(static_cast<const void*>(&whileInstructionStart));
+    FunctionInjections["HandleWhile"](p);
+    }
+    HandleWhile_INTERNAL(vm, block, whileInstructionStart);
+}
+
+
+inline void HandleDefineMethod(PebbleVM* vm, Block* block, Operation* blockOwner);
+
+inline void HandleDefineMethod_INTERNAL(PebbleVM* vm, Block* block, Operation* blockOwner)
+{
+    uint8_t opId;
+    extArg_t arg = noArg;
+
+    extArg_t BindInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_BindSection));
+    extArg_t JumpInstructionStart = AddUnresolvedInstruction(vm, IndexOfInstruction(BCI_Jump));
+
+    opId = IndexOfInstruction(BCI_BindSection);
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, BindInstructionStart);
+
+    EnterSlotContext(blockOwner);
+    FlattenBlock(vm, block);
+    LeaveSlotContext();
+
+    opId = IndexOfInstruction(BCI_Return);
+    AddByteCodeInstruction(vm, opId, noArg);
+
+    opId = IndexOfInstruction(BCI_Jump);
+    arg = NextInstructionId(vm);
+    RewriteByteCodeInstruction(vm, opId, arg, JumpInstructionStart);
+    AddEndLineInstruction(vm);
+}
+
+// generated by TestBuilder
+inline void HandleDefineMethod(PebbleVM* vm, Block* block, Operation* blockOwner)
+{
+    TEST_Tracer("HandleDefineMethod");
+    methodHitMap["HandleDefineMethod"]++;
+    if(FunctionInjections.count("HandleDefineMethod") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    p.push_back(static_cast<const void*>(&blockOwner));
+    FunctionInjections["HandleDefineMethod"](p);
+    }
+    HandleDefineMethod_INTERNAL(vm, block, blockOwner);
+}
+
+
+inline void HandleIf(PebbleVM* vm, Block* block, JumpContext& ctx);
+
+inline void HandleIf_INTERNAL(PebbleVM* vm, Block* block, JumpContext& ctx)
+{
+    HandleAnonymousScope(vm, block);
+    AddInstructionsForUnresolvedJump(vm, ctx);
+}
+
+// generated by TestBuilder
+inline void HandleIf(PebbleVM* vm, Block* block, JumpContext& ctx)
+{
+    TEST_Tracer("HandleIf");
+    methodHitMap["HandleIf"]++;
+    if(FunctionInjections.count("HandleIf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["HandleIf"](p);
+    }
+    HandleIf_INTERNAL(vm, block, ctx);
+}
+
+
+inline void HandleFlatteningControlFlow(PebbleVM* vm, Block* block, Operation* blockOwner, extArg_t blockOwnerInstructionStart, JumpContext& ctx);
+
+inline void HandleFlatteningControlFlow_INTERNAL(PebbleVM* vm, Block* block, Operation* blockOwner, extArg_t blockOwnerInstructionStart, JumpContext& ctx)
+{
+    if(JumpContextNeedsResolution(ctx) && !IsPartOfIfComplex(blockOwner))
+    {
+        ResolveJumpContext(vm, ctx);
+    }
+
+    if(blockOwner == nullptr)
+    {
+        HandleAnonymousScope(vm, block);
+    }
+    else if(blockOwner->Type == OperationType::While)
+    {
+        HandleWhile(vm, block, blockOwnerInstructionStart);
+    }
+    else if(blockOwner->Type == OperationType::If || blockOwner->Type == OperationType::ElseIf)
+    {
+        HandleIf(vm, block, ctx);
+    }
+    else if(blockOwner->Type == OperationType::Else)
+    {
+        HandleAnonymousScope(vm, block);
+    }
+    else if(blockOwner->Type == OperationType::DefineMethod)
+    {
+        HandleDefineMethod(vm, block, blockOwner);
+    }
+    else if(blockOwner->Type == OperationType::Ref)
+    {
+        HandleDefineMethod(vm, block, nullptr);
+    }
+    else
+    {
+        HandleAnonymousScope(vm, block);
+    }
+}
+
+// generated by TestBuilder
+inline void HandleFlatteningControlFlow(PebbleVM* vm, Block* block, Operation* blockOwner, extArg_t blockOwnerInstructionStart, JumpContext& ctx)
+{
+    TEST_Tracer("HandleFlatteningControlFlow");
+    methodHitMap["HandleFlatteningControlFlow"]++;
+    if(FunctionInjections.count("HandleFlatteningControlFlow") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    p.push_back(static_cast<const void*>(&blockOwner));
+    p.push_back(static_cast<const void*>(&blockOwnerInstructionStart));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["HandleFlatteningControlFlow"](p);
+    }
+    HandleFlatteningControlFlow_INTERNAL(vm, block, blockOwner, blockOwnerInstructionStart, ctx);
+}
+
+
+inline void HandleFlatteningOperation(PebbleVM* vm, Operation* op, extArg_t& blockOwnerInstructionStart, Operation** blockOwner, JumpContext& ctx);
+
+inline void HandleFlatteningOperation_INTERNAL(PebbleVM* vm, Operation* op, extArg_t& blockOwnerInstructionStart, Operation** blockOwner, JumpContext& ctx)
+{
+    if(JumpContextNeedsResolution(ctx) && !IsPartOfIfContinuation(op))
+    {
+        ResolveJumpContext(vm, ctx);
+    }
+    else if(JumpContextHasUnresolvedClause(ctx))
+    {
+        ResolveJumpContextClause(vm, ctx);
+    }
+    
+    blockOwnerInstructionStart = NextInstructionId(vm);
+    GlobalBlockOwner = nullptr;
+    FlattenOperation(vm, op);
+    if(GlobalBlockOwner != nullptr)
+    {
+        *blockOwner = GlobalBlockOwner;
+    }
+    else
+    {
+        *blockOwner = op;
+    }
+    
+
+    vm->ByteCodeLineAssociation.push_back(NextInstructionId(vm));
+    
+    if(!IsConditionalJump((*blockOwner)) && (*blockOwner)->Type != OperationType::Else && (*blockOwner)->Type != OperationType::DefineMethod) 
+    {
+        AddEndLineInstruction(vm);
+    }
+
+    if(IsPartOfIfConditional(op))
+    {
+        AddInstructionsForUnresolvedJumpFalse(vm, ctx);
+    }
+}
+
+// generated by TestBuilder
+inline void HandleFlatteningOperation(PebbleVM* vm, Operation* op, extArg_t& blockOwnerInstructionStart, Operation** blockOwner, JumpContext& ctx)
+{
+    TEST_Tracer("HandleFlatteningOperation");
+    methodHitMap["HandleFlatteningOperation"]++;
+    if(FunctionInjections.count("HandleFlatteningOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&blockOwnerInstructionStart));
+    p.push_back(static_cast<const void*>(&blockOwner));
+    p.push_back(static_cast<const void*>(&ctx));
+    FunctionInjections["HandleFlatteningOperation"](p);
+    }
+    HandleFlatteningOperation_INTERNAL(vm, op, blockOwnerInstructionStart, blockOwner, ctx);
+}
+
+
+void FlattenBlock(PebbleVM* vm, Block* block);
+
+void FlattenBlock_INTERNAL(PebbleVM* vm, Block* block)
+{
+    Operation* blockOwner = nullptr;
+    extArg_t blockOwnerInstructionStart = 0;
+    
+    JumpContext ctx;
+    InitJumpContext(ctx);
+
+    for(auto exec: block->Executables)
+    {
+        switch(exec->ExecType)
+        {
+            case ExecutableType::Block:
+            HandleFlatteningControlFlow(vm, static_cast<Block*>(exec), blockOwner, blockOwnerInstructionStart, ctx);
+            blockOwner = nullptr;
+            break;
+
+            case ExecutableType::Operation:
+            HandleFlatteningOperation(vm, static_cast<Operation*>(exec), blockOwnerInstructionStart, &blockOwner, ctx);
+
+            break;
+        }
+    }
+
+    if(JumpContextNeedsResolution(ctx) && !IsPartOfIfContinuation(blockOwner))
+    {
+        ResolveJumpContext(vm, ctx);
+    }
+}
+
+// generated by TestBuilder
+void FlattenBlock(PebbleVM* vm, Block* block)
+{
+    TEST_Tracer("FlattenBlock");
+    methodHitMap["FlattenBlock"]++;
+    if(FunctionInjections.count("FlattenBlock") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&block));
+    FunctionInjections["FlattenBlock"](p);
+    }
+    FlattenBlock_INTERNAL(vm, block);
+}
+
+
+
+std::vector<Object*> PrimitiveObjectsEncountered;
+
+
+bool CallNamesContains(PebbleVM* vm, String callName, size_t& atPosition);
+
+bool CallNamesContains_INTERNAL(PebbleVM* vm, String callName, size_t& atPosition)
+{
+    for(size_t i=0; i<vm->CallNames.size(); i++)
+    {
+        auto name = vm->CallNames[i];
+        if(name == callName)
+        {
+            atPosition = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// generated by TestBuilder
+bool CallNamesContains(PebbleVM* vm, String callName, size_t& atPosition)
+{
+    TEST_Tracer("CallNamesContains");
+    methodHitMap["CallNamesContains"]++;
+    if(FunctionInjections.count("CallNamesContains") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&callName));
+    p.push_back(static_cast<const void*>(&atPosition));
+    FunctionInjections["CallNamesContains"](p);
+    }
+    return CallNamesContains_INTERNAL(vm, callName, atPosition);
+}
+
+
+void IfNeededAddReferenceName(PebbleVM* vm, Operation* op);
+
+void IfNeededAddReferenceName_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto callName = op->Value->Name;
+
+    size_t atPosition;
+    if(CallNamesContains(vm, callName, atPosition))
+    {
+        op->EntityIndex = atPosition + SIMPLE_CALLS;
+        return;
+    }
+
+    op->EntityIndex = vm->CallNames.size() + SIMPLE_CALLS;
+    vm->CallNames.push_back(callName);
+}
+
+// generated by TestBuilder
+void IfNeededAddReferenceName(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("IfNeededAddReferenceName");
+    methodHitMap["IfNeededAddReferenceName"]++;
+    if(FunctionInjections.count("IfNeededAddReferenceName") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IfNeededAddReferenceName"](p);
+    }
+    IfNeededAddReferenceName_INTERNAL(vm, op);
+}
+
+
+bool EncounteredPrimitiveObject(Object* obj, size_t& atPosition);
+
+bool EncounteredPrimitiveObject_INTERNAL(Object* obj, size_t& atPosition)
+{
+    for(size_t i=0; i<PrimitiveObjectsEncountered.size(); i++)
+    {
+        auto encounteredObj = PrimitiveObjectsEncountered[i];
+        if(obj == encounteredObj)
+        {
+            atPosition = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// generated by TestBuilder
+bool EncounteredPrimitiveObject(Object* obj, size_t& atPosition)
+{
+    TEST_Tracer("EncounteredPrimitiveObject");
+    methodHitMap["EncounteredPrimitiveObject"]++;
+    if(FunctionInjections.count("EncounteredPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    p.push_back(static_cast<const void*>(&atPosition));
+    FunctionInjections["EncounteredPrimitiveObject"](p);
+    }
+    return EncounteredPrimitiveObject_INTERNAL(obj, atPosition);
+}
+
+
+BindingType ObjectClassToType(Object* obj);
+
+BindingType ObjectClassToType_INTERNAL(Object* obj)
+{
+    if(obj->Class == IntegerClass)
+    {
+        return &IntegerType;
+    }
+    else if(obj->Class == DecimalClass)
+    {
+        return &DecimalType;
+    }
+    else if(obj->Class == BooleanClass)
+    {
+        return &BooleanType;
+    }
+    else if(obj->Class == StringClass)
+    {
+        return &StringType;
+    }
+    else if(obj->Class == MethodClass)
+    {
+        return &MethodType;
+    }
+    else
+    {
+        return &NothingType;
+    }
+}
+
+// generated by TestBuilder
+BindingType ObjectClassToType(Object* obj)
+{
+    TEST_Tracer("ObjectClassToType");
+    methodHitMap["ObjectClassToType"]++;
+    if(FunctionInjections.count("ObjectClassToType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ObjectClassToType"](p);
+    }
+    return ObjectClassToType_INTERNAL(obj);
+}
+
+
+void AssignValueFromObject(Call* c, Object* obj);
+
+void AssignValueFromObject_INTERNAL(Call* c, Object* obj)
+{
+    if(obj->Class == IntegerClass)
+    {
+        c->BoundValue.i = *static_cast<int*>(obj->Value);
+    }
+    else if(obj->Class == DecimalClass)
+    {
+        c->BoundValue.d = *static_cast<double*>(obj->Value);
+    }
+    else if(obj->Class == StringClass)
+    {
+        c->BoundValue.s = StringConstructor(*static_cast<String*>(obj->Value));
+    }
+    else if(obj->Class == BooleanClass)
+    {
+        c->BoundValue.b = *static_cast<bool*>(obj->Value);
+    }
+}
+
+// generated by TestBuilder
+void AssignValueFromObject(Call* c, Object* obj)
+{
+    TEST_Tracer("AssignValueFromObject");
+    methodHitMap["AssignValueFromObject"]++;
+    if(FunctionInjections.count("AssignValueFromObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&c));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["AssignValueFromObject"](p);
+    }
+    AssignValueFromObject_INTERNAL(c, obj);
+}
+
+
+void IfNeededAddConstPrimitive(PebbleVM* vm, Operation* op);
+
+void IfNeededAddConstPrimitive_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    auto obj = op->Value->To;
+    
+    size_t atPosition;
+    if(EncounteredPrimitiveObject(obj, atPosition))
+    {
+        op->EntityIndex = atPosition;
+        return;
+    }
+
+    op->EntityIndex = PrimitiveObjectsEncountered.size();
+    PrimitiveObjectsEncountered.push_back(obj);
+    
+    Call* call = CallConstructor(vm->PrimitiveSlab);
+    AssignValueFromObject(call, obj);
+    BindScope(call, &SomethingScope);
+    BindType(call, ObjectClassToType(op->Value->To));
+    vm->ConstPrimitives.push_back(call);
+}
+
+// generated by TestBuilder
+void IfNeededAddConstPrimitive(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("IfNeededAddConstPrimitive");
+    methodHitMap["IfNeededAddConstPrimitive"]++;
+    if(FunctionInjections.count("IfNeededAddConstPrimitive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["IfNeededAddConstPrimitive"](p);
+    }
+    IfNeededAddConstPrimitive_INTERNAL(vm, op);
+}
+
+
+void AssignEntityIndexForSimpleCall(Operation* op);
+
+void AssignEntityIndexForSimpleCall_INTERNAL(Operation* op)
+{
+    auto name = op->Value->Name;
+    if(name == "Object")
+    {
+        op->EntityIndex = OBJECT_CALL_ID;
+    }
+    else if(name == "Nothing")
+    {
+        op->EntityIndex = NOTHING_CALL_ID;
+    }
+    else if(name == "Array")
+    {
+        op->EntityIndex = ARRAY_CALL_ID;
+    }
+    else if(name == "Integer")
+    {
+        op->EntityIndex = INTEGER_CALL_ID;
+    }
+    else if(name == "Decimal")
+    {
+        op->EntityIndex = DECIMAL_CALL_ID;
+    }
+    else if(name == "String")
+    {
+        op->EntityIndex = STRING_CALL_ID;
+    }
+    else if(name == "Boolean")
+    {
+        op->EntityIndex = BOOLEAN_CALL_ID;
+    }
+    else if(name == "Anything")
+    {
+        op->EntityIndex = ANYTHING_CALL_ID;
+    }
+    else
+    {
+        LogIt(LogSeverityType::Sev1_Notify, 
+            "AssignEntityIndexForSimpleCall", "bad simple call name");
+    }
+}
+
+// generated by TestBuilder
+void AssignEntityIndexForSimpleCall(Operation* op)
+{
+    TEST_Tracer("AssignEntityIndexForSimpleCall");
+    methodHitMap["AssignEntityIndexForSimpleCall"]++;
+    if(FunctionInjections.count("AssignEntityIndexForSimpleCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["AssignEntityIndexForSimpleCall"](p);
+    }
+    AssignEntityIndexForSimpleCall_INTERNAL(op);
+}
+
+
+void FirstPassOperation(PebbleVM* vm, Operation* op);
+
+void FirstPassOperation_INTERNAL(PebbleVM* vm, Operation* op)
+{
+    if(op->Type == OperationType::Ref)
+    {
+        if(OperationRefIsPrimitive(op))
+        {
+            IfNeededAddConstPrimitive(vm, op);
+        }
+        else if(IsSimpleCall(op))
+        {
+            AssignEntityIndexForSimpleCall(op);
+        }
+        else
+        {
+            IfNeededAddReferenceName(vm, op);
+        }
+        return;
+    }
+
+    for(auto operand: op->Operands)
+    {
+        FirstPassOperation(vm, operand);
+    }
+}
+
+// generated by TestBuilder
+void FirstPassOperation(PebbleVM* vm, Operation* op)
+{
+    TEST_Tracer("FirstPassOperation");
+    methodHitMap["FirstPassOperation"]++;
+    if(FunctionInjections.count("FirstPassOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["FirstPassOperation"](p);
+    }
+    FirstPassOperation_INTERNAL(vm, op);
+}
+
+
+void FirstPassBlock(PebbleVM* vm, Block* b);
+
+void FirstPassBlock_INTERNAL(PebbleVM* vm, Block* b)
+{
+    for(auto exec: b->Executables)
+    {
+        switch(exec->ExecType)
+        {
+            case ExecutableType::Block:
+            FirstPassBlock(vm, static_cast<Block*>(exec));
+            break;
+
+            case ExecutableType::Operation:
+            FirstPassOperation(vm, static_cast<Operation*>(exec));
+            break;
+        }
+    }
+}
+
+// generated by TestBuilder
+void FirstPassBlock(PebbleVM* vm, Block* b)
+{
+    TEST_Tracer("FirstPassBlock");
+    methodHitMap["FirstPassBlock"]++;
+    if(FunctionInjections.count("FirstPassBlock") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&b));
+    FunctionInjections["FirstPassBlock"](p);
+    }
+    FirstPassBlock_INTERNAL(vm, b);
+}
+
+std::vector<void*> DeletedValueAddrs;
+
+
+void InitEntityLists(PebbleVM* vm);
+
+void InitEntityLists_INTERNAL(PebbleVM* vm)
+{
+    ReleaseConstPrimitives(vm);
+    vm->ConstPrimitives.reserve(64);
+
+    vm->CallNames.clear();
+    vm->CallNames.reserve(64);
+
+    PrimitiveObjectsEncountered.clear();
+    PrimitiveObjectsEncountered.reserve(64);
+    
+    vm->LocalSlots.clear();
+    SlotContexts.clear();
+    ParamScopeNames = nullptr;
+    DefinedParamScopeNames.clear();
+    DefinedParamScopeOwner = nullptr;
+
+    vm->ByteCodeProgram.clear();
+    vm->ByteCodeLineAssociation.clear();
+    vm->ByteCodeLineAssociation.push_back(0);
+
+    DeletedValueAddrs.clear();
+    DeletedValueAddrs.reserve(64);
+}
+
+// generated by TestBuilder
+void InitEntityLists(PebbleVM* vm)
+{
+    TEST_Tracer("InitEntityLists");
+    methodHitMap["InitEntityLists"]++;
+    if(FunctionInjections.count("InitEntityLists") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["InitEntityLists"](p);
+    }
+    InitEntityLists_INTERNAL(vm);
+}
+
+
+void FirstPassProgram(PebbleVM* vm, Program* p);
+
+void FirstPassProgram_INTERNAL(PebbleVM* vm, Program* p)
+{
+    FirstPassBlock(vm, p->Main);
+}
+
+// generated by TestBuilder
+void FirstPassProgram(PebbleVM* vm, Program* p)
+{
+    TEST_Tracer("FirstPassProgram");
+    methodHitMap["FirstPassProgram"]++;
+    if(FunctionInjections.count("FirstPassProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["FirstPassProgram"](p);
+    }
+    FirstPassProgram_INTERNAL(vm, p);
+}
+
+
+void SafeDeleteObjectValue(Object* obj);
+
+void SafeDeleteObjectValue_INTERNAL(Object* obj)
+{
+    if(obj->Value == nullptr)
+    {
+        return;
+    }
+
+
+    for(void* addr: DeletedValueAddrs)
+    {
+        if(obj->Value == addr)
+        {
+            return;
+        }
+    }
+
+    DeletedValueAddrs.push_back(obj->Value);
+    ObjectValueDestructor(obj->Class, obj->Value);
+}
+
+// generated by TestBuilder
+void SafeDeleteObjectValue(Object* obj)
+{
+    TEST_Tracer("SafeDeleteObjectValue");
+    methodHitMap["SafeDeleteObjectValue"]++;
+    if(FunctionInjections.count("SafeDeleteObjectValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["SafeDeleteObjectValue"](p);
+    }
+    SafeDeleteObjectValue_INTERNAL(obj);
+}
+
+
+void InternalDeleteObject(Object* obj);
+
+void InternalDeleteObject_INTERNAL(Object* obj)
+{
+    ScopeDestructor(ObjectScopeSlab, obj->Attributes);
+    if(IsCallable(obj))
+    {
+        MethodDestructor(obj->Action);
+    }
+    SafeDeleteObjectValue(obj);
+    
+    ObjectDestructor(obj);
+}
+
+// generated by TestBuilder
+void InternalDeleteObject(Object* obj)
+{
+    TEST_Tracer("InternalDeleteObject");
+    methodHitMap["InternalDeleteObject"]++;
+    if(FunctionInjections.count("InternalDeleteObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["InternalDeleteObject"](p);
+    }
+    InternalDeleteObject_INTERNAL(obj);
+}
+
+
+void FlattenProgram(PebbleVM* vm, Program* p);
+
+void FlattenProgram_INTERNAL(PebbleVM* vm, Program* p)
+{
+    InitEntityLists(vm);
+    FirstPassProgram(vm, p);
+    FlattenBlock(vm, p->Main);
+    FuseInstructions(vm);
+
+    for(auto obj: PrimitiveObjectsEncountered)
+    {
+        InternalDeleteObject(obj);
+    }
+}
+
+// generated by TestBuilder
+void FlattenProgram(PebbleVM* vm, Program* p)
+{
+    TEST_Tracer("FlattenProgram");
+    methodHitMap["FlattenProgram"]++;
+    if(FunctionInjections.count("FlattenProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["FlattenProgram"](p);
+    }
+    FlattenProgram_INTERNAL(vm, p);
+}
@@ -0,0 +1,219 @@
+#include "test.h"
+#include <iostream>
+
+#include "fusion.h"
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "diagnostics.h"
+
+
+bool g_fusionStatsOn = false;
+
+
+
+
+inline bool TakesInstructionId(uint8_t op);
+
+inline bool TakesInstructionId_INTERNAL(uint8_t op)
+{
+    return op == OP_Jump || op == OP_JumpFalse || op == OP_BindSection;
+}
+
+// generated by TestBuilder
+inline bool TakesInstructionId(uint8_t op)
+{
+    TEST_Tracer("TakesInstructionId");
+    methodHitMap["TakesInstructionId"]++;
+    if(FunctionInjections.count("TakesInstructionId") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["TakesInstructionId"](p);
+    }
+    return TakesInstructionId_INTERNAL(op);
+}
+
+
+inline std::vector<bool> FindBoundaries(PebbleVM* vm)
+{
+    std::vector<bool> boundaries(vm->ByteCodeProgram.size() + 1, false);
+    for(auto& ins: vm->ByteCodeProgram)
+    {
+        if(TakesInstructionId(ins.Op) && ins.Arg < boundaries.size())
+        {
+            boundaries[ins.Arg] = true;
+        }
+    }
+
+    for(auto id: vm->ByteCodeLineAssociation)
+    {
+        if(id + 1 < boundaries.size())
+        {
+            boundaries[id + 1] = true;
+        }
+    }
+
+    return boundaries;
+}
+
+
+inline bool MatchesSequence(PebbleVM* vm, extArg_t at, const std::vector<bool>& boundaries, const std::vector<uint8_t>& ops)
+{
+    if(at + ops.size() > vm->ByteCodeProgram.size())
+    {
+        return false;
+    }
+
+    for(size_t i=0; i<ops.size(); i++)
+    {
+        if(vm->ByteCodeProgram[at+i].Op != ops[i] || (i > 0 && boundaries[at+i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+inline extArg_t FuseSequenceAt(PebbleVM* vm, extArg_t at, const std::vector<bool>& boundaries, ByteCodeInstruction& ins)
+{
+    auto& program = vm->ByteCodeProgram;
+
+    if(MatchesSequence(vm, at, boundaries, { OP_Cmp, OP_LoadCmp, OP_JumpFalse })
+        && program[at+1].Arg < 8 && program[at+2].Arg <= MaxCmpJumpTarget)
+    {
+        ins = { OP_CmpJumpFalse, static_cast<uint32_t>(CmpJumpFalseArg(program[at+1].Arg, program[at+2].Arg)) };
+        return 3;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadCallName, OP_ResolveDirect }))
+    {
+        ins = { OP_ResolveName, program[at].Arg };
+        return 2;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadPrimitive, OP_Add }) && program[at].Arg < vm->ConstPrimitives.size())
+    {
+        ins = { OP_AddConst, program[at].Arg };
+        return 2;
+    }
+
+    if(MatchesSequence(vm, at, boundaries, { OP_LoadPrimitive, OP_Subtract }) && program[at].Arg < vm->ConstPrimitives.size())
+    {
+        ins = { OP_SubtractConst, program[at].Arg };
+        return 2;
+    }
+
+    ins = program[at];
+    return 1;
+}
+
+
+inline void RelocateInstruction(ByteCodeInstruction& ins, const std::vector<extArg_t>& newIds)
+{
+    if(TakesInstructionId(ins.Op) && ins.Arg < newIds.size())
+    {
+        ins.Arg = newIds[ins.Arg];
+    }
+    else if(ins.Op == OP_CmpJumpFalse)
+    {
+        auto target = CmpJumpTargetOf(ins.Arg);
+        ins.Arg = CmpJumpFalseArg(CmpJumpComparisonOf(ins.Arg), newIds[target]);
+    }
+}
+
+
+
+
+void FuseInstructions(PebbleVM* vm);
+
+void FuseInstructions_INTERNAL(PebbleVM* vm)
+{
+    vm->FusionStats = {};
+
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+    auto boundaries = FindBoundaries(vm);
+
+    std::vector<ByteCodeInstruction> fusedProgram;
+    fusedProgram.reserve(programEnd);
+
+    std::vector<extArg_t> newIds(programEnd + 1);
+
+    for(extArg_t i=0; i<programEnd;)
+    {
+        ByteCodeInstruction ins;
+        extArg_t length = FuseSequenceAt(vm, i, boundaries, ins);
+        if(length > 1)
+        {
+            vm->FusionStats.FusedSequences++;
+            vm->FusionStats.RemovedInstructions += length - 1;
+        }
+
+        for(extArg_t j=0; j<length; j++)
+        {
+            newIds[i+j] = fusedProgram.size();
+        }
+        fusedProgram.push_back(ins);
+        i += length;
+    }
+    newIds[programEnd] = fusedProgram.size();
+
+    for(auto& ins: fusedProgram)
+    {
+        RelocateInstruction(ins, newIds);
+    }
+
+    for(auto& id: vm->ByteCodeLineAssociation)
+    {
+        if(id <= programEnd)
+        {
+            id = newIds[id];
+        }
+    }
+
+    vm->ByteCodeProgram.swap(fusedProgram);
+}
+
+// generated by TestBuilder
+void FuseInstructions(PebbleVM* vm)
+{
+    TEST_Tracer("FuseInstructions");
+    methodHitMap["FuseInstructions"]++;
+    if(FunctionInjections.count("FuseInstructions") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["FuseInstructions"](p);
+    }
+    FuseInstructions_INTERNAL(vm);
+}
+
+
+void ReportFusionStatistics(const PebbleVM* vm);
+
+void ReportFusionStatistics_INTERNAL(const PebbleVM* vm)
+{
+    double executed = vm->FusionStats.ExecutedInstructions;
+    double fusedPercent = executed > 0 ? 100.0 * vm->FusionStats.ExecutedSuperinstructions / executed : 0;
+
+    std::cerr << "fused sequences:            " << vm->FusionStats.FusedSequences << "\n"
+              << "instructions removed:       " << vm->FusionStats.RemovedInstructions << "\n"
+              << "instructions executed:      " << vm->FusionStats.ExecutedInstructions << "\n"
+              << "superinstructions executed: " << vm->FusionStats.ExecutedSuperinstructions 
+                << " (" << fusedPercent << "%)\n"
+              << "dispatches saved:           " << vm->FusionStats.ReplacedDispatches << "\n";
+}
+
+// generated by TestBuilder
+void ReportFusionStatistics(const PebbleVM* vm)
+{
+    TEST_Tracer("ReportFusionStatistics");
+    methodHitMap["ReportFusionStatistics"]++;
+    if(FunctionInjections.count("ReportFusionStatistics") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ReportFusionStatistics"](p);
+    }
+    ReportFusionStatistics_INTERNAL(vm);
+}
@@ -0,0 +1,459 @@
+#include "test.h"
+#include <iostream>
+#include <chrono>
+#include <unordered_set>
+
+#include "gc.h"
+
+#include "vm.h"
+#include "call.h"
+#include "scope.h"
+#include "value.h"
+#include "diagnostics.h"
+
+
+size_t GCMinimumThreshold = 4096;
+
+bool g_gcStatsOn = false;
+
+static thread_local std::unordered_set<const void*> ManagedCalls;
+static thread_local std::unordered_set<const void*> ManagedScopes;
+
+static thread_local std::unordered_set<const void*> Marked;
+
+static thread_local std::unordered_set<const String*> LiveStrings;
+
+static thread_local std::vector<Call*> CallWorklist;
+static thread_local std::vector<Scope*> ScopeWorklist;
+
+
+
+
+inline bool IsMarked(const void* entity);
+
+inline bool IsMarked_INTERNAL(const void* entity)
+{
+    return Marked.count(entity) != 0;
+}
+
+// generated by TestBuilder
+inline bool IsMarked(const void* entity)
+{
+    TEST_Tracer("IsMarked");
+    methodHitMap["IsMarked"]++;
+    if(FunctionInjections.count("IsMarked") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&entity));
+    FunctionInjections["IsMarked"](p);
+    }
+    return IsMarked_INTERNAL(entity);
+}
+
+
+inline void MarkCall(Call* call);
+
+inline void MarkCall_INTERNAL(Call* call)
+{
+    if(call != nullptr && Marked.insert(call).second)
+    {
+        CallWorklist.push_back(call);
+    }
+}
+
+// generated by TestBuilder
+inline void MarkCall(Call* call)
+{
+    TEST_Tracer("MarkCall");
+    methodHitMap["MarkCall"]++;
+    if(FunctionInjections.count("MarkCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["MarkCall"](p);
+    }
+    MarkCall_INTERNAL(call);
+}
+
+
+inline void MarkScope(Scope* scope);
+
+inline void MarkScope_INTERNAL(Scope* scope)
+{
+    if(scope != nullptr && Marked.insert(scope).second)
+    {
+        ScopeWorklist.push_back(scope);
+    }
+}
+
+// generated by TestBuilder
+inline void MarkScope(Scope* scope)
+{
+    TEST_Tracer("MarkScope");
+    methodHitMap["MarkScope"]++;
+    if(FunctionInjections.count("MarkScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["MarkScope"](p);
+    }
+    MarkScope_INTERNAL(scope);
+}
+
+
+inline void MarkMemoryStack(PebbleVM* vm);
+
+inline void MarkMemoryStack_INTERNAL(PebbleVM* vm)
+{
+    for(auto word: vm->MemoryStack)
+    {
+        if(ManagedCalls.count(word) != 0)
+        {
+            MarkCall(static_cast<Call*>(word));
+        }
+        else if(ManagedScopes.count(word) != 0)
+        {
+            MarkScope(static_cast<Scope*>(word));
+        }
+    }
+}
+
+// generated by TestBuilder
+inline void MarkMemoryStack(PebbleVM* vm)
+{
+    TEST_Tracer("MarkMemoryStack");
+    methodHitMap["MarkMemoryStack"]++;
+    if(FunctionInjections.count("MarkMemoryStack") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["MarkMemoryStack"](p);
+    }
+    MarkMemoryStack_INTERNAL(vm);
+}
+
+
+inline void MarkRoots(PebbleVM* vm);
+
+inline void MarkRoots_INTERNAL(PebbleVM* vm)
+{
+    MarkScope(vm->ProgramReg);
+    MarkScope(vm->LocalScopeReg);
+    MarkScope(&NothingScope);
+    MarkScope(&SomethingScope);
+
+    MarkCall(vm->SelfReg);
+    MarkCall(vm->CallerReg);
+    MarkCall(vm->LastResultReg);
+
+    for(size_t i=0; i<SIMPLE_CALLS && i<vm->RuntimeCalls.size(); i++)
+    {
+        MarkCall(vm->RuntimeCalls[i]);
+    }
+
+    for(auto call: vm->ConstPrimitives)
+    {
+        MarkCall(call);
+    }
+
+    for(auto& frame: vm->CallStack)
+    {
+        MarkCall(frame.LastResult);
+    }
+
+    for(auto& labeledScope: vm->LocalScopes)
+    {
+        MarkScope(labeledScope.Value);
+    }
+
+    MarkMemoryStack(vm);
+}
+
+// generated by TestBuilder
+inline void MarkRoots(PebbleVM* vm)
+{
+    TEST_Tracer("MarkRoots");
+    methodHitMap["MarkRoots"]++;
+    if(FunctionInjections.count("MarkRoots") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["MarkRoots"](p);
+    }
+    MarkRoots_INTERNAL(vm);
+}
+
+
+inline void TraceWorklists();
+
+inline void TraceWorklists_INTERNAL()
+{
+    while(!CallWorklist.empty() || !ScopeWorklist.empty())
+    {
+        while(!CallWorklist.empty())
+        {
+            auto call = CallWorklist.back();
+            CallWorklist.pop_back();
+
+            if(call->BoundType == &StringType && call->BoundValue.s != nullptr)
+            {
+                LiveStrings.insert(call->BoundValue.s);
+            }
+            MarkScope(call->BoundScope);
+        }
+
+        while(!ScopeWorklist.empty())
+        {
+            auto scope = ScopeWorklist.back();
+            ScopeWorklist.pop_back();
+
+            for(auto call: scope->CallsIndex)
+            {
+                MarkCall(call);
+            }
+            for(auto call: scope->Elements)
+            {
+                MarkCall(call);
+            }
+            MarkScope(scope->InheritedScope);
+        }
+    }
+}
+
+// generated by TestBuilder
+inline void TraceWorklists()
+{
+    TEST_Tracer("TraceWorklists");
+    methodHitMap["TraceWorklists"]++;
+    if(FunctionInjections.count("TraceWorklists") == 1){
+    Params p;
+    FunctionInjections["TraceWorklists"](p);
+    }
+    TraceWorklists_INTERNAL();
+}
+
+
+
+
+template <typename T>
+inline void SweepPrimitiveTable(T& table)
+{
+    for(auto entry = table.begin(); entry != table.end();)
+    {
+        if(IsMarked(entry->second))
+        {
+            entry++;
+        }
+        else
+        {
+            entry = table.erase(entry);
+        }
+    }
+}
+
+
+inline void SweepPrimitiveTables(PebbleVM* vm);
+
+inline void SweepPrimitiveTables_INTERNAL(PebbleVM* vm)
+{
+    SweepPrimitiveTable(vm->IntegerPrimitives);
+    SweepPrimitiveTable(vm->DecimalPrimitives);
+    SweepPrimitiveTable(vm->StringPrimitives);
+
+    for(auto& call: vm->BooleanPrimitives)
+    {
+        if(call != nullptr && !IsMarked(call))
+        {
+            call = nullptr;
+        }
+    }
+}
+
+// generated by TestBuilder
+inline void SweepPrimitiveTables(PebbleVM* vm)
+{
+    TEST_Tracer("SweepPrimitiveTables");
+    methodHitMap["SweepPrimitiveTables"]++;
+    if(FunctionInjections.count("SweepPrimitiveTables") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["SweepPrimitiveTables"](p);
+    }
+    SweepPrimitiveTables_INTERNAL(vm);
+}
+
+
+inline void SweepCalls(PebbleVM* vm);
+
+inline void SweepCalls_INTERNAL(PebbleVM* vm)
+{
+    std::unordered_set<String*> freedStrings;
+
+    size_t kept = SIMPLE_CALLS;
+    for(size_t i=SIMPLE_CALLS; i<vm->RuntimeCalls.size(); i++)
+    {
+        auto call = vm->RuntimeCalls[i];
+        if(IsMarked(call))
+        {
+            vm->RuntimeCalls[kept++] = call;
+            continue;
+        }
+
+        auto value = call->BoundValue.s;
+        bool ownsValue = call->BoundType == &StringType && call->BoundScope != &NothingScope;
+        if(ownsValue && value != nullptr && LiveStrings.count(value) == 0 && freedStrings.insert(value).second)
+        {
+            vm->GCStats.BytesReclaimed += sizeof(String) + value->capacity();
+            vm->GCStats.StringsFreed++;
+            StringDestructor(value);
+        }
+
+        vm->GCStats.BytesReclaimed += sizeof(Call);
+        vm->GCStats.CallsFreed++;
+        CallDestructor(vm->CallSlab, call);
+    }
+
+    vm->RuntimeCalls.resize(kept);
+}
+
+// generated by TestBuilder
+inline void SweepCalls(PebbleVM* vm)
+{
+    TEST_Tracer("SweepCalls");
+    methodHitMap["SweepCalls"]++;
+    if(FunctionInjections.count("SweepCalls") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["SweepCalls"](p);
+    }
+    SweepCalls_INTERNAL(vm);
+}
+
+
+inline void SweepScopes(PebbleVM* vm);
+
+inline void SweepScopes_INTERNAL(PebbleVM* vm)
+{
+    size_t kept = 0;
+    for(size_t i=0; i<vm->RuntimeScopes.size(); i++)
+    {
+        auto scope = vm->RuntimeScopes[i];
+        if(IsMarked(scope))
+        {
+            vm->RuntimeScopes[kept++] = scope;
+            continue;
+        }
+
+        vm->GCStats.BytesReclaimed += sizeof(Scope) + scope->CallsIndex.AllocatedBytes() 
+            + scope->Elements.capacity() * sizeof(Call*);
+        vm->GCStats.ScopesFreed++;
+        ScopeDestructor(vm->ScopeSlab, scope);
+    }
+
+    vm->RuntimeScopes.resize(kept);
+}
+
+// generated by TestBuilder
+inline void SweepScopes(PebbleVM* vm)
+{
+    TEST_Tracer("SweepScopes");
+    methodHitMap["SweepScopes"]++;
+    if(FunctionInjections.count("SweepScopes") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["SweepScopes"](p);
+    }
+    SweepScopes_INTERNAL(vm);
+}
+
+
+
+
+void InitGarbageCollector(PebbleVM* vm);
+
+void InitGarbageCollector_INTERNAL(PebbleVM* vm)
+{
+    vm->GCStats = {};
+    vm->GCThreshold = GCMinimumThreshold;
+}
+
+// generated by TestBuilder
+void InitGarbageCollector(PebbleVM* vm)
+{
+    TEST_Tracer("InitGarbageCollector");
+    methodHitMap["InitGarbageCollector"]++;
+    if(FunctionInjections.count("InitGarbageCollector") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["InitGarbageCollector"](p);
+    }
+    InitGarbageCollector_INTERNAL(vm);
+}
+
+
+void CollectGarbage(PebbleVM* vm);
+
+void CollectGarbage_INTERNAL(PebbleVM* vm)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    ManagedCalls.clear();
+    ManagedCalls.insert(vm->RuntimeCalls.begin(), vm->RuntimeCalls.end());
+    ManagedScopes.clear();
+    ManagedScopes.insert(vm->RuntimeScopes.begin(), vm->RuntimeScopes.end());
+    Marked.clear();
+    Marked.reserve(vm->RuntimeCalls.size() + vm->RuntimeScopes.size());
+    LiveStrings.clear();
+
+    MarkRoots(vm);
+    TraceWorklists();
+
+    SweepPrimitiveTables(vm);
+    SweepCalls(vm);
+    SweepScopes(vm);
+
+    size_t live = vm->RuntimeCalls.size() + vm->RuntimeScopes.size();
+    vm->GCThreshold = std::max(GCMinimumThreshold, 2 * live);
+
+    std::chrono::duration<double, std::milli> pause = std::chrono::steady_clock::now() - start;
+    vm->GCStats.Collections++;
+    vm->GCStats.TotalPauseMs += pause.count();
+    vm->GCStats.MaxPauseMs = std::max(vm->GCStats.MaxPauseMs, pause.count());
+    vm->GCStats.MaxLive = std::max(vm->GCStats.MaxLive, live);
+}
+
+// generated by TestBuilder
+void CollectGarbage(PebbleVM* vm)
+{
+    TEST_Tracer("CollectGarbage");
+    methodHitMap["CollectGarbage"]++;
+    if(FunctionInjections.count("CollectGarbage") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["CollectGarbage"](p);
+    }
+    CollectGarbage_INTERNAL(vm);
+}
+
+
+void ReportGarbageCollectorStatistics(const PebbleVM* vm);
+
+void ReportGarbageCollectorStatistics_INTERNAL(const PebbleVM* vm)
+{
+    std::cerr << "gc collections:      " << vm->GCStats.Collections << "\n"
+              << "gc total pause (ms): " << vm->GCStats.TotalPauseMs << "\n"
+              << "gc max pause (ms):   " << vm->GCStats.MaxPauseMs << "\n"
+              << "gc calls freed:      " << vm->GCStats.CallsFreed << "\n"
+              << "gc scopes freed:     " << vm->GCStats.ScopesFreed << "\n"
+              << "gc strings freed:    " << vm->GCStats.StringsFreed << "\n"
+              << "gc bytes reclaimed:  " << vm->GCStats.BytesReclaimed << "\n"
+              << "gc max live:         " << vm->GCStats.MaxLive << "\n";
+}
+
+// generated by TestBuilder
+void ReportGarbageCollectorStatistics(const PebbleVM* vm)
+{
+    TEST_Tracer("ReportGarbageCollectorStatistics");
+    methodHitMap["ReportGarbageCollectorStatistics"]++;
+    if(FunctionInjections.count("ReportGarbageCollectorStatistics") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ReportGarbageCollectorStatistics"](p);
+    }
+    ReportGarbageCollectorStatistics_INTERNAL(vm);
+}
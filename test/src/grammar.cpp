@@ -0,0 +1,1044 @@
+#include "test.h"
+#include <fstream>
+
+#include "grammar.h"
+
+#include "token.h"
+#include "diagnostics.h"
+#include "grammartables.h"
+
+
+String g_grammarFile = "";
+
+std::vector<CFGRule> Grammar;
+std::list<PrecedenceClass> PrecedenceRules;
+std::vector<String> ProductionVariables;
+std::vector<PreprocessorRule> PreprocessorRules;
+
+std::deque<String> GrammarSymbolNames;
+std::unordered_map<std::string_view, GrammarSymbol> GrammarSymbols;
+GrammarSymbol RefGrammarSymbol = NoGrammarSymbol;
+std::vector<ReductionState> ReductionTransitions;
+std::vector<int> ReductionRules;
+std::vector<int> SymbolPrecedences;
+std::vector<bool> ProductionSymbols;
+int DefaultSymbolPrecedence = 0;
+
+
+bool PrecedenceClass::Contains(String symb)
+{
+    for(auto str: Members)
+        if(str == symb)
+            return true;
+
+    return false;
+}
+
+
+
+
+
+OperationType StringNameToOperationType(String Name);
+
+OperationType StringNameToOperationType_INTERNAL(String Name)
+{
+    if(Name=="Add")
+        return OperationType::Add;
+    else if(Name=="Subtract")
+        return OperationType::Subtract;
+    else if(Name=="Multiply")
+        return OperationType::Multiply;
+    else if(Name=="Divide")
+        return OperationType::Divide;
+
+    else if(Name=="And")
+        return OperationType::And;
+    else if(Name=="Or")
+        return OperationType::Or;
+    else if(Name=="Not")
+        return OperationType::Not;
+        
+    else if(Name=="Is")
+        return OperationType::Is;
+    else if(Name=="IsEqual")
+        return OperationType::IsEqual;
+    else if(Name=="IsNotEqual")
+        return OperationType::IsNotEqual;
+    else if(Name=="IsGreaterThan")
+        return OperationType::IsGreaterThan;
+    else if(Name=="IsLessThan")
+        return OperationType::IsLessThan;
+    else if(Name=="IsGreaterThanOrEqualTo")
+        return OperationType::IsGreaterThanOrEqualTo;
+    else if(Name=="IsLessThanOrEqualTo")
+        return OperationType::IsLessThanOrEqualTo;
+
+    else if(Name=="Evaluate")
+        return OperationType::Evaluate;
+    else if(Name=="EvaluateHere")
+        return OperationType::EvaluateHere;
+
+    else if(Name=="If")
+        return OperationType::If;
+    else if(Name=="ElseIf")
+        return OperationType::ElseIf;
+    else if(Name=="Else")
+        return OperationType::Else;
+    else if(Name=="While")
+        return OperationType::While;
+    else if(Name=="DefineMethod")
+        return OperationType::DefineMethod;
+    else if(Name=="Assign")
+        return OperationType::Assign;
+    else if(Name=="Tuple")
+        return OperationType::Tuple;
+    else if(Name=="Print")
+        return OperationType::Print;
+    else if(Name=="Ask")
+        return OperationType::Ask;
+    else if(Name=="Return")
+        return OperationType::Return;
+
+    else if(Name=="New")
+        return OperationType::New;
+    else if(Name=="ScopeResolution")
+        return OperationType::ScopeResolution;
+    else if(Name=="Ref")
+        return OperationType::Ref;
+
+
+    else if(Name=="DoTypeBinding")
+        return OperationType::DoTypeBinding;
+    else if(Name=="Array")
+        return OperationType::Array;
+
+    else if(Name=="NoOperationType")
+        return OperationType::NoOperationType;
+    
+    LogIt(LogSeverityType::Sev2_Important, "StringNameToOperationType", Msg("possibly unimplemented enum type %s", Name));
+    return OperationType::NoOperationType;
+}
+
+// generated by TestBuilder
+OperationType StringNameToOperationType(String Name)
+{
+    TEST_Tracer("StringNameToOperationType");
+    methodHitMap["StringNameToOperationType"]++;
+    if(FunctionInjections.count("StringNameToOperationType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&Name));
+    FunctionInjections["StringNameToOperationType"](p);
+    }
+    return StringNameToOperationType_INTERNAL(Name);
+}
+
+
+
+void AddProductionVariable(String newProductionVar);
+
+void AddProductionVariable_INTERNAL(String newProductionVar)
+{
+    for(auto productionVar: ProductionVariables)
+    {
+        if(productionVar == newProductionVar)
+            return;
+    }
+    ProductionVariables.push_back(newProductionVar);
+}
+
+// generated by TestBuilder
+void AddProductionVariable(String newProductionVar)
+{
+    TEST_Tracer("AddProductionVariable");
+    methodHitMap["AddProductionVariable"]++;
+    if(FunctionInjections.count("AddProductionVariable") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&newProductionVar));
+    FunctionInjections["AddProductionVariable"](p);
+    }
+    AddProductionVariable_INTERNAL(newProductionVar);
+}
+
+
+int PrecedenceOf(String opSymbol);
+
+int PrecedenceOf_INTERNAL(String opSymbol)
+{
+    int i=1;
+    for(auto rule: PrecedenceRules)
+    {
+        for(auto str: rule.Members)
+        {
+            if(str == opSymbol)
+            {
+                return i;
+            }
+        }
+        i++;
+    }
+    LogIt(Sev2_Important, "PrecedenceOf", Msg("unknown operation symbol %s", opSymbol));
+    return PrecedenceOf(".");
+}
+
+// generated by TestBuilder
+int PrecedenceOf(String opSymbol)
+{
+    TEST_Tracer("PrecedenceOf");
+    methodHitMap["PrecedenceOf"]++;
+    if(FunctionInjections.count("PrecedenceOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&opSymbol));
+    FunctionInjections["PrecedenceOf"](p);
+    }
+    return PrecedenceOf_INTERNAL(opSymbol);
+}
+
+
+int PrecedenceOf(Token* lookaheadToken);
+
+int PrecedenceOf_INTERNAL(Token* lookaheadToken)
+{
+    if(lookaheadToken == nullptr)
+        return 0;
+
+    return PrecedenceOf(String(lookaheadToken->Content));
+}
+
+// generated by TestBuilder
+int PrecedenceOf(Token* lookaheadToken)
+{
+    TEST_Tracer("PrecedenceOf");
+    methodHitMap["PrecedenceOf"]++;
+    if(FunctionInjections.count("PrecedenceOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&lookaheadToken));
+    FunctionInjections["PrecedenceOf"](p);
+    }
+    return PrecedenceOf_INTERNAL(lookaheadToken);
+}
+
+
+void AssignRulePrecedences();
+
+void AssignRulePrecedences_INTERNAL()
+{
+    for(auto& rule: Grammar)
+    {
+        rule.Precedence = PrecedenceOf(rule.Symbol);
+    }
+}
+
+// generated by TestBuilder
+void AssignRulePrecedences()
+{
+    TEST_Tracer("AssignRulePrecedences");
+    methodHitMap["AssignRulePrecedences"]++;
+    if(FunctionInjections.count("AssignRulePrecedences") == 1){
+    Params p;
+    FunctionInjections["AssignRulePrecedences"](p);
+    }
+    AssignRulePrecedences_INTERNAL();
+}
+
+
+void AddPrecedenceClass(TokenList& tokens);
+
+void AddPrecedenceClass_INTERNAL(TokenList& tokens)
+{
+    PrecedenceClass precdence;
+    for(Token* t: tokens)
+    {
+        precdence.Members.emplace_back(t->Content);
+    }
+    PrecedenceRules.push_front(precdence);
+}
+
+// generated by TestBuilder
+void AddPrecedenceClass(TokenList& tokens)
+{
+    TEST_Tracer("AddPrecedenceClass");
+    methodHitMap["AddPrecedenceClass"]++;
+    if(FunctionInjections.count("AddPrecedenceClass") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["AddPrecedenceClass"](p);
+    }
+    AddPrecedenceClass_INTERNAL(tokens);
+}
+
+
+void AddGrammarRuleInternal(
+    TokenList&tokens, 
+    String& name, 
+    String& symbol, 
+    String& parseMethod, 
+    PrecedenceClass& higherpclass, 
+    PrecedenceClass& lowerpclass);
+
+void AddGrammarRuleInternal_INTERNAL(
+    TokenList&tokens, 
+    String& name, 
+    String& symbol, 
+    String& parseMethod, 
+    PrecedenceClass& higherpclass, 
+    PrecedenceClass& lowerpclass)
+{
+    CFGRule rule;
+
+    rule.HasHigherPrecedenceClassOverride = false;
+    rule.HasLowerPrecedenceClassOverride = false;
+
+    rule.Name = name;
+    rule.Symbol = symbol; 
+    rule.ParseMethod = parseMethod; 
+
+    rule.OpType = StringNameToOperationType(rule.Name);
+    rule.FromProduction = tokens.at(0)->Content;
+    AddProductionVariable(rule.FromProduction);
+
+    if(!higherpclass.Members.empty())
+    {
+        rule.HasHigherPrecedenceClassOverride = true;
+        rule.HigherPrecedenceClass = higherpclass;
+    }
+
+    if(!lowerpclass.Members.empty())
+    {
+        rule.HasLowerPrecedenceClassOverride = true;
+        rule.LowerPrecedenceClass = lowerpclass;
+    }
+
+    for(size_t i=3; i<tokens.size(); i++)
+    {
+        rule.IntoPattern.emplace_back(tokens.at(i)->Content);
+    }
+
+    Grammar.push_back(rule);
+}
+
+// generated by TestBuilder
+void AddGrammarRuleInternal(
+    TokenList&tokens, 
+    String& name, 
+    String& symbol, 
+    String& parseMethod, 
+    PrecedenceClass& higherpclass, 
+    PrecedenceClass& lowerpclass)
+{
+    TEST_Tracer("AddGrammarRuleInternal");
+    methodHitMap["AddGrammarRuleInternal"]++;
+    if(FunctionInjections.count("AddGrammarRuleInternal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&symbol));
+    p.push_back(static_cast<const void*>(&parseMethod));
+    p.push_back(static_cast<const void*>(&higherpclass));
+    p.push_back(static_cast<const void*>(&lowerpclass));
+    FunctionInjections["AddGrammarRuleInternal"](p);
+    }
+    AddGrammarRuleInternal_INTERNAL(tokens, name, symbol, parseMethod, higherpclass, lowerpclass);
+}
+
+
+PrecedenceClass GetOverridePrecedenceClass(TokenList& tokens);
+
+PrecedenceClass GetOverridePrecedenceClass_INTERNAL(TokenList& tokens)
+{
+    PrecedenceClass pclass;
+    pclass.Members.reserve(tokens.size()-1);
+    for(size_t i=1; i<tokens.size(); i++)
+    {
+        pclass.Members.emplace_back(tokens.at(i)->Content);
+    }
+
+    return pclass;
+}
+
+// generated by TestBuilder
+PrecedenceClass GetOverridePrecedenceClass(TokenList& tokens)
+{
+    TEST_Tracer("GetOverridePrecedenceClass");
+    methodHitMap["GetOverridePrecedenceClass"]++;
+    if(FunctionInjections.count("GetOverridePrecedenceClass") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["GetOverridePrecedenceClass"](p);
+    }
+    return GetOverridePrecedenceClass_INTERNAL(tokens);
+}
+
+
+void AddGrammarRule(TokenList& tokens);
+
+void AddGrammarRule_INTERNAL(TokenList& tokens)
+{
+    static String name;
+    static String symbol;
+    static String parseMethod;
+    static PrecedenceClass higherpclass;
+    static PrecedenceClass lowerpclass;
+
+    if(tokens.at(0)->Content == g_ContextStartSymbol)
+    {
+        name = tokens.at(1)->Content;
+        symbol = tokens.at(2)->Content;
+        parseMethod = tokens.at(3)->Content;
+        higherpclass.Members.clear();
+        lowerpclass.Members.clear();
+        
+    }
+    else if(tokens.at(0)->Content == ">")
+    {
+        if(name.empty())
+        {
+            LogIt(LogSeverityType::Sev3_Critical, "AddGrammarRule", "expected context declaration before precedence override");
+            return;
+        }
+
+        higherpclass = GetOverridePrecedenceClass(tokens);
+    }
+    else if(tokens.at(0)->Content == "<")
+    {
+        if(name.empty())
+        {
+            LogIt(LogSeverityType::Sev3_Critical, "AddGrammarRule", "expected context declaration before precedence override");
+            return;
+        }
+
+        lowerpclass = GetOverridePrecedenceClass(tokens);
+    }
+    else if(tokens.at(0)->Type == TokenType::Reference)
+    {
+        if(name.empty())
+        {
+            LogIt(LogSeverityType::Sev3_Critical, "AddGrammarRule", "expected context declaration before pattern");
+            return;
+        }
+
+        AddGrammarRuleInternal(tokens, name, symbol, parseMethod, higherpclass, lowerpclass);
+    }
+}
+
+// generated by TestBuilder
+void AddGrammarRule(TokenList& tokens)
+{
+    TEST_Tracer("AddGrammarRule");
+    methodHitMap["AddGrammarRule"]++;
+    if(FunctionInjections.count("AddGrammarRule") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["AddGrammarRule"](p);
+    }
+    AddGrammarRule_INTERNAL(tokens);
+}
+
+
+void AddPreprocessorRule(TokenList& tokens);
+
+void AddPreprocessorRule_INTERNAL(TokenList& tokens)
+{
+    static String becomes;
+
+    if(tokens[0]->Content == g_ContextStartSymbol)
+    {
+        if(tokens.size() != 2)
+        {
+            LogIt(LogSeverityType::Sev3_Critical, "AddPreprocessorRule", "context declaration (@) line has wrong # of args");
+            return;
+        }
+
+        becomes = tokens[1]->Content;
+    }
+    else
+    {
+        if(becomes.empty())
+        {
+            LogIt(LogSeverityType::Sev3_Critical, "AddPreprocessorRule", "pattern reached before context declaration (@)");
+            return;
+        }
+
+        std::vector<String> pattern;
+        for(auto token: tokens)
+        {
+            pattern.emplace_back(token->Content);
+        }
+        PreprocessorRule rule = { becomes, pattern };
+        PreprocessorRules.push_back(rule);
+    }
+}
+
+// generated by TestBuilder
+void AddPreprocessorRule(TokenList& tokens)
+{
+    TEST_Tracer("AddPreprocessorRule");
+    methodHitMap["AddPreprocessorRule"]++;
+    if(FunctionInjections.count("AddPreprocessorRule") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["AddPreprocessorRule"](p);
+    }
+    AddPreprocessorRule_INTERNAL(tokens);
+}
+
+
+
+GrammarSymbol InternGrammarSymbol(const String& str);
+
+GrammarSymbol InternGrammarSymbol_INTERNAL(const String& str)
+{
+    auto it = GrammarSymbols.find(str);
+    if(it != GrammarSymbols.end())
+    {
+        return it->second;
+    }
+
+    GrammarSymbol symbol = GrammarSymbolNames.size();
+    GrammarSymbolNames.push_back(str);
+    GrammarSymbols[GrammarSymbolNames.back()] = symbol;
+    return symbol;
+}
+
+// generated by TestBuilder
+GrammarSymbol InternGrammarSymbol(const String& str)
+{
+    TEST_Tracer("InternGrammarSymbol");
+    methodHitMap["InternGrammarSymbol"]++;
+    if(FunctionInjections.count("InternGrammarSymbol") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&str));
+    FunctionInjections["InternGrammarSymbol"](p);
+    }
+    return InternGrammarSymbol_INTERNAL(str);
+}
+
+
+std::vector<GrammarSymbol> InternGrammarSymbols(const std::vector<String>& strs)
+{
+    std::vector<GrammarSymbol> symbols;
+    symbols.reserve(strs.size());
+    for(auto& str: strs)
+    {
+        symbols.push_back(InternGrammarSymbol(str));
+    }
+
+    return symbols;
+}
+
+
+void InternGrammar();
+
+void InternGrammar_INTERNAL()
+{
+    GrammarSymbols.clear();
+    GrammarSymbolNames.clear();
+
+    for(auto& productionVar: ProductionVariables)
+    {
+        InternGrammarSymbol(productionVar);
+    }
+    RefGrammarSymbol = InternGrammarSymbol("Ref");
+
+    for(auto& rule: Grammar)
+    {
+        rule.FromProductionSymbol = InternGrammarSymbol(rule.FromProduction);
+        rule.HigherPrecedenceSymbols = InternGrammarSymbols(rule.HigherPrecedenceClass.Members);
+        rule.LowerPrecedenceSymbols = InternGrammarSymbols(rule.LowerPrecedenceClass.Members);
+        InternGrammarSymbols(rule.IntoPattern);
+    }
+
+    for(auto& pclass: PrecedenceRules)
+    {
+        InternGrammarSymbols(pclass.Members);
+    }
+
+    DefaultSymbolPrecedence = PrecedenceOf(".");
+    SymbolPrecedences.assign(GrammarSymbolNames.size(), DefaultSymbolPrecedence);
+
+    std::vector<bool> hasPrecedence(GrammarSymbolNames.size(), false);
+    int precedence = 1;
+    for(auto& pclass: PrecedenceRules)
+    {
+        for(auto& member: pclass.Members)
+        {
+            auto symbol = GrammarSymbolOf(member);
+            if(!hasPrecedence[symbol])
+            {
+                SymbolPrecedences[symbol] = precedence;
+                hasPrecedence[symbol] = true;
+            }
+        }
+        precedence++;
+    }
+
+    ProductionSymbols.assign(GrammarSymbolNames.size(), false);
+    for(auto& productionVar: ProductionVariables)
+    {
+        ProductionSymbols[GrammarSymbolOf(productionVar)] = true;
+    }
+}
+
+// generated by TestBuilder
+void InternGrammar()
+{
+    TEST_Tracer("InternGrammar");
+    methodHitMap["InternGrammar"]++;
+    if(FunctionInjections.count("InternGrammar") == 1){
+    Params p;
+    FunctionInjections["InternGrammar"](p);
+    }
+    InternGrammar_INTERNAL();
+}
+
+
+ReductionState AddReductionState();
+
+ReductionState AddReductionState_INTERNAL()
+{
+    ReductionState state = ReductionRules.size();
+    ReductionTransitions.insert(ReductionTransitions.end(), GrammarSymbolNames.size(), NoReductionState);
+    ReductionRules.push_back(-1);
+    return state;
+}
+
+// generated by TestBuilder
+ReductionState AddReductionState()
+{
+    TEST_Tracer("AddReductionState");
+    methodHitMap["AddReductionState"]++;
+    if(FunctionInjections.count("AddReductionState") == 1){
+    Params p;
+    FunctionInjections["AddReductionState"](p);
+    }
+    return AddReductionState_INTERNAL();
+}
+
+
+void BuildReductionTrie();
+
+void BuildReductionTrie_INTERNAL()
+{
+    size_t numberOfSymbols = GrammarSymbolNames.size();
+    ReductionTransitions.clear();
+    ReductionRules.clear();
+
+    std::vector<ReductionState> parents = { NoReductionState };
+    AddReductionState();
+
+    for(size_t r=0; r<Grammar.size(); r++)
+    {
+        ReductionState state = ReductionTrieRoot;
+        auto& pattern = Grammar[r].IntoPattern;
+        for(auto it = pattern.rbegin(); it != pattern.rend(); it++)
+        {
+            size_t transition = state * numberOfSymbols + GrammarSymbolOf(*it);
+            if(ReductionTransitions[transition] == NoReductionState)
+            {
+                ReductionState next = AddReductionState();
+                parents.push_back(state);
+                ReductionTransitions[transition] = next;
+            }
+            state = ReductionTransitions[transition];
+        }
+
+        if(ReductionRules[state] < 0)
+        {
+            ReductionRules[state] = r;
+        }
+    }
+
+    for(size_t state=1; state<ReductionRules.size(); state++)
+    {
+        int parentRule = ReductionRules[parents[state]];
+        if(parentRule >= 0 && (ReductionRules[state] < 0 || parentRule < ReductionRules[state]))
+        {
+            ReductionRules[state] = parentRule;
+        }
+    }
+}
+
+// generated by TestBuilder
+void BuildReductionTrie()
+{
+    TEST_Tracer("BuildReductionTrie");
+    methodHitMap["BuildReductionTrie"]++;
+    if(FunctionInjections.count("BuildReductionTrie") == 1){
+    Params p;
+    FunctionInjections["BuildReductionTrie"](p);
+    }
+    BuildReductionTrie_INTERNAL();
+}
+
+
+void BuildParseTables();
+
+void BuildParseTables_INTERNAL()
+{
+    InternGrammar();
+    BuildReductionTrie();
+}
+
+// generated by TestBuilder
+void BuildParseTables()
+{
+    TEST_Tracer("BuildParseTables");
+    methodHitMap["BuildParseTables"]++;
+    if(FunctionInjections.count("BuildParseTables") == 1){
+    Params p;
+    FunctionInjections["BuildParseTables"](p);
+    }
+    BuildParseTables_INTERNAL();
+}
+
+
+void ResetGrammar();
+
+void ResetGrammar_INTERNAL()
+{
+    Grammar.clear();
+    Grammar.reserve(128);
+
+    PrecedenceRules.clear();
+    
+    ProductionVariables.clear();
+    ProductionVariables.reserve(32);
+    ProductionVariables.push_back("Ref");
+
+    PreprocessorRules.clear();
+    PreprocessorRules.reserve(16);
+}
+
+// generated by TestBuilder
+void ResetGrammar()
+{
+    TEST_Tracer("ResetGrammar");
+    methodHitMap["ResetGrammar"]++;
+    if(FunctionInjections.count("ResetGrammar") == 1){
+    Params p;
+    FunctionInjections["ResetGrammar"](p);
+    }
+    ResetGrammar_INTERNAL();
+}
+
+
+void CompileGrammarFromFile(const String& fileName);
+
+void CompileGrammarFromFile_INTERNAL(const String& fileName)
+{
+    ResetGrammar();
+
+    std::fstream file;
+    file.open(fileName, std::ios::in);
+    if(!file)
+    {
+        LogIt(LogSeverityType::Sev3_Critical, "CompileGrammarFromFile", Msg("cannot open %s", fileName));
+        return;
+    }
+
+    int state = 0;
+
+    String line;
+    TokenArena arena;
+    while(std::getline(file, line))
+    {
+        ClearTokenArena(arena);
+        TokenList tokens = LexLine(line, arena);
+        if(tokens.empty())
+        {
+            continue;
+        }
+
+        if(tokens.at(0)->Content == ";")
+        {
+            state++;
+            continue;
+        }
+
+        switch(state)
+        {
+            case 1:
+            AddPreprocessorRule(tokens);
+            break;
+
+            case 2:
+            AddGrammarRule(tokens);
+            break;;
+
+            case 3:
+            AddPrecedenceClass(tokens);
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    AssignRulePrecedences();
+    BuildParseTables();
+}
+
+// generated by TestBuilder
+void CompileGrammarFromFile(const String& fileName)
+{
+    TEST_Tracer("CompileGrammarFromFile");
+    methodHitMap["CompileGrammarFromFile"]++;
+    if(FunctionInjections.count("CompileGrammarFromFile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&fileName));
+    FunctionInjections["CompileGrammarFromFile"](p);
+    }
+    CompileGrammarFromFile_INTERNAL(fileName);
+}
+
+
+
+
+std::vector<String> CompiledStringsIn(CompiledStringRange range)
+{
+    std::vector<String> strings;
+    strings.reserve(range.Size);
+    for(int i=range.Start; i<range.Start + range.Size; i++)
+    {
+        strings.push_back(CompiledGrammarStrings[i]);
+    }
+
+    return strings;
+}
+
+
+void CompileGrammarFromTables();
+
+void CompileGrammarFromTables_INTERNAL()
+{
+    ResetGrammar();
+
+    for(auto& compiled: CompiledPreprocessorRules)
+    {
+        PreprocessorRule rule = { compiled.Becomes, CompiledStringsIn(compiled.Pattern) };
+        PreprocessorRules.push_back(rule);
+    }
+
+    for(auto& compiled: CompiledGrammarRules)
+    {
+        CFGRule rule;
+        rule.Name = compiled.Name;
+        rule.Symbol = compiled.Symbol;
+        rule.Precedence = compiled.Precedence;
+        rule.OpType = compiled.OpType;
+        rule.IntoPattern = CompiledStringsIn(compiled.IntoPattern);
+        rule.FromProduction = compiled.FromProduction;
+        rule.ParseMethod = compiled.ParseMethod;
+
+        rule.HasHigherPrecedenceClassOverride = compiled.HigherPrecedenceClass.Size > 0;
+        rule.HasLowerPrecedenceClassOverride = compiled.LowerPrecedenceClass.Size > 0;
+        rule.HigherPrecedenceClass.Members = CompiledStringsIn(compiled.HigherPrecedenceClass);
+        rule.LowerPrecedenceClass.Members = CompiledStringsIn(compiled.LowerPrecedenceClass);
+
+        Grammar.push_back(rule);
+    }
+
+    for(auto& compiled: CompiledPrecedenceClasses)
+    {
+        PrecedenceClass pclass;
+        pclass.Members = CompiledStringsIn(compiled);
+        PrecedenceRules.push_back(pclass);
+    }
+
+    ProductionVariables.clear();
+    for(auto productionVar: CompiledProductionVariables)
+    {
+        ProductionVariables.push_back(productionVar);
+    }
+
+    BuildParseTables();
+}
+
+// generated by TestBuilder
+void CompileGrammarFromTables()
+{
+    TEST_Tracer("CompileGrammarFromTables");
+    methodHitMap["CompileGrammarFromTables"]++;
+    if(FunctionInjections.count("CompileGrammarFromTables") == 1){
+    Params p;
+    FunctionInjections["CompileGrammarFromTables"](p);
+    }
+    CompileGrammarFromTables_INTERNAL();
+}
+
+
+void CompileGrammar();
+
+void CompileGrammar_INTERNAL()
+{
+    if(!g_grammarFile.empty())
+    {
+        CompileGrammarFromFile(g_grammarFile);
+        return;
+    }
+
+    CompileGrammarFromTables();
+}
+
+// generated by TestBuilder
+void CompileGrammar()
+{
+    TEST_Tracer("CompileGrammar");
+    methodHitMap["CompileGrammar"]++;
+    if(FunctionInjections.count("CompileGrammar") == 1){
+    Params p;
+    FunctionInjections["CompileGrammar"](p);
+    }
+    CompileGrammar_INTERNAL();
+}
+
+
+String CppLiteralFor(const String& str);
+
+String CppLiteralFor_INTERNAL(const String& str)
+{
+    String literal = "\"";
+    for(auto c: str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            literal += '\\';
+        }
+        literal += c;
+    }
+
+    return literal + "\"";
+}
+
+// generated by TestBuilder
+String CppLiteralFor(const String& str)
+{
+    TEST_Tracer("CppLiteralFor");
+    methodHitMap["CppLiteralFor"]++;
+    if(FunctionInjections.count("CppLiteralFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&str));
+    FunctionInjections["CppLiteralFor"](p);
+    }
+    return CppLiteralFor_INTERNAL(str);
+}
+
+
+String CppRangeFor(const std::vector<String>& strings, std::vector<String>& table)
+{
+    String range = "{ " + std::to_string(table.size()) + ", " + std::to_string(strings.size()) + " }";
+    table.insert(table.end(), strings.begin(), strings.end());
+    return range;
+}
+
+
+String CppOperationTypeFor(OperationType type, const String& name);
+
+String CppOperationTypeFor_INTERNAL(OperationType type, const String& name)
+{
+    if(type == OperationType::NoOperationType)
+    {
+        return "OperationType::NoOperationType";
+    }
+    return "OperationType::" + name;
+}
+
+// generated by TestBuilder
+String CppOperationTypeFor(OperationType type, const String& name)
+{
+    TEST_Tracer("CppOperationTypeFor");
+    methodHitMap["CppOperationTypeFor"]++;
+    if(FunctionInjections.count("CppOperationTypeFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&name));
+    FunctionInjections["CppOperationTypeFor"](p);
+    }
+    return CppOperationTypeFor_INTERNAL(type, name);
+}
+
+
+bool EmitGrammarTables(const String& file);
+
+bool EmitGrammarTables_INTERNAL(const String& file)
+{
+    std::vector<String> table;
+
+    std::vector<String> preprocessorRules;
+    for(auto& rule: PreprocessorRules)
+    {
+        preprocessorRules.push_back("{ " + CppLiteralFor(rule.Becomes) + ", " + CppRangeFor(rule.Pattern, table) + " }");
+    }
+
+    std::vector<String> grammarRules;
+    for(auto& rule: Grammar)
+    {
+        grammarRules.push_back("{ " + CppLiteralFor(rule.Name) + ", " + CppLiteralFor(rule.Symbol) + ", "
+            + std::to_string(rule.Precedence) + ", " + CppOperationTypeFor(rule.OpType, rule.Name) + ", "
+            + CppRangeFor(rule.IntoPattern, table) + ", " + CppLiteralFor(rule.FromProduction) + ", "
+            + CppLiteralFor(rule.ParseMethod) + ", " 
+            + CppRangeFor(rule.HigherPrecedenceClass.Members, table) + ", "
+            + CppRangeFor(rule.LowerPrecedenceClass.Members, table) + " }");
+    }
+
+    std::vector<String> precedenceClasses;
+    for(auto& pclass: PrecedenceRules)
+    {
+        precedenceClasses.push_back(CppRangeFor(pclass.Members, table));
+    }
+
+    std::vector<String> productionVariables;
+    for(auto& productionVar: ProductionVariables)
+    {
+        productionVariables.push_back(CppLiteralFor(productionVar));
+    }
+
+    for(auto& str: table)
+    {
+        str = CppLiteralFor(str);
+    }
+
+    std::ofstream out(file);
+    if(!out)
+    {
+        return false;
+    }
+
+    auto emitTable = [&](const String& type, const String& name, const std::vector<String>& entries)
+    {
+        out << "constexpr std::array<" << type << ", " << entries.size() << "> " << name << " =\n{{\n";
+        for(auto& entry: entries)
+        {
+            out << "    " << entry << ",\n";
+        }
+        out << "}};\n\n";
+    };
+
+    out << "// generated by `make grammar` from ./assets/grammar.txt. do not edit\n\n"
+        << "#ifndef __GRAMMARTABLES_H\n"
+        << "#define __GRAMMARTABLES_H\n\n"
+        << "#include <array>\n\n"
+        << "#include \"grammar.h\"\n\n";
+
+    emitTable("const char*", "CompiledGrammarStrings", table);
+    emitTable("CompiledPreprocessorRule", "CompiledPreprocessorRules", preprocessorRules);
+    emitTable("CompiledGrammarRule", "CompiledGrammarRules", grammarRules);
+    emitTable("CompiledStringRange", "CompiledPrecedenceClasses", precedenceClasses);
+    emitTable("const char*", "CompiledProductionVariables", productionVariables);
+
+    out << "#endif\n";
+
+    return out.good();
+}
+
+// generated by TestBuilder
+bool EmitGrammarTables(const String& file)
+{
+    TEST_Tracer("EmitGrammarTables");
+    methodHitMap["EmitGrammarTables"]++;
+    if(FunctionInjections.count("EmitGrammarTables") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&file));
+    FunctionInjections["EmitGrammarTables"](p);
+    }
+    return EmitGrammarTables_INTERNAL(file);
+}
@@ -0,0 +1,650 @@
+#include "test.h"
+#include <cstring>
+#include <memory>
+
+#include "jit.h"
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "gc.h"
+
+#if __x86_64__
+#if __unix__ || __APPLE__
+#define PEBBLE_JIT_X86_64
+#include <sys/mman.h>
+#endif
+#endif
+
+
+bool g_jitOn = false;
+
+uint32_t JitThreshold = JitDefaultThreshold;
+
+
+
+
+void JitEval(PebbleVM* vm, extArg_t arg);
+
+void JitEval_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    BCI_Eval(vm, arg);
+    if(!vm->ErrorFlag && vm->JumpStatusReg)
+    {
+        CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+// generated by TestBuilder
+void JitEval(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("JitEval");
+    methodHitMap["JitEval"]++;
+    if(FunctionInjections.count("JitEval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["JitEval"](p);
+    }
+    JitEval_INTERNAL(vm, arg);
+}
+
+
+void JitEvalHere(PebbleVM* vm, extArg_t arg);
+
+void JitEvalHere_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    BCI_EvalHere(vm, arg);
+    if(!vm->ErrorFlag && vm->JumpStatusReg)
+    {
+        CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+// generated by TestBuilder
+void JitEvalHere(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("JitEvalHere");
+    methodHitMap["JitEvalHere"]++;
+    if(FunctionInjections.count("JitEvalHere") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["JitEvalHere"](p);
+    }
+    JitEvalHere_INTERNAL(vm, arg);
+}
+
+
+void JitTailEval(PebbleVM* vm, extArg_t arg);
+
+void JitTailEval_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    bool reusesCallFrame = TailEvalReusesCallFrame(vm, arg);
+    BCI_TailEval(vm, arg);
+    if(!vm->ErrorFlag)
+    {
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        if(reusesCallFrame) CountSectionEntry(vm, vm->InstructionReg);
+    }
+}
+
+// generated by TestBuilder
+void JitTailEval(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("JitTailEval");
+    methodHitMap["JitTailEval"]++;
+    if(FunctionInjections.count("JitTailEval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["JitTailEval"](p);
+    }
+    JitTailEval_INTERNAL(vm, arg);
+}
+
+
+void JitEndLine(PebbleVM* vm, extArg_t arg);
+
+void JitEndLine_INTERNAL(PebbleVM* vm, extArg_t arg)
+{
+    BCI_EndLine(vm, arg);
+    if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+}
+
+// generated by TestBuilder
+void JitEndLine(PebbleVM* vm, extArg_t arg)
+{
+    TEST_Tracer("JitEndLine");
+    methodHitMap["JitEndLine"]++;
+    if(FunctionInjections.count("JitEndLine") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&arg));
+    FunctionInjections["JitEndLine"](p);
+    }
+    JitEndLine_INTERNAL(vm, arg);
+}
+
+
+
+#ifdef PEBBLE_JIT_X86_64
+
+
+struct NativeJump
+{
+    size_t At;
+    extArg_t Target;
+};
+
+constexpr extArg_t ExitLabel = ~extArg_t(0);
+
+constexpr extArg_t MaxNativeInstructionId = 0x7fffffff;
+
+
+inline void Emit(std::vector<uint8_t>& code, std::initializer_list<uint8_t> bytes)
+{
+    code.insert(code.end(), bytes);
+}
+
+
+inline void EmitValue(std::vector<uint8_t>& code, uint64_t value, int width)
+{
+    for(int i=0; i<width; i++)
+    {
+        code.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+
+inline void EmitJumpTarget(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    jumps.push_back({ code.size(), target });
+    EmitValue(code, 0, 4);
+}
+
+
+inline void EmitJump(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    Emit(code, { 0xE9 });
+    EmitJumpTarget(code, jumps, target);
+}
+
+
+inline void EmitSetInstructionReg(std::vector<uint8_t>& code, extArg_t insId)
+{
+    Emit(code, { 0x48, 0xC7, 0x03 });
+    EmitValue(code, insId, 4);
+}
+
+
+inline void EmitCall(std::vector<uint8_t>& code, BCI_Method method, extArg_t arg)
+{
+    Emit(code, { 0x4C, 0x89, 0xF7 });
+    Emit(code, { 0xBE });
+    EmitValue(code, arg, 4);
+    Emit(code, { 0x48, 0xB8 });
+    EmitValue(code, reinterpret_cast<uint64_t>(method), 8);
+    Emit(code, { 0xFF, 0xD0 });
+}
+
+
+inline void EmitErrorCheck(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps)
+{
+    Emit(code, { 0x41, 0x80, 0x3C, 0x24, 0x00 });
+    Emit(code, { 0x0F, 0x85 });
+    EmitJumpTarget(code, jumps, ExitLabel);
+}
+
+
+inline void EmitJumpStatusCheck(std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, extArg_t target)
+{
+    Emit(code, { 0x41, 0x83, 0x7D, 0x00, 0x00 });
+    Emit(code, { 0x74, 0x0D });
+
+    Emit(code, { 0x41, 0xC7, 0x45, 0x00 });
+    EmitValue(code, 0, 4);
+    EmitJump(code, jumps, target);
+}
+
+
+inline BCI_Method NativeMethodFor(uint8_t op);
+
+inline BCI_Method NativeMethodFor_INTERNAL(uint8_t op)
+{
+    switch(op)
+    {
+        case OP_Eval:       return JitEval;
+        case OP_EvalHere:   return JitEvalHere;
+        case OP_TailEval:   return JitTailEval;
+        case OP_EndLine:    return JitEndLine;
+        default:            return BCI_Instructions[op];
+    }
+}
+
+// generated by TestBuilder
+inline BCI_Method NativeMethodFor(uint8_t op)
+{
+    TEST_Tracer("NativeMethodFor");
+    methodHitMap["NativeMethodFor"]++;
+    if(FunctionInjections.count("NativeMethodFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["NativeMethodFor"](p);
+    }
+    return NativeMethodFor_INTERNAL(op);
+}
+
+
+inline extArg_t ConditionalJumpTarget(const ByteCodeInstruction& ins);
+
+inline extArg_t ConditionalJumpTarget_INTERNAL(const ByteCodeInstruction& ins)
+{
+    return ins.Op == OP_CmpJumpFalse ? CmpJumpTargetOf(ins.Arg) : ins.Arg;
+}
+
+// generated by TestBuilder
+inline extArg_t ConditionalJumpTarget(const ByteCodeInstruction& ins)
+{
+    TEST_Tracer("ConditionalJumpTarget");
+    methodHitMap["ConditionalJumpTarget"]++;
+    if(FunctionInjections.count("ConditionalJumpTarget") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ins));
+    FunctionInjections["ConditionalJumpTarget"](p);
+    }
+    return ConditionalJumpTarget_INTERNAL(ins);
+}
+
+
+inline void EmitInstruction(PebbleVM* vm, std::vector<uint8_t>& code, std::vector<NativeJump>& jumps, NativeRegion& region, extArg_t insId)
+{
+    auto& ins = vm->ByteCodeProgram[insId];
+    auto isInRegion = [&region](extArg_t id) { return id >= region.Start && id <= region.End; };
+
+    switch(ins.Op)
+    {
+        case OP_NOP:
+            break;
+
+        case OP_Jump:
+            if(!isInRegion(ins.Arg))
+            {
+                EmitSetInstructionReg(code, ins.Arg);
+            }
+            EmitJump(code, jumps, isInRegion(ins.Arg) ? ins.Arg : ExitLabel);
+            break;
+
+        case OP_JumpFalse:
+        case OP_CmpJumpFalse:
+        {
+            auto target = ConditionalJumpTarget(ins);
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            EmitJumpStatusCheck(code, jumps, isInRegion(target) ? target : ExitLabel);
+            break;
+        }
+
+        case OP_Eval:
+        case OP_EvalHere:
+        case OP_TailEval:
+        case OP_Return:
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            EmitJumpStatusCheck(code, jumps, ExitLabel);
+            break;
+
+        default:
+            EmitSetInstructionReg(code, insId);
+            EmitCall(code, NativeMethodFor(ins.Op), ins.Arg);
+            EmitErrorCheck(code, jumps);
+            break;
+    }
+}
+
+
+inline void GenerateRegion(PebbleVM* vm, std::vector<uint8_t>& code, NativeRegion& region)
+{
+    std::vector<NativeJump> jumps;
+    std::vector<size_t> offsets(region.End - region.Start + 1);
+
+    Emit(code, { 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56 });
+    Emit(code, { 0x48, 0x83, 0xEC, 0x08 });
+
+    Emit(code, { 0x48, 0xBB });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->InstructionReg), 8);
+    Emit(code, { 0x49, 0xBC });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->ErrorFlag), 8);
+    Emit(code, { 0x49, 0xBD });
+    EmitValue(code, reinterpret_cast<uint64_t>(&vm->JumpStatusReg), 8);
+    Emit(code, { 0x49, 0xBE });
+    EmitValue(code, reinterpret_cast<uint64_t>(vm), 8);
+
+    Emit(code, { 0x48, 0xB8 });
+    EmitValue(code, reinterpret_cast<uint64_t>(region.Entries.data()), 8);
+    Emit(code, { 0xFF, 0x24, 0xF8 });
+
+    for(extArg_t id = region.Start; id <= region.End; id++)
+    {
+        offsets[id - region.Start] = code.size();
+        EmitInstruction(vm, code, jumps, region, id);
+    }
+
+    EmitSetInstructionReg(code, region.End + 1);
+
+    size_t exitOffset = code.size();
+    Emit(code, { 0x48, 0x83, 0xC4, 0x08 });
+    Emit(code, { 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+
+    for(auto& jump: jumps)
+    {
+        size_t to = jump.Target == ExitLabel ? exitOffset : offsets[jump.Target - region.Start];
+        auto rel = static_cast<int32_t>(static_cast<int64_t>(to) - static_cast<int64_t>(jump.At + 4));
+        std::memcpy(code.data() + jump.At, &rel, sizeof(rel));
+    }
+
+    for(size_t i=0; i<offsets.size(); i++)
+    {
+        region.Entries[i] = reinterpret_cast<void*>(offsets[i]);
+    }
+}
+
+
+inline bool MapRegion(const std::vector<uint8_t>& code, NativeRegion& region)
+{
+    region.Size = code.size();
+    void* memory = mmap(nullptr, region.Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(memory == MAP_FAILED)
+    {
+        return false;
+    }
+
+    std::memcpy(memory, code.data(), region.Size);
+    if(mprotect(memory, region.Size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, region.Size);
+        return false;
+    }
+
+    region.Memory = memory;
+    region.Code = reinterpret_cast<NativeCode>(memory);
+    for(auto& entry: region.Entries)
+    {
+        entry = static_cast<uint8_t*>(memory) + reinterpret_cast<size_t>(entry);
+    }
+    return true;
+}
+
+#endif
+
+
+
+
+inline extArg_t SectionEnd(PebbleVM* vm, extArg_t section);
+
+inline extArg_t SectionEnd_INTERNAL(PebbleVM* vm, extArg_t section)
+{
+    if(section >= 2
+        && vm->ByteCodeProgram[section - 2].Op == OP_BindSection
+        && vm->ByteCodeProgram[section - 2].Arg == section
+        && vm->ByteCodeProgram[section - 1].Op == OP_Jump
+        && vm->ByteCodeProgram[section - 1].Arg > section)
+    {
+        return vm->ByteCodeProgram[section - 1].Arg - 1;
+    }
+
+    extArg_t id = section;
+    while(id + 1 < vm->ByteCodeProgram.size() && vm->ByteCodeProgram[id].Op != OP_Return)
+    {
+        id++;
+    }
+    return id;
+}
+
+// generated by TestBuilder
+inline extArg_t SectionEnd(PebbleVM* vm, extArg_t section)
+{
+    TEST_Tracer("SectionEnd");
+    methodHitMap["SectionEnd"]++;
+    if(FunctionInjections.count("SectionEnd") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&section));
+    FunctionInjections["SectionEnd"](p);
+    }
+    return SectionEnd_INTERNAL(vm, section);
+}
+
+
+void CompileRegion(PebbleVM* vm, extArg_t start, extArg_t end);
+
+void CompileRegion_INTERNAL(PebbleVM* vm, extArg_t start, extArg_t end)
+{
+#ifdef PEBBLE_JIT_X86_64
+    if(end >= vm->ByteCodeProgram.size() || end >= MaxNativeInstructionId || start > end)
+    {
+        return;
+    }
+
+    auto region = std::make_unique<NativeRegion>();
+    region->Start = start;
+    region->End = end;
+    region->Entries.resize(end - start + 1);
+
+    std::vector<uint8_t> code;
+    GenerateRegion(vm, code, *region);
+    if(!MapRegion(code, *region))
+    {
+        return;
+    }
+
+    for(extArg_t id = start; id <= end; id++)
+    {
+        if(vm->Jit.RegionAt[id] == nullptr)
+        {
+            vm->Jit.RegionAt[id] = region.get();
+            vm->DecodedProgram[id].Op = NativeOp;
+            vm->DecodedProgram[id].Target = vm->Jit.NativeTarget;
+        }
+    }
+
+    vm->Jit.Regions.push_back(std::move(region));
+#endif
+}
+
+// generated by TestBuilder
+void CompileRegion(PebbleVM* vm, extArg_t start, extArg_t end)
+{
+    TEST_Tracer("CompileRegion");
+    methodHitMap["CompileRegion"]++;
+    if(FunctionInjections.count("CompileRegion") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&start));
+    p.push_back(static_cast<const void*>(&end));
+    FunctionInjections["CompileRegion"](p);
+    }
+    CompileRegion_INTERNAL(vm, start, end);
+}
+
+
+inline bool CountEntry(PebbleVM* vm, extArg_t insId);
+
+inline bool CountEntry_INTERNAL(PebbleVM* vm, extArg_t insId)
+{
+    if(insId >= vm->Jit.Counters.size() || vm->Jit.RegionAt[insId] != nullptr || vm->Jit.Counters[insId] >= JitThreshold)
+    {
+        return false;
+    }
+
+    return ++vm->Jit.Counters[insId] == JitThreshold;
+}
+
+// generated by TestBuilder
+inline bool CountEntry(PebbleVM* vm, extArg_t insId)
+{
+    TEST_Tracer("CountEntry");
+    methodHitMap["CountEntry"]++;
+    if(FunctionInjections.count("CountEntry") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&insId));
+    FunctionInjections["CountEntry"](p);
+    }
+    return CountEntry_INTERNAL(vm, insId);
+}
+
+
+
+
+bool JitIsSupported();
+
+bool JitIsSupported_INTERNAL()
+{
+#ifdef PEBBLE_JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+// generated by TestBuilder
+bool JitIsSupported()
+{
+    TEST_Tracer("JitIsSupported");
+    methodHitMap["JitIsSupported"]++;
+    if(FunctionInjections.count("JitIsSupported") == 1){
+    Params p;
+    FunctionInjections["JitIsSupported"](p);
+    }
+    return JitIsSupported_INTERNAL();
+}
+
+
+void InitJit(PebbleVM* vm, void* nativeTarget);
+
+void InitJit_INTERNAL(PebbleVM* vm, void* nativeTarget)
+{
+    ReleaseNativeCode(vm);
+    vm->Jit.NativeTarget = nativeTarget;
+    vm->Jit.Counters.assign(vm->ByteCodeProgram.size(), 0);
+    vm->Jit.RegionAt.assign(vm->ByteCodeProgram.size(), nullptr);
+}
+
+// generated by TestBuilder
+void InitJit(PebbleVM* vm, void* nativeTarget)
+{
+    TEST_Tracer("InitJit");
+    methodHitMap["InitJit"]++;
+    if(FunctionInjections.count("InitJit") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&nativeTarget));
+    FunctionInjections["InitJit"](p);
+    }
+    InitJit_INTERNAL(vm, nativeTarget);
+}
+
+
+void CountSectionEntry(PebbleVM* vm, extArg_t section);
+
+void CountSectionEntry_INTERNAL(PebbleVM* vm, extArg_t section)
+{
+    if(CountEntry(vm, section))
+    {
+        CompileRegion(vm, section, SectionEnd(vm, section));
+    }
+}
+
+// generated by TestBuilder
+void CountSectionEntry(PebbleVM* vm, extArg_t section)
+{
+    TEST_Tracer("CountSectionEntry");
+    methodHitMap["CountSectionEntry"]++;
+    if(FunctionInjections.count("CountSectionEntry") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&section));
+    FunctionInjections["CountSectionEntry"](p);
+    }
+    CountSectionEntry_INTERNAL(vm, section);
+}
+
+
+void CountLoopEntry(PebbleVM* vm, extArg_t loopHeader, extArg_t backEdge);
+
+void CountLoopEntry_INTERNAL(PebbleVM* vm, extArg_t loopHeader, extArg_t backEdge)
+{
+    if(CountEntry(vm, loopHeader))
+    {
+        CompileRegion(vm, loopHeader, backEdge);
+    }
+}
+
+// generated by TestBuilder
+void CountLoopEntry(PebbleVM* vm, extArg_t loopHeader, extArg_t backEdge)
+{
+    TEST_Tracer("CountLoopEntry");
+    methodHitMap["CountLoopEntry"]++;
+    if(FunctionInjections.count("CountLoopEntry") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&loopHeader));
+    p.push_back(static_cast<const void*>(&backEdge));
+    FunctionInjections["CountLoopEntry"](p);
+    }
+    CountLoopEntry_INTERNAL(vm, loopHeader, backEdge);
+}
+
+
+void RunNativeCode(PebbleVM* vm);
+
+void RunNativeCode_INTERNAL(PebbleVM* vm)
+{
+    auto region = vm->Jit.RegionAt[vm->InstructionReg];
+    region->Code(vm->InstructionReg - region->Start);
+}
+
+// generated by TestBuilder
+void RunNativeCode(PebbleVM* vm)
+{
+    TEST_Tracer("RunNativeCode");
+    methodHitMap["RunNativeCode"]++;
+    if(FunctionInjections.count("RunNativeCode") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["RunNativeCode"](p);
+    }
+    RunNativeCode_INTERNAL(vm);
+}
+
+
+void ReleaseNativeCode(PebbleVM* vm);
+
+void ReleaseNativeCode_INTERNAL(PebbleVM* vm)
+{
+#ifdef PEBBLE_JIT_X86_64
+    for(auto& region: vm->Jit.Regions)
+    {
+        munmap(region->Memory, region->Size);
+    }
+#endif
+    vm->Jit.Regions.clear();
+    vm->Jit.RegionAt.clear();
+    vm->Jit.Counters.clear();
+}
+
+// generated by TestBuilder
+void ReleaseNativeCode(PebbleVM* vm)
+{
+    TEST_Tracer("ReleaseNativeCode");
+    methodHitMap["ReleaseNativeCode"]++;
+    if(FunctionInjections.count("ReleaseNativeCode") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ReleaseNativeCode"](p);
+    }
+    ReleaseNativeCode_INTERNAL(vm);
+}
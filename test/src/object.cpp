@@ -0,0 +1,797 @@
+#include "test.h"
+#include <cstdarg>
+#include <iostream>
+
+#include "object.h"
+#include "diagnostics.h"
+#include "program.h"
+#include "reference.h"
+#include "scope.h"
+#include "token.h"
+
+utils::Slab<Scope> ObjectScopeSlab;
+
+
+Object* ObjectConstructor();
+
+Object* ObjectConstructor_INTERNAL()
+{
+    Object* obj = new Object;
+    obj->Attributes = ScopeConstructor(ObjectScopeSlab, nullptr);
+    obj->Attributes->IsDurable = true;
+    obj->Class = NullClass;
+    obj->Value = nullptr;
+    obj->Action = nullptr;
+    obj->DefinitionScope = nullptr;
+
+    return obj;
+}
+
+// generated by TestBuilder
+Object* ObjectConstructor()
+{
+    TEST_Tracer("ObjectConstructor");
+    methodHitMap["ObjectConstructor"]++;
+    if(FunctionInjections.count("ObjectConstructor") == 1){
+    Params p;
+    FunctionInjections["ObjectConstructor"](p);
+    }
+    return ObjectConstructor_INTERNAL();
+}
+
+
+Object* ObjectConstructor(ObjectClass cls, void* value);
+
+Object* ObjectConstructor_INTERNAL(ObjectClass cls, void* value)
+{
+    Object* obj = new Object;
+    obj->Attributes = ScopeConstructor(ObjectScopeSlab, nullptr);
+    obj->Class = cls;
+    obj->Value = value;
+    obj->Action = nullptr;
+    obj->DefinitionScope = nullptr;
+
+    return obj;
+}
+
+// generated by TestBuilder
+Object* ObjectConstructor(ObjectClass cls, void* value)
+{
+    TEST_Tracer("ObjectConstructor");
+    methodHitMap["ObjectConstructor"]++;
+    if(FunctionInjections.count("ObjectConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&cls));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ObjectConstructor"](p);
+    }
+    return ObjectConstructor_INTERNAL(cls, value);
+}
+
+
+void ObjectValueDestructor(Object* obj);
+
+void ObjectValueDestructor_INTERNAL(Object* obj)
+{
+    auto klass = obj->Class;
+    if(klass == IntegerClass)
+    {
+        delete static_cast<int*>(obj->Value);
+    }
+    else if(klass == DecimalClass)
+    {
+        delete static_cast<double*>(obj->Value);
+    }
+    else if(klass == BooleanClass)
+    {
+        delete static_cast<bool*>(obj->Value);
+    }
+    else if(klass == StringClass)
+    {
+        delete static_cast<std::string*>(obj->Value);
+    }
+}
+
+// generated by TestBuilder
+void ObjectValueDestructor(Object* obj)
+{
+    TEST_Tracer("ObjectValueDestructor");
+    methodHitMap["ObjectValueDestructor"]++;
+    if(FunctionInjections.count("ObjectValueDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ObjectValueDestructor"](p);
+    }
+    ObjectValueDestructor_INTERNAL(obj);
+}
+
+
+void ObjectValueDestructor(ObjectClass klass, void* val);
+
+void ObjectValueDestructor_INTERNAL(ObjectClass klass, void* val)
+{
+    if(klass == IntegerClass)
+    {
+        delete static_cast<int*>(val);
+    }
+    else if(klass == DecimalClass)
+    {
+        delete static_cast<double*>(val);
+    }
+    else if(klass == BooleanClass)
+    {
+        delete static_cast<bool*>(val);
+    }
+    else if(klass == StringClass)
+    {
+        delete static_cast<std::string*>(val);
+    }
+}
+
+// generated by TestBuilder
+void ObjectValueDestructor(ObjectClass klass, void* val)
+{
+    TEST_Tracer("ObjectValueDestructor");
+    methodHitMap["ObjectValueDestructor"]++;
+    if(FunctionInjections.count("ObjectValueDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&klass));
+    p.push_back(static_cast<const void*>(&val));
+    FunctionInjections["ObjectValueDestructor"](p);
+    }
+    ObjectValueDestructor_INTERNAL(klass, val);
+}
+
+
+void ObjectDestructor(Object* obj);
+
+void ObjectDestructor_INTERNAL(Object* obj)
+{
+    delete obj;
+}
+
+// generated by TestBuilder
+void ObjectDestructor(Object* obj)
+{
+    TEST_Tracer("ObjectDestructor");
+    methodHitMap["ObjectDestructor"]++;
+    if(FunctionInjections.count("ObjectDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ObjectDestructor"](p);
+    }
+    ObjectDestructor_INTERNAL(obj);
+}
+
+
+void DeleteObject(Object* obj);
+
+void DeleteObject_INTERNAL(Object* obj)
+{
+    ScopeDestructor(ObjectScopeSlab, obj->Attributes);
+    if(IsCallable(obj))
+    {
+        MethodDestructor(obj->Action);
+    }
+    if(obj->Value != nullptr)
+    {
+        ObjectValueDestructor(obj);
+    }
+    
+    ObjectDestructor(obj);
+}
+
+// generated by TestBuilder
+void DeleteObject(Object* obj)
+{
+    TEST_Tracer("DeleteObject");
+    methodHitMap["DeleteObject"]++;
+    if(FunctionInjections.count("DeleteObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["DeleteObject"](p);
+    }
+    DeleteObject_INTERNAL(obj);
+}
+
+
+
+String* ObjectValueConstructor(String value);
+
+String* ObjectValueConstructor_INTERNAL(String value)
+{
+    std::string* s = new std::string;
+    *s = value;
+    return s;
+}
+
+// generated by TestBuilder
+String* ObjectValueConstructor(String value)
+{
+    TEST_Tracer("ObjectValueConstructor");
+    methodHitMap["ObjectValueConstructor"]++;
+    if(FunctionInjections.count("ObjectValueConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ObjectValueConstructor"](p);
+    }
+    return ObjectValueConstructor_INTERNAL(value);
+}
+
+bool* ObjectValueConstructor(bool value);
+
+bool* ObjectValueConstructor_INTERNAL(bool value)
+{
+    bool* s = new bool;
+    *s = value;
+    return s;
+}
+
+// generated by TestBuilder
+bool* ObjectValueConstructor(bool value)
+{
+    TEST_Tracer("ObjectValueConstructor");
+    methodHitMap["ObjectValueConstructor"]++;
+    if(FunctionInjections.count("ObjectValueConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ObjectValueConstructor"](p);
+    }
+    return ObjectValueConstructor_INTERNAL(value);
+}
+
+double* ObjectValueConstructor(double value);
+
+double* ObjectValueConstructor_INTERNAL(double value)
+{
+    double* s = new double;
+    *s = value;
+    return s;
+}
+
+// generated by TestBuilder
+double* ObjectValueConstructor(double value)
+{
+    TEST_Tracer("ObjectValueConstructor");
+    methodHitMap["ObjectValueConstructor"]++;
+    if(FunctionInjections.count("ObjectValueConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ObjectValueConstructor"](p);
+    }
+    return ObjectValueConstructor_INTERNAL(value);
+}
+
+int* ObjectValueConstructor(int value);
+
+int* ObjectValueConstructor_INTERNAL(int value)
+{
+    int* s = new int;
+    *s = value;
+    return s;
+}
+
+// generated by TestBuilder
+int* ObjectValueConstructor(int value)
+{
+    TEST_Tracer("ObjectValueConstructor");
+    methodHitMap["ObjectValueConstructor"]++;
+    if(FunctionInjections.count("ObjectValueConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["ObjectValueConstructor"](p);
+    }
+    return ObjectValueConstructor_INTERNAL(value);
+}
+
+
+
+Method* MethodConstructor();
+
+Method* MethodConstructor_INTERNAL()
+{
+    Method* m = new Method;
+    m->CodeBlock = nullptr;
+    m->ParameterNames = {};
+
+    return m;
+}
+
+// generated by TestBuilder
+Method* MethodConstructor()
+{
+    TEST_Tracer("MethodConstructor");
+    methodHitMap["MethodConstructor"]++;
+    if(FunctionInjections.count("MethodConstructor") == 1){
+    Params p;
+    FunctionInjections["MethodConstructor"](p);
+    }
+    return MethodConstructor_INTERNAL();
+}
+
+
+void MethodDestructor(Method* m);
+
+void MethodDestructor_INTERNAL(Method* m)
+{
+    delete m;
+}
+
+// generated by TestBuilder
+void MethodDestructor(Method* m)
+{
+    TEST_Tracer("MethodDestructor");
+    methodHitMap["MethodDestructor"]++;
+    if(FunctionInjections.count("MethodDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&m));
+    FunctionInjections["MethodDestructor"](p);
+    }
+    MethodDestructor_INTERNAL(m);
+}
+
+
+
+
+Object* ObjectOf(const Reference* ref);
+
+Object* ObjectOf_INTERNAL(const Reference* ref)
+{
+    return ref->To;
+}
+
+// generated by TestBuilder
+Object* ObjectOf(const Reference* ref)
+{
+    TEST_Tracer("ObjectOf");
+    methodHitMap["ObjectOf"]++;
+    if(FunctionInjections.count("ObjectOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["ObjectOf"](p);
+    }
+    return ObjectOf_INTERNAL(ref);
+}
+
+
+bool IsCallable(const Reference* ref);
+
+bool IsCallable_INTERNAL(const Reference* ref)
+{
+    return ref->To->Action != nullptr;
+}
+
+// generated by TestBuilder
+bool IsCallable(const Reference* ref)
+{
+    TEST_Tracer("IsCallable");
+    methodHitMap["IsCallable"]++;
+    if(FunctionInjections.count("IsCallable") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsCallable"](p);
+    }
+    return IsCallable_INTERNAL(ref);
+}
+
+
+bool IsCallable(const Object* obj);
+
+bool IsCallable_INTERNAL(const Object* obj)
+{
+    return obj->Action != nullptr;
+}
+
+// generated by TestBuilder
+bool IsCallable(const Object* obj)
+{
+    TEST_Tracer("IsCallable");
+    methodHitMap["IsCallable"]++;
+    if(FunctionInjections.count("IsCallable") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["IsCallable"](p);
+    }
+    return IsCallable_INTERNAL(obj);
+}
+
+
+bool IsNumeric(const Reference* ref);
+
+bool IsNumeric_INTERNAL(const Reference* ref)
+{
+    return ObjectOf(ref)->Class == IntegerClass || ObjectOf(ref)->Class == DecimalClass;
+}
+
+// generated by TestBuilder
+bool IsNumeric(const Reference* ref)
+{
+    TEST_Tracer("IsNumeric");
+    methodHitMap["IsNumeric"]++;
+    if(FunctionInjections.count("IsNumeric") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsNumeric"](p);
+    }
+    return IsNumeric_INTERNAL(ref);
+}
+
+
+bool IsString(const Reference* ref);
+
+bool IsString_INTERNAL(const Reference* ref)
+{
+    return ObjectOf(ref) != nullptr && ObjectOf(ref)->Class == StringClass;
+}
+
+// generated by TestBuilder
+bool IsString(const Reference* ref)
+{
+    TEST_Tracer("IsString");
+    methodHitMap["IsString"]++;
+    if(FunctionInjections.count("IsString") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsString"](p);
+    }
+    return IsString_INTERNAL(ref);
+}
+
+
+
+
+
+
+
+ObjectClass GetPrecedenceClass(const Object* obj1, const Object* obj2);
+
+ObjectClass GetPrecedenceClass_INTERNAL(const Object* obj1, const Object* obj2)
+{
+    if(obj1->Class == DecimalClass || obj2->Class == DecimalClass)
+        return DecimalClass;
+    return IntegerClass;
+}
+
+// generated by TestBuilder
+ObjectClass GetPrecedenceClass(const Object* obj1, const Object* obj2)
+{
+    TEST_Tracer("GetPrecedenceClass");
+    methodHitMap["GetPrecedenceClass"]++;
+    if(FunctionInjections.count("GetPrecedenceClass") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj1));
+    p.push_back(static_cast<const void*>(&obj2));
+    FunctionInjections["GetPrecedenceClass"](p);
+    }
+    return GetPrecedenceClass_INTERNAL(obj1, obj2);
+}
+
+
+
+
+String GetStringValue(const Object* obj);
+
+String GetStringValue_INTERNAL(const Object* obj)
+{
+    if(obj->Class == IntegerClass)
+    {
+        return std::to_string(*static_cast<int*>(obj->Value));
+    }
+    else if(obj->Class == DecimalClass)
+    {
+        return std::to_string(*static_cast<double*>(obj->Value));
+    }
+    else if(obj->Class == BooleanClass)
+    {
+        if(*static_cast<bool*>(obj->Value))
+        {
+            return "true";
+        }
+        return "false";
+    }
+    else if(obj->Class == StringClass)
+    {
+        return *static_cast<String*>(obj->Value);
+    }
+    else if(obj->Class == NullClass)
+    {
+        return "Nothing";
+    }
+    else if(obj->Class == BaseClass)
+    {
+        return "Object";
+    }
+    else if(obj->Class == SomethingClass)
+    {
+        return "Something";
+    }
+    else if(obj->Class == MethodClass)
+    {
+        return "Method";
+    }
+    else
+    {
+        return "<" + obj->Class + ">";
+    }
+}
+
+// generated by TestBuilder
+String GetStringValue(const Object* obj)
+{
+    TEST_Tracer("GetStringValue");
+    methodHitMap["GetStringValue"]++;
+    if(FunctionInjections.count("GetStringValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["GetStringValue"](p);
+    }
+    return GetStringValue_INTERNAL(obj);
+}
+
+
+int GetIntValue(const Object* obj);
+
+int GetIntValue_INTERNAL(const Object* obj)
+{
+    if(obj->Class != IntegerClass)
+    {
+        LogIt(LogSeverityType::Sev1_Notify, "GetIntValue", "only implemented for IntegerClass");
+        return 0;
+    }
+    return *static_cast<int*>(obj->Value);
+}
+
+// generated by TestBuilder
+int GetIntValue(const Object* obj)
+{
+    TEST_Tracer("GetIntValue");
+    methodHitMap["GetIntValue"]++;
+    if(FunctionInjections.count("GetIntValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["GetIntValue"](p);
+    }
+    return GetIntValue_INTERNAL(obj);
+}
+
+
+double GetDecimalValue(const Object* obj);
+
+double GetDecimalValue_INTERNAL(const Object* obj)
+{
+    if(obj->Class == DecimalClass)
+    {
+        return *static_cast<double*>(obj->Value);
+    }
+    if(obj->Class == IntegerClass)
+    {
+        return static_cast<double>(*static_cast<int*>(obj->Value));
+    }
+    LogIt(LogSeverityType::Sev1_Notify, "GetDecimalValue", "only implemented for Integer and Decimal classes");
+    return 0;
+}
+
+// generated by TestBuilder
+double GetDecimalValue(const Object* obj)
+{
+    TEST_Tracer("GetDecimalValue");
+    methodHitMap["GetDecimalValue"]++;
+    if(FunctionInjections.count("GetDecimalValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["GetDecimalValue"](p);
+    }
+    return GetDecimalValue_INTERNAL(obj);
+}
+
+
+bool GetBoolValue(const Object* obj);
+
+bool GetBoolValue_INTERNAL(const Object* obj)
+{
+    if(obj->Class == BooleanClass)
+    {
+        return *static_cast<bool*>(obj->Value);
+    }
+    else if (obj->Class == IntegerClass)
+    {
+        return static_cast<bool>(*static_cast<int*>(obj->Value));
+    }
+    else if(obj->Class == NullClass)
+    {
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+// generated by TestBuilder
+bool GetBoolValue(const Object* obj)
+{
+    TEST_Tracer("GetBoolValue");
+    methodHitMap["GetBoolValue"]++;
+    if(FunctionInjections.count("GetBoolValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["GetBoolValue"](p);
+    }
+    return GetBoolValue_INTERNAL(obj);
+}
+
+
+
+
+bool ObjectIsClass(Object* obj, ObjectClass cls);
+
+bool ObjectIsClass_INTERNAL(Object* obj, ObjectClass cls)
+{
+    return obj->Class == cls;
+}
+
+// generated by TestBuilder
+bool ObjectIsClass(Object* obj, ObjectClass cls)
+{
+    TEST_Tracer("ObjectIsClass");
+    methodHitMap["ObjectIsClass"]++;
+    if(FunctionInjections.count("ObjectIsClass") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    p.push_back(static_cast<const void*>(&cls));
+    FunctionInjections["ObjectIsClass"](p);
+    }
+    return ObjectIsClass_INTERNAL(obj, cls);
+}
+
+
+
+
+
+bool ValueMatchesPrimitiveObject(int value, Object* obj);
+
+bool ValueMatchesPrimitiveObject_INTERNAL(int value, Object* obj)
+{
+    return ObjectIsClass(obj, IntegerClass) && *static_cast<int*>(obj->Value) == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveObject(int value, Object* obj)
+{
+    TEST_Tracer("ValueMatchesPrimitiveObject");
+    methodHitMap["ValueMatchesPrimitiveObject"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ValueMatchesPrimitiveObject"](p);
+    }
+    return ValueMatchesPrimitiveObject_INTERNAL(value, obj);
+}
+
+
+bool ValueMatchesPrimitiveObject(String value, Object* obj);
+
+bool ValueMatchesPrimitiveObject_INTERNAL(String value, Object* obj)
+{
+    return ObjectIsClass(obj, StringClass) && *static_cast<String*>(obj->Value) == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveObject(String value, Object* obj)
+{
+    TEST_Tracer("ValueMatchesPrimitiveObject");
+    methodHitMap["ValueMatchesPrimitiveObject"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ValueMatchesPrimitiveObject"](p);
+    }
+    return ValueMatchesPrimitiveObject_INTERNAL(value, obj);
+}
+
+
+bool ValueMatchesPrimitiveObject(double value, Object* obj);
+
+bool ValueMatchesPrimitiveObject_INTERNAL(double value, Object* obj)
+{
+    return ObjectIsClass(obj, DecimalClass) && *static_cast<double*>(obj->Value) == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveObject(double value, Object* obj)
+{
+    TEST_Tracer("ValueMatchesPrimitiveObject");
+    methodHitMap["ValueMatchesPrimitiveObject"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ValueMatchesPrimitiveObject"](p);
+    }
+    return ValueMatchesPrimitiveObject_INTERNAL(value, obj);
+}
+
+
+bool ValueMatchesPrimitiveObject(bool value, Object* obj);
+
+bool ValueMatchesPrimitiveObject_INTERNAL(bool value, Object* obj)
+{
+    return ObjectIsClass(obj, BooleanClass) && *static_cast<bool*>(obj->Value) == value;
+}
+
+// generated by TestBuilder
+bool ValueMatchesPrimitiveObject(bool value, Object* obj)
+{
+    TEST_Tracer("ValueMatchesPrimitiveObject");
+    methodHitMap["ValueMatchesPrimitiveObject"]++;
+    if(FunctionInjections.count("ValueMatchesPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ValueMatchesPrimitiveObject"](p);
+    }
+    return ValueMatchesPrimitiveObject_INTERNAL(value, obj);
+}
+
+
+bool ListContainsPrimitiveObject(std::vector<Object*> list, int value, Object** foundObject)
+{
+    for(auto obj: list)
+    {
+        if(ValueMatchesPrimitiveObject(value, obj))
+        {
+            *foundObject = obj;
+            return true;
+        }
+    }
+    
+    *foundObject = nullptr; 
+    return false;
+}
+
+
+bool ListContainsPrimitiveObject(std::vector<Object*> list, String& value, Object** foundObject)
+{
+    for(auto obj: list)
+    {
+        if(ValueMatchesPrimitiveObject(value, obj))
+        {
+            *foundObject = obj;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+bool ListContainsPrimitiveObject(std::vector<Object*> list, double value, Object** foundObject)
+{
+    for(auto obj: list)
+    {
+        if(ValueMatchesPrimitiveObject(value, obj))
+        {
+            *foundObject = obj;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+bool ListContainsPrimitiveObject(std::vector<Object*> list, bool value, Object** foundObject)
+{
+    for(auto obj: list)
+    {
+        if(ValueMatchesPrimitiveObject(value, obj))
+        {
+            *foundObject = obj;
+            return true;
+        }
+    }
+    
+    return false;
+}
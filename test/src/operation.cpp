@@ -0,0 +1,148 @@
+#include "test.h"
+#include <iostream>
+
+#include "operation.h"
+#include "reference.h"
+#include "diagnostics.h"
+#include "executable.h"
+#include "object.h"
+
+
+
+
+
+
+Operation* OperationConstructor(
+    OperationType type, 
+    OperationsList operands, 
+    Reference* value);
+
+Operation* OperationConstructor_INTERNAL(
+    OperationType type, 
+    OperationsList operands, 
+    Reference* value)
+{
+    Operation* op = new Operation;
+    op->LineNumber = -1;
+    op->Operands = operands;
+    op->Type = type;
+    op->Value = value;
+
+    op->ExecType = ExecutableType::Operation;
+
+    return op;
+}
+
+// generated by TestBuilder
+Operation* OperationConstructor(
+    OperationType type, 
+    OperationsList operands, 
+    Reference* value)
+{
+    TEST_Tracer("OperationConstructor");
+    methodHitMap["OperationConstructor"]++;
+    if(FunctionInjections.count("OperationConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&operands));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["OperationConstructor"](p);
+    }
+    return OperationConstructor_INTERNAL(type, operands, value);
+}
+
+
+Operation* OperationConstructor(
+    OperationType type, 
+    Reference* value,
+    OperationsList operands);
+
+Operation* OperationConstructor_INTERNAL(
+    OperationType type, 
+    Reference* value,
+    OperationsList operands)
+{
+    Operation* op = new Operation;
+    op->LineNumber = -1;
+    op->Operands = operands;
+    op->Type = type;
+    op->Value = value;
+
+    op->ExecType = ExecutableType::Operation;
+
+    return op;
+}
+
+// generated by TestBuilder
+Operation* OperationConstructor(
+    OperationType type, 
+    Reference* value,
+    OperationsList operands)
+{
+    TEST_Tracer("OperationConstructor");
+    methodHitMap["OperationConstructor"]++;
+    if(FunctionInjections.count("OperationConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&value));
+    p.push_back(static_cast<const void*>(&operands));
+    FunctionInjections["OperationConstructor"](p);
+    }
+    return OperationConstructor_INTERNAL(type, value, operands);
+}
+
+
+void OperationDestructor(Operation* op);
+
+void OperationDestructor_INTERNAL(Operation* op)
+{
+    delete op;
+}
+
+// generated by TestBuilder
+void OperationDestructor(Operation* op)
+{
+    TEST_Tracer("OperationDestructor");
+    methodHitMap["OperationDestructor"]++;
+    if(FunctionInjections.count("OperationDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["OperationDestructor"](p);
+    }
+    OperationDestructor_INTERNAL(op);
+}
+
+
+void DeleteOperationRecursive(Operation* op);
+
+void DeleteOperationRecursive_INTERNAL(Operation* op)
+{
+    for(auto operand: op->Operands)
+        DeleteOperationRecursive(operand);
+    
+    if(op->Type == OperationType::Ref)
+    {
+        if(IsReferenceStub(op->Value))
+        {
+            ReferenceStubDestructor(op->Value);
+        }
+        else
+        {
+            ReferenceDestructor(op->Value);
+        }
+    }
+    OperationDestructor(op);
+}
+
+// generated by TestBuilder
+void DeleteOperationRecursive(Operation* op)
+{
+    TEST_Tracer("DeleteOperationRecursive");
+    methodHitMap["DeleteOperationRecursive"]++;
+    if(FunctionInjections.count("DeleteOperationRecursive") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    FunctionInjections["DeleteOperationRecursive"](p);
+    }
+    DeleteOperationRecursive_INTERNAL(op);
+}
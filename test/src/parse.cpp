@@ -0,0 +1,1069 @@
+#include "test.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "parse.h"
+
+#include "main.h"
+#include "token.h"
+#include "diagnostics.h"
+#include "reference.h"
+#include "operation.h"
+#include "executable.h"
+#include "object.h"
+#include "program.h"
+#include "grammar.h"
+
+
+std::vector<Object*> ConstantPrimitiveObjects;
+
+std::unordered_map<String, Object*> ConstantPrimitiveIndex;
+
+thread_local std::vector<DeferredConstant>* DeferredConstants = nullptr;
+
+
+
+void AddToList(ParseToken** listHead, ParseToken** listTail, ParseToken* newToken);
+
+void AddToList_INTERNAL(ParseToken** listHead, ParseToken** listTail, ParseToken* newToken)
+{
+    if(*listHead == nullptr)
+    {
+        *listHead = newToken;
+        *listTail = newToken;
+        return;
+    }
+    else
+    {
+        (*listTail)->Next = newToken;
+        newToken->Prev = *listTail;
+        *listTail = newToken;
+    }
+}
+
+// generated by TestBuilder
+void AddToList(ParseToken** listHead, ParseToken** listTail, ParseToken* newToken)
+{
+    TEST_Tracer("AddToList");
+    methodHitMap["AddToList"]++;
+    if(FunctionInjections.count("AddToList") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&newToken));
+    FunctionInjections["AddToList"](p);
+    }
+    AddToList_INTERNAL(listHead, listTail, newToken);
+}
+
+
+void RemoveLastTokenFromList(ParseToken** listHead, ParseToken** listTail);
+
+void RemoveLastTokenFromList_INTERNAL(ParseToken** listHead, ParseToken** listTail)
+{
+    if(listTail == nullptr)
+        return;
+
+    ParseToken* temp = *listTail;
+    *listTail = (*listTail)->Prev;
+
+    if(listTail != nullptr)
+        (*listTail)->Next = nullptr;
+
+    delete temp;
+}
+
+// generated by TestBuilder
+void RemoveLastTokenFromList(ParseToken** listHead, ParseToken** listTail)
+{
+    TEST_Tracer("RemoveLastTokenFromList");
+    methodHitMap["RemoveLastTokenFromList"]++;
+    if(FunctionInjections.count("RemoveLastTokenFromList") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    FunctionInjections["RemoveLastTokenFromList"](p);
+    }
+    RemoveLastTokenFromList_INTERNAL(listHead, listTail);
+}
+
+
+ParseToken* ParseTokenConstructor(GrammarSymbol symbol);
+
+ParseToken* ParseTokenConstructor_INTERNAL(GrammarSymbol symbol)
+{
+    ParseToken* gt = new ParseToken;
+    gt->Next = nullptr;
+    gt->Prev = nullptr;
+    gt->Symbol = symbol;
+    gt->Value = nullptr;
+
+    return gt;
+}
+
+// generated by TestBuilder
+ParseToken* ParseTokenConstructor(GrammarSymbol symbol)
+{
+    TEST_Tracer("ParseTokenConstructor");
+    methodHitMap["ParseTokenConstructor"]++;
+    if(FunctionInjections.count("ParseTokenConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&symbol));
+    FunctionInjections["ParseTokenConstructor"](p);
+    }
+    return ParseTokenConstructor_INTERNAL(symbol);
+}
+
+
+void ParseTokenDestructor(ParseToken* token);
+
+void ParseTokenDestructor_INTERNAL(ParseToken* token)
+{
+    delete token;
+}
+
+// generated by TestBuilder
+void ParseTokenDestructor(ParseToken* token)
+{
+    TEST_Tracer("ParseTokenDestructor");
+    methodHitMap["ParseTokenDestructor"]++;
+    if(FunctionInjections.count("ParseTokenDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["ParseTokenDestructor"](p);
+    }
+    ParseTokenDestructor_INTERNAL(token);
+}
+
+
+String ConstantKeyOf(Token* token);
+
+String ConstantKeyOf_INTERNAL(Token* token)
+{
+    switch(token->Type)
+    {
+        case TokenType::Integer:
+        return "i" + std::to_string(std::stoi(String(token->Content)));
+
+        case TokenType::Boolean:
+        return token->Content == "true" ? "b1" : "b0";
+
+        case TokenType::String:
+        return "s" + String(token->Content);
+
+        case TokenType::Decimal:
+        {
+            double value = std::stod(String(token->Content));
+            String key(1 + sizeof(value), 'd');
+            std::memcpy(&key[1], &value, sizeof(value));
+            return key;
+        }
+
+        default:
+        return "";
+    }
+}
+
+// generated by TestBuilder
+String ConstantKeyOf(Token* token)
+{
+    TEST_Tracer("ConstantKeyOf");
+    methodHitMap["ConstantKeyOf"]++;
+    if(FunctionInjections.count("ConstantKeyOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["ConstantKeyOf"](p);
+    }
+    return ConstantKeyOf_INTERNAL(token);
+}
+
+
+bool TokenRefersToExistingPrimitiveObject(Token* token, Object** matchedObject);
+
+bool TokenRefersToExistingPrimitiveObject_INTERNAL(Token* token, Object** matchedObject)
+{
+    auto it = ConstantPrimitiveIndex.find(ConstantKeyOf(token));
+    if(it == ConstantPrimitiveIndex.end())
+    {
+        return false;
+    }
+
+    *matchedObject = it->second;
+    return true;
+}
+
+// generated by TestBuilder
+bool TokenRefersToExistingPrimitiveObject(Token* token, Object** matchedObject)
+{
+    TEST_Tracer("TokenRefersToExistingPrimitiveObject");
+    methodHitMap["TokenRefersToExistingPrimitiveObject"]++;
+    if(FunctionInjections.count("TokenRefersToExistingPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    p.push_back(static_cast<const void*>(&matchedObject));
+    FunctionInjections["TokenRefersToExistingPrimitiveObject"](p);
+    }
+    return TokenRefersToExistingPrimitiveObject_INTERNAL(token, matchedObject);
+}
+
+
+Object* CreateObjectFromToken(Token* token);
+
+Object* CreateObjectFromToken_INTERNAL(Token* token)
+{
+    switch(token->Type)
+    {
+        case TokenType::Integer:
+        return ObjectConstructor(IntegerClass, ObjectValueConstructor(std::stoi(String(token->Content))));
+        
+        case TokenType::Decimal:
+        return ObjectConstructor(DecimalClass, ObjectValueConstructor(std::stod(String(token->Content))));
+
+        case TokenType::Boolean:
+        {
+            bool b = (token->Content == "true" ? true : false);
+            return ObjectConstructor(BooleanClass, ObjectValueConstructor(b));
+        }
+
+        case TokenType::String:
+        return ObjectConstructor(StringClass, ObjectValueConstructor(String(token->Content)));
+
+        default:
+        return nullptr;
+    }
+}
+
+// generated by TestBuilder
+Object* CreateObjectFromToken(Token* token)
+{
+    TEST_Tracer("CreateObjectFromToken");
+    methodHitMap["CreateObjectFromToken"]++;
+    if(FunctionInjections.count("CreateObjectFromToken") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["CreateObjectFromToken"](p);
+    }
+    return CreateObjectFromToken_INTERNAL(token);
+}
+
+
+Object* ConstantObjectFor(Token* token);
+
+Object* ConstantObjectFor_INTERNAL(Token* token)
+{
+    Object* obj = nullptr;
+    if(!TokenRefersToExistingPrimitiveObject(token, &obj))
+    {
+        obj = CreateObjectFromToken(token);
+        ConstantPrimitiveObjects.push_back(obj);
+        ConstantPrimitiveIndex[ConstantKeyOf(token)] = obj;
+    }
+
+    return obj;
+}
+
+// generated by TestBuilder
+Object* ConstantObjectFor(Token* token)
+{
+    TEST_Tracer("ConstantObjectFor");
+    methodHitMap["ConstantObjectFor"]++;
+    if(FunctionInjections.count("ConstantObjectFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["ConstantObjectFor"](p);
+    }
+    return ConstantObjectFor_INTERNAL(token);
+}
+
+
+void BindDeferredConstants(const std::vector<DeferredConstant>& constants)
+{
+    for(auto& constant: constants)
+    {
+        constant.Ref->To = ConstantObjectFor(constant.Value);
+    }
+}
+
+
+Operation* RefOperation(Token* refToken);
+
+Operation* RefOperation_INTERNAL(Token* refToken)
+{
+    Reference* ref = nullptr;
+
+    if(TokenMatchesType(refToken, PrimitiveTokenTypes))
+    {
+        if(DeferredConstants != nullptr)
+        {
+            ref = ReferenceConstructor(c_operationReferenceName, nullptr);
+            DeferredConstants->push_back({ ref, refToken });
+        }
+        else
+        {
+            ref = ReferenceConstructor(c_operationReferenceName, ConstantObjectFor(refToken));
+        }
+    }
+    else
+    {
+        ref = ReferenceStubConstructor(String(refToken->Content));    
+    }
+    
+    Operation* op = OperationConstructor(OperationType::Ref, ref);
+
+    return op;
+}
+
+// generated by TestBuilder
+Operation* RefOperation(Token* refToken)
+{
+    TEST_Tracer("RefOperation");
+    methodHitMap["RefOperation"]++;
+    if(FunctionInjections.count("RefOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refToken));
+    FunctionInjections["RefOperation"](p);
+    }
+    return RefOperation_INTERNAL(refToken);
+}
+
+
+const CFGRule* MatchGrammarPatterns(ParseToken* listTail);
+
+const CFGRule* MatchGrammarPatterns_INTERNAL(ParseToken* listTail)
+{
+    ReductionState state = ReductionTrieRoot;
+    const CFGRule* match = ReducedRuleAt(state);
+
+    for(ParseToken* listItr = listTail; listItr != nullptr; listItr = listItr->Prev)
+    {
+        state = NextReductionState(state, listItr->Symbol);
+        if(state == NoReductionState)
+        {
+            break;
+        }
+
+        const CFGRule* rule = ReducedRuleAt(state);
+        if(rule != nullptr)
+        {
+            match = rule;
+        }
+    }
+
+    return match;
+}
+
+// generated by TestBuilder
+const CFGRule* MatchGrammarPatterns(ParseToken* listTail)
+{
+    TEST_Tracer("MatchGrammarPatterns");
+    methodHitMap["MatchGrammarPatterns"]++;
+    if(FunctionInjections.count("MatchGrammarPatterns") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listTail));
+    FunctionInjections["MatchGrammarPatterns"](p);
+    }
+    return MatchGrammarPatterns_INTERNAL(listTail);
+}
+
+
+void DestroyList(ParseToken* listHead);
+
+void DestroyList_INTERNAL(ParseToken* listHead)
+{
+    ParseToken* prevToken;
+    while(listHead != nullptr)
+    {
+        prevToken = listHead;
+        listHead = listHead->Next;
+        ParseTokenDestructor(prevToken);
+    }
+}
+
+// generated by TestBuilder
+void DestroyList(ParseToken* listHead)
+{
+    TEST_Tracer("DestroyList");
+    methodHitMap["DestroyList"]++;
+    if(FunctionInjections.count("DestroyList") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    FunctionInjections["DestroyList"](p);
+    }
+    DestroyList_INTERNAL(listHead);
+}
+
+
+void PointToHeadOfRuleAndSnip(ParseToken** listHead, ParseToken** listTail, ParseToken** listSnipHead, const CFGRule& rule);
+
+void PointToHeadOfRuleAndSnip_INTERNAL(ParseToken** listHead, ParseToken** listTail, ParseToken** listSnipHead, const CFGRule& rule)
+{
+    int backtrackAmount = rule.IntoPattern.size()-1;
+
+    for(int i=0; i<backtrackAmount; i++, *listSnipHead = (*listSnipHead)->Prev);
+
+    *listTail = (*listSnipHead)->Prev;
+    
+    if(*listTail != nullptr)
+    {
+        (*listTail)->Next = nullptr;
+    }
+    else
+    {
+        *listHead = nullptr;
+    }
+}
+
+// generated by TestBuilder
+void PointToHeadOfRuleAndSnip(ParseToken** listHead, ParseToken** listTail, ParseToken** listSnipHead, const CFGRule& rule)
+{
+    TEST_Tracer("PointToHeadOfRuleAndSnip");
+    methodHitMap["PointToHeadOfRuleAndSnip"]++;
+    if(FunctionInjections.count("PointToHeadOfRuleAndSnip") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&listSnipHead));
+    p.push_back(static_cast<const void*>(&rule));
+    FunctionInjections["PointToHeadOfRuleAndSnip"](p);
+    }
+    PointToHeadOfRuleAndSnip_INTERNAL(listHead, listTail, listSnipHead, rule);
+}
+
+
+OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule);
+
+OperationsList GetOperandsAndRemoveRule_INTERNAL(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
+{
+    OperationsList operands;
+    operands.reserve(4);
+
+    ParseToken* listSnipHead = *listTail;
+    
+    PointToHeadOfRuleAndSnip(listHead, listTail, &listSnipHead, rule);
+    
+    for(ParseToken* listSnipItr = listSnipHead; listSnipItr != nullptr; listSnipItr = listSnipItr->Next)
+    {
+        if(IsProductionSymbol(listSnipItr->Symbol) && listSnipItr->Value != nullptr)
+        {
+            operands.push_back(listSnipItr->Value);
+        }
+    }
+
+    DestroyList(listSnipHead);
+
+    return operands;
+}
+
+// generated by TestBuilder
+OperationsList GetOperandsAndRemoveRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
+{
+    TEST_Tracer("GetOperandsAndRemoveRule");
+    methodHitMap["GetOperandsAndRemoveRule"]++;
+    if(FunctionInjections.count("GetOperandsAndRemoveRule") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&rule));
+    FunctionInjections["GetOperandsAndRemoveRule"](p);
+    }
+    return GetOperandsAndRemoveRule_INTERNAL(listHead, listTail, rule);
+}
+
+
+
+
+
+Operation* CollapseByReduce(const CFGRule& rule, OperationsList& components);
+
+Operation* CollapseByReduce_INTERNAL(const CFGRule& rule, OperationsList& components)
+{
+    return OperationConstructor(rule.OpType, components);
+}
+
+// generated by TestBuilder
+Operation* CollapseByReduce(const CFGRule& rule, OperationsList& components)
+{
+    TEST_Tracer("CollapseByReduce");
+    methodHitMap["CollapseByReduce"]++;
+    if(FunctionInjections.count("CollapseByReduce") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rule));
+    p.push_back(static_cast<const void*>(&components));
+    FunctionInjections["CollapseByReduce"](p);
+    }
+    return CollapseByReduce_INTERNAL(rule, components);
+}
+
+
+Operation* CollapseByMerge(const CFGRule& rule, OperationsList& components);
+
+Operation* CollapseByMerge_INTERNAL(const CFGRule& rule, OperationsList& components)
+{
+    OperationsList& oplist = components.at(0)->Operands;
+    
+    for(size_t i=1; i< components.size(); i++)
+    {
+        oplist.push_back(components.at(i));
+    }
+    
+    return components.at(0);
+}
+
+// generated by TestBuilder
+Operation* CollapseByMerge(const CFGRule& rule, OperationsList& components)
+{
+    TEST_Tracer("CollapseByMerge");
+    methodHitMap["CollapseByMerge"]++;
+    if(FunctionInjections.count("CollapseByMerge") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rule));
+    p.push_back(static_cast<const void*>(&components));
+    FunctionInjections["CollapseByMerge"](p);
+    }
+    return CollapseByMerge_INTERNAL(rule, components);
+}
+
+
+Operation* NothingStubOperation();
+
+Operation* NothingStubOperation_INTERNAL()
+{
+    return OperationConstructor(OperationType::Ref, { ReferenceStubConstructor(c_nullStubName) }); 
+}
+
+// generated by TestBuilder
+Operation* NothingStubOperation()
+{
+    TEST_Tracer("NothingStubOperation");
+    methodHitMap["NothingStubOperation"]++;
+    if(FunctionInjections.count("NothingStubOperation") == 1){
+    Params p;
+    FunctionInjections["NothingStubOperation"](p);
+    }
+    return NothingStubOperation_INTERNAL();
+}
+
+
+Operation* CollapseByUnscopedEval(const CFGRule& rule, OperationsList& components);
+
+Operation* CollapseByUnscopedEval_INTERNAL(const CFGRule& rule, OperationsList& components)
+{
+    if(components.size() == 1)
+    {
+        auto op = components[0];
+        components.clear();
+        components.push_back(NothingStubOperation());
+        components.push_back(op);
+    }
+    else
+    {
+        auto op1 = components[0];
+        auto op2 = components[1];
+        
+        components.clear();
+        components.push_back(NothingStubOperation());
+        components.push_back(op1);
+        components.push_back(op2);
+    }
+
+    return OperationConstructor(rule.OpType, components);
+}
+
+// generated by TestBuilder
+Operation* CollapseByUnscopedEval(const CFGRule& rule, OperationsList& components)
+{
+    TEST_Tracer("CollapseByUnscopedEval");
+    methodHitMap["CollapseByUnscopedEval"]++;
+    if(FunctionInjections.count("CollapseByUnscopedEval") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rule));
+    p.push_back(static_cast<const void*>(&components));
+    FunctionInjections["CollapseByUnscopedEval"](p);
+    }
+    return CollapseByUnscopedEval_INTERNAL(rule, components);
+}
+
+
+Operation* CollapseRuleInternal(const CFGRule& rule, OperationsList& components);
+
+Operation* CollapseRuleInternal_INTERNAL(const CFGRule& rule, OperationsList& components)
+{
+    if(rule.ParseMethod == "Reduce")
+    {
+        return CollapseByReduce(rule, components);
+    }
+    else if(rule.ParseMethod == "Retain")
+    {
+        return components.at(0);
+    }
+    else if(rule.ParseMethod == "Merge")
+    {
+        return CollapseByMerge(rule, components);
+    }
+    else if(rule.ParseMethod == "UnscopedEval")
+    {
+        return CollapseByUnscopedEval(rule, components);
+    }
+    else
+    {
+        LogIt(LogSeverityType::Sev1_Notify, "CollapseRule", "unknown collapsing procedure");
+        return nullptr;
+    }
+}
+
+// generated by TestBuilder
+Operation* CollapseRuleInternal(const CFGRule& rule, OperationsList& components)
+{
+    TEST_Tracer("CollapseRuleInternal");
+    methodHitMap["CollapseRuleInternal"]++;
+    if(FunctionInjections.count("CollapseRuleInternal") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rule));
+    p.push_back(static_cast<const void*>(&components));
+    FunctionInjections["CollapseRuleInternal"](p);
+    }
+    return CollapseRuleInternal_INTERNAL(rule, components);
+}
+
+
+void CollapseListByRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule);
+
+void CollapseListByRule_INTERNAL(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
+{
+    OperationsList operands = GetOperandsAndRemoveRule(listHead, listTail, rule);
+    Operation* op = CollapseRuleInternal(rule, operands);
+
+    ParseToken* t = ParseTokenConstructor(rule.FromProductionSymbol);
+    t->Value = op;
+
+    AddToList(listHead, listTail, t);
+}
+
+// generated by TestBuilder
+void CollapseListByRule(ParseToken** listHead, ParseToken** listTail, const CFGRule& rule)
+{
+    TEST_Tracer("CollapseListByRule");
+    methodHitMap["CollapseListByRule"]++;
+    if(FunctionInjections.count("CollapseListByRule") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&rule));
+    FunctionInjections["CollapseListByRule"](p);
+    }
+    CollapseListByRule_INTERNAL(listHead, listTail, rule);
+}
+
+
+void LogParseStack(ParseToken* listHead);
+
+void LogParseStack_INTERNAL(ParseToken* listHead)
+{
+    if(LogAtLevel > LogSeverityType::Sev0_Debug)
+    {
+        return;
+    }
+
+    String Line;
+    for(ParseToken* t = listHead; t != nullptr; t = t->Next)
+    {
+       Line += t->Symbol == NoGrammarSymbol ? "?" : GrammarSymbolNames[t->Symbol];
+       Line += " ";
+    }
+    LogItDebug(Line, "LogParseStack");
+}
+
+// generated by TestBuilder
+void LogParseStack(ParseToken* listHead)
+{
+    TEST_Tracer("LogParseStack");
+    methodHitMap["LogParseStack"]++;
+    if(FunctionInjections.count("LogParseStack") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    FunctionInjections["LogParseStack"](p);
+    }
+    LogParseStack_INTERNAL(listHead);
+}
+
+
+
+void AddRefToken(ParseToken** listHead, ParseToken** listTail, Token* token);
+
+void AddRefToken_INTERNAL(ParseToken** listHead, ParseToken** listTail, Token* token)
+{
+    ParseToken* t = ParseTokenConstructor(RefGrammarSymbol);
+    t->Value = RefOperation(token);
+    AddToList(listHead, listTail, t);
+}
+
+// generated by TestBuilder
+void AddRefToken(ParseToken** listHead, ParseToken** listTail, Token* token)
+{
+    TEST_Tracer("AddRefToken");
+    methodHitMap["AddRefToken"]++;
+    if(FunctionInjections.count("AddRefToken") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["AddRefToken"](p);
+    }
+    AddRefToken_INTERNAL(listHead, listTail, token);
+}
+
+
+void AddSimpleToken(ParseToken** listHead, ParseToken** listTail, Token* token);
+
+void AddSimpleToken_INTERNAL(ParseToken** listHead, ParseToken** listTail, Token* token)
+{
+    ParseToken* t = ParseTokenConstructor(GrammarSymbolOf(token->Content));
+    t->Value = nullptr;
+    AddToList(listHead, listTail, t);
+}
+
+// generated by TestBuilder
+void AddSimpleToken(ParseToken** listHead, ParseToken** listTail, Token* token)
+{
+    TEST_Tracer("AddSimpleToken");
+    methodHitMap["AddSimpleToken"]++;
+    if(FunctionInjections.count("AddSimpleToken") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&token));
+    FunctionInjections["AddSimpleToken"](p);
+    }
+    AddSimpleToken_INTERNAL(listHead, listTail, token);
+}
+
+const std::vector<String> SkippedKeyWords = { "the" };
+const std::vector<String> ReferenceKeyWords = { "caller", "self", "that", "it" };
+
+
+void AddNextTokenToList(ParseToken** listHead, ParseToken** listTail, Token* currentToken);
+
+void AddNextTokenToList_INTERNAL(ParseToken** listHead, ParseToken** listTail, Token* currentToken)
+{
+    if(TokenMatchesType(currentToken, ObjectTokenTypes) || TokenMatchesContent(currentToken, ReferenceKeyWords))
+    {
+        AddRefToken(listHead, listTail, currentToken);
+    }
+    else
+    {
+        if(TokenMatchesContent(currentToken, SkippedKeyWords))
+            return;
+
+        AddSimpleToken(listHead, listTail, currentToken);
+    }
+}
+
+// generated by TestBuilder
+void AddNextTokenToList(ParseToken** listHead, ParseToken** listTail, Token* currentToken)
+{
+    TEST_Tracer("AddNextTokenToList");
+    methodHitMap["AddNextTokenToList"]++;
+    if(FunctionInjections.count("AddNextTokenToList") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&currentToken));
+    FunctionInjections["AddNextTokenToList"](p);
+    }
+    AddNextTokenToList_INTERNAL(listHead, listTail, currentToken);
+}
+
+
+inline bool SymbolsContain(const std::vector<GrammarSymbol>& symbols, GrammarSymbol symbol)
+{
+    return std::find(symbols.begin(), symbols.end(), symbol) != symbols.end();
+}
+
+
+bool CurrentRuleHasHigherPrecedence(const CFGRule& rule, GrammarSymbol lookaheadSymbol, int lookaheadPrecedence);
+
+bool CurrentRuleHasHigherPrecedence_INTERNAL(const CFGRule& rule, GrammarSymbol lookaheadSymbol, int lookaheadPrecedence)
+{
+    if(lookaheadSymbol != NoGrammarSymbol)
+    {
+        if(rule.HasHigherPrecedenceClassOverride && SymbolsContain(rule.HigherPrecedenceSymbols, lookaheadSymbol))
+            return false;
+
+        if(rule.HasLowerPrecedenceClassOverride && SymbolsContain(rule.LowerPrecedenceSymbols, lookaheadSymbol))
+            return true;
+    }
+
+    int currentRulePrecedence = rule.Precedence;
+    return (currentRulePrecedence >= lookaheadPrecedence);
+}
+
+// generated by TestBuilder
+bool CurrentRuleHasHigherPrecedence(const CFGRule& rule, GrammarSymbol lookaheadSymbol, int lookaheadPrecedence)
+{
+    TEST_Tracer("CurrentRuleHasHigherPrecedence");
+    methodHitMap["CurrentRuleHasHigherPrecedence"]++;
+    if(FunctionInjections.count("CurrentRuleHasHigherPrecedence") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rule));
+    p.push_back(static_cast<const void*>(&lookaheadSymbol));
+    p.push_back(static_cast<const void*>(&lookaheadPrecedence));
+    FunctionInjections["CurrentRuleHasHigherPrecedence"](p);
+    }
+    return CurrentRuleHasHigherPrecedence_INTERNAL(rule, lookaheadSymbol, lookaheadPrecedence);
+}
+
+
+void TryReversingGrammarRules(ParseToken** listHead, ParseToken** listTail, Token* lookaheadToken);
+
+void TryReversingGrammarRules_INTERNAL(ParseToken** listHead, ParseToken** listTail, Token* lookaheadToken)
+{
+    GrammarSymbol lookaheadSymbol = NoGrammarSymbol;
+    int lookaheadPrecedence = 0;
+    if(lookaheadToken != nullptr)
+    {
+        lookaheadSymbol = GrammarSymbolOf(lookaheadToken->Content);
+        lookaheadPrecedence = PrecedenceOfSymbol(lookaheadSymbol);
+    }
+
+    while(const CFGRule* match = MatchGrammarPatterns(*listTail))
+    {
+        if(CurrentRuleHasHigherPrecedence(*match, lookaheadSymbol, lookaheadPrecedence))
+        {
+            CollapseListByRule(listHead, listTail, *match);
+        }
+        else
+        {
+            break;
+        }
+        LogParseStack(*listHead);
+    }
+}
+
+// generated by TestBuilder
+void TryReversingGrammarRules(ParseToken** listHead, ParseToken** listTail, Token* lookaheadToken)
+{
+    TEST_Tracer("TryReversingGrammarRules");
+    methodHitMap["TryReversingGrammarRules"]++;
+    if(FunctionInjections.count("TryReversingGrammarRules") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&listHead));
+    p.push_back(static_cast<const void*>(&listTail));
+    p.push_back(static_cast<const void*>(&lookaheadToken));
+    FunctionInjections["TryReversingGrammarRules"](p);
+    }
+    TryReversingGrammarRules_INTERNAL(listHead, listTail, lookaheadToken);
+}
+
+
+bool PositionMatchesPreprocessorRule(TokenList& list, size_t startPos, PreprocessorRule** matchedRule);
+
+bool PositionMatchesPreprocessorRule_INTERNAL(TokenList& list, size_t startPos, PreprocessorRule** matchedRule)
+{
+    PreprocessorRule* longestMatch = nullptr;
+    for(auto& rule: PreprocessorRules)
+    {
+        if(list.size() < rule.Pattern.size() + startPos)
+        {
+            continue;
+        }
+
+        bool ruleMatches = true;
+        for(size_t i=0; i<rule.Pattern.size(); i++)
+        {
+            if(rule.Pattern[i] != list[startPos + i]->Content)
+            {
+                ruleMatches = false;
+                break;
+            }
+        }
+
+        if(ruleMatches)
+        {
+            if(longestMatch == nullptr)
+            {
+                longestMatch = &rule;
+            }
+            else
+            {
+                if(longestMatch->Pattern.size() < rule.Pattern.size())
+                {
+                    longestMatch = &rule;
+                }
+            }
+        }
+    }
+
+    if(longestMatch != nullptr)
+    {
+        *matchedRule = longestMatch;
+        return true;
+    }
+
+    return false;
+}
+
+// generated by TestBuilder
+bool PositionMatchesPreprocessorRule(TokenList& list, size_t startPos, PreprocessorRule** matchedRule)
+{
+    TEST_Tracer("PositionMatchesPreprocessorRule");
+    methodHitMap["PositionMatchesPreprocessorRule"]++;
+    if(FunctionInjections.count("PositionMatchesPreprocessorRule") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&list));
+    p.push_back(static_cast<const void*>(&startPos));
+    p.push_back(static_cast<const void*>(&matchedRule));
+    FunctionInjections["PositionMatchesPreprocessorRule"](p);
+    }
+    return PositionMatchesPreprocessorRule_INTERNAL(list, startPos, matchedRule);
+}
+
+
+TokenList Preprocess(TokenList& list, TokenArena& arena);
+
+TokenList Preprocess_INTERNAL(TokenList& list, TokenArena& arena)
+{
+    TokenList processedList;
+    int newListIndex = 0;
+    for(size_t i=0; i<list.size(); i++)
+    {
+        PreprocessorRule* rule = nullptr;
+        if(PositionMatchesPreprocessorRule(list, i, &rule))
+        {
+            processedList.push_back(TokenConstructor(arena, TokenType::Simple, rule->Becomes, newListIndex));
+            i += rule->Pattern.size() - 1;
+        }
+        else
+        {
+            auto t = list[i];
+            t->Position = newListIndex;
+            processedList.push_back(t);
+        }
+
+        newListIndex++;
+    }
+
+    return processedList;
+}
+
+// generated by TestBuilder
+TokenList Preprocess(TokenList& list, TokenArena& arena)
+{
+    TEST_Tracer("Preprocess");
+    methodHitMap["Preprocess"]++;
+    if(FunctionInjections.count("Preprocess") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&list));
+    p.push_back(static_cast<const void*>(&arena));
+    FunctionInjections["Preprocess"](p);
+    }
+    return Preprocess_INTERNAL(list, arena);
+}
+
+
+Operation* ParseExpression(TokenList& rawline, bool& isSyntaxError);
+
+Operation* ParseExpression_INTERNAL(TokenList& rawline, bool& isSyntaxError)
+{
+    ParseToken* listHead = nullptr;
+    ParseToken* listTail = nullptr;
+
+    TokenArena preprocessedTokens;
+    TokenList line = Preprocess(rawline, preprocessedTokens);
+    LogDiagnostics(line);
+
+    int pos = 0;
+    while(static_cast<size_t>(pos) < line.size())
+    {
+        Token* currentToken = line.at(pos);
+        AddNextTokenToList(&listHead, &listTail, currentToken);
+
+        LogParseStack(listHead);
+
+        Token* lookaheadToken = nullptr;
+        if(static_cast<size_t>(pos+1) < line.size())
+            lookaheadToken = line.at(pos+1);
+
+        TryReversingGrammarRules(&listHead, &listTail, lookaheadToken);
+
+        pos++;
+    }
+
+    if(listHead != listTail || listHead == nullptr)
+    {
+        DestroyList(listHead);
+        isSyntaxError = true;
+        return nullptr;
+    }
+
+    auto ast = listHead->Value;
+    DestroyList(listHead);
+
+    isSyntaxError = false;
+    return ast;
+}
+
+// generated by TestBuilder
+Operation* ParseExpression(TokenList& rawline, bool& isSyntaxError)
+{
+    TEST_Tracer("ParseExpression");
+    methodHitMap["ParseExpression"]++;
+    if(FunctionInjections.count("ParseExpression") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rawline));
+    p.push_back(static_cast<const void*>(&isSyntaxError));
+    FunctionInjections["ParseExpression"](p);
+    }
+    return ParseExpression_INTERNAL(rawline, isSyntaxError);
+}
+
+
+Operation* ExpressionParser(TokenList& rawline);
+
+Operation* ExpressionParser_INTERNAL(TokenList& rawline)
+{
+    bool isSyntaxError = false;
+    Operation* ast = ParseExpression(rawline, isSyntaxError);
+    if(isSyntaxError)
+    {
+        ReportCompileMsg(SystemMessageType::Exception, "syntax error");
+        FatalCompileError = true;
+    }
+
+    return ast;
+}
+
+// generated by TestBuilder
+Operation* ExpressionParser(TokenList& rawline)
+{
+    TEST_Tracer("ExpressionParser");
+    methodHitMap["ExpressionParser"]++;
+    if(FunctionInjections.count("ExpressionParser") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&rawline));
+    FunctionInjections["ExpressionParser"](p);
+    }
+    return ExpressionParser_INTERNAL(rawline);
+}
+
+
+void InitParser();
+
+void InitParser_INTERNAL()
+{
+    ConstantPrimitiveObjects.clear();
+    ConstantPrimitiveObjects.reserve(64);
+    ConstantPrimitiveIndex.clear();
+}
+
+// generated by TestBuilder
+void InitParser()
+{
+    TEST_Tracer("InitParser");
+    methodHitMap["InitParser"]++;
+    if(FunctionInjections.count("InitParser") == 1){
+    Params p;
+    FunctionInjections["InitParser"](p);
+    }
+    InitParser_INTERNAL();
+}
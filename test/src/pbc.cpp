@@ -0,0 +1,372 @@
+#include "test.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+#include "pbc.h"
+
+#include "vm.h"
+#include "bytecode.h"
+#include "errormsg.h"
+#include "call.h"
+#include "mappedfile.h"
+
+
+bool g_cacheOn = false;
+
+static const BindingType PbcTypes[] =
+{
+    &NothingType, &IntegerType, &DecimalType, &StringType, &BooleanType, &MethodType
+};
+
+constexpr size_t NumberOfPbcTypes = sizeof(PbcTypes) / sizeof(PbcTypes[0]);
+
+
+
+
+uint64_t HashOfFile(const String& file);
+
+uint64_t HashOfFile_INTERNAL(const String& file)
+{
+    MappedFile contents;
+    if(!OpenMappedFile(file, contents))
+    {
+        return 0;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325;
+    for(size_t i=0; i<contents.Size; i++)
+    {
+        hash ^= static_cast<unsigned char>(contents.Data[i]);
+        hash *= 0x100000001b3;
+    }
+
+    CloseMappedFile(contents);
+    return hash;
+}
+
+// generated by TestBuilder
+uint64_t HashOfFile(const String& file)
+{
+    TEST_Tracer("HashOfFile");
+    methodHitMap["HashOfFile"]++;
+    if(FunctionInjections.count("HashOfFile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&file));
+    FunctionInjections["HashOfFile"](p);
+    }
+    return HashOfFile_INTERNAL(file);
+}
+
+
+
+
+template <typename T>
+inline void AppendTable(std::vector<char>& out, const T* data, size_t count)
+{
+    auto bytes = reinterpret_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+
+inline PbcString AddPbcString(std::vector<char>& strings, const String& str)
+{
+    PbcString pbcString = { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(str.size()) };
+    strings.insert(strings.end(), str.begin(), str.end());
+    return pbcString;
+}
+
+
+PbcPrimitive PbcPrimitiveFor(const Call* call, std::vector<char>& strings)
+{
+    PbcPrimitive primitive;
+    std::memset(&primitive, 0, sizeof(primitive));
+
+    for(size_t i=0; i<NumberOfPbcTypes; i++)
+    {
+        if(call->BoundType == PbcTypes[i])
+        {
+            primitive.Type = i;
+        }
+    }
+
+    if(call->BoundType == &IntegerType) primitive.Integer = call->BoundValue.i;
+    else if(call->BoundType == &DecimalType) primitive.Decimal = call->BoundValue.d;
+    else if(call->BoundType == &StringType) primitive.Text = AddPbcString(strings, *call->BoundValue.s);
+    else if(call->BoundType == &BooleanType) primitive.Boolean = call->BoundValue.b;
+
+    return primitive;
+}
+
+
+String PrecompiledFileFor(const String& sourceFile);
+
+String PrecompiledFileFor_INTERNAL(const String& sourceFile)
+{
+    auto extension = sourceFile.rfind(".pebl");
+    if(extension != String::npos && extension + 5 == sourceFile.size())
+    {
+        return sourceFile.substr(0, extension) + ".pbc";
+    }
+    return sourceFile + ".pbc";
+}
+
+// generated by TestBuilder
+String PrecompiledFileFor(const String& sourceFile)
+{
+    TEST_Tracer("PrecompiledFileFor");
+    methodHitMap["PrecompiledFileFor"]++;
+    if(FunctionInjections.count("PrecompiledFileFor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&sourceFile));
+    FunctionInjections["PrecompiledFileFor"](p);
+    }
+    return PrecompiledFileFor_INTERNAL(sourceFile);
+}
+
+
+bool WritePrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile, Program* p);
+
+bool WritePrecompiledProgram_INTERNAL(PebbleVM* vm, const String& pbcFile, const String& sourceFile, Program* p)
+{
+    PbcHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.Magic = PbcMagic;
+    header.Version = PbcVersion;
+    header.SourceHash = HashOfFile(sourceFile);
+    header.NumberOfInstructionIds = BCI_NumberOfInstructions;
+    header.NumberOfInstructions = vm->ByteCodeProgram.size();
+    header.NumberOfCallNames = vm->CallNames.size();
+    header.NumberOfPrimitives = vm->ConstPrimitives.size();
+    header.NumberOfSlots = vm->LocalSlots.size();
+    header.NumberOfLineAssociations = vm->ByteCodeLineAssociation.size();
+    header.NumberOfLines = p->Lines.size();
+
+    std::vector<char> strings;
+
+    std::vector<ByteCodeInstruction> instructions(vm->ByteCodeProgram.size());
+    std::memset(instructions.data(), 0, instructions.size() * sizeof(ByteCodeInstruction));
+    for(size_t i=0; i<vm->ByteCodeProgram.size(); i++)
+    {
+        instructions[i].Op = vm->ByteCodeProgram[i].Op;
+        instructions[i].Arg = vm->ByteCodeProgram[i].Arg;
+    }
+
+    std::vector<PbcString> callNames;
+    for(auto& name: vm->CallNames)
+    {
+        callNames.push_back(AddPbcString(strings, name));
+    }
+
+    std::vector<PbcPrimitive> primitives;
+    for(auto call: vm->ConstPrimitives)
+    {
+        primitives.push_back(PbcPrimitiveFor(call, strings));
+    }
+
+    std::vector<int32_t> lines;
+    for(auto& line: p->Lines)
+    {
+        lines.push_back(line.LineNumber);
+    }
+
+    header.StringsSize = strings.size();
+
+    std::vector<char> out;
+    AppendTable(out, &header, 1);
+    AppendTable(out, instructions.data(), instructions.size());
+    AppendTable(out, callNames.data(), callNames.size());
+    AppendTable(out, primitives.data(), primitives.size());
+    AppendTable(out, vm->LocalSlots.data(), vm->LocalSlots.size());
+    AppendTable(out, vm->ByteCodeLineAssociation.data(), vm->ByteCodeLineAssociation.size());
+    AppendTable(out, lines.data(), lines.size());
+    AppendTable(out, strings.data(), strings.size());
+
+    std::ofstream file(pbcFile, std::ios::binary | std::ios::trunc);
+    if(!file)
+    {
+        return false;
+    }
+
+    file.write(out.data(), out.size());
+    return file.good();
+}
+
+// generated by TestBuilder
+bool WritePrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile, Program* p)
+{
+    TEST_Tracer("WritePrecompiledProgram");
+    methodHitMap["WritePrecompiledProgram"]++;
+    if(FunctionInjections.count("WritePrecompiledProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&pbcFile));
+    p.push_back(static_cast<const void*>(&sourceFile));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["WritePrecompiledProgram"](p);
+    }
+    return WritePrecompiledProgram_INTERNAL(vm, pbcFile, sourceFile, p);
+}
+
+
+
+
+bool ReadPrecompiledTables(const MappedFile& contents, uint64_t sourceHash, AotProgram& aot);
+
+bool ReadPrecompiledTables_INTERNAL(const MappedFile& contents, uint64_t sourceHash, AotProgram& aot)
+{
+    if(contents.Size < sizeof(PbcHeader))
+    {
+        return false;
+    }
+
+    PbcHeader header;
+    std::memcpy(&header, contents.Data, sizeof(header));
+    if(header.Magic != PbcMagic || header.Version != PbcVersion || header.SourceHash != sourceHash
+        || header.NumberOfInstructionIds != BCI_NumberOfInstructions)
+    {
+        return false;
+    }
+
+    uint64_t expectedSize = sizeof(PbcHeader)
+        + header.NumberOfInstructions * sizeof(ByteCodeInstruction)
+        + header.NumberOfCallNames * sizeof(PbcString)
+        + header.NumberOfPrimitives * sizeof(PbcPrimitive)
+        + header.NumberOfSlots * sizeof(LocalSlot)
+        + header.NumberOfLineAssociations * sizeof(extArg_t)
+        + header.NumberOfLines * sizeof(int32_t)
+        + header.StringsSize;
+    if(expectedSize != contents.Size)
+    {
+        return false;
+    }
+
+    const char* at = contents.Data + sizeof(PbcHeader);
+
+    auto instructions = reinterpret_cast<const ByteCodeInstruction*>(at);
+    aot.Instructions.assign(instructions, instructions + header.NumberOfInstructions);
+    at += header.NumberOfInstructions * sizeof(ByteCodeInstruction);
+
+    auto callNames = reinterpret_cast<const PbcString*>(at);
+    at += header.NumberOfCallNames * sizeof(PbcString);
+
+    auto primitives = reinterpret_cast<const PbcPrimitive*>(at);
+    at += header.NumberOfPrimitives * sizeof(PbcPrimitive);
+
+    auto slots = reinterpret_cast<const LocalSlot*>(at);
+    aot.Slots.assign(slots, slots + header.NumberOfSlots);
+    at += header.NumberOfSlots * sizeof(LocalSlot);
+
+    auto lineAssociation = reinterpret_cast<const extArg_t*>(at);
+    aot.LineAssociation.assign(lineAssociation, lineAssociation + header.NumberOfLineAssociations);
+    at += header.NumberOfLineAssociations * sizeof(extArg_t);
+
+    auto lines = reinterpret_cast<const int32_t*>(at);
+    aot.LineNumbers.assign(lines, lines + header.NumberOfLines);
+    at += header.NumberOfLines * sizeof(int32_t);
+
+    const char* strings = at;
+    auto readString = [&](const PbcString& str, String& into)
+    {
+        if(uint64_t(str.Offset) + str.Length > header.StringsSize)
+        {
+            return false;
+        }
+        into.assign(strings + str.Offset, str.Length);
+        return true;
+    };
+
+    aot.CallNames.resize(header.NumberOfCallNames);
+    for(size_t i=0; i<header.NumberOfCallNames; i++)
+    {
+        if(!readString(callNames[i], aot.CallNames[i]))
+        {
+            return false;
+        }
+    }
+
+    aot.Primitives.resize(header.NumberOfPrimitives);
+    for(size_t i=0; i<header.NumberOfPrimitives; i++)
+    {
+        auto& primitive = primitives[i];
+        auto& loaded = aot.Primitives[i];
+        if(primitive.Type >= NumberOfPbcTypes || !readString(primitive.Text, loaded.Text))
+        {
+            return false;
+        }
+
+        loaded.Type = PbcTypes[primitive.Type];
+        loaded.Integer = primitive.Integer;
+        loaded.Decimal = primitive.Decimal;
+        loaded.Boolean = primitive.Boolean;
+    }
+
+    for(auto& ins: aot.Instructions)
+    {
+        if(ins.Op >= BCI_NumberOfInstructions)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// generated by TestBuilder
+bool ReadPrecompiledTables(const MappedFile& contents, uint64_t sourceHash, AotProgram& aot)
+{
+    TEST_Tracer("ReadPrecompiledTables");
+    methodHitMap["ReadPrecompiledTables"]++;
+    if(FunctionInjections.count("ReadPrecompiledTables") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&contents));
+    p.push_back(static_cast<const void*>(&sourceHash));
+    p.push_back(static_cast<const void*>(&aot));
+    FunctionInjections["ReadPrecompiledTables"](p);
+    }
+    return ReadPrecompiledTables_INTERNAL(contents, sourceHash, aot);
+}
+
+
+Program* LoadPrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile);
+
+Program* LoadPrecompiledProgram_INTERNAL(PebbleVM* vm, const String& pbcFile, const String& sourceFile)
+{
+    uint64_t sourceHash = HashOfFile(sourceFile);
+    if(sourceHash == 0)
+    {
+        return nullptr;
+    }
+
+    MappedFile contents;
+    if(!OpenMappedFile(pbcFile, contents))
+    {
+        return nullptr;
+    }
+
+    AotProgram aot;
+    bool isValid = ReadPrecompiledTables(contents, sourceHash, aot);
+    CloseMappedFile(contents);
+
+    if(!isValid)
+    {
+        return nullptr;
+    }
+
+    return LoadProgramTables(vm, aot);
+}
+
+// generated by TestBuilder
+Program* LoadPrecompiledProgram(PebbleVM* vm, const String& pbcFile, const String& sourceFile)
+{
+    TEST_Tracer("LoadPrecompiledProgram");
+    methodHitMap["LoadPrecompiledProgram"]++;
+    if(FunctionInjections.count("LoadPrecompiledProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&pbcFile));
+    p.push_back(static_cast<const void*>(&sourceFile));
+    FunctionInjections["LoadPrecompiledProgram"](p);
+    }
+    return LoadPrecompiledProgram_INTERNAL(vm, pbcFile, sourceFile);
+}
@@ -0,0 +1,228 @@
+#include "test.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+#include "profile.h"
+
+#include "vm.h"
+#include "dis.h"
+
+
+bool g_profileOpsOn = false;
+
+constexpr size_t ReportedPairs = 30;
+
+
+void StartInstructionProfile(PebbleVM* vm);
+
+void StartInstructionProfile_INTERNAL(PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    profile.Counts.assign(OP_NumberOfInstructions, 0);
+    profile.Nanoseconds.assign(OP_NumberOfInstructions, 0);
+    profile.PairCounts.assign(OP_NumberOfInstructions * OP_NumberOfInstructions, 0);
+    profile.PairNanoseconds.assign(OP_NumberOfInstructions * OP_NumberOfInstructions, 0);
+    profile.CurrentOp = NoProfiledOp;
+    profile.PreviousOp = NoProfiledOp;
+}
+
+// generated by TestBuilder
+void StartInstructionProfile(PebbleVM* vm)
+{
+    TEST_Tracer("StartInstructionProfile");
+    methodHitMap["StartInstructionProfile"]++;
+    if(FunctionInjections.count("StartInstructionProfile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["StartInstructionProfile"](p);
+    }
+    StartInstructionProfile_INTERNAL(vm);
+}
+
+
+void FinishInstructionProfile(PebbleVM* vm);
+
+void FinishInstructionProfile_INTERNAL(PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    EndProfiledInstruction(profile, std::chrono::steady_clock::now());
+    profile.CurrentOp = NoProfiledOp;
+    profile.PreviousOp = NoProfiledOp;
+}
+
+// generated by TestBuilder
+void FinishInstructionProfile(PebbleVM* vm)
+{
+    TEST_Tracer("FinishInstructionProfile");
+    methodHitMap["FinishInstructionProfile"]++;
+    if(FunctionInjections.count("FinishInstructionProfile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["FinishInstructionProfile"](p);
+    }
+    FinishInstructionProfile_INTERNAL(vm);
+}
+
+
+
+
+double PercentOf(uint64_t part, uint64_t whole);
+
+double PercentOf_INTERNAL(uint64_t part, uint64_t whole)
+{
+    return whole > 0 ? 100.0 * part / whole : 0;
+}
+
+// generated by TestBuilder
+double PercentOf(uint64_t part, uint64_t whole)
+{
+    TEST_Tracer("PercentOf");
+    methodHitMap["PercentOf"]++;
+    if(FunctionInjections.count("PercentOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&part));
+    p.push_back(static_cast<const void*>(&whole));
+    FunctionInjections["PercentOf"](p);
+    }
+    return PercentOf_INTERNAL(part, whole);
+}
+
+
+void ReportProfileRow(const String& name, uint64_t count, uint64_t totalCount,
+    uint64_t nanoseconds, uint64_t totalNanoseconds);
+
+void ReportProfileRow_INTERNAL(const String& name, uint64_t count, uint64_t totalCount,
+    uint64_t nanoseconds, uint64_t totalNanoseconds)
+{
+    char row[256];
+    std::snprintf(row, sizeof(row), "  %-40s %12llu %6.2f%% %12.6f %6.2f%% %10.1f\n", name.c_str(),
+        static_cast<unsigned long long>(count), PercentOf(count, totalCount), nanoseconds / 1e9,
+        PercentOf(nanoseconds, totalNanoseconds), count > 0 ? static_cast<double>(nanoseconds) / count : 0);
+    std::cerr << row;
+}
+
+// generated by TestBuilder
+void ReportProfileRow(const String& name, uint64_t count, uint64_t totalCount,
+    uint64_t nanoseconds, uint64_t totalNanoseconds)
+{
+    TEST_Tracer("ReportProfileRow");
+    methodHitMap["ReportProfileRow"]++;
+    if(FunctionInjections.count("ReportProfileRow") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&count));
+    p.push_back(static_cast<const void*>(&totalCount));
+    p.push_back(static_cast<const void*>(&nanoseconds));
+    p.push_back(static_cast<const void*>(&totalNanoseconds));
+    FunctionInjections["ReportProfileRow"](p);
+    }
+    ReportProfileRow_INTERNAL(name, count, totalCount, nanoseconds, totalNanoseconds);
+}
+
+
+void ReportProfileHeader(const String& name);
+
+void ReportProfileHeader_INTERNAL(const String& name)
+{
+    char header[256];
+    std::snprintf(header, sizeof(header), "  %-40s %12s %7s %12s %7s %10s\n", name.c_str(),
+        "count", "", "secs", "", "ns/op");
+    std::cerr << header;
+}
+
+// generated by TestBuilder
+void ReportProfileHeader(const String& name)
+{
+    TEST_Tracer("ReportProfileHeader");
+    methodHitMap["ReportProfileHeader"]++;
+    if(FunctionInjections.count("ReportProfileHeader") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    FunctionInjections["ReportProfileHeader"](p);
+    }
+    ReportProfileHeader_INTERNAL(name);
+}
+
+
+void ReportInstructionProfile(const PebbleVM* vm);
+
+void ReportInstructionProfile_INTERNAL(const PebbleVM* vm)
+{
+    auto& profile = vm->OpProfile;
+    if(profile.Counts.empty())
+    {
+        return;
+    }
+
+    uint64_t totalCount = 0;
+    uint64_t totalNanoseconds = 0;
+    std::vector<uint8_t> ops;
+    for(uint8_t op=0; op<OP_NumberOfInstructions; op++)
+    {
+        totalCount += profile.Counts[op];
+        totalNanoseconds += profile.Nanoseconds[op];
+        if(profile.Counts[op] > 0)
+        {
+            ops.push_back(op);
+        }
+    }
+
+    std::sort(ops.begin(), ops.end(), [&profile](uint8_t a, uint8_t b)
+    {
+        return profile.Nanoseconds[a] > profile.Nanoseconds[b];
+    });
+
+    std::cerr << "instructions executed: " << totalCount << " in " << totalNanoseconds / 1e9 << " secs\n\n";
+    ReportProfileHeader("instruction");
+    for(auto op: ops)
+    {
+        ReportProfileRow(InstructionName(op), profile.Counts[op], totalCount,
+            profile.Nanoseconds[op], totalNanoseconds);
+    }
+
+    uint64_t totalPairs = 0;
+    std::vector<size_t> pairs;
+    for(size_t pair=0; pair<profile.PairCounts.size(); pair++)
+    {
+        totalPairs += profile.PairCounts[pair];
+        if(profile.PairCounts[pair] > 0)
+        {
+            pairs.push_back(pair);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end(), [&profile](size_t a, size_t b)
+    {
+        return profile.PairCounts[a] > profile.PairCounts[b];
+    });
+
+    std::cerr << "\n";
+    ReportProfileHeader("previous instruction -> instruction");
+    for(size_t i=0; i<pairs.size() && i<ReportedPairs; i++)
+    {
+        auto pair = pairs[i];
+        auto name = InstructionName(pair / OP_NumberOfInstructions) + " -> "
+            + InstructionName(pair % OP_NumberOfInstructions);
+        ReportProfileRow(name, profile.PairCounts[pair], totalPairs,
+            profile.PairNanoseconds[pair], totalNanoseconds);
+    }
+
+    if(pairs.size() > ReportedPairs)
+    {
+        std::cerr << "  (" << pairs.size() - ReportedPairs << " more pairs)\n";
+    }
+}
+
+// generated by TestBuilder
+void ReportInstructionProfile(const PebbleVM* vm)
+{
+    TEST_Tracer("ReportInstructionProfile");
+    methodHitMap["ReportInstructionProfile"]++;
+    if(FunctionInjections.count("ReportInstructionProfile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ReportInstructionProfile"](p);
+    }
+    ReportInstructionProfile_INTERNAL(vm);
+}
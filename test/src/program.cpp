@@ -0,0 +1,779 @@
+#include "test.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "main.h"
+#include "program.h"
+#include "token.h"
+#include "diagnostics.h"
+#include "operation.h"
+#include "reference.h"
+#include "decision.h"
+#include "parse.h"
+#include "object.h"
+#include "scope.h"
+#include "executable.h"
+
+Program* PROGRAM;
+
+bool override = true;
+
+std::string ProgramOutput;
+std::string ProgramMsgs;
+
+std::vector<SystemMessage> RuntimeMsgBuffer;
+std::vector<SystemMessage> CompileMsgBuffer;
+
+bool RuntimeMsgFlag = false;
+bool CompileMsgFlag = false;
+
+bool FatalCompileError = false;
+
+int RuntimeMsgCount = 0;
+int CompileMsgCount = 0;
+
+
+void ReportRuntimeMsg(SystemMessageType type, String message);
+
+void ReportRuntimeMsg_INTERNAL(SystemMessageType type, String message)
+{
+    SystemMessage msg { message, type };
+    RuntimeMsgBuffer.push_back(msg);
+    RuntimeMsgFlag = true;
+    RuntimeMsgCount++;
+}
+
+// generated by TestBuilder
+void ReportRuntimeMsg(SystemMessageType type, String message)
+{
+    TEST_Tracer("ReportRuntimeMsg");
+    methodHitMap["ReportRuntimeMsg"]++;
+    if(FunctionInjections.count("ReportRuntimeMsg") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&message));
+    FunctionInjections["ReportRuntimeMsg"](p);
+    }
+    ReportRuntimeMsg_INTERNAL(type, message);
+}
+
+
+void ReportCompileMsg(SystemMessageType type, String message);
+
+void ReportCompileMsg_INTERNAL(SystemMessageType type, String message)
+{
+    SystemMessage msg { message, type };
+    CompileMsgBuffer.push_back(msg);
+    CompileMsgFlag = true;
+    CompileMsgCount++;
+}
+
+// generated by TestBuilder
+void ReportCompileMsg(SystemMessageType type, String message)
+{
+    TEST_Tracer("ReportCompileMsg");
+    methodHitMap["ReportCompileMsg"]++;
+    if(FunctionInjections.count("ReportCompileMsg") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&message));
+    FunctionInjections["ReportCompileMsg"](p);
+    }
+    ReportCompileMsg_INTERNAL(type, message);
+}
+
+
+
+
+
+
+void Reset();
+
+void Reset_INTERNAL()
+{
+    ProgramOutput.clear();
+    ProgramMsgs.clear();
+    RuntimeMsgBuffer.clear();
+    CompileMsgBuffer.clear();
+    RuntimeMsgFlag = false;
+    CompileMsgFlag = false;
+    FatalCompileError = false;
+    RuntimeMsgCount = 0;
+    CompileMsgCount = 0;
+}
+
+// generated by TestBuilder
+void Reset()
+{
+    TEST_Tracer("Reset");
+    methodHitMap["Reset"]++;
+    if(FunctionInjections.count("Reset") == 1){
+    Params p;
+    FunctionInjections["Reset"](p);
+    }
+    Reset_INTERNAL();
+}
+
+
+Program* ProgramConstructor();
+
+Program* ProgramConstructor_INTERNAL()
+{
+    Program* p = new Program;
+    p->GlobalScope = ScopeConstructor(p->ScopeSlab, nullptr);
+    p->GlobalScope->IsDurable = true;
+    p->Main = nullptr;
+    p->That = nullptr;
+
+    return p;
+}
+
+// generated by TestBuilder
+Program* ProgramConstructor()
+{
+    TEST_Tracer("ProgramConstructor");
+    methodHitMap["ProgramConstructor"]++;
+    if(FunctionInjections.count("ProgramConstructor") == 1){
+    Params p;
+    FunctionInjections["ProgramConstructor"](p);
+    }
+    return ProgramConstructor_INTERNAL();
+}
+
+
+
+
+
+
+
+
+char LastNonWhitespaceChar(String& line);
+
+char LastNonWhitespaceChar_INTERNAL(String& line)
+{
+    int i = line.size();
+    while (i--, i >= 0 && line.at(i) == ' ');
+    return (i >= 0 ? line.at(i) : '\0');
+}
+
+// generated by TestBuilder
+char LastNonWhitespaceChar(String& line)
+{
+    TEST_Tracer("LastNonWhitespaceChar");
+    methodHitMap["LastNonWhitespaceChar"]++;
+    if(FunctionInjections.count("LastNonWhitespaceChar") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&line));
+    FunctionInjections["LastNonWhitespaceChar"](p);
+    }
+    return LastNonWhitespaceChar_INTERNAL(line);
+}
+
+
+String RemoveCommas(String line);
+
+String RemoveCommas_INTERNAL(String line)
+{
+    String returnString = "";
+    for(size_t i=0; i<line.size(); i++)
+    {
+        if(line.at(i) == ',')
+            continue;
+        returnString += line.at(i);
+    }
+    
+    return returnString;
+}
+
+// generated by TestBuilder
+String RemoveCommas(String line)
+{
+    TEST_Tracer("RemoveCommas");
+    methodHitMap["RemoveCommas"]++;
+    if(FunctionInjections.count("RemoveCommas") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&line));
+    FunctionInjections["RemoveCommas"](p);
+    }
+    return RemoveCommas_INTERNAL(line);
+}
+
+String g_tabString;
+
+
+bool IsTabCharacter(char c);
+
+bool IsTabCharacter_INTERNAL(char c)
+{
+    return c == '\t' || c == ' ';
+}
+
+// generated by TestBuilder
+bool IsTabCharacter(char c)
+{
+    TEST_Tracer("IsTabCharacter");
+    methodHitMap["IsTabCharacter"]++;
+    if(FunctionInjections.count("IsTabCharacter") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&c));
+    FunctionInjections["IsTabCharacter"](p);
+    }
+    return IsTabCharacter_INTERNAL(c);
+}
+
+
+int LevelOfIndentation(std::string_view indentation)
+{
+    if(indentation.empty())
+        return 0;
+
+    if(g_tabString.empty() || indentation.size() % g_tabString.size() != 0)
+        return -1;
+
+    for(size_t i=0; i<indentation.size(); i+=g_tabString.size())
+    {
+        if(indentation.compare(i, g_tabString.size(), g_tabString) != 0)
+            return -1;
+    }
+
+    return indentation.size() / g_tabString.size();
+}
+
+struct SourceLine
+{
+    std::string_view Text;
+    int LineNumber;
+    int Level;
+};
+
+
+std::vector<SourceLine> ScanSourceLines(std::string_view source)
+{
+    std::vector<SourceLine> lines;
+    int lineNumber = 0;
+    size_t position = 0;
+    while(position < source.size())
+    {
+        auto start = source.data() + position;
+        auto end = static_cast<const char*>(std::memchr(start, '\n', source.size() - position));
+        size_t length = end == nullptr ? source.size() - position : end - start;
+
+        auto line = source.substr(position, length);
+        position += length + 1;
+        lineNumber++;
+
+        size_t indent = 0;
+        while(indent < line.size() && IsTabCharacter(line[indent]))
+            indent++;
+
+        if(indent == line.size() || line[indent] == '#')
+            continue;
+
+        auto indentation = line.substr(0, indent);
+        if(g_tabString.empty())
+            g_tabString = indentation;
+
+        SourceLine sourceLine = { line, lineNumber, LevelOfIndentation(indentation) };
+        lines.push_back(sourceLine);
+    }
+
+    return lines;
+}
+
+
+
+Operation* ParseOutAtomic(PossibleOperationsList& typeProbabilities, TokenList& tokens);
+
+Operation* ParseOutAtomic_INTERNAL(PossibleOperationsList& typeProbabilities, TokenList& tokens)
+{
+    return nullptr;
+
+
+
+
+}
+
+// generated by TestBuilder
+Operation* ParseOutAtomic(PossibleOperationsList& typeProbabilities, TokenList& tokens)
+{
+    TEST_Tracer("ParseOutAtomic");
+    methodHitMap["ParseOutAtomic"]++;
+    if(FunctionInjections.count("ParseOutAtomic") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&typeProbabilities));
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseOutAtomic"](p);
+    }
+    return ParseOutAtomic_INTERNAL(typeProbabilities, tokens);
+}
+
+
+Operation* ParseComposite(PossibleOperationsList& typeProbabilities, TokenList& tokens);
+
+Operation* ParseComposite_INTERNAL(PossibleOperationsList& typeProbabilities, TokenList& tokens)
+{
+    Operation* op = ExpressionParser(tokens);
+    return op;
+}
+
+// generated by TestBuilder
+Operation* ParseComposite(PossibleOperationsList& typeProbabilities, TokenList& tokens)
+{
+    TEST_Tracer("ParseComposite");
+    methodHitMap["ParseComposite"]++;
+    if(FunctionInjections.count("ParseComposite") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&typeProbabilities));
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseComposite"](p);
+    }
+    return ParseComposite_INTERNAL(typeProbabilities, tokens);
+}
+
+
+Operation* ParseIf(PossibleOperationsList& typeProbabilityes, TokenList& tokens);
+
+Operation* ParseIf_INTERNAL(PossibleOperationsList& typeProbabilityes, TokenList& tokens)
+{
+
+    TokenList newList;
+    newList = RightOfToken(tokens, FindToken(tokens, "if"));
+    newList = LeftOfToken(newList, FindToken(newList, ":"));
+
+    LogDiagnostics(newList, "printing token list after removing if stuff");
+
+    Operation* condition = ParseLine(newList);
+    Operation* op = OperationConstructor(OperationType::If, { condition });
+
+    return op;
+}
+
+// generated by TestBuilder
+Operation* ParseIf(PossibleOperationsList& typeProbabilityes, TokenList& tokens)
+{
+    TEST_Tracer("ParseIf");
+    methodHitMap["ParseIf"]++;
+    if(FunctionInjections.count("ParseIf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&typeProbabilityes));
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseIf"](p);
+    }
+    return ParseIf_INTERNAL(typeProbabilityes, tokens);
+}
+
+
+Operation* ParseWhile(PossibleOperationsList& typeProbabilityes, TokenList& tokens);
+
+Operation* ParseWhile_INTERNAL(PossibleOperationsList& typeProbabilityes, TokenList& tokens)
+{
+
+    TokenList newList;
+    newList = RightOfToken(tokens, FindToken(tokens, "while"));
+    newList = LeftOfToken(newList, FindToken(newList, ":"));
+
+    LogDiagnostics(newList, "printing token list after removing if stuff");
+
+    Operation* condition = ParseLine(newList);
+    Operation* op = OperationConstructor(OperationType::While, { condition });
+
+    return op;
+}
+
+// generated by TestBuilder
+Operation* ParseWhile(PossibleOperationsList& typeProbabilityes, TokenList& tokens)
+{
+    TEST_Tracer("ParseWhile");
+    methodHitMap["ParseWhile"]++;
+    if(FunctionInjections.count("ParseWhile") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&typeProbabilityes));
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseWhile"](p);
+    }
+    return ParseWhile_INTERNAL(typeProbabilityes, tokens);
+}
+
+
+void NumberOperation(Operation* op, int lineNumber);
+
+void NumberOperation_INTERNAL(Operation* op, int lineNumber)
+{
+    op->LineNumber = lineNumber;
+    for(Operation* operand: op->Operands)
+    {
+        NumberOperation(operand, lineNumber);
+    }
+}
+
+// generated by TestBuilder
+void NumberOperation(Operation* op, int lineNumber)
+{
+    TEST_Tracer("NumberOperation");
+    methodHitMap["NumberOperation"]++;
+    if(FunctionInjections.count("NumberOperation") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&op));
+    p.push_back(static_cast<const void*>(&lineNumber));
+    FunctionInjections["NumberOperation"](p);
+    }
+    NumberOperation_INTERNAL(op, lineNumber);
+}
+
+typedef Operation*(*LineTypeFunctions)(PossibleOperationsList&, TokenList&);
+LineTypeFunctions lineFunctions[] = {ParseOutAtomic, ParseComposite};
+
+
+Operation* ParseLine(TokenList& tokens);
+
+Operation* ParseLine_INTERNAL(TokenList& tokens)
+{
+    return ExpressionParser(tokens);
+
+    
+
+
+
+
+}
+
+// generated by TestBuilder
+Operation* ParseLine(TokenList& tokens)
+{
+    TEST_Tracer("ParseLine");
+    methodHitMap["ParseLine"]++;
+    if(FunctionInjections.count("ParseLine") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseLine"](p);
+    }
+    return ParseLine_INTERNAL(tokens);
+}
+
+
+int SizeOfBlock(std::vector<CodeLine>::iterator it, std::vector<CodeLine>::iterator end)
+{
+    int blockLevel = it->Level;
+    int blockSize = 0;
+    for(; it != end && it->Level >= blockLevel; it++) 
+        blockSize++;
+
+    return blockSize;
+}
+
+
+bool IsChildBlock(std::vector<CodeLine>::iterator it, int previousLineLevel)
+{
+    return it->Level > previousLineLevel;
+}
+
+
+void HandleCompileMessage(int lineNumber);
+
+void HandleCompileMessage_INTERNAL(int lineNumber)
+{
+    if(CompileMsgFlag)
+    {
+        CompileMsgPrint(lineNumber);
+        CompileMsgFlag = false;
+    }
+}
+
+// generated by TestBuilder
+void HandleCompileMessage(int lineNumber)
+{
+    TEST_Tracer("HandleCompileMessage");
+    methodHitMap["HandleCompileMessage"]++;
+    if(FunctionInjections.count("HandleCompileMessage") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&lineNumber));
+    FunctionInjections["HandleCompileMessage"](p);
+    }
+    HandleCompileMessage_INTERNAL(lineNumber);
+}
+
+
+Block* ParseBlock(
+    std::vector<CodeLine>::iterator it, 
+    std::vector<CodeLine>::iterator end,
+    Scope* scope)
+{
+    Block* thisBlock = BlockConstructor();
+    
+    LogItDebug("entered new block", "ParseBlock");
+
+    int previousLineLevel = it->Level;
+
+    for(; it != end; it++)
+    {
+        if(IsChildBlock(it, previousLineLevel))
+        {
+            LogItDebug(Msg("starting compile new block at line [%i]", it->LineNumber), "ParseBlock");
+            int blockSize = SizeOfBlock(it, end);
+            Block* b = ParseBlock(it, it+blockSize);
+            if(FatalCompileError)
+            {
+                DeleteBlockRecursive(thisBlock);
+                return nullptr;
+            }
+            LogItDebug(Msg("finishes compile new block at line [%i]", it->LineNumber), "ParseBlock");
+
+            it += blockSize - 1;
+
+            thisBlock->Executables.push_back(b);
+        }
+        else
+        {
+            LogItDebug(Msg("starting compile line [%i]", it->LineNumber), "ParseBlock");
+            Operation* op = it->Parsed != nullptr ? it->Parsed : ParseLine(it->Tokens);
+            HandleCompileMessage(it->LineNumber);
+            if(FatalCompileError)
+            {
+                DeleteBlockRecursive(thisBlock);
+                return nullptr;
+            }
+
+            NumberOperation(op, it->LineNumber);
+            LogItDebug(Msg("finishes compile line [%i]", it->LineNumber), "ParseBlock");
+
+            thisBlock->Executables.push_back(op);
+        }
+    }
+
+    return thisBlock;
+}
+
+
+
+int g_parseThreads = 0;
+
+constexpr size_t LinesPerParseChunk = 64;
+
+constexpr size_t MinLinesPerParseThread = 2048;
+
+
+size_t NumberOfParseThreads(size_t numberOfLines);
+
+size_t NumberOfParseThreads_INTERNAL(size_t numberOfLines)
+{
+    if(LogAtLevel <= LogSeverityType::Sev1_Notify)
+        return 1;
+
+    size_t numberOfChunks = (numberOfLines + LinesPerParseChunk - 1) / LinesPerParseChunk;
+    size_t threads = g_parseThreads;
+    if(threads == 0)
+    {
+        threads = std::min<size_t>(std::thread::hardware_concurrency(), numberOfLines / MinLinesPerParseThread);
+    }
+
+    return std::max<size_t>(1, std::min(threads, numberOfChunks));
+}
+
+// generated by TestBuilder
+size_t NumberOfParseThreads(size_t numberOfLines)
+{
+    TEST_Tracer("NumberOfParseThreads");
+    methodHitMap["NumberOfParseThreads"]++;
+    if(FunctionInjections.count("NumberOfParseThreads") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&numberOfLines));
+    FunctionInjections["NumberOfParseThreads"](p);
+    }
+    return NumberOfParseThreads_INTERNAL(numberOfLines);
+}
+
+
+Operation* ParseLineOnWorker(TokenList& tokens);
+
+Operation* ParseLineOnWorker_INTERNAL(TokenList& tokens)
+{
+    try
+    {
+        bool isSyntaxError = false;
+        return ParseExpression(tokens, isSyntaxError);
+    }
+    catch(const std::exception&)
+    {
+        return nullptr;
+    }
+}
+
+// generated by TestBuilder
+Operation* ParseLineOnWorker(TokenList& tokens)
+{
+    TEST_Tracer("ParseLineOnWorker");
+    methodHitMap["ParseLineOnWorker"]++;
+    if(FunctionInjections.count("ParseLineOnWorker") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["ParseLineOnWorker"](p);
+    }
+    return ParseLineOnWorker_INTERNAL(tokens);
+}
+
+
+void ParseLinesInParallel(Program* p, const std::vector<SourceLine>& lines, size_t threads)
+{
+    size_t numberOfChunks = (lines.size() + LinesPerParseChunk - 1) / LinesPerParseChunk;
+    std::vector<std::vector<DeferredConstant>> constants(numberOfChunks);
+    std::vector<TokenArena> arenas(threads);
+    std::atomic<size_t> nextChunk(0);
+
+    p->Lines.resize(lines.size());
+
+    auto parseChunks = [&](size_t worker)
+    {
+        for(size_t chunk = nextChunk++; chunk < numberOfChunks; chunk = nextChunk++)
+        {
+            DeferredConstants = &constants[chunk];
+
+            size_t end = std::min(lines.size(), (chunk + 1) * LinesPerParseChunk);
+            for(size_t i = chunk * LinesPerParseChunk; i < end; i++)
+            {
+                auto& codeLine = p->Lines[i];
+                codeLine.Tokens = LexLine(lines[i].Text, arenas[worker]);
+                codeLine.LineNumber = lines[i].LineNumber;
+                codeLine.Level = lines[i].Level;
+                codeLine.Parsed = ParseLineOnWorker(codeLine.Tokens);
+            }
+
+            DeferredConstants = nullptr;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(size_t worker=1; worker<threads; worker++)
+    {
+        workers.emplace_back(parseChunks, worker);
+    }
+    parseChunks(0);
+
+    for(auto& worker: workers)
+    {
+        worker.join();
+    }
+
+    for(auto& arena: arenas)
+    {
+        MoveTokenArena(p->Tokens, arena);
+    }
+
+    for(auto& chunkConstants: constants)
+    {
+        BindDeferredConstants(chunkConstants);
+    }
+}
+
+
+Program* ParseSourceOf(Program* p);
+
+Program* ParseSourceOf_INTERNAL(Program* p)
+{
+    auto lines = ScanSourceLines(ViewOf(p->Source));
+    size_t threads = NumberOfParseThreads(lines.size());
+    if(threads > 1)
+    {
+        ParseLinesInParallel(p, lines, threads);
+    }
+    else
+    {
+        p->Lines.reserve(lines.size());
+        for(auto& line: lines)
+        {
+            CodeLine codeLine = { LexLine(line.Text, p->Tokens), line.LineNumber, line.Level };
+            p->Lines.push_back(codeLine);
+        }
+    }
+
+    if(p->Lines.empty())
+    {
+        ProgramDestructor(p);
+        return nullptr;
+    }
+
+    Block* b = ParseBlock(p->Lines.begin(), p->Lines.end(), p->GlobalScope);
+    p->Main = b;
+
+    return p;
+}
+
+// generated by TestBuilder
+Program* ParseSourceOf(Program* p)
+{
+    TEST_Tracer("ParseSourceOf");
+    methodHitMap["ParseSourceOf"]++;
+    if(FunctionInjections.count("ParseSourceOf") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["ParseSourceOf"](p);
+    }
+    return ParseSourceOf_INTERNAL(p);
+}
+
+
+Program* ParseProgram(const std::string filepath)
+{
+    InitParser();
+    g_tabString.clear();
+    
+    Program* p = ProgramConstructor();
+
+    if(!OpenMappedFile(filepath, p->Source))
+    {
+        std::cout << "\ncould not open file: " << filepath << std::endl;
+        return nullptr;
+    }
+
+    return ParseSourceOf(p);
+}
+
+
+Program* ParseProgramSource(const std::string& source)
+{
+    InitParser();
+    g_tabString.clear();
+
+    Program* p = ProgramConstructor();
+    CopyIntoMappedFile(source, p->Source);
+
+    return ParseSourceOf(p);
+}
+
+
+void ProgramDestructor(Program* p);
+
+void ProgramDestructor_INTERNAL(Program* p)
+{
+    if(p->GlobalScope != nullptr)
+    {
+        ScopeDestructor(p->ScopeSlab, p->GlobalScope);
+    }
+
+    if(p->Main != nullptr)
+    {
+        DeleteBlockRecursive(p->Main);
+    }
+    CloseMappedFile(p->Source);
+
+    delete p;
+}
+
+// generated by TestBuilder
+void ProgramDestructor(Program* p)
+{
+    TEST_Tracer("ProgramDestructor");
+    methodHitMap["ProgramDestructor"]++;
+    if(FunctionInjections.count("ProgramDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["ProgramDestructor"](p);
+    }
+    ProgramDestructor_INTERNAL(p);
+}
@@ -0,0 +1,258 @@
+#include "test.h"
+
+#include "reference.h"
+
+#include "main.h"
+#include "object.h"
+#include "scope.h"
+#include "program.h"
+#include "token.h"
+#include "diagnostics.h"
+#include "operation.h"
+
+
+
+Reference* ReferenceConstructor();
+
+Reference* ReferenceConstructor_INTERNAL()
+{
+    Reference* ref = new Reference; 
+    ref->Name = "";
+    ref->To = nullptr;
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceConstructor()
+{
+    TEST_Tracer("ReferenceConstructor");
+    methodHitMap["ReferenceConstructor"]++;
+    if(FunctionInjections.count("ReferenceConstructor") == 1){
+    Params p;
+    FunctionInjections["ReferenceConstructor"](p);
+    }
+    return ReferenceConstructor_INTERNAL();
+}
+
+
+Reference* ReferenceConstructor(String refName, Object* obj);
+
+Reference* ReferenceConstructor_INTERNAL(String refName, Object* obj)
+{
+    Reference* ref = new Reference; 
+    ref->Name = refName;
+    ref->To = obj;
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceConstructor(String refName, Object* obj)
+{
+    TEST_Tracer("ReferenceConstructor");
+    methodHitMap["ReferenceConstructor"]++;
+    if(FunctionInjections.count("ReferenceConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["ReferenceConstructor"](p);
+    }
+    return ReferenceConstructor_INTERNAL(refName, obj);
+}
+
+
+void ReferenceDestructor(Reference* ref);
+
+void ReferenceDestructor_INTERNAL(Reference* ref)
+{
+    delete ref;
+}
+
+// generated by TestBuilder
+void ReferenceDestructor(Reference* ref)
+{
+    TEST_Tracer("ReferenceDestructor");
+    methodHitMap["ReferenceDestructor"]++;
+    if(FunctionInjections.count("ReferenceDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["ReferenceDestructor"](p);
+    }
+    ReferenceDestructor_INTERNAL(ref);
+}
+
+
+
+
+
+
+bool IsTemporaryReference(Reference* ref);
+
+bool IsTemporaryReference_INTERNAL(Reference* ref)
+{
+    return ref->Name == c_temporaryReferenceName;
+}
+
+// generated by TestBuilder
+bool IsTemporaryReference(Reference* ref)
+{
+    TEST_Tracer("IsTemporaryReference");
+    methodHitMap["IsTemporaryReference"]++;
+    if(FunctionInjections.count("IsTemporaryReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsTemporaryReference"](p);
+    }
+    return IsTemporaryReference_INTERNAL(ref);
+}
+
+
+
+
+
+bool NameMatchesReference(String name, Reference* ref);
+
+bool NameMatchesReference_INTERNAL(String name, Reference* ref)
+{
+    return name == ref->Name;
+}
+
+// generated by TestBuilder
+bool NameMatchesReference(String name, Reference* ref)
+{
+    TEST_Tracer("NameMatchesReference");
+    methodHitMap["NameMatchesReference"]++;
+    if(FunctionInjections.count("NameMatchesReference") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&name));
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["NameMatchesReference"](p);
+    }
+    return NameMatchesReference_INTERNAL(name, ref);
+}
+
+
+
+
+bool IsPrimitiveObject(Reference* ref);
+
+bool IsPrimitiveObject_INTERNAL(Reference* ref)
+{
+    if(ref->To == nullptr)
+    {
+        return false;
+    }
+    
+    return IsPrimitiveObject(ref->To);
+}
+
+// generated by TestBuilder
+bool IsPrimitiveObject(Reference* ref)
+{
+    TEST_Tracer("IsPrimitiveObject");
+    methodHitMap["IsPrimitiveObject"]++;
+    if(FunctionInjections.count("IsPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsPrimitiveObject"](p);
+    }
+    return IsPrimitiveObject_INTERNAL(ref);
+}
+
+
+bool IsPrimitiveObject(Object* obj);
+
+bool IsPrimitiveObject_INTERNAL(Object* obj)
+{
+    auto objClass = obj->Class;
+    if(objClass == BooleanClass || objClass == StringClass || objClass == DecimalClass || objClass == IntegerClass)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+// generated by TestBuilder
+bool IsPrimitiveObject(Object* obj)
+{
+    TEST_Tracer("IsPrimitiveObject");
+    methodHitMap["IsPrimitiveObject"]++;
+    if(FunctionInjections.count("IsPrimitiveObject") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&obj));
+    FunctionInjections["IsPrimitiveObject"](p);
+    }
+    return IsPrimitiveObject_INTERNAL(obj);
+}
+
+
+
+
+
+Reference* ReferenceStubConstructor(String refName);
+
+Reference* ReferenceStubConstructor_INTERNAL(String refName)
+{
+    Reference* ref = new Reference;
+    ref->Name = refName;
+    ref->To = nullptr;
+
+    return ref;
+}
+
+// generated by TestBuilder
+Reference* ReferenceStubConstructor(String refName)
+{
+    TEST_Tracer("ReferenceStubConstructor");
+    methodHitMap["ReferenceStubConstructor"]++;
+    if(FunctionInjections.count("ReferenceStubConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&refName));
+    FunctionInjections["ReferenceStubConstructor"](p);
+    }
+    return ReferenceStubConstructor_INTERNAL(refName);
+}
+
+
+void ReferenceStubDestructor(Reference* ref);
+
+void ReferenceStubDestructor_INTERNAL(Reference* ref)
+{
+    delete ref;
+}
+
+// generated by TestBuilder
+void ReferenceStubDestructor(Reference* ref)
+{
+    TEST_Tracer("ReferenceStubDestructor");
+    methodHitMap["ReferenceStubDestructor"]++;
+    if(FunctionInjections.count("ReferenceStubDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["ReferenceStubDestructor"](p);
+    }
+    ReferenceStubDestructor_INTERNAL(ref);
+}
+
+
+bool IsReferenceStub(Reference* ref);
+
+bool IsReferenceStub_INTERNAL(Reference* ref)
+{
+    return ObjectOf(ref) == nullptr;
+}
+
+// generated by TestBuilder
+bool IsReferenceStub(Reference* ref)
+{
+    TEST_Tracer("IsReferenceStub");
+    methodHitMap["IsReferenceStub"]++;
+    if(FunctionInjections.count("IsReferenceStub") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["IsReferenceStub"](p);
+    }
+    return IsReferenceStub_INTERNAL(ref);
+}
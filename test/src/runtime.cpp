@@ -0,0 +1,788 @@
+#include "test.h"
+#include "runtime.h"
+
+#include <iostream>
+
+#include "operation.h"
+#include "astvm.h"
+
+#include "program.h"
+#include "reference.h"
+#include "main.h"
+#include "object.h"
+#include "scope.h"
+#include "diagnostics.h"
+#include "astvm.h"
+
+OperationEvaluator OperationEvaluators[] = 
+{
+    OperationAssign,
+
+    OperationIs,
+    OperationIsEqual,
+    OperationIsNotEqual,
+
+    OperationIsLessThan,
+    OperationIsGreaterThan,
+    OperationIsLessThanOrEqualTo,
+    OperationIsGreaterThanOrEqualTo,
+
+    OperationAdd,
+    OperationSubtract,
+    OperationMultiply,
+    OperationDivide,
+
+    OperationAnd,
+    OperationOr,
+    OperationNot,
+
+    OperationEvaluate,
+    OperationEvaluateHere,
+
+    OperationPrint,
+    OperationAsk,
+
+    OperationRef,
+    OperationDefineMethod,
+    OperationReturn,
+
+    OperationIf,
+    OperationElseIf,
+    OperationElse,
+    OperationWhile,
+
+    OperationTuple,
+
+    OperationNew,
+    OperationScopeResolution,
+    OperationClass,
+
+};
+
+
+
+
+Reference* ResolveStub(Reference* ref);
+
+Reference* ResolveStub_INTERNAL(Reference* ref) 
+{
+    if(!IsReferenceStub(ref))
+        return ref;
+
+    if(ref->Name == "that" || ref->Name == "it")
+    {
+        if(PROGRAM->That == nullptr)
+        {
+            ReportRuntimeMsg(SystemMessageType::Exception, "no previous result to use with 'that'/'it' keyword");
+            return NullReference(c_temporaryReferenceName);
+        }
+        return ReferenceForExistingObject(c_temporaryReferenceName, PROGRAM->That->To);
+    }
+    
+    auto lookupRef = LookupReference(ref->Name);
+    if(lookupRef == nullptr)
+        return NullReference(ref->Name);
+    else
+        return lookupRef;
+}
+
+// generated by TestBuilder
+Reference* ResolveStub(Reference* ref) 
+{
+    TEST_Tracer("ResolveStub");
+    methodHitMap["ResolveStub"]++;
+    if(FunctionInjections.count("ResolveStub") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    FunctionInjections["ResolveStub"](p);
+    }
+    return ResolveStub_INTERNAL(ref);
+}
+
+
+inline Reference* ResolveNthOf(std::vector<Reference*>& operands, size_t n)
+{
+    if(operands.size() >= n)
+        return ResolveStub(operands.at(n-1));
+    return nullptr;
+}
+
+
+inline Reference* ResolveFirst(std::vector<Reference*>& operands)
+{
+    return ResolveNthOf(operands, 1);
+}
+
+
+inline Reference* ResolveSecond(std::vector<Reference*>& operands)
+{
+    return ResolveNthOf(operands, 2);
+}
+
+
+bool ReferencesAreEqual(Reference* lhs, Reference* rhs);
+
+bool ReferencesAreEqual_INTERNAL(Reference* lhs, Reference* rhs)
+{
+    return lhs->To == rhs->To;
+}
+
+// generated by TestBuilder
+bool ReferencesAreEqual(Reference* lhs, Reference* rhs)
+{
+    TEST_Tracer("ReferencesAreEqual");
+    methodHitMap["ReferencesAreEqual"]++;
+    if(FunctionInjections.count("ReferencesAreEqual") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&lhs));
+    p.push_back(static_cast<const void*>(&rhs));
+    FunctionInjections["ReferencesAreEqual"](p);
+    }
+    return ReferencesAreEqual_INTERNAL(lhs, rhs);
+}
+
+
+Reference* OperationIsEqual(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lhs = ResolveFirst(operands);
+    Reference* rhs = ResolveSecond(operands);
+    bool areEqual = ReferencesAreEqual(lhs, rhs);
+    
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, areEqual);
+}
+
+
+Reference* OperationIsNotEqual(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lhs = ResolveFirst(operands);
+    Reference* rhs = ResolveSecond(operands);
+    bool areEqual = ReferencesAreEqual(lhs, rhs);
+    
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, !areEqual);
+}
+
+
+Reference* OperationIsLessThan(Reference* value, std::vector<Reference*>& operands)
+{
+    auto lRef = ResolveFirst(operands);
+    auto rRef = ResolveSecond(operands);
+    bool comparisonIs = false;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {
+        comparisonIs = GetDecimalValue(ObjectOf(lRef)) < GetDecimalValue(ObjectOf(rRef));
+    }
+
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, comparisonIs);
+}
+
+
+Reference* OperationIsGreaterThan(Reference* value, std::vector<Reference*>& operands)
+{
+    auto lRef = ResolveFirst(operands);
+    auto rRef = ResolveSecond(operands);
+    bool comparisonIs = false;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {
+        comparisonIs = GetDecimalValue(ObjectOf(lRef)) > GetDecimalValue(ObjectOf(rRef));
+    }
+
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, comparisonIs);
+}
+
+
+Reference* OperationIsLessThanOrEqualTo(Reference* value, std::vector<Reference*>& operands)
+{
+    auto lRef = ResolveFirst(operands);
+    auto rRef = ResolveSecond(operands);
+    bool comparisonIs = false;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {
+        comparisonIs = GetDecimalValue(ObjectOf(lRef)) <= GetDecimalValue(ObjectOf(rRef));
+    }
+
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, comparisonIs);
+}
+
+
+Reference* OperationIsGreaterThanOrEqualTo(Reference* value, std::vector<Reference*>& operands)
+{
+    auto lRef = ResolveFirst(operands);
+    auto rRef = ResolveSecond(operands);
+    bool comparisonIs = false;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {
+        comparisonIs = GetDecimalValue(ObjectOf(lRef)) >= GetDecimalValue(ObjectOf(rRef));
+    }
+    
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, comparisonIs);
+}
+
+
+
+Reference* OperationOr(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+
+    bool b = GetBoolValue(ObjectOf(lRef)) || GetBoolValue(ObjectOf(rRef));
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, b);
+}
+
+
+Reference* OperationNot(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* ref = ResolveFirst(operands);
+
+    bool b = !GetBoolValue(ObjectOf(ref));
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, b);
+}
+
+
+Reference* OperationEvaluateHere(Reference* value, std::vector<Reference*>& operands)
+{
+    LogIt(LogSeverityType::Sev1_Notify, "OperationEvaluateHere", "unimplemented");
+    return NullReference();
+}
+
+
+Reference* OperationIs(Reference* value, std::vector<Reference*>& operands)
+{
+    LogIt(LogSeverityType::Sev1_Notify, "OperationIs", "unimplemented");
+    return NullReference();
+}
+
+
+
+Reference* OperationRef(Reference* value, std::vector<Reference*>& operands)
+{
+    return value;
+}
+
+
+Reference* OperationAssign(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+
+    if(IsNullReference(rRef))
+    {
+        ReportRuntimeMsg(SystemMessageType::Warning, Msg("cannot assign %s to Nothing", lRef));
+        Dereference(lRef);
+        return ReferenceForExistingObject(c_temporaryReferenceName, lRef->To);
+    }
+
+    ReassignReference(lRef, rRef->To);
+    return ReferenceForExistingObject(c_temporaryReferenceName, lRef->To);
+}
+
+
+Reference* OperationPrint(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* ref = ResolveFirst(operands);
+
+    if(g_outputOn)
+        std::cout << GetStringValue(ObjectOf(ref)) << "\n";
+    ProgramOutput.append(GetStringValue(ObjectOf(ref)) + "\n");
+
+    auto returnRef = ReferenceForExistingObject(c_temporaryReferenceName, ObjectOf(ref));
+    if(IsNullReference(ref))
+        Dereference(ref);
+    
+    return returnRef;
+}
+
+
+Reference* OperationAdd(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+    Reference* resultRef;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {  
+        ObjectClass type = GetPrecedenceClass(ObjectOf(lRef), ObjectOf(rRef));
+        if(type == IntegerClass)
+        {
+            int value = GetIntValue(ObjectOf(lRef)) + GetIntValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else if(type == DecimalClass)
+        {
+            double value = GetDecimalValue(ObjectOf(lRef)) + GetDecimalValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else
+        {
+            LogIt(LogSeverityType::Sev1_Notify, "Add", "unimplemented");
+            resultRef = NullReference();
+        }
+        
+        return resultRef;
+    }
+    else if(IsString(lRef) || IsString(rRef))
+    {
+        String s = GetStringValue(ObjectOf(lRef)) + GetStringValue(ObjectOf(rRef));
+        resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, s);
+
+        return resultRef;
+    }
+
+    resultRef = NullReference();
+    ReportRuntimeMsg(SystemMessageType::Warning, Msg("cannot add types %s and %s", 
+        ObjectOf(lRef)->Class, 
+        ObjectOf(rRef)->Class));
+
+    return resultRef;
+}
+
+
+Reference* OperationAnd(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+
+    bool b = GetBoolValue(ObjectOf(lRef)) && GetBoolValue(ObjectOf(rRef));
+    return ReferenceForPrimitiveObject(c_temporaryReferenceName, b);
+}
+
+
+Reference* OperationSubtract(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+    Reference* resultRef;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {  
+        ObjectClass type = GetPrecedenceClass(ObjectOf(lRef), ObjectOf(rRef));
+        if(type == IntegerClass)
+        {
+            int value = GetIntValue(ObjectOf(lRef)) - GetIntValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else if(type == DecimalClass)
+        {
+            double value = GetDecimalValue(ObjectOf(lRef)) - GetDecimalValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else
+        {
+            LogIt(LogSeverityType::Sev1_Notify, "Subtract", "unimplemented");
+            resultRef = NullReference();
+        }
+        return resultRef;
+    }
+
+    resultRef = NullReference();
+    ReportRuntimeMsg(SystemMessageType::Warning, Msg("cannot subtract %s from %s", ObjectOf(rRef)->Class, ObjectOf(lRef)->Class));
+    return resultRef;
+}
+
+
+Reference* OperationIf(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* ref = ResolveFirst(operands);
+    return ReferenceForExistingObject(c_temporaryReferenceName, ObjectOf(ref));
+}
+
+
+Reference* OperationWhile(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* ref = ResolveFirst(operands);
+    return ReferenceForExistingObject(c_temporaryReferenceName, ObjectOf(ref));
+}
+
+
+
+Reference* OperationMultiply(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+    Reference* resultRef;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {  
+        ObjectClass type = GetPrecedenceClass(ObjectOf(lRef), ObjectOf(rRef));
+        if(type == IntegerClass)
+        {
+            int value = GetIntValue(ObjectOf(lRef)) * GetIntValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else if(type == DecimalClass)
+        {
+            double value = GetDecimalValue(ObjectOf(lRef)) * GetDecimalValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else
+        {
+            LogIt(LogSeverityType::Sev1_Notify, "Multiply", "unimplemented");
+            resultRef = NullReference();
+        }
+        return resultRef;
+    }
+
+    resultRef = NullReference();
+    ReportRuntimeMsg(SystemMessageType::Warning, Msg("cannot multiply %s and %s", ObjectOf(lRef)->Class, ObjectOf(rRef)->Class));
+    return resultRef;
+}
+
+
+
+Reference* OperationDivide(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* lRef = ResolveFirst(operands);
+    Reference* rRef = ResolveSecond(operands);
+    Reference* resultRef;
+
+    if(IsNumeric(lRef) && IsNumeric(rRef))
+    {  
+        ObjectClass type = GetPrecedenceClass(ObjectOf(lRef), ObjectOf(rRef));
+        if(type == IntegerClass)
+        {
+            int value = GetIntValue(ObjectOf(lRef)) / GetIntValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else if(type == DecimalClass)
+        {
+            double value = GetDecimalValue(ObjectOf(lRef)) / GetDecimalValue(ObjectOf(rRef));
+            resultRef = ReferenceForPrimitiveObject(c_temporaryReferenceName, value);
+        }
+        else
+        {
+            LogIt(LogSeverityType::Sev1_Notify, "Divide", "unimplemented");
+            resultRef = NullReference();
+        }
+        return resultRef;
+    }
+
+    resultRef = NullReference();
+    ReportRuntimeMsg(SystemMessageType::Warning, Msg("cannot divide %s by %s", ObjectOf(lRef)->Class, ObjectOf(rRef)->Class));
+    return resultRef;
+}
+
+
+Reference* OperationReturn(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* returnRef = ResolveFirst(operands);
+    return ReferenceForExistingObject(c_returnReferenceName, returnRef->To);
+}
+
+
+
+
+
+
+
+Reference* OperationDefineMethod(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* methodRef = ResolveFirst(operands);
+    if(IsNullReference(methodRef))
+    {
+        auto refToNewObj = ReferenceForNewObject(c_temporaryReferenceName, BaseClass, nullptr);
+        
+        if(CurrentScope()->IsDurable)
+            refToNewObj->To->DefinitionScope = CurrentScope();
+        
+        refToNewObj->To->Action = MethodConstructor();
+        ReassignReference(methodRef, refToNewObj->To);
+        Dereference(refToNewObj);
+    }
+    else
+    {
+        if(methodRef->To->Action == nullptr)
+            methodRef->To->Action = MethodConstructor();
+    }
+
+    ParameterList params;
+    if(operands.size() > 1)
+    {
+        auto argsRef = ResolveSecond(operands);
+        if(IsNullReference(argsRef) || argsRef->To->Class != TupleClass)
+        {
+            params.push_back(argsRef->Name);
+        }
+        else
+        {
+            for(auto paramRef: argsRef->To->Attributes->ReferencesIndex)
+            {
+                params.push_back(paramRef->Name);
+            }
+        }
+    }
+
+    methodRef->To->Action->ParameterNames = params;
+
+    return methodRef;
+}
+
+
+
+
+
+Reference* OperationTuple(Reference* value, std::vector<Reference*>& operands)
+{
+    LogItDebug("called", "OperationTuple");
+    Reference* tupleRef = ReferenceForNewObject(c_temporaryReferenceName, TupleClass, nullptr);
+
+    for(auto ref: operands)
+    {
+        EnterScope(ObjectOf(tupleRef)->Attributes);
+        {
+            auto copyRef = NullReference(ref->Name);
+            ReassignReference(copyRef, ref->To);
+        }
+        ExitScope();
+
+    }
+
+    return tupleRef;
+}
+
+
+
+
+std::vector<Reference*> ResolveParamters(Reference* ref)
+{
+    if(IsNullReference(ref))
+        return {};
+
+    auto obj = ObjectOf(ref);
+    if(obj != nullptr && obj->Class == TupleClass)
+    {
+        std::vector<Reference*> params;
+        for(auto ref: obj->Attributes->ReferencesIndex)
+        {
+            params.push_back(ref);
+        }
+        return params;
+    }
+    else
+    {
+        return { ref };
+    }
+    
+}
+
+
+Reference* OperationEvaluate(Reference* value, std::vector<Reference*>& operands)
+{
+    String callerName = operands[0]->Name;
+    Reference* caller = nullptr;
+
+    Scope* methodResolutionScope = nullptr;
+    Scope* methodCallerScope = nullptr;
+
+    if(callerName == c_nullStubName)
+    {
+        methodResolutionScope = CurrentScope();
+        methodCallerScope = nullptr;
+    }
+    else
+    {
+        caller = ResolveFirst(operands);
+        if(IsNullReference(caller))
+        {
+            ReportRuntimeMsg(SystemMessageType::Exception, "cannot resolve method caller");
+            return caller;
+        }
+
+        methodResolutionScope = caller->To->Attributes;
+        methodCallerScope = caller->To->Attributes;
+    }
+
+    Reference* method;
+    EnterScope(methodResolutionScope);
+    {
+        method = ResolveSecond(operands);        
+    }
+    ExitScope();
+    
+
+    if(IsNullReference(method))
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, Msg("cannot resolve %s into a method", method->Name));
+        return method;
+    }
+    if(method->To->Action == nullptr)
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, Msg("%s is not callable", method->Name));
+        return NullReference();
+    }
+
+    Reference* params = ResolveNthOf(operands, 3);
+    
+    std::vector<Reference*> givenParamsList = ResolveParamters(params);
+    auto givenNum = givenParamsList.size();
+    auto requiredNum = ObjectOf(method)->Action->ParameterNames.size();
+    if(givenNum != requiredNum)
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, Msg("wrong number of parameters: given %i, but expected %i", givenNum, requiredNum));
+        return NullReference();
+    }
+
+    auto methodParamNames = ObjectOf(method)->Action->ParameterNames;
+    
+    if(caller == nullptr)
+    {
+        methodCallerScope = method->To->DefinitionScope;
+        if(methodCallerScope == nullptr)
+        {
+            methodCallerScope = CurrentScope();
+        }
+    }
+
+    auto methodSelfScope = method->To->Attributes;
+    methodSelfScope->InheritedScope = methodCallerScope;
+
+    auto methodBodyScope = ScopeConstructor(WalkerScopeSlab, methodSelfScope);
+    EnterScope(methodBodyScope);
+    {
+        for(size_t i=0; i<methodParamNames.size(); i++)
+        {
+            ReferenceForExistingObject(methodParamNames[i], givenParamsList[i]->To);
+        }
+        if(caller == nullptr)
+            NullReference("caller");
+        else
+            ReferenceForExistingObject("caller", caller->To);
+
+        ReferenceForExistingObject("self", method->To);
+    }
+    ExitScope();
+
+    Reference* result;
+    auto methodBlock = ObjectOf(method)->Action->CodeBlock;
+    result = DoBlock(methodBlock, methodBodyScope);
+
+    WipeScope(methodBodyScope);
+
+    LogItDebug("finished evaluate", "OperationEvaluate");
+    return result;
+}
+
+
+
+
+
+Reference* OperationNew(Reference* value, std::vector<Reference*>& operands)
+{
+    Reference* ref = ResolveFirst(operands);
+
+    if(IsNullReference(ref))
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, Msg("%s is Nothing, it must be defined before use", ref->Name));
+        return NullReference();
+    }
+
+    Reference* returnRef = ReferenceForNewObject(c_temporaryReferenceName, ObjectOf(ref)->Class, ObjectOf(ref)->Value);
+    
+    if(CurrentScope()->IsDurable)
+        returnRef->To->DefinitionScope = CurrentScope();
+    for(auto attributeRef: ObjectOf(ref)->Attributes->ReferencesIndex)
+    {
+        EnterScope(ObjectOf(returnRef)->Attributes);
+        {
+            ReferenceForExistingObject(attributeRef->Name, attributeRef->To);
+        }
+        ExitScope();
+    }
+    ObjectOf(returnRef)->Attributes->InheritedScope = ObjectOf(ref)->Attributes->InheritedScope;
+    returnRef->To->Action = ref->To->Action;
+
+    return returnRef;
+}
+
+
+
+inline bool HasNoCaller(std::vector<Reference*>& operands)
+{
+    return operands.size() < 2;
+}
+
+
+Reference* OperationScopeResolution(Reference* value, std::vector<Reference*>& operands)
+{
+    if(HasNoCaller(operands))
+    {
+        Reference* ref = ResolveFirst(operands);
+        if(IsTemporaryReference(ref))
+            return ReferenceForExistingObject(c_temporaryReferenceName, ref->To);
+        else
+            return ref;
+    }
+    else
+    {
+        Reference* caller = ResolveFirst(operands);
+
+        if(IsNullReference(caller))
+        {
+            ReportRuntimeMsg(SystemMessageType::Exception, Msg("%s is Nothing and has no attributes", caller->Name));
+            return NullReference();
+        }
+
+        String attributeName = operands.at(1)->Name;
+        Scope* callerScope = caller->To->Attributes;
+        Reference* attribute = ReferenceForInImmediateScope(attributeName, callerScope);
+
+        if(attribute == nullptr)
+        {
+            EnterScope(callerScope);
+            {
+                attribute = NullReference(attributeName);
+            }
+            ExitScope();
+        }
+
+        return attribute;
+    }
+}
+
+
+
+
+Reference* OperationClass(Reference* value, std::vector<Reference*>& operands)
+{
+    if(operands.size() == 0)
+    {
+        ReportRuntimeMsg(SystemMessageType::Exception, "no class name specified");
+        return NullReference();
+    }
+
+    String className = operands.at(0)->Name;
+    Reference* klass = ReferenceForNewObject(className, className, nullptr);
+
+    EnterScope(klass->To->Attributes);
+    {
+        ReferenceForExistingObject("self", klass->To);
+    }
+    ExitScope();
+
+    klass->To->Attributes->InheritedScope = PROGRAM->GlobalScope;
+
+    return klass;
+}
+
+
+
+
+Reference* OperationAsk(Reference* value, std::vector<Reference*>& operands)
+{
+    LogIt(LogSeverityType::Sev3_Critical, "OperationAsk", "unimplemented");
+    return NullReference();
+}
+
+Reference* OperationElseIf(Reference* value, std::vector<Reference*>& operands)
+{
+    LogIt(LogSeverityType::Sev3_Critical, "OperationAsk", "unimplemented");
+    return NullReference();
+}
+
+Reference* OperationElse(Reference* value, std::vector<Reference*>& operands)
+{
+    LogIt(LogSeverityType::Sev3_Critical, "OperationAsk", "unimplemented");
+    return NullReference();
+}
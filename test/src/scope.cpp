@@ -0,0 +1,197 @@
+#include "test.h"
+#include "scope.h"
+
+#include "reference.h"
+#include "call.h"
+#include "diagnostics.h"
+#include "utils.h"
+#include <iostream>
+#include <algorithm>
+#include <new>
+
+
+
+CallIndex::CallIndex()
+    : Calls(InlineCalls), Size(0), Capacity(CallIndexInlineSize), Table(nullptr), TableCapacity(0)
+{
+}
+
+
+CallIndex::~CallIndex()
+{
+    if(Calls != InlineCalls)
+    {
+        delete[] Calls;
+    }
+    delete[] Table;
+}
+
+
+void CallIndex::Grow()
+{
+    uint32_t newCapacity = Capacity * 2;
+    Call** newCalls = new Call*[newCapacity];
+    std::copy(Calls, Calls + Size, newCalls);
+
+    if(Calls != InlineCalls)
+    {
+        delete[] Calls;
+    }
+    Calls = newCalls;
+    Capacity = newCapacity;
+
+    Rehash(newCapacity * 2);
+}
+
+
+void CallIndex::Rehash(uint32_t newTableCapacity)
+{
+    delete[] Table;
+    Table = new Call*[newTableCapacity]();
+    TableCapacity = newTableCapacity;
+
+    for(uint32_t i=0; i<Size; i++)
+    {
+        InsertIntoTable(Calls[i]);
+    }
+}
+
+
+void CallIndex::InsertIntoTable(Call* call)
+{
+    size_t i = SlotFor(call->Name);
+    for(; Table[i] != nullptr; i = (i + 1) & (TableCapacity - 1))
+    {
+        if(Table[i]->Name == call->Name)
+            return;
+    }
+    Table[i] = call;
+}
+
+
+
+
+Scope* ScopeConstructor(utils::Slab<Scope>& slab, Scope* inheritedScope)
+{
+    Scope* s = new (slab.Allocate()) Scope;
+    s->InheritedScope = inheritedScope;
+    s->ReferencesIndex = {};
+    s->IsDurable = false;
+
+    return s;
+}
+
+
+void ScopeDestructor(utils::Slab<Scope>& slab, Scope* scope)
+{
+    scope->~Scope();
+    slab.Free(scope);
+}
+
+
+void ReleaseScopeStorage(Scope* scope);
+
+void ReleaseScopeStorage_INTERNAL(Scope* scope)
+{
+    bool ownsStorage = scope->CallsIndex.AllocatedBytes() > 0 || scope->ReferencesIndex.capacity() > 0
+        || scope->Elements.capacity() > 0;
+    if(ownsStorage)
+    {
+        scope->~Scope();
+    }
+}
+
+// generated by TestBuilder
+void ReleaseScopeStorage(Scope* scope)
+{
+    TEST_Tracer("ReleaseScopeStorage");
+    methodHitMap["ReleaseScopeStorage"]++;
+    if(FunctionInjections.count("ReleaseScopeStorage") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["ReleaseScopeStorage"](p);
+    }
+    ReleaseScopeStorage_INTERNAL(scope);
+}
+
+
+void ReleaseAllScopes(utils::Slab<Scope>& slab)
+{
+    slab.Reset();
+}
+
+
+void AddReferenceToScope(Reference* ref, Scope* scope);
+
+void AddReferenceToScope_INTERNAL(Reference* ref, Scope* scope)
+{
+    scope->ReferencesIndex.push_back(ref);
+}
+
+// generated by TestBuilder
+void AddReferenceToScope(Reference* ref, Scope* scope)
+{
+    TEST_Tracer("AddReferenceToScope");
+    methodHitMap["AddReferenceToScope"]++;
+    if(FunctionInjections.count("AddReferenceToScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&ref));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["AddReferenceToScope"](p);
+    }
+    AddReferenceToScope_INTERNAL(ref, scope);
+}
+
+
+void AddCallToScope(Call* call, Scope* scope);
+
+void AddCallToScope_INTERNAL(Call* call, Scope* scope)
+{
+    scope->CallsIndex.push_back(call);
+}
+
+// generated by TestBuilder
+void AddCallToScope(Call* call, Scope* scope)
+{
+    TEST_Tracer("AddCallToScope");
+    methodHitMap["AddCallToScope"]++;
+    if(FunctionInjections.count("AddCallToScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["AddCallToScope"](p);
+    }
+    AddCallToScope_INTERNAL(call, scope);
+}
+
+
+inline Call* CopyCallBindings(const Call* call, utils::Slab<Call>& slab)
+{
+    Call* callCopy = CallConstructor(slab, call->Name);
+    BindScope(callCopy, call->BoundScope);
+    BindSection(callCopy, call->BoundSection);
+    BindType(callCopy, call->BoundType);
+    EnforceCallType(callCopy, call->CallType);
+    callCopy->NumberOfParameters = call->NumberOfParameters;
+
+    return callCopy;
+}
+
+
+Scope* CopyScope(Scope* scp, utils::Slab<Scope>& scopeSlab, utils::Slab<Call>& callSlab)
+{
+    Scope* scpCopy = ScopeConstructor(scopeSlab, scp->InheritedScope);
+
+    for(auto call: scp->CallsIndex)
+    {
+        AddCallToScope(CopyCallBindings(call, callSlab), scpCopy);
+    }
+
+    scpCopy->Elements.reserve(scp->Elements.size());
+    for(auto call: scp->Elements)
+    {
+        scpCopy->Elements.push_back(CopyCallBindings(call, callSlab));
+    }
+
+    return scpCopy;
+}
@@ -0,0 +1,685 @@
+#include "test.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#include "token.h"
+
+#include "main.h"
+#include "diagnostics.h"
+#include "reference.h"
+#include "operation.h"
+
+
+
+
+
+
+Token* TokenConstructor(TokenArena& arena, TokenType type, std::string_view content, int position)
+{
+    if(arena.Used == TokenArenaBlockSize)
+    {
+        arena.Blocks.emplace_back(new Token[TokenArenaBlockSize]);
+        arena.Used = 0;
+    }
+
+    Token* t = &arena.Blocks.back()[arena.Used++];
+    *t = { type, content, position };
+    return t;
+}
+
+
+void ClearTokenArena(TokenArena& arena);
+
+void ClearTokenArena_INTERNAL(TokenArena& arena)
+{
+    if(arena.Blocks.size() > 1)
+        arena.Blocks.resize(1);
+
+    arena.Used = arena.Blocks.empty() ? TokenArenaBlockSize : 0;
+}
+
+// generated by TestBuilder
+void ClearTokenArena(TokenArena& arena)
+{
+    TEST_Tracer("ClearTokenArena");
+    methodHitMap["ClearTokenArena"]++;
+    if(FunctionInjections.count("ClearTokenArena") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&arena));
+    FunctionInjections["ClearTokenArena"](p);
+    }
+    ClearTokenArena_INTERNAL(arena);
+}
+
+
+void MoveTokenArena(TokenArena& into, TokenArena& from);
+
+void MoveTokenArena_INTERNAL(TokenArena& into, TokenArena& from)
+{
+    if(into.Blocks.empty())
+    {
+        into.Blocks.swap(from.Blocks);
+        into.Used = from.Used;
+    }
+    else
+    {
+        auto last = into.Blocks.end() - 1;
+        into.Blocks.insert(last, std::make_move_iterator(from.Blocks.begin()), std::make_move_iterator(from.Blocks.end()));
+    }
+
+    from.Blocks.clear();
+    from.Used = TokenArenaBlockSize;
+}
+
+// generated by TestBuilder
+void MoveTokenArena(TokenArena& into, TokenArena& from)
+{
+    TEST_Tracer("MoveTokenArena");
+    methodHitMap["MoveTokenArena"]++;
+    if(FunctionInjections.count("MoveTokenArena") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&into));
+    p.push_back(static_cast<const void*>(&from));
+    FunctionInjections["MoveTokenArena"](p);
+    }
+    MoveTokenArena_INTERNAL(into, from);
+}
+
+
+
+enum CharClass : unsigned char
+{
+    CharSpace = 1,                  // separates tokens
+    CharSingleton = 2,              // is a token on its own
+    CharDoubleStart = 4,            // may start a two character token
+    CharDigit = 8,
+    CharQuote = 16,                 // starts a string
+};
+
+const String SingletonChars = "!@#$%^*()-+=[]{}\\:;<>,./?~`&|";
+const String DoubledChars = "&&||==!=>=<='s";
+
+const char DecimalPoint = '.';
+const char CommentChar = '#';
+
+
+std::vector<unsigned char> CharClassTable()
+{
+    std::vector<unsigned char> table(256, 0);
+    table[static_cast<unsigned char>(' ')] |= CharSpace;
+    table[static_cast<unsigned char>('"')] |= CharQuote;
+
+    for(char c: SingletonChars)
+        table[static_cast<unsigned char>(c)] |= CharSingleton;
+
+    for(size_t i=0; i<DoubledChars.size(); i+=2)
+        table[static_cast<unsigned char>(DoubledChars[i])] |= CharDoubleStart;
+
+    for(char c='0'; c<='9'; c++)
+        table[static_cast<unsigned char>(c)] |= CharDigit;
+
+    return table;
+}
+
+const std::vector<unsigned char> CharClasses = CharClassTable();
+
+
+inline bool CharIs(char c, CharClass charClass);
+
+inline bool CharIs_INTERNAL(char c, CharClass charClass)
+{
+    return CharClasses[static_cast<unsigned char>(c)] & charClass;
+}
+
+// generated by TestBuilder
+inline bool CharIs(char c, CharClass charClass)
+{
+    TEST_Tracer("CharIs");
+    methodHitMap["CharIs"]++;
+    if(FunctionInjections.count("CharIs") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&c));
+    p.push_back(static_cast<const void*>(&charClass));
+    FunctionInjections["CharIs"](p);
+    }
+    return CharIs_INTERNAL(c, charClass);
+}
+
+
+
+
+std::string ToLowerCase(const std::string& str)
+{
+    std::string lowerCaseStr = "";
+    for(size_t i=0; i<str.size(); i++)
+    {
+        lowerCaseStr += std::tolower(str.at(i));
+    }
+    return lowerCaseStr;
+}
+
+
+bool IsDoubleCharToken(std::string_view line, size_t position)
+{
+    if(position + 1 >= line.size() || !CharIs(line[position], CharDoubleStart))
+        return false;
+    
+    for(size_t i=0; i<DoubledChars.size(); i+=2)
+    {
+        if(line[position] == DoubledChars[i] && line[position+1] == DoubledChars[i+1])
+            return true;
+    }
+
+    return false;
+}
+
+
+bool IsActuallyDecimalPoint(std::string_view line, size_t position)
+{
+    return (position > 0 && CharIs(line[position-1], CharDigit)) &&
+        (position + 1 < line.size() && CharIs(line[position+1], CharDigit));
+}
+
+
+bool IsBoolean(std::string_view word)
+{
+    if(word.size() != 4 && word.size() != 5)
+        return false;
+
+    String lowerCaseWord = ToLowerCase(String(word));
+    return lowerCaseWord == "true" || lowerCaseWord == "false";
+}
+
+
+TokenType TypeOfWord(std::string_view word, size_t numberOfDigits, size_t numberOfPoints)
+{
+    if(numberOfDigits == word.size())
+    {
+        return TokenType::Integer;
+    }
+    else if(numberOfDigits + numberOfPoints == word.size() && numberOfPoints == 1)
+    {
+        return TokenType::Decimal;
+    }
+    else if(IsBoolean(word))
+    {
+        return TokenType::Boolean;
+    }
+    else if(word[0] >= 'A' && word[0] <= 'Z')
+    {
+        return TokenType::Reference;
+    }
+    else
+    {
+        return TokenType::Simple;
+    }
+}
+
+
+size_t EndOfWord(std::string_view line, size_t position, size_t& numberOfDigits, size_t& numberOfPoints)
+{
+    for(; position < line.size() && !CharIs(line[position], CharSpace); position++)
+    {
+        char c = line[position];
+        if(c == DecimalPoint)
+        {
+            if(!IsActuallyDecimalPoint(line, position))
+                break;
+            numberOfPoints++;
+        }
+        else if(CharIs(c, CharSingleton) || IsDoubleCharToken(line, position))
+        {
+            break;
+        }
+        else if(CharIs(c, CharDigit))
+        {
+            numberOfDigits++;
+        }
+    }
+
+    return position;
+}
+
+
+TokenList LexLine(std::string_view line, TokenArena& arena)
+{
+    TokenList tokens;
+    size_t position = 0;
+    int tokenNumber = 0;
+    while(true)
+    {
+        for(; position < line.size() && CharIs(line[position], CharSpace); position++);
+        if(position >= line.size())
+            break;
+
+        char c = line[position];
+        std::string_view content;
+        TokenType type = TokenType::Simple;
+
+        if(CharIs(c, CharQuote))
+        {
+            size_t end = line.find('"', position + 1);
+            if(end == std::string_view::npos)
+                end = line.size();
+
+            content = line.substr(position + 1, end - position - 1);
+            type = TokenType::String;
+            position = end + 1;
+        }
+        else if(IsDoubleCharToken(line, position))
+        {
+            content = line.substr(position, 2);
+            position += 2;
+        }
+        else if(CharIs(c, CharSingleton))
+        {
+            if(c == CommentChar)
+                break;
+
+            content = line.substr(position, 1);
+            position++;
+        }
+        else
+        {
+            size_t numberOfDigits = 0;
+            size_t numberOfPoints = 0;
+            size_t end = EndOfWord(line, position, numberOfDigits, numberOfPoints);
+
+            content = line.substr(position, end - position);
+            type = TypeOfWord(content, numberOfDigits, numberOfPoints);
+            position = end;
+        }
+
+        tokens.push_back(TokenConstructor(arena, type, content, tokenNumber++));
+    }
+
+    return tokens;
+}
+
+
+std::string GetStringTokenType(TokenType type)
+{
+    std::string typeString;
+    switch(type)
+    {
+        case TokenType::Boolean:
+        typeString = "boolean  ";
+        break;
+
+        case TokenType::Decimal:
+        typeString = "decimal  ";
+        break;
+
+        case TokenType::Integer:
+        typeString = "integer  ";
+        break;
+
+        case TokenType::Reference:
+        typeString = "reference";
+        break;
+
+        case TokenType::Simple:
+        typeString = "simple   ";
+        break;
+
+        case TokenType::String:
+        typeString = "string   ";
+        break;
+
+        default:
+        typeString = "unknown  ";
+        break;
+    }
+
+    return typeString;
+}
+
+
+bool SameLetterOrChar(char c1, char c2);
+
+bool SameLetterOrChar_INTERNAL(char c1, char c2)
+{
+    return std::toupper(c1) == std::toupper(c2);
+}
+
+// generated by TestBuilder
+bool SameLetterOrChar(char c1, char c2)
+{
+    TEST_Tracer("SameLetterOrChar");
+    methodHitMap["SameLetterOrChar"]++;
+    if(FunctionInjections.count("SameLetterOrChar") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&c1));
+    p.push_back(static_cast<const void*>(&c2));
+    FunctionInjections["SameLetterOrChar"](p);
+    }
+    return SameLetterOrChar_INTERNAL(c1, c2);
+}
+
+
+bool StringCaseInsensitiveEquals(std::string_view str1, std::string_view str2)
+{
+    if(str1.size() != str2.size())
+        return false;
+
+    for(size_t pos=0; pos<str1.size(); pos++)
+    {
+        if(!SameLetterOrChar(str1.at(pos), str2.at(pos)))
+            return false;
+    }
+    
+    return true;
+}
+
+
+Token* FindToken(const TokenList& tokens, std::string_view str)
+{
+    for(Token* t: tokens)
+    {
+        if(StringCaseInsensitiveEquals(str, t->Content))
+            return t;
+    }
+    return nullptr;
+}
+
+
+void RenumberTokenList(TokenList& tokens);
+
+void RenumberTokenList_INTERNAL(TokenList& tokens)
+{
+    for(int i=0; static_cast<size_t>(i)<tokens.size(); i++)
+    {
+        tokens.at(i)->Position = i;
+    }
+}
+
+// generated by TestBuilder
+void RenumberTokenList(TokenList& tokens)
+{
+    TEST_Tracer("RenumberTokenList");
+    methodHitMap["RenumberTokenList"]++;
+    if(FunctionInjections.count("RenumberTokenList") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    FunctionInjections["RenumberTokenList"](p);
+    }
+    RenumberTokenList_INTERNAL(tokens);
+}
+
+
+
+
+TokenList RightOfToken(const TokenList& tokens, Token* pivotToken);
+
+TokenList RightOfToken_INTERNAL(const TokenList& tokens, Token* pivotToken)
+{
+    TokenList rightList;
+    rightList.reserve(tokens.size());
+
+    for(int i=pivotToken->Position + 1; static_cast<size_t>(i)<tokens.size(); i++)
+        rightList.push_back(tokens.at(i));
+    
+    RenumberTokenList(rightList);
+    return rightList;
+}
+
+// generated by TestBuilder
+TokenList RightOfToken(const TokenList& tokens, Token* pivotToken)
+{
+    TEST_Tracer("RightOfToken");
+    methodHitMap["RightOfToken"]++;
+    if(FunctionInjections.count("RightOfToken") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&pivotToken));
+    FunctionInjections["RightOfToken"](p);
+    }
+    return RightOfToken_INTERNAL(tokens, pivotToken);
+}
+
+
+TokenList LeftOfToken(const TokenList& tokens, Token* pivotToken);
+
+TokenList LeftOfToken_INTERNAL(const TokenList& tokens, Token* pivotToken)
+{
+    TokenList leftList;
+    leftList.reserve(tokens.size());
+
+    for(int i=0; i<pivotToken->Position; i++)
+        leftList.push_back(tokens.at(i));
+    
+    RenumberTokenList(leftList);
+    return leftList;
+}
+
+// generated by TestBuilder
+TokenList LeftOfToken(const TokenList& tokens, Token* pivotToken)
+{
+    TEST_Tracer("LeftOfToken");
+    methodHitMap["LeftOfToken"]++;
+    if(FunctionInjections.count("LeftOfToken") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&pivotToken));
+    FunctionInjections["LeftOfToken"](p);
+    }
+    return LeftOfToken_INTERNAL(tokens, pivotToken);
+}
+
+
+
+bool TokenMatchesType(Token* token, std::vector<TokenType> types)
+{
+    for(TokenType type: types)
+    {
+        if(type == token->Type)
+            return true;
+    }
+    return false;
+}
+
+
+bool TokenMatchesType(Token* token, TokenType type);
+
+bool TokenMatchesType_INTERNAL(Token* token, TokenType type)
+{
+    std::vector<TokenType> types = { type };
+    return TokenMatchesType(token, types);
+}
+
+// generated by TestBuilder
+bool TokenMatchesType(Token* token, TokenType type)
+{
+    TEST_Tracer("TokenMatchesType");
+    methodHitMap["TokenMatchesType"]++;
+    if(FunctionInjections.count("TokenMatchesType") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["TokenMatchesType"](p);
+    }
+    return TokenMatchesType_INTERNAL(token, type);
+}
+
+
+bool TokenMatchesContent(Token* token, std::vector<String> contents)
+{
+    for(String content: contents)
+    {
+        if(content == token->Content)
+            return true;
+    }
+    return false;
+}
+
+
+bool TokenMatchesContent(Token* token, String content);
+
+bool TokenMatchesContent_INTERNAL(Token* token, String content)
+{
+    std::vector<String> contents = { content };
+    return TokenMatchesContent(token, contents);
+}
+
+// generated by TestBuilder
+bool TokenMatchesContent(Token* token, String content)
+{
+    TEST_Tracer("TokenMatchesContent");
+    methodHitMap["TokenMatchesContent"]++;
+    if(FunctionInjections.count("TokenMatchesContent") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&token));
+    p.push_back(static_cast<const void*>(&content));
+    FunctionInjections["TokenMatchesContent"](p);
+    }
+    return TokenMatchesContent_INTERNAL(token, content);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, std::vector<TokenType> types, int& pos)
+{
+    for(; static_cast<size_t>(pos)<tokens.size(); pos++)
+    {
+        if(TokenMatchesType(tokens.at(pos), types))
+            return tokens.at(pos++);
+    }
+    pos = -1;
+    return nullptr;
+}
+
+
+
+Token* NextTokenMatching(const TokenList& tokens, TokenType type, int& pos);
+
+Token* NextTokenMatching_INTERNAL(const TokenList& tokens, TokenType type, int& pos)
+{
+    std::vector<TokenType> types = { type };
+    return NextTokenMatching(tokens, types, pos);
+}
+
+// generated by TestBuilder
+Token* NextTokenMatching(const TokenList& tokens, TokenType type, int& pos)
+{
+    TEST_Tracer("NextTokenMatching");
+    methodHitMap["NextTokenMatching"]++;
+    if(FunctionInjections.count("NextTokenMatching") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&type));
+    p.push_back(static_cast<const void*>(&pos));
+    FunctionInjections["NextTokenMatching"](p);
+    }
+    return NextTokenMatching_INTERNAL(tokens, type, pos);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, TokenType type);
+
+Token* NextTokenMatching_INTERNAL(const TokenList& tokens, TokenType type)
+{
+    int i = 0;
+    return NextTokenMatching(tokens, type, i);
+}
+
+// generated by TestBuilder
+Token* NextTokenMatching(const TokenList& tokens, TokenType type)
+{
+    TEST_Tracer("NextTokenMatching");
+    methodHitMap["NextTokenMatching"]++;
+    if(FunctionInjections.count("NextTokenMatching") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&type));
+    FunctionInjections["NextTokenMatching"](p);
+    }
+    return NextTokenMatching_INTERNAL(tokens, type);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, std::vector<TokenType> types)
+{
+    int i = 0;
+    return NextTokenMatching(tokens, types, i);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, std::vector<String> contents, int& pos)
+{
+    for(; static_cast<size_t>(pos)<tokens.size(); pos++)
+    {
+        if(TokenMatchesContent(tokens.at(pos), contents))
+            return tokens.at(pos++);
+    }
+    pos = -1;
+    return nullptr;
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, std::vector<String> contents)
+{
+    int pos = 0;
+    return NextTokenMatching(tokens, contents, pos);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, String content, int& pos);
+
+Token* NextTokenMatching_INTERNAL(const TokenList& tokens, String content, int& pos)
+{
+    std::vector<String> contents = { content };
+    return NextTokenMatching(tokens, contents, pos);
+}
+
+// generated by TestBuilder
+Token* NextTokenMatching(const TokenList& tokens, String content, int& pos)
+{
+    TEST_Tracer("NextTokenMatching");
+    methodHitMap["NextTokenMatching"]++;
+    if(FunctionInjections.count("NextTokenMatching") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&content));
+    p.push_back(static_cast<const void*>(&pos));
+    FunctionInjections["NextTokenMatching"](p);
+    }
+    return NextTokenMatching_INTERNAL(tokens, content, pos);
+}
+
+
+Token* NextTokenMatching(const TokenList& tokens, String content);
+
+Token* NextTokenMatching_INTERNAL(const TokenList& tokens, String content)
+{
+    int pos = 0;
+    return NextTokenMatching(tokens, content, pos);
+}
+
+// generated by TestBuilder
+Token* NextTokenMatching(const TokenList& tokens, String content)
+{
+    TEST_Tracer("NextTokenMatching");
+    methodHitMap["NextTokenMatching"]++;
+    if(FunctionInjections.count("NextTokenMatching") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&tokens));
+    p.push_back(static_cast<const void*>(&content));
+    FunctionInjections["NextTokenMatching"](p);
+    }
+    return NextTokenMatching_INTERNAL(tokens, content);
+}
+
+
+
+bool TokenListContainsContent(const TokenList& tokenList, std::vector<String> contents)
+{
+    for(Token* t: tokenList)
+    {
+        if(TokenMatchesContent(t, contents))
+            return true;
+    }
+    return false;
+}
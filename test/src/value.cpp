@@ -0,0 +1,136 @@
+#include "test.h"
+#include <iostream>
+
+#include "value.h"
+
+
+void StringDestructor(String* s);
+
+void StringDestructor_INTERNAL(String* s)
+{
+    delete s;
+}
+
+// generated by TestBuilder
+void StringDestructor(String* s)
+{
+    TEST_Tracer("StringDestructor");
+    methodHitMap["StringDestructor"]++;
+    if(FunctionInjections.count("StringDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&s));
+    FunctionInjections["StringDestructor"](p);
+    }
+    StringDestructor_INTERNAL(s);
+}
+
+
+String* StringConstructor(const String& value);
+
+String* StringConstructor_INTERNAL(const String& value)
+{
+    std::string* s = new std::string;
+    *s = value;
+    return s;
+}
+
+// generated by TestBuilder
+String* StringConstructor(const String& value)
+{
+    TEST_Tracer("StringConstructor");
+    methodHitMap["StringConstructor"]++;
+    if(FunctionInjections.count("StringConstructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["StringConstructor"](p);
+    }
+    return StringConstructor_INTERNAL(value);
+}
+
+
+void AssignValue(Value& v, const String& value);
+
+void AssignValue_INTERNAL(Value& v, const String& value)
+{
+    v.s = StringConstructor(value);
+}
+
+// generated by TestBuilder
+void AssignValue(Value& v, const String& value)
+{
+    TEST_Tracer("AssignValue");
+    methodHitMap["AssignValue"]++;
+    if(FunctionInjections.count("AssignValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&v));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["AssignValue"](p);
+    }
+    AssignValue_INTERNAL(v, value);
+}
+
+
+void AssignValue(Value& v, bool value);
+
+void AssignValue_INTERNAL(Value& v, bool value)
+{
+    v.b = value;
+}
+
+// generated by TestBuilder
+void AssignValue(Value& v, bool value)
+{
+    TEST_Tracer("AssignValue");
+    methodHitMap["AssignValue"]++;
+    if(FunctionInjections.count("AssignValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&v));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["AssignValue"](p);
+    }
+    AssignValue_INTERNAL(v, value);
+}
+
+
+void AssignValue(Value& v, double value);
+
+void AssignValue_INTERNAL(Value& v, double value)
+{
+    v.d = value;
+}
+
+// generated by TestBuilder
+void AssignValue(Value& v, double value)
+{
+    TEST_Tracer("AssignValue");
+    methodHitMap["AssignValue"]++;
+    if(FunctionInjections.count("AssignValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&v));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["AssignValue"](p);
+    }
+    AssignValue_INTERNAL(v, value);
+}
+
+
+void AssignValue(Value& v, int value);
+
+void AssignValue_INTERNAL(Value& v, int value)
+{
+    v.i = value;
+}
+
+// generated by TestBuilder
+void AssignValue(Value& v, int value)
+{
+    TEST_Tracer("AssignValue");
+    methodHitMap["AssignValue"]++;
+    if(FunctionInjections.count("AssignValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&v));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["AssignValue"](p);
+    }
+    AssignValue_INTERNAL(v, value);
+}
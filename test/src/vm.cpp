@@ -0,0 +1,973 @@
+#include "test.h"
+#include <unordered_set>
+
+#include "vm.h"
+
+#include "bytecode.h"
+#include "gc.h"
+#include "fusion.h"
+#include "jit.h"
+#include "errormsg.h"
+#include "dis.h"
+#include "flattener.h"
+
+#include "object.h"
+#include "scope.h"
+#include "reference.h"
+#include "diagnostics.h"
+#include "program.h"
+#include "main.h"
+#include "program.h"
+#include "call.h"
+#include "value.h"
+
+
+
+String* SimpleCallNames[] = {
+    &ObjectType,
+    &NothingType,
+    &ArrayType,
+    &IntegerType,
+    &DecimalType,
+    &StringType,
+    &BooleanType,
+    &AnythingType,
+};
+
+
+
+
+template <typename T>
+inline Call* IfStillMatches(Call* call, T value)
+{
+    if(call != nullptr && ValueMatchesPrimitiveCall(value, call))
+    {
+        return call;
+    }
+    return nullptr;
+}
+
+
+Call* FindPrimitiveCall(PebbleVM* vm, int value);
+
+Call* FindPrimitiveCall_INTERNAL(PebbleVM* vm, int value)
+{
+    auto entry = vm->IntegerPrimitives.find(value);
+    return entry == vm->IntegerPrimitives.end() ? nullptr : IfStillMatches(entry->second, value);
+}
+
+// generated by TestBuilder
+Call* FindPrimitiveCall(PebbleVM* vm, int value)
+{
+    TEST_Tracer("FindPrimitiveCall");
+    methodHitMap["FindPrimitiveCall"]++;
+    if(FunctionInjections.count("FindPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["FindPrimitiveCall"](p);
+    }
+    return FindPrimitiveCall_INTERNAL(vm, value);
+}
+
+
+Call* FindPrimitiveCall(PebbleVM* vm, double value);
+
+Call* FindPrimitiveCall_INTERNAL(PebbleVM* vm, double value)
+{
+    auto entry = vm->DecimalPrimitives.find(value);
+    return entry == vm->DecimalPrimitives.end() ? nullptr : IfStillMatches(entry->second, value);
+}
+
+// generated by TestBuilder
+Call* FindPrimitiveCall(PebbleVM* vm, double value)
+{
+    TEST_Tracer("FindPrimitiveCall");
+    methodHitMap["FindPrimitiveCall"]++;
+    if(FunctionInjections.count("FindPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["FindPrimitiveCall"](p);
+    }
+    return FindPrimitiveCall_INTERNAL(vm, value);
+}
+
+
+Call* FindPrimitiveCall(PebbleVM* vm, bool value);
+
+Call* FindPrimitiveCall_INTERNAL(PebbleVM* vm, bool value)
+{
+    return IfStillMatches(vm->BooleanPrimitives[value], value);
+}
+
+// generated by TestBuilder
+Call* FindPrimitiveCall(PebbleVM* vm, bool value)
+{
+    TEST_Tracer("FindPrimitiveCall");
+    methodHitMap["FindPrimitiveCall"]++;
+    if(FunctionInjections.count("FindPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["FindPrimitiveCall"](p);
+    }
+    return FindPrimitiveCall_INTERNAL(vm, value);
+}
+
+
+Call* FindPrimitiveCall(PebbleVM* vm, const String& value);
+
+Call* FindPrimitiveCall_INTERNAL(PebbleVM* vm, const String& value)
+{
+    auto entry = vm->StringPrimitives.find(value);
+    return entry == vm->StringPrimitives.end() ? nullptr : IfStillMatches<const String&>(entry->second, value);
+}
+
+// generated by TestBuilder
+Call* FindPrimitiveCall(PebbleVM* vm, const String& value)
+{
+    TEST_Tracer("FindPrimitiveCall");
+    methodHitMap["FindPrimitiveCall"]++;
+    if(FunctionInjections.count("FindPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&value));
+    FunctionInjections["FindPrimitiveCall"](p);
+    }
+    return FindPrimitiveCall_INTERNAL(vm, value);
+}
+
+
+void AddPrimitiveCall(PebbleVM* vm, Call* call);
+
+void AddPrimitiveCall_INTERNAL(PebbleVM* vm, Call* call)
+{
+    if(call->BoundScope == &NothingScope)
+    {
+        return;
+    }
+
+    if(call->BoundType == &IntegerType)
+    {
+        auto& entry = vm->IntegerPrimitives[call->BoundValue.i];
+        if(IfStillMatches(entry, (int)call->BoundValue.i) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &DecimalType)
+    {
+        auto& entry = vm->DecimalPrimitives[call->BoundValue.d];
+        if(IfStillMatches(entry, call->BoundValue.d) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &BooleanType)
+    {
+        auto& entry = vm->BooleanPrimitives[call->BoundValue.b];
+        if(IfStillMatches(entry, call->BoundValue.b) == nullptr) entry = call;
+    }
+    else if(call->BoundType == &StringType && call->BoundValue.s != nullptr)
+    {
+        auto& entry = vm->StringPrimitives[*call->BoundValue.s];
+        if(IfStillMatches<const String&>(entry, *call->BoundValue.s) == nullptr) entry = call;
+    }
+}
+
+// generated by TestBuilder
+void AddPrimitiveCall(PebbleVM* vm, Call* call)
+{
+    TEST_Tracer("AddPrimitiveCall");
+    methodHitMap["AddPrimitiveCall"]++;
+    if(FunctionInjections.count("AddPrimitiveCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["AddPrimitiveCall"](p);
+    }
+    AddPrimitiveCall_INTERNAL(vm, call);
+}
+
+
+void ClearPrimitiveTables(PebbleVM* vm);
+
+void ClearPrimitiveTables_INTERNAL(PebbleVM* vm)
+{
+    vm->IntegerPrimitives.clear();
+    vm->DecimalPrimitives.clear();
+    vm->StringPrimitives.clear();
+    vm->BooleanPrimitives[0] = nullptr;
+    vm->BooleanPrimitives[1] = nullptr;
+}
+
+// generated by TestBuilder
+void ClearPrimitiveTables(PebbleVM* vm)
+{
+    TEST_Tracer("ClearPrimitiveTables");
+    methodHitMap["ClearPrimitiveTables"]++;
+    if(FunctionInjections.count("ClearPrimitiveTables") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ClearPrimitiveTables"](p);
+    }
+    ClearPrimitiveTables_INTERNAL(vm);
+}
+
+
+
+Scope NothingScope;
+
+Scope SomethingScope;
+
+Call ObjectCall
+{
+    &ObjectType,
+    &AbstractObjectType,
+    0,
+    &SomethingScope,
+};
+
+Call NothingCall
+{
+    &NothingType,
+    &NothingType,
+    0,
+    &NothingScope,
+};
+
+Call AnythingCall
+{
+    &AnythingType,
+    &AnythingType,
+    0,
+    &NothingScope
+};
+
+Call ArrayCall
+{
+    /*Name*/                &ArrayType,
+    /*BoundType*/           &AbstractArrayType,
+    /*BoundSection*/        0,
+    /*BoundScope*/          &SomethingScope,
+    /*CallType*/            &AbstractArrayType,
+    /*BoundValue*/          0,
+    /*NumberOfParamters*/   1,
+};
+
+Call IntegerCall
+{
+    &IntegerType,
+    &AbstractIntegerType,
+    0,
+    &SomethingScope,
+};
+
+Call DecimalCall
+{
+    &DecimalType,
+    &AbstractDecimalType,
+    0,
+    &SomethingScope,
+};
+
+Call StringCall
+{
+    &StringType,
+    &AbstractStringType,
+    0,
+    &SomethingScope,
+};
+
+Call BooleanCall
+{
+    &BooleanType,
+    &AbstractBooleanType,
+    0,
+    &SomethingScope,
+};
+
+
+
+const String SizeCallName = "Size";
+const String ArrayElementCallName = "?";
+
+
+void ResolveSizeCallName(PebbleVM* vm);
+
+void ResolveSizeCallName_INTERNAL(PebbleVM* vm)
+{
+    vm->SizeCallNamePointer = &SizeCallName;
+    for(auto& name: vm->CallNames)
+    {
+        if(name == SizeCallName)
+        {
+            vm->SizeCallNamePointer = &name;
+            return;
+        }
+    }
+}
+
+// generated by TestBuilder
+void ResolveSizeCallName(PebbleVM* vm)
+{
+    TEST_Tracer("ResolveSizeCallName");
+    methodHitMap["ResolveSizeCallName"]++;
+    if(FunctionInjections.count("ResolveSizeCallName") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ResolveSizeCallName"](p);
+    }
+    ResolveSizeCallName_INTERNAL(vm);
+}
+
+
+void AddSimpleCallsToProgramScope(PebbleVM* vm);
+
+void AddSimpleCallsToProgramScope_INTERNAL(PebbleVM* vm)
+{
+    AddCallToScope(&ObjectCall, vm->ProgramReg);
+    AddCallToScope(&NothingCall, vm->ProgramReg);
+    AddCallToScope(&ArrayCall, vm->ProgramReg);
+    AddCallToScope(&IntegerCall, vm->ProgramReg);
+    AddCallToScope(&DecimalCall, vm->ProgramReg);
+    AddCallToScope(&StringCall, vm->ProgramReg);
+    AddCallToScope(&BooleanCall, vm->ProgramReg);
+    AddCallToScope(&AnythingCall, vm->ProgramReg);
+}
+
+// generated by TestBuilder
+void AddSimpleCallsToProgramScope(PebbleVM* vm)
+{
+    TEST_Tracer("AddSimpleCallsToProgramScope");
+    methodHitMap["AddSimpleCallsToProgramScope"]++;
+    if(FunctionInjections.count("AddSimpleCallsToProgramScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["AddSimpleCallsToProgramScope"](p);
+    }
+    AddSimpleCallsToProgramScope_INTERNAL(vm);
+}
+
+
+
+void InitRuntime(PebbleVM* vm);
+
+void InitRuntime_INTERNAL(PebbleVM* vm)
+{
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+
+    vm->RuntimeCalls.clear();
+    vm->RuntimeCalls.reserve(256);
+
+    vm->RuntimeCalls = { &ObjectCall, &NothingCall, &ArrayCall, &IntegerCall,
+        &DecimalCall, &StringCall, &BooleanCall, &AnythingCall };
+
+    vm->RuntimeScopes.clear();
+    vm->RuntimeScopes.reserve(256);
+
+    vm->CallStack.clear();
+    vm->CallStack.reserve(CallStackReservedFrames);
+
+    vm->LocalScopes.clear();
+    vm->LocalScopes.reserve(CallStackReservedFrames);
+    
+    vm->CallStack.push_back( {programEnd, 0, 0, 0, nullptr });
+    vm->MaxCallStackSize = vm->CallStack.size();
+
+    vm->CallerReg = &NothingCall;
+    vm->SelfReg = &NothingCall;
+
+    vm->MemoryStack.clear();
+    vm->MemoryStack.reserve(256);
+
+    vm->MemoryStack.push_back(vm->CallerReg);
+    vm->MemoryStack.push_back(vm->SelfReg);
+
+    ResolveSizeCallName(vm);
+
+    ClearPrimitiveTables(vm);
+    for(auto call: vm->ConstPrimitives)
+    {
+        AddPrimitiveCall(vm, call);
+    }
+
+    vm->ProgramReg = ScopeConstructor(vm->ScopeSlab, nullptr);
+    vm->LocalScopeReg = vm->ProgramReg;
+    AddSimpleCallsToProgramScope(vm);
+
+    InitGarbageCollector(vm);
+
+    vm->FusionStats.ExecutedInstructions = 0;
+    vm->FusionStats.ExecutedSuperinstructions = 0;
+    vm->FusionStats.ReplacedDispatches = 0;
+
+    vm->FatalErrorOccured = false;
+    vm->ErrorFlag = false;
+
+    vm->InstructionReg = 0;
+
+    vm->JumpStatusReg = 0;
+    vm->LocalScopeIsDetachedReg = false;
+    vm->LastResultReg = nullptr;
+    vm->CmpReg = CmpRegDefaultValue;
+}
+
+// generated by TestBuilder
+void InitRuntime(PebbleVM* vm)
+{
+    TEST_Tracer("InitRuntime");
+    methodHitMap["InitRuntime"]++;
+    if(FunctionInjections.count("InitRuntime") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["InitRuntime"](p);
+    }
+    InitRuntime_INTERNAL(vm);
+}
+
+
+
+
+PebbleVM* PebbleVMConstructor();
+
+PebbleVM* PebbleVMConstructor_INTERNAL()
+{
+    return new PebbleVM();
+}
+
+// generated by TestBuilder
+PebbleVM* PebbleVMConstructor()
+{
+    TEST_Tracer("PebbleVMConstructor");
+    methodHitMap["PebbleVMConstructor"]++;
+    if(FunctionInjections.count("PebbleVMConstructor") == 1){
+    Params p;
+    FunctionInjections["PebbleVMConstructor"](p);
+    }
+    return PebbleVMConstructor_INTERNAL();
+}
+
+
+void PebbleVMDestructor(PebbleVM* vm);
+
+void PebbleVMDestructor_INTERNAL(PebbleVM* vm)
+{
+    ReleaseNativeCode(vm);
+    ReleaseConstPrimitives(vm);
+    delete vm;
+}
+
+// generated by TestBuilder
+void PebbleVMDestructor(PebbleVM* vm)
+{
+    TEST_Tracer("PebbleVMDestructor");
+    methodHitMap["PebbleVMDestructor"]++;
+    if(FunctionInjections.count("PebbleVMDestructor") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["PebbleVMDestructor"](p);
+    }
+    PebbleVMDestructor_INTERNAL(vm);
+}
+
+
+
+constexpr uint8_t HaltOp = OP_NumberOfInstructions;
+
+
+void DecodeByteCodeProgram(PebbleVM* vm);
+
+void DecodeByteCodeProgram_INTERNAL(PebbleVM* vm)
+{
+    extArg_t programEnd = vm->ByteCodeProgram.size();
+    vm->DecodedProgram.clear();
+    vm->DecodedProgram.reserve(programEnd + 1);
+
+    for(auto& ins: vm->ByteCodeProgram)
+    {
+        vm->DecodedProgram.push_back({ nullptr, ins.Arg, ins.Op });
+    }
+
+    vm->DecodedProgram.push_back({ nullptr, programEnd, HaltOp });
+}
+
+// generated by TestBuilder
+void DecodeByteCodeProgram(PebbleVM* vm)
+{
+    TEST_Tracer("DecodeByteCodeProgram");
+    methodHitMap["DecodeByteCodeProgram"]++;
+    if(FunctionInjections.count("DecodeByteCodeProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["DecodeByteCodeProgram"](p);
+    }
+    DecodeByteCodeProgram_INTERNAL(vm);
+}
+
+
+void TraceCurrentInstruction(PebbleVM* vm, bool shouldLog);
+
+void TraceCurrentInstruction_INTERNAL(PebbleVM* vm, bool shouldLog)
+{
+    if(g_fusionStatsOn)
+    {
+        CountExecutedInstruction(vm->FusionStats, vm->DecodedProgram[vm->InstructionReg].Op);
+    }
+
+    if(g_profileOpsOn)
+    {
+        ProfileInstruction(vm->OpProfile, vm->DecodedProgram[vm->InstructionReg].Op);
+    }
+
+    if(shouldLog)
+    {
+        LogItDebug(Msg("%i: %s", (int)vm->InstructionReg, ToString(vm, vm->ByteCodeProgram[vm->InstructionReg])));
+    }
+}
+
+// generated by TestBuilder
+void TraceCurrentInstruction(PebbleVM* vm, bool shouldLog)
+{
+    TEST_Tracer("TraceCurrentInstruction");
+    methodHitMap["TraceCurrentInstruction"]++;
+    if(FunctionInjections.count("TraceCurrentInstruction") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&shouldLog));
+    FunctionInjections["TraceCurrentInstruction"](p);
+    }
+    TraceCurrentInstruction_INTERNAL(vm, shouldLog);
+}
+
+
+
+bool HasBeenDestroyed(String* value, std::unordered_set<String*>& destroyedValues)
+{
+    if(value == nullptr)
+        return true;
+
+    return !destroyedValues.insert(value).second;
+}
+
+
+bool ShouldDestroyValue(const Call* call);
+
+bool ShouldDestroyValue_INTERNAL(const Call* call)
+{
+    return call->BoundType == &StringType && call->BoundScope != &NothingScope;
+}
+
+// generated by TestBuilder
+bool ShouldDestroyValue(const Call* call)
+{
+    TEST_Tracer("ShouldDestroyValue");
+    methodHitMap["ShouldDestroyValue"]++;
+    if(FunctionInjections.count("ShouldDestroyValue") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["ShouldDestroyValue"](p);
+    }
+    return ShouldDestroyValue_INTERNAL(call);
+}
+
+
+void DeleteCallValue(Call* call, std::unordered_set<String*>& destroyedValues)
+{
+    if(ShouldDestroyValue(call) && !HasBeenDestroyed(call->BoundValue.s, destroyedValues))
+    {
+        StringDestructor(call->BoundValue.s);
+    }
+}
+
+
+void GracefullyExit(PebbleVM* vm);
+
+void GracefullyExit_INTERNAL(PebbleVM* vm)
+{
+    ClearPrimitiveTables(vm);
+
+    std::unordered_set<String*> destroyedValues;
+    destroyedValues.reserve(vm->RuntimeCalls.size() + vm->ConstPrimitives.size());
+    for(auto call: vm->ConstPrimitives)
+    {
+        if(ShouldDestroyValue(call))
+        {
+            destroyedValues.insert(call->BoundValue.s);
+        }
+    }
+
+    for(size_t i=SIMPLE_CALLS; i<vm->RuntimeCalls.size(); i++)
+    {
+        DeleteCallValue(vm->RuntimeCalls[i], destroyedValues);
+    }
+    vm->RuntimeCalls.resize(SIMPLE_CALLS);
+
+    for(auto scope: vm->RuntimeScopes)
+    {
+        ReleaseScopeStorage(scope);
+    }
+    vm->RuntimeScopes.clear();
+
+    ReleaseScopeStorage(vm->ProgramReg);
+    vm->ProgramReg = nullptr;
+    ReleaseNativeCode(vm);
+
+    ReleaseAllCalls(vm->CallSlab);
+    ReleaseAllScopes(vm->ScopeSlab);
+}
+
+// generated by TestBuilder
+void GracefullyExit(PebbleVM* vm)
+{
+    TEST_Tracer("GracefullyExit");
+    methodHitMap["GracefullyExit"]++;
+    if(FunctionInjections.count("GracefullyExit") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["GracefullyExit"](p);
+    }
+    GracefullyExit_INTERNAL(vm);
+}
+
+
+void ReleaseConstPrimitives(PebbleVM* vm);
+
+void ReleaseConstPrimitives_INTERNAL(PebbleVM* vm)
+{
+    std::unordered_set<String*> destroyedValues;
+    for(auto call: vm->ConstPrimitives)
+    {
+        DeleteCallValue(call, destroyedValues);
+    }
+
+    vm->ConstPrimitives.clear();
+    ReleaseAllCalls(vm->PrimitiveSlab);
+}
+
+// generated by TestBuilder
+void ReleaseConstPrimitives(PebbleVM* vm)
+{
+    TEST_Tracer("ReleaseConstPrimitives");
+    methodHitMap["ReleaseConstPrimitives"]++;
+    if(FunctionInjections.count("ReleaseConstPrimitives") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    FunctionInjections["ReleaseConstPrimitives"](p);
+    }
+    ReleaseConstPrimitives_INTERNAL(vm);
+}
+
+
+
+#ifdef __GNUC__
+#define PEBBLE_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#ifdef PEBBLE_THREADED_DISPATCH
+#define DISPATCH goto *vm->DecodedProgram[vm->InstructionReg].Target
+#else
+#define DISPATCH goto dispatch
+#endif
+
+#define CURRENT_ARG vm->DecodedProgram[vm->InstructionReg].Arg
+
+
+int DoByteCodeProgram(PebbleVM* vm, Program* p);
+
+int DoByteCodeProgram_INTERNAL(PebbleVM* vm, Program* p)
+{
+    InitRuntime(vm);
+    DecodeByteCodeProgram(vm);
+
+    bool shouldLogInstructions = LogAtLevel == LogSeverityType::Sev0_Debug;
+    bool shouldTraceInstructions = shouldLogInstructions || g_fusionStatsOn || g_profileOpsOn;
+    if(g_profileOpsOn)
+    {
+        StartInstructionProfile(vm);
+    }
+
+    bool useJit = g_jitOn && JitIsSupported() && !shouldTraceInstructions;
+
+    bool tailEvalEntersSection = false;
+
+    #define SIMPLE_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            vm->InstructionReg++; \
+            DISPATCH;
+
+    #define CHECKED_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            vm->InstructionReg++; \
+            DISPATCH;
+
+    #define JUMPING_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++; \
+            DISPATCH;
+
+    #define EVAL_OP(name) \
+        op_##name: \
+            BCI_##name(vm, CURRENT_ARG); \
+            if(vm->ErrorFlag) goto error; \
+            if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; if(useJit) CountSectionEntry(vm, vm->InstructionReg); } else vm->InstructionReg++; \
+            DISPATCH;
+
+#ifdef PEBBLE_THREADED_DISPATCH
+    static void* handlers[] = {
+        &&op_LoadCallName, &&op_LoadPrimitive, &&op_Assign, &&op_Add, &&op_Subtract,
+        &&op_Multiply, &&op_Divide, &&op_SysCall, &&op_And, &&op_Or,
+        &&op_Not, &&op_NotEquals, &&op_Equals, &&op_Cmp, &&op_LoadCmp,
+        &&op_JumpFalse, &&op_Jump, &&op_Copy, &&op_BindType, &&op_ResolveDirect,
+        &&op_ResolveScoped, &&op_BindScope, &&op_BindSection, &&op_EvalHere, &&op_Eval,
+        &&op_Return, &&op_Array, &&op_EnterLocal, &&op_LeaveLocal, &&op_NOP,
+        &&op_Dup, &&op_EndLine, &&op_DropTOS, &&op_Is, &&op_LoadLocal,
+        &&op_StoreLocal, &&op_ResolveName, &&op_AddConst, &&op_SubtractConst, &&op_CmpJumpFalse,
+        &&op_TailEval,
+        &&halt, &&op_Native,
+    };
+
+    for(auto& ins: vm->DecodedProgram)
+    {
+        ins.Target = (shouldTraceInstructions && ins.Op != HaltOp) ? &&trace : handlers[ins.Op];
+    }
+
+    if(useJit)
+    {
+        InitJit(vm, &&op_Native);
+    }
+    DISPATCH;
+
+    trace:
+        TraceCurrentInstruction(vm, shouldLogInstructions);
+        goto *handlers[vm->DecodedProgram[vm->InstructionReg].Op];
+#else
+    if(useJit)
+    {
+        InitJit(vm, nullptr);
+    }
+
+    dispatch:
+        if(shouldTraceInstructions && vm->DecodedProgram[vm->InstructionReg].Op != HaltOp)
+        {
+            TraceCurrentInstruction(vm, shouldLogInstructions);
+        }
+
+        switch(vm->DecodedProgram[vm->InstructionReg].Op)
+        {
+            case OP_LoadCallName:   goto op_LoadCallName;
+            case OP_LoadPrimitive:  goto op_LoadPrimitive;
+            case OP_Assign:         goto op_Assign;
+            case OP_Add:            goto op_Add;
+            case OP_Subtract:       goto op_Subtract;
+            case OP_Multiply:       goto op_Multiply;
+            case OP_Divide:         goto op_Divide;
+            case OP_SysCall:        goto op_SysCall;
+            case OP_And:            goto op_And;
+            case OP_Or:             goto op_Or;
+            case OP_Not:            goto op_Not;
+            case OP_NotEquals:      goto op_NotEquals;
+            case OP_Equals:         goto op_Equals;
+            case OP_Cmp:            goto op_Cmp;
+            case OP_LoadCmp:        goto op_LoadCmp;
+            case OP_JumpFalse:      goto op_JumpFalse;
+            case OP_Jump:           goto op_Jump;
+            case OP_Copy:           goto op_Copy;
+            case OP_BindType:       goto op_BindType;
+            case OP_ResolveDirect:  goto op_ResolveDirect;
+            case OP_ResolveScoped:  goto op_ResolveScoped;
+            case OP_BindScope:      goto op_BindScope;
+            case OP_BindSection:    goto op_BindSection;
+            case OP_EvalHere:       goto op_EvalHere;
+            case OP_Eval:           goto op_Eval;
+            case OP_Return:         goto op_Return;
+            case OP_Array:          goto op_Array;
+            case OP_EnterLocal:     goto op_EnterLocal;
+            case OP_LeaveLocal:     goto op_LeaveLocal;
+            case OP_NOP:            goto op_NOP;
+            case OP_Dup:            goto op_Dup;
+            case OP_EndLine:        goto op_EndLine;
+            case OP_DropTOS:        goto op_DropTOS;
+            case OP_Is:             goto op_Is;
+            case OP_LoadLocal:      goto op_LoadLocal;
+            case OP_StoreLocal:     goto op_StoreLocal;
+            case OP_ResolveName:    goto op_ResolveName;
+            case OP_AddConst:       goto op_AddConst;
+            case OP_SubtractConst:  goto op_SubtractConst;
+            case OP_CmpJumpFalse:   goto op_CmpJumpFalse;
+            case OP_TailEval:       goto op_TailEval;
+            case HaltOp:            goto halt;
+            case NativeOp:          goto op_Native;
+            default:                goto halt;
+        }
+#endif
+
+    SIMPLE_OP(LoadCallName)
+    SIMPLE_OP(LoadPrimitive)
+    CHECKED_OP(Assign)
+    CHECKED_OP(Add)
+    CHECKED_OP(Subtract)
+
+    CHECKED_OP(Multiply)
+    CHECKED_OP(Divide)
+    SIMPLE_OP(SysCall)
+    CHECKED_OP(And)
+    CHECKED_OP(Or)
+
+    CHECKED_OP(Not)
+    SIMPLE_OP(NotEquals)
+    SIMPLE_OP(Equals)
+    CHECKED_OP(Cmp)
+    SIMPLE_OP(LoadCmp)
+
+    JUMPING_OP(JumpFalse)
+    SIMPLE_OP(Copy)
+    SIMPLE_OP(BindType)
+    SIMPLE_OP(ResolveDirect)
+
+    SIMPLE_OP(ResolveScoped)
+    SIMPLE_OP(BindScope)
+    SIMPLE_OP(BindSection)
+    EVAL_OP(EvalHere)
+    EVAL_OP(Eval)
+
+    JUMPING_OP(Return)
+    CHECKED_OP(Array)
+    SIMPLE_OP(EnterLocal)
+    SIMPLE_OP(LeaveLocal)
+    SIMPLE_OP(NOP)
+
+    SIMPLE_OP(Dup)
+    SIMPLE_OP(DropTOS)
+    CHECKED_OP(Is)
+
+    SIMPLE_OP(LoadLocal)
+    CHECKED_OP(StoreLocal)
+    SIMPLE_OP(ResolveName)
+    CHECKED_OP(AddConst)
+    CHECKED_OP(SubtractConst)
+    JUMPING_OP(CmpJumpFalse)
+
+    op_Jump:
+        if(useJit && CURRENT_ARG < vm->InstructionReg) CountLoopEntry(vm, CURRENT_ARG, vm->InstructionReg);
+        vm->InstructionReg = CURRENT_ARG;
+        DISPATCH;
+
+    op_EndLine:
+        BCI_EndLine(vm, CURRENT_ARG);
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        vm->InstructionReg++;
+        DISPATCH;
+
+    op_TailEval:
+        tailEvalEntersSection = useJit && TailEvalReusesCallFrame(vm, CURRENT_ARG);
+        BCI_TailEval(vm, CURRENT_ARG);
+        if(vm->ErrorFlag) goto error;
+        if(ShouldCollectGarbage(vm)) CollectGarbage(vm);
+        if(tailEvalEntersSection) CountSectionEntry(vm, vm->InstructionReg);
+        if(vm->JumpStatusReg) vm->JumpStatusReg = 0; else vm->InstructionReg++;
+        DISPATCH;
+
+    op_Native:
+        RunNativeCode(vm);
+        if(vm->ErrorFlag) goto error;
+        DISPATCH;
+
+    error:
+        IfNeededDisplayError(vm, p);
+        if(vm->FatalErrorOccured)
+        {
+            if(g_profileOpsOn) FinishInstructionProfile(vm);
+            GracefullyExit(vm);
+            return 1;
+        }
+
+        if(vm->JumpStatusReg)
+        {
+            vm->JumpStatusReg = 0;
+        }
+        else
+        {
+            vm->InstructionReg++;
+        }
+        DISPATCH;
+
+    halt:
+        if(g_profileOpsOn) FinishInstructionProfile(vm);
+        if(LogAtLevel == LogSeverityType::Sev0_Debug)
+        {
+            std::cout << "\nmem#" << vm->MemoryStack.size() << "\n";
+        }
+        GracefullyExit(vm);
+        return 0;
+
+    #undef SIMPLE_OP
+    #undef CHECKED_OP
+    #undef JUMPING_OP
+    #undef EVAL_OP
+}
+
+// generated by TestBuilder
+int DoByteCodeProgram(PebbleVM* vm, Program* p)
+{
+    TEST_Tracer("DoByteCodeProgram");
+    methodHitMap["DoByteCodeProgram"]++;
+    if(FunctionInjections.count("DoByteCodeProgram") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&p));
+    FunctionInjections["DoByteCodeProgram"](p);
+    }
+    return DoByteCodeProgram_INTERNAL(vm, p);
+}
+
+#ifdef PEBBLE_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
+
+
+void AddRuntimeCall(PebbleVM* vm, Call* call);
+
+void AddRuntimeCall_INTERNAL(PebbleVM* vm, Call* call)
+{
+    vm->RuntimeCalls.push_back(call);
+}
+
+// generated by TestBuilder
+void AddRuntimeCall(PebbleVM* vm, Call* call)
+{
+    TEST_Tracer("AddRuntimeCall");
+    methodHitMap["AddRuntimeCall"]++;
+    if(FunctionInjections.count("AddRuntimeCall") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&call));
+    FunctionInjections["AddRuntimeCall"](p);
+    }
+    AddRuntimeCall_INTERNAL(vm, call);
+}
+
+
+void AddRuntimeScope(PebbleVM* vm, Scope* scope);
+
+void AddRuntimeScope_INTERNAL(PebbleVM* vm, Scope* scope)
+{
+    vm->RuntimeScopes.push_back(scope);
+}
+
+// generated by TestBuilder
+void AddRuntimeScope(PebbleVM* vm, Scope* scope)
+{
+    TEST_Tracer("AddRuntimeScope");
+    methodHitMap["AddRuntimeScope"]++;
+    if(FunctionInjections.count("AddRuntimeScope") == 1){
+    Params p;
+    p.push_back(static_cast<const void*>(&vm));
+    p.push_back(static_cast<const void*>(&scope));
+    FunctionInjections["AddRuntimeScope"](p);
+    }
+    AddRuntimeScope_INTERNAL(vm, scope);
+}
@@ -3,6 +3,13 @@
 #include <algorithm>
 #include <random>
 
+#if __unix__ || __APPLE__
+#define PEBBLE_TEST_PROCESSES
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "test.h"
 #include "consolecolor.h"
 #include "unittests.h"
@@ -49,12 +56,21 @@ FLags
     [--trace NAME]      Only runs the program with the specified 'NAME' (see
                         the [--only] flag). In addition, enables log trace 
                         statements which are written to `./logs/log`
+
+    [--jobs N]          Runs each test in a process of its own, with up to 'N'
+                        processes at once. Tests then cannot see the global
+                        state left by another test, and a test which crashes
+                        is reported as a failure instead of ending the run.
+                        Results are still reported in a fixed order. Only
+                        available on unix
 */
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Global variables
 
-std::map<std::string, int> methodHitMap;
+/// each thread counts the calls it makes, so tests may run programs on other threads
+/// while NumberOfCallsTo counts the calls made by the testbuild's own thread
+thread_local std::map<std::string, int> methodHitMap;
 std::map<MethodName, InjectedFunction> FunctionInjections;
 
 std::string testBuffer;
@@ -69,6 +85,7 @@ bool g_noisyReport = false;
 bool g_onlyRunOneProgram = false;
 bool g_useBytecodeRuntime = true;
 bool g_tracerOn = false;
+int g_testJobs = 0;
 
 std::string g_onlyProgramToRun;
 
@@ -296,11 +313,12 @@ void Execute()
     
     if(!test.EncounteredCompiletimeError)
     {
+        PebbleVM* vm = PebbleVMConstructor();
         if(g_useBytecodeRuntime)
         {
-            FlattenProgram(test.ProgramToRun);
-            test.ProgramReturnCode = DoByteCodeProgram(test.ProgramToRun);
-            test.ProgramOutput = ProgramOutput;
+            FlattenProgram(vm, test.ProgramToRun);
+            test.ProgramReturnCode = DoByteCodeProgram(vm, test.ProgramToRun);
+            test.ProgramOutput = *vm->Output;
             ProgramDestructor(test.ProgramToRun);
         }
         else
@@ -312,8 +330,9 @@ void Execute()
         test.HasBeenRun = true;
         test.EncounteredRuntimeError = test.ProgramReturnCode;
 
+        TestConstantsFidelity(vm);
+        PebbleVMDestructor(vm);
         Valgrind();
-        TestConstantsFidelity();
     }
 }
 
@@ -393,65 +412,83 @@ std::string Diff()
     return diff;
 }
 
-inline void AddHeader()
+/// an assertion which failed, with the fields of its entry in the failure report
+struct FailedAssert
+{
+    std::string ProgramName;
+    std::string TestName;
+    std::string AssertName;
+    std::string Report;
+};
+
+/// every failed assertion, in the order they are reported
+std::vector<FailedAssert> failures;
+
+inline void AddHeader(int number, const FailedAssert& failure)
 {
-    testBuffer.append("  " + std::to_string(failedAsserts+1) + ") " + test.ProgramName + "\n\n");
+    testBuffer.append("  " + std::to_string(number) + ") " + failure.ProgramName + "\n\n");
 }
 
-inline void AddTestNameField(std::string& padding)
+inline void AddTestNameField(std::string& padding, const FailedAssert& failure)
 {
     std::string testName;
-    if(test.TestName.empty())
+    if(failure.TestName.empty())
     {
         testName = "failed: N/A";
     }
     else
     {
-        testName = "failed: it tests " + test.TestName;
+        testName = "failed: it tests " + failure.TestName;
     }
     testBuffer.append(padding + testName + "\n");
 }
 
-inline void AddShouldField(std::string& padding)
+inline void AddShouldField(std::string& padding, const FailedAssert& failure)
 {
     std::string assert;
-    if(test.AssertName.empty())
+    if(failure.AssertName.empty())
     {
         assert = "assert: N/A";
     }
     else
     {
-        assert = "assert: should " + test.AssertName;
+        assert = "assert: should " + failure.AssertName;
     }
 
     testBuffer.append(padding + assert + "\n");
 }
 
-inline void AddExpectedField(std::string& padding)
+inline void AddExpectedField(std::string& padding, const FailedAssert& failure)
+{
+    testBuffer.append(padding + "report: " + IndentStringToLevel(failure.Report, 3) + "\n\n");
+}
+
+/// adds the entry of [failure] to the failure report as its [number]th entry
+void AddFailedTestToBuffer(int number, const FailedAssert& failure)
+{
+    std::string padding = "    ";
+    padding += SpacesOfLength(DigitsOfInt(number));
+
+    AddHeader(number, failure);
+    AddTestNameField(padding, failure);
+    AddShouldField(padding, failure);
+    AddExpectedField(padding, failure);
+}
+
+/// records the assertion of the current test as failed
+void AddFailedAssert()
 {
-    std::string otherwiseReport;
+    std::string report;
     if(test.OtherwiseReport.empty())
     {
-        otherwiseReport = "default is " + Diff();
+        report = "default is " + Diff();
     }
     else
     {
-        otherwiseReport = test.OtherwiseReport;
+        report = test.OtherwiseReport;
     }
 
-    testBuffer.append(padding + "report: " + IndentStringToLevel(otherwiseReport, 3) + "\n\n");
-}
-
-void AddFailedTestToBuffer()
-{
-    std::string padding = "    ";
-    padding += SpacesOfLength(DigitsOfInt(failedAsserts + 1));
-
-    AddHeader();
-    AddTestNameField(padding);
-    AddShouldField(padding);
-    AddExpectedField(padding);
-
+    failures.push_back({ test.ProgramName, test.TestName, test.AssertName, report });
 }
 
 void Assert(bool b)
@@ -463,7 +500,7 @@ void Assert(bool b)
 
     if(!b)
     {
-        AddFailedTestToBuffer();
+        AddFailedAssert();
         ReportFailedAssert();
     }
     else
@@ -475,7 +512,7 @@ void Assert(bool b)
 }
 
 
-void TestConstantsFidelity()
+void TestConstantsFidelity(const PebbleVM* vm)
 {
     Should("not modify IntegerCall");
     OtherwiseReport("IntegerCall modified at some point during test");
@@ -515,8 +552,8 @@ void TestConstantsFidelity()
     {
         Should("leave memory stack containing only global Caller/Self calls");
         OtherwiseReport(Msg("vm memory stack size is %i (expected 2)",
-            MemoryStack.size()));
-        Assert(MemoryStack.size() == 2);
+            vm->MemoryStack.size()));
+        Assert(vm->MemoryStack.size() == 2);
     }
 }
 
@@ -579,25 +616,395 @@ void ClearTest()
     ClearAssert();
 }
 
-void DoAllTests()
+// ---------------------------------------------------------------------------------------------------------------------
+// Test results
+
+/// the result of running one test of Tests
+/// [Name] is the description of the test followed by the last program it ran
+/// [Output] is what the test printed, when it runs in a process of its own
+/// [Seconds] is the wall time of the test
+/// [Succeeded] and [Failed] count the assertions of the test
+/// [Failures] are the failed assertions of the test
+struct TestResult
+{
+    std::string Name;
+    std::string Output;
+    double Seconds = 0;
+    int Succeeded = 0;
+    int Failed = 0;
+    std::vector<FailedAssert> Failures;
+};
+
+/// the result of every test which has been reported
+std::vector<TestResult> testResults;
+
+/// returns the name of the test which just ran
+std::string NameOfTest()
+{
+    std::string name = test.TestName.empty() ? VoidName : test.TestName;
+    if(!test.ProgramName.empty())
+    {
+        name += " (" + test.ProgramName + ")";
+    }
+
+    return name;
+}
+
+/// runs [method] and returns its result
+TestResult RunTest(TestFunction method)
+{
+    int succeededBefore = succeededAsserts;
+    int failedBefore = failedAsserts;
+    size_t failuresBefore = failures.size();
+
+    ClearTest();
+    auto start = std::chrono::high_resolution_clock::now();
+    method();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    TestResult result;
+    result.Name = NameOfTest();
+    result.Seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+    result.Succeeded = succeededAsserts - succeededBefore;
+    result.Failed = failedAsserts - failedBefore;
+    result.Failures.assign(failures.begin() + failuresBefore, failures.end());
+
+    return result;
+}
+
+/// runs every test in the testbuild itself, in a random order so that tests which
+/// depend on the state left by another fail
+void DoAllTestsInOrder()
 {
     unsigned seed = std::chrono::system_clock::now()
         .time_since_epoch()
         .count();
     std::shuffle(Tests.begin(), Tests.end(), std::default_random_engine(seed));
 
+    for(auto method: Tests)
+    {
+        testResults.push_back(RunTest(method));
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Test processes
+//
+// with --jobs N, each test runs in a process of its own which is forked from the
+// testbuild before any test has run, so no test sees the global state left by
+// another. up to N processes run at once. each sends its result to the testbuild over
+// a pipe, and the results are reported in the order of Tests whichever process
+// finishes first
+
+/// appends [field] to [out], preceded by its size
+void WriteField(std::string& out, const std::string& field)
+{
+    size_t size = field.size();
+    out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.append(field);
+}
+
+/// reads the field of [in] at [at] into [field] and moves [at] past it. returns false
+/// if [in] ends before the field does
+bool ReadField(const std::string& in, size_t& at, std::string& field)
+{
+    size_t size;
+    if(in.size() - at < sizeof(size))
+    {
+        return false;
+    }
+
+    in.copy(reinterpret_cast<char*>(&size), sizeof(size), at);
+    at += sizeof(size);
+    if(in.size() - at < size)
+    {
+        return false;
+    }
+
+    field = in.substr(at, size);
+    at += size;
+    return true;
+}
+
+/// returns [result] as the fields sent over the pipe of a test process
+std::string SerializeTestResult(const TestResult& result)
+{
+    std::string out;
+    WriteField(out, result.Name);
+    WriteField(out, result.Output);
+    WriteField(out, std::to_string(result.Seconds));
+    WriteField(out, std::to_string(result.Succeeded));
+    WriteField(out, std::to_string(result.Failed));
+    WriteField(out, std::to_string(result.Failures.size()));
+    for(auto& failure: result.Failures)
+    {
+        WriteField(out, failure.ProgramName);
+        WriteField(out, failure.TestName);
+        WriteField(out, failure.AssertName);
+        WriteField(out, failure.Report);
+    }
+
+    return out;
+}
+
+/// reads the [result] sent over the pipe of a test process from [in]. returns false
+/// if the process did not send all of it
+bool DeserializeTestResult(const std::string& in, TestResult& result)
+{
+    size_t at = 0;
+    std::string seconds, succeeded, failed, numberOfFailures;
+    if(!ReadField(in, at, result.Name) || !ReadField(in, at, result.Output) || !ReadField(in, at, seconds)
+        || !ReadField(in, at, succeeded) || !ReadField(in, at, failed) || !ReadField(in, at, numberOfFailures))
+    {
+        return false;
+    }
+
+    result.Seconds = std::stod(seconds);
+    result.Succeeded = std::stoi(succeeded);
+    result.Failed = std::stoi(failed);
+
+    result.Failures.resize(std::stoul(numberOfFailures));
+    for(auto& failure: result.Failures)
+    {
+        if(!ReadField(in, at, failure.ProgramName) || !ReadField(in, at, failure.TestName)
+            || !ReadField(in, at, failure.AssertName) || !ReadField(in, at, failure.Report))
+        {
+            return false;
+        }
+    }
+
+    return at == in.size();
+}
+
+/// returns the result of a test process which ended without sending its result
+TestResult CrashedTestResult(size_t index, const std::string& reason)
+{
+    TestResult result;
+    result.Name = Msg("test %i", static_cast<int>(index));
+    result.Output = std::string(CONSOLE_RED) + "." + CONSOLE_RESET;
+    result.Failed = 1;
+    result.Failures.push_back({ result.Name, "", "finish its process", reason });
+    return result;
+}
+
+/// adds [result] to the results of the testbuild and prints its output
+void ReportTestResult(const TestResult& result)
+{
+    std::cout << result.Output;
+    succeededAsserts += result.Succeeded;
+    failedAsserts += result.Failed;
+    failures.insert(failures.end(), result.Failures.begin(), result.Failures.end());
+    testResults.push_back(result);
+}
+
+#ifdef PEBBLE_TEST_PROCESSES
+
+/// a test running in a process of its own
+/// [Index] is the index of the test in Tests
+/// [Pid] is the id of the process
+/// [Fd] is the end of the pipe the process sends its result to
+/// [Data] is what the process has sent so far
+struct TestProcess
+{
+    size_t Index;
+    pid_t Pid;
+    int Fd;
+    std::string Data;
+};
+
+/// writes all of [data] to [fd]
+void WriteAll(int fd, const std::string& data)
+{
+    size_t written = 0;
+    while(written < data.size())
+    {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if(n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if(n <= 0)
+        {
+            return;
+        }
+        written += n;
+    }
+}
+
+/// starts a process which runs the test of Tests at [index] and sends its result over
+/// a pipe. returns false if the process cannot be started
+bool StartTestProcess(size_t index, TestProcess& process)
+{
+    int fds[2];
+    if(pipe(fds) != 0)
+    {
+        return false;
+    }
+
+    std::cout.flush();
+    pid_t pid = fork();
+    if(pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if(pid == 0)
+    {
+        close(fds[0]);
+
+        std::ostringstream output;
+        std::cout.rdbuf(output.rdbuf());
+        TestResult result = RunTest(Tests[index]);
+        result.Output = output.str();
+
+        WriteAll(fds[1], SerializeTestResult(result));
+        close(fds[1]);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    process = { index, pid, fds[0], "" };
+    return true;
+}
+
+/// returns the result sent by [process], which has closed its pipe
+TestResult FinishTestProcess(TestProcess& process)
+{
+    close(process.Fd);
+
+    int status = 0;
+    while(waitpid(process.Pid, &status, 0) < 0 && errno == EINTR);
+
+    TestResult result;
+    if(WIFSIGNALED(status))
+    {
+        return CrashedTestResult(process.Index, Msg("the process was ended by signal %i", WTERMSIG(status)));
+    }
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !DeserializeTestResult(process.Data, result))
+    {
+        return CrashedTestResult(process.Index, "the process ended without sending its result");
+    }
+
+    return result;
+}
+
+/// runs every test in a process of its own, with up to g_testJobs processes at once
+void DoAllTestsInProcesses()
+{
+    std::vector<TestResult> results(Tests.size());
+    std::vector<bool> isFinished(Tests.size(), false);
+    std::vector<TestProcess> running;
+
+    size_t nextToStart = 0;
+    size_t nextToReport = 0;
+    while(nextToReport < Tests.size())
+    {
+        while(running.size() < static_cast<size_t>(g_testJobs) && nextToStart < Tests.size())
+        {
+            TestProcess process;
+            if(StartTestProcess(nextToStart, process))
+            {
+                running.push_back(process);
+            }
+            else
+            {
+                results[nextToStart] = CrashedTestResult(nextToStart, "the process could not be started");
+                isFinished[nextToStart] = true;
+            }
+            nextToStart++;
+        }
+
+        std::vector<pollfd> fds;
+        for(auto& process: running)
+        {
+            fds.push_back({ process.Fd, POLLIN, 0 });
+        }
+        if(!fds.empty() && poll(fds.data(), fds.size(), -1) < 0)
+        {
+            continue;
+        }
+
+        for(size_t i=running.size(); i-- > 0;)
+        {
+            if(fds[i].revents == 0)
+            {
+                continue;
+            }
+
+            char chunk[4096];
+            ssize_t n = read(running[i].Fd, chunk, sizeof(chunk));
+            if(n > 0)
+            {
+                running[i].Data.append(chunk, n);
+                continue;
+            }
+            if(n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            results[running[i].Index] = FinishTestProcess(running[i]);
+            isFinished[running[i].Index] = true;
+            running.erase(running.begin() + i);
+        }
+
+        for(; nextToReport < Tests.size() && isFinished[nextToReport]; nextToReport++)
+        {
+            ReportTestResult(results[nextToReport]);
+        }
+    }
+}
+
+#endif
+
+void DoAllTests()
+{
     auto start = std::chrono::high_resolution_clock::now();
-    for(auto test: Tests)
+
+#ifdef PEBBLE_TEST_PROCESSES
+    if(g_testJobs > 0)
+    {
+        DoAllTestsInProcesses();
+    }
+    else
     {
-        ClearTest();
-        test();
+        DoAllTestsInOrder();
     }
+#else
+    DoAllTestsInOrder();
+#endif
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
     timespan = time_span.count();
 }
 
+/// prints the wall time of every test which made an assertion, slowest first
+void DisplayTestTimes()
+{
+    std::vector<TestResult> timed;
+    for(auto& result: testResults)
+    {
+        if(result.Succeeded + result.Failed > 0)
+        {
+            timed.push_back(result);
+        }
+    }
+
+    std::stable_sort(timed.begin(), timed.end(), 
+        [](const TestResult& a, const TestResult& b) { return a.Seconds > b.Seconds; });
+
+    std::cout << CONSOLE_YELLOW << "\n\ntest times: \n\n" << CONSOLE_RESET;
+    std::cout.precision(3);
+    for(auto& result: timed)
+    {
+        std::cout << "  " << std::fixed << result.Seconds << " secs  " << result.Name << "\n";
+    }
+}
+
 char FirstNonSpaceChar(std::string& str)
 {
     size_t i;
@@ -642,6 +1049,10 @@ bool Test()
 
     DoAllTests();
 
+    for(size_t i=0; i<failures.size(); i++)
+    {
+        AddFailedTestToBuffer(static_cast<int>(i+1), failures[i]);
+    }
 
     if(failedAsserts)
     {
@@ -649,6 +1060,8 @@ bool Test()
         DisplayTestBuffer();
     }
 
+    DisplayTestTimes();
+
     std::cout.precision(2);
     std::cout << CONSOLE_YELLOW << "\n\nfinished " << (succeededAsserts + failedAsserts) << " assertions at " 
         << std::fixed << (100.0 * succeededAsserts / (succeededAsserts + failedAsserts)) 
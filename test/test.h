@@ -57,7 +57,7 @@ extern std::map<MethodName, InjectedFunction> FunctionInjections;
 
 
 void TEST_Tracer(const char* str);
-extern std::map<MethodName, int> methodHitMap;
+extern thread_local std::map<MethodName, int> methodHitMap;
 
 extern bool g_shouldRunCustomProgram;
 extern bool g_noisyReport;
@@ -65,6 +65,10 @@ extern bool g_onlyRunOneProgram;
 extern bool g_useBytecodeRuntime;
 extern bool g_tracerOn;
 
+/// the number of tests run at once, each in a process of its own, or 0 to run every
+/// test in the testbuild itself
+extern int g_testJobs;
+
 extern std::string g_onlyProgramToRun;
 
 bool Test();
@@ -97,7 +101,7 @@ class ProgramResult
 
 extern ProgramResult Result;
 void Valgrind();
-void TestConstantsFidelity();
+void TestConstantsFidelity(const PebbleVM* vm);
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -2,6 +2,7 @@
 
 #include "decision.h"
 #include "parse.h"
+#include "grammar.h"
 #include "token.h"
 #include "diagnostics.h"
 #include "main.h"
@@ -10,6 +11,20 @@
 #include "program.h"
 #include "reference.h"
 #include "scope.h"
+#include "gc.h"
+#include "jit.h"
+#include "aot.h"
+#include "pbc.h"
+#include "flattener.h"
+#include "embed.h"
+#include "profile.h"
+#include "vm.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Documentation
@@ -230,6 +245,86 @@ void TestDecimals()
         Assert(Result.AsExpected());
 }
 
+void TestPrimitiveValues()
+{
+    ItTests("primitive values are only constructed once");
+
+    CompileAndExecuteProgram("TestPrimitiveValues");
+        Should("compute the loop correctly");
+        Expected("0\n0\n");
+        Assert(Result.AsExpected());
+
+        Should("reuse the call for a primitive value which already exists");
+        Assert(NumberOfCallsTo("CallConstructor") < 120);
+}
+
+void TestGarbageCollection()
+{
+    ItTests("unreachable calls and scopes are freed while the program runs");
+
+    auto threshold = GCMinimumThreshold;
+    GCMinimumThreshold = 64;
+
+    CompileAndExecuteProgram("TestGarbageCollection");
+        Should("keep every reachable call and its value");
+        Expected("45450\n3\n1\npair\n");
+        Assert(Result.AsExpected());
+
+        Should("collect garbage once the threshold is reached");
+        Assert(NumberOfCallsTo("CollectGarbage") > 0);
+
+    /// the same loop runs for longer and longer, so only garbage grows with N
+    std::vector<GCStatistics> stats;
+    for(auto n: { "100", "1000", "10000" })
+    {
+        PebbleProgram* program = CompilePebbleProgram(String("Pair:\n    First = 0\n    Second = 0\n\n")
+            + "MakePair(A, B):\n    P = a Pair()\n    P.First = A\n    P.Second = B\n    return P\n\n"
+            + "N = " + n + "\nwhile N > 0\n    Temporary = MakePair(N, 1)\n    N = N - 1\n");
+        if(program != nullptr)
+        {
+            RunPebbleProgram(program);
+            stats.push_back(program->VM->GCStats);
+            PebbleProgramDestructor(program);
+        }
+    }
+
+        Should("free unreachable calls and scopes");
+        Assert(stats.size() == 3 && stats[0].CallsFreed > 0 && stats[0].ScopesFreed > 0);
+
+        Should("keep the live calls and scopes under a bound which does not grow with N");
+        Assert(stats.size() == 3 && stats[2].MaxLive <= stats[0].MaxLive && stats[2].MaxLive < GCMinimumThreshold);
+
+    GCMinimumThreshold = threshold;
+}
+
+void TestUnboxedIntegers()
+{
+    ItTests("integer and boolean results are kept unboxed on the stack");
+
+    CompileAndExecuteProgram("TestUnboxedIntegers");
+        Should("compute the same values as boxed calls");
+        Expected("876250\ntrue\n35\ntrue\n");
+        Assert(Result.AsExpected());
+
+        Should("not construct a call for each intermediate result");
+        Assert(NumberOfCallsTo("CallConstructor") < 100);
+}
+
+void TestArrays()
+{
+    ItTests("arrays are indexed and sized natively");
+
+    CompileAndExecuteProgram("TestArrays");
+        Should("store and index each element and resolve the Size of the array");
+        Expected("1000\n1998\n50\n<Nothing>\n");
+        Assert(Result.AsExpected());
+
+    CompileAndExecuteProgram("TestArrayOutOfBounds");
+        Should("not index outside of the array");
+        Expected("exception to be thrown");
+        Assert(Result.EncounteredFatalException());
+}
+
 void TestMethodWithNoParams()
 {
     ItTests("can define/evaluate method with no params");
@@ -270,6 +365,26 @@ void TestScopeAccess()
         Assert(Result.AsExpected());
 }
 
+void TestLargeScopes()
+{
+    ItTests("finds calls in scopes with many names");
+
+    CompileAndExecuteProgram("TestLargeScopes");
+        Should("resolve globals, attributes and parameters of large scopes");
+        Expected("0\n10\n20\n30\n40\n50\n60\n70\n80\n90\n100\n110\n120\n130\n55\n44\n100\n");
+        Assert(Result.AsExpected());
+}
+
+void TestMethodLocals()
+{
+    ItTests("method parameters and locals resolve correctly");
+
+    CompileAndExecuteProgram("TestMethodLocals");
+        Should("resolve parameters, locals and globals used inside of methods");
+        Expected("102\n7\n10\n101\n1\n2\n4\n12\n21\n");
+        Assert(Result.AsExpected());
+}
+
 void TestMethodRecursion()
 {
     ItTests("method can call itself");
@@ -286,10 +401,105 @@ void TestComments()
 
     CompileAndExecuteProgram("TestComments");
         Should("not parse program comments marked by a #");
-        Expected("30\n#60\n");
+        Expected("30\n#60\n#\n");
         Assert(Result.AsExpected());
 }
 
+void TestGrammarTables()
+{
+    ItTests("compiles the grammar into pebble from ./assets/grammar.txt");
+
+    auto readFile = [](const String& name)
+    {
+        std::ifstream file(name);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    };
+
+    g_grammarFile = "./assets/grammar.txt";
+    CompileGrammar();
+    bool emitted = EmitGrammarTables("./logs/grammartables.h");
+
+    g_grammarFile = "";
+    CompileGrammar();
+    EmitGrammarTables("./logs/grammartables_loaded.h");
+
+        Should("write the grammar tables");
+        Assert(emitted);
+
+        Should("have compiled tables which match the grammar file");
+        OtherwiseReport("run `make grammar` to regenerate src/parser/grammartables.h");
+        Assert(readFile("./logs/grammartables.h") == readFile("./src/parser/grammartables.h"));
+
+        Should("load the same grammar from the compiled tables");
+        Assert(readFile("./logs/grammartables_loaded.h") == readFile("./logs/grammartables.h"));
+}
+
+void TestParallelParse()
+{
+    ItTests("parses the lines of a long program on several threads the same as on one");
+
+    /// the program spans several chunks of 64 lines, so every thread parses some of them
+    std::vector<String> lines = { "Total = 0" };
+    for(int i=1; i<300; i++)
+    {
+        lines.push_back("Total = Total + " + std::to_string(i));
+    }
+    lines.push_back("print Total");
+
+    auto join = [](const std::vector<String>& lines)
+    {
+        String source;
+        for(auto& line: lines)
+        {
+            source += line + "\n";
+        }
+        return source;
+    };
+
+    String source = join(lines);
+    lines[199] = "Total = = 3";
+    String badSource = join(lines);
+
+    /// logged runs parse on one thread, so logging must be off
+    DisableLogging();
+    auto parseThreads = g_parseThreads;
+    std::vector<String> outputs;
+    std::vector<String> errors;
+    std::vector<size_t> threadsUsed;
+    for(int threads: { 1, 3 })
+    {
+        g_parseThreads = threads;
+        threadsUsed.push_back(NumberOfParseThreads(lines.size()));
+
+        PebbleProgram* program = CompilePebbleProgram(source);
+        if(program != nullptr)
+        {
+            outputs.push_back(RunPebbleProgram(program).Output);
+            PebbleProgramDestructor(program);
+        }
+
+        String messages;
+        program = CompilePebbleProgram(badSource, &messages);
+        errors.push_back(program == nullptr ? messages : "");
+        if(program != nullptr)
+        {
+            PebbleProgramDestructor(program);
+        }
+    }
+    g_parseThreads = parseThreads;
+
+        Should("parse the lines on as many threads as g_parseThreads");
+        Assert(threadsUsed[0] == 1 && threadsUsed[1] == 3);
+
+        Should("run the program the same as when it is parsed on one thread");
+        Assert(outputs.size() == 2 && outputs[0] == "44850\n" && outputs[1] == outputs[0]);
+
+        Should("report a syntax error at the line it is on");
+        Assert(errors[0].find("line[200]: syntax error") != String::npos && errors[1] == errors[0]);
+}
+
 void TestIfElseComplex()
 {
     ItTests("correctly evaluates an if/else-if/else statement");
@@ -310,6 +520,22 @@ void TestWhile()
         Assert(Result.AsExpected());
 }
 
+void TestSuperinstructions()
+{
+    ItTests("common instruction sequences are fused into superinstructions");
+
+    CompileAndExecuteProgram("TestWhile");
+        Should("run the loops the same as without fusion");
+        Expected("5\n4\n3\n2\n1\n-5\n-4\n-3\n-2\n-1\n");
+        Assert(Result.AsExpected());
+
+        Should("compare and jump in a single instruction");
+        Assert(NumberOfCallsTo("BCI_CmpJumpFalse") > 0 && NumberOfCallsTo("BCI_LoadCmp") == 0);
+
+        Should("use constants directly in arithmetic");
+        Assert(NumberOfCallsTo("BCI_AddConst") > 0 && NumberOfCallsTo("BCI_SubtractConst") > 0);
+}
+
 void TestHere()
 {
     ItTests("correctly evaluates a method with the here operator");
@@ -330,6 +556,393 @@ void TestMethodReturn()
         Assert(Result.AsExpected());
 }
 
+void TestCallFrames()
+{
+    ItTests("restores the caller's local scopes when a method returns");
+
+    CompileAndExecuteProgram("TestCallFrames");
+        Should("return from inside local scopes and deep recursion");
+        Expected("12\n-1\n300\n6\n9\n3\n");
+        Assert(Result.AsExpected());
+}
+
+void TestTailCalls()
+{
+    ItTests("evaluates a method called in tail position in the current call frame");
+
+    CompileAndExecuteProgram("TestTailCalls");
+        Should("return the result of tail calls and deep tail recursion");
+        Expected("1250025000\nfalse\n6\n55\n20\n");
+        Assert(Result.AsExpected());
+
+        Should("evaluate methods called in tail position with BCI_TailEval");
+        Assert(NumberOfCallsTo("BCI_TailEval") > 0);
+
+    DisableLogging();
+    std::vector<size_t> maxCallStackSizes;
+    for(auto depth: { "10", "1000", "10000" })
+    {
+        PebbleProgram* program = CompilePebbleProgram(
+            String("Sum(N, Acc):\n    if N == 0\n        return Acc\n    return Sum(N - 1, Acc + N)\n\nprint Sum(")
+            + depth + ", 0)\n");
+
+            Should("compile the tail recursive program");
+            Assert(program != nullptr);
+
+        if(program == nullptr)
+        {
+            return;
+        }
+
+        RunPebbleProgram(program);
+        maxCallStackSizes.push_back(program->VM->MaxCallStackSize);
+        PebbleProgramDestructor(program);
+    }
+
+        Should("not grow the call stack with the depth of tail recursion");
+        Assert(maxCallStackSizes[0] == maxCallStackSizes[1] && maxCallStackSizes[1] == maxCallStackSizes[2]);
+}
+
+void TestJit()
+{
+    ItTests("compiles hot sections and loops to native code with the same results");
+
+    auto threshold = JitThreshold;
+    g_jitOn = true;
+    JitThreshold = 1;
+
+    CompileAndExecuteProgram("TestWhile");
+        Should("run compiled loops the same as the interpreter");
+        Expected("5\n4\n3\n2\n1\n-5\n-4\n-3\n-2\n-1\n");
+        Assert(Result.AsExpected());
+
+        Should("compile the loops if the platform is supported");
+        Assert(!JitIsSupported() || NumberOfCallsTo("CompileRegion") > 0);
+
+    CompileAndExecuteProgram("TestTailCalls");
+        Should("run compiled methods and tail calls the same as the interpreter");
+        Expected("1250025000\nfalse\n6\n55\n20\n");
+        Assert(Result.AsExpected());
+
+    CompileAndExecuteProgram("TestCallFrames");
+        Should("return from compiled methods to the interpreter");
+        Expected("12\n-1\n300\n6\n9\n3\n");
+        Assert(Result.AsExpected());
+
+    CompileAndExecuteProgram("TestArrayOutOfBounds");
+        Should("report errors raised in native code");
+        Expected("exception to be thrown");
+        Assert(Result.EncounteredFatalException());
+
+    std::vector<String> programNames;
+    for(auto& entry: std::filesystem::directory_iterator("./test/programs"))
+    {
+        if(entry.path().extension() == ".pebl")
+        {
+            programNames.push_back(entry.path().stem().string());
+        }
+    }
+    std::sort(programNames.begin(), programNames.end());
+
+    /// every test program runs once with the interpreter alone and once with the JIT
+    std::vector<String> differentPrograms;
+    for(auto& name: programNames)
+    {
+        g_jitOn = false;
+        ClearRun();
+        CompileAndExecuteProgram(name);
+        String interpretedOutput = test.ProgramOutput;
+        int interpretedReturnCode = test.ProgramReturnCode;
+
+        g_jitOn = true;
+        ClearRun();
+        CompileAndExecuteProgram(name);
+        if(test.ProgramOutput != interpretedOutput || test.ProgramReturnCode != interpretedReturnCode)
+        {
+            differentPrograms.push_back(name);
+        }
+    }
+
+        Should("run every test program the same as the interpreter");
+        Expected("no program to print differently with the JIT");
+        Assert(!programNames.empty() && differentPrograms.empty());
+
+    g_jitOn = false;
+    JitThreshold = threshold;
+}
+
+void TestEmitCpp()
+{
+    ItTests("writes a program as a C++ translation unit which runs without dispatch");
+
+    SetProgramToRun("TestWhile");
+    DisableLogging();
+    Compile();
+    bool compiled = test.ProgramToRun != nullptr && !test.EncounteredCompiletimeError;
+
+        Should("compile the program");
+        Assert(compiled);
+
+    if(!compiled)
+    {
+        return;
+    }
+
+    PebbleVM* vm = PebbleVMConstructor();
+    FlattenProgram(vm, test.ProgramToRun);
+    size_t numberOfInstructions = vm->ByteCodeProgram.size();
+    bool emitted = EmitCpp(vm, "./logs/TestWhile.cpp", test.ProgramToRun);
+    ProgramDestructor(test.ProgramToRun);
+    PebbleVMDestructor(vm);
+
+    std::ifstream file("./logs/TestWhile.cpp");
+    std::stringstream code;
+    code << file.rdbuf();
+
+        Should("write the translation unit");
+        Assert(emitted);
+
+        Should("turn jumps into gotos and run the program from its tables");
+        Assert(code.str().find("if(vm->JumpStatusReg) { vm->JumpStatusReg = 0; goto ins_") != String::npos
+            && code.str().find("return RunAotProgram(Aot, RunProgram);") != String::npos);
+
+    bool hasEveryLabel = true;
+    for(size_t i=0; i<=numberOfInstructions; i++)
+    {
+        hasEveryLabel = hasEveryLabel && code.str().find("\nins_" + std::to_string(i) + ":\n") != String::npos;
+    }
+
+        Should("label every instruction and the halt which follows them");
+        Assert(hasEveryLabel);
+
+        Should("dispatch to the labels by InstructionReg");
+        Assert(code.str().find("\ndispatch:\n    switch(vm->InstructionReg)") != String::npos);
+}
+
+void TestPrecompiledProgram()
+{
+    ItTests("loads precompiled bytecode instead of compiling an unchanged program");
+
+    SetProgramToRun("TestWhile");
+    DisableLogging();
+    Compile();
+    bool compiled = test.ProgramToRun != nullptr && !test.EncounteredCompiletimeError;
+
+        Should("compile the program");
+        Assert(compiled);
+
+    if(!compiled)
+    {
+        return;
+    }
+
+    PebbleVM* vm = PebbleVMConstructor();
+    FlattenProgram(vm, test.ProgramToRun);
+    bool written = WritePrecompiledProgram(vm, "./logs/TestWhile.pbc", test.ProgramFile, test.ProgramToRun);
+    ProgramDestructor(test.ProgramToRun);
+    PebbleVMDestructor(vm);
+
+        Should("write the .pbc file");
+        Assert(written);
+
+    ProgramOutput = "";
+    vm = PebbleVMConstructor();
+    Program* loaded = LoadPrecompiledProgram(vm, "./logs/TestWhile.pbc", test.ProgramFile);
+    if(loaded != nullptr)
+    {
+        DoByteCodeProgram(vm, loaded);
+        test.ProgramOutput = *vm->Output;
+        delete loaded;
+    }
+    PebbleVMDestructor(vm);
+
+        Should("run the loaded program the same as the compiled one");
+        Expected("5\n4\n3\n2\n1\n-5\n-4\n-3\n-2\n-1\n");
+        Assert(loaded != nullptr && Result.AsExpected());
+
+        Should("not load a .pbc file written for another source");
+        vm = PebbleVMConstructor();
+        Assert(LoadPrecompiledProgram(vm, "./logs/TestWhile.pbc", "./test/programs/TestTailCalls.pebl") == nullptr);
+        PebbleVMDestructor(vm);
+}
+
+void TestSeparateVms()
+{
+    ItTests("runs programs in separate vms which do not share state");
+
+    SetProgramToRun("TestWhile");
+    DisableLogging();
+    Compile();
+    Program* whileProgram = test.ProgramToRun;
+    bool compiled = whileProgram != nullptr && !test.EncounteredCompiletimeError;
+
+    SetProgramToRun("TestTailCalls");
+    Compile();
+    Program* tailCallsProgram = test.ProgramToRun;
+    compiled = compiled && tailCallsProgram != nullptr && !test.EncounteredCompiletimeError;
+
+    SetProgramToRun("TestArrayOutOfBounds");
+    Compile();
+    Program* outOfBoundsProgram = test.ProgramToRun;
+    compiled = compiled && outOfBoundsProgram != nullptr && !test.EncounteredCompiletimeError;
+
+        Should("compile the programs");
+        Assert(compiled);
+
+    if(!compiled)
+    {
+        return;
+    }
+
+    String whileOutput, tailCallsOutput;
+    PebbleVM* whileVm = PebbleVMConstructor();
+    whileVm->Output = &whileOutput;
+    PebbleVM* tailCallsVm = PebbleVMConstructor();
+    tailCallsVm->Output = &tailCallsOutput;
+
+    /// both programs are flattened before either is run, so each vm must keep its own tables
+    FlattenProgram(whileVm, whileProgram);
+    FlattenProgram(tailCallsVm, tailCallsProgram);
+    int whileReturnCode = DoByteCodeProgram(whileVm, whileProgram);
+    int tailCallsReturnCode = DoByteCodeProgram(tailCallsVm, tailCallsProgram);
+
+        Should("run each program with the tables it was flattened into");
+        Assert(whileReturnCode == 0 && whileOutput == "5\n4\n3\n2\n1\n-5\n-4\n-3\n-2\n-1\n");
+        Assert(tailCallsReturnCode == 0 && tailCallsOutput == "1250025000\nfalse\n6\n55\n20\n");
+
+        Should("print to the output of its own vm");
+        Assert(ProgramOutput.empty());
+
+    /// the same vms run their programs again at the same time, beside a vm which
+    /// reports a runtime error to its own Messages
+    whileOutput = "";
+    tailCallsOutput = "";
+    PebbleVM* outOfBoundsVm = PebbleVMConstructor();
+    FlattenProgram(outOfBoundsVm, outOfBoundsProgram);
+    std::thread whileThread([&]() { whileReturnCode = DoByteCodeProgram(whileVm, whileProgram); });
+    std::thread tailCallsThread([&]() { tailCallsReturnCode = DoByteCodeProgram(tailCallsVm, tailCallsProgram); });
+    std::thread outOfBoundsThread([&]() { DoByteCodeProgram(outOfBoundsVm, outOfBoundsProgram); });
+    whileThread.join();
+    tailCallsThread.join();
+    outOfBoundsThread.join();
+
+        Should("run programs at the same time on different threads");
+        Assert(whileReturnCode == 0 && whileOutput == "5\n4\n3\n2\n1\n-5\n-4\n-3\n-2\n-1\n");
+        Assert(tailCallsReturnCode == 0 && tailCallsOutput == "1250025000\nfalse\n6\n55\n20\n");
+        Assert(ProgramOutput.empty());
+
+        Should("report runtime errors to the messages of their own vm");
+        Assert(outOfBoundsVm->MessagesBuffer.find("array index out of bounds") != String::npos
+            && *outOfBoundsVm->Output == outOfBoundsVm->MessagesBuffer);
+        Assert(whileVm->MessagesBuffer.empty() && tailCallsVm->MessagesBuffer.empty());
+        Assert(ProgramMsgs.empty());
+
+    ProgramDestructor(whileProgram);
+    ProgramDestructor(tailCallsProgram);
+    ProgramDestructor(outOfBoundsProgram);
+    PebbleVMDestructor(whileVm);
+    PebbleVMDestructor(tailCallsVm);
+    PebbleVMDestructor(outOfBoundsVm);
+}
+
+void TestEmbeddedProgram()
+{
+    ItTests("compiles a program held in memory once and runs it many times");
+
+    DisableLogging();
+    ProgramOutput = "";
+    String messages;
+    PebbleProgram* program = CompilePebbleProgram("Greeting = \"hello \"\nName = ask \"name? \"\nprint Greeting + Name\n", &messages);
+
+        Should("compile the source");
+        Assert(program != nullptr && messages.empty());
+
+    if(program == nullptr)
+    {
+        return;
+    }
+
+    std::vector<String> names = { "Ada", "Grace", "Alan" };
+    bool allAsExpected = true;
+    for(auto& name: names)
+    {
+        auto result = RunPebbleProgram(program, [&]() { return name; });
+        allAsExpected = allAsExpected && result.ExitCode == 0 && result.Output == "name? \nhello " + name + "\n";
+    }
+    PebbleProgramDestructor(program);
+
+        Should("read ask from the callback and capture the output of every run");
+        Assert(allAsExpected);
+
+        Should("not print to the global output");
+        Assert(ProgramOutput.empty());
+
+    /// a pooled service may compile, run and free a program on different threads
+    PebbleRunResult pooledResult = { "", "", 1 };
+    std::thread compileThread([&]() { program = CompilePebbleProgram("X = 0\nwhile X < 3\n    X = X + 1\nprint X\n"); });
+    compileThread.join();
+    if(program != nullptr)
+    {
+        std::thread runThread([&]() { pooledResult = RunPebbleProgram(program); });
+        runThread.join();
+        PebbleProgramDestructor(program);
+    }
+
+        Should("run and free a program on other threads than the one which compiled it");
+        Assert(program != nullptr && pooledResult.ExitCode == 0 && pooledResult.Output == "3\n");
+
+    program = CompilePebbleProgram("X = = 3\n", &messages);
+
+        Should("not compile a program with a syntax error");
+        Assert(program == nullptr && messages.find("syntax error") != String::npos);
+}
+
+void TestInstructionProfile()
+{
+    ItTests("counts and times each instruction and pair of instructions with --profile-ops");
+
+    DisableLogging();
+    PebbleProgram* program = CompilePebbleProgram("X = 0\nwhile X < 10\n    X = X + 1\nprint X\n");
+
+        Should("compile the source");
+        Assert(program != nullptr);
+
+    if(program == nullptr)
+    {
+        return;
+    }
+
+    g_profileOpsOn = true;
+    auto result = RunPebbleProgram(program);
+    g_profileOpsOn = false;
+
+    auto& profile = program->VM->OpProfile;
+    uint64_t instructions = 0;
+    uint64_t pairs = 0;
+    for(auto count: profile.Counts)
+    {
+        instructions += count;
+    }
+    for(auto count: profile.PairCounts)
+    {
+        pairs += count;
+    }
+
+        Should("run the program the same as without profiling");
+        Assert(result.Output == "10\n");
+
+        Should("count every instruction and every pair of instructions executed");
+        Assert(instructions > 0 && pairs == instructions - 1);
+
+        Should("count each jump back to the start of the loop");
+        Assert(profile.Counts[OP_Jump] == 10);
+
+        Should("count the pair of the loop condition after its jump");
+        Assert(profile.PairCounts[OP_Jump * OP_NumberOfInstructions + OP_ResolveName] == 10);
+
+    PebbleProgramDestructor(program);
+}
+
 void TestTypeSystem()
 {
     ItTests("enforces a runtime type system");
@@ -416,25 +1029,42 @@ std::vector<TestFunction> Tests =
 
     // Tests for scoping
     TestScopeAccess,
+    TestLargeScopes,
 
     // Test for control flow
     TestIf,
     TestIfElseComplex,
     TestWhile,
+    TestSuperinstructions,
 
     // Tests for operations + numbers
     TestOrderOfOperations,
     TestDecimals,
+    TestPrimitiveValues,
+    TestGarbageCollection,
+    TestUnboxedIntegers,
+    TestArrays,
 
     // Tests for methods
     TestMethodWithNoParams,
     TestMethodWithSingleParam,
     TestMethodWithMultipleParams,
+    TestMethodLocals,
     TestMethodRecursion,
     TestMethodReturn,
+    TestCallFrames,
+    TestTailCalls,
+    TestJit,
+    TestEmitCpp,
+    TestPrecompiledProgram,
+    TestSeparateVms,
+    TestEmbeddedProgram,
+    TestInstructionProfile,
 
     // Tests for compile time
     TestComments,
+    TestGrammarTables,
+    TestParallelParse,
 
     // Tests for the type system
     TestTypeSystem,